@@ -0,0 +1,715 @@
+/**
+ *  Benchmark suite
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "config.hxx"
+
+#include <libnn/model/feed_forward.hxx>
+#include <libnn/ml/nn_func.hxx>
+#include <libnn/ml/backpropagation.hxx>
+#include <libnn/io/sigmoid.hxx>
+#include <libnn/io/feed_forward.hxx>
+#include <libnn/io/binary.hxx>
+#include <libnn/math/sigmoid.hxx>
+#include <libnn/math/blas.hxx>
+#include <libnn/math/cpu.hxx>
+
+#include <vector>
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <iostream>
+#include <functional>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <new>
+#include <exception>
+#include <stdexcept>
+#include <cstdlib>
+#include <cstdio>
+
+extern "C" {
+#include <unistd.h>
+#include <sys/resource.h>
+}
+
+
+/** Base numeric type */
+typedef double base_t;
+
+/** Feed-forward network */
+typedef libnn::model::feed_forward<base_t, libnn::math::logistic_fn<base_t> >
+    nn_t;
+
+/** Generic network function */
+typedef libnn::ml::nn_func<base_t, libnn::math::logistic_fn<base_t> >
+    nn_func_t;
+
+/** Samples (inputs or outputs) */
+typedef std::vector<std::vector<base_t> > samples_t;
+
+/** Training set */
+typedef std::vector<std::pair<std::vector<base_t>, std::vector<base_t> > >
+    tset_t;
+
+
+/*
+ *  Allocations counting
+ */
+
+static std::atomic<size_t> alloc_cnt(0);    /**< Allocation count */
+static std::atomic<size_t> alloc_bytes(0);  /**< Allocated bytes  */
+
+/** \cond */
+void * operator new (size_t size) {
+    ++alloc_cnt;
+    alloc_bytes += size;
+
+    void * ptr = ::malloc(size ? size : 1);
+    if (NULL == ptr) throw std::bad_alloc();
+
+    return ptr;
+}
+
+void operator delete (void * ptr) noexcept { ::free(ptr); }
+
+void operator delete (void * ptr, size_t) noexcept { ::free(ptr); }
+/** \endcond */
+
+
+/**
+ *  \brief  Reset peak RSS
+ *
+ *  Resets the process RSS high water mark (Linux 4.0 and newer).
+ *  If not supported, the peak RSS reported is the process lifetime one.
+ */
+static void reset_peak_rss() {
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    if (clear_refs) clear_refs << "5" << std::flush;
+}
+
+
+/**
+ *  \brief  Peak RSS
+ *
+ *  \return Peak RSS (KiB) since the last \ref reset_peak_rss
+ */
+static size_t peak_rss() {
+    std::ifstream status("/proc/self/status");
+
+    for (std::string line; std::getline(status, line); )
+        if (0 == line.compare(0, 6, "VmHWM:"))
+            return ::atol(line.c_str() + 6);
+
+    struct rusage usage;
+    ::getrusage(RUSAGE_SELF, &usage);
+
+    return usage.ru_maxrss;
+}
+
+
+/** Network size */
+struct size_spec {
+    const char *        name;    /**< Size name         */
+    std::vector<size_t> layers;  /**< Layer sizes       */
+};  // end of struct size_spec
+
+/** Network sizes (tiny to huge) */
+static const size_spec sizes[] = {
+    { "tiny",   { 4, 8, 2 }              },
+    { "small",  { 32, 64, 8 }            },
+    { "medium", { 128, 256, 256, 16 }    },
+    { "large",  { 512, 1024, 1024, 64 }  },
+    { "huge",   { 1024, 4096, 4096, 256 } },
+};
+
+/** Rows of batches (evaluation and training) */
+static const size_t batch_rows = 64;
+
+
+/**
+ *  \brief  Synapse count
+ *
+ *  \param  layers  Layer sizes
+ *
+ *  \return Synapse count of the network (with bias)
+ */
+static size_t synapse_cnt(const std::vector<size_t> & layers) {
+    size_t cnt = 0;
+    for (size_t k = 1; k < layers.size(); ++k)
+        cnt += (layers[k - 1] + 1) * layers[k];
+
+    return cnt;
+}
+
+
+/**
+ *  \brief  Measurement
+ *
+ *  Accumulates time and allocations of the measured parts
+ *  of benchmark iterations.
+ */
+class meter {
+    private:
+
+    typedef std::chrono::steady_clock clock_t;
+
+    clock_t::time_point m_t0;       /**< Start time             */
+    size_t              m_alloc0;   /**< Start allocation count */
+    size_t              m_bytes0;   /**< Start allocated bytes  */
+
+    public:
+
+    double time;    /**< Measured time (s)       */
+    size_t allocs;  /**< Measured allocations    */
+    size_t bytes;   /**< Measured allocated bytes */
+
+    /** Constructor */
+    meter(): m_alloc0(0), m_bytes0(0), time(0), allocs(0), bytes(0) {}
+
+    /** Start measurement */
+    void start() {
+        m_alloc0 = alloc_cnt;
+        m_bytes0 = alloc_bytes;
+        m_t0     = clock_t::now();
+    }
+
+    /** Stop measurement */
+    void stop() {
+        time   += std::chrono::duration<double>(clock_t::now() - m_t0).count();
+        allocs += alloc_cnt   - m_alloc0;
+        bytes  += alloc_bytes - m_bytes0;
+    }
+
+};  // end of class meter
+
+
+/** Benchmark result */
+struct record {
+    std::string bench;         /**< Benchmark                       */
+    std::string size;          /**< Network size                    */
+    size_t      synapses;      /**< Synapse count                   */
+    size_t      iterations;    /**< Iterations                      */
+    size_t      samples;       /**< Samples processed               */
+    double      ns_sample;     /**< Time per sample (ns)            */
+    double      gflops;        /**< GFLOP/s (0 if not applicable)   */
+    double      allocs_sample; /**< Allocations per sample          */
+    double      bytes_sample;  /**< Allocated bytes per sample      */
+    size_t      peak_rss;      /**< Peak RSS (KiB)                  */
+};  // end of struct record
+
+
+/** Benchmark body (measures its iteration using the meter) */
+typedef std::function<void (meter &)> body_t;
+
+
+/** Options */
+struct options {
+    std::vector<std::string> sizes;    /**< Network sizes          */
+    std::vector<std::string> benches;  /**< Benchmarks (all if empty) */
+    std::vector<std::string> outputs;  /**< Output files           */
+    double                   time;     /**< Min. time per benchmark */
+
+    /** Defaults */
+    options(): time(0.25) {}
+
+    /** Check whether benchmark is selected */
+    bool selected(const std::string & bench) const {
+        return benches.empty() || benches.end() !=
+            std::find(benches.begin(), benches.end(), bench);
+    }
+
+};  // end of struct options
+
+
+/**
+ *  \brief  Run benchmark
+ *
+ *  The body is run once as warm-up (so that lazily allocated buffers
+ *  don't count), then repeatedly until the measured time reaches
+ *  the minimum.
+ *  Long running benchmarks (warm-up taking at least the minimum time)
+ *  are measured by the warm-up only.
+ *
+ *  \param  opts      Options
+ *  \param  bench     Benchmark name
+ *  \param  size      Network size
+ *  \param  samples   Samples per iteration
+ *  \param  flops     Floating point operations per sample (or 0)
+ *  \param  body      Benchmark body
+ *
+ *  \return Result
+ */
+static record run(
+    const options     & opts,
+    const std::string & bench,
+    const size_spec   & size,
+    size_t              samples,
+    double              flops,
+    const body_t      & body)
+{
+    reset_peak_rss();
+
+    // Warm-up (measured if it takes long enough by itself)
+    meter m;
+    body(m);
+
+    size_t iterations = 1;
+    if (m.time < opts.time) {
+        m = meter();
+        iterations = 0;
+
+        do {
+            body(m);
+            ++iterations;
+        } while (m.time < opts.time);
+    }
+
+    record rec;
+    rec.bench         = bench;
+    rec.size          = size.name;
+    rec.synapses      = synapse_cnt(size.layers);
+    rec.iterations    = iterations;
+    rec.samples       = iterations * samples;
+    rec.ns_sample     = m.time * 1e9 / rec.samples;
+    rec.gflops        = flops * rec.samples / m.time * 1e-9;
+    rec.allocs_sample = (double)m.allocs / rec.samples;
+    rec.bytes_sample  = (double)m.bytes  / rec.samples;
+    rec.peak_rss      = peak_rss();
+
+    std::cerr
+        << bench << " (" << size.name << "): "
+        << rec.ns_sample << " ns/sample, " << rec.gflops << " GFLOP/s, "
+        << rec.allocs_sample << " allocs/sample" << std::endl;
+
+    return rec;
+}
+
+
+/** Deterministic weight initialiser */
+class weight_init {
+    private:
+
+    std::mt19937                           m_rng;   /**< RNG          */
+    std::uniform_real_distribution<base_t> m_dist;  /**< Distribution */
+
+    public:
+
+    /** Constructor */
+    weight_init(): m_rng(1), m_dist(-0.5, 0.5) {}
+
+    /** Weight */
+    base_t operator () () { return m_dist(m_rng); }
+
+};  // end of class weight_init
+
+
+/**
+ *  \brief  Random samples
+ *
+ *  \param  cnt   Sample count
+ *  \param  size  Sample size
+ *  \param  seed  RNG seed
+ *
+ *  \return Samples (values in [0, 1])
+ */
+static samples_t random_samples(size_t cnt, size_t size, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<base_t> uniform(0, 1);
+
+    samples_t samples(cnt, std::vector<base_t>(size));
+    for (size_t i = 0; i < cnt; ++i)
+        for (size_t j = 0; j < size; ++j) samples[i][j] = uniform(rng);
+
+    return samples;
+}
+
+
+/**
+ *  \brief  Run benchmarks of network size
+ *
+ *  \param  opts     Options
+ *  \param  size     Network size
+ *  \param  records  Results
+ */
+static void run_size(
+    const options       & opts,
+    const size_spec     & size,
+    std::vector<record> & records)
+{
+    const size_t syn     = synapse_cnt(size.layers);
+    const size_t in_size = size.layers.front();
+
+    weight_init w_init;
+    nn_t nn(size.layers, w_init, nn_t::BIAS);
+
+    const samples_t inputs  = random_samples(batch_rows, in_size, 2);
+    const samples_t targets = random_samples(
+        batch_rows, size.layers.back(), 3);
+
+    tset_t tset;
+    for (size_t i = 0; i < batch_rows; ++i)
+        tset.emplace_back(inputs[i], targets[i]);
+
+    // Topology construction
+    if (opts.selected("construct"))
+        records.push_back(run(opts, "construct", size, 1, 0,
+        [&size](meter & m) {
+            weight_init w_init;
+
+            m.start();
+            nn_t nn(size.layers, w_init, nn_t::BIAS);
+            m.stop();
+        }));
+
+    // Generic (neuron by neuron) evaluation
+    // (the bias source is evaluated as neuron without dendrites,
+    // which doesn't matter for the timing)
+    if (opts.selected("eval_generic")) {
+        nn_func_t f(nn.topology());
+
+        records.push_back(run(opts, "eval_generic", size, 1, 2.0 * syn,
+        [&f, &inputs](meter & m) {
+            m.start();
+            f(inputs[0]);
+            m.stop();
+        }));
+    }
+
+    // Computation reset (of the generic evaluation)
+    if (opts.selected("reset")) {
+        nn_func_t f(nn.topology());
+
+        records.push_back(run(opts, "reset", size, 1, 0,
+        [&f, &inputs](meter & m) {
+            f(inputs[0]);
+
+            m.start();
+            f.reset();
+            m.stop();
+        }));
+    }
+
+    nn_t::function_t func = nn.function();
+
+    // Single sample evaluation
+    if (opts.selected("eval_single"))
+        records.push_back(run(opts, "eval_single", size, 1, 2.0 * syn,
+        [&func, &inputs](meter & m) {
+            m.start();
+            func(inputs[0]);
+            m.stop();
+        }));
+
+    // Batch evaluation
+    if (opts.selected("eval_batch")) {
+        std::vector<base_t> outputs(batch_rows * size.layers.back());
+
+        records.push_back(run(opts, "eval_batch", size, batch_rows, 2.0 * syn,
+        [&func, &inputs, &outputs](meter & m) {
+            m.start();
+            func.batch(inputs, outputs.data());
+            m.stop();
+        }));
+    }
+
+    // Training (the learning factor is small so that the weights
+    // don't diverge during the benchmark)
+    libnn::ml::const_learning_factor<base_t> criterion(0, 0.001);
+
+    nn_t::training_t train = nn.training();
+
+    // On-line training step
+    if (opts.selected("train_online"))
+        records.push_back(run(opts, "train_online", size, 1, 6.0 * syn,
+        [&train, &tset, &criterion](meter & m) {
+            m.start();
+            train(tset[0].first, tset[0].second, criterion);
+            m.stop();
+        }));
+
+    // Batch training step
+    if (opts.selected("train_batch"))
+        records.push_back(run(opts, "train_batch", size, batch_rows, 6.0 * syn,
+        [&train, &tset, &criterion](meter & m) {
+            m.start();
+            train(tset, criterion);
+            m.stop();
+        }));
+
+    // Text (de)serialisation
+    std::ostringstream text;
+    text << nn;
+
+    if (opts.selected("save_text"))
+        records.push_back(run(opts, "save_text", size, 1, 0,
+        [&nn](meter & m) {
+            std::ostringstream out;
+
+            m.start();
+            out << nn;
+            m.stop();
+        }));
+
+    if (opts.selected("load_text"))
+        records.push_back(run(opts, "load_text", size, 1, 0,
+        [&text](meter & m) {
+            std::istringstream in(text.str());
+            nn_t nn;
+
+            m.start();
+            in >> nn;
+            m.stop();
+        }));
+
+    // Binary (de)serialisation
+    std::ostringstream binary;
+    libnn::io::serialise_binary(binary, nn);
+
+    if (opts.selected("save_binary"))
+        records.push_back(run(opts, "save_binary", size, 1, 0,
+        [&nn](meter & m) {
+            std::ostringstream out;
+
+            m.start();
+            libnn::io::serialise_binary(out, nn);
+            m.stop();
+        }));
+
+    if (opts.selected("load_binary"))
+        records.push_back(run(opts, "load_binary", size, 1, 0,
+        [&binary](meter & m) {
+            std::istringstream in(binary.str());
+            nn_t nn;
+
+            m.start();
+            libnn::io::deserialise_binary(in, nn);
+            m.stop();
+        }));
+}
+
+
+/**
+ *  \brief  Write results as CSV
+ *
+ *  \param  out      Output stream
+ *  \param  records  Results
+ */
+static void write_csv(std::ostream & out, const std::vector<record> & records) {
+    out << "benchmark,size,synapses,iterations,samples,ns_per_sample,"
+        "gflops,allocs_per_sample,bytes_per_sample,peak_rss_kib" << std::endl;
+
+    for (size_t i = 0; i < records.size(); ++i) {
+        const record & r = records[i];
+
+        out << r.bench << ',' << r.size << ',' << r.synapses << ','
+            << r.iterations << ',' << r.samples << ',' << r.ns_sample << ','
+            << r.gflops << ',' << r.allocs_sample << ',' << r.bytes_sample
+            << ',' << r.peak_rss << std::endl;
+    }
+}
+
+
+/**
+ *  \brief  Write results as JSON
+ *
+ *  One result per line, so that the files are easy to diff.
+ *
+ *  \param  out      Output stream
+ *  \param  records  Results
+ */
+static void write_json(
+    std::ostream              & out,
+    const std::vector<record> & records)
+{
+    out << "{" << std::endl
+        << "  \"isa\": \""
+        << libnn::math::cpu::name(libnn::math::cpu::isa()) << "\"," << std::endl
+        << "  \"blas\": \""
+        << libnn::math::blas::name(libnn::math::blas::backend()) << "\","
+        << std::endl
+        << "  \"results\": [" << std::endl;
+
+    for (size_t i = 0; i < records.size(); ++i) {
+        const record & r = records[i];
+
+        out << "    {\"benchmark\": \"" << r.bench
+            << "\", \"size\": \"" << r.size
+            << "\", \"synapses\": " << r.synapses
+            << ", \"iterations\": " << r.iterations
+            << ", \"samples\": " << r.samples
+            << ", \"ns_per_sample\": " << r.ns_sample
+            << ", \"gflops\": " << r.gflops
+            << ", \"allocs_per_sample\": " << r.allocs_sample
+            << ", \"bytes_per_sample\": " << r.bytes_sample
+            << ", \"peak_rss_kib\": " << r.peak_rss
+            << '}' << (i + 1 < records.size() ? "," : "") << std::endl;
+    }
+
+    out << "  ]" << std::endl << "}" << std::endl;
+}
+
+
+/**
+ *  \brief  Split comma-separated list
+ *
+ *  \param  list  List
+ *
+ *  \return Items
+ */
+static std::vector<std::string> split(const std::string & list) {
+    std::vector<std::string> items;
+
+    std::istringstream in(list);
+    for (std::string item; std::getline(in, item, ','); )
+        if (!item.empty()) items.push_back(item);
+
+    return items;
+}
+
+
+/** Print usage */
+static void usage(const char * prog) {
+    std::cerr
+        << "Usage: " << prog << " [OPTIONS]" << std::endl
+        << std::endl
+        << "libnn benchmark suite" << std::endl
+        << std::endl
+        << "Benchmarks: construct, eval_generic, reset, eval_single,"
+        << std::endl
+        << "eval_batch, train_online, train_batch, save_text, load_text,"
+        << std::endl
+        << "save_binary, load_binary" << std::endl
+        << std::endl
+        << "OPTIONS:" << std::endl
+        << "    -s SIZES   comma-separated network sizes: tiny, small,"
+        << std::endl
+        << "               medium, large, huge" << std::endl
+        << "               (default: tiny,small,medium)" << std::endl
+        << "    -b NAMES   comma-separated benchmarks (default: all)"
+        << std::endl
+        << "    -t SECS    min. measured time per benchmark (default: 0.25)"
+        << std::endl
+        << "    -o FILE    write results to FILE (JSON if it ends with .json,"
+        << std::endl
+        << "               CSV otherwise; may be repeated; default: CSV"
+        << std::endl
+        << "               to standard output)" << std::endl
+        << "    -h         this help" << std::endl;
+}
+
+
+/** Benchmark main routine */
+static int main_impl(int argc, char * const argv[]) {
+    options opts;
+    opts.sizes = split("tiny,small,medium");
+
+    for (int opt; -1 != (opt = ::getopt(argc, argv, "s:b:t:o:h")); ) {
+        switch (opt) {
+            case 's': opts.sizes   = split(optarg);         break;
+            case 'b': opts.benches = split(optarg);         break;
+            case 't': opts.time    = ::atof(optarg);        break;
+            case 'o': opts.outputs.push_back(optarg);       break;
+
+            case 'h':
+                usage(argv[0]);
+                return 0;
+
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    std::vector<record> records;
+
+    for (size_t i = 0; i < opts.sizes.size(); ++i) {
+        const size_spec * size = NULL;
+        for (size_t j = 0; j < sizeof(sizes) / sizeof(sizes[0]); ++j)
+            if (opts.sizes[i] == sizes[j].name) size = &sizes[j];
+
+        if (NULL == size)
+            throw std::runtime_error("unknown size: " + opts.sizes[i]);
+
+        run_size(opts, *size, records);
+    }
+
+    if (opts.outputs.empty()) write_csv(std::cout, records);
+
+    for (size_t i = 0; i < opts.outputs.size(); ++i) {
+        const std::string & path = opts.outputs[i];
+
+        std::ofstream out(path);
+        if (!out) throw std::runtime_error("failed to open " + path);
+
+        const bool json = 5 <= path.size()
+            && 0 == path.compare(path.size() - 5, 5, ".json");
+
+        if (json)
+            write_json(out, records);
+        else
+            write_csv(out, records);
+    }
+
+    return 0;
+}
+
+/** Exception-safe wrapper */
+int main(int argc, char * const argv[]) {
+    int exit_code = 128;
+
+    try {
+        exit_code = main_impl(argc, argv);
+    }
+    catch (const std::exception & x) {
+        std::cerr
+            << "Standard exception caught: "
+            << x.what()
+            << std::endl;
+    }
+    catch (...) {
+        std::cerr
+            << "Unhandled non-standard exception caught"
+            << std::endl;
+    }
+
+    return exit_code;
+}
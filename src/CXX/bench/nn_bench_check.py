@@ -0,0 +1,242 @@
+#!/usr/bin/env python3
+
+# Benchmark regression check
+#
+# Runs nn_bench several times, computes median and distribution-free
+# confidence interval (order statistics) of the tracked metrics and
+# compares them against stored baseline.
+#
+# Time per sample regresses if its median exceeds the baseline median
+# by more than the threshold and the confidence intervals don't overlap
+# (so that noise alone doesn't fail the check).
+# Allocations per sample are deterministic; they regress if the median
+# exceeds the baseline by more than the allocations threshold.
+#
+# Exit code: 0 (no regression), 1 (regression), 2 (error)
+
+import sys
+import os
+import math
+import json
+import argparse
+import tempfile
+import subprocess
+
+
+TIME   = "ns_per_sample"      # time metric
+ALLOCS = "allocs_per_sample"  # allocations metric
+
+
+def median(values):
+    """Median"""
+
+    v = sorted(values)
+    n = len(v)
+
+    return v[n // 2] if n % 2 else (v[n // 2 - 1] + v[n // 2]) / 2.0
+
+
+def median_ci(values, level=0.95):
+    """Median confidence interval (order statistics)
+
+    Returns the narrowest symmetric interval [v(j), v(n-1-j)] with
+    coverage at least level (or the full range if there are too few
+    values).
+    """
+
+    v = sorted(values)
+    n = len(v)
+
+    # P(v(j) <= median <= v(n-1-j)) = 1 - 2 * P(Bin(n, 1/2) <= j)
+    j = 0
+    cdf = 0.5 ** n  # P(Bin(n, 1/2) <= 0)
+    while j + 1 < n - 1 - (j + 1):
+        cdf_next = cdf + math.comb(n, j + 1) * 0.5 ** n
+        if 1.0 - 2.0 * cdf_next < level: break
+
+        j += 1
+        cdf = cdf_next
+
+    return v[j], v[n - 1 - j]
+
+
+def run_bench(bench, sizes, benches, time, runs):
+    """Run benchmark suite
+
+    Returns run results (list of nn_bench JSON documents).
+    """
+
+    results = []
+
+    fd, path = tempfile.mkstemp(suffix=".json")
+    os.close(fd)
+
+    try:
+        for i in range(runs):
+            print("Run %d/%d" % (i + 1, runs), flush=True)
+
+            cmd = [bench, "-s", sizes, "-t", str(time), "-o", path]
+            if benches: cmd += ["-b", benches]
+
+            subprocess.run(cmd, check=True, stdout=subprocess.DEVNULL)
+
+            with open(path) as f:
+                results.append(json.load(f))
+
+    finally:
+        os.unlink(path)
+
+    return results
+
+
+def summarise(results):
+    """Summarise run results
+
+    Returns summary document: ISA, BLAS, run count and metrics
+    (median, CI) for each benchmark & size.
+    """
+
+    samples = {}
+    for result in results:
+        for rec in result["results"]:
+            key = rec["benchmark"] + "/" + rec["size"]
+            entry = samples.setdefault(key, {TIME: [], ALLOCS: []})
+            entry[TIME].append(rec[TIME])
+            entry[ALLOCS].append(rec[ALLOCS])
+
+    benchmarks = {}
+    for key, entry in samples.items():
+        benchmarks[key] = {}
+        for metric, values in entry.items():
+            lo, hi = median_ci(values)
+            benchmarks[key][metric] = {
+                "median":  median(values),
+                "ci_low":  lo,
+                "ci_high": hi,
+            }
+
+    return {
+        "isa":        results[0]["isa"],
+        "blas":       results[0]["blas"],
+        "runs":       len(results),
+        "benchmarks": benchmarks,
+    }
+
+
+def compare(baseline, current, threshold, allocs_threshold):
+    """Compare summaries
+
+    Prints comparison table, returns count of regressions.
+    """
+
+    regression_cnt = 0
+
+    if baseline["isa"] != current["isa"] or baseline["blas"] != current["blas"]:
+        print("WARNING: baseline measured with ISA %s, BLAS %s "
+              "(current: ISA %s, BLAS %s)" % (
+              baseline["isa"], baseline["blas"],
+              current["isa"], current["blas"]))
+
+    fmt = "%-24s %-18s %14s %14s %9s  %s"
+    row = lambda *cols: print((fmt % cols).rstrip())
+
+    row("benchmark", "metric", "baseline", "current", "change", "")
+
+    base_bench = baseline["benchmarks"]
+    curr_bench = current["benchmarks"]
+
+    for key in sorted(set(base_bench) | set(curr_bench)):
+        if key not in curr_bench:
+            row(key, "", "", "", "", "not measured")
+            continue
+
+        if key not in base_bench:
+            row(key, "", "", "", "", "no baseline")
+            continue
+
+        for metric, thr in ((TIME, threshold), (ALLOCS, allocs_threshold)):
+            base = base_bench[key][metric]
+            curr = curr_bench[key][metric]
+
+            change = ((curr["median"] / base["median"] - 1.0) * 100.0
+                if base["median"] else
+                (0.0 if not curr["median"] else math.inf))
+
+            regressed = change > thr
+            if TIME == metric:  # noise check
+                regressed = regressed and curr["ci_low"] > base["ci_high"]
+
+            verdict = ""
+            if regressed:
+                verdict = "REGRESSION (threshold %g%%)" % thr
+                regression_cnt += 1
+            elif change < -thr and (TIME != metric
+                or curr["ci_high"] < base["ci_low"]):
+                verdict = "improvement"
+
+            row(key, metric, "%.6g" % base["median"], "%.6g" % curr["median"],
+                "%+.1f%%" % change, verdict)
+
+    return regression_cnt
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Benchmark regression check")
+
+    parser.add_argument("--bench", default="./nn_bench",
+        help="nn_bench executable (default: ./nn_bench)")
+    parser.add_argument("--baseline", required=True,
+        help="baseline JSON file")
+    parser.add_argument("--update", action="store_true",
+        help="store the measurement as a new baseline")
+    parser.add_argument("--runs", type=int, default=5,
+        help="count of benchmark suite runs (default: 5)")
+    parser.add_argument("--sizes", default="tiny,small",
+        help="network sizes (default: tiny,small)")
+    parser.add_argument("--benches", default="",
+        help="benchmarks (default: all)")
+    parser.add_argument("--time", type=float, default=0.1,
+        help="min. time per benchmark [s] (default: 0.1)")
+    parser.add_argument("--threshold", type=float, default=10.0,
+        help="time regression threshold [%%] (default: 10)")
+    parser.add_argument("--allocs-threshold", type=float, default=0.0,
+        help="allocations regression threshold [%%] (default: 0)")
+
+    args = parser.parse_args()
+
+    if args.runs < 1:
+        parser.error("at least one run is required")
+
+    current = summarise(run_bench(
+        args.bench, args.sizes, args.benches, args.time, args.runs))
+
+    if args.update:
+        with open(args.baseline, "w") as f:
+            json.dump(current, f, indent=2, sort_keys=True)
+            f.write("\n")
+
+        print("Baseline stored to " + args.baseline)
+        return 0
+
+    with open(args.baseline) as f:
+        baseline = json.load(f)
+
+    regression_cnt = compare(
+        baseline, current, args.threshold, args.allocs_threshold)
+
+    if regression_cnt:
+        print("%d regression(s) found" % regression_cnt)
+        return 1
+
+    print("No regressions found")
+    return 0
+
+
+if __name__ == "__main__":
+    try:
+        sys.exit(main())
+
+    except (OSError, ValueError, KeyError, subprocess.CalledProcessError) as x:
+        print("ERROR: " + str(x), file=sys.stderr)
+        sys.exit(2)
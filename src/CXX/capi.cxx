@@ -0,0 +1,722 @@
+/**
+ *  libnn C API implementation
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "config.hxx"
+
+#include "libnn/capi.h"
+
+#include "libnn/model/feed_forward.hxx"
+#include "libnn/ml/backpropagation.hxx"
+#include "libnn/math/sigmoid.hxx"
+#include "libnn/math/util.hxx"
+#include "libnn/misc/array_view.hxx"
+#include "libnn/io/sigmoid.hxx"
+#include "libnn/io/feed_forward.hxx"
+#include "libnn/io/binary.hxx"
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <fstream>
+#include <streambuf>
+#include <exception>
+#include <stdexcept>
+#include <new>
+#include <cstdlib>
+
+#include <pthread.h>
+
+
+namespace {
+
+/** Last error detail (per thread) */
+thread_local std::string last_error;
+
+
+/**
+ *  \brief  Set error
+ *
+ *  \param  status  Status
+ *  \param  detail  Error detail
+ *
+ *  \return \c status
+ */
+libnn_status error(libnn_status status, const char * detail) {
+    try {
+        last_error = detail;
+    }
+    catch (...) {}  // the status is still provided
+
+    return status;
+}
+
+
+/**
+ *  \brief  Run function, translate exceptions to status
+ *
+ *  \tparam Fn  Function type
+ *  \param  fn  Function
+ *
+ *  \return Status
+ */
+template <class Fn>
+libnn_status guard(Fn fn) {
+    try {
+        fn();
+    }
+    catch (const std::bad_alloc & ) {
+        return error(LIBNN_ENOMEM, "out of memory");
+    }
+    catch (const std::logic_error & x) {
+        return error(LIBNN_EINVAL, x.what());
+    }
+    catch (const std::range_error & x) {
+        return error(LIBNN_EINVAL, x.what());
+    }
+    catch (const std::exception & x) {
+        return error(LIBNN_EINTERNAL, x.what());
+    }
+    catch (...) {
+        return error(LIBNN_EINTERNAL, "unknown exception");
+    }
+
+    return LIBNN_OK;
+}
+
+
+/** Read/write lock guard */
+class rwlock_guard {
+    private:
+
+    pthread_rwlock_t & m_lock;  /**< Lock */
+
+    public:
+
+    /**
+     *  \brief  Constructor (locks)
+     *
+     *  \param  lock   Lock
+     *  \param  write  Write (exclusive) lock
+     */
+    rwlock_guard(pthread_rwlock_t & lock, bool write): m_lock(lock) {
+        if (write)
+            pthread_rwlock_wrlock(&m_lock);
+        else
+            pthread_rwlock_rdlock(&m_lock);
+    }
+
+    /** Destructor (unlocks) */
+    ~rwlock_guard() { pthread_rwlock_unlock(&m_lock); }
+
+    /** Copying is forbidden */
+    rwlock_guard(const rwlock_guard & orig) = delete;
+
+    /** Assignment is forbidden */
+    void operator = (const rwlock_guard & rarg) = delete;
+
+};  // end of class rwlock_guard
+
+
+/** Read-only memory stream buffer (no copy of the data) */
+class membuf: public std::streambuf {
+    public:
+
+    /** Constructor */
+    membuf(const void * data, size_t size) {
+        char * begin = const_cast<char *>(static_cast<const char *>(data));
+        setg(begin, begin, begin + size);
+    }
+
+};  // end of class membuf
+
+}  // end of anonymous namespace
+
+
+/**
+ *  \brief  Model (type-erased)
+ *
+ *  The model lock protects the synapses weights: evaluation and saving
+ *  take it shared, training exclusively.
+ *  The contexts re-read the weights after training by themselves
+ *  (see \c libnn::topo::nn::version).
+ */
+struct libnn_model {
+    const libnn_dtype dtype;  /**< Base numeric type */
+    pthread_rwlock_t  lock;   /**< Weights lock      */
+
+    /**
+     *  \brief  Constructor
+     *
+     *  Writers are preferred where supported (otherwise, training could
+     *  starve while the model is evaluated continuously).
+     *
+     *  \param  dt  Base numeric type
+     */
+    libnn_model(libnn_dtype dt): dtype(dt) {
+        pthread_rwlockattr_t attr;
+        pthread_rwlockattr_init(&attr);
+#ifdef __GLIBC__
+        pthread_rwlockattr_setkind_np(&attr,
+            PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP);
+#endif
+
+        const int rc = pthread_rwlock_init(&lock, &attr);
+        pthread_rwlockattr_destroy(&attr);
+
+        if (rc)
+            throw std::runtime_error(
+                "libnn_model: "
+                "failed to initialise lock");
+    }
+
+    /** Input size */
+    virtual size_t input_size() const = 0;
+
+    /** Output size */
+    virtual size_t output_size() const = 0;
+
+    /**
+     *  \brief  Load model
+     *
+     *  \param  in      Input stream
+     *  \param  format  Data format
+     */
+    virtual void load(std::istream & in, libnn_format format) = 0;
+
+    /**
+     *  \brief  Save model
+     *
+     *  \param  out     Output stream
+     *  \param  format  Data format
+     */
+    virtual void save(std::ostream & out, libnn_format format) const = 0;
+
+    /**
+     *  \brief  Create context
+     *
+     *  \param  max_rows  Rows per call processed without memory allocation
+     */
+    virtual libnn_context * context(size_t max_rows) = 0;
+
+    /** Destructor */
+    virtual ~libnn_model() { pthread_rwlock_destroy(&lock); }
+
+};  // end of struct libnn_model
+
+
+/** Context (type-erased) */
+struct libnn_context {
+    libnn_model * const model;  /**< Model */
+
+    /** Constructor */
+    libnn_context(libnn_model * m): model(m) {}
+
+    /** Destructor */
+    virtual ~libnn_context() {}
+
+};  // end of struct libnn_context
+
+
+namespace {
+
+/** Model base numeric type */
+template <typename Base_t> struct dtype_of;
+
+/** \cond */
+template <> struct dtype_of<float>  {
+    static const libnn_dtype value = LIBNN_FLOAT;
+};
+template <> struct dtype_of<double> {
+    static const libnn_dtype value = LIBNN_DOUBLE;
+};
+/** \endcond */
+
+
+/**
+ *  \brief  Model implementation
+ *
+ *  \tparam  Base_t  Base numeric type
+ */
+template <typename Base_t>
+struct model_impl: public libnn_model {
+    /** Network */
+    typedef libnn::model::feed_forward<Base_t,
+        libnn::math::logistic_fn<Base_t> > nn_t;
+
+    nn_t nn;  /**< Network */
+
+    /** Constructor (empty network) */
+    model_impl(): libnn_model(dtype_of<Base_t>::value) {}
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  layers    Layer sizes
+     *  \param  w_init    Weight initialiser
+     *  \param  features  Features
+     */
+    model_impl(
+        const std::vector<size_t>               & layers,
+        libnn::math::rng_uniform_seeded<Base_t> & w_init,
+        int                                       features)
+    :
+        libnn_model(dtype_of<Base_t>::value),
+        nn(layers, w_init, features)
+    {}
+
+    size_t input_size() const { return nn.layer(0).size(); }
+
+    size_t output_size() const {
+        return nn.layer(nn.layer_cnt() - 1).size();
+    }
+
+    void load(std::istream & in, libnn_format format) {
+        if (LIBNN_BINARY == format)
+            libnn::io::deserialise_binary(in, nn);
+        else
+            libnn::io::deserialise(in, nn);
+    }
+
+    void save(std::ostream & out, libnn_format format) const {
+        if (LIBNN_BINARY == format)
+            libnn::io::serialise_binary(out, nn);
+        else
+            libnn::io::serialise(out, nn);
+    }
+
+    libnn_context * context(size_t max_rows);
+
+};  // end of template struct model_impl
+
+
+/**
+ *  \brief  Context implementation
+ *
+ *  \tparam  Base_t  Base numeric type
+ */
+template <typename Base_t>
+struct context_impl: public libnn_context {
+    typedef model_impl<Base_t>                 model_t;     /**< Model    */
+    typedef typename model_t::nn_t::function_t function_t;  /**< Function */
+    typedef typename model_t::nn_t::training_t training_t;  /**< Training */
+
+    typedef libnn::misc::matrix_view<const Base_t>   matrix_t;  /**< Data */
+    typedef libnn::misc::training_view<const Base_t> tset_t;    /**< Set  */
+
+    size_t                      max_rows;  /**< Reserved rows   */
+    function_t                  function;  /**< Function        */
+    std::unique_ptr<training_t> training;  /**< Training (lazy) */
+
+    /** Constructor */
+    context_impl(model_t & model, size_t rows):
+        libnn_context(&model),
+        max_rows(rows),
+        function(model.nn.function())
+    {
+        function.reserve(max_rows);
+    }
+
+    /** Model */
+    model_t & get_model() const { return *static_cast<model_t *>(model); }
+
+    /** Evaluation */
+    void eval(const Base_t * x, size_t rows, Base_t * y) {
+        model_t & m = get_model();
+
+        rwlock_guard lock(m.lock, false);
+
+        function.batch(matrix_t(x, rows, m.input_size()), y);
+    }
+
+    /** Training step */
+    Base_t train(const Base_t * x, const Base_t * y, size_t rows, Base_t alpha) {
+        model_t & m = get_model();
+
+        rwlock_guard lock(m.lock, true);
+
+        if (!training) {
+            training.reset(new training_t(m.nn.training()));
+            training->reserve(max_rows);
+        }
+
+        libnn::ml::const_learning_factor<Base_t> criterion(0, alpha);
+
+        const Base_t error = (*training)(tset_t(
+            matrix_t(x, rows, m.input_size()),
+            matrix_t(y, rows, m.output_size())), criterion);
+
+        return error;
+    }
+
+};  // end of template struct context_impl
+
+
+template <typename Base_t>
+libnn_context * model_impl<Base_t>::context(size_t max_rows) {
+    rwlock_guard lock(this->lock, false);
+
+    return new context_impl<Base_t>(*this, max_rows);
+}
+
+
+/**
+ *  \brief  Load model
+ *
+ *  \param  in      Input stream
+ *  \param  format  Data format
+ *  \param  dtype   Base numeric type
+ *  \param  model   Loaded model
+ *
+ *  \return Status
+ */
+libnn_status load(
+    std::istream & in,
+    libnn_format   format,
+    libnn_dtype    dtype,
+    libnn_model ** model)
+{
+    if (NULL == model || (LIBNN_TEXT != format && LIBNN_BINARY != format))
+        return error(LIBNN_EINVAL, "invalid argument");
+
+    std::unique_ptr<libnn_model> m;
+
+    libnn_status status = guard([&]() {
+        switch (dtype) {
+            case LIBNN_FLOAT:  m.reset(new model_impl<float>());  break;
+            case LIBNN_DOUBLE: m.reset(new model_impl<double>()); break;
+
+            default:
+                throw std::logic_error("invalid base numeric type");
+        }
+    });
+
+    if (LIBNN_OK != status) return status;
+
+    status = guard([&]() { m->load(in, format); });
+
+    // Deserialisation errors mean malformed data
+    if (LIBNN_OK != status && LIBNN_ENOMEM != status)
+        status = LIBNN_EFORMAT;
+
+    if (LIBNN_OK == status) *model = m.release();
+
+    return status;
+}
+
+
+/**
+ *  \brief  Check evaluation/training arguments
+ *
+ *  \param  ctx    Context
+ *  \param  dtype  Base numeric type of the call
+ *  \param  x      Inputs
+ *  \param  y      Outputs
+ *  \param  rows   Row count
+ *
+ *  \return Status
+ */
+libnn_status check_args(
+    libnn_context * ctx,
+    libnn_dtype     dtype,
+    const void *    x,
+    const void *    y,
+    size_t          rows)
+{
+    if (NULL == ctx)
+        return error(LIBNN_EINVAL, "no context");
+
+    if (dtype != ctx->model->dtype)
+        return error(LIBNN_EINVAL, "model base numeric type mismatch");
+
+    if (rows && (NULL == x || NULL == y))
+        return error(LIBNN_EINVAL, "no data");
+
+    return LIBNN_OK;
+}
+
+
+/** Evaluation */
+template <typename Base_t>
+libnn_status eval(
+    libnn_context * ctx,
+    const Base_t *  x,
+    size_t          rows,
+    Base_t *        y)
+{
+    libnn_status status = check_args(ctx, dtype_of<Base_t>::value, x, y, rows);
+    if (LIBNN_OK != status || 0 == rows) return status;
+
+    return guard([&]() {
+        static_cast<context_impl<Base_t> *>(ctx)->eval(x, rows, y);
+    });
+}
+
+
+/** Training step */
+template <typename Base_t>
+libnn_status train(
+    libnn_context * ctx,
+    const Base_t *  x,
+    const Base_t *  y,
+    size_t          rows,
+    Base_t          alpha,
+    Base_t *        error_out)
+{
+    libnn_status status = check_args(ctx, dtype_of<Base_t>::value, x, y, rows);
+    if (LIBNN_OK != status) return status;
+
+    if (0 == rows)
+        return error(LIBNN_EINVAL, "empty training set");
+
+    return guard([&]() {
+        const Base_t err = static_cast<context_impl<Base_t> *>(ctx)->train(
+            x, y, rows, alpha);
+
+        if (error_out) *error_out = err;
+    });
+}
+
+}  // end of anonymous namespace
+
+
+extern "C" {
+
+int libnn_abi_version(void) { return LIBNN_ABI_VERSION; }
+
+
+const char * libnn_strerror(libnn_status status) {
+    switch (status) {
+        case LIBNN_OK:        return "success";
+        case LIBNN_EINVAL:    return "invalid argument";
+        case LIBNN_ENOMEM:    return "out of memory";
+        case LIBNN_EIO:       return "I/O error";
+        case LIBNN_EFORMAT:   return "malformed or incompatible model data";
+        case LIBNN_EINTERNAL: return "internal error";
+    }
+
+    return "unknown status";
+}
+
+
+const char * libnn_last_error(void) { return last_error.c_str(); }
+
+
+libnn_status libnn_model_create(
+    libnn_dtype    dtype,
+    const size_t * layers,
+    size_t         layer_cnt,
+    int            features,
+    double         w_min,
+    double         w_max,
+    unsigned       seed,
+    libnn_model ** model)
+{
+    if (NULL == model || NULL == layers || layer_cnt < 2 ||
+        (features & ~(LIBNN_BIAS | LIBNN_LATERAL)))
+    {
+        return error(LIBNN_EINVAL, "invalid argument");
+    }
+
+    return guard([&]() {
+        const std::vector<size_t> spec(layers, layers + layer_cnt);
+
+        switch (dtype) {
+            case LIBNN_FLOAT: {
+                libnn::math::rng_uniform_seeded<float> w_init(
+                    w_min, w_max, seed);
+                *model = new model_impl<float>(spec, w_init, features);
+                break;
+            }
+
+            case LIBNN_DOUBLE: {
+                libnn::math::rng_uniform_seeded<double> w_init(
+                    w_min, w_max, seed);
+                *model = new model_impl<double>(spec, w_init, features);
+                break;
+            }
+
+            default:
+                throw std::logic_error("invalid base numeric type");
+        }
+    });
+}
+
+
+libnn_status libnn_model_load(
+    const char *   path,
+    libnn_format   format,
+    libnn_dtype    dtype,
+    libnn_model ** model)
+{
+    if (NULL == path) return error(LIBNN_EINVAL, "no path");
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return error(LIBNN_EIO, "failed to open file");
+
+    return load(file, format, dtype, model);
+}
+
+
+libnn_status libnn_model_load_mem(
+    const void *   data,
+    size_t         size,
+    libnn_format   format,
+    libnn_dtype    dtype,
+    libnn_model ** model)
+{
+    if (NULL == data && size) return error(LIBNN_EINVAL, "no data");
+
+    membuf buf(data, size);
+    std::istream in(&buf);
+
+    return load(in, format, dtype, model);
+}
+
+
+libnn_status libnn_model_save(
+    libnn_model * model,
+    const char *  path,
+    libnn_format  format)
+{
+    if (NULL == model || NULL == path ||
+        (LIBNN_TEXT != format && LIBNN_BINARY != format))
+    {
+        return error(LIBNN_EINVAL, "invalid argument");
+    }
+
+    libnn_status status = LIBNN_OK;
+
+    libnn_status s = guard([&]() {
+        std::ofstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            status = error(LIBNN_EIO, "failed to create file");
+            return;
+        }
+
+        {
+            rwlock_guard lock(model->lock, false);
+            model->save(file, format);
+        }
+
+        file.close();
+        if (file.fail()) status = error(LIBNN_EIO, "failed to write file");
+    });
+
+    return LIBNN_OK == s ? status : s;
+}
+
+
+void libnn_model_destroy(libnn_model * model) { delete model; }
+
+
+libnn_dtype libnn_model_dtype(const libnn_model * model) {
+    return model->dtype;
+}
+
+
+size_t libnn_model_input_size(const libnn_model * model) {
+    return model->input_size();
+}
+
+
+size_t libnn_model_output_size(const libnn_model * model) {
+    return model->output_size();
+}
+
+
+libnn_status libnn_context_create(
+    libnn_model *    model,
+    size_t           max_rows,
+    libnn_context ** ctx)
+{
+    if (NULL == model || NULL == ctx)
+        return error(LIBNN_EINVAL, "invalid argument");
+
+    return guard([&]() { *ctx = model->context(max_rows); });
+}
+
+
+void libnn_context_destroy(libnn_context * ctx) { delete ctx; }
+
+
+libnn_status libnn_eval_f32(
+    libnn_context * ctx,
+    const float *   x,
+    size_t          rows,
+    float *         y)
+{
+    return eval(ctx, x, rows, y);
+}
+
+
+libnn_status libnn_eval_f64(
+    libnn_context * ctx,
+    const double *  x,
+    size_t          rows,
+    double *        y)
+{
+    return eval(ctx, x, rows, y);
+}
+
+
+libnn_status libnn_train_f32(
+    libnn_context * ctx,
+    const float *   x,
+    const float *   y,
+    size_t          rows,
+    float           alpha,
+    float *         error)
+{
+    return train(ctx, x, y, rows, alpha, error);
+}
+
+
+libnn_status libnn_train_f64(
+    libnn_context * ctx,
+    const double *  x,
+    const double *  y,
+    size_t          rows,
+    double          alpha,
+    double *        error)
+{
+    return train(ctx, x, y, rows, alpha, error);
+}
+
+}  // end of extern "C"
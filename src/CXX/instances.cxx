@@ -0,0 +1,73 @@
+/**
+ *  Explicit template instantiations
+ *
+ *  See libnn/instances.hxx.
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "config.hxx"
+
+#include "libnn/instances.hxx"
+#include "libnn/topo/nn.hxx"
+#include "libnn/ml/nn_func.hxx"
+#include "libnn/ml/backpropagation.hxx"
+#include "libnn/ml/layered.hxx"
+
+
+#ifdef LIBNN_HEADER_ONLY
+#error "the library can't be built with LIBNN_HEADER_ONLY"
+#endif
+
+
+namespace libnn {
+
+/** \cond */
+#define LIBNN_INSTANTIATE(Base_t, Act_fn) \
+    template class topo::nn<Base_t, Act_fn>; \
+    template class ml::computation<Base_t, Act_fn, Base_t>; \
+    template class ml::nn_func<Base_t, Act_fn>; \
+    template class ml::backpropagation<Base_t, Act_fn>; \
+    template class ml::impl::layered_net<Base_t, Act_fn>; \
+    template class ml::layered_func<Base_t, Act_fn>; \
+    template class ml::layered_backprop<Base_t, Act_fn>;
+LIBNN_INSTANCES(LIBNN_INSTANTIATE)
+
+#undef LIBNN_INSTANTIATE
+/** \endcond */
+
+}  // end of namespace libnn
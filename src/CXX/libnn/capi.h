@@ -0,0 +1,314 @@
+#ifndef libnn__capi_h
+#define libnn__capi_h
+
+/**
+ *  libnn C API
+ *
+ *  Stable C interface for FFI consumers (link with -lnn).
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stddef.h>
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  \brief  ABI version
+ *
+ *  Incremented on incompatible changes of the C API.
+ */
+#define LIBNN_ABI_VERSION 1
+
+/** Exported symbol (the library is built with hidden visibility) */
+#if defined(__GNUC__) && 4 <= __GNUC__
+#define LIBNN_API __attribute__((visibility("default")))
+#else
+#define LIBNN_API
+#endif
+
+
+/** Status codes */
+typedef enum libnn_status {
+    LIBNN_OK        = 0,  /**< Success                               */
+    LIBNN_EINVAL    = 1,  /**< Invalid argument                      */
+    LIBNN_ENOMEM    = 2,  /**< Out of memory                         */
+    LIBNN_EIO       = 3,  /**< I/O error                             */
+    LIBNN_EFORMAT   = 4,  /**< Malformed or incompatible model data  */
+    LIBNN_EINTERNAL = 5,  /**< Internal error                        */
+} libnn_status;
+
+/** Base numeric types */
+typedef enum libnn_dtype {
+    LIBNN_FLOAT  = 0,  /**< \c float  */
+    LIBNN_DOUBLE = 1,  /**< \c double */
+} libnn_dtype;
+
+/** Model data formats */
+typedef enum libnn_format {
+    LIBNN_TEXT   = 0,  /**< Text (portable, see \c libnn/io)          */
+    LIBNN_BINARY = 1,  /**< Binary (compact, host representation)     */
+} libnn_format;
+
+/** Model features (bits) */
+enum {
+    LIBNN_BIAS    = 0x1,  /**< Use bias                               */
+    LIBNN_LATERAL = 0x2,  /**< Synapses to previous neurons in layer  */
+};
+
+
+/**
+ *  \brief  Model
+ *
+ *  Feed-forward neural network with logistic activation.
+ *  A model may be shared by any number of contexts (and threads).
+ */
+typedef struct libnn_model libnn_model;
+
+/**
+ *  \brief  Context
+ *
+ *  Evaluation and training state of a model; holds all the buffers,
+ *  so the calls don't allocate memory.
+ *  A context may only be used by one thread at a time; contexts of
+ *  the same model may be used concurrently (evaluation runs in parallel,
+ *  training is exclusive).
+ */
+typedef struct libnn_context libnn_context;
+
+
+/** ABI version of the library (see \ref LIBNN_ABI_VERSION) */
+LIBNN_API int libnn_abi_version(void);
+
+/**
+ *  \brief  Status description
+ *
+ *  \param  status  Status
+ *
+ *  \return Static string
+ */
+LIBNN_API const char * libnn_strerror(libnn_status status);
+
+/**
+ *  \brief  Last error detail
+ *
+ *  \return Description of the last error of the calling thread
+ *          (valid until the next failing call of the thread)
+ */
+LIBNN_API const char * libnn_last_error(void);
+
+
+/**
+ *  \brief  Create model
+ *
+ *  Synapses weights are initialised ~ U(w_min, w_max).
+ *
+ *  \param  dtype      Base numeric type
+ *  \param  layers     Layer sizes (input layer first, output layer last)
+ *  \param  layer_cnt  Layer count (at least 2)
+ *  \param  features   Feature bits (\c LIBNN_BIAS, \c LIBNN_LATERAL)
+ *  \param  w_min      Weight minimum
+ *  \param  w_max      Weight maximum
+ *  \param  seed       Weight generator seed (same seed, same weights)
+ *  \param  model      Created model
+ *
+ *  \return Status
+ */
+LIBNN_API libnn_status libnn_model_create(
+    libnn_dtype    dtype,
+    const size_t * layers,
+    size_t         layer_cnt,
+    int            features,
+    double         w_min,
+    double         w_max,
+    unsigned       seed,
+    libnn_model ** model);
+
+/**
+ *  \brief  Load model from file
+ *
+ *  \param  path    File path
+ *  \param  format  Data format
+ *  \param  dtype   Base numeric type
+ *  \param  model   Loaded model
+ *
+ *  \return Status
+ */
+LIBNN_API libnn_status libnn_model_load(
+    const char *   path,
+    libnn_format   format,
+    libnn_dtype    dtype,
+    libnn_model ** model);
+
+/**
+ *  \brief  Load model from memory
+ *
+ *  \param  data    Model data
+ *  \param  size    Data size
+ *  \param  format  Data format
+ *  \param  dtype   Base numeric type
+ *  \param  model   Loaded model
+ *
+ *  \return Status
+ */
+LIBNN_API libnn_status libnn_model_load_mem(
+    const void *   data,
+    size_t         size,
+    libnn_format   format,
+    libnn_dtype    dtype,
+    libnn_model ** model);
+
+/**
+ *  \brief  Save model to file
+ *
+ *  \param  model   Model
+ *  \param  path    File path
+ *  \param  format  Data format
+ *
+ *  \return Status
+ */
+LIBNN_API libnn_status libnn_model_save(
+    libnn_model * model,
+    const char *  path,
+    libnn_format  format);
+
+/**
+ *  \brief  Destroy model
+ *
+ *  All the model contexts must be destroyed before.
+ *
+ *  \param  model  Model (may be \c NULL)
+ */
+LIBNN_API void libnn_model_destroy(libnn_model * model);
+
+/** Model base numeric type */
+LIBNN_API libnn_dtype libnn_model_dtype(const libnn_model * model);
+
+/** Model input size */
+LIBNN_API size_t libnn_model_input_size(const libnn_model * model);
+
+/** Model output size */
+LIBNN_API size_t libnn_model_output_size(const libnn_model * model);
+
+
+/**
+ *  \brief  Create context
+ *
+ *  \param  model     Model
+ *  \param  max_rows  Rows per call processed without memory allocation
+ *  \param  ctx       Created context
+ *
+ *  \return Status
+ */
+LIBNN_API libnn_status libnn_context_create(
+    libnn_model *    model,
+    size_t           max_rows,
+    libnn_context ** ctx);
+
+/**
+ *  \brief  Destroy context
+ *
+ *  \param  ctx  Context (may be \c NULL)
+ */
+LIBNN_API void libnn_context_destroy(libnn_context * ctx);
+
+
+/**
+ *  \brief  Evaluate model (\c float model)
+ *
+ *  \param  ctx   Context
+ *  \param  x     Inputs (row-major, \c rows x input size)
+ *  \param  rows  Row count
+ *  \param  y     Outputs (row-major, \c rows x output size)
+ *
+ *  \return Status
+ */
+LIBNN_API libnn_status libnn_eval_f32(
+    libnn_context * ctx,
+    const float *   x,
+    size_t          rows,
+    float *         y);
+
+/** Evaluate model (\c double model); see \ref libnn_eval_f32 */
+LIBNN_API libnn_status libnn_eval_f64(
+    libnn_context * ctx,
+    const double *  x,
+    size_t          rows,
+    double *        y);
+
+/**
+ *  \brief  Training step (\c float model)
+ *
+ *  Backpropagation on the training set (batch); the weights are updated
+ *  once.
+ *  The first call allocates the context training buffers.
+ *
+ *  \param  ctx    Context
+ *  \param  x      Inputs (row-major, \c rows x input size)
+ *  \param  y      Desired outputs (row-major, \c rows x output size)
+ *  \param  rows   Row count
+ *  \param  alpha  Learning factor
+ *  \param  error  Error norm squared average (before the update;
+ *                 may be \c NULL)
+ *
+ *  \return Status
+ */
+LIBNN_API libnn_status libnn_train_f32(
+    libnn_context * ctx,
+    const float *   x,
+    const float *   y,
+    size_t          rows,
+    float           alpha,
+    float *         error);
+
+/** Training step (\c double model); see \ref libnn_train_f32 */
+LIBNN_API libnn_status libnn_train_f64(
+    libnn_context * ctx,
+    const double *  x,
+    const double *  y,
+    size_t          rows,
+    double          alpha,
+    double *        error);
+
+#ifdef __cplusplus
+}  // end of extern "C"
+#endif
+
+
+#endif  // end of #ifndef libnn__capi_h
@@ -0,0 +1,70 @@
+#ifndef libnn__instances_hxx
+#define libnn__instances_hxx
+
+/**
+ *  Explicitly instantiated configurations
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libnn/math/sigmoid.hxx"
+
+
+/**
+ *  \brief  Compiled configurations
+ *
+ *  The library (\c libnn.la) explicitly instantiates the network
+ *  topology, computation and training templates for the configurations
+ *  (base numeric type and activation function) listed here; the headers
+ *  declare them \c extern, so the translation units including them don't
+ *  instantiate them again (but link them from the library).
+ *
+ *  Define \c LIBNN_HEADER_ONLY to use the headers without the library
+ *  (everything is then instantiated implicitly, as needed).
+ *
+ *  The macro applies macro \c M to each configuration
+ *  (as \c M(Base_t, Act_fn)).
+ */
+#define LIBNN_INSTANCES(M) \
+    M(float,  libnn::math::logistic_fn<float>) \
+    M(double, libnn::math::logistic_fn<double>) \
+    M(float,  libnn::math::hyperbolic_tangent_fn<float>) \
+    M(double, libnn::math::hyperbolic_tangent_fn<double>) \
+    M(float,  libnn::math::identity_fn<float>) \
+    M(double, libnn::math::identity_fn<double>)
+
+
+#endif  // end of #ifndef libnn__instances_hxx
@@ -0,0 +1,369 @@
+#ifndef libnn__io__binary_hxx
+#define libnn__io__binary_hxx
+
+/**
+ *  Neural network binary (de)serialisation
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libnn/topo/nn.hxx"
+#include "libnn/model/feed_forward.hxx"
+
+#include <iostream>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+
+namespace libnn {
+namespace io {
+
+namespace impl {
+
+/** Binary format magic */
+static const char binary_magic[4] = { 'L', 'N', 'N', 'B' };
+
+/** Binary format version */
+static const uint32_t binary_version = 1;
+
+/** Byte order mark (written in host byte order) */
+static const uint32_t binary_bom = 0x01020304;
+
+
+/**
+ *  \brief  Write binary value
+ *
+ *  \tparam T    Value type (trivially copyable)
+ *  \param  out  Output stream
+ *  \param  val  Value
+ */
+template <typename T>
+inline void write_binary(std::ostream & out, const T & val) {
+    out.write(reinterpret_cast<const char *>(&val), sizeof(val));
+}
+
+
+/**
+ *  \brief  Read binary value
+ *
+ *  Throws an exception on premature end of input.
+ *
+ *  \tparam T   Value type (trivially copyable)
+ *  \param  in  Input stream
+ *
+ *  \return Value
+ */
+template <typename T>
+inline T read_binary(std::istream & in) {
+    T val;
+    if (in.read(reinterpret_cast<char *>(&val), sizeof(val)).fail())
+        throw std::runtime_error(
+            "libnn::io::deserialise_binary: "
+            "premature end of input");
+
+    return val;
+}
+
+
+/**
+ *  \brief  Write binary format header
+ *
+ *  \tparam Base_t  Base numeric type
+ *  \param  out     Output stream
+ *  \param  tag     Section tag (4 characters)
+ */
+template <typename Base_t>
+void write_binary_header(std::ostream & out, const char * tag) {
+    out.write(binary_magic, sizeof(binary_magic));
+    write_binary(out, binary_version);
+    write_binary(out, binary_bom);
+    write_binary<uint32_t>(out, sizeof(Base_t));
+    out.write(tag, 4);
+}
+
+
+/**
+ *  \brief  Read and check binary format header
+ *
+ *  \tparam Base_t  Base numeric type
+ *  \param  in      Input stream
+ *  \param  tag     Section tag expected (4 characters)
+ */
+template <typename Base_t>
+void read_binary_header(std::istream & in, const char * tag) {
+    char magic[4];
+    if (in.read(magic, sizeof(magic)).fail() ||
+        0 != std::memcmp(magic, binary_magic, sizeof(magic)))
+    {
+        throw std::runtime_error(
+            "libnn::io::deserialise_binary: "
+            "not a libnn binary format");
+    }
+
+    if (binary_version != read_binary<uint32_t>(in))
+        throw std::runtime_error(
+            "libnn::io::deserialise_binary: "
+            "unsupported format version");
+
+    if (binary_bom != read_binary<uint32_t>(in))
+        throw std::runtime_error(
+            "libnn::io::deserialise_binary: "
+            "incompatible byte order");
+
+    if (sizeof(Base_t) != read_binary<uint32_t>(in))
+        throw std::runtime_error(
+            "libnn::io::deserialise_binary: "
+            "incompatible base numeric type");
+
+    char t[4];
+    if (in.read(t, sizeof(t)).fail() || 0 != std::memcmp(t, tag, sizeof(t)))
+        throw std::runtime_error(
+            "libnn::io::deserialise_binary: "
+            "unexpected section");
+}
+
+}  // end of namespace impl
+
+
+/**
+ *  \brief  Serialise neural network topology in binary format
+ *
+ *  The binary format is compact and fast to load, but not portable:
+ *  values are written in host byte order and representation (the header
+ *  allows for detection of incompatible hosts).
+ *  Activation functions are not stored (their parameters are given
+ *  by the activation function type).
+ *
+ *  \tparam Base_t   Base numeric type
+ *  \tparam Act_fn   Activation function
+ *  \param  out      Output stream
+ *  \param  network  Neural network
+ *
+ *  \return \c out
+ */
+template <typename Base_t, class Act_fn>
+std::ostream & serialise_binary(
+    std::ostream & out,
+    const topo::nn<Base_t, Act_fn> & network)
+{
+    typedef typename topo::nn<Base_t, Act_fn>::neuron neuron_t;
+
+    impl::write_binary_header<Base_t>(out, "TOPO");
+
+    // Neurons
+    impl::write_binary<uint64_t>(out, network.size());
+
+    size_t synapses = 0;
+    network.for_each_neuron([&](const neuron_t & n) {
+        impl::write_binary<uint64_t>(out, n.index());
+        impl::write_binary<uint8_t>(out, n.type());
+
+        n.for_each_dendrite([&synapses](
+            const typename neuron_t::dendrite & ) { ++synapses; });
+    });
+
+    // Shared weights
+    impl::write_binary<uint64_t>(out, network.shared_weight_cnt());
+
+    std::vector<const Base_t *> shared;
+    for (size_t i = 0; i < network.shared_weight_cnt(); ++i) {
+        impl::write_binary(out, network.shared_weight(i));
+        shared.push_back(&network.shared_weight(i));
+    }
+
+    // Synapses
+    impl::write_binary<uint64_t>(out, synapses);
+
+    network.for_each_neuron([&](const neuron_t & n) {
+        n.for_each_dendrite([&](const typename neuron_t::dendrite & d) {
+            impl::write_binary<uint64_t>(out, d.source().index());
+            impl::write_binary<uint64_t>(out, n.index());
+
+            if (d.shared()) {
+                size_t index = 0;
+                while (shared[index] != &d.weight()) ++index;
+
+                impl::write_binary<uint8_t>(out, 1);
+                impl::write_binary<uint64_t>(out, index);
+            }
+            else {
+                impl::write_binary<uint8_t>(out, 0);
+                impl::write_binary(out, d.weight());
+            }
+        });
+    });
+
+    return out;
+}
+
+
+/**
+ *  \brief  Deserialise neural network topology from binary format
+ *
+ *  \tparam Base_t   Base numeric type
+ *  \tparam Act_fn   Activation function
+ *  \param  in       Input stream
+ *  \param  network  Neural network
+ *
+ *  \return \c in
+ */
+template <typename Base_t, class Act_fn>
+std::istream & deserialise_binary(
+    std::istream & in,
+    topo::nn<Base_t, Act_fn> & network)
+{
+    typedef typename topo::nn<Base_t, Act_fn>::neuron neuron_t;
+
+    network.clear();  // discard existing network topology
+
+    impl::read_binary_header<Base_t>(in, "TOPO");
+
+    // Neurons
+    const uint64_t neurons = impl::read_binary<uint64_t>(in);
+    for (uint64_t i = 0; i < neurons; ++i) {
+        const uint64_t index = impl::read_binary<uint64_t>(in);
+        const uint8_t  type  = impl::read_binary<uint8_t>(in);
+
+        if (neuron_t::OUTPUT < type)
+            throw std::runtime_error(
+                "libnn::io::deserialise_binary: "
+                "neuron type unknown");
+
+        network.set_neuron(index, (typename neuron_t::type_t)type);
+    }
+
+    // Shared weights
+    const uint64_t shared = impl::read_binary<uint64_t>(in);
+    for (uint64_t i = 0; i < shared; ++i)
+        network.add_shared_weight(impl::read_binary<Base_t>(in));
+
+    // Synapses
+    const uint64_t synapses = impl::read_binary<uint64_t>(in);
+    for (uint64_t i = 0; i < synapses; ++i) {
+        neuron_t & source = network.get_neuron(impl::read_binary<uint64_t>(in));
+        neuron_t & target = network.get_neuron(impl::read_binary<uint64_t>(in));
+
+        if (impl::read_binary<uint8_t>(in))
+            network.set_shared_dendrite(target, source,
+                impl::read_binary<uint64_t>(in));
+        else
+            target.set_dendrite(source, impl::read_binary<Base_t>(in));
+    }
+
+    return in;
+}
+
+
+/**
+ *  \brief  Serialise feed-forward neural network in binary format
+ *
+ *  See \ref serialise_binary for topology.
+ *
+ *  \tparam Base_t   Base numeric type
+ *  \tparam Act_fn   Activation function
+ *  \tparam RWMin    Random weight minimum
+ *  \tparam RWMax    Random weight maximum
+ *  \param  out      Output stream
+ *  \param  network  Neural network
+ *
+ *  \return \c out
+ */
+template <typename Base_t, class Act_fn, class RWMin, class RWMax>
+std::ostream & serialise_binary(
+    std::ostream & out,
+    const model::feed_forward<Base_t, Act_fn, RWMin, RWMax> & network)
+{
+    impl::write_binary_header<Base_t>(out, "FFNN");
+
+    impl::write_binary<int32_t>(out, network.features());
+    impl::write_binary<uint64_t>(out, network.layer_cnt());
+
+    for (size_t i = 0; i < network.layer_cnt(); ++i) {
+        impl::write_binary<uint64_t>(out, network.layer(i).begin);
+        impl::write_binary<uint64_t>(out, network.layer(i).end);
+    }
+
+    return serialise_binary(out, network.topology());
+}
+
+
+/**
+ *  \brief  Deserialise feed-forward neural network from binary format
+ *
+ *  \tparam Base_t   Base numeric type
+ *  \tparam Act_fn   Activation function
+ *  \tparam RWMin    Random weight minimum
+ *  \tparam RWMax    Random weight maximum
+ *  \param  in       Input stream
+ *  \param  network  Neural network
+ *
+ *  \return \c in
+ */
+template <typename Base_t, class Act_fn, class RWMin, class RWMax>
+std::istream & deserialise_binary(
+    std::istream & in,
+    model::feed_forward<Base_t, Act_fn, RWMin, RWMax> & network)
+{
+    network.topology().clear();  // discard existing network topology
+
+    impl::read_binary_header<Base_t>(in, "FFNN");
+
+    network.features(impl::read_binary<int32_t>(in));
+
+    typename model::feed_forward<Base_t, Act_fn, RWMin, RWMax>::layers_t
+        layers;
+
+    const uint64_t layer_cnt = impl::read_binary<uint64_t>(in);
+    for (uint64_t i = 0; i < layer_cnt; ++i) {
+        const uint64_t begin = impl::read_binary<uint64_t>(in);
+        const uint64_t end   = impl::read_binary<uint64_t>(in);
+
+        layers.emplace_back(begin, end);
+    }
+
+    deserialise_binary(in, network.topology());
+
+    network.layers(layers);
+
+    return in;
+}
+
+}}  // end of namespace libnn::io
+
+
+#endif  // end of #ifndef libnn__io__binary_hxx
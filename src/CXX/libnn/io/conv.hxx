@@ -0,0 +1,441 @@
+#ifndef libnn__io__conv_hxx
+#define libnn__io__conv_hxx
+
+/**
+ *  Convolutional neural network (de)serialisation
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libnn/io/nn.hxx"
+#include "libnn/io/feed_forward.hxx"
+#include "libnn/model/conv.hxx"
+
+#include <iostream>
+#include <regex>
+#include <string>
+#include <sstream>
+#include <vector>
+
+
+using namespace libnn::model;
+
+namespace libnn {
+namespace io {
+
+namespace impl {
+
+/**
+ *  \brief  Serialise vector of values
+ *
+ *  \param  out     Output stream
+ *  \param  values  Values
+ *  \param  begin   First value index
+ *  \param  cnt     Value count
+ *
+ *  \return \c out
+ */
+template <typename Base_t>
+std::ostream & serialise(
+    std::ostream              & out,
+    const std::vector<Base_t> & values,
+    size_t                      begin,
+    size_t                      cnt)
+{
+    for (size_t i = begin; i < begin + cnt; ++i)
+        out << ' ' << values[i];
+
+    return out;
+}
+
+
+/**
+ *  \brief  Deserialise values
+ *
+ *  \param  str     String of space-separated values
+ *  \param  values  Values
+ *  \param  begin   First value index
+ *  \param  cnt     Value count
+ */
+template <typename Base_t>
+void deserialise(
+    const std::string   & str,
+    std::vector<Base_t> & values,
+    size_t                begin,
+    size_t                cnt)
+{
+    std::stringstream ss(str);
+
+    for (size_t i = begin; i < begin + cnt; ++i)
+        if ((ss >> values[i]).fail())
+            throw std::runtime_error(
+                "libnn::io::deserialise: "
+                "failed to read value");
+
+    std::string rest;
+    if (!(ss >> rest).fail())
+        throw std::runtime_error(
+            "libnn::io::deserialise: "
+            "too many values");
+}
+
+
+/**
+ *  \brief  Read "name = A x B" line
+ *
+ *  \param  in    Input stream
+ *  \param  name  Parameter name
+ *  \param  a     First value
+ *  \param  b     Second value
+ */
+inline void getline_pair(
+    std::istream      & in,
+    const std::string & name,
+    size_t            & a,
+    size_t            & b)
+{
+    std::smatch bref;  // back-references
+    std::string line;  // input line
+
+    getline(in, line);
+    if (!std::regex_match(line, bref, std::regex(
+        "^[ \\t]*" + name + "[ \\t]*=[ \\t]*(\\d+)[ \\t]*x[ \\t]*(\\d+)$")))
+    {
+        throw std::runtime_error(
+            "libnn::io::deserialise: "
+            "layer " + name + " expected");
+    }
+
+    a = lexical_cast<size_t>(bref[1]);
+    b = lexical_cast<size_t>(bref[2]);
+}
+
+}  // end of namespace impl
+
+
+/**
+ *  \brief  Serialise convolutional neural network
+ *
+ *  Kernel weights are serialised per filter, in [channel, row, column]
+ *  order.
+ *
+ *  \tparam Base_t   Base numeric type
+ *  \tparam Act_fn   Activation function
+ *  \tparam RWMin    Random weight minimum
+ *  \tparam RWMax    Random weight maximum
+ *  \param  out      Output stream
+ *  \param  network  Neural network
+ *  \param  indent   Indentation prefix
+ *
+ *  \return \c out
+ */
+template <typename Base_t, class Act_fn, class RWMin, class RWMax>
+std::ostream & serialise(
+    std::ostream & out,
+    const conv<Base_t, Act_fn, RWMin, RWMax> & network,
+    const std::string & indent = "")
+{
+    typedef typename conv<Base_t, Act_fn, RWMin, RWMax>::layer_t layer_t;
+
+    static const char * const type_str[] = {
+        /* CONV     */  "CONV",
+        /* MAX_POOL */  "MAX_POOL",
+        /* AVG_POOL */  "AVG_POOL",
+    };
+
+    out << indent << "ConvNN" << std::endl;
+
+    const auto & input  = network.input();
+    const auto & layers = network.layers();
+
+    out
+        << indent << "    input  = " << input.channels
+        << " x " << input.height << " x " << input.width << std::endl
+        << indent << "    layers = " << layers.size() << std::endl;
+
+    std::for_each(layers.begin(), layers.end(),
+    [&out, &indent](const layer_t & layer) {
+        out
+            << indent << "    Layer " << type_str[(int)layer.type()]
+            << std::endl;
+
+        if (layer_t::CONV == layer.type())
+            out
+                << indent << "        filters = "
+                << layer.output().channels << std::endl;
+
+        out
+            << indent << "        kernel  = "
+            << layer.kernel_h() << " x " << layer.kernel_w() << std::endl
+            << indent << "        stride  = "
+            << layer.stride_h() << " x " << layer.stride_w() << std::endl;
+
+        if (layer_t::CONV == layer.type()) {
+            out
+                << indent << "        padding = "
+                << layer.pad_h() << " x " << layer.pad_w() << std::endl
+                << indent << "        f       = "
+                << layer.act_fn() << std::endl;
+
+            out << indent << "        Bias";
+            impl::serialise(out, layer.bias(), 0, layer.bias().size())
+                << std::endl;
+
+            const size_t ksize = layer.kernel_size();
+            for (size_t f = 0; f < layer.output().channels; ++f) {
+                out << indent << "        Kernel " << f;
+                impl::serialise(out, layer.weights(), f * ksize, ksize)
+                    << std::endl;
+            }
+        }
+
+        out << indent << "    LayerEnd" << std::endl;
+    });
+
+    serialise(out, network.dense(), indent + "    ");
+
+    out << indent << "ConvNNEnd" << std::endl;
+
+    return out;
+}
+
+
+/**
+ *  \brief  Deserialise convolutional neural network
+ *
+ *  \tparam Base_t   Base numeric type
+ *  \tparam Act_fn   Activation function
+ *  \tparam RWMin    Random weight minimum
+ *  \tparam RWMax    Random weight maximum
+ *  \param  in       Input stream
+ *  \param  network  Neural network
+ *
+ *  \return \c in
+ */
+template <typename Base_t, class Act_fn, class RWMin, class RWMax>
+std::istream & deserialise(
+    std::istream & in,
+    conv<Base_t, Act_fn, RWMin, RWMax> & network)
+{
+    typedef typename conv<Base_t, Act_fn, RWMin, RWMax>::layer_t layer_t;
+    typedef typename conv<Base_t, Act_fn, RWMin, RWMax>::shape_t shape_t;
+
+    network.layers().clear();  // discard existing network
+
+    std::smatch bref;  // back-references
+    std::string line;  // input line
+
+    // Convolutional NN section begin
+    impl::getline(in, line);
+    if (!std::regex_match(line, bref, std::regex(
+        "^[ \\t]*ConvNN$")))
+    {
+        throw std::runtime_error(
+            "libnn::io::deserialise: "
+            "ConvNN section expected");
+    }
+
+    // Input shape
+    impl::getline(in, line);
+    if (!std::regex_match(line, bref, std::regex(
+        "^[ \\t]*input[ \\t]*=[ \\t]*(\\d+)[ \\t]*x[ \\t]*(\\d+)"
+        "[ \\t]*x[ \\t]*(\\d+)$")))
+    {
+        throw std::runtime_error(
+            "libnn::io::deserialise: "
+            "input shape expected");
+    }
+
+    network.input(shape_t(
+        impl::lexical_cast<size_t>(bref[1]),
+        impl::lexical_cast<size_t>(bref[2]),
+        impl::lexical_cast<size_t>(bref[3])));
+
+    // Layer count
+    impl::getline(in, line);
+    if (!std::regex_match(line, bref, std::regex(
+        "^[ \\t]*layers[ \\t]*=[ \\t]*(\\d+)$")))
+    {
+        throw std::runtime_error(
+            "libnn::io::deserialise: "
+            "layer count expected");
+    }
+
+    const size_t layer_cnt = impl::lexical_cast<size_t>(bref[1]);
+
+    // Layers
+    for (size_t i = 0; i < layer_cnt; ++i) {
+        impl::getline(in, line);
+        if (!std::regex_match(line, bref, std::regex(
+            "^[ \\t]*Layer[ \\t]+([A-Z_]+)$")))
+        {
+            throw std::runtime_error(
+                "libnn::io::deserialise: "
+                "layer section expected");
+        }
+
+        typename layer_t::type_t type;
+        if ("CONV" == bref[1])
+            type = layer_t::CONV;
+        else if ("MAX_POOL" == bref[1])
+            type = layer_t::MAX_POOL;
+        else if ("AVG_POOL" == bref[1])
+            type = layer_t::AVG_POOL;
+        else
+            throw std::runtime_error(
+                "libnn::io::deserialise: "
+                "layer type unknown");
+
+        size_t filters = 0;
+        if (layer_t::CONV == type) {
+            impl::getline(in, line);
+            if (!std::regex_match(line, bref, std::regex(
+                "^[ \\t]*filters[ \\t]*=[ \\t]*(\\d+)$")))
+            {
+                throw std::runtime_error(
+                    "libnn::io::deserialise: "
+                    "layer filters expected");
+            }
+
+            filters = impl::lexical_cast<size_t>(bref[1]);
+        }
+
+        size_t kernel_h, kernel_w, stride_h, stride_w, pad_h = 0, pad_w = 0;
+        impl::getline_pair(in, "kernel", kernel_h, kernel_w);
+        impl::getline_pair(in, "stride", stride_h, stride_w);
+
+        if (layer_t::CONV != type) {
+            network.layers().emplace_back(type, network.output(), 0,
+                kernel_h, kernel_w, stride_h, stride_w);
+        }
+        else {
+            impl::getline_pair(in, "padding", pad_h, pad_w);
+
+            // Activation function
+            impl::getline(in, line);
+            if (!std::regex_match(line, bref, std::regex(
+                "^[ \\t]*f[ \\t]*=[ \\t]*(.*)$")))
+            {
+                throw std::runtime_error(
+                    "libnn::io::deserialise: "
+                    "activation function specification expected");
+            }
+
+            network.layers().emplace_back(type, network.output(), filters,
+                kernel_h, kernel_w, stride_h, stride_w, pad_h, pad_w,
+                impl::lexical_cast<Act_fn>(bref[1]));
+
+            layer_t & layer = network.layers().back();
+
+            // Bias
+            impl::getline(in, line);
+            if (!std::regex_match(line, bref, std::regex(
+                "^[ \\t]*Bias(.*)$")))
+            {
+                throw std::runtime_error(
+                    "libnn::io::deserialise: "
+                    "layer bias expected");
+            }
+
+            impl::deserialise(bref[1], layer.bias(), 0, filters);
+
+            // Kernels
+            const size_t ksize = layer.kernel_size();
+            for (size_t f = 0; f < filters; ++f) {
+                impl::getline(in, line);
+                if (!std::regex_match(line, bref, std::regex(
+                    "^[ \\t]*Kernel[ \\t]+(\\d+)(.*)$")) ||
+                    impl::lexical_cast<size_t>(bref[1]) != f)
+                {
+                    throw std::runtime_error(
+                        "libnn::io::deserialise: "
+                        "layer kernel expected");
+                }
+
+                impl::deserialise(bref[2], layer.weights(), f * ksize, ksize);
+            }
+        }
+
+        // Layer end
+        impl::getline(in, line);
+        if (!std::regex_match(line, bref, std::regex(
+            "^[ \\t]*LayerEnd$")))
+        {
+            throw std::runtime_error(
+                "libnn::io::deserialise: "
+                "layer section end expected");
+        }
+    }
+
+    // Dense network
+    deserialise(in, network.dense());
+
+    // Convolutional NN section end
+    impl::getline(in, line);
+    if (!std::regex_match(line, bref, std::regex(
+        "^[ \\t]*ConvNNEnd[ \\t]*$")))
+    {
+        throw std::runtime_error(
+            "libnn::io::deserialise: "
+            "ConvNN section end expected");
+    }
+
+    return in;
+}
+
+}}  // end of namespace libnn::io
+
+
+// (De)serialisation operators
+/** \cond */
+template <typename Base_t, class Act_fn, class RWMin, class RWMax>
+std::ostream & operator << (
+    std::ostream & out,
+    const conv<Base_t, Act_fn, RWMin, RWMax> & network)
+{
+    return libnn::io::serialise(out, network);
+}
+
+template <typename Base_t, class Act_fn, class RWMin, class RWMax>
+std::istream & operator >> (
+    std::istream & in,
+    conv<Base_t, Act_fn, RWMin, RWMax> & network)
+{
+    return libnn::io::deserialise(in, network);
+}
+/** \endcond */
+
+#endif  // end of #ifndef libnn__io__conv_hxx
@@ -82,6 +82,19 @@ std::ostream & serialise(
 
     serialise(out, network.topology(), indent + "    ");
 
+    // Bias & layers
+    if (feed_forward<Base_t, Act_fn, RWMin, RWMax>::BIAS & network.features())
+        out << indent << "    Bias " << network.bias() << std::endl;
+
+    for (size_t i = 0; i < network.layer_cnt(); ++i) {
+        const auto & layer = network.layer(i);
+
+        out
+            << indent << "    Layer " << i
+            << " = [" << layer.begin << ", " << layer.end << ')'
+            << std::endl;
+    }
+
     out << indent << "FFNNEnd" << std::endl;
 
     return out;
@@ -91,6 +104,9 @@ std::ostream & serialise(
 /**
  *  \brief  Deserialise feed-forward neural network
  *
+ *  Layers specification is optional (for compatibility with older
+ *  format); if missing, layers are inferred from the topology.
+ *
  *  \tparam Base_t   Base numeric type
  *  \tparam Act_fn   Activation function
  *  \tparam RWMin    Random weight minimum
@@ -130,13 +146,53 @@ std::istream & deserialise(
             "features expected");
     }
 
-    network.features(impl::lexical_cast<int>(bref[1]));
+    network.features(std::stoi(bref[1], NULL, 16));  // hexadecimal
 
     // Topology
     deserialise(in, network.topology());
 
-    // Feed-forward NN section end
+    // Bias (optional)
     impl::getline(in, line);
+    if (std::regex_match(line, bref, std::regex(
+        "^[ \\t]*Bias[ \\t]+(\\d+)$")))
+    {
+        if (impl::lexical_cast<size_t>(bref[1]) != network.bias())
+            throw std::runtime_error(
+                "libnn::io::deserialise: "
+                "unexpected bias neuron index");
+
+        impl::getline(in, line);
+    }
+
+    // Layers (optional, inferred from topology if missing)
+    typename feed_forward<Base_t, Act_fn, RWMin, RWMax>::layers_t layers;
+
+    for (;;) {
+        if (!std::regex_match(line, bref, std::regex(
+            "^[ \\t]*Layer[ \\t]+(\\d+)[ \\t]*=[ \\t]*"
+            "\\[[ \\t]*(\\d+)[ \\t]*,[ \\t]*(\\d+)[ \\t]*\\)$")))
+        {
+            break;  // layers parsed
+        }
+
+        if (impl::lexical_cast<size_t>(bref[1]) != layers.size())
+            throw std::runtime_error(
+                "libnn::io::deserialise: "
+                "layers must be indexed sequentially");
+
+        layers.emplace_back(
+            impl::lexical_cast<size_t>(bref[2]),
+            impl::lexical_cast<size_t>(bref[3]));
+
+        impl::getline(in, line);  // get another line
+    }
+
+    if (layers.empty())
+        network.infer_layers();
+    else
+        network.layers(layers);
+
+    // Feed-forward NN section end
     if (!std::regex_match(line, bref, std::regex(
         "^[ \\t]*FFNNEnd[ \\t]*$")))
     {
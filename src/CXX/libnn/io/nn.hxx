@@ -43,6 +43,7 @@
 #include "libnn/topo/nn.hxx"
 
 #include <iostream>
+#include <map>
 #include <regex>
 #include <string>
 #include <sstream>
@@ -88,7 +89,7 @@ const T lexical_cast(const std::string & str) {
  *  \param  in    Input stream
  *  \param  line  Resulting line
  */
-void getline(std::istream & in, std::string & line) {
+inline void getline(std::istream & in, std::string & line) {
     while (!in.eof()) {
         std::getline(in, line);
 
@@ -151,6 +152,19 @@ std::ostream & serialise(
             << indent << "    NeuronEnd"                 << std::endl;
     });
 
+    // Serialise shared weights (each of them just once)
+    std::map<const Base_t *, size_t> shared;
+
+    for (size_t i = 0; i < network.shared_weight_cnt(); ++i) {
+        const Base_t & w = network.shared_weight(i);
+
+        out
+            << indent << "    SharedWeight " << i << " = " << w
+            << std::endl;
+
+        shared[&w] = i;
+    }
+
     // Serialise synapses
     network.for_each_neuron(
     [&](const typename nn<Base_t, Act_fn>::neuron & n) {
@@ -158,9 +172,14 @@ std::ostream & serialise(
         [&](const typename nn<Base_t, Act_fn>::neuron::dendrite & d) {
             out
                 << indent << "    Synapsis "
-                << d.source.index() << " -> " << n.index()
-                << " weight = " << d.weight
-                << std::endl;
+                << d.source().index() << " -> " << n.index();
+
+            if (d.shared())
+                out << " shared " << shared.at(&d.weight());
+            else
+                out << " weight = " << d.weight();
+
+            out << std::endl;
         });
     });
 
@@ -260,18 +279,38 @@ std::istream & deserialise(
         network.set_neuron(index, type, f);
     }
 
+    // Shared weights
+    for (;;) {
+        if (!std::regex_match(line, bref, std::regex(
+            "^[ \\t]*SharedWeight[ \\t]+(\\d+)[ \\t]*=[ \\t]*(.+)$")))
+        {
+            break;  // shared weights parsed
+        }
+
+        size_t index        = impl::lexical_cast<size_t>(bref[1]);
+        const Base_t weight = impl::lexical_cast<Base_t>(bref[2]);
+
+        if (index != network.shared_weight_cnt())
+            throw std::runtime_error(
+                "libnn::io::deserialise: "
+                "shared weights must be indexed sequentially");
+
+        network.add_shared_weight(weight);
+
+        impl::getline(in, line);  // get another line
+    }
+
     // Synapses
     for (;;) {
         if (!std::regex_match(line, bref, std::regex(
             "^[ \\t]*Synapsis[ \\t]+(\\d+)[ \\t]*->[ \\t]*(\\d+)[ \\t]+"
-            "weight[ \\t]*=[ \\t]*(.+)$")))
+            "(weight[ \\t]*=|shared)[ \\t]*(.+)$")))
         {
             break;  // synapses parsed
         }
 
-        size_t from_index   = impl::lexical_cast<size_t>(bref[1]);
-        size_t to_index     = impl::lexical_cast<size_t>(bref[2]);
-        const Base_t weight = impl::lexical_cast<Base_t>(bref[3]);
+        size_t from_index = impl::lexical_cast<size_t>(bref[1]);
+        size_t to_index   = impl::lexical_cast<size_t>(bref[2]);
 
         // Add synapsis
         typename topo::nn<Base_t, Act_fn>::neuron & from_neuron =
@@ -279,7 +318,12 @@ std::istream & deserialise(
         typename topo::nn<Base_t, Act_fn>::neuron & to_neuron =
             network.get_neuron(to_index);
 
-        to_neuron.set_dendrite(from_neuron, weight);
+        if ("shared" == bref[3])
+            network.set_shared_dendrite(to_neuron, from_neuron,
+                impl::lexical_cast<size_t>(bref[4]));
+        else
+            to_neuron.set_dendrite(from_neuron,
+                impl::lexical_cast<Base_t>(bref[4]));
 
         impl::getline(in, line);  // get another line
     }
@@ -40,8 +40,8 @@
  *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
-#include "libnn/io/feed_forward.hxx"
 #include "libnn/io/sigmoid.hxx"
+#include "libnn/io/feed_forward.hxx"
 
 #include <iostream>
 
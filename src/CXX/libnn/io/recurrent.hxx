@@ -0,0 +1,201 @@
+#ifndef libnn__io__recurrent_hxx
+#define libnn__io__recurrent_hxx
+
+/**
+ *  Recurrent neural network (de)serialisation
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libnn/io/nn.hxx"
+#include "libnn/model/recurrent.hxx"
+
+#include <iostream>
+#include <regex>
+#include <string>
+#include <sstream>
+#include <cassert>
+
+
+using namespace libnn::model;
+
+namespace libnn {
+namespace io {
+
+/**
+ *  \brief  Serialise recurrent neural network
+ *
+ *  \tparam Base_t   Base numeric type
+ *  \tparam Act_fn   Activation function
+ *  \tparam RWMin    Random weight minimum
+ *  \tparam RWMax    Random weight maximum
+ *  \param  out      Output stream
+ *  \param  network  Neural network
+ *  \param  indent   Indentation prefix
+ *
+ *  \return \c out
+ */
+template <typename Base_t, class Act_fn, class RWMin, class RWMax>
+std::ostream & serialise(
+    std::ostream & out,
+    const recurrent<Base_t, Act_fn, RWMin, RWMax> & network,
+    const std::string & indent = "")
+{
+    out << indent << "RNN" << std::endl;
+
+    out << indent << "    features = 0x"
+        << std::hex << network.features() << std::dec
+        << std::endl;
+
+    serialise(out, network.topology(), indent + "    ");
+
+    const auto & context = network.context();
+    std::for_each(context.begin(), context.end(),
+    [&out, &indent](const std::pair<size_t, size_t> & ctx) {
+        out
+            << indent << "    Context "
+            << ctx.first << " <- " << ctx.second
+            << std::endl;
+    });
+
+    out << indent << "RNNEnd" << std::endl;
+
+    return out;
+}
+
+
+/**
+ *  \brief  Deserialise recurrent neural network
+ *
+ *  \tparam Base_t   Base numeric type
+ *  \tparam Act_fn   Activation function
+ *  \tparam RWMin    Random weight minimum
+ *  \tparam RWMax    Random weight maximum
+ *  \param  in       Input stream
+ *  \param  network  Neural network
+ *
+ *  \return \c in
+ */
+template <typename Base_t, class Act_fn, class RWMin, class RWMax>
+std::istream & deserialise(
+    std::istream & in,
+    recurrent<Base_t, Act_fn, RWMin, RWMax> & network)
+{
+    network.topology().clear();  // discard existing network topology
+    network.context().clear();
+
+    std::smatch bref;  // back-references
+    std::string line;  // input line
+
+    // Recurrent NN section begin
+    impl::getline(in, line);
+    if (!std::regex_match(line, bref, std::regex(
+        "^[ \\t]*RNN$")))
+    {
+        throw std::runtime_error(
+            "libnn::io::deserialise: "
+            "RNN section expected");
+    }
+
+    // Features
+    impl::getline(in, line);
+    if (!std::regex_match(line, bref, std::regex(
+        "^[ \\t]*features[ \\t]*=[ \\t]*([xa-f\\d]+)$")))
+    {
+        throw std::runtime_error(
+            "libnn::io::deserialise: "
+            "features expected");
+    }
+
+    network.features(std::stoi(bref[1], NULL, 16));  // hexadecimal
+
+    // Topology
+    deserialise(in, network.topology());
+
+    // Context
+    for (;;) {
+        impl::getline(in, line);
+        if (!std::regex_match(line, bref, std::regex(
+            "^[ \\t]*Context[ \\t]+(\\d+)[ \\t]*<-[ \\t]*(\\d+)$")))
+        {
+            break;  // context parsed
+        }
+
+        const size_t ctx_index = impl::lexical_cast<size_t>(bref[1]);
+        const size_t src_index = impl::lexical_cast<size_t>(bref[2]);
+
+        // Check the neurons exist
+        network.topology().get_neuron(ctx_index);
+        network.topology().get_neuron(src_index);
+
+        network.context().emplace_back(ctx_index, src_index);
+    }
+
+    // Recurrent NN section end
+    if (!std::regex_match(line, bref, std::regex(
+        "^[ \\t]*RNNEnd[ \\t]*$")))
+    {
+        throw std::runtime_error(
+            "libnn::io::deserialise: "
+            "RNN section end expected");
+    }
+
+    return in;
+}
+
+}}  // end of namespace libnn::io
+
+
+// (De)serialisation operators
+/** \cond */
+template <typename Base_t, class Act_fn, class RWMin, class RWMax>
+std::ostream & operator << (
+    std::ostream & out,
+    const recurrent<Base_t, Act_fn, RWMin, RWMax> & network)
+{
+    return libnn::io::serialise(out, network);
+}
+
+template <typename Base_t, class Act_fn, class RWMin, class RWMax>
+std::istream & operator >> (
+    std::istream & in,
+    recurrent<Base_t, Act_fn, RWMin, RWMax> & network)
+{
+    return libnn::io::deserialise(in, network);
+}
+/** \endcond */
+
+#endif  // end of #ifndef libnn__io__recurrent_hxx
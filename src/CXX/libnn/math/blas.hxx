@@ -0,0 +1,347 @@
+#ifndef libnn__math__blas_hxx
+#define libnn__math__blas_hxx
+
+/**
+ *  BLAS backend abstraction
+ *
+ *  Dense products are computed either by the internal kernels
+ *  (see gemm.hxx) or by an external BLAS library (CBLAS interface;
+ *  OpenBLAS, BLIS, MKL...).
+ *  The external BLAS is compiled in iff \c LIBNN_WITH_CBLAS is defined
+ *  (done by \c configure \c --with-blas in config.hxx; programs using
+ *  the installed headers shall define it and link the BLAS library).
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libnn/math/gemm.hxx"
+
+#ifdef LIBNN_WITH_CBLAS
+extern "C" {
+#include <cblas.h>
+}
+#endif  // end of #ifdef LIBNN_WITH_CBLAS
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+
+namespace libnn {
+namespace math {
+namespace blas {
+
+/**
+ *  \brief  BLAS backend
+ */
+enum backend_t {
+    INTERNAL = 0,  /**< libnn kernels (see \c gemm.hxx)          */
+    CBLAS    = 1,  /**< External BLAS library (CBLAS interface) */
+};  // end of enum backend_t
+
+
+/**
+ *  \brief  Check backend availability
+ *
+ *  The external BLAS is available if libnn was configured with it
+ *  (see \c --with-blas configure option).
+ *
+ *  \param  b  Backend
+ *
+ *  \return \c true iff the backend may be used
+ */
+inline bool available(backend_t b) {
+#ifdef LIBNN_WITH_CBLAS
+    return INTERNAL == b || CBLAS == b;
+#else
+    return INTERNAL == b;
+#endif  // end of #ifdef LIBNN_WITH_CBLAS
+}
+
+
+namespace impl {
+
+/**
+ *  \brief  Initial backend
+ *
+ *  The external BLAS is used if available, unless the \c LIBNN_BLAS
+ *  environment variable says \c internal.
+ *
+ *  \return Backend
+ */
+inline backend_t initial_backend() {
+    const char * env = ::getenv("LIBNN_BLAS");
+
+    if (NULL != env) {
+        if (0 == std::strcmp(env, "internal")) return INTERNAL;
+
+        if (0 != std::strcmp(env, "cblas"))
+            throw std::logic_error(
+                "libnn::math::blas: LIBNN_BLAS shall be "
+                "either internal or cblas");
+    }
+
+    return available(CBLAS) ? CBLAS : INTERNAL;
+}
+
+/** Selected backend */
+inline backend_t & selected_backend() {
+    static backend_t b = initial_backend();
+    return b;
+}
+
+
+/**
+ *  \brief  CBLAS routines (generic, unavailable)
+ *
+ *  \tparam  Base_t  Base numeric type
+ */
+template <typename Base_t>
+struct cblas {
+    static const bool available = false;  /**< No CBLAS routines */
+
+    /** GEMM (never called) */
+    static void gemm(
+        transpose_t, transpose_t, size_t, size_t, size_t,
+        const Base_t &, const Base_t *, size_t, const Base_t *, size_t,
+        const Base_t &, Base_t *, size_t)
+    {
+        throw std::logic_error(
+            "libnn::math::blas: CBLAS GEMM not available");
+    }
+
+    /** GEMV (never called) */
+    static void gemv(
+        transpose_t, size_t, size_t,
+        const Base_t &, const Base_t *, size_t, const Base_t *, size_t,
+        const Base_t &, Base_t *, size_t)
+    {
+        throw std::logic_error(
+            "libnn::math::blas: CBLAS GEMV not available");
+    }
+
+};  // end of template struct cblas
+
+/** \cond */
+template <typename Base_t>
+const bool cblas<Base_t>::available;
+/** \endcond */
+
+#ifdef LIBNN_WITH_CBLAS
+
+/** CBLAS transposition */
+inline CBLAS_TRANSPOSE cblas_trans(transpose_t trans) {
+    return NO_TRANS == trans ? CblasNoTrans : CblasTrans;
+}
+
+/** CBLAS routines for \c float */
+template <>
+struct cblas<float> {
+    static const bool available = true;  /**< sgemm, sgemv */
+
+    /** \c cblas_sgemm */
+    static void gemm(
+        transpose_t trans_a, transpose_t trans_b,
+        size_t m, size_t n, size_t k,
+        const float & alpha, const float * a, size_t lda,
+        const float * b, size_t ldb,
+        const float & beta, float * c, size_t ldc)
+    {
+        cblas_sgemm(CblasRowMajor, cblas_trans(trans_a), cblas_trans(trans_b),
+            (int)m, (int)n, (int)k,
+            alpha, a, (int)lda, b, (int)ldb, beta, c, (int)ldc);
+    }
+
+    /** \c cblas_sgemv */
+    static void gemv(
+        transpose_t trans, size_t m, size_t n,
+        const float & alpha, const float * a, size_t lda,
+        const float * x, size_t incx,
+        const float & beta, float * y, size_t incy)
+    {
+        cblas_sgemv(CblasRowMajor, cblas_trans(trans), (int)m, (int)n,
+            alpha, a, (int)lda, x, (int)incx, beta, y, (int)incy);
+    }
+
+};  // end of struct cblas<float>
+
+/** CBLAS routines for \c double */
+template <>
+struct cblas<double> {
+    static const bool available = true;  /**< dgemm, dgemv */
+
+    /** \c cblas_dgemm */
+    static void gemm(
+        transpose_t trans_a, transpose_t trans_b,
+        size_t m, size_t n, size_t k,
+        const double & alpha, const double * a, size_t lda,
+        const double * b, size_t ldb,
+        const double & beta, double * c, size_t ldc)
+    {
+        cblas_dgemm(CblasRowMajor, cblas_trans(trans_a), cblas_trans(trans_b),
+            (int)m, (int)n, (int)k,
+            alpha, a, (int)lda, b, (int)ldb, beta, c, (int)ldc);
+    }
+
+    /** \c cblas_dgemv */
+    static void gemv(
+        transpose_t trans, size_t m, size_t n,
+        const double & alpha, const double * a, size_t lda,
+        const double * x, size_t incx,
+        const double & beta, double * y, size_t incy)
+    {
+        cblas_dgemv(CblasRowMajor, cblas_trans(trans), (int)m, (int)n,
+            alpha, a, (int)lda, x, (int)incx, beta, y, (int)incy);
+    }
+
+};  // end of struct cblas<double>
+
+#endif  // end of #ifdef LIBNN_WITH_CBLAS
+
+}  // end of namespace impl
+
+
+/**
+ *  \brief  Selected backend
+ *
+ *  \return Backend used by \ref gemm and \ref gemv
+ */
+inline backend_t backend() { return impl::selected_backend(); }
+
+/**
+ *  \brief  Select backend
+ *
+ *  Note that the selection is global (not thread-safe); it's meant
+ *  to be done at program start (or in tests).
+ *
+ *  \param  b  Backend
+ */
+inline void backend(backend_t b) {
+    if (!available(b))
+        throw std::logic_error(
+            "libnn::math::blas: backend not available");
+
+    impl::selected_backend() = b;
+}
+
+/**
+ *  \brief  Backend name
+ *
+ *  \param  b  Backend
+ *
+ *  \return \c internal or \c cblas
+ */
+inline const char * name(backend_t b) {
+    return CBLAS == b ? "cblas" : "internal";
+}
+
+
+/**
+ *  \brief  General matrix multiplication (backend dispatch)
+ *
+ *  Computes C = alpha op(A) op(B) + beta C using the selected backend.
+ *  \c float and \c double products are computed by \c cblas_sgemm
+ *  and \c cblas_dgemm if the external BLAS is selected; otherwise
+ *  (and for other base types) by \ref libnn::math::gemm.
+ *  See \ref libnn::math::gemm for the parameters.
+ */
+template <typename Base_t>
+void gemm(
+    transpose_t    trans_a,
+    transpose_t    trans_b,
+    size_t         m,
+    size_t         n,
+    size_t         k,
+    const Base_t & alpha,
+    const Base_t * a,
+    size_t         lda,
+    const Base_t * b,
+    size_t         ldb,
+    const Base_t & beta,
+    Base_t       * c,
+    size_t         ldc)
+{
+    if (impl::cblas<Base_t>::available && CBLAS == backend()) {
+        if (0 == m || 0 == n) return;
+
+        impl::cblas<Base_t>::gemm(trans_a, trans_b, m, n, k,
+            alpha, a, lda, b, ldb, beta, c, ldc);
+    }
+    else
+        math::gemm(trans_a, trans_b, m, n, k,
+            alpha, a, lda, b, ldb, beta, c, ldc);
+}
+
+
+/**
+ *  \brief  Matrix-vector multiplication (backend dispatch)
+ *
+ *  Computes y = alpha op(A) x + beta y using the selected backend.
+ *  See \ref libnn::math::gemv for the parameters.
+ */
+template <typename Base_t>
+void gemv(
+    transpose_t    trans,
+    size_t         m,
+    size_t         n,
+    const Base_t & alpha,
+    const Base_t * a,
+    size_t         lda,
+    const Base_t * x,
+    size_t         incx,
+    const Base_t & beta,
+    Base_t       * y,
+    size_t         incy)
+{
+    if (impl::cblas<Base_t>::available && CBLAS == backend()) {
+        if (0 == m || 0 == n) {
+            // y = beta y (CBLAS would leave y alone)
+            math::gemv(trans, m, n, alpha, a, lda, x, incx, beta, y, incy);
+            return;
+        }
+
+        impl::cblas<Base_t>::gemv(trans, m, n,
+            alpha, a, lda, x, incx, beta, y, incy);
+    }
+    else
+        math::gemv(trans, m, n, alpha, a, lda, x, incx, beta, y, incy);
+}
+
+}}}  // end of namespace libnn::math::blas
+
+
+#endif  // end of #ifndef libnn__math__blas_hxx
@@ -50,19 +50,19 @@ namespace math {
 /** \cond */  // we don't need these trivials documented
 
 // Exponential function
-float       exp(float       x) { return std::exp(x); }
-double      exp(double      x) { return std::exp(x); }
-long double exp(long double x) { return std::exp(x); }
+inline float       exp(float       x) { return std::exp(x); }
+inline double      exp(double      x) { return std::exp(x); }
+inline long double exp(long double x) { return std::exp(x); }
 
 // Error function
-float       erf(float       x) { return std::erf(x); }
-double      erf(double      x) { return std::erf(x); }
-long double erf(long double x) { return std::erf(x); }
+inline float       erf(float       x) { return std::erf(x); }
+inline double      erf(double      x) { return std::erf(x); }
+inline long double erf(long double x) { return std::erf(x); }
 
 // Acrtangent
-float       atan(float       x) { return std::atan(x); }
-double      atan(double      x) { return std::atan(x); }
-long double atan(long double x) { return std::atan(x); }
+inline float       atan(float       x) { return std::atan(x); }
+inline double      atan(double      x) { return std::atan(x); }
+inline long double atan(long double x) { return std::atan(x); }
 
 /** \endcond */
 
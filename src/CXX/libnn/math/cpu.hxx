@@ -0,0 +1,205 @@
+#ifndef libnn__math__cpu_hxx
+#define libnn__math__cpu_hxx
+
+/**
+ *  CPU instruction set selection
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+
+/**
+ *  \brief  Multi-ISA kernels
+ *
+ *  Defined if the numeric kernels are compiled for several instruction
+ *  sets (selected at run time, see \ref libnn::math::cpu::isa).
+ *  That's the case for GCC on x86 (the kernels are compiled using
+ *  \c \#pragma \c GCC \c target).
+ */
+#if defined(__GNUC__) && !defined(__clang__) \
+&&  (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)) \
+&&  (defined(__x86_64__) || defined(__i386__))
+#define LIBNN_MULTI_ISA
+#endif
+
+
+namespace libnn {
+namespace math {
+namespace cpu {
+
+/**
+ *  \brief  Instruction set (of the numeric kernels)
+ */
+enum isa_t {
+    GENERIC = 0,  /**< As allowed by the compiler flags         */
+    SSE42   = 1,  /**< SSE 4.2 (128 bit vectors)                */
+    AVX2    = 2,  /**< AVX2 and FMA (256 bit vectors)           */
+    AVX512  = 3,  /**< AVX-512 Foundation (512 bit vectors)     */
+};  // end of enum isa_t
+
+/** Instruction set count */
+static const size_t isa_cnt = 4;
+
+
+/**
+ *  \brief  Check instruction set availability
+ *
+ *  The instruction set is available if the kernels were compiled
+ *  for it (see \c LIBNN_MULTI_ISA) and the CPU (and OS) supports it.
+ *
+ *  \param  isa  Instruction set
+ *
+ *  \return \c true iff the kernels may use the instruction set
+ */
+inline bool available(isa_t isa) {
+#ifdef LIBNN_MULTI_ISA
+    __builtin_cpu_init();
+
+    switch (isa) {
+        case GENERIC: return true;
+        case SSE42:   return __builtin_cpu_supports("sse4.2");
+        case AVX2:    return __builtin_cpu_supports("avx2")
+                          && __builtin_cpu_supports("fma");
+        case AVX512:  return __builtin_cpu_supports("avx512f");
+    }
+
+    return false;
+#else
+    return GENERIC == isa;
+#endif  // end of #ifdef LIBNN_MULTI_ISA
+}
+
+
+/**
+ *  \brief  Instruction set name
+ *
+ *  \param  isa  Instruction set
+ *
+ *  \return \c generic, \c sse4.2, \c avx2 or \c avx512
+ */
+inline const char * name(isa_t isa) {
+    switch (isa) {
+        case GENERIC: return "generic";
+        case SSE42:   return "sse4.2";
+        case AVX2:    return "avx2";
+        case AVX512:  return "avx512";
+    }
+
+    return "unknown";
+}
+
+
+namespace impl {
+
+/**
+ *  \brief  Initial instruction set
+ *
+ *  The best available instruction set is used, unless the \c LIBNN_ISA
+ *  environment variable sets one (by name, see \ref name).
+ *  The latter is meant for testing and for reproduction of numeric
+ *  results (the kernels results differ in rounding).
+ *
+ *  \return Instruction set
+ */
+inline isa_t initial_isa() {
+    const char * env = ::getenv("LIBNN_ISA");
+
+    if (NULL != env) {
+        for (size_t i = 0; i < isa_cnt; ++i) {
+            const isa_t isa = (isa_t)i;
+
+            if (0 != std::strcmp(env, name(isa))) continue;
+
+            if (!available(isa))
+                throw std::logic_error(
+                    "libnn::math::cpu: instruction set set by LIBNN_ISA "
+                    "is not available");
+
+            return isa;
+        }
+
+        throw std::logic_error(
+            "libnn::math::cpu: LIBNN_ISA shall be "
+            "generic, sse4.2, avx2 or avx512");
+    }
+
+    for (size_t i = isa_cnt - 1; i > 0; --i)
+        if (available((isa_t)i)) return (isa_t)i;
+
+    return GENERIC;
+}
+
+/** Selected instruction set (resolved once) */
+inline isa_t & selected_isa() {
+    static isa_t isa = initial_isa();
+    return isa;
+}
+
+}  // end of namespace impl
+
+
+/**
+ *  \brief  Selected instruction set
+ *
+ *  \return Instruction set used by the numeric kernels
+ */
+inline isa_t isa() { return impl::selected_isa(); }
+
+/**
+ *  \brief  Select instruction set
+ *
+ *  Note that the selection is global (not thread-safe); it's meant
+ *  to be done at program start (or in tests).
+ *
+ *  \param  isa  Instruction set
+ */
+inline void isa(isa_t isa) {
+    if (!available(isa))
+        throw std::logic_error(
+            "libnn::math::cpu: instruction set not available");
+
+    impl::selected_isa() = isa;
+}
+
+}}}  // end of namespace libnn::math::cpu
+
+
+#endif  // end of #ifndef libnn__math__cpu_hxx
@@ -0,0 +1,646 @@
+#ifndef libnn__math__gemm_hxx
+#define libnn__math__gemm_hxx
+
+/**
+ *  General matrix multiplication and related kernels
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libnn/math/simd.hxx"
+#include "libnn/math/cpu.hxx"
+#include "libnn/misc/executor.hxx"
+
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+#include <thread>
+
+
+namespace libnn {
+namespace math {
+
+/**
+ *  \brief  Matrix operand transposition
+ */
+enum transpose_t {
+    NO_TRANS = 0,  /**< Use the matrix as is  */
+    TRANS    = 1,  /**< Use transposed matrix */
+};  // end of enum transpose_t
+
+
+namespace impl {
+
+/** GEMM block size (rows of C, i.e. packed A block) */
+static const size_t gemm_block_m = 64;
+
+/** GEMM block size (inner dimension) */
+static const size_t gemm_block_k = 256;
+
+/** GEMM block size (columns of C, i.e. packed B block) */
+static const size_t gemm_block_n = 1024;
+
+/** GEMM register tile rows */
+static const size_t gemm_tile_m = 4;
+
+
+/** Minimal GEMM flop count to justify packing (smaller are done directly) */
+static const size_t gemm_pack_min = 4096;
+
+/** Minimal GEMM flop count per thread (see \c gemm_threaded) */
+static const size_t gemm_thread_min = 1 << 18;
+
+/**
+ *  \brief  Matrix element access
+ *
+ *  \param  m      Matrix (row-major)
+ *  \param  ld     Leading dimension (row stride)
+ *  \param  trans  Transposition
+ *  \param  i      Row (of the possibly transposed matrix)
+ *  \param  j      Column (of the possibly transposed matrix)
+ *
+ *  \return Element
+ */
+template <typename Base_t>
+inline const Base_t & at(
+    const Base_t * m, size_t ld, transpose_t trans, size_t i, size_t j)
+{
+    return TRANS == trans ? m[j * ld + i] : m[i * ld + j];
+}
+
+/**
+ *  \brief  Kernel workspace
+ *
+ *  Packing buffers are kept per thread and reused by subsequent calls
+ *  (they only grow).
+ *
+ *  \tparam  Base_t  Base numeric type
+ */
+template <typename Base_t>
+struct workspace {
+    std::vector<Base_t> a;  /**< Packed A block        */
+    std::vector<Base_t> b;  /**< Packed B block        */
+    std::vector<Base_t> x;  /**< Contiguous GEMV input */
+    std::vector<Base_t> y;  /**< Contiguous GEMV output */
+
+    /** Workspace of the calling thread */
+    static workspace & get() {
+        static thread_local workspace ws;
+        return ws;
+    }
+
+};  // end of template struct workspace
+
+
+/**
+ *  \brief  Scale matrix (C = beta C)
+ *
+ *  \param  m     Rows
+ *  \param  n     Columns
+ *  \param  beta  Factor
+ *  \param  c     Matrix
+ *  \param  ldc   Leading dimension
+ */
+template <typename Base_t>
+void scale(size_t m, size_t n, const Base_t & beta, Base_t * c, size_t ldc) {
+    if (1 == beta) return;
+
+    for (size_t i = 0; i < m; ++i) {
+        Base_t * c_row = c + i * ldc;
+
+        if (0 == beta)
+            std::fill(c_row, c_row + n, Base_t(0));
+        else
+            for (size_t j = 0; j < n; ++j) c_row[j] *= beta;
+    }
+}
+
+
+/*
+ *  Instruction set specific kernels
+ *
+ *  The kernels (see kernels.hxx) are compiled in namespace of each
+ *  instruction set, for the instruction set target.
+ *  The selected set (see cpu::isa) is used via kernel table.
+ */
+
+namespace generic {
+#define LIBNN_KERNELS_SIMD_BYTES LIBNN_SIMD_BYTES
+#include "libnn/math/kernels.hxx"
+#undef LIBNN_KERNELS_SIMD_BYTES
+}  // end of namespace generic
+
+#ifdef LIBNN_MULTI_ISA
+
+#pragma GCC push_options
+#pragma GCC target("sse4.2")
+namespace sse42 {
+#define LIBNN_KERNELS_SIMD_BYTES 16
+#include "libnn/math/kernels.hxx"
+#undef LIBNN_KERNELS_SIMD_BYTES
+}  // end of namespace sse42
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+namespace avx2 {
+#define LIBNN_KERNELS_SIMD_BYTES 32
+#include "libnn/math/kernels.hxx"
+#undef LIBNN_KERNELS_SIMD_BYTES
+}  // end of namespace avx2
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+namespace avx512 {
+#define LIBNN_KERNELS_SIMD_BYTES 64
+#include "libnn/math/kernels.hxx"
+#undef LIBNN_KERNELS_SIMD_BYTES
+}  // end of namespace avx512
+#pragma GCC pop_options
+
+#endif  // end of #ifdef LIBNN_MULTI_ISA
+
+
+/**
+ *  \brief  Kernel table
+ *
+ *  Kernels compiled for an instruction set.
+ *  The tables are initialised once; the table of the selected
+ *  instruction set is looked up by each call of the public routines.
+ *
+ *  \tparam  Base_t  Base numeric type
+ */
+template <typename Base_t>
+struct kernels {
+    /** Dot product */
+    typedef Base_t (*dot_t)(const Base_t *, const Base_t *, size_t);
+
+    /** Scaled vector addition */
+    typedef void (*axpy_t)(const Base_t &, const Base_t *, Base_t *, size_t);
+
+    /** GEMV of contiguous vectors */
+    typedef void (*gemv_t)(
+        transpose_t, size_t, size_t, const Base_t &,
+        const Base_t *, size_t, const Base_t *, Base_t *);
+
+    /** GEMM */
+    typedef void (*gemm_t)(
+        transpose_t, transpose_t, size_t, size_t, size_t, const Base_t &,
+        const Base_t *, size_t, const Base_t *, size_t, Base_t *, size_t);
+
+    dot_t  dot;          /**< Dot product (\c dot)                     */
+    axpy_t axpy;         /**< y += alpha x (\c axpy)                   */
+    gemv_t gemv;         /**< GEMV (\c gemv_contiguous)                */
+    gemm_t gemm_small;   /**< Small GEMM (\c gemm_small)               */
+    gemm_t gemm_packed;  /**< Packed GEMM (\c gemm_packed)             */
+    size_t tile_n;       /**< GEMM register tile columns               */
+
+    /**
+     *  \brief  Kernel table of instruction set
+     *
+     *  \param  isa  Instruction set
+     *
+     *  \return Kernel table (generic if the set is not compiled)
+     */
+    static const kernels & get(cpu::isa_t isa) {
+#define LIBNN_KERNELS(ns) { \
+    &ns::dot<Base_t>, &ns::axpy<Base_t>, &ns::gemv_contiguous<Base_t>, \
+    &ns::gemm_small<Base_t>, &ns::gemm_packed<Base_t>, \
+    ns::gemm_tile_n<Base_t>::value }
+
+        static const kernels table[cpu::isa_cnt] = {
+            LIBNN_KERNELS(generic),
+#ifdef LIBNN_MULTI_ISA
+            LIBNN_KERNELS(sse42),
+            LIBNN_KERNELS(avx2),
+            LIBNN_KERNELS(avx512),
+#else
+            LIBNN_KERNELS(generic),
+            LIBNN_KERNELS(generic),
+            LIBNN_KERNELS(generic),
+#endif  // end of #ifdef LIBNN_MULTI_ISA
+        };
+
+#undef LIBNN_KERNELS
+
+        return table[isa];
+    }
+
+    /** Kernel table of the selected instruction set */
+    static const kernels & selected() { return get(cpu::isa()); }
+
+};  // end of template struct kernels
+
+}  // end of namespace impl
+
+
+/**
+ *  \brief  Dot product of contiguous vectors
+ *
+ *  \tparam Base_t  Base numeric type
+ *  \param  x       Vector
+ *  \param  y       Vector
+ *  \param  n       Vector size
+ *
+ *  \return x^T y
+ */
+template <typename Base_t>
+inline Base_t dot(const Base_t * x, const Base_t * y, size_t n) {
+    return impl::kernels<Base_t>::selected().dot(x, y, n);
+}
+
+/**
+ *  \brief  Scaled vector addition (y += alpha x) of contiguous vectors
+ *
+ *  \tparam Base_t  Base numeric type
+ *  \param  alpha   Factor
+ *  \param  x       Vector
+ *  \param  y       Vector (updated)
+ *  \param  n       Vector size
+ */
+template <typename Base_t>
+inline void axpy(const Base_t & alpha, const Base_t * x, Base_t * y, size_t n) {
+    impl::kernels<Base_t>::selected().axpy(alpha, x, y, n);
+}
+
+
+
+
+/**
+ *  \brief  General matrix-vector multiplication
+ *
+ *  Computes y = alpha op(A) x + beta y, where op(A) is either A
+ *  or its transposition.
+ *  A is an \c m x \c n matrix stored in row-major order; op(A) x
+ *  therefore has \c m elements (\c n if transposed).
+ *  Vector elements are \c incx (\c incy) apart.
+ *
+ *  \tparam Base_t  Base numeric type
+ *  \param  trans   A transposition
+ *  \param  m       A rows
+ *  \param  n       A columns
+ *  \param  alpha   op(A) x factor
+ *  \param  a       Matrix A
+ *  \param  lda     A leading dimension
+ *  \param  x       Vector x
+ *  \param  incx    x increment
+ *  \param  beta    y factor
+ *  \param  y       Vector y
+ *  \param  incy    y increment
+ */
+template <typename Base_t>
+void gemv(
+    transpose_t    trans,
+    size_t         m,
+    size_t         n,
+    const Base_t & alpha,
+    const Base_t * a,
+    size_t         lda,
+    const Base_t * x,
+    size_t         incx,
+    const Base_t & beta,
+    Base_t       * y,
+    size_t         incy)
+{
+    const size_t x_size = NO_TRANS == trans ? n : m;
+    const size_t y_size = NO_TRANS == trans ? m : n;
+
+    // y = beta y
+    impl::scale(y_size, 1, beta, y, incy);
+
+    if (0 == alpha) return;
+
+    impl::workspace<Base_t> & ws = impl::workspace<Base_t>::get();
+
+    // Make vectors contiguous
+    const Base_t * x_cont = x;
+    if (1 != incx) {
+        ws.x.resize(x_size);
+        for (size_t i = 0; i < x_size; ++i) ws.x[i] = x[i * incx];
+
+        x_cont = ws.x.data();
+    }
+
+    Base_t * y_cont = y;
+    if (1 != incy) {
+        ws.y.resize(y_size);
+        for (size_t i = 0; i < y_size; ++i) ws.y[i] = y[i * incy];
+
+        y_cont = ws.y.data();
+    }
+
+    impl::kernels<Base_t>::selected().gemv(
+        trans, m, n, alpha, a, lda, x_cont, y_cont);
+
+    if (1 != incy)
+        for (size_t i = 0; i < y_size; ++i) y[i * incy] = ws.y[i];
+}
+
+
+/**
+ *  \brief  General matrix multiplication
+ *
+ *  Computes C = alpha op(A) op(B) + beta C, where op(X) is either X
+ *  or its transposition.
+ *  All matrices are stored in row-major order; op(A) is M x K,
+ *  op(B) is K x N and C is M x N.
+ *
+ *  The computation is cache-blocked: a block of op(B) (K x N blocks
+ *  of \c impl::gemm_block_k x \c impl::gemm_block_n) and a block
+ *  of op(A) (\c impl::gemm_block_m x \c impl::gemm_block_k) are packed
+ *  to contiguous panels; the C tiles are then computed by register-tiled
+ *  SIMD micro-kernel (see \c kernels.hxx).
+ *  The packing buffers are kept per thread and reused.
+ *  Matrix-vector products (i.e. \c m or \c n is 1) are done by \ref gemv,
+ *  very small products without packing.
+ *  The kernels of the selected instruction set are used (see
+ *  \ref cpu::isa).
+ *
+ *  \tparam Base_t   Base numeric type
+ *  \param  trans_a  A transposition
+ *  \param  trans_b  B transposition
+ *  \param  m        Rows of op(A) and C
+ *  \param  n        Columns of op(B) and C
+ *  \param  k        Columns of op(A), rows of op(B)
+ *  \param  alpha    op(A) op(B) factor
+ *  \param  a        Matrix A
+ *  \param  lda      A leading dimension
+ *  \param  b        Matrix B
+ *  \param  ldb      B leading dimension
+ *  \param  beta     C factor
+ *  \param  c        Matrix C
+ *  \param  ldc      C leading dimension
+ */
+template <typename Base_t>
+void gemm(
+    transpose_t    trans_a,
+    transpose_t    trans_b,
+    size_t         m,
+    size_t         n,
+    size_t         k,
+    const Base_t & alpha,
+    const Base_t * a,
+    size_t         lda,
+    const Base_t * b,
+    size_t         ldb,
+    const Base_t & beta,
+    Base_t       * c,
+    size_t         ldc)
+{
+    // C = beta C
+    impl::scale(m, n, beta, c, ldc);
+
+    if (0 == alpha || 0 == m || 0 == n || 0 == k) return;
+
+    // C row = alpha op(A) row op(B)  (i.e. y = alpha op(B)^T x)
+    if (1 == m) {
+        gemv(NO_TRANS == trans_b ? TRANS : NO_TRANS,
+            NO_TRANS == trans_b ? k : n,
+            NO_TRANS == trans_b ? n : k,
+            alpha, b, ldb,
+            a, NO_TRANS == trans_a ? 1 : lda,
+            Base_t(1), c, 1);
+    }
+
+    // C column = alpha op(A) op(B) column
+    else if (1 == n) {
+        gemv(trans_a,
+            NO_TRANS == trans_a ? m : k,
+            NO_TRANS == trans_a ? k : m,
+            alpha, a, lda,
+            b, NO_TRANS == trans_b ? ldb : 1,
+            Base_t(1), c, ldc);
+    }
+
+    // Small matrices
+    else if (m * n * k < impl::gemm_pack_min) {
+        impl::kernels<Base_t>::selected().gemm_small(
+            trans_a, trans_b, m, n, k, alpha, a, lda, b, ldb, c, ldc);
+    }
+
+    else {
+        impl::kernels<Base_t>::selected().gemm_packed(
+            trans_a, trans_b, m, n, k, alpha, a, lda, b, ldb, c, ldc);
+    }
+}
+
+
+/**
+ *  \brief  General matrix multiplication (threaded)
+ *
+ *  Same as \ref gemm, but the computation is split to (at most)
+ *  \c threads parts computed concurrently.
+ *  C is split by rows (or columns if it has more of them); each part
+ *  is computed by \ref gemm in a separate thread (with its own packing
+ *  buffers).
+ *  Small products are computed by the calling thread only.
+ *
+ *  \tparam Base_t   Base numeric type
+ *  \param  threads  Thread count (0 means hardware concurrency)
+ *  \param  trans_a  A transposition
+ *  \param  trans_b  B transposition
+ *  \param  m        Rows of op(A) and C
+ *  \param  n        Columns of op(B) and C
+ *  \param  k        Columns of op(A), rows of op(B)
+ *  \param  alpha    op(A) op(B) factor
+ *  \param  a        Matrix A
+ *  \param  lda      A leading dimension
+ *  \param  b        Matrix B
+ *  \param  ldb      B leading dimension
+ *  \param  beta     C factor
+ *  \param  c        Matrix C
+ *  \param  ldc      C leading dimension
+ */
+template <typename Base_t>
+void gemm_threaded(
+    size_t         threads,
+    transpose_t    trans_a,
+    transpose_t    trans_b,
+    size_t         m,
+    size_t         n,
+    size_t         k,
+    const Base_t & alpha,
+    const Base_t * a,
+    size_t         lda,
+    const Base_t * b,
+    size_t         ldb,
+    const Base_t & beta,
+    Base_t       * c,
+    size_t         ldc)
+{
+    if (0 == threads) threads = std::thread::hardware_concurrency();
+
+    // Limit thread count so that each has enough work
+    threads = std::min(threads, m * n * k / impl::gemm_thread_min);
+
+    const bool   by_rows = m >= n;
+    const size_t size    = by_rows ? m : n;
+    const size_t unit    = by_rows
+        ? impl::gemm_tile_m : impl::kernels<Base_t>::selected().tile_n;
+
+    threads = std::min(threads, (size + unit - 1) / unit);
+
+    if (threads < 2) {
+        gemm(trans_a, trans_b, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+        return;
+    }
+
+    // Part size (whole tiles)
+    const size_t part = ((size + threads - 1) / threads + unit - 1)
+        / unit * unit;
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+
+    for (size_t begin = 0; begin < size; begin += part) {
+        const size_t cnt = std::min(part, size - begin);
+
+        const Base_t * a_part = a;
+        const Base_t * b_part = b;
+        Base_t       * c_part = c;
+
+        if (by_rows) {
+            a_part += NO_TRANS == trans_a ? begin * lda : begin;
+            c_part += begin * ldc;
+        }
+        else {
+            b_part += NO_TRANS == trans_b ? begin : begin * ldb;
+            c_part += begin;
+        }
+
+        workers.emplace_back(
+        [=, &alpha, &beta]() {
+            gemm(trans_a, trans_b,
+                by_rows ? cnt : m, by_rows ? n : cnt, k,
+                alpha, a_part, lda, b_part, ldb, beta, c_part, ldc);
+        });
+    }
+
+    std::for_each(workers.begin(), workers.end(),
+    [](std::thread & worker) {
+        worker.join();
+    });
+}
+
+
+/**
+ *  \brief  General matrix multiplication (parallel)
+ *
+ *  Same as \ref gemm, but the computation is split to parts
+ *  (whole tiles of C rows or columns) processed by an executor
+ *  (e.g. the library \c misc::thread_pool), so that no threads are
+ *  created per call.
+ *  The parts are large enough for the threading to pay off.
+ *
+ *  \tparam Base_t   Base numeric type
+ *  \param  exec     Executor
+ *  \param  trans_a  A transposition
+ *  \param  trans_b  B transposition
+ *  \param  m        Rows of op(A) and C
+ *  \param  n        Columns of op(B) and C
+ *  \param  k        Columns of op(A), rows of op(B)
+ *  \param  alpha    op(A) op(B) factor
+ *  \param  a        Matrix A
+ *  \param  lda      A leading dimension
+ *  \param  b        Matrix B
+ *  \param  ldb      B leading dimension
+ *  \param  beta     C factor
+ *  \param  c        Matrix C
+ *  \param  ldc      C leading dimension
+ */
+template <typename Base_t>
+void gemm_threaded(
+    misc::executor & exec,
+    transpose_t      trans_a,
+    transpose_t      trans_b,
+    size_t           m,
+    size_t           n,
+    size_t           k,
+    const Base_t   & alpha,
+    const Base_t   * a,
+    size_t           lda,
+    const Base_t   * b,
+    size_t           ldb,
+    const Base_t   & beta,
+    Base_t         * c,
+    size_t           ldc)
+{
+    const bool   by_rows = m >= n;
+    const size_t size    = by_rows ? m : n;
+    const size_t unit    = by_rows
+        ? impl::gemm_tile_m : impl::kernels<Base_t>::selected().tile_n;
+
+    const size_t tiles     = (size + unit - 1) / unit;
+    const size_t tile_work = unit * (by_rows ? n : m) * std::max<size_t>(1, k);
+
+    // Tiles per part (so that each has enough work)
+    const size_t grain = std::max<size_t>(1,
+        (impl::gemm_thread_min + tile_work - 1) / tile_work);
+
+    if (exec.concurrency() < 2 || tiles <= grain) {
+        gemm(trans_a, trans_b, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+        return;
+    }
+
+    exec.parallel_for(0, tiles,
+    [=, &alpha, &beta](size_t tile_begin, size_t tile_end) {
+        const size_t begin = tile_begin * unit;
+        const size_t cnt   = std::min(tile_end * unit, size) - begin;
+
+        const Base_t * a_part = a;
+        const Base_t * b_part = b;
+        Base_t       * c_part = c;
+
+        if (by_rows) {
+            a_part += NO_TRANS == trans_a ? begin * lda : begin;
+            c_part += begin * ldc;
+        }
+        else {
+            b_part += NO_TRANS == trans_b ? begin : begin * ldb;
+            c_part += begin;
+        }
+
+        gemm(trans_a, trans_b,
+            by_rows ? cnt : m, by_rows ? n : cnt, k,
+            alpha, a_part, lda, b_part, ldb, beta, c_part, ldc);
+    }, grain);
+}
+
+}}  // end of namespace libnn::math
+
+#endif  // end of #ifndef libnn__math__gemm_hxx
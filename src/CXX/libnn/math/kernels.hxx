@@ -0,0 +1,537 @@
+/**
+ *  Numeric kernels (instruction set specific part)
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/*
+ *  NOTE: This file deliberately has no include guard.
+ *  It's included in several namespaces (one per instruction set),
+ *  each time compiled for different target (see gemm.hxx).
+ *  The \c LIBNN_KERNELS_SIMD_BYTES macro sets the SIMD vector size.
+ *  Standard headers must be included beforehand.
+ */
+
+#ifndef LIBNN_KERNELS_SIMD_BYTES
+#error "LIBNN_KERNELS_SIMD_BYTES must be defined (see libnn/math/gemm.hxx)"
+#endif
+
+
+/**
+ *  \brief  SIMD vector (generic, scalar implementation)
+ *
+ *  Thin abstraction of short vector instructions used by the numeric
+ *  kernels (see \c gemm.hxx).
+ *  The generic template uses 1 lane (i.e. scalar operations);
+ *  \c float and \c double are specialised using the GNU vector
+ *  extensions (if available) of \c LIBNN_KERNELS_SIMD_BYTES size,
+ *  so that the compiler emits instructions of the target instruction
+ *  set.
+ *
+ *  Loads and stores don't require alignment.
+ *
+ *  \tparam  Base_t  Base numeric type
+ */
+template <typename Base_t>
+struct simd {
+    typedef Base_t vec_t;  /**< Vector type */
+
+    static const size_t lanes = 1;  /**< Vector length */
+
+    /** Load vector */
+    static vec_t load(const Base_t * p) { return *p; }
+
+    /** Store vector */
+    static void store(Base_t * p, const vec_t & v) { *p = v; }
+
+    /** Zero vector */
+    static vec_t zero() { return Base_t(0); }
+
+    /** Sum of vector elements */
+    static Base_t sum(const vec_t & v) { return v; }
+
+};  // end of template struct simd
+
+/** \cond */
+template <typename Base_t>
+const size_t simd<Base_t>::lanes;
+/** \endcond */
+
+#ifdef __GNUC__
+
+/**
+ *  \brief  SIMD vector using GNU vector extensions
+ *
+ *  \tparam  Base_t  Base numeric type
+ *  \tparam  Vec_t   Vector type
+ */
+template <typename Base_t, typename Vec_t>
+struct gnu_simd {
+    typedef Vec_t vec_t;  /**< Vector type */
+
+    static const size_t lanes = sizeof(vec_t) / sizeof(Base_t);  /**< Length */
+
+    /** Load vector */
+    static vec_t load(const Base_t * p) {
+        vec_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    /** Store vector */
+    static void store(Base_t * p, const vec_t & v) {
+        std::memcpy(p, &v, sizeof(v));
+    }
+
+    /** Zero vector */
+    static vec_t zero() { return vec_t(); }
+
+    /** Sum of vector elements */
+    static Base_t sum(const vec_t & v) {
+        Base_t s = 0;
+        for (size_t i = 0; i < lanes; ++i) s += v[i];
+        return s;
+    }
+
+};  // end of template struct gnu_simd
+
+/** \cond */
+template <typename Base_t, typename Vec_t>
+const size_t gnu_simd<Base_t, Vec_t>::lanes;
+/** \endcond */
+
+/** \c float vector */
+typedef float  float_vec_t  __attribute__((vector_size(LIBNN_KERNELS_SIMD_BYTES)));
+
+/** \c double vector */
+typedef double double_vec_t __attribute__((vector_size(LIBNN_KERNELS_SIMD_BYTES)));
+
+/** SIMD vector of \c float */
+template <>
+struct simd<float>: public gnu_simd<float, float_vec_t> {};
+
+/** SIMD vector of \c double */
+template <>
+struct simd<double>: public gnu_simd<double, double_vec_t> {};
+
+#endif  // end of #ifdef __GNUC__
+
+
+/**
+ *  \brief  Dot product of contiguous vectors
+ *
+ *  \tparam Base_t  Base numeric type
+ *  \param  x       Vector
+ *  \param  y       Vector
+ *  \param  n       Vector size
+ *
+ *  \return x^T y
+ */
+template <typename Base_t>
+Base_t dot(const Base_t * x, const Base_t * y, size_t n) {
+    typedef simd<Base_t> simd_t;
+
+    const size_t l = simd_t::lanes;
+
+    typename simd_t::vec_t acc0 = simd_t::zero(), acc1 = simd_t::zero();
+
+    size_t i = 0;
+    for (; i + 2 * l <= n; i += 2 * l) {
+        acc0 += simd_t::load(x + i)     * simd_t::load(y + i);
+        acc1 += simd_t::load(x + i + l) * simd_t::load(y + i + l);
+    }
+
+    Base_t res = simd_t::sum(acc0 + acc1);
+    for (; i < n; ++i) res += x[i] * y[i];
+
+    return res;
+}
+
+/**
+ *  \brief  Scaled vector addition (y += alpha x) of contiguous vectors
+ *
+ *  \tparam Base_t  Base numeric type
+ *  \param  alpha   Factor
+ *  \param  x       Vector
+ *  \param  y       Vector (updated)
+ *  \param  n       Vector size
+ */
+template <typename Base_t>
+void axpy(const Base_t & alpha, const Base_t * x, Base_t * y, size_t n) {
+    typedef simd<Base_t> simd_t;
+
+    const size_t l = simd_t::lanes;
+
+    size_t i = 0;
+    for (; i + l <= n; i += l)
+        simd_t::store(y + i, simd_t::load(y + i) + alpha * simd_t::load(x + i));
+
+    for (; i < n; ++i) y[i] += alpha * x[i];
+}
+
+/**
+ *  \brief  GEMM register tile vectors per row
+ *
+ *  Register tile has \c gemm_tile_m rows of \c gemm_tile_v vectors.
+ */
+template <typename Base_t>
+struct gemm_tile_v {
+    static const size_t value = 1 == simd<Base_t>::lanes ? 4 : 2;
+};
+
+/** \cond */
+template <typename Base_t>
+const size_t gemm_tile_v<Base_t>::value;
+/** \endcond */
+
+/**
+ *  \brief  GEMM register tile columns
+ *
+ *  \tparam  Base_t  Base numeric type
+ */
+template <typename Base_t>
+struct gemm_tile_n {
+    static const size_t value = gemm_tile_v<Base_t>::value * simd<Base_t>::lanes;
+};
+
+/** \cond */
+template <typename Base_t>
+const size_t gemm_tile_n<Base_t>::value;
+/** \endcond */
+
+/**
+ *  \brief  Pack block of op(A)
+ *
+ *  The block (\c mc x \c kc) is stored as sequence of panels of
+ *  \c gemm_tile_m rows; each panel is stored column by column
+ *  (i.e. in the order the micro-kernel reads it).
+ *  Incomplete panel is padded by zeros.
+ *  The \c alpha factor is applied.
+ *
+ *  \param  trans  A transposition
+ *  \param  a      A block (top left element)
+ *  \param  lda    A leading dimension
+ *  \param  mc     Block rows
+ *  \param  kc     Block columns
+ *  \param  alpha  Factor
+ *  \param  pack   Packed block
+ */
+template <typename Base_t>
+void pack_a(
+    transpose_t    trans,
+    const Base_t * a,
+    size_t         lda,
+    size_t         mc,
+    size_t         kc,
+    const Base_t & alpha,
+    Base_t       * pack)
+{
+    const size_t mr = gemm_tile_m;
+
+    for (size_t i0 = 0; i0 < mc; i0 += mr) {
+        const size_t rows = std::min(mr, mc - i0);
+
+        for (size_t p = 0; p < kc; ++p) {
+            size_t i = 0;
+            for (; i < rows; ++i)
+                *pack++ = alpha * at(a, lda, trans, i0 + i, p);
+
+            for (; i < mr; ++i) *pack++ = 0;
+        }
+    }
+}
+
+/**
+ *  \brief  Pack block of op(B)
+ *
+ *  The block (\c kc x \c nc) is stored as sequence of panels of
+ *  \c gemm_tile_n columns; each panel is stored row by row.
+ *  Incomplete panel is padded by zeros.
+ *
+ *  \param  trans  B transposition
+ *  \param  b      B block (top left element)
+ *  \param  ldb    B leading dimension
+ *  \param  kc     Block rows
+ *  \param  nc     Block columns
+ *  \param  pack   Packed block
+ */
+template <typename Base_t>
+void pack_b(
+    transpose_t    trans,
+    const Base_t * b,
+    size_t         ldb,
+    size_t         kc,
+    size_t         nc,
+    Base_t       * pack)
+{
+    const size_t nr = gemm_tile_n<Base_t>::value;
+
+    for (size_t j0 = 0; j0 < nc; j0 += nr) {
+        const size_t cols = std::min(nr, nc - j0);
+
+        for (size_t p = 0; p < kc; ++p) {
+            size_t j = 0;
+
+            if (NO_TRANS == trans) {
+                const Base_t * b_row = b + p * ldb + j0;
+                for (; j < cols; ++j) *pack++ = b_row[j];
+            }
+            else {
+                for (; j < cols; ++j) *pack++ = b[(j0 + j) * ldb + p];
+            }
+
+            for (; j < nr; ++j) *pack++ = 0;
+        }
+    }
+}
+
+/**
+ *  \brief  GEMM micro-kernel
+ *
+ *  Computes C tile += A panel * B panel using register tile
+ *  of \c gemm_tile_m x \c gemm_tile_n accumulators (SIMD vectors).
+ *  Only \c m x \c n part of the tile is stored to C (edge tiles).
+ *
+ *  \param  kc   Inner dimension
+ *  \param  a    Packed A panel
+ *  \param  b    Packed B panel
+ *  \param  c    C tile (top left element)
+ *  \param  ldc  C leading dimension
+ *  \param  m    C tile rows
+ *  \param  n    C tile columns
+ */
+template <typename Base_t>
+void gemm_kernel(
+    size_t         kc,
+    const Base_t * a,
+    const Base_t * b,
+    Base_t       * c,
+    size_t         ldc,
+    size_t         m,
+    size_t         n)
+{
+    typedef simd<Base_t> simd_t;
+    typedef typename simd_t::vec_t vec_t;
+
+    const size_t mr = gemm_tile_m;
+    const size_t nv = gemm_tile_v<Base_t>::value;
+    const size_t l  = simd_t::lanes;
+    const size_t nr = nv * l;
+
+    vec_t acc[gemm_tile_m][gemm_tile_v<Base_t>::value];
+    LIBNN_UNROLL
+    for (size_t i = 0; i < mr; ++i)
+        LIBNN_UNROLL
+        for (size_t v = 0; v < nv; ++v)
+            acc[i][v] = simd_t::zero();
+
+    for (size_t p = 0; p < kc; ++p, a += mr, b += nr) {
+        vec_t b_vec[gemm_tile_v<Base_t>::value];
+        LIBNN_UNROLL
+        for (size_t v = 0; v < nv; ++v)
+            b_vec[v] = simd_t::load(b + v * l);
+
+        LIBNN_UNROLL
+        for (size_t i = 0; i < mr; ++i) {
+            const Base_t a_i = a[i];
+
+            LIBNN_UNROLL
+            for (size_t v = 0; v < nv; ++v)
+                acc[i][v] += a_i * b_vec[v];
+        }
+    }
+
+    // Full tile
+    if (mr == m && nr == n) {
+        for (size_t i = 0; i < mr; ++i) {
+            Base_t * c_row = c + i * ldc;
+
+            for (size_t v = 0; v < nv; ++v)
+                simd_t::store(c_row + v * l,
+                    simd_t::load(c_row + v * l) + acc[i][v]);
+        }
+
+        return;
+    }
+
+    // Edge tile
+    Base_t tile[gemm_tile_m * gemm_tile_n<Base_t>::value];
+    for (size_t i = 0; i < mr; ++i)
+        for (size_t v = 0; v < nv; ++v)
+            simd_t::store(tile + i * nr + v * l, acc[i][v]);
+
+    for (size_t i = 0; i < m; ++i)
+        for (size_t j = 0; j < n; ++j)
+            c[i * ldc + j] += tile[i * nr + j];
+}
+
+/**
+ *  \brief  GEMV (y += alpha op(A) x) of contiguous vectors
+ *
+ *  \param  trans  A transposition
+ *  \param  m      A rows
+ *  \param  n      A columns
+ *  \param  alpha  Factor
+ *  \param  a      A
+ *  \param  lda    A leading dimension
+ *  \param  x      Input vector
+ *  \param  y      Output vector
+ */
+template <typename Base_t>
+void gemv_contiguous(
+    transpose_t    trans,
+    size_t         m,
+    size_t         n,
+    const Base_t & alpha,
+    const Base_t * a,
+    size_t         lda,
+    const Base_t * x,
+    Base_t       * y)
+{
+    // y_i += alpha A_i x (row dot products)
+    if (NO_TRANS == trans) {
+        for (size_t i = 0; i < m; ++i)
+            y[i] += alpha * dot(a + i * lda, x, n);
+    }
+
+    // y += alpha x_i A_i (row by row)
+    else {
+        for (size_t i = 0; i < m; ++i) {
+            const Base_t alpha_x_i = alpha * x[i];
+            if (0 != alpha_x_i) axpy(alpha_x_i, a + i * lda, y, n);
+        }
+    }
+}
+
+/**
+ *  \brief  Packed GEMM (C += alpha op(A) op(B))
+ *
+ *  See \ref math::gemm.
+ */
+template <typename Base_t>
+void gemm_packed(
+    transpose_t    trans_a,
+    transpose_t    trans_b,
+    size_t         m,
+    size_t         n,
+    size_t         k,
+    const Base_t & alpha,
+    const Base_t * a,
+    size_t         lda,
+    const Base_t * b,
+    size_t         ldb,
+    Base_t       * c,
+    size_t         ldc)
+{
+    const size_t mr = gemm_tile_m;
+    const size_t nr = gemm_tile_n<Base_t>::value;
+
+    const size_t mc_max = std::min(gemm_block_m, (m + mr - 1) / mr * mr);
+    const size_t nc_max = std::min(gemm_block_n, (n + nr - 1) / nr * nr);
+    const size_t kc_max = std::min(gemm_block_k, k);
+
+    workspace<Base_t> & ws = workspace<Base_t>::get();
+    if (ws.a.size() < mc_max * kc_max) ws.a.resize(mc_max * kc_max);
+    if (ws.b.size() < kc_max * nc_max) ws.b.resize(kc_max * nc_max);
+
+    for (size_t j0 = 0; j0 < n; j0 += gemm_block_n) {
+        const size_t nc = std::min(gemm_block_n, n - j0);
+
+        for (size_t p0 = 0; p0 < k; p0 += gemm_block_k) {
+            const size_t kc = std::min(gemm_block_k, k - p0);
+
+            pack_b(trans_b,
+                TRANS == trans_b ? b + j0 * ldb + p0 : b + p0 * ldb + j0,
+                ldb, kc, nc, ws.b.data());
+
+            for (size_t i0 = 0; i0 < m; i0 += gemm_block_m) {
+                const size_t mc = std::min(gemm_block_m, m - i0);
+
+                pack_a(trans_a,
+                    TRANS == trans_a ? a + p0 * lda + i0 : a + i0 * lda + p0,
+                    lda, mc, kc, alpha, ws.a.data());
+
+                for (size_t jr = 0; jr < nc; jr += nr) {
+                    const Base_t * b_panel = ws.b.data() + jr * kc;
+
+                    for (size_t ir = 0; ir < mc; ir += mr) {
+                        gemm_kernel(kc,
+                            ws.a.data() + ir * kc, b_panel,
+                            c + (i0 + ir) * ldc + j0 + jr, ldc,
+                            std::min(mr, mc - ir), std::min(nr, nc - jr));
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ *  \brief  Small GEMM (C += alpha op(A) op(B)) without packing
+ *
+ *  See \ref math::gemm.
+ */
+template <typename Base_t>
+void gemm_small(
+    transpose_t    trans_a,
+    transpose_t    trans_b,
+    size_t         m,
+    size_t         n,
+    size_t         k,
+    const Base_t & alpha,
+    const Base_t * a,
+    size_t         lda,
+    const Base_t * b,
+    size_t         ldb,
+    Base_t       * c,
+    size_t         ldc)
+{
+    for (size_t i = 0; i < m; ++i) {
+        Base_t * c_row = c + i * ldc;
+
+        for (size_t p = 0; p < k; ++p) {
+            const Base_t a_ip = alpha * at(a, lda, trans_a, i, p);
+            if (0 == a_ip) continue;
+
+            if (NO_TRANS == trans_b)
+                axpy(a_ip, b + p * ldb, c_row, n);
+            else
+                for (size_t j = 0; j < n; ++j)
+                    c_row[j] += a_ip * b[j * ldb + p];
+        }
+    }
+}
@@ -160,8 +160,34 @@ class hyperbolic_tangent_fn {
         return 2 / (1 + exp(-2 * x)) - 1;
     }
 
+    /** Returns hyperbolic tangent derivation value for \c x */
+    Base_t d(const Base_t & x) const {
+        Base_t f_x = (*this)(x);
+        return 1 - f_x * f_x;
+    }
+
 };  // end of template class hyperbolic_tangent_fn
 
+
+/**
+ *  \brief  Identity
+ *
+ *  Linear activation (e.g. for regression output layers).
+ *
+ *  \tparam  Base_t  Base numeric type
+ */
+template <typename Base_t>
+class identity_fn {
+    public:
+
+    /** Returns \c x */
+    Base_t operator () (const Base_t & x) const { return x; }
+
+    /** Returns identity derivation value (1) */
+    Base_t d(const Base_t & ) const { return 1; }
+
+};  // end of template class identity_fn
+
 }}  // end of namespace libnn::math
 
 #endif  // end of #ifndef libnn__math__sigmoid_hxx
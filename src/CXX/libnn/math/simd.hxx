@@ -0,0 +1,73 @@
+#ifndef libnn__math__simd_hxx
+#define libnn__math__simd_hxx
+
+/**
+ *  SIMD support macros
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ *  \brief  Full unrolling of (short, constant trip count) loop
+ *
+ *  Used in numeric kernels so that SIMD accumulators are kept
+ *  in registers even on lower optimisation levels.
+ */
+#if defined(__clang__)
+#define LIBNN_UNROLL _Pragma("unroll")
+#elif defined(__GNUC__) && __GNUC__ >= 8
+#define LIBNN_UNROLL _Pragma("GCC unroll 16")
+#else
+#define LIBNN_UNROLL
+#endif
+
+
+/**
+ *  \brief  SIMD vector size of the generic kernels (bytes)
+ *
+ *  The generic kernels use the widest vectors allowed by the compiler
+ *  flags (the instruction set specific ones are compiled for their
+ *  target, see \c kernels.hxx and \c cpu.hxx).
+ */
+#if defined(__AVX512F__)
+#define LIBNN_SIMD_BYTES 64
+#elif defined(__AVX__)
+#define LIBNN_SIMD_BYTES 32
+#else
+#define LIBNN_SIMD_BYTES 16
+#endif
+
+#endif  // end of #ifndef libnn__math__simd_hxx
@@ -41,6 +41,7 @@
  */
 
 #include <stdexcept>
+#include <random>
 #include <cmath>
 #include <climits>
 #include <cassert>
@@ -156,6 +157,59 @@ class rng_uniform {
 
 };  // end of template class rng_uniform
 
+
+/**
+ *  \brief  Seeded random number generator of X ~ U(min, max)
+ *
+ *  Unlike \ref rng_uniform, the generator has its own engine instead
+ *  of the global \c ::rand state; generators may therefore be used
+ *  concurrently and the same \c seed always gives the same sequence.
+ *
+ *  \tparam  Base_t  Base numeric type
+ *  \tparam  Engine  Random number engine
+ */
+template <typename Base_t, class Engine = std::mt19937>
+class rng_uniform_seeded {
+    public:
+
+    typedef typename Engine::result_type seed_t;  /**< Seed type */
+
+    private:
+
+    Engine                                 m_engine;  /**< Engine       */
+    std::uniform_real_distribution<Base_t> m_dist;    /**< Distribution */
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  min   Minimal value
+     *  \param  max   Maximal value
+     *  \param  seed  Engine seed
+     */
+    rng_uniform_seeded(
+        const Base_t & min,
+        const Base_t & max,
+        seed_t         seed)
+    :
+        m_engine(seed)
+    {
+        if (!(min <= max))
+            throw std::range_error(
+                "libnn::math::random: "
+                "invalid range specified");
+
+        m_dist = std::uniform_real_distribution<Base_t>(min, max);
+    }
+
+    /**
+     *  \brief  Returns random value within [min, max)
+     */
+    Base_t operator () () { return m_dist(m_engine); }
+
+};  // end of template class rng_uniform_seeded
+
 }}  // end of namespace libnn::math
 
 #endif  // end of #ifndef libnn__math__util_hxx
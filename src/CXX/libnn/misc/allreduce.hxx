@@ -0,0 +1,112 @@
+#ifndef libnn__misc__allreduce_hxx
+#define libnn__misc__allreduce_hxx
+
+/**
+ *  Collective vector sum interface
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstddef>
+
+
+namespace libnn {
+namespace misc {
+
+/**
+ *  \brief  All-reduce (interface)
+ *
+ *  Collective sum of vectors over a group of participants (ranks),
+ *  e.g. processes of a data-parallel training.
+ *  Each rank calls the all-reduce with its own vector of the same size;
+ *  when it returns, all the ranks hold the same element-wise sum.
+ *  Implementations are the \ref local_allreduce (single rank) and
+ *  the \ref shm_allreduce (processes sharing a host).
+ *
+ *  \tparam  T  Element type
+ */
+template <typename T>
+class allreduce {
+    public:
+
+    /** Count of ranks */
+    virtual size_t ranks() const = 0;
+
+    /** Rank of the caller (in [0, ranks)) */
+    virtual size_t rank() const = 0;
+
+    /**
+     *  \brief  Sum vectors of all ranks
+     *
+     *  Blocks until all the ranks call it.
+     *
+     *  \param  data  Vector (replaced by the sum)
+     *  \param  size  Vector size (must be the same for all ranks)
+     */
+    virtual void operator () (T * data, size_t size) = 0;
+
+    /** Destructor */
+    virtual ~allreduce() {}
+
+};  // end of template class allreduce
+
+
+/**
+ *  \brief  Single rank all-reduce
+ *
+ *  The sum of a single vector is the vector itself.
+ *
+ *  \tparam  T  Element type
+ */
+template <typename T>
+class local_allreduce: public allreduce<T> {
+    public:
+
+    /** Single rank */
+    size_t ranks() const { return 1; }
+
+    /** Rank 0 */
+    size_t rank() const { return 0; }
+
+    /** Identity */
+    void operator () (T * data, size_t size) {}
+
+};  // end of template class local_allreduce
+
+}}  // end of namespace libnn::misc
+
+
+#endif  // end of #ifndef libnn__misc__allreduce_hxx
@@ -0,0 +1,392 @@
+#ifndef libnn__misc__array_view_hxx
+#define libnn__misc__array_view_hxx
+
+/**
+ *  Array, matrix and training set views
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <stdexcept>
+
+
+namespace libnn {
+namespace misc {
+
+/**
+ *  \brief  Array view
+ *
+ *  Non-owning view of a contiguous array (e.g. a row of a caller's
+ *  matrix).
+ *  It's an iterable container, so it may be passed as network input
+ *  (or desired output) without copying the data.
+ *
+ *  \tparam  T  Item type (\c const for read-only views)
+ */
+template <typename T>
+class array_view {
+    public:
+
+    typedef T         value_type;      /**< Item type      */
+    typedef T *       iterator;        /**< Iterator       */
+    typedef const T * const_iterator;  /**< Const iterator */
+
+    private:
+
+    T *    m_data;  /**< Data       */
+    size_t m_size;  /**< Item count */
+
+    public:
+
+    /** Constructor (empty view) */
+    array_view(): m_data(NULL), m_size(0) {}
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  data  Data
+     *  \param  size  Item count
+     */
+    array_view(T * data, size_t size): m_data(data), m_size(size) {}
+
+    /** Item count */
+    size_t size() const { return m_size; }
+
+    /** Check emptiness */
+    bool empty() const { return 0 == m_size; }
+
+    /** Data */
+    T * data() const { return m_data; }
+
+    /** Begin iterator */
+    T * begin() const { return m_data; }
+
+    /** End iterator */
+    T * end() const { return m_data + m_size; }
+
+    /** Item access */
+    T & operator [] (size_t i) const { return m_data[i]; }
+
+};  // end of template class array_view
+
+
+/**
+ *  \brief  Matrix view
+ *
+ *  Non-owning view of a row-major matrix (rows may be padded,
+ *  i.e. the row stride may exceed the column count).
+ *  It's a container of rows (\ref array_view), so it may be passed
+ *  as batch of network inputs without copying the data.
+ *
+ *  \tparam  T  Item type (\c const for read-only views)
+ */
+template <typename T>
+class matrix_view {
+    public:
+
+    typedef array_view<T> row_t;       /**< Row        */
+    typedef row_t         value_type;  /**< Value type */
+
+    /** Row iterator */
+    class iterator {
+        friend class matrix_view;
+
+        public:
+
+        typedef std::forward_iterator_tag iterator_category;
+        typedef row_t                     value_type;
+        typedef std::ptrdiff_t            difference_type;
+        typedef const row_t *             pointer;
+        typedef const row_t &             reference;
+
+        private:
+
+        row_t  m_row;     /**< Current row */
+        size_t m_stride;  /**< Row stride  */
+
+        /** Constructor */
+        iterator(T * data, size_t cols, size_t stride):
+            m_row(data, cols),
+            m_stride(stride)
+        {}
+
+        public:
+
+        /** Row */
+        const row_t & operator * () const { return m_row; }
+
+        /** Row access */
+        const row_t * operator -> () const { return &m_row; }
+
+        /** Pre-increment */
+        iterator & operator ++ () {
+            m_row = row_t(m_row.data() + m_stride, m_row.size());
+            return *this;
+        }
+
+        /** Post-increment */
+        iterator operator ++ (int) {
+            iterator orig(*this);
+            ++*this;
+            return orig;
+        }
+
+        /** Equality */
+        bool operator == (const iterator & rarg) const {
+            return m_row.data() == rarg.m_row.data();
+        }
+
+        /** Inequality */
+        bool operator != (const iterator & rarg) const {
+            return !(*this == rarg);
+        }
+
+    };  // end of class iterator
+
+    typedef iterator const_iterator;  /**< Const iterator */
+
+    private:
+
+    T *    m_data;    /**< Data         */
+    size_t m_rows;    /**< Row count    */
+    size_t m_cols;    /**< Column count */
+    size_t m_stride;  /**< Row stride   */
+
+    public:
+
+    /** Constructor (empty view) */
+    matrix_view(): m_data(NULL), m_rows(0), m_cols(0), m_stride(0) {}
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  data    Data
+     *  \param  rows    Row count
+     *  \param  cols    Column count
+     *  \param  stride  Row stride (items; 0 means \c cols)
+     */
+    matrix_view(T * data, size_t rows, size_t cols, size_t stride = 0):
+        m_data(data),
+        m_rows(rows),
+        m_cols(cols),
+        m_stride(stride ? stride : cols)
+    {
+        if (m_stride < m_cols)
+            throw std::range_error(
+                "libnn::misc::matrix_view: "
+                "row stride is smaller than column count");
+    }
+
+    /** Row count */
+    size_t rows() const { return m_rows; }
+
+    /** Column count */
+    size_t cols() const { return m_cols; }
+
+    /** Row stride */
+    size_t stride() const { return m_stride; }
+
+    /** Row count (container size) */
+    size_t size() const { return m_rows; }
+
+    /** Data */
+    T * data() const { return m_data; }
+
+    /** Row */
+    row_t operator [] (size_t i) const {
+        return row_t(m_data + i * m_stride, m_cols);
+    }
+
+    /**
+     *  \brief  Sub-matrix of rows
+     *
+     *  \param  begin  First row
+     *  \param  end    Last row plus one
+     *
+     *  \return View of rows [begin, end)
+     */
+    matrix_view slice(size_t begin, size_t end) const {
+        return matrix_view(m_data + begin * m_stride, end - begin,
+            m_cols, m_stride);
+    }
+
+    /** Begin iterator */
+    iterator begin() const { return iterator(m_data, m_cols, m_stride); }
+
+    /** End iterator */
+    iterator end() const {
+        return iterator(m_data + m_rows * m_stride, m_cols, m_stride);
+    }
+
+};  // end of template class matrix_view
+
+
+/**
+ *  \brief  Training set view
+ *
+ *  Pairs rows of inputs and desired outputs matrices; it's a container
+ *  of [input, output] pairs, so it may be passed as training set
+ *  without copying the data.
+ *
+ *  \tparam  T  Item type (\c const for read-only views)
+ */
+template <typename T>
+class training_view {
+    public:
+
+    typedef matrix_view<T>                 matrix_t;    /**< Matrix     */
+    typedef typename matrix_t::row_t       row_t;       /**< Row        */
+    typedef std::pair<row_t, row_t>        value_type;  /**< Sample     */
+
+    /** Sample iterator */
+    class iterator {
+        friend class training_view;
+
+        public:
+
+        typedef std::forward_iterator_tag iterator_category;
+        typedef training_view::value_type value_type;
+        typedef std::ptrdiff_t            difference_type;
+        typedef const value_type *        pointer;
+        typedef const value_type &        reference;
+
+        private:
+
+        typename matrix_t::iterator m_in;      /**< Input iterator  */
+        typename matrix_t::iterator m_out;     /**< Output iterator */
+        value_type                  m_sample;  /**< Current sample  */
+
+        /** Constructor */
+        iterator(
+            const typename matrix_t::iterator & in,
+            const typename matrix_t::iterator & out)
+        :
+            m_in(in),
+            m_out(out),
+            m_sample(*in, *out)
+        {}
+
+        public:
+
+        /** Sample */
+        const value_type & operator * () const { return m_sample; }
+
+        /** Sample access */
+        const value_type * operator -> () const { return &m_sample; }
+
+        /** Pre-increment */
+        iterator & operator ++ () {
+            m_sample = value_type(*++m_in, *++m_out);
+            return *this;
+        }
+
+        /** Post-increment */
+        iterator operator ++ (int) {
+            iterator orig(*this);
+            ++*this;
+            return orig;
+        }
+
+        /** Equality */
+        bool operator == (const iterator & rarg) const {
+            return m_in == rarg.m_in;
+        }
+
+        /** Inequality */
+        bool operator != (const iterator & rarg) const {
+            return !(*this == rarg);
+        }
+
+    };  // end of class iterator
+
+    typedef iterator const_iterator;  /**< Const iterator */
+
+    private:
+
+    matrix_t m_inputs;   /**< Inputs           */
+    matrix_t m_outputs;  /**< Desired outputs  */
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  inputs   Inputs
+     *  \param  outputs  Desired outputs
+     */
+    training_view(const matrix_t & inputs, const matrix_t & outputs):
+        m_inputs(inputs),
+        m_outputs(outputs)
+    {
+        if (inputs.rows() != outputs.rows())
+            throw std::range_error(
+                "libnn::misc::training_view: "
+                "inputs and outputs row counts differ");
+    }
+
+    /** Inputs */
+    const matrix_t & inputs() const { return m_inputs; }
+
+    /** Desired outputs */
+    const matrix_t & outputs() const { return m_outputs; }
+
+    /** Sample count */
+    size_t size() const { return m_inputs.rows(); }
+
+    /** Sample */
+    value_type operator [] (size_t i) const {
+        return value_type(m_inputs[i], m_outputs[i]);
+    }
+
+    /** Begin iterator */
+    iterator begin() const {
+        return iterator(m_inputs.begin(), m_outputs.begin());
+    }
+
+    /** End iterator */
+    iterator end() const {
+        return iterator(m_inputs.end(), m_outputs.end());
+    }
+
+};  // end of template class training_view
+
+}}  // end of namespace libnn::misc
+
+
+#endif  // end of #ifndef libnn__misc__array_view_hxx
@@ -0,0 +1,264 @@
+#ifndef libnn__misc__executor_hxx
+#define libnn__misc__executor_hxx
+
+/**
+ *  Parallel task executor interface
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstddef>
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <atomic>
+
+
+namespace libnn {
+namespace misc {
+
+/**
+ *  \brief  Executor (interface)
+ *
+ *  Parallel features of the library (dense evaluation and training,
+ *  threaded matrix products...) run their loops via an executor.
+ *  Implementations are the \ref serial_executor (the default),
+ *  the library \ref thread_pool and \ref function_executor, which
+ *  adapts an application's existing task executor.
+ */
+class executor {
+    public:
+
+    /**
+     *  \brief  Range function
+     *
+     *  Called with [begin, end) sub-range of the \ref parallel_for range.
+     */
+    typedef std::function<void(size_t, size_t)> range_fn_t;
+
+    /** Count of threads executing the tasks */
+    virtual size_t concurrency() const = 0;
+
+    /**
+     *  \brief  Parallel for
+     *
+     *  Calls \c fn for disjoint sub-ranges covering [begin, end)
+     *  (possibly concurrently) and waits until all the calls finish.
+     *  An exception thrown by \c fn is re-thrown (the 1st one caught;
+     *  other sub-ranges may still be processed).
+     *
+     *  \param  begin  Range begin
+     *  \param  end    Range end
+     *  \param  fn     Range function
+     *  \param  grain  Minimal sub-range size (0 means automatic)
+     */
+    virtual void parallel_for(
+        size_t             begin,
+        size_t             end,
+        const range_fn_t & fn,
+        size_t             grain = 0) = 0;
+
+    /** Destructor */
+    virtual ~executor() {}
+
+};  // end of class executor
+
+
+namespace impl {
+
+/** Sub-ranges per thread (for automatic grain size) */
+static const size_t chunks_per_thread = 8;
+
+/**
+ *  \brief  Grain size
+ *
+ *  Unless specified, the grain is set so that each thread gets
+ *  \ref chunks_per_thread sub-ranges (so that the load may be balanced
+ *  while the scheduling overhead stays small).
+ *
+ *  \param  size         Range size
+ *  \param  concurrency  Thread count
+ *  \param  grain        Requested grain (0 means automatic)
+ *
+ *  \return Grain size
+ */
+inline size_t grain_size(size_t size, size_t concurrency, size_t grain) {
+    if (grain) return grain;
+
+    return std::max<size_t>(1, size / (chunks_per_thread * concurrency));
+}
+
+}  // end of namespace impl
+
+
+/**
+ *  \brief  Serial executor
+ *
+ *  Runs the whole range by the calling thread.
+ */
+class serial_executor: public executor {
+    public:
+
+    /** Single thread */
+    size_t concurrency() const { return 1; }
+
+    /** Serial for */
+    void parallel_for(
+        size_t             begin,
+        size_t             end,
+        const range_fn_t & fn,
+        size_t             grain = 0)
+    {
+        if (begin < end) fn(begin, end);
+    }
+
+};  // end of class serial_executor
+
+
+/**
+ *  \brief  Executor hook
+ *
+ *  Adapts an application's task executor (thread pool, event loop...);
+ *  the range is split to chunks of the grain size, which are processed
+ *  by the calling thread and by (at most \c concurrency) tasks passed
+ *  to the \c spawn function.
+ *  The chunks are taken dynamically, so that the calling thread never
+ *  waits for a task that hasn't started yet (which makes nested loops
+ *  safe even if all the executor threads are busy).
+ */
+class function_executor: public executor {
+    public:
+
+    typedef std::function<void()>               task_t;   /**< Task         */
+    typedef std::function<void(const task_t &)> spawn_t;  /**< Task spawner */
+
+    private:
+
+    /** Loop state (shared with the spawned tasks) */
+    struct loop {
+        const range_fn_t *      fn;      /**< Range function   */
+        size_t                  begin;   /**< Range begin      */
+        size_t                  end;     /**< Range end        */
+        size_t                  grain;   /**< Chunk size       */
+        size_t                  chunks;  /**< Chunk count      */
+        std::atomic<size_t>     next;    /**< Next chunk       */
+        std::mutex              mx;      /**< Completion mutex */
+        std::condition_variable cv;      /**< Completion signal */
+        size_t                  done;    /**< Processed chunks */
+        std::exception_ptr      error;   /**< Error (1st one)  */
+
+        /** Process chunks (until there are none left) */
+        void run() {
+            for (;;) {
+                const size_t c = next++;
+                if (!(c < chunks)) break;
+
+                const size_t b = begin + c * grain;
+
+                std::exception_ptr x;
+                try { (*fn)(b, std::min(b + grain, end)); }
+                catch (...) { x = std::current_exception(); }
+
+                std::lock_guard<std::mutex> lock(mx);
+                if (x && !error) error = x;
+                if (chunks == ++done) cv.notify_all();
+            }
+        }
+
+    };  // end of struct loop
+
+    spawn_t m_spawn;        /**< Task spawner          */
+    size_t  m_concurrency;  /**< Executor thread count */
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  spawn        Task spawner (runs the task asynchronously)
+     *  \param  concurrency  Executor thread count
+     */
+    function_executor(const spawn_t & spawn, size_t concurrency):
+        m_spawn(spawn),
+        m_concurrency(std::max<size_t>(1, concurrency))
+    {}
+
+    /** Executor thread count */
+    size_t concurrency() const { return m_concurrency; }
+
+    /** Parallel for via the spawner */
+    void parallel_for(
+        size_t             begin,
+        size_t             end,
+        const range_fn_t & fn,
+        size_t             grain = 0)
+    {
+        if (!(begin < end)) return;
+
+        const size_t size = end - begin;
+
+        std::shared_ptr<loop> l(new loop());
+        l->fn     = &fn;
+        l->begin  = begin;
+        l->end    = end;
+        l->grain  = impl::grain_size(size, m_concurrency + 1, grain);
+        l->chunks = (size + l->grain - 1) / l->grain;
+        l->next   = 0;
+        l->done   = 0;
+
+        // Tasks starting after all the chunks are taken don't call fn
+        // (so they may outlive the call)
+        const size_t tasks = std::min(m_concurrency, l->chunks - 1);
+        for (size_t i = 0; i < tasks; ++i)
+            m_spawn([l]() { l->run(); });
+
+        l->run();
+
+        std::unique_lock<std::mutex> lock(l->mx);
+        l->cv.wait(lock, [&l]() { return l->chunks == l->done; });
+
+        if (l->error) std::rethrow_exception(l->error);
+    }
+
+};  // end of class function_executor
+
+}}  // end of namespace libnn::misc
+
+
+#endif  // end of #ifndef libnn__misc__executor_hxx
@@ -0,0 +1,462 @@
+#ifndef libnn__misc__instrument_hxx
+#define libnn__misc__instrument_hxx
+
+/**
+ *  Instrumentation counters
+ *
+ *  Counts of neuron evaluations, dendrite multiply-adds, computation resets
+ *  and memory resource allocations and counts of forward, backward
+ *  and update phases of computations and training (per thread, aggregated
+ *  on demand).
+ *  The instrumentation is compiled in iff \c LIBNN_INSTRUMENT is defined
+ *  (done by \c configure \c --enable-instrumentation in config.hxx;
+ *  programs using the installed headers shall define it the same way
+ *  as the library); otherwise, it has no overhead at all.
+ *  Phases duration (in cycles) is measured iff \c LIBNN_INSTRUMENT_PHASES
+ *  is defined, too (\c --enable-instrumentation=phases); reading the time
+ *  stamp counter twice per phase is costly for small networks.
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+// Phase timing implies instrumentation
+#if defined(LIBNN_INSTRUMENT_PHASES) && !defined(LIBNN_INSTRUMENT)
+#define LIBNN_INSTRUMENT
+#endif
+
+#if defined(LIBNN_INSTRUMENT_PHASES) && \
+    (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#endif
+
+
+namespace libnn {
+namespace misc {
+namespace instrument {
+
+/** Counters */
+enum counter_t {
+    NEURON_EVALS = 0,  /**< Neuron function evaluations */
+    MULADDS,           /**< Dendrite multiply-adds      */
+    RESETS,            /**< Computation resets          */
+    ALLOCS,            /**< Memory resource allocations */
+};  // end of enum counter_t
+
+static const size_t counter_cnt = 4;  /**< Count of counters */
+
+/** Timed phases */
+enum phase_t {
+    FORWARD = 0,  /**< Forward phase (evaluation)        */
+    BACKWARD,     /**< Backward phase (error propagation) */
+    UPDATE,       /**< Weights update                    */
+};  // end of enum phase_t
+
+static const size_t phase_cnt = 3;  /**< Count of phases */
+
+/** Instrumentation is compiled in */
+#ifdef LIBNN_INSTRUMENT
+static const bool enabled = true;
+#else
+static const bool enabled = false;
+#endif
+
+/** Phases duration is measured */
+#ifdef LIBNN_INSTRUMENT_PHASES
+static const bool timed = true;
+#else
+static const bool timed = false;
+#endif
+
+
+/** Counter name */
+inline const char * name(counter_t counter) {
+    static const char * const names[counter_cnt] = {
+        "neuron_evals", "muladds", "resets", "allocs",
+    };
+
+    return names[counter];
+}
+
+/** Phase name */
+inline const char * name(phase_t phase) {
+    static const char * const names[phase_cnt] = {
+        "forward", "backward", "update",
+    };
+
+    return names[phase];
+}
+
+
+/**
+ *  \brief  Time stamp (in cycles)
+ *
+ *  Time stamp counter on x86, nanoseconds elsewhere.
+ */
+inline uint64_t cycles() {
+#if defined(LIBNN_INSTRUMENT_PHASES) && \
+    (defined(__x86_64__) || defined(__i386__))
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+
+/** Counters values */
+struct stats {
+    uint64_t count[counter_cnt];  /**< Counters                         */
+    uint64_t calls[phase_cnt];    /**< Phases executions                */
+    uint64_t cycles[phase_cnt];   /**< Phases duration (iff \ref timed) */
+
+    /** Constructor (zero stats) */
+    stats() {
+        std::fill(count,  count  + counter_cnt, 0);
+        std::fill(calls,  calls  + phase_cnt,   0);
+        std::fill(cycles, cycles + phase_cnt,   0);
+    }
+
+    /** Add stats */
+    stats & operator += (const stats & rarg) {
+        for (size_t i = 0; i < counter_cnt; ++i) count[i] += rarg.count[i];
+
+        for (size_t i = 0; i < phase_cnt; ++i) {
+            calls[i]  += rarg.calls[i];
+            cycles[i] += rarg.cycles[i];
+        }
+
+        return *this;
+    }
+
+    /** Subtract stats */
+    stats & operator -= (const stats & rarg) {
+        for (size_t i = 0; i < counter_cnt; ++i) count[i] -= rarg.count[i];
+
+        for (size_t i = 0; i < phase_cnt; ++i) {
+            calls[i]  -= rarg.calls[i];
+            cycles[i] -= rarg.cycles[i];
+        }
+
+        return *this;
+    }
+
+};  // end of struct stats
+
+
+/**
+ *  \brief  Thread counters
+ *
+ *  Written by the owner thread only (so that plain relaxed load & store
+ *  suffices; no locked instructions), read by anyone.
+ */
+class thread_counters {
+    private:
+
+    std::atomic<uint64_t> m_count[counter_cnt];  /**< Counters       */
+    std::atomic<uint64_t> m_calls[phase_cnt];    /**< Phase calls    */
+    std::atomic<uint64_t> m_cycles[phase_cnt];   /**< Phase duration */
+
+    /** Add to counter (owner thread only) */
+    static void add(std::atomic<uint64_t> & counter, uint64_t n) {
+        counter.store(
+            counter.load(std::memory_order_relaxed) + n,
+            std::memory_order_relaxed);
+    }
+
+    public:
+
+    /** Constructor */
+    thread_counters() {
+        for (size_t i = 0; i < counter_cnt; ++i) m_count[i] = 0;
+
+        for (size_t i = 0; i < phase_cnt; ++i) {
+            m_calls[i]  = 0;
+            m_cycles[i] = 0;
+        }
+    }
+
+    /** Add to counter (owner thread only) */
+    void count(counter_t counter, uint64_t n) { add(m_count[counter], n); }
+
+    /** Record phase execution (owner thread only) */
+    void phase(phase_t phase, uint64_t cycles) {
+        add(m_calls[phase],  1);
+        add(m_cycles[phase], cycles);
+    }
+
+    /** Current values */
+    stats get() const {
+        stats s;
+
+        for (size_t i = 0; i < counter_cnt; ++i)
+            s.count[i] = m_count[i].load(std::memory_order_relaxed);
+
+        for (size_t i = 0; i < phase_cnt; ++i) {
+            s.calls[i]  = m_calls[i].load(std::memory_order_relaxed);
+            s.cycles[i] = m_cycles[i].load(std::memory_order_relaxed);
+        }
+
+        return s;
+    }
+
+};  // end of class thread_counters
+
+
+namespace impl {
+
+/**
+ *  \brief  Thread counters registry
+ *
+ *  The lock is only taken on thread registration and exit
+ *  and on aggregation.
+ */
+class registry {
+    private:
+
+    std::mutex                      m_mutex;    /**< Registry lock     */
+    std::vector<thread_counters *>  m_threads;  /**< Live threads      */
+    stats                           m_retired;  /**< Exited threads    */
+    stats                           m_base;     /**< Reset values      */
+
+    /** Sum of all counters (unlocked) */
+    stats sum() const {
+        stats s(m_retired);
+
+        std::for_each(m_threads.begin(), m_threads.end(),
+        [&s](const thread_counters * counters) {
+            s += counters->get();
+        });
+
+        return s;
+    }
+
+    public:
+
+    /**
+     *  \brief  Registry instance
+     *
+     *  Never destroyed (threads may exit after static destruction).
+     */
+    static registry & instance() {
+        static registry * reg = new registry;
+        return *reg;
+    }
+
+    /** Register thread counters */
+    void add(thread_counters * counters) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_threads.push_back(counters);
+    }
+
+    /** Unregister thread counters (keeping their values) */
+    void remove(thread_counters * counters) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_retired += counters->get();
+        m_threads.erase(
+            std::find(m_threads.begin(), m_threads.end(), counters));
+    }
+
+    /** Aggregated stats (since the last reset) */
+    stats get() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        stats s(sum());
+        s -= m_base;
+
+        return s;
+    }
+
+    /** Reset (aggregated) stats */
+    void reset() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_base = sum();
+    }
+
+};  // end of class registry
+
+/** Registered thread counters (registration lasts for the thread life) */
+class thread_slot {
+    public:
+
+    thread_counters counters;  /**< The thread counters */
+
+    /** Constructor (registers counters) */
+    thread_slot() { registry::instance().add(&counters); }
+
+    /** Destructor (unregisters counters) */
+    ~thread_slot() { registry::instance().remove(&counters); }
+
+};  // end of class thread_slot
+
+}  // end of namespace impl
+
+
+/** Calling thread counters */
+inline thread_counters & local() {
+    static thread_local impl::thread_slot slot;
+    return slot.counters;
+}
+
+/**
+ *  \brief  Aggregated stats
+ *
+ *  Sum of counters of all threads (including the exited ones)
+ *  since the last \ref reset.
+ */
+inline stats get() { return impl::registry::instance().get(); }
+
+/** Reset aggregated stats */
+inline void reset() { impl::registry::instance().reset(); }
+
+/**
+ *  \brief  Add to calling thread counter
+ *
+ *  For counting off the hot paths (e.g. allocations);
+ *  no-op unless the instrumentation is compiled in.
+ *
+ *  \param  counter  Counter
+ *  \param  n        Count
+ */
+inline void count(counter_t counter, uint64_t n = 1) {
+    if (enabled) local().count(counter, n);
+}
+
+
+#ifdef LIBNN_INSTRUMENT
+
+/**
+ *  \brief  Local counters
+ *
+ *  Plain (single-threaded) counters updated on hot paths by
+ *  a computation; added to the thread counters at the end of each
+ *  phase (see \ref phase_timer).
+ */
+class tally {
+    private:
+
+    uint64_t m_count[counter_cnt];  /**< Counters */
+
+    public:
+
+    /** Constructor */
+    tally() { std::fill(m_count, m_count + counter_cnt, 0); }
+
+    /** Add to counter */
+    void add(counter_t counter, uint64_t n = 1) { m_count[counter] += n; }
+
+    /** Move counters to thread counters */
+    void flush(thread_counters & counters) {
+        for (size_t i = 0; i < counter_cnt; ++i) {
+            if (m_count[i]) counters.count((counter_t)i, m_count[i]);
+            m_count[i] = 0;
+        }
+    }
+
+};  // end of class tally
+
+/**
+ *  \brief  Phase timer
+ *
+ *  Counts the phase and measures its duration in cycles (scope
+ *  of the instance; iff \ref timed) and flushes local counters
+ *  to the thread counters when the phase ends.
+ */
+class phase_timer {
+    private:
+
+    const phase_t  m_phase;  /**< Phase                */
+    tally        & m_tally;  /**< Local counters       */
+    const uint64_t m_start;  /**< Phase start (cycles) */
+
+    public:
+
+    /**
+     *  \brief  Constructor (phase start)
+     *
+     *  \param  phase  Phase
+     *  \param  t      Local counters
+     */
+    phase_timer(phase_t phase, tally & t):
+        m_phase(phase),
+        m_tally(t),
+        m_start(timed ? cycles() : 0)
+    {}
+
+    /** Destructor (phase end) */
+    ~phase_timer() {
+        const uint64_t end = timed ? cycles() : 0;
+
+        thread_counters & counters = local();
+        counters.phase(m_phase, end - m_start);
+        m_tally.flush(counters);
+    }
+
+};  // end of class phase_timer
+
+#else  // no instrumentation, no overhead
+
+/** Local counters (no-op) */
+class tally {
+    public:
+
+    /** Add to counter (no-op) */
+    void add(counter_t, uint64_t = 1) {}
+
+};  // end of class tally
+
+/** Phase timer (no-op) */
+class phase_timer {
+    public:
+
+    /** Constructor (no-op) */
+    phase_timer(phase_t, tally &) {}
+
+};  // end of class phase_timer
+
+#endif  // end of #ifdef LIBNN_INSTRUMENT
+
+}}}  // end of namespace libnn::misc::instrument
+
+#endif  // end of #ifndef libnn__misc__instrument_hxx
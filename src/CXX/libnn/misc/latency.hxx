@@ -0,0 +1,143 @@
+#ifndef libnn__misc__latency_hxx
+#define libnn__misc__latency_hxx
+
+/**
+ *  Latency statistics
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+
+
+namespace libnn {
+namespace misc {
+
+/**
+ *  \brief  Latency statistics
+ *
+ *  Keeps the last \c window samples (latencies or other durations,
+ *  in seconds) for percentiles; count, sum and maximum are kept
+ *  for all the samples.
+ *  Not thread-safe.
+ */
+class latency_stats {
+    private:
+
+    std::vector<double> m_samples;  /**< Samples (ring)              */
+    size_t              m_window;   /**< Window size                 */
+    size_t              m_count;    /**< Total count of samples      */
+    double              m_sum;      /**< Sum of samples              */
+    double              m_max;      /**< Maximal sample              */
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  window  Count of samples kept for percentiles
+     */
+    latency_stats(size_t window = 1 << 16):
+        m_window(std::max<size_t>(1, window)),
+        m_count(0),
+        m_sum(0),
+        m_max(0)
+    {
+        m_samples.reserve(std::min<size_t>(m_window, 1024));
+    }
+
+    /**
+     *  \brief  Record sample
+     *
+     *  \param  sample  Sample (seconds)
+     */
+    void record(double sample) {
+        if (m_samples.size() < m_window)
+            m_samples.push_back(sample);
+        else
+            m_samples[m_count % m_window] = sample;
+
+        ++m_count;
+        m_sum += sample;
+        m_max  = std::max(m_max, sample);
+    }
+
+    /** Total count of samples */
+    size_t count() const { return m_count; }
+
+    /** Mean of samples (0 if there are none) */
+    double mean() const { return m_count ? m_sum / m_count : 0; }
+
+    /** Maximal sample */
+    double max() const { return m_max; }
+
+    /**
+     *  \brief  Percentile (of the kept samples)
+     *
+     *  \param  p  Percentile (in [0, 100])
+     *
+     *  \return Sample below which \c p percent of the samples are
+     *          (0 if there are none)
+     */
+    double percentile(double p) const {
+        if (m_samples.empty()) return 0;
+
+        std::vector<double> samples(m_samples);
+
+        const size_t k = std::min(samples.size() - 1,
+            (size_t)(p / 100 * samples.size()));
+
+        std::nth_element(samples.begin(), samples.begin() + k, samples.end());
+
+        return samples[k];
+    }
+
+    /** Forget all samples */
+    void reset() {
+        m_samples.clear();
+        m_count = 0;
+        m_sum   = 0;
+        m_max   = 0;
+    }
+
+};  // end of class latency_stats
+
+}}  // end of namespace libnn::misc
+
+
+#endif  // end of #ifndef libnn__misc__latency_hxx
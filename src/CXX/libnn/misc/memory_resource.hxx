@@ -0,0 +1,536 @@
+#ifndef libnn__misc__memory_resource_hxx
+#define libnn__misc__memory_resource_hxx
+
+/**
+ *  Memory resources and polymorphic allocator
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libnn/misc/instrument.hxx"
+
+#include <new>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif  // end of #ifdef __linux__
+
+
+namespace libnn {
+namespace misc {
+
+/**
+ *  \brief  Memory resource
+ *
+ *  Source of memory for the library containers (see
+ *  \ref polymorphic_allocator).
+ *  C++11 counterpart of \c std::pmr::memory_resource; implement
+ *  \c do_allocate and \c do_deallocate to place networks and computations
+ *  in huge pages, shared memory, arenas...
+ */
+class memory_resource {
+    public:
+
+    /** Default alignment */
+    static constexpr size_t max_align = alignof(std::max_align_t);
+
+    /**
+     *  \brief  Allocate memory
+     *
+     *  Counted as \c ALLOCS (see libnn/misc/instrument.hxx);
+     *  upstream allocations of composed resources count, too.
+     *
+     *  \param  bytes  Size
+     *  \param  align  Alignment
+     *
+     *  \return Allocated memory (throws \c std::bad_alloc on failure)
+     */
+    void * allocate(size_t bytes, size_t align = max_align) {
+        instrument::count(instrument::ALLOCS);
+
+        return do_allocate(bytes, align);
+    }
+
+    /**
+     *  \brief  Deallocate memory
+     *
+     *  \param  ptr    Memory (as returned by \ref allocate)
+     *  \param  bytes  Size (as passed to \ref allocate)
+     *  \param  align  Alignment (as passed to \ref allocate)
+     */
+    void deallocate(void * ptr, size_t bytes, size_t align = max_align) {
+        do_deallocate(ptr, bytes, align);
+    }
+
+    /**
+     *  \brief  Check whether memory allocated by another resource may be
+     *          deallocated by this one (and vice versa)
+     *
+     *  \param  other  Another resource
+     */
+    bool is_equal(const memory_resource & other) const {
+        return this == &other || do_is_equal(other);
+    }
+
+    /** Destructor */
+    virtual ~memory_resource() {}
+
+    protected:
+
+    /** Allocation implementation (see \ref allocate) */
+    virtual void * do_allocate(size_t bytes, size_t align) = 0;
+
+    /** Deallocation implementation (see \ref deallocate) */
+    virtual void do_deallocate(void * ptr, size_t bytes, size_t align) = 0;
+
+    /** Equality implementation (see \ref is_equal) */
+    virtual bool do_is_equal(const memory_resource & other) const {
+        return this == &other;
+    }
+
+};  // end of class memory_resource
+
+
+/** Implementation details */
+namespace impl {
+
+/**
+ *  \brief  Global \c new and \c delete resource
+ *
+ *  Alignments up to \c max_align are supported.
+ */
+class new_delete_resource: public memory_resource {
+    protected:
+
+    void * do_allocate(size_t bytes, size_t align) {
+        if (align > max_align) throw std::bad_alloc();
+
+        return ::operator new(bytes);
+    }
+
+    void do_deallocate(void * ptr, size_t bytes, size_t align) {
+        ::operator delete(ptr);
+    }
+
+};  // end of class new_delete_resource
+
+}  // end of namespace impl
+
+/**
+ *  \brief  Global \c new and \c delete resource
+ *
+ *  The default resource.
+ */
+inline memory_resource * new_delete_resource() {
+    static impl::new_delete_resource resource;
+    return &resource;
+}
+
+
+/**
+ *  \brief  Monotonic (arena) resource
+ *
+ *  Memory is carved from chunks of geometrically growing size
+ *  (allocated by the upstream resource); deallocation does nothing.
+ *  All memory is released at once (by \ref release or destruction).
+ *  Suitable for request-scoped computations.
+ *  Not thread-safe.
+ */
+class monotonic_resource: public memory_resource {
+    private:
+
+    /** Upstream chunk header */
+    struct chunk {
+        chunk * next;  /**< Next (previously allocated) chunk */
+        size_t  size;  /**< Chunk size (incl. header)         */
+    };  // end of struct chunk
+
+    memory_resource * const m_upstream;   /**< Upstream resource     */
+    void            * const m_buffer;     /**< Initial buffer        */
+    const size_t            m_buff_size;  /**< Initial buffer size   */
+    const size_t            m_init_size;  /**< Initial chunk size    */
+    size_t                  m_next_size;  /**< Next chunk size       */
+    chunk                 * m_chunks;     /**< Upstream chunks       */
+    char                  * m_ptr;        /**< Free memory           */
+    size_t                  m_avail;      /**< Free memory size      */
+    size_t                  m_used;       /**< Allocated memory size */
+
+    /**
+     *  \brief  Allocate next chunk
+     *
+     *  \param  bytes  Minimal size required
+     *  \param  align  Alignment required
+     */
+    void next_chunk(size_t bytes, size_t align) {
+        const size_t min_size = sizeof(chunk) + bytes + align;
+
+        while (m_next_size < min_size) m_next_size *= 2;
+
+        chunk * c = (chunk *)m_upstream->allocate(m_next_size);
+        c->next = m_chunks;
+        c->size = m_next_size;
+        m_chunks = c;
+
+        m_ptr   = (char *)(c + 1);
+        m_avail = m_next_size - sizeof(chunk);
+
+        m_next_size *= 2;
+    }
+
+    protected:
+
+    void * do_allocate(size_t bytes, size_t align) {
+        void * ptr = m_ptr;
+        if (NULL == m_ptr || !std::align(align, bytes, ptr, m_avail)) {
+            next_chunk(bytes, align);
+
+            ptr = m_ptr;
+            std::align(align, bytes, ptr, m_avail);
+        }
+
+        m_ptr    = (char *)ptr + bytes;
+        m_avail -= bytes;
+        m_used  += bytes;
+
+        return ptr;
+    }
+
+    void do_deallocate(void * ptr, size_t bytes, size_t align) {}
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  init_size  Initial chunk size
+     *  \param  upstream   Upstream resource
+     */
+    explicit monotonic_resource(
+        size_t            init_size = 4096,
+        memory_resource * upstream  = new_delete_resource())
+    :
+        m_upstream(upstream),
+        m_buffer(NULL),
+        m_buff_size(0),
+        m_init_size(init_size < 64 ? 64 : init_size),
+        m_next_size(m_init_size),
+        m_chunks(NULL),
+        m_ptr(NULL),
+        m_avail(0),
+        m_used(0)
+    {}
+
+    /**
+     *  \brief  Constructor (initial buffer)
+     *
+     *  The buffer is used first; upstream chunks are allocated once
+     *  it's exhausted.
+     *
+     *  \param  buffer    Initial buffer (not owned)
+     *  \param  size      Initial buffer size
+     *  \param  upstream  Upstream resource
+     */
+    monotonic_resource(
+        void            * buffer,
+        size_t            size,
+        memory_resource * upstream = new_delete_resource())
+    :
+        m_upstream(upstream),
+        m_buffer(buffer),
+        m_buff_size(size),
+        m_init_size(size < 64 ? 64 : size),
+        m_next_size(m_init_size),
+        m_chunks(NULL),
+        m_ptr((char *)buffer),
+        m_avail(size),
+        m_used(0)
+    {}
+
+    /** Upstream resource getter */
+    memory_resource * upstream() const { return m_upstream; }
+
+    /** Allocated memory size (bytes) */
+    size_t used() const { return m_used; }
+
+    /**
+     *  \brief  Release all memory
+     *
+     *  Upstream chunks are returned; the initial buffer (if any)
+     *  is reused.
+     */
+    void release() {
+        while (m_chunks) {
+            chunk * c = m_chunks;
+            m_chunks = c->next;
+            m_upstream->deallocate(c, c->size);
+        }
+
+        m_next_size = m_init_size;
+        m_ptr       = (char *)m_buffer;
+        m_avail     = m_buff_size;
+        m_used      = 0;
+    }
+
+    /** Destructor */
+    ~monotonic_resource() { release(); }
+
+    private:
+
+    /** Copying is forbidden */
+    monotonic_resource(const monotonic_resource & orig) = delete;
+
+    /** Assignment is forbidden */
+    void operator = (const monotonic_resource & rarg) = delete;
+
+};  // end of class monotonic_resource
+
+
+/**
+ *  \brief  Huge pages resource
+ *
+ *  Allocates memory mapped in huge pages (2 MiB); explicit huge pages
+ *  are used if reserved (see \c /proc/sys/vm/nr_hugepages),
+ *  transparent huge pages are advised otherwise.
+ *  Each allocation is mapped separately (and rounded up to the huge
+ *  page size); use it as the upstream of \ref monotonic_resource
+ *  (with large initial size) for large models.
+ *  On systems other than Linux, the upstream resource is used.
+ */
+class huge_page_resource: public memory_resource {
+    private:
+
+    memory_resource * const m_upstream;  /**< Upstream resource (fallback) */
+
+    /** Huge page size */
+    static constexpr size_t page_size = 2 * 1024 * 1024;
+
+    /** Mapping size */
+    static size_t map_size(size_t bytes) {
+        return (bytes + page_size - 1) / page_size * page_size;
+    }
+
+    protected:
+
+    void * do_allocate(size_t bytes, size_t align) {
+#ifdef __linux__
+        if (align > page_size) throw std::bad_alloc();
+
+        const size_t size = map_size(bytes ? bytes : 1);
+        void * ptr = MAP_FAILED;
+
+#ifdef MAP_HUGETLB
+        ptr = ::mmap(NULL, size, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#endif  // end of #ifdef MAP_HUGETLB
+
+        if (MAP_FAILED == ptr) {
+            ptr = ::mmap(NULL, size, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+            if (MAP_FAILED == ptr) throw std::bad_alloc();
+
+#ifdef MADV_HUGEPAGE
+            ::madvise(ptr, size, MADV_HUGEPAGE);
+#endif  // end of #ifdef MADV_HUGEPAGE
+        }
+
+        return ptr;
+#else
+        return m_upstream->allocate(bytes, align);
+#endif  // end of #ifdef __linux__
+    }
+
+    void do_deallocate(void * ptr, size_t bytes, size_t align) {
+#ifdef __linux__
+        ::munmap(ptr, map_size(bytes ? bytes : 1));
+#else
+        m_upstream->deallocate(ptr, bytes, align);
+#endif  // end of #ifdef __linux__
+    }
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  upstream  Upstream resource (used if huge pages aren't
+     *                    supported)
+     */
+    explicit huge_page_resource(
+        memory_resource * upstream = new_delete_resource())
+    :
+        m_upstream(upstream)
+    {}
+
+};  // end of class huge_page_resource
+
+
+/**
+ *  \brief  Polymorphic allocator
+ *
+ *  Allocator using a \ref memory_resource (C++11 counterpart
+ *  of \c std::pmr::polymorphic_allocator).
+ *  The resource doesn't propagate on container assignment nor swap
+ *  (so that container items stay where they were allocated);
+ *  container copies use the default resource.
+ *  Allocator-aware items (e.g. nested containers) are constructed
+ *  with the same resource.
+ *
+ *  \tparam  T  Value type
+ */
+template <typename T>
+class polymorphic_allocator {
+    public:
+
+    typedef T value_type;  /**< Value type */
+
+    private:
+
+    memory_resource * m_resource;  /**< Memory resource */
+
+    /** Construct allocator-aware item */
+    template <typename U, typename... Args>
+    void construct_impl(std::true_type, U * ptr, Args &&... args) {
+        ::new((void *)ptr) U(std::forward<Args>(args)..., *this);
+    }
+
+    /** Construct item */
+    template <typename U, typename... Args>
+    void construct_impl(std::false_type, U * ptr, Args &&... args) {
+        ::new((void *)ptr) U(std::forward<Args>(args)...);
+    }
+
+    public:
+
+    /** Constructor (default resource) */
+    polymorphic_allocator(): m_resource(new_delete_resource()) {}
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  resource  Memory resource
+     */
+    polymorphic_allocator(memory_resource * resource):
+        m_resource(resource)
+    {}
+
+    /** Conversion from another value type allocator */
+    template <typename U>
+    polymorphic_allocator(const polymorphic_allocator<U> & orig):
+        m_resource(orig.resource())
+    {}
+
+    /** Memory resource getter */
+    memory_resource * resource() const { return m_resource; }
+
+    /**
+     *  \brief  Allocate memory
+     *
+     *  \param  n  Item count
+     *
+     *  \return Memory for \c n items
+     */
+    T * allocate(size_t n) {
+        if (n > std::numeric_limits<size_t>::max() / sizeof(T))
+            throw std::bad_alloc();
+
+        return (T *)m_resource->allocate(n * sizeof(T), alignof(T));
+    }
+
+    /**
+     *  \brief  Deallocate memory
+     *
+     *  \param  ptr  Memory
+     *  \param  n    Item count
+     */
+    void deallocate(T * ptr, size_t n) {
+        m_resource->deallocate(ptr, n * sizeof(T), alignof(T));
+    }
+
+    /**
+     *  \brief  Construct item
+     *
+     *  Allocator-aware items get the allocator as the last constructor
+     *  argument.
+     *
+     *  \param  ptr   Item memory
+     *  \param  args  Constructor arguments
+     */
+    template <typename U, typename... Args>
+    void construct(U * ptr, Args &&... args) {
+        typedef std::integral_constant<bool,
+            std::uses_allocator<U, polymorphic_allocator>::value &&
+            std::is_constructible<U, Args..., polymorphic_allocator>::value>
+            uses_allocator_t;
+
+        construct_impl(uses_allocator_t(), ptr, std::forward<Args>(args)...);
+    }
+
+    /** Container copy allocator (default resource) */
+    polymorphic_allocator select_on_container_copy_construction() const {
+        return polymorphic_allocator();
+    }
+
+};  // end of template class polymorphic_allocator
+
+/** Allocators equality */
+template <typename T, typename U>
+bool operator == (
+    const polymorphic_allocator<T> & larg,
+    const polymorphic_allocator<U> & rarg)
+{
+    return larg.resource()->is_equal(*rarg.resource());
+}
+
+/** Allocators inequality */
+template <typename T, typename U>
+bool operator != (
+    const polymorphic_allocator<T> & larg,
+    const polymorphic_allocator<U> & rarg)
+{
+    return !(larg == rarg);
+}
+
+}}  // end of namespace libnn::misc
+
+
+#endif  // end of #ifndef libnn__misc__memory_resource_hxx
@@ -0,0 +1,149 @@
+#ifndef libnn__misc__memory_usage_hxx
+#define libnn__misc__memory_usage_hxx
+
+/**
+ *  Memory usage accounting
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <list>
+#include <deque>
+#include <vector>
+#include <cstddef>
+
+
+namespace libnn {
+namespace misc {
+
+/**
+ *  \brief  Memory usage (bytes)
+ *
+ *  Heap memory used by a model or a computation, broken down by purpose.
+ *  Objects' own (\c sizeof) storage is not included; the figures cover
+ *  memory allocated dynamically by the object (and its members).
+ */
+struct memory_usage {
+    size_t neurons;    /**< Neurons and I/O layers definitions    */
+    size_t dendrites;  /**< Dendrites and shared weights          */
+    size_t fmap;       /**< Forward synapses map                  */
+    size_t results;    /**< Result slots (activations, deltas...) */
+    size_t optimiser;  /**< Optimiser state (gradient, fixes...)  */
+
+    /** Constructor (no memory used) */
+    memory_usage():
+        neurons(0), dendrites(0), fmap(0), results(0), optimiser(0)
+    {}
+
+    /** Total */
+    size_t total() const {
+        return neurons + dendrites + fmap + results + optimiser;
+    }
+
+    /** Add another usage */
+    memory_usage & operator += (const memory_usage & rarg) {
+        neurons   += rarg.neurons;
+        dendrites += rarg.dendrites;
+        fmap      += rarg.fmap;
+        results   += rarg.results;
+        optimiser += rarg.optimiser;
+
+        return *this;
+    }
+
+    /** Sum of usages */
+    memory_usage operator + (const memory_usage & rarg) const {
+        memory_usage sum(*this);
+        return sum += rarg;
+    }
+
+};  // end of struct memory_usage
+
+
+/**
+ *  \brief  Vector storage size (bytes)
+ *
+ *  \param  v  Vector
+ *
+ *  \return Size of allocated storage (capacity) of \c v
+ */
+template <typename T, class Alloc>
+size_t heap_size(const std::vector<T, Alloc> & v) {
+    return v.capacity() * sizeof(T);
+}
+
+/**
+ *  \brief  List storage size (bytes)
+ *
+ *  Each item is stored in a node with links to the previous and next
+ *  nodes.
+ *
+ *  \param  l  List
+ *
+ *  \return Size of allocated storage of \c l
+ */
+template <typename T, class Alloc>
+size_t heap_size(const std::list<T, Alloc> & l) {
+    struct node { void * prev; void * next; T item; };
+
+    return l.size() * sizeof(node);
+}
+
+/**
+ *  \brief  Deque storage size estimate (bytes)
+ *
+ *  Deque stores its items in 512 B chunks (or 1 item chunks if the item
+ *  is larger) indexed by a map of chunk pointers (8 at least).
+ *  The estimate follows GNU libstdc++ layout; the map may actually be
+ *  larger (it's reallocated with a reserve as the deque grows).
+ *
+ *  \param  d  Deque
+ *
+ *  \return Estimated size of allocated storage of \c d
+ */
+template <typename T, class Alloc>
+size_t heap_size(const std::deque<T, Alloc> & d) {
+    const size_t chunk_size = sizeof(T) < 512 ? 512 / sizeof(T) : 1;
+    const size_t chunk_cnt  = d.size() / chunk_size + 1;
+    const size_t map_size   = chunk_cnt + 2 < 8 ? 8 : chunk_cnt + 2;
+
+    return chunk_cnt * chunk_size * sizeof(T) + map_size * sizeof(T *);
+}
+
+}}  // end of namespace libnn::misc
+
+
+#endif  // end of #ifndef libnn__misc__memory_usage_hxx
@@ -0,0 +1,202 @@
+#ifndef libnn__misc__numa_hxx
+#define libnn__misc__numa_hxx
+
+/**
+ *  NUMA topology and memory placement
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libnn/misc/thread_pool.hxx"
+
+#ifdef LIBNN_WITH_NUMA
+#include <numa.h>
+#include <numaif.h>
+#endif  // end of #ifdef LIBNN_WITH_NUMA
+
+#ifdef __linux__
+#include <sched.h>
+#include <unistd.h>
+#endif  // end of #ifdef __linux__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+
+
+namespace libnn {
+namespace misc {
+
+/**
+ *  \brief  NUMA topology and memory placement
+ *
+ *  Thin wrapper of libnuma (used iff \c LIBNN_WITH_NUMA is defined,
+ *  see \c configure \c --with-numa).
+ *  Without it (or on non-NUMA systems), the machine is reported
+ *  as a single node 0 with all the CPUs available to the process,
+ *  and memory binding does nothing.
+ */
+namespace numa {
+
+/** Check whether NUMA support is available */
+inline bool available() {
+#ifdef LIBNN_WITH_NUMA
+    static const bool avail = 0 <= numa_available();
+    return avail;
+#else
+    return false;
+#endif  // end of #ifdef LIBNN_WITH_NUMA
+}
+
+
+/**
+ *  \brief  CPUs of a node
+ *
+ *  Only CPUs available to the process are listed.
+ *
+ *  \param  node  Node
+ *
+ *  \return CPU list (empty for non-existent node)
+ */
+inline std::vector<int> cpus(int node) {
+    const std::vector<int> all = thread_pool::available_cpus();
+
+    if (!available()) return 0 == node ? all : std::vector<int>();
+
+    std::vector<int> node_cpus;
+
+#ifdef LIBNN_WITH_NUMA
+    struct bitmask * mask = numa_allocate_cpumask();
+
+    if (0 == numa_node_to_cpus(node, mask))
+        std::copy_if(all.begin(), all.end(), std::back_inserter(node_cpus),
+        [mask](int cpu) {
+            return 0 != numa_bitmask_isbitset(mask, (unsigned)cpu);
+        });
+
+    numa_free_cpumask(mask);
+#endif  // end of #ifdef LIBNN_WITH_NUMA
+
+    return node_cpus;
+}
+
+
+/**
+ *  \brief  Nodes
+ *
+ *  \return Nodes with CPUs available to the process
+ */
+inline std::vector<int> nodes() {
+    std::vector<int> list;
+
+#ifdef LIBNN_WITH_NUMA
+    if (available()) {
+        for (int node = 0; node <= numa_max_node(); ++node)
+            if (!cpus(node).empty()) list.push_back(node);
+
+        return list;
+    }
+#endif  // end of #ifdef LIBNN_WITH_NUMA
+
+    list.push_back(0);
+    return list;
+}
+
+
+/**
+ *  \brief  Node of the calling thread
+ *
+ *  \return Node of the CPU the thread currently runs on
+ */
+inline int current_node() {
+#if defined(LIBNN_WITH_NUMA) && defined(__linux__)
+    if (available()) {
+        const int cpu = sched_getcpu();
+        if (0 <= cpu) {
+            const int node = numa_node_of_cpu(cpu);
+            if (0 <= node) return node;
+        }
+    }
+#endif  // end of #if defined(LIBNN_WITH_NUMA) && defined(__linux__)
+
+    return 0;
+}
+
+
+/**
+ *  \brief  Bind memory to node
+ *
+ *  Pages wholly within the memory range are bound to the node
+ *  (and moved there if already allocated elsewhere).
+ *  The memory should be first touched by a thread running on the node,
+ *  so that it's allocated locally in the first place.
+ *
+ *  \param  addr  Memory address
+ *  \param  size  Memory size
+ *  \param  node  Node
+ *
+ *  \return \c true iff the memory was bound
+ */
+inline bool bind(const void * addr, size_t size, int node) {
+#if defined(LIBNN_WITH_NUMA) && defined(__linux__)
+    if (!available() || node < 0) return false;
+
+    const uintptr_t page  = (uintptr_t)::sysconf(_SC_PAGESIZE);
+    const uintptr_t begin = ((uintptr_t)addr + page - 1) / page * page;
+    const uintptr_t end   = ((uintptr_t)addr + size) / page * page;
+
+    if (!(begin < end)) return false;
+
+    const size_t bits = 8 * sizeof(unsigned long);
+
+    std::vector<unsigned long> mask(node / bits + 1, 0);
+    mask[node / bits] = 1UL << (node % bits);
+
+    return 0 == mbind((void *)begin, end - begin, MPOL_BIND,
+        mask.data(), mask.size() * bits + 1, MPOL_MF_MOVE);
+#else
+    return false;
+#endif  // end of #if defined(LIBNN_WITH_NUMA) && defined(__linux__)
+}
+
+}  // end of namespace numa
+
+}}  // end of namespace libnn::misc
+
+
+#endif  // end of #ifndef libnn__misc__numa_hxx
@@ -0,0 +1,487 @@
+#ifndef libnn__misc__shm_allreduce_hxx
+#define libnn__misc__shm_allreduce_hxx
+
+/**
+ *  Shared memory all-reduce (processes of a host)
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libnn/misc/allreduce.hxx"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <string>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <type_traits>
+#include <stdexcept>
+#include <new>
+
+extern "C" {
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+}
+
+
+namespace libnn {
+namespace misc {
+
+/**
+ *  \brief  Shared memory all-reduce
+ *
+ *  Processes of the same host (ranks) exchange their vectors via
+ *  a POSIX shared memory segment.
+ *  The segment contains a slot (of \c capacity elements) per rank and
+ *  a process-shared barrier; longer vectors are reduced piece-wise.
+ *
+ *  Two algorithms are available:
+ *  - \c RING: reduce-scatter and all-gather over the ring of ranks;
+ *    each rank reads 2 (N-1)/N of the vector size from its predecessor
+ *    slot, but 2 N-1 barriers are passed (suitable for large vectors,
+ *    e.g. gradients)
+ *  - \c TREE: binary tree reduction to rank 0 and broadcast; log2 N + 2
+ *    barriers, but the root reads all the vectors (suitable for small
+ *    vectors or a few ranks)
+ *
+ *  All ranks get bit-identical sums (so that replicas of a trained
+ *  network stay identical).
+ *
+ *  Rank 0 creates the segment (replacing a stale one of the same name)
+ *  and removes its name as soon as all the ranks have attached;
+ *  the other ranks wait for the segment to appear.
+ *  The ranks may be forked after rank 0 creates its instance, or be
+ *  started independently.
+ *  Note that if a rank dies, the others block forever.
+ *
+ *  \tparam  T  Element type (trivially copyable)
+ */
+template <typename T>
+class shm_allreduce: public allreduce<T> {
+    public:
+
+    /** Algorithm */
+    enum algorithm_t {
+        RING = 0,  /**< Ring (reduce-scatter + all-gather) */
+        TREE       /**< Binary tree (reduce + broadcast)   */
+    };  // end of enum algorithm_t
+
+    private:
+
+    static_assert(std::is_trivially_copyable<T>::value,
+        "libnn::misc::shm_allreduce: element type isn't trivially copyable");
+
+    /** Cache line size (assumed) */
+    static const size_t cache_line = 64;
+
+    /** Segment initialised mark */
+    static const uint64_t magic = 0x6c69626e6e736d72;
+
+    /** Segment header */
+    struct header {
+        std::atomic<uint64_t> init;       /**< Initialised mark       */
+        uint64_t              ranks;      /**< Rank count             */
+        uint64_t              capacity;   /**< Slot capacity          */
+        char                  pad1[cache_line];
+        std::atomic<uint64_t> arrived;    /**< Ranks at the barrier   */
+        char                  pad2[cache_line];
+        std::atomic<uint64_t> phase;      /**< Barrier phase          */
+        char                  pad3[cache_line];
+    };  // end of struct header
+
+    std::string m_name;       /**< Segment name        */
+    size_t      m_ranks;      /**< Rank count          */
+    size_t      m_rank;       /**< Own rank            */
+    size_t      m_capacity;   /**< Slot capacity       */
+    algorithm_t m_algorithm;  /**< Algorithm           */
+    size_t      m_slot_size;  /**< Slot size (bytes)   */
+    size_t      m_size;       /**< Segment size        */
+    void *      m_addr;       /**< Segment address     */
+    bool        m_unlinked;   /**< Name removed        */
+
+    /** Header size (whole cache lines) */
+    static size_t header_size() {
+        return (sizeof(header) + cache_line - 1) / cache_line * cache_line;
+    }
+
+    /** Segment header */
+    header & hdr() const { return *static_cast<header *>(m_addr); }
+
+    /**
+     *  \brief  Rank slot
+     *
+     *  \param  r  Rank
+     */
+    T * slot(size_t r) const {
+        return reinterpret_cast<T *>(static_cast<char *>(m_addr)
+            + header_size() + r * m_slot_size);
+    }
+
+    /**
+     *  \brief  Throw system error
+     *
+     *  \param  what  Failed operation
+     */
+    static void fail(const std::string & what) {
+        throw std::runtime_error(
+            "libnn::misc::shm_allreduce: " + what + " failed: "
+            + ::strerror(errno));
+    }
+
+    /**
+     *  \brief  Idle wait
+     *
+     *  Yields the CPU at first, sleeps after a while.
+     *
+     *  \param  idle  Count of idle waits in a row
+     */
+    static void backoff(size_t & idle) {
+        if (++idle < 64)
+            std::this_thread::yield();
+        else
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+
+    /** Create segment (rank 0) */
+    void create() {
+        ::shm_unlink(m_name.c_str());  // stale segment (if any)
+
+        const int fd = ::shm_open(m_name.c_str(),
+            O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+        if (-1 == fd) fail("shm_open");
+
+        if (-1 == ::ftruncate(fd, m_size)) {
+            ::close(fd);
+            ::shm_unlink(m_name.c_str());
+            fail("ftruncate");
+        }
+
+        m_addr = ::mmap(NULL, m_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+            fd, 0);
+        ::close(fd);
+
+        if (MAP_FAILED == m_addr) {
+            m_addr = NULL;
+            ::shm_unlink(m_name.c_str());
+            fail("mmap");
+        }
+
+        header * h = new (m_addr) header();
+        h->ranks    = m_ranks;
+        h->capacity = m_capacity;
+        h->arrived  = 0;
+        h->phase    = 0;
+        h->init.store(magic, std::memory_order_release);
+    }
+
+    /** Attach segment (other ranks) */
+    void attach() {
+        int fd;
+        size_t idle = 0;
+
+        // Wait for the segment (and its header) to appear
+        for (;; backoff(idle)) {
+            fd = ::shm_open(m_name.c_str(), O_RDWR, 0);
+            if (-1 == fd) {
+                if (ENOENT == errno) continue;
+                fail("shm_open");
+            }
+
+            struct stat st;
+            if (-1 == ::fstat(fd, &st)) {
+                ::close(fd);
+                fail("fstat");
+            }
+
+            if ((size_t)st.st_size >= header_size()) break;
+
+            ::close(fd);
+        }
+
+        void * addr = ::mmap(NULL, header_size(), PROT_READ | PROT_WRITE,
+            MAP_SHARED, fd, 0);
+
+        if (MAP_FAILED == addr) {
+            ::close(fd);
+            fail("mmap");
+        }
+
+        const header & h = *static_cast<const header *>(addr);
+
+        for (idle = 0; magic != h.init.load(std::memory_order_acquire); )
+            backoff(idle);
+
+        const bool match = h.ranks == m_ranks && h.capacity == m_capacity;
+
+        ::munmap(addr, header_size());
+
+        if (!match) {
+            ::close(fd);
+
+            throw std::logic_error(
+                "libnn::misc::shm_allreduce: "
+                "rank count or capacity mismatch");
+        }
+
+        m_addr = ::mmap(NULL, m_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+            fd, 0);
+        ::close(fd);
+
+        if (MAP_FAILED == m_addr) {
+            m_addr = NULL;
+            fail("mmap");
+        }
+    }
+
+    /** Process-shared barrier (sense by phase counter) */
+    void barrier() {
+        header & h = hdr();
+
+        const uint64_t phase = h.phase.load(std::memory_order_acquire);
+
+        if (h.arrived.fetch_add(1, std::memory_order_acq_rel) + 1 == m_ranks) {
+            h.arrived.store(0, std::memory_order_relaxed);
+            h.phase.store(phase + 1, std::memory_order_release);
+            return;
+        }
+
+        size_t idle = 0;
+        while (phase == h.phase.load(std::memory_order_acquire))
+            backoff(idle);
+    }
+
+    /**
+     *  \brief  Chunk of a piece (ring algorithm)
+     *
+     *  \param  c     Chunk index
+     *  \param  size  Piece size
+     *
+     *  \return Chunk range [begin, end)
+     */
+    std::pair<size_t, size_t> chunk(size_t c, size_t size) const {
+        return std::pair<size_t, size_t>(
+            c * size / m_ranks, (c + 1) * size / m_ranks);
+    }
+
+    /**
+     *  \brief  Ring all-reduce of a piece
+     *
+     *  Reduce-scatter: in step \c s, rank \c r adds chunk \c r-1-s
+     *  of its predecessor to its own; after N-1 steps, it holds the sum
+     *  of chunk \c r+1.
+     *  All-gather: in step \c s, rank \c r copies chunk \c r-s (which
+     *  is complete in its predecessor's slot).
+     *
+     *  \param  data  Piece
+     *  \param  size  Piece size
+     */
+    void ring(T * data, size_t size) {
+        T * const       own  = slot(m_rank);
+        const T * const prev = slot((m_rank + m_ranks - 1) % m_ranks);
+
+        std::copy(data, data + size, own);
+        barrier();
+
+        for (size_t s = 0; s + 1 < m_ranks; ++s) {
+            const auto ch = chunk((m_rank + 2 * m_ranks - 1 - s) % m_ranks,
+                size);
+
+            for (size_t i = ch.first; i < ch.second; ++i) own[i] += prev[i];
+
+            barrier();
+        }
+
+        for (size_t s = 0; s + 1 < m_ranks; ++s) {
+            const auto ch = chunk((m_rank + m_ranks - s) % m_ranks, size);
+
+            std::copy(prev + ch.first, prev + ch.second, own + ch.first);
+
+            barrier();
+        }
+
+        std::copy(own, own + size, data);
+    }
+
+    /**
+     *  \brief  Tree all-reduce of a piece
+     *
+     *  In step \c d (power of 2), rank \c r divisible by \c 2d adds
+     *  the slot of rank \c r+d to its own; rank 0 then holds the sum.
+     *
+     *  \param  data  Piece
+     *  \param  size  Piece size
+     */
+    void tree(T * data, size_t size) {
+        T * const own = slot(m_rank);
+
+        std::copy(data, data + size, own);
+        barrier();
+
+        for (size_t d = 1; d < m_ranks; d <<= 1) {
+            if (0 == m_rank % (2 * d) && m_rank + d < m_ranks) {
+                const T * const other = slot(m_rank + d);
+
+                for (size_t i = 0; i < size; ++i) own[i] += other[i];
+            }
+
+            barrier();
+        }
+
+        const T * const root = slot(0);
+        std::copy(root, root + size, data);
+
+        barrier();  // rank 0 slot may only be rewritten after the broadcast
+    }
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  Creates (rank 0) or attaches the segment and waits for all
+     *  the ranks.
+     *
+     *  \param  name       Segment name (see \c shm_open, e.g. "/job")
+     *  \param  ranks      Rank count
+     *  \param  rank       Own rank
+     *  \param  capacity   Slot capacity (elements; must be the same
+     *                     for all ranks)
+     *  \param  algorithm  Algorithm
+     */
+    shm_allreduce(
+        const std::string & name,
+        size_t              ranks,
+        size_t              rank,
+        size_t              capacity  = 1 << 16,
+        algorithm_t         algorithm = RING)
+    :
+        m_name(name),
+        m_ranks(ranks),
+        m_rank(rank),
+        m_capacity(capacity),
+        m_algorithm(algorithm),
+        m_slot_size((capacity * sizeof(T) + cache_line - 1)
+            / cache_line * cache_line),
+        m_size(header_size() + ranks * m_slot_size),
+        m_addr(NULL),
+        m_unlinked(false)
+    {
+        if (0 == ranks || rank >= ranks || 0 == capacity)
+            throw std::range_error(
+                "libnn::misc::shm_allreduce: "
+                "invalid rank, rank count or capacity");
+
+        if (!std::atomic<uint64_t>().is_lock_free())
+            throw std::logic_error(
+                "libnn::misc::shm_allreduce: "
+                "lock-free atomics are not available");
+
+        if (0 == rank) create(); else attach();
+
+        barrier();
+
+        // All ranks are attached now
+        if (0 == rank) {
+            ::shm_unlink(m_name.c_str());
+            m_unlinked = true;
+        }
+    }
+
+    /** Segment name */
+    const std::string & name() const { return m_name; }
+
+    /** Algorithm */
+    algorithm_t algorithm() const { return m_algorithm; }
+
+    /** Slot capacity */
+    size_t capacity() const { return m_capacity; }
+
+    size_t ranks() const { return m_ranks; }
+
+    size_t rank() const { return m_rank; }
+
+    /**
+     *  \brief  Sum vectors of all ranks
+     *
+     *  \param  data  Vector (replaced by the sum)
+     *  \param  size  Vector size (must be the same for all ranks)
+     */
+    void operator () (T * data, size_t size) {
+        if (1 == m_ranks) return;
+
+        for (size_t off = 0; off < size; off += m_capacity) {
+            const size_t piece = std::min(m_capacity, size - off);
+
+            if (TREE == m_algorithm)
+                tree(data + off, piece);
+            else
+                ring(data + off, piece);
+        }
+    }
+
+    /** Wait for all ranks */
+    void sync() { barrier(); }
+
+    /** Copying is forbidden */
+    shm_allreduce(const shm_allreduce & orig) = delete;
+
+    /** Assignment is forbidden */
+    void operator = (const shm_allreduce & rarg) = delete;
+
+    /** Destructor */
+    ~shm_allreduce() {
+        if (m_addr) ::munmap(m_addr, m_size);
+
+        if (0 == m_rank && !m_unlinked) ::shm_unlink(m_name.c_str());
+    }
+
+};  // end of template class shm_allreduce
+
+/** \cond */
+template <typename T> const size_t   shm_allreduce<T>::cache_line;
+template <typename T> const uint64_t shm_allreduce<T>::magic;
+/** \endcond */
+
+}}  // end of namespace libnn::misc
+
+
+#endif  // end of #ifndef libnn__misc__shm_allreduce_hxx
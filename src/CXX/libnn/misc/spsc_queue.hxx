@@ -0,0 +1,162 @@
+#ifndef libnn__misc__spsc_queue_hxx
+#define libnn__misc__spsc_queue_hxx
+
+/**
+ *  Lock-free single-producer, single-consumer queue
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstddef>
+#include <vector>
+#include <atomic>
+#include <stdexcept>
+
+
+namespace libnn {
+namespace misc {
+
+/**
+ *  \brief  Lock-free single-producer, single-consumer queue
+ *
+ *  Bounded ring buffer; one thread may push, one (other) thread may pop
+ *  concurrently.
+ *  Operations never block; they fail if the queue is full (or empty).
+ *  The producer and consumer positions are kept on separate cache lines
+ *  (to avoid false sharing).
+ *
+ *  \tparam  T  Item type (should be cheap to copy, e.g. a pointer)
+ */
+template <typename T>
+class spsc_queue {
+    private:
+
+    /** Cache line size (assumed) */
+    static const size_t cache_line = 64;
+
+    std::vector<T>      m_ring;  /**< Ring buffer                     */
+    size_t              m_mask;  /**< Index mask (capacity - 1)       */
+    char                m_pad1[cache_line];
+    std::atomic<size_t> m_head;  /**< Consumer position (next to pop) */
+    char                m_pad2[cache_line];
+    std::atomic<size_t> m_tail;  /**< Producer position (next to push) */
+    char                m_pad3[cache_line];
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  capacity  Capacity (rounded up to a power of 2)
+     */
+    spsc_queue(size_t capacity):
+        m_head(0),
+        m_tail(0)
+    {
+        if (0 == capacity)
+            throw std::range_error(
+                "libnn::misc::spsc_queue: "
+                "zero capacity");
+
+        size_t size = 1;
+        while (size < capacity) size <<= 1;
+
+        m_ring.resize(size);
+        m_mask = size - 1;
+    }
+
+    /** Capacity */
+    size_t capacity() const { return m_ring.size(); }
+
+    /** Item count (approximate if used concurrently) */
+    size_t size() const {
+        return m_tail.load(std::memory_order_acquire)
+            -  m_head.load(std::memory_order_acquire);
+    }
+
+    /** Check emptiness (approximate if used concurrently) */
+    bool empty() const { return 0 == size(); }
+
+    /**
+     *  \brief  Push item (producer only)
+     *
+     *  \param  item  Item
+     *
+     *  \return \c true iff the item was pushed (i.e. queue wasn't full)
+     */
+    bool push(const T & item) {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+
+        if (tail - m_head.load(std::memory_order_acquire) == m_ring.size())
+            return false;
+
+        m_ring[tail & m_mask] = item;
+        m_tail.store(tail + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /**
+     *  \brief  Pop item (consumer only)
+     *
+     *  \param  item  Item
+     *
+     *  \return \c true iff an item was popped (i.e. queue wasn't empty)
+     */
+    bool pop(T & item) {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+
+        if (head == m_tail.load(std::memory_order_acquire))
+            return false;
+
+        item = m_ring[head & m_mask];
+        m_head.store(head + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /** Copying is forbidden */
+    spsc_queue(const spsc_queue & orig) = delete;
+
+    /** Assignment is forbidden */
+    void operator = (const spsc_queue & rarg) = delete;
+
+};  // end of template class spsc_queue
+
+}}  // end of namespace libnn::misc
+
+
+#endif  // end of #ifndef libnn__misc__spsc_queue_hxx
@@ -0,0 +1,464 @@
+#ifndef libnn__misc__thread_pool_hxx
+#define libnn__misc__thread_pool_hxx
+
+/**
+ *  Work-stealing thread pool
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libnn/misc/executor.hxx"
+
+#include <cstddef>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <future>
+#include <exception>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif  // end of #ifdef __linux__
+
+
+namespace libnn {
+namespace misc {
+
+/**
+ *  \brief  Work-stealing thread pool
+ *
+ *  Each worker has its own task deque; it pushes and pops tasks
+ *  at its back (LIFO, cache-friendly), idle workers steal tasks from
+ *  the front of the others' deques (i.e. the oldest, typically largest
+ *  tasks).
+ *  Tasks submitted by other threads are queued to a shared injection
+ *  queue.
+ *
+ *  \ref parallel_for splits the range lazily: the executing thread
+ *  keeps halving its range (pushing the upper half to its deque)
+ *  until the grain size is reached; stolen halves are split further
+ *  by the thieves.
+ *  A thread waiting for a \ref parallel_for completion executes other
+ *  tasks meanwhile, so nested parallel loops (and parallel loops called
+ *  from tasks) don't deadlock.
+ *
+ *  Workers may be pinned to CPUs (see \ref available_cpus).
+ *
+ *  The pool is meant to be created once and shared by all parallel
+ *  computations (see \c executor setters of the computations and
+ *  trainers).
+ */
+class thread_pool: public executor {
+    public:
+
+    typedef std::function<void()> task_t;  /**< Task */
+
+    private:
+
+    /** Worker */
+    struct worker {
+        std::mutex         mx;      /**< Deque mutex */
+        std::deque<task_t> tasks;   /**< Task deque  */
+        std::thread        thread;  /**< Thread      */
+    };  // end of struct worker
+
+    /** Current thread identity */
+    struct identity {
+        const thread_pool * pool;   /**< Pool of the worker (or NULL) */
+        size_t              index;  /**< Worker index                 */
+    };  // end of struct identity
+
+    /** Current thread identity */
+    static identity & current() {
+        static thread_local identity id = { NULL, 0 };
+        return id;
+    }
+
+    /** Parallel for job */
+    struct job {
+        const range_fn_t &  fn;         /**< Range function         */
+        size_t              grain;      /**< Grain size             */
+        std::atomic<size_t> remaining;  /**< Unprocessed item count */
+        std::mutex          mx;         /**< Error mutex            */
+        std::exception_ptr  error;      /**< Error (1st one)        */
+
+        /** Constructor */
+        job(const range_fn_t & fn_, size_t grain_, size_t size):
+            fn(fn_), grain(grain_), remaining(size)
+        {}
+    };  // end of struct job
+
+    std::vector<std::unique_ptr<worker> > m_workers;  /**< Workers         */
+    std::mutex                            m_mx;       /**< Pool mutex      */
+    std::condition_variable               m_cv;       /**< Task signal     */
+    std::deque<task_t>                    m_inject;   /**< Injection queue */
+    std::atomic<size_t>                   m_queued;   /**< Queued tasks    */
+    bool                                  m_stop;     /**< Stop flag       */
+
+    static const size_t npos = (size_t)-1;  /**< No worker index */
+
+    /** Index of the current thread worker (or \c npos) */
+    size_t self() const {
+        const identity & id = current();
+        if (this == id.pool) return id.index;
+
+        return npos;
+    }
+
+    /**
+     *  \brief  Queue task
+     *
+     *  Workers push to their own deques, others to the injection queue.
+     *
+     *  \param  task  Task
+     */
+    void push(const task_t & task) {
+        const size_t i = self();
+
+        ++m_queued;
+
+        if (npos != i) {
+            std::lock_guard<std::mutex> lock(m_workers[i]->mx);
+            m_workers[i]->tasks.push_back(task);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mx);
+            if (npos == i) m_inject.push_back(task);
+        }
+
+        m_cv.notify_one();
+    }
+
+    /**
+     *  \brief  Dequeue task
+     *
+     *  Own deque back first, then the injection queue, then steal
+     *  from the other deques fronts.
+     *
+     *  \param  i     Worker index (or \c npos)
+     *  \param  task  Task
+     *
+     *  \return \c true iff a task was dequeued
+     */
+    bool pop(size_t i, task_t & task) {
+        if (0 == m_queued) return false;
+
+        if (npos != i) {
+            worker & w = *m_workers[i];
+
+            std::lock_guard<std::mutex> lock(w.mx);
+            if (!w.tasks.empty()) {
+                task = std::move(w.tasks.back());
+                w.tasks.pop_back();
+                --m_queued;
+                return true;
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mx);
+            if (!m_inject.empty()) {
+                task = std::move(m_inject.front());
+                m_inject.pop_front();
+                --m_queued;
+                return true;
+            }
+        }
+
+        const size_t cnt   = m_workers.size();
+        const size_t start = npos == i ? 0 : i + 1;
+        for (size_t j = 0; j < cnt; ++j) {
+            const size_t k = (start + j) % cnt;
+            if (k == i) continue;
+
+            worker & v = *m_workers[k];
+
+            std::lock_guard<std::mutex> lock(v.mx);
+            if (!v.tasks.empty()) {
+                task = std::move(v.tasks.front());
+                v.tasks.pop_front();
+                --m_queued;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     *  \brief  Worker routine
+     *
+     *  \param  i  Worker index
+     */
+    void work(size_t i) {
+        current().pool  = this;
+        current().index = i;
+
+        task_t task;
+        for (;;) {
+            if (pop(i, task)) {
+                task();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(m_mx);
+            m_cv.wait(lock, [this]() { return m_stop || 0 < m_queued; });
+
+            if (m_stop && 0 == m_queued) break;
+        }
+    }
+
+    /**
+     *  \brief  Process range
+     *
+     *  Splits the range (pushing the upper halves as tasks) down
+     *  to grain size and processes the rest.
+     *
+     *  \param  j      Job
+     *  \param  begin  Range begin
+     *  \param  end    Range end
+     */
+    void run(job & j, size_t begin, size_t end) {
+        while (end - begin > j.grain) {
+            const size_t mid = begin + (end - begin) / 2;
+
+            push([this, &j, mid, end]() { run(j, mid, end); });
+            end = mid;
+        }
+
+        try {
+            j.fn(begin, end);
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(j.mx);
+            if (!j.error) j.error = std::current_exception();
+        }
+
+        j.remaining -= end - begin;  // NOTE: the job may be gone now
+    }
+
+    /**
+     *  \brief  Pin thread to CPU
+     *
+     *  \param  thread  Thread
+     *  \param  cpu     CPU
+     */
+    static void pin(std::thread & thread, int cpu) {
+#ifdef __linux__
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+
+        if (0 != pthread_setaffinity_np(
+            thread.native_handle(), sizeof(set), &set))
+        {
+            throw std::runtime_error(
+                "libnn::misc::thread_pool: "
+                "failed to set CPU affinity");
+        }
+#else
+        throw std::logic_error(
+            "libnn::misc::thread_pool: "
+            "CPU affinity not supported");
+#endif  // end of #ifdef __linux__
+    }
+
+    public:
+
+    /**
+     *  \brief  CPUs available to the process
+     *
+     *  Workers may be pinned to the CPUs (in order) by passing
+     *  the list (or its part) to the constructor.
+     *
+     *  \return CPU list (empty if CPU affinity is not supported)
+     */
+    static std::vector<int> available_cpus() {
+        std::vector<int> cpus;
+
+#ifdef __linux__
+        cpu_set_t set;
+        CPU_ZERO(&set);
+
+        if (0 == sched_getaffinity(0, sizeof(set), &set))
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+                if (CPU_ISSET(cpu, &set)) cpus.push_back(cpu);
+#endif  // end of #ifdef __linux__
+
+        return cpus;
+    }
+
+    /**
+     *  \brief  Constructor
+     *
+     *  If CPU list is specified, worker \c i is pinned to CPU
+     *  \c cpus[i % cpus.size()].
+     *
+     *  \param  threads  Worker count (0 means hardware concurrency)
+     *  \param  cpus     Workers CPU affinity (empty means no pinning)
+     */
+    thread_pool(
+        size_t                   threads = 0,
+        const std::vector<int> & cpus    = std::vector<int>())
+    :
+        m_queued(0),
+        m_stop(false)
+    {
+        if (0 == threads)
+            threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+
+        m_workers.reserve(threads);
+        for (size_t i = 0; i < threads; ++i)
+            m_workers.emplace_back(new worker());
+
+        try {
+            for (size_t i = 0; i < threads; ++i) {
+                worker & w = *m_workers[i];
+
+                w.thread = std::thread(&thread_pool::work, this, i);
+
+                if (!cpus.empty()) pin(w.thread, cpus[i % cpus.size()]);
+            }
+        }
+        catch (...) {
+            stop();
+            throw;
+        }
+    }
+
+    /** Worker count */
+    size_t size() const { return m_workers.size(); }
+
+    /** Worker count (for \ref executor) */
+    size_t concurrency() const { return m_workers.size(); }
+
+    /**
+     *  \brief  Submit task
+     *
+     *  \param  task  Task
+     *
+     *  \return Task future (provides exception thrown by the task)
+     */
+    std::future<void> submit(const task_t & task) {
+        auto packaged = std::make_shared<std::packaged_task<void()> >(task);
+
+        push([packaged]() { (*packaged)(); });
+
+        return packaged->get_future();
+    }
+
+    /**
+     *  \brief  Parallel for
+     *
+     *  See \ref executor::parallel_for.
+     *  The calling thread takes part in the processing.
+     *
+     *  \param  begin  Range begin
+     *  \param  end    Range end
+     *  \param  fn     Range function
+     *  \param  grain  Minimal sub-range size (0 means automatic)
+     */
+    void parallel_for(
+        size_t             begin,
+        size_t             end,
+        const range_fn_t & fn,
+        size_t             grain = 0)
+    {
+        if (!(begin < end)) return;
+
+        const size_t size = end - begin;
+        grain = impl::grain_size(size, m_workers.size() + 1, grain);
+
+        if (size <= grain) {
+            fn(begin, end);
+            return;
+        }
+
+        job j(fn, grain, size);
+        run(j, begin, end);
+
+        // Help until the job is done
+        const size_t i = self();
+        task_t task;
+        while (0 < j.remaining)
+            if (pop(i, task)) task(); else std::this_thread::yield();
+
+        if (j.error) std::rethrow_exception(j.error);
+    }
+
+    /**
+     *  \brief  Stop the pool
+     *
+     *  Waits for the queued tasks and joins the workers.
+     */
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(m_mx);
+            m_stop = true;
+        }
+
+        m_cv.notify_all();
+
+        std::for_each(m_workers.begin(), m_workers.end(),
+        [](std::unique_ptr<worker> & w) {
+            if (w->thread.joinable()) w->thread.join();
+        });
+    }
+
+    /** Destructor */
+    ~thread_pool() { stop(); }
+
+    /** Copying is forbidden */
+    thread_pool(const thread_pool & orig) = delete;
+
+    /** Assignment is forbidden */
+    void operator = (const thread_pool & rarg) = delete;
+
+};  // end of class thread_pool
+
+}}  // end of namespace libnn::misc
+
+
+#endif  // end of #ifndef libnn__misc__thread_pool_hxx
@@ -0,0 +1,288 @@
+#ifndef libnn__misc__unix_socket_hxx
+#define libnn__misc__unix_socket_hxx
+
+/**
+ *  Unix domain stream socket
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstddef>
+#include <cstring>
+#include <cerrno>
+#include <string>
+#include <stdexcept>
+
+extern "C" {
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+}
+
+
+namespace libnn {
+namespace misc {
+
+/**
+ *  \brief  Unix domain stream socket
+ *
+ *  Minimal RAII wrapper of a local (same host) stream socket, used
+ *  by the library local services (e.g. parameter server endpoint).
+ *  Transfers are blocking and complete (partial reads and writes
+ *  are resumed).
+ *  Errors are reported by \c std::runtime_error exceptions.
+ */
+class unix_socket {
+    private:
+
+    int m_fd;  /**< File descriptor (-1 if closed) */
+
+    /**
+     *  \brief  Throw system error
+     *
+     *  \param  what  Failed operation
+     */
+    static void fail(const std::string & what) {
+        throw std::runtime_error(
+            "libnn::misc::unix_socket: " + what + " failed: "
+            + ::strerror(errno));
+    }
+
+    /**
+     *  \brief  Socket address
+     *
+     *  \param  path  Socket path
+     *
+     *  \return Socket address
+     */
+    static struct sockaddr_un address(const std::string & path) {
+        struct sockaddr_un addr;
+        ::memset(&addr, 0, sizeof(addr));
+
+        if (path.size() >= sizeof(addr.sun_path))
+            throw std::range_error(
+                "libnn::misc::unix_socket: "
+                "socket path too long");
+
+        addr.sun_family = AF_UNIX;
+        ::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+        return addr;
+    }
+
+    /**
+     *  \brief  Constructor (of an open socket)
+     *
+     *  \param  fd  File descriptor
+     */
+    explicit unix_socket(int fd): m_fd(fd) {}
+
+    public:
+
+    /** Constructor (of a closed socket) */
+    unix_socket(): m_fd(-1) {}
+
+    /** Move constructor */
+    unix_socket(unix_socket && orig): m_fd(orig.m_fd) { orig.m_fd = -1; }
+
+    /** Move assignment */
+    unix_socket & operator = (unix_socket && rarg) {
+        if (this != &rarg) {
+            close();
+
+            m_fd = rarg.m_fd;
+            rarg.m_fd = -1;
+        }
+
+        return *this;
+    }
+
+    /**
+     *  \brief  Create listening socket
+     *
+     *  An existing socket file of the same path is removed.
+     *
+     *  \param  path     Socket path
+     *  \param  backlog  Connection backlog
+     *
+     *  \return Listening socket
+     */
+    static unix_socket listen(const std::string & path, int backlog = 64) {
+        const struct sockaddr_un addr = address(path);
+
+        unix_socket sock(::socket(AF_UNIX, SOCK_STREAM, 0));
+        if (-1 == sock.m_fd) fail("socket");
+
+        ::unlink(path.c_str());
+
+        if (-1 == ::bind(sock.m_fd, (const struct sockaddr *)&addr,
+            sizeof(addr))) fail("bind");
+
+        if (-1 == ::listen(sock.m_fd, backlog)) fail("listen");
+
+        return sock;
+    }
+
+    /**
+     *  \brief  Connect to a listening socket
+     *
+     *  \param  path  Socket path
+     *
+     *  \return Connected socket
+     */
+    static unix_socket connect(const std::string & path) {
+        const struct sockaddr_un addr = address(path);
+
+        unix_socket sock(::socket(AF_UNIX, SOCK_STREAM, 0));
+        if (-1 == sock.m_fd) fail("socket");
+
+        if (-1 == ::connect(sock.m_fd, (const struct sockaddr *)&addr,
+            sizeof(addr))) fail("connect");
+
+        return sock;
+    }
+
+    /**
+     *  \brief  Accept connection (listening socket only)
+     *
+     *  \return Connected socket (closed if the listening socket was shut
+     *          down)
+     */
+    unix_socket accept() {
+        for (;;) {
+            const int fd = ::accept(m_fd, NULL, NULL);
+            if (-1 != fd) return unix_socket(fd);
+
+            if (EINTR == errno) continue;
+            if (EINVAL == errno || EBADF == errno) return unix_socket();
+
+            fail("accept");
+        }
+    }
+
+    /** Check whether the socket is open */
+    bool is_open() const { return -1 != m_fd; }
+
+    /**
+     *  \brief  Send data
+     *
+     *  \param  data  Data
+     *  \param  size  Data size
+     */
+    void send(const void * data, size_t size) {
+        const char * ptr = static_cast<const char *>(data);
+
+        while (size) {
+            const ssize_t n = ::send(m_fd, ptr, size, MSG_NOSIGNAL);
+            if (-1 == n) {
+                if (EINTR == errno) continue;
+                fail("send");
+            }
+
+            ptr  += n;
+            size -= n;
+        }
+    }
+
+    /**
+     *  \brief  Receive data
+     *
+     *  \param  data  Data
+     *  \param  size  Data size
+     *
+     *  \return \c false if the peer closed the connection before sending
+     *          any data, \c true if all the data were received
+     */
+    bool recv(void * data, size_t size) {
+        char * ptr = static_cast<char *>(data);
+        const size_t total = size;
+
+        while (size) {
+            const ssize_t n = ::recv(m_fd, ptr, size, 0);
+            if (-1 == n) {
+                if (EINTR == errno) continue;
+                fail("recv");
+            }
+
+            if (0 == n) {
+                if (size == total) return false;
+
+                throw std::runtime_error(
+                    "libnn::misc::unix_socket: "
+                    "connection closed prematurely");
+            }
+
+            ptr  += n;
+            size -= n;
+        }
+
+        return true;
+    }
+
+    /**
+     *  \brief  Shut the socket down
+     *
+     *  Pending (and future) blocking operations on the socket (in other
+     *  threads) return.
+     */
+    void shutdown() {
+        if (-1 != m_fd) ::shutdown(m_fd, SHUT_RDWR);
+    }
+
+    /** Close the socket */
+    void close() {
+        if (-1 == m_fd) return;
+
+        ::close(m_fd);
+        m_fd = -1;
+    }
+
+    /** Copying is forbidden */
+    unix_socket(const unix_socket & orig) = delete;
+
+    /** Assignment is forbidden */
+    void operator = (const unix_socket & rarg) = delete;
+
+    /** Destructor */
+    ~unix_socket() { close(); }
+
+};  // end of class unix_socket
+
+}}  // end of namespace libnn::misc
+
+
+#endif  // end of #ifndef libnn__misc__unix_socket_hxx
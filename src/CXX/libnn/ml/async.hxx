@@ -0,0 +1,1006 @@
+#ifndef libnn__ml__async_hxx
+#define libnn__ml__async_hxx
+
+/**
+ *  Async (coroutine) network evaluation
+ *
+ *  Awaitable network evaluation for C++20 coroutines (the header
+ *  is empty unless compiled with coroutines support).
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// The async API requires C++20 coroutines; the header is empty otherwise
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+
+/** The async API (C++20 coroutines) is available */
+#define LIBNN_HAVE_COROUTINES 1
+
+#include "libnn/misc/thread_pool.hxx"
+
+#include <coroutine>
+#include <cstddef>
+#include <vector>
+#include <deque>
+#include <list>
+#include <queue>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <utility>
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+
+
+namespace libnn {
+namespace ml {
+
+/** Async operation was cancelled */
+class operation_cancelled: public std::runtime_error {
+    public:
+
+    /** Constructor */
+    operation_cancelled():
+        std::runtime_error("libnn::ml::async: operation cancelled")
+    {}
+
+};  // end of class operation_cancelled
+
+
+/** Async operation deadline was exceeded */
+class deadline_exceeded: public std::runtime_error {
+    public:
+
+    /** Constructor */
+    deadline_exceeded():
+        std::runtime_error("libnn::ml::async: deadline exceeded")
+    {}
+
+};  // end of class deadline_exceeded
+
+
+namespace impl {
+
+/** Cancellation state (shared by source and tokens) */
+struct cancel_state {
+    typedef std::function<void()> callback_t;  /**< Cancellation callback */
+
+    std::mutex                                  mx;         /**< Mutex     */
+    std::atomic<bool>                           cancelled;  /**< Flag      */
+    std::list<std::pair<size_t, callback_t> >   callbacks;  /**< Callbacks */
+    size_t                                      next_id;    /**< Next ID   */
+
+    /** Constructor */
+    cancel_state(): cancelled(false), next_id(1) {}
+
+};  // end of struct cancel_state
+
+}  // end of namespace impl
+
+
+/**
+ *  \brief  Cancellation token
+ *
+ *  Observes cancellation of a \ref cancel_source.
+ *  Default-constructed token is never cancelled.
+ */
+class cancel_token {
+    friend class cancel_source;
+
+    public:
+
+    typedef impl::cancel_state::callback_t callback_t;  /**< Callback */
+
+    private:
+
+    std::shared_ptr<impl::cancel_state> m_state;  /**< Shared state */
+
+    /** Constructor (by source) */
+    cancel_token(const std::shared_ptr<impl::cancel_state> & state):
+        m_state(state)
+    {}
+
+    public:
+
+    /** Constructor (never cancelled token) */
+    cancel_token() {}
+
+    /** Check whether cancellation was requested */
+    bool cancelled() const { return m_state && m_state->cancelled; }
+
+    /**
+     *  \brief  Subscribe cancellation callback
+     *
+     *  The callback is called (once) by the thread requesting
+     *  the cancellation.
+     *
+     *  \param  callback  Callback
+     *
+     *  \return Subscription ID (0 if the token is already cancelled
+     *          or can't be cancelled; the callback isn't subscribed)
+     */
+    size_t subscribe(const callback_t & callback) const {
+        if (!m_state) return 0;
+
+        std::lock_guard<std::mutex> lock(m_state->mx);
+
+        if (m_state->cancelled) return 0;
+
+        const size_t id = m_state->next_id++;
+        m_state->callbacks.emplace_back(id, callback);
+
+        return id;
+    }
+
+    /**
+     *  \brief  Unsubscribe cancellation callback
+     *
+     *  \param  id  Subscription ID
+     */
+    void unsubscribe(size_t id) const {
+        if (!m_state || 0 == id) return;
+
+        std::lock_guard<std::mutex> lock(m_state->mx);
+
+        m_state->callbacks.remove_if(
+        [id](const std::pair<size_t, callback_t> & cb) {
+            return id == cb.first;
+        });
+    }
+
+};  // end of class cancel_token
+
+
+/**
+ *  \brief  Cancellation source
+ *
+ *  Pending async operations of the source tokens complete with
+ *  \ref operation_cancelled once \ref cancel is called.
+ */
+class cancel_source {
+    private:
+
+    std::shared_ptr<impl::cancel_state> m_state;  /**< Shared state */
+
+    public:
+
+    /** Constructor */
+    cancel_source(): m_state(std::make_shared<impl::cancel_state>()) {}
+
+    /** Token */
+    cancel_token token() const { return cancel_token(m_state); }
+
+    /** Check whether cancellation was requested */
+    bool cancelled() const { return m_state->cancelled; }
+
+    /**
+     *  \brief  Request cancellation
+     *
+     *  Calls the subscribed callbacks (by the calling thread).
+     */
+    void cancel() {
+        std::list<std::pair<size_t, impl::cancel_state::callback_t> > cbs;
+
+        {
+            std::lock_guard<std::mutex> lock(m_state->mx);
+
+            if (m_state->cancelled) return;
+
+            m_state->cancelled = true;
+            cbs.swap(m_state->callbacks);
+        }
+
+        for (auto cb = cbs.begin(); cb != cbs.end(); ++cb) cb->second();
+    }
+
+};  // end of class cancel_source
+
+
+namespace impl {
+
+/**
+ *  \brief  Async evaluation request
+ *
+ *  \tparam  Base_t  Base numeric type
+ */
+template <typename Base_t>
+class async_request {
+    public:
+
+    typedef std::vector<Base_t> io_t;  /**< Input/output */
+
+    /** Resume function */
+    typedef std::function<void(std::coroutine_handle<>)> resume_t;
+
+    io_t                            input;      /**< Input                */
+    io_t                            output;     /**< Output               */
+    std::exception_ptr              error;      /**< Error                */
+    std::coroutine_handle<>         waiter;     /**< Awaiting coroutine   */
+    std::shared_ptr<const resume_t> resume;     /**< Resume function      */
+    cancel_token                    cancel;     /**< Cancellation token   */
+    size_t                          cancel_id;  /**< Cancellation subscr. */
+
+    private:
+
+    std::mutex m_mx;    /**< Completion mutex */
+    bool       m_done;  /**< Completed        */
+
+    public:
+
+    /** Constructor */
+    async_request(): cancel_id(0), m_done(false) {}
+
+    /** Check completion */
+    bool done() {
+        std::lock_guard<std::mutex> lock(m_mx);
+        return m_done;
+    }
+
+    /**
+     *  \brief  Complete without resuming the waiter
+     *
+     *  Only used before the request is started (no concurrency).
+     *
+     *  \param  x  Error
+     */
+    void fail(std::exception_ptr x) {
+        error  = x;
+        m_done = true;
+    }
+
+    /**
+     *  \brief  Complete the request and resume the waiter
+     *
+     *  The first completion (evaluation, cancellation or deadline) wins;
+     *  the others are ignored.
+     *
+     *  \param  out  Output (moved; \c NULL in case of error)
+     *  \param  x    Error
+     *
+     *  \return \c true iff the request was completed by the call
+     */
+    bool complete(io_t * out, std::exception_ptr x) {
+        {
+            std::lock_guard<std::mutex> lock(m_mx);
+
+            if (m_done) return false;
+
+            if (out) output.swap(*out); else error = x;
+            m_done = true;
+        }
+
+        cancel.unsubscribe(cancel_id);
+
+        if (resume && *resume) (*resume)(waiter); else waiter.resume();
+
+        return true;
+    }
+
+};  // end of template class async_request
+
+
+/**
+ *  \brief  Deadline timer
+ *
+ *  Completes requests with \ref deadline_exceeded at their deadlines.
+ *  The timer thread is started with the first scheduled deadline.
+ *  Only weak references are kept (completed requests are just
+ *  dropped at their deadlines).
+ *
+ *  \tparam  Base_t  Base numeric type
+ */
+template <typename Base_t>
+class deadline_timer {
+    public:
+
+    typedef std::chrono::steady_clock clock_t;     /**< Clock    */
+    typedef clock_t::time_point       deadline_t;  /**< Deadline */
+
+    private:
+
+    typedef async_request<Base_t> request_t;  /**< Request */
+
+    /** Scheduled deadline */
+    struct entry {
+        deadline_t                 deadline;  /**< Deadline */
+        std::weak_ptr<request_t>   req;       /**< Request  */
+
+        /** Ordering (earliest deadline on top) */
+        bool operator < (const entry & rarg) const {
+            return deadline > rarg.deadline;
+        }
+    };  // end of struct entry
+
+    std::mutex                  m_mx;      /**< Mutex        */
+    std::condition_variable     m_cv;      /**< Signal       */
+    std::priority_queue<entry>  m_queue;   /**< Deadlines    */
+    bool                        m_stop;    /**< Stop flag    */
+    std::thread                 m_thread;  /**< Timer thread */
+
+    /** Timer thread routine */
+    void run() {
+        std::unique_lock<std::mutex> lock(m_mx);
+
+        while (!m_stop) {
+            if (m_queue.empty()) {
+                m_cv.wait(lock);
+                continue;
+            }
+
+            const deadline_t deadline = m_queue.top().deadline;
+            if (clock_t::now() < deadline) {
+                m_cv.wait_until(lock, deadline);
+                continue;
+            }
+
+            std::shared_ptr<request_t> req = m_queue.top().req.lock();
+            m_queue.pop();
+
+            if (!req) continue;
+
+            lock.unlock();
+            req->complete(NULL, std::make_exception_ptr(deadline_exceeded()));
+            lock.lock();
+        }
+    }
+
+    public:
+
+    /** Constructor */
+    deadline_timer(): m_stop(false) {}
+
+    /**
+     *  \brief  Schedule deadline
+     *
+     *  \param  deadline  Deadline
+     *  \param  req       Request
+     */
+    void schedule(deadline_t deadline, const std::shared_ptr<request_t> & req) {
+        std::lock_guard<std::mutex> lock(m_mx);
+
+        if (!m_thread.joinable())
+            m_thread = std::thread([this]() { run(); });
+
+        const bool earliest = m_queue.empty()
+            || deadline < m_queue.top().deadline;
+
+        m_queue.push(entry{deadline, req});
+
+        if (earliest) m_cv.notify_one();
+    }
+
+    /** Copying is forbidden */
+    deadline_timer(const deadline_timer & orig) = delete;
+
+    /** Assignment is forbidden */
+    void operator = (const deadline_timer & rarg) = delete;
+
+    /** Destructor (pending deadlines are dropped) */
+    ~deadline_timer() {
+        {
+            std::lock_guard<std::mutex> lock(m_mx);
+            m_stop = true;
+        }
+
+        m_cv.notify_one();
+
+        if (m_thread.joinable()) m_thread.join();
+    }
+
+};  // end of template class deadline_timer
+
+}  // end of namespace impl
+
+
+/**
+ *  \brief  Async evaluation result (awaitable)
+ *
+ *  The evaluation is started when the result is awaited
+ *  (\c co_await yields the output or throws the evaluation error,
+ *  \ref operation_cancelled or \ref deadline_exceeded).
+ *  The result may only be awaited once.
+ *
+ *  \tparam  Base_t  Base numeric type
+ */
+template <typename Base_t>
+class async_result {
+    public:
+
+    typedef std::vector<Base_t> output_t;  /**< Output */
+
+    private:
+
+    typedef impl::async_request<Base_t> request_t;  /**< Request */
+
+    /** Start function (returns \c false if completed at once) */
+    typedef std::function<bool(const std::shared_ptr<request_t> &)> start_t;
+
+    std::shared_ptr<request_t> m_req;    /**< Request        */
+    start_t                    m_start;  /**< Start function */
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  req    Request
+     *  \param  start  Start function
+     */
+    async_result(const std::shared_ptr<request_t> & req, start_t && start):
+        m_req(req),
+        m_start(std::move(start))
+    {}
+
+    /** Evaluation is never ready before it's started */
+    bool await_ready() const noexcept { return false; }
+
+    /**
+     *  \brief  Start evaluation
+     *
+     *  NOTE that the awaiting coroutine may be resumed (and the awaitable
+     *  destroyed) before the function returns, so only locals are used
+     *  once the evaluation is started.
+     *
+     *  \param  h  Awaiting coroutine
+     *
+     *  \return \c false iff the request was completed at once
+     */
+    bool await_suspend(std::coroutine_handle<> h) {
+        std::shared_ptr<request_t> req   = m_req;
+        start_t                    start = std::move(m_start);
+
+        req->waiter = h;
+
+        return start(req);
+    }
+
+    /** Output (or error) */
+    output_t await_resume() {
+        if (m_req->error) std::rethrow_exception(m_req->error);
+
+        return std::move(m_req->output);
+    }
+
+};  // end of template class async_result
+
+
+namespace impl {
+
+/**
+ *  \brief  Async evaluation base
+ *
+ *  Provides request creation and start (cancellation and deadline
+ *  registration); the evaluation is up to the derived class.
+ *
+ *  \tparam  Base_t  Base numeric type
+ */
+template <typename Base_t>
+class async_base {
+    public:
+
+    typedef std::vector<Base_t>            input_t;     /**< Input    */
+    typedef std::vector<Base_t>            output_t;    /**< Output   */
+    typedef deadline_timer<Base_t>         timer_t;     /**< Timer    */
+    typedef typename timer_t::clock_t      clock_t;     /**< Clock    */
+    typedef typename timer_t::deadline_t   deadline_t;  /**< Deadline */
+    typedef async_result<Base_t>           result_t;    /**< Result   */
+
+    /** Coroutine resume function (e.g. posting to an event loop) */
+    typedef typename async_request<Base_t>::resume_t resume_t;
+
+    protected:
+
+    typedef async_request<Base_t>      request_t;    /**< Request         */
+    typedef std::shared_ptr<request_t> request_ptr;  /**< Request pointer */
+
+    misc::thread_pool &              m_pool;     /**< Thread pool          */
+    std::shared_ptr<const resume_t>  m_resume;   /**< Resume function      */
+    timer_t                          m_timer;    /**< Deadline timer       */
+    std::mutex                       m_mx;       /**< Pending tasks mutex  */
+    std::condition_variable          m_cv;       /**< Pending tasks signal */
+    size_t                           m_pending;  /**< Pending pool tasks   */
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  pool    Thread pool
+     *  \param  resume  Resume function (empty means resuming inline)
+     */
+    async_base(misc::thread_pool & pool, const resume_t & resume):
+        m_pool(pool),
+        m_resume(std::make_shared<const resume_t>(resume)),
+        m_pending(0)
+    {}
+
+    /**
+     *  \brief  Create async result
+     *
+     *  \param  input     Input
+     *  \param  cancel    Cancellation token
+     *  \param  deadline  Deadline
+     *  \param  submit    Request submission (called once started)
+     *
+     *  \return Async result
+     */
+    result_t create(
+        input_t                                    input,
+        const cancel_token                       & cancel,
+        deadline_t                                 deadline,
+        std::function<void(const request_ptr &)> && submit)
+    {
+        request_ptr req = std::make_shared<request_t>();
+        req->input  = std::move(input);
+        req->resume = m_resume;
+        req->cancel = cancel;
+
+        return result_t(req, [this, deadline, submit](const request_ptr & r) {
+            if (r->cancel.cancelled()) {
+                r->fail(std::make_exception_ptr(operation_cancelled()));
+                return false;
+            }
+
+            if (deadline <= clock_t::now()) {
+                r->fail(std::make_exception_ptr(deadline_exceeded()));
+                return false;
+            }
+
+            // From now on, the request may be completed concurrently
+            const std::weak_ptr<request_t> weak = r;
+            r->cancel_id = r->cancel.subscribe([weak]() {
+                const request_ptr req = weak.lock();
+                if (req)
+                    req->complete(NULL,
+                        std::make_exception_ptr(operation_cancelled()));
+            });
+
+            if (0 == r->cancel_id && r->cancel.cancelled()) {
+                r->complete(NULL,
+                    std::make_exception_ptr(operation_cancelled()));
+                return true;
+            }
+
+            if (deadline_t::max() != deadline) m_timer.schedule(deadline, r);
+
+            submit(r);
+
+            return true;
+        });
+    }
+
+    /** Pool task submitted */
+    void task_begin() {
+        std::lock_guard<std::mutex> lock(m_mx);
+        ++m_pending;
+    }
+
+    /** Pool task finished */
+    void task_end() {
+        std::lock_guard<std::mutex> lock(m_mx);
+        if (0 == --m_pending) m_cv.notify_all();
+    }
+
+    /** Wait for pool tasks */
+    void wait() {
+        std::unique_lock<std::mutex> lock(m_mx);
+        m_cv.wait(lock, [this]() { return 0 == m_pending; });
+    }
+
+};  // end of template class async_base
+
+}  // end of namespace impl
+
+
+/**
+ *  \brief  Async network function
+ *
+ *  Each awaited evaluation runs as a thread pool task, so that
+ *  the awaiting (e.g. event loop) thread isn't blocked.
+ *  The awaiting coroutine is resumed by the thread completing
+ *  the evaluation (pool worker, deadline timer or the thread
+ *  requesting cancellation) unless a resume function is specified;
+ *  use it to re-schedule the coroutine on its event loop.
+ *
+ *  Cancelled (or expired) evaluations are skipped if they haven't
+ *  started yet; running evaluation isn't interrupted (its output is
+ *  dropped).
+ *  Concurrent evaluations use separate network function instances
+ *  (created on demand by a factory and reused).
+ *
+ *  The object must not be destroyed by a coroutine resumed by it;
+ *  the destructor waits for the pending evaluations.
+ *
+ *  \tparam  Base_t    Base numeric type
+ *  \tparam  Function  Network function (providing \c operator()(input),
+ *                     e.g. \c model::feed_forward::function_t)
+ */
+template <typename Base_t, class Function>
+class async_func: private impl::async_base<Base_t> {
+    private:
+
+    typedef impl::async_base<Base_t> base_t;  /**< Base */
+
+    public:
+
+    typedef typename base_t::input_t    input_t;     /**< Input        */
+    typedef typename base_t::output_t   output_t;    /**< Output       */
+    typedef typename base_t::clock_t    clock_t;     /**< Clock        */
+    typedef typename base_t::deadline_t deadline_t;  /**< Deadline     */
+    typedef typename base_t::result_t   result_t;    /**< Async result */
+    typedef typename base_t::resume_t   resume_t;    /**< Resume fn    */
+
+    /** Network function factory (e.g. calling \c nn.function()) */
+    typedef std::function<Function()> factory_t;
+
+    private:
+
+    typedef typename base_t::request_ptr request_ptr;  /**< Request */
+
+    const factory_t                         m_factory;  /**< Fn factory     */
+    std::mutex                              m_fn_mx;    /**< Free fns mutex */
+    std::vector<std::unique_ptr<Function> > m_free;     /**< Idle fns       */
+
+    /** Take function instance */
+    std::unique_ptr<Function> take() {
+        {
+            std::lock_guard<std::mutex> lock(m_fn_mx);
+
+            if (!m_free.empty()) {
+                std::unique_ptr<Function> fn = std::move(m_free.back());
+                m_free.pop_back();
+
+                return fn;
+            }
+        }
+
+        return std::unique_ptr<Function>(new Function(m_factory()));
+    }
+
+    /** Return function instance */
+    void give(std::unique_ptr<Function> && fn) {
+        std::lock_guard<std::mutex> lock(m_fn_mx);
+        m_free.push_back(std::move(fn));
+    }
+
+    /** Evaluation (pool task) */
+    void eval(const request_ptr & req) {
+        if (!req->done()) {
+            std::unique_ptr<Function> fn = take();
+
+            output_t           out;
+            std::exception_ptr error;
+
+            try { out = (*fn)(req->input); }
+            catch (...) { error = std::current_exception(); }
+
+            give(std::move(fn));
+
+            req->complete(error ? NULL : &out, error);
+        }
+
+        this->task_end();
+    }
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  factory  Network function factory
+     *  \param  pool     Thread pool
+     *  \param  resume   Coroutine resume function (empty means inline)
+     */
+    async_func(
+        const factory_t   & factory,
+        misc::thread_pool & pool,
+        const resume_t    & resume = resume_t())
+    :
+        base_t(pool, resume),
+        m_factory(factory)
+    {}
+
+    /**
+     *  \brief  Evaluate network function asynchronously
+     *
+     *  The evaluation starts when the result is awaited.
+     *
+     *  \param  input     Input
+     *  \param  cancel    Cancellation token
+     *  \param  deadline  Deadline
+     *
+     *  \return Async result (awaitable)
+     */
+    result_t operator () (
+        input_t              input,
+        const cancel_token & cancel   = cancel_token(),
+        deadline_t           deadline = deadline_t::max())
+    {
+        return this->create(std::move(input), cancel, deadline,
+        [this](const request_ptr & req) {
+            this->task_begin();
+            this->m_pool.submit([this, req]() { eval(req); });
+        });
+    }
+
+    /** Copying is forbidden */
+    async_func(const async_func & orig) = delete;
+
+    /** Assignment is forbidden */
+    void operator = (const async_func & rarg) = delete;
+
+    /** Destructor (waits for pending evaluations) */
+    ~async_func() { this->wait(); }
+
+};  // end of template class async_func
+
+
+/**
+ *  \brief  Batching async network function
+ *
+ *  Coalesces concurrent awaiters: requests arriving while a batch
+ *  is being evaluated are queued and evaluated as the next batch
+ *  (at most \c max_batch requests at once) by a single pool task.
+ *  Unlike \ref micro_batcher, no time window is waited for; the batches
+ *  grow with the load.
+ *  If a batch evaluation fails, its requests are evaluated one by one,
+ *  so that an invalid request doesn't fail the others.
+ *
+ *  See \ref async_func for the resumption, cancellation and lifetime
+ *  rules.
+ *
+ *  \tparam  Base_t    Base numeric type
+ *  \tparam  Function  Network function providing batch evaluation
+ *                     (\c batch(inputs), e.g.
+ *                     \c model::feed_forward::function_t)
+ */
+template <typename Base_t, class Function>
+class async_batcher: private impl::async_base<Base_t> {
+    private:
+
+    typedef impl::async_base<Base_t> base_t;  /**< Base */
+
+    public:
+
+    typedef typename base_t::input_t    input_t;     /**< Input        */
+    typedef typename base_t::output_t   output_t;    /**< Output       */
+    typedef typename base_t::clock_t    clock_t;     /**< Clock        */
+    typedef typename base_t::deadline_t deadline_t;  /**< Deadline     */
+    typedef typename base_t::result_t   result_t;    /**< Async result */
+    typedef typename base_t::resume_t   resume_t;    /**< Resume fn    */
+
+    private:
+
+    typedef typename base_t::request_ptr request_ptr;  /**< Request */
+
+    Function &              m_fn;         /**< Network function      */
+    const size_t            m_max_batch;  /**< Maximal batch size    */
+    std::mutex              m_queue_mx;   /**< Queue mutex           */
+    std::deque<request_ptr> m_queue;      /**< Queued requests       */
+    bool                    m_draining;   /**< Drain task is running */
+    std::atomic<size_t>     m_requests;   /**< Evaluated requests    */
+    std::atomic<size_t>     m_batches;    /**< Evaluated batches     */
+
+    /**
+     *  \brief  Take batch
+     *
+     *  Completed (i.e. cancelled or expired) requests are dropped.
+     *
+     *  \param  batch  Batch
+     *
+     *  \return \c false iff there are no requests left (the drain
+     *          task shall finish)
+     */
+    bool take(std::vector<request_ptr> & batch) {
+        std::lock_guard<std::mutex> lock(m_queue_mx);
+
+        while (!m_queue.empty() && batch.size() < m_max_batch) {
+            if (!m_queue.front()->done())
+                batch.push_back(std::move(m_queue.front()));
+
+            m_queue.pop_front();
+        }
+
+        if (batch.empty()) m_draining = false;
+
+        return !batch.empty();
+    }
+
+    /**
+     *  \brief  Evaluate failed batch requests one by one
+     *
+     *  So that an invalid request only fails itself.
+     *
+     *  \param  batch   Batch
+     *  \param  inputs  Batch inputs
+     */
+    void isolate(
+        std::vector<request_ptr> & batch,
+        std::vector<input_t>     & inputs)
+    {
+        std::vector<input_t> single(1);
+
+        for (size_t i = 0; i < batch.size(); ++i) {
+            single[0] = std::move(inputs[i]);
+
+            std::vector<output_t> outputs;
+            std::exception_ptr    error;
+
+            try {
+                outputs = m_fn.batch(single);
+
+                if (1 != outputs.size())
+                    throw std::logic_error(
+                        "libnn::ml::async_batcher: "
+                        "batch output count mismatch");
+            }
+            catch (...) {
+                error = std::current_exception();
+            }
+
+            batch[i]->complete(error ? NULL : &outputs[0], error);
+        }
+    }
+
+    /** Drain the queue (pool task) */
+    void drain() {
+        std::vector<request_ptr> batch;
+        std::vector<input_t>     inputs;
+
+        while (take(batch)) {
+            inputs.resize(batch.size());
+            for (size_t i = 0; i < batch.size(); ++i)
+                inputs[i] = std::move(batch[i]->input);
+
+            std::vector<output_t> outputs;
+            std::exception_ptr    error;
+
+            try {
+                outputs = m_fn.batch(inputs);
+
+                if (outputs.size() != batch.size())
+                    throw std::logic_error(
+                        "libnn::ml::async_batcher: "
+                        "batch output count mismatch");
+            }
+            catch (...) {
+                error = std::current_exception();
+            }
+
+            m_requests += batch.size();
+            ++m_batches;
+
+            if (error && 1 < batch.size())
+                isolate(batch, inputs);
+            else
+                for (size_t i = 0; i < batch.size(); ++i)
+                    batch[i]->complete(error ? NULL : &outputs[i], error);
+
+            batch.clear();
+        }
+
+        this->task_end();
+    }
+
+    /** Enqueue request */
+    void enqueue(const request_ptr & req) {
+        {
+            std::lock_guard<std::mutex> lock(m_queue_mx);
+
+            m_queue.push_back(req);
+
+            if (m_draining) return;
+
+            m_draining = true;
+        }
+
+        this->task_begin();
+        this->m_pool.submit([this]() { drain(); });
+    }
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  fn         Network function (only used by the pool tasks)
+     *  \param  pool       Thread pool
+     *  \param  max_batch  Maximal batch size
+     *  \param  resume     Coroutine resume function (empty means inline)
+     */
+    async_batcher(
+        Function          & fn,
+        misc::thread_pool & pool,
+        size_t              max_batch = 64,
+        const resume_t    & resume    = resume_t())
+    :
+        base_t(pool, resume),
+        m_fn(fn),
+        m_max_batch(std::max<size_t>(1, max_batch)),
+        m_draining(false),
+        m_requests(0),
+        m_batches(0)
+    {}
+
+    /** Maximal batch size */
+    size_t max_batch() const { return m_max_batch; }
+
+    /** Evaluated requests */
+    size_t requests() const { return m_requests; }
+
+    /** Evaluated batches */
+    size_t batches() const { return m_batches; }
+
+    /**
+     *  \brief  Evaluate network function asynchronously
+     *
+     *  The request is queued when the result is awaited.
+     *
+     *  \param  input     Input
+     *  \param  cancel    Cancellation token
+     *  \param  deadline  Deadline
+     *
+     *  \return Async result (awaitable)
+     */
+    result_t operator () (
+        input_t              input,
+        const cancel_token & cancel   = cancel_token(),
+        deadline_t           deadline = deadline_t::max())
+    {
+        return this->create(std::move(input), cancel, deadline,
+        [this](const request_ptr & req) { enqueue(req); });
+    }
+
+    /** Copying is forbidden */
+    async_batcher(const async_batcher & orig) = delete;
+
+    /** Assignment is forbidden */
+    void operator = (const async_batcher & rarg) = delete;
+
+    /** Destructor (waits for pending evaluations) */
+    ~async_batcher() { this->wait(); }
+
+};  // end of template class async_batcher
+
+}}  // end of namespace libnn::ml
+
+#endif  // end of C++20 coroutines check
+
+
+#endif  // end of #ifndef libnn__ml__async_hxx
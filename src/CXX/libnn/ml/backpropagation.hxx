@@ -42,14 +42,23 @@
  *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include "libnn/instances.hxx"
 #include "libnn/topo/nn.hxx"
 #include "libnn/ml/computation.hxx"
+#include "libnn/ml/telemetry.hxx"
+#include "libnn/misc/allreduce.hxx"
+#include "libnn/misc/instrument.hxx"
+#include "libnn/misc/memory_usage.hxx"
+#include "libnn/misc/memory_resource.hxx"
 
 #include <vector>
 #include <list>
+#include <unordered_map>
 #include <stdexcept>
 #include <algorithm>
+#include <type_traits>
 #include <cassert>
+#include <cmath>
 
 
 namespace libnn {
@@ -66,6 +75,18 @@ namespace ml {
  *
  *  that computes 1st derivation of the activation function in \c x.
  *
+ *  Batch mode normally keeps forward and backward results of each neuron
+ *  for each training pattern of the batch.
+ *  For deep networks and large batches, that may be a lot of memory.
+ *  Checkpointed training mode (see \ref checkpoint) trades computation
+ *  for memory: only forward results of neurons at checkpoint levels
+ *  (i.e. every k-th level of the network, level being the longest path
+ *  from a neuron without synapses) are kept per pattern.
+ *  The rest is re-computed (lazily, from the nearest checkpoints)
+ *  in a single computation slot during the backward phase.
+ *
+ *  Batch mode may also be data-parallel (see \ref allreduce).
+ *
  *  \tparam  Base_t   Base numeric type
  *  \tparam  Act_fn   Activation function
  */
@@ -82,9 +103,15 @@ class backpropagation {
      *  For each neuron, this list contains all synapsis (and their neurons
      *  indices) that connect to the neuron.
      */
-    typedef std::vector<
-        std::list<
-            std::pair<const typename nn_t::neuron::dendrite &, size_t> > >
+    typedef std::pair<const typename nn_t::neuron::dendrite &, size_t>
+        synapsis_t;
+
+    /** Forward synapses of a neuron */
+    typedef std::list<synapsis_t, misc::polymorphic_allocator<synapsis_t> >
+        synapses_t;
+
+    /** Forward synapses mapping */
+    typedef std::vector<synapses_t, misc::polymorphic_allocator<synapses_t> >
         forward_map_t;
 
     /**
@@ -132,9 +159,12 @@ class backpropagation {
         forward_result f(const typename nn_t::neuron & n) {
             forward_result res;
 
+            this->tally().add(misc::instrument::MULADDS, n.dendrite_cnt());
+
             n.for_each_dendrite(
             [&res, this](const typename nn_t::neuron::dendrite & dend) {
-                res.net += dend.weight * this->fx(dend.source.index()).phi_net;
+                res.net +=
+                    dend.weight() * this->fx(dend.source().index()).phi_net;
             });
 
             res.phi_net = n.act_fn(res.net);
@@ -147,9 +177,12 @@ class backpropagation {
         /**
          *  \brief  Constructor
          *
-         *  \param  network  Neural network
+         *  \param  network   Neural network
+         *  \param  resource  Memory resource
          */
-        forward(const nn_t & network): computation_t(network) {}
+        forward(const nn_t & network, misc::memory_resource * resource):
+            computation_t(network, resource)
+        {}
 
         /**
          *  \brief  Hard-fix neurons' activation function values
@@ -161,6 +194,18 @@ class backpropagation {
             this->const_fx(n, forward_result(phi));
         }
 
+        /**
+         *  \brief  Restore (checkpointed) forward result of a neuron
+         *
+         *  The value is soft-fixed (until the next reset).
+         *
+         *  \param  n    Neuron index
+         *  \param  res  Forward result
+         */
+        void restore(size_t n, const forward_result & res) {
+            this->fx(n, res);
+        }
+
         /**
          *  \brief  Execute the forward phase
          *
@@ -171,6 +216,9 @@ class backpropagation {
          */
         template <class Input>
         std::vector<Base_t> operator () (const Input & input) {
+            misc::instrument::phase_timer timer(
+                misc::instrument::FORWARD, this->tally());
+
             this->reset();  // make sure all is clean
 
             // Set input layer
@@ -239,7 +287,7 @@ class backpropagation {
         typedef typename neuron_t::dendrite dendrite_t;
 
         const forward_map_t & m_fmap;     /**< Forward mapping       */
-        const forward       & m_forward;  /**< Forward stage results */
+        forward             & m_forward;  /**< Forward stage results */
 
         /**
          *  \brief  Compute backward result for non-output neuron
@@ -259,12 +307,14 @@ class backpropagation {
             assert(n.index() < m_fmap.size());
 
             const auto & fw_neurons = m_fmap[n.index()];
+            this->tally().add(misc::instrument::MULADDS, fw_neurons.size());
+
             std::for_each(fw_neurons.begin(), fw_neurons.end(),
             [&res, this](const std::pair<const dendrite_t &, size_t> & dend_n) {
                 const dendrite_t & fw_dend    = dend_n.first;
                 const size_t       fw_n_index = dend_n.second;
 
-                res.delta += this->fx(fw_n_index).delta * fw_dend.weight;
+                res.delta += this->fx(fw_n_index).delta * fw_dend.weight();
             });
 
             res.delta *= n.act_fn().d(m_forward.fx(n.index()).net);
@@ -277,16 +327,18 @@ class backpropagation {
         /**
          *  \brief  Constructor
          *
-         *  \param  network  Neural network
-         *  \param  fmap     Forward mapping
-         *  \param  forvard  Forward stage results
+         *  \param  network   Neural network
+         *  \param  fmap      Forward mapping
+         *  \param  forvard   Forward stage results
+         *  \param  resource  Memory resource
          */
         backward(
-            const nn_t          & network,
-            const forward_map_t & fmap,
-            const forward       & forvard)
+            const nn_t            & network,
+            const forward_map_t   & fmap,
+            forward               & forvard,
+            misc::memory_resource * resource)
         :
-            computation_t(network),
+            computation_t(network, resource),
             m_fmap(fmap),
             m_forward(forvard)
         {}
@@ -304,9 +356,14 @@ class backpropagation {
         /**
          *  \brief  Execute the backward phase
          *
+         *  \tparam Error  Error container type (iterable)
          *  \param  error  Error
          */
-        void operator () (const std::vector<Base_t> & error) {
+        template <class Error>
+        void operator () (const Error & error) {
+            misc::instrument::phase_timer timer(
+                misc::instrument::BACKWARD, this->tally());
+
             this->reset();  // make sure all is clean
 
             // Set output layer delta
@@ -340,40 +397,96 @@ class backpropagation {
         /**
          *  \brief  Constructor
          *
-         *  \param  network  Trained neural network
-         *  \param  fmap     The network forward map
+         *  \param  network   Trained neural network
+         *  \param  fmap      The network forward map
+         *  \param  resource  Memory resource
          */
         comp_slot(
-            const nn_t & network,
-            const forward_map_t & fmap)
+            const nn_t            & network,
+            const forward_map_t   & fmap,
+            misc::memory_resource * resource)
         :
-            fw(network),
-            bw(network, fmap, fw)
+            fw(network, resource),
+            bw(network, fmap, fw, resource)
         {}
 
     };  // end of struct comp_slot
 
-    typedef std::list<comp_slot> slots_t;  /**< Computation slot list */
+    /** Computation slot list */
+    typedef std::list<comp_slot, misc::polymorphic_allocator<comp_slot> >
+        slots_t;
+
+    /** Hard fixation */
+    typedef std::pair<size_t, Base_t> fix_t;
 
     /** Hard fixations list */
-    typedef std::vector<std::pair<size_t, Base_t> > fixes_t;
+    typedef std::vector<fix_t, misc::polymorphic_allocator<fix_t> > fixes_t;
+
+    /** Indices list */
+    typedef std::vector<size_t, misc::polymorphic_allocator<size_t> >
+        indices_t;
+
+    /** Gradient (or other per-dendrite values) */
+    typedef std::vector<Base_t, misc::polymorphic_allocator<Base_t> >
+        grad_t;
+
+    /**
+     *  \brief  Checkpoint (for a training pattern)
+     *
+     *  Forward results of checkpoint neurons and output error.
+     */
+    struct checkpoint_t {
+        /** Allocator (checkpoints are allocator-aware) */
+        typedef misc::polymorphic_allocator<Base_t> allocator_type;
+
+        /** Forward results */
+        typedef std::vector<forward_result,
+            misc::polymorphic_allocator<forward_result> > forward_results_t;
+
+        forward_results_t fw;     /**< Checkpointed forward results */
+        grad_t            error;  /**< Output error                 */
+
+        /** Constructor */
+        checkpoint_t(const allocator_type & alloc): fw(alloc), error(alloc) {}
+
+    };  // end of struct checkpoint_t
+
+    /** Checkpoints */
+    typedef std::vector<checkpoint_t,
+        misc::polymorphic_allocator<checkpoint_t> > checkpoints_t;
+
+    nn_t &                  m_network;    /**< Trained neural network     */
+    misc::memory_resource * m_resource;   /**< Memory resource            */
+    const forward_map_t     m_fmap;       /**< The network forward map    */
+    fixes_t                 m_fixes;      /**< Hard fixations list        */
+    slots_t                 m_slots;      /**< Computation slots          */
+    size_t                  m_ckpt_ival;  /**< Checkpoint interval (0:off)*/
+    indices_t               m_ckpt;       /**< Checkpoint neurons indices */
+    checkpoints_t           m_ckpts;      /**< Checkpoints (per pattern)  */
+    grad_t                  m_grad;       /**< Accumulated gradient       */
+    size_t                  m_dend_cnt;   /**< Dendrite count             */
+    size_t                  m_peak_mem;   /**< Peak activation memory     */
+
+    misc::instrument::tally m_tally;      /**< Instrumentation counters */
+    telemetry::recorder     m_telemetry;  /**< Training telemetry       */
 
-    nn_t &              m_network;    /**< Trained neural network         */
-    const forward_map_t m_fmap;       /**< The neural network forward map */
-    fixes_t             m_fixes;      /**< Hard fixations list            */
-    slots_t             m_slots;      /**< Computation slots              */
+    misc::allreduce<Base_t> * m_allreduce;  /**< Data-parallel ranks sum */
 
     /**
      *  \brief  Create NN forward synapses mapping
      *
      *  See \ref forward_map_t.
      *
-     *  \param  nn  Neural network
+     *  \param  nn        Neural network
+     *  \param  resource  Memory resource
      *
      *  \return NN forward synapses mapping
      */
-    static forward_map_t create_fmap(const nn_t & nn) {
-        forward_map_t fmap(nn.slot_cnt());
+    static forward_map_t create_fmap(
+        const nn_t            & nn,
+        misc::memory_resource * resource)
+    {
+        forward_map_t fmap(nn.slot_cnt(), synapses_t(resource), resource);
 
         nn.for_each_neuron(
         [&fmap](const typename nn_t::neuron & n) {
@@ -381,13 +494,69 @@ class backpropagation {
 
             n.for_each_dendrite(
             [&fmap, n_index](const typename nn_t::neuron::dendrite & dend) {
-                fmap[dend.source.index()].emplace_back(dend, n_index);
+                fmap[dend.source().index()].emplace_back(dend, n_index);
             });
         });
 
         return fmap;
     }
 
+    /**
+     *  \brief  Compute neuron level (recursively)
+     *
+     *  Level is the longest path from a neuron without synapses
+     *  (input layer neurons, bias...).
+     *  Synapses closing a cycle are ignored.
+     *
+     *  \param  n       Neuron
+     *  \param  levels  Neuron levels
+     *  \param  state   Neuron level computation state (0 means not visited,
+     *                  1 means in progress, 2 means done)
+     *
+     *  \return Level of \c n
+     */
+    static size_t level(
+        const typename nn_t::neuron & n,
+        std::vector<size_t>         & levels,
+        std::vector<char>           & state)
+    {
+        const size_t index = n.index();
+
+        if (state[index]) return levels[index];  // done or a cycle
+
+        state[index] = 1;
+
+        size_t n_level = 0;
+        n.for_each_dendrite(
+        [&n_level, &levels, &state](const typename nn_t::neuron::dendrite & dend) {
+            const size_t src_level = level(dend.source(), levels, state) + 1;
+            if (src_level > n_level) n_level = src_level;
+        });
+
+        state[index] = 2;
+
+        return levels[index] = n_level;
+    }
+
+    /**
+     *  \brief  Create neuron levels
+     *
+     *  \param  nn  Neural network
+     *
+     *  \return Levels of neurons (by index)
+     */
+    static std::vector<size_t> create_levels(const nn_t & nn) {
+        std::vector<size_t> levels(nn.slot_cnt(), 0);
+        std::vector<char>   state(nn.slot_cnt(), 0);
+
+        nn.for_each_neuron(
+        [&levels, &state](const typename nn_t::neuron & n) {
+            level(n, levels, state);
+        });
+
+        return levels;
+    }
+
     /**
      *  \brief  Make \c n forward/backward computation slots available
      *
@@ -401,13 +570,13 @@ class backpropagation {
      */
     void assert_slots(size_t n) {
         for (size_t i = m_slots.size(); i < n; ++i) {
-            m_slots.emplace_back(m_network, m_fmap);
+            m_slots.emplace_back(m_network, m_fmap, m_resource);
 
             // Fix activation function values & backward error propagations
             auto & slot = m_slots.back();
 
             std::for_each(m_fixes.begin(), m_fixes.end(),
-            [&slot](const std::pair<size_t, Base_t> & fix) {
+            [&slot](const fix_t & fix) {
                 slot.fw.fix(fix.first, fix.second);
                 slot.bw.fix(fix.first, 0);
             });
@@ -432,11 +601,57 @@ class backpropagation {
         const Input  & input,
         const Output & output,
         comp_slot    & slot)
+    {
+        std::vector<Base_t> error;
+
+        Base_t error_norm2 = compute_error(input, output, slot.fw, error);
+        m_telemetry.phase(misc::instrument::FORWARD);
+
+        // Compute backward stage (delta distribution)
+        slot.bw(error);
+        m_telemetry.phase(misc::instrument::BACKWARD);
+
+        return error_norm2;
+    }
+
+    /** Set error vector (by move) */
+    static void set_error(
+        std::vector<Base_t>  & error,
+        std::vector<Base_t> && output)
+    {
+        error = std::move(output);
+    }
+
+    /** Set error vector (by copy, e.g. to checkpoint) */
+    template <class Error>
+    static void set_error(Error & error, const std::vector<Base_t> & output) {
+        error.assign(output.begin(), output.end());
+    }
+
+    /**
+     *  \brief  Forward phase and error computation
+     *
+     *  \tparam Input   Input container type (iterable)
+     *  \tparam Output  Output container type (iterable)
+     *  \tparam Error   Error vector type
+     *  \param  input   Input
+     *  \param  output  Output (desired)
+     *  \param  fw      Forward phase
+     *  \param  error   Error (actual output minus desired output)
+     *
+     *  \return Error norm squared
+     */
+    template <class Input, class Output, class Error>
+    static Base_t compute_error(
+        const Input  & input,
+        const Output & output,
+        forward      & fw,
+        Error        & error)
     {
         Base_t error_norm2 = 0;
 
         // Compute forward stage (activation func. and its argument)
-        auto error = slot.fw(input);
+        set_error(error, fw(input));
 
         // Compute error (actual output minus desired output)
         if (output.size() != error.size())
@@ -452,12 +667,46 @@ class backpropagation {
             error_norm2 += err * err;
         });
 
-        // Compute backward stage (delta distribution)
-        slot.bw(error);
-
         return error_norm2;
     }
 
+    /**
+     *  \brief  Compute input error
+     *
+     *  Computes error derivative by the network inputs (in the input
+     *  layer order), i.e. sum of weighed deltas of the input neurons
+     *  synapses targets.
+     *  That allows for back-propagation of the error further, to
+     *  a preceding stage (e.g. convolutional layers).
+     *  Must be called before the network update.
+     *
+     *  \param  slot   Computation slot
+     *  \param  error  Input error
+     */
+    void compute_input_error(
+        const comp_slot     & slot,
+        std::vector<Base_t> & error) const
+    {
+        error.clear();
+        error.reserve(m_network.input_size());
+
+        m_network.for_each_input(
+        [&slot, &error, this](const typename nn_t::neuron & n) {
+            Base_t err = 0;
+
+            const auto & fw_neurons = m_fmap[n.index()];
+            std::for_each(fw_neurons.begin(), fw_neurons.end(),
+            [&slot, &err](
+                const std::pair<const typename nn_t::neuron::dendrite &,
+                    size_t> & dend_n)
+            {
+                err += slot.bw.fx(dend_n.second).delta * dend_n.first.weight();
+            });
+
+            error.push_back(err);
+        });
+    }
+
     /**
      *  \brief  Backward error propagation: network update
      *
@@ -471,21 +720,463 @@ class backpropagation {
         const Base_t    & alpha,
         const comp_slot & slot)
     {
+        misc::instrument::phase_timer timer(misc::instrument::UPDATE, m_tally);
+
         m_network.for_each_neuron(
         [&slot, &alpha, this](
             typename nn_t::neuron & n)
         {
             const auto & bw_res = slot.bw.fx(n.index());
 
+            m_tally.add(misc::instrument::MULADDS, n.dendrite_cnt());
+
             n.for_each_dendrite(
             [&slot, &alpha, &bw_res, this](
                 typename nn_t::neuron::dendrite & dend)
             {
-                const auto & fw_res = slot.fw.fx(dend.source.index());
+                const auto & fw_res = slot.fw.fx(dend.source().index());
+
+                dend.weight() -= alpha * bw_res.delta * fw_res.phi_net;
+            });
+        });
+    }
+
+    /**
+     *  \brief  Accumulate gradient
+     *
+     *  Adds gradient computed in \c slot to \c m_grad (dendrite-wise).
+     *  Forward results that are not available (because they weren't
+     *  checkpointed) are re-computed.
+     *
+     *  \param  slot  Computation slot
+     */
+    void accumulate(comp_slot & slot) {
+        misc::instrument::phase_timer timer(misc::instrument::UPDATE, m_tally);
+
+        auto grad = m_grad.begin();
+
+        m_network.for_each_neuron(
+        [&slot, &grad, this](const typename nn_t::neuron & n) {
+            const Base_t delta = slot.bw.fx(n.index()).delta;
+
+            m_tally.add(misc::instrument::MULADDS, n.dendrite_cnt());
+
+            n.for_each_dendrite(
+            [&slot, &grad, delta](const typename nn_t::neuron::dendrite & dend) {
+                *(grad++) += delta * slot.fw.fx(dend.source().index()).phi_net;
+            });
+        });
+    }
+
+    /**
+     *  \brief  Update network by accumulated gradient
+     *
+     *  \param  alpha  Learning factor
+     */
+    void apply(const Base_t & alpha) {
+        misc::instrument::phase_timer timer(misc::instrument::UPDATE, m_tally);
+        m_tally.add(misc::instrument::MULADDS, m_grad.size());
+
+        auto grad = m_grad.cbegin();
+
+        m_network.for_each_neuron(
+        [&alpha, &grad](typename nn_t::neuron & n) {
+            n.for_each_dendrite(
+            [&alpha, &grad](typename nn_t::neuron::dendrite & dend) {
+                dend.weight() -= alpha * *(grad++);
+            });
+        });
+    }
+
+    /**
+     *  \brief  Update peak activation memory
+     */
+    void update_peak_mem() {
+        const size_t mem = activation_memory();
+        if (mem > m_peak_mem) m_peak_mem = mem;
+    }
+
+    /** Dendrite count */
+    size_t dendrite_cnt() const {
+        size_t cnt = 0;
+
+        m_network.for_each_neuron(
+        [&cnt](const typename nn_t::neuron & n) {
+            cnt += n.dendrite_cnt();
+        });
+
+        return cnt;
+    }
+
+    /**
+     *  \brief  Parameters of the synapses
+     *
+     *  Synapses are ordered by the neurons and their dendrites.
+     *  A shared weight is one parameter, placed at its first synapsis.
+     *
+     *  \param  index  Parameter index per synapsis
+     *
+     *  \return Parameter count
+     */
+    size_t param_index(std::vector<size_t> & index) const {
+        std::unordered_map<const Base_t *, size_t> shared;
+
+        index.clear();
+        index.reserve(dendrite_cnt());
+
+        size_t cnt = 0;
+
+        m_network.for_each_neuron(
+        [&index, &shared, &cnt](const typename nn_t::neuron & n) {
+            n.for_each_dendrite(
+            [&index, &shared, &cnt](
+                const typename nn_t::neuron::dendrite & dend)
+            {
+                if (!dend.shared()) {
+                    index.push_back(cnt++);
+                    return;
+                }
+
+                const auto param = shared.emplace(&dend.weight(), cnt);
+                if (param.second) ++cnt;  // first sharer
+
+                index.push_back(param.first->second);
+            });
+        });
+
+        return cnt;
+    }
+
+    /**
+     *  \brief  Error norm squared average (over all ranks)
+     *
+     *  If data-parallel, the error norm squared sum and the sample count
+     *  are summed over all ranks.
+     *
+     *  \param  error_norm2  Error norm squared sum
+     *  \param  set_size     Sample count (the total is set)
+     *
+     *  \return Error norm squared average
+     */
+    Base_t error_avg(Base_t error_norm2, size_t & set_size) {
+        if (m_allreduce) {
+            Base_t sum[2] = { error_norm2, (Base_t)set_size };
+            (*m_allreduce)(sum, 2);
+
+            error_norm2 = sum[0];
+            set_size    = (size_t)(sum[1] + 0.5);
+        }
+
+        return error_norm2 / set_size;
+    }
+
+    /** Weights norm squared */
+    Base_t weight_norm2() const {
+        Base_t norm2 = 0;
+
+        m_network.for_each_neuron(
+        [&norm2](const typename nn_t::neuron & n) {
+            n.for_each_dendrite(
+            [&norm2](const typename nn_t::neuron::dendrite & dend) {
+                norm2 += dend.weight() * dend.weight();
+            });
+        });
+
+        return norm2;
+    }
+
+    /**
+     *  \brief  Report on-line training step (if observed)
+     *
+     *  \param  slot   Computation slot
+     *  \param  error  Error norm squared
+     *  \param  alpha  Learning factor
+     *
+     *  \return \c error
+     */
+    Base_t observed(const comp_slot & slot, Base_t error, Base_t alpha) {
+        if (!m_telemetry.active()) return error;
+
+        Base_t grad_norm2 = 0;
+
+        m_network.for_each_neuron(
+        [&slot, &grad_norm2](const typename nn_t::neuron & n) {
+            const Base_t delta = slot.bw.fx(n.index()).delta;
+
+            n.for_each_dendrite(
+            [&slot, &grad_norm2, delta](
+                const typename nn_t::neuron::dendrite & dend)
+            {
+                const Base_t grad =
+                    delta * slot.fw.fx(dend.source().index()).phi_net;
 
-                dend.weight -= alpha * bw_res.delta * fw_res.phi_net;
+                grad_norm2 += grad * grad;
             });
         });
+
+        m_telemetry.step(1, error, alpha,
+            std::sqrt(grad_norm2), std::sqrt(weight_norm2()));
+
+        return error;
+    }
+
+    /**
+     *  \brief  Report batch training step (if observed)
+     *
+     *  \param  samples     Sample count
+     *  \param  error       Error norm squared average
+     *  \param  alpha       Learning factor
+     *  \param  grad_scale  Accumulated gradient scale (0 if not available)
+     *
+     *  \return \c error
+     */
+    Base_t observed(
+        size_t samples,
+        Base_t error,
+        Base_t alpha,
+        Base_t grad_scale)
+    {
+        if (!m_telemetry.active()) return error;
+
+        Base_t grad_norm2 = 0;
+        if (0 != grad_scale)
+            std::for_each(m_grad.begin(), m_grad.end(),
+            [&grad_norm2](const Base_t & grad) {
+                grad_norm2 += grad * grad;
+            });
+
+        m_telemetry.step(samples, error, alpha,
+            std::sqrt(grad_norm2) * grad_scale, std::sqrt(weight_norm2()));
+
+        return error;
+    }
+
+    /**
+     *  \brief  Checkpointed batch forward stage
+     *
+     *  Only checkpoints (and output errors) are kept per pattern.
+     *
+     *  \tparam TSet  Training set
+     *  \param  set   Training set
+     *
+     *  \return Error norm squared sum
+     */
+    template <class TSet>
+    Base_t checkpointed_forward(const TSet & set) {
+        assert_slots(1);
+        comp_slot & slot = m_slots.front();
+
+        if (m_ckpts.size() < set.size()) m_ckpts.resize(set.size());
+
+        Base_t error_norm2 = 0;
+        auto ckpt = m_ckpts.begin();
+        for (auto iter = set.begin(); iter != set.end(); ++iter, ++ckpt) {
+            error_norm2 += compute_error(
+                iter->first, iter->second, slot.fw, ckpt->error);
+
+            ckpt->fw.resize(m_ckpt.size());
+            for (size_t i = 0; i < m_ckpt.size(); ++i)
+                ckpt->fw[i] = slot.fw.fx(m_ckpt[i]);
+        }
+
+        update_peak_mem();
+
+        return error_norm2;
+    }
+
+    /**
+     *  \brief  Checkpointed batch backward stage
+     *
+     *  Segments are re-computed from the checkpoints; the gradient
+     *  is accumulated in \c m_grad.
+     *
+     *  \param  set_size      Training set size
+     *  \param  input_errors  Input errors (optional)
+     */
+    void checkpointed_backward(
+        size_t                              set_size,
+        std::vector<std::vector<Base_t> > * input_errors)
+    {
+        comp_slot & slot = m_slots.front();
+
+        if (input_errors) input_errors->resize(set_size);
+
+        m_grad.assign(m_dend_cnt, 0);
+
+        auto ckpt = m_ckpts.begin();
+        for (size_t j = 0; j < set_size; ++j, ++ckpt) {
+            slot.fw.reset();
+            for (size_t i = 0; i < m_ckpt.size(); ++i)
+                slot.fw.restore(m_ckpt[i], ckpt->fw[i]);
+
+            slot.bw(ckpt->error);
+
+            if (input_errors) compute_input_error(slot, (*input_errors)[j]);
+
+            accumulate(slot);
+        }
+
+        update_peak_mem();
+    }
+
+    /**
+     *  \brief  Batch forward stage
+     *
+     *  Forward and backward results are kept per pattern (in computation
+     *  slots; there may be more slots than patterns).
+     *
+     *  \tparam TSet  Training set
+     *  \param  set   Training set
+     *
+     *  \return Error norm squared sum
+     */
+    template <class TSet>
+    Base_t batch_forward(const TSet & set) {
+        const size_t set_size = set.size();
+
+        assert_slots(set_size);
+        update_peak_mem();
+
+        Base_t error_norm2 = 0;
+        auto iter = set.begin();
+        auto slot = m_slots.begin();
+        for (size_t j = 0; j < set_size; ++j, ++slot, ++iter)
+            error_norm2 += compute(iter->first, iter->second, *slot);
+
+        return error_norm2;
+    }
+
+    /**
+     *  \brief  Accumulate batch gradient
+     *
+     *  The gradient is accumulated in \c m_grad (see \ref batch_forward).
+     *
+     *  \param  set_size  Training set size
+     */
+    void batch_accumulate(size_t set_size) {
+        m_grad.assign(dendrite_cnt(), 0);
+
+        auto slot = m_slots.begin();
+        for (size_t j = 0; j < set_size; ++j, ++slot)
+            accumulate(*slot);
+    }
+
+    /**
+     *  \brief  Checkpointed batch training
+     *
+     *  See \ref checkpoint and the batch training \c operator().
+     *
+     *  \tparam TSet          Training set
+     *  \tparam Criterion     Update criterion type
+     *  \param  set           Training set
+     *  \param  criterion     Update criterion
+     *  \param  input_errors  Input errors (optional)
+     *
+     *  \return Error norm squared average
+     */
+    template <class TSet, class Criterion>
+    Base_t checkpointed(
+        const TSet                        & set,
+        Criterion                         & criterion,
+        std::vector<std::vector<Base_t> > * input_errors)
+    {
+        const size_t set_size = set.size();
+
+        // Compute batch forward stage, keep checkpoints only
+        size_t total = set_size;
+        const Base_t error_norm2_avg = error_avg(
+            checkpointed_forward(set), total);
+        m_telemetry.phase(misc::instrument::FORWARD);
+
+        // Get learning factor
+        const Base_t alpha = criterion(error_norm2_avg);
+        if (0 == alpha && NULL == input_errors)
+            return observed(set_size, error_norm2_avg, alpha, 0);
+
+        // Compute batch backward stage (segments are re-computed)
+        checkpointed_backward(set_size, input_errors);
+        m_telemetry.phase(misc::instrument::BACKWARD);
+
+        if (0 == alpha)
+            return observed(
+                set_size, error_norm2_avg, alpha, (Base_t)1 / set_size);
+
+        // Sum gradient over the ranks
+        if (m_allreduce) (*m_allreduce)(m_grad.data(), m_grad.size());
+
+        // Update batch
+        apply(alpha / total);
+        m_telemetry.phase(misc::instrument::UPDATE);
+
+        return observed(set_size, error_norm2_avg, alpha, (Base_t)1 / total);
+    }
+
+    /**
+     *  \brief  Batch training
+     *
+     *  See the batch training \c operator().
+     *
+     *  \tparam TSet          Training set
+     *  \tparam Criterion     Update criterion type
+     *  \param  set           Training set
+     *  \param  criterion     Update criterion
+     *  \param  input_errors  Input errors (optional)
+     *
+     *  \return Error norm squared average
+     */
+    template <class TSet, class Criterion>
+    Base_t batch(
+        const TSet                        & set,
+        Criterion                         & criterion,
+        std::vector<std::vector<Base_t> > * input_errors)
+    {
+        m_telemetry.start();
+
+        if (m_ckpt_ival) return checkpointed(set, criterion, input_errors);
+
+        const size_t set_size = set.size();
+
+        // Compute batch
+        size_t total = set_size;
+        const Base_t error_norm2_avg = error_avg(batch_forward(set), total);
+
+        // Get learning factor
+        const Base_t alpha = criterion(error_norm2_avg);
+
+        // Provide input errors
+        if (input_errors) {
+            input_errors->resize(set_size);
+
+            auto slot = m_slots.begin();
+            for (size_t j = 0; j < set_size; ++j, ++slot)
+                compute_input_error(*slot, (*input_errors)[j]);
+
+            m_telemetry.phase(misc::instrument::BACKWARD);
+        }
+
+        if (0 == alpha) return observed(set_size, error_norm2_avg, alpha, 0);
+
+        // Update by accumulated gradient (summed over the ranks if
+        // data-parallel; the gradient norm is reported if observed)
+        if (m_allreduce || m_telemetry.active()) {
+            batch_accumulate(set_size);
+
+            if (m_allreduce) (*m_allreduce)(m_grad.data(), m_grad.size());
+
+            apply(alpha / total);
+            m_telemetry.phase(misc::instrument::UPDATE);
+
+            return observed(
+                set_size, error_norm2_avg, alpha, (Base_t)1 / total);
+        }
+
+        // Update batch
+        const Base_t alpha4sample = alpha / set_size;
+        auto slot = m_slots.begin();
+        for (size_t j = 0; j < set_size; ++j, ++slot)
+            update(alpha4sample, *slot);
+
+        return error_norm2_avg;
     }
 
     public:
@@ -493,11 +1184,28 @@ class backpropagation {
     /**
      *  \brief  Constructor
      *
-     *  \param  nn  Neural network
+     *  The forward map, computation slots, checkpoints and gradient
+     *  are allocated by the \c resource (which must outlive the instance).
+     *
+     *  \param  nn        Neural network
+     *  \param  resource  Memory resource (optional)
      */
-    backpropagation(nn_t & nn):
+    backpropagation(
+        nn_t                  & nn,
+        misc::memory_resource * resource = misc::new_delete_resource())
+    :
         m_network(nn),
-        m_fmap(create_fmap(m_network))
+        m_resource(resource),
+        m_fmap(create_fmap(m_network, m_resource)),
+        m_fixes(m_resource),
+        m_slots(m_resource),
+        m_ckpt_ival(0),
+        m_ckpt(m_resource),
+        m_ckpts(m_resource),
+        m_grad(m_resource),
+        m_dend_cnt(0),
+        m_peak_mem(0),
+        m_allreduce(NULL)
     {}
 
     /**
@@ -510,24 +1218,311 @@ class backpropagation {
      *  NOTE: respective neurons' net values (sums of weighed inputs)
      *  shall be 0 (so it's not logical for them to have any synapses).
      *
-     *  \tparam Fixes  Container type of hard fixations (iterable)
-     *  \param  nn     Neural network
-     *  \param  fixes  Container of hard fixations
+     *  \tparam Fixes     Container type of hard fixations (iterable)
+     *  \param  nn        Neural network
+     *  \param  fixes     Container of hard fixations
+     *  \param  resource  Memory resource (optional)
      */
-    template <typename Fixes>
-    backpropagation(nn_t & nn, const Fixes & fixes):
+    template <typename Fixes, typename = typename std::enable_if<
+        !std::is_convertible<Fixes, misc::memory_resource *>::value>::type>
+    backpropagation(
+        nn_t                  & nn,
+        const Fixes           & fixes,
+        misc::memory_resource * resource = misc::new_delete_resource())
+    :
         m_network(nn),
-        m_fmap(create_fmap(m_network))
+        m_resource(resource),
+        m_fmap(create_fmap(m_network, m_resource)),
+        m_fixes(m_resource),
+        m_slots(m_resource),
+        m_ckpt_ival(0),
+        m_ckpt(m_resource),
+        m_ckpts(m_resource),
+        m_grad(m_resource),
+        m_dend_cnt(0),
+        m_peak_mem(0),
+        m_allreduce(NULL)
     {
         // Set hard fixations
         m_fixes.reserve(fixes.size());
 
         std::for_each(fixes.begin(), fixes.end(),
-        [this](const std::pair<size_t, Base_t> & fix) {
+        [this](const fix_t & fix) {
             m_fixes.push_back(fix);
         });
     }
 
+    /** Checkpoint interval getter (0 means checkpointing is off) */
+    size_t checkpoint() const { return m_ckpt_ival; }
+
+    /**
+     *  \brief  Set checkpointed training mode
+     *
+     *  In checkpointed batch training mode, forward results are only
+     *  kept for neurons on each \c interval-th level (starting with level 0,
+     *  i.e. neurons without synapses, including the input layer).
+     *  All other results are re-computed from the checkpoints during
+     *  the backward phase, one training pattern at a time.
+     *  Gradient is accumulated over the batch and the network is updated
+     *  at once, afterwards.
+     *  That costs one more forward phase computation (at most), but
+     *  the activation memory doesn't grow with batch size and depth
+     *  of the network as fast.
+     *  See \ref activation_memory and \ref peak_activation_memory.
+     *
+     *  Interval of 0 switches the checkpointed mode off.
+     *  Note that the on-line training mode is not affected.
+     *
+     *  \param  interval  Checkpoint interval (levels)
+     */
+    void checkpoint(size_t interval) {
+        m_ckpt_ival = interval;
+
+        m_ckpt.clear();
+        checkpoints_t(m_resource).swap(m_ckpts);
+        grad_t(m_resource).swap(m_grad);
+        m_dend_cnt = 0;
+
+        if (0 == m_ckpt_ival) return;
+
+        // Computation slots are not kept per pattern any more
+        if (m_slots.size() > 1)
+            m_slots.erase(++m_slots.begin(), m_slots.end());
+
+        // Select checkpoint neurons (hard-fixed ones are constant anyway)
+        const auto levels = create_levels(m_network);
+
+        m_network.for_each_neuron(
+        [&levels, this](const typename nn_t::neuron & n) {
+            m_dend_cnt += n.dendrite_cnt();
+
+            if (levels[n.index()] % m_ckpt_ival) return;
+
+            const size_t index = n.index();
+            if (std::any_of(m_fixes.begin(), m_fixes.end(),
+                [index](const fix_t & fix) {
+                    return fix.first == index;
+                }))
+            {
+                return;
+            }
+
+            m_ckpt.push_back(index);
+        });
+    }
+
+    /** All-reduce getter (\c NULL means no data parallelism) */
+    misc::allreduce<Base_t> * allreduce() const { return m_allreduce; }
+
+    /**
+     *  \brief  Set data-parallel batch training
+     *
+     *  Several instances (ranks; typically processes training replicas
+     *  of the same network) may train on parts (shards) of a batch.
+     *  Their error norm squared sums, sample counts and gradients
+     *  are summed by the \c allreduce, so that the \c criterion gets
+     *  the error average of the whole batch and all the replicas are
+     *  updated the same way (as if trained on the whole batch).
+     *  All the ranks must therefore run the batch training at the same
+     *  time (with the same criterion).
+     *  See \ref data_parallel.
+     *  Note that the on-line training mode is not affected.
+     *
+     *  \param  allreduce  All-reduce (or \c NULL)
+     */
+    void allreduce(misc::allreduce<Base_t> * allreduce) {
+        m_allreduce = allreduce;
+    }
+
+    /** Training observer (or \c NULL) */
+    telemetry::observer * observer() const { return m_telemetry.get(); }
+
+    /**
+     *  \brief  Set training observer
+     *
+     *  The observer receives an event per training step (and per epoch,
+     *  see \ref epoch); see \c telemetry::event.
+     *  Note that the events cost an extra pass over the synapses
+     *  per step (gradient and weights norms) and that observed batch
+     *  training updates the network by accumulated gradient.
+     *
+     *  \param  obs  Observer (or \c NULL)
+     */
+    void observer(telemetry::observer * obs) { m_telemetry.set(obs); }
+
+    /**
+     *  \brief  End epoch
+     *
+     *  The observer receives the epoch event (aggregating the steps
+     *  since the previous epoch end).
+     */
+    void epoch() { m_telemetry.epoch(); }
+
+    /**
+     *  \brief  Synapses weights
+     *
+     *  The weights are ordered by the neurons and their dendrites
+     *  (the same way as the \ref gradient).
+     *  Shared weight is only listed once (at its first synapsis).
+     *
+     *  \param  weights  Weights
+     */
+    void get_weights(std::vector<Base_t> & weights) const {
+        std::vector<size_t> index;
+        weights.resize(param_index(index));
+
+        auto param = index.cbegin();
+
+        m_network.for_each_neuron(
+        [&weights, &param](const typename nn_t::neuron & n) {
+            n.for_each_dendrite(
+            [&weights, &param](const typename nn_t::neuron::dendrite & dend) {
+                weights[*(param++)] = dend.weight();
+            });
+        });
+    }
+
+    /**
+     *  \brief  Set synapses weights
+     *
+     *  See \ref get_weights.
+     *
+     *  \param  weights  Weights
+     */
+    void set_weights(const std::vector<Base_t> & weights) {
+        std::vector<size_t> index;
+        if (weights.size() != param_index(index))
+            throw std::logic_error(
+                "libnn::ml::backpropagation: "
+                "invalid weights count");
+
+        auto param = index.cbegin();
+
+        m_network.for_each_neuron(
+        [&weights, &param](typename nn_t::neuron & n) {
+            n.for_each_dendrite(
+            [&weights, &param](typename nn_t::neuron::dendrite & dend) {
+                dend.weight() = weights[*(param++)];
+            });
+        });
+    }
+
+    /**
+     *  \brief  Compute batch gradient
+     *
+     *  Computes gradient of the error (by the synapses weights, see
+     *  \ref get_weights) averaged over a training set, without updating
+     *  the network.
+     *  Shared weight gradient is the sum over its synapses.
+     *  Batch training with learning factor \c alpha is equivalent
+     *  to subtracting \c alpha multiple of the gradient from the weights.
+     *  That allows for the update to be done elsewhere (e.g. by
+     *  a parameter server, see \ref ps_worker).
+     *  The all-reduce (see \ref allreduce) isn't used.
+     *
+     *  \tparam TSet  Training set (see the batch mode \c operator())
+     *  \param  set   Training set
+     *  \param  grad  Gradient
+     *
+     *  \return Error norm squared average
+     */
+    template <class TSet>
+    Base_t gradient(const TSet & set, std::vector<Base_t> & grad) {
+        const size_t set_size = set.size();
+
+        if (0 == set_size)
+            throw std::logic_error(
+                "libnn::ml::backpropagation: "
+                "empty training set");
+
+        Base_t error_norm2_avg;
+        if (m_ckpt_ival) {
+            error_norm2_avg = checkpointed_forward(set);
+            checkpointed_backward(set_size, NULL);
+        }
+        else {
+            error_norm2_avg = batch_forward(set);
+            batch_accumulate(set_size);
+        }
+
+        error_norm2_avg /= set_size;
+
+        std::vector<size_t> index;
+        grad.assign(param_index(index), 0);
+
+        for (size_t i = 0; i < index.size(); ++i)
+            grad[index[i]] += m_grad[i] / set_size;
+
+        return error_norm2_avg;
+    }
+
+    /**
+     *  \brief  Memory usage (bytes)
+     *
+     *  Forward map, result slots (computation slots and checkpoints)
+     *  and optimiser state (accumulated gradient and hard fixations).
+     *  The trained network memory is not included (see
+     *  \ref topo::nn::memory_usage).
+     */
+    misc::memory_usage memory_usage() const {
+        misc::memory_usage usage;
+
+        usage.fmap = misc::heap_size(m_fmap);
+        std::for_each(m_fmap.begin(), m_fmap.end(),
+        [&usage](const typename forward_map_t::value_type & synapses) {
+            usage.fmap += misc::heap_size(synapses);
+        });
+
+        usage.results = misc::heap_size(m_slots);
+        std::for_each(m_slots.begin(), m_slots.end(),
+        [&usage](const comp_slot & slot) {
+            usage += slot.fw.memory_usage();
+            usage += slot.bw.memory_usage();
+        });
+
+        usage.results += misc::heap_size(m_ckpt) + misc::heap_size(m_ckpts);
+        std::for_each(m_ckpts.begin(), m_ckpts.end(),
+        [&usage](const checkpoint_t & ckpt) {
+            usage.results += misc::heap_size(ckpt.fw);
+            usage.results += misc::heap_size(ckpt.error);
+        });
+
+        usage.optimiser = misc::heap_size(m_grad) + misc::heap_size(m_fixes);
+
+        return usage;
+    }
+
+    /**
+     *  \brief  Activation memory (bytes)
+     *
+     *  Memory currently used for storage of forward and backward phase
+     *  results (computation slots), checkpoints and accumulated gradient.
+     */
+    size_t activation_memory() const {
+        const size_t slot_mem = m_network.slot_cnt() * (
+            sizeof(misc::fixable<forward_result>) +
+            sizeof(misc::fixable<backward_result>));
+
+        size_t mem = m_slots.size() * slot_mem;
+
+        std::for_each(m_ckpts.begin(), m_ckpts.end(),
+        [&mem](const checkpoint_t & ckpt) {
+            mem += ckpt.fw.capacity()    * sizeof(forward_result);
+            mem += ckpt.error.capacity() * sizeof(Base_t);
+        });
+
+        mem += m_grad.capacity() * sizeof(Base_t);
+
+        return mem;
+    }
+
+    /**
+     *  \brief  Peak activation memory (bytes)
+     *
+     *  Maximum of \ref activation_memory observed during training.
+     */
+    size_t peak_activation_memory() const { return m_peak_mem; }
+
     /**
      *  \brief  Run backpropagation on a single input/output pair
      *
@@ -557,12 +1552,54 @@ class backpropagation {
         Criterion    & criterion)
     {
         assert_slots(1);
+        update_peak_mem();
+        m_telemetry.start();
 
         Base_t error_norm2 = compute(input, output, m_slots.front());
         const Base_t alpha = criterion(error_norm2);
         if (0 != alpha) update(alpha, m_slots.front());
+        m_telemetry.phase(misc::instrument::UPDATE);
 
-        return error_norm2;
+        return observed(m_slots.front(), error_norm2, alpha);
+    }
+
+    /**
+     *  \brief  Run backpropagation on a single pair, provide input error
+     *
+     *  Same as the on-line training mode, but also provides error
+     *  derivative by the network inputs (computed before the update).
+     *  See the batch mode overload providing input errors.
+     *
+     *  \tparam Input        Input container type (iterable)
+     *  \tparam Output       Output container type (iterable)
+     *  \tparam Criterion    Update criterion type
+     *  \param  input        Input
+     *  \param  output       Output (desired)
+     *  \param  criterion    Update criterion
+     *  \param  input_error  Input error
+     *
+     *  \return Error norm squared
+     */
+    template <class Input, class Output, class Criterion>
+    Base_t operator () (
+        const Input         & input,
+        const Output        & output,
+        Criterion           & criterion,
+        std::vector<Base_t> & input_error)
+    {
+        assert_slots(1);
+        update_peak_mem();
+        m_telemetry.start();
+
+        Base_t error_norm2 = compute(input, output, m_slots.front());
+        compute_input_error(m_slots.front(), input_error);
+        m_telemetry.phase(misc::instrument::BACKWARD);
+
+        const Base_t alpha = criterion(error_norm2);
+        if (0 != alpha) update(alpha, m_slots.front());
+        m_telemetry.phase(misc::instrument::UPDATE);
+
+        return observed(m_slots.front(), error_norm2, alpha);
     }
 
     /**
@@ -576,6 +1613,8 @@ class backpropagation {
      *  Just note that the criterion takes average of the samples error
      *  norms squared and its return value is divided by the set size
      *  before it's applied as the learning factor per each sample.
+     *  If checkpointed mode is set, memory is saved at the cost
+     *  of re-computation (see \ref checkpoint).
      *
      *  \tparam TSet       Training set (iterable container of
      *                     \c std::pair containing [input, output] samples)
@@ -590,29 +1629,35 @@ class backpropagation {
         const TSet   & set,
         Criterion    & criterion)
     {
-        size_t set_size = set.size();
-
-        assert_slots(set_size);
-
-        // Compute batch
-        Base_t error_norm2_avg = 0;
-        auto iter = set.begin();
-        for (auto slot = m_slots.begin(); slot != m_slots.end(); ++slot, ++iter)
-            error_norm2_avg += compute(iter->first, iter->second, *slot);
-
-        error_norm2_avg /= set_size;
-
-        // Get learning factor
-        const Base_t alpha = criterion(error_norm2_avg);
-
-        // Update batch
-        if (0 != alpha) {
-            const Base_t alpha4sample = alpha / set_size;
-            for (auto slot = m_slots.begin(); slot != m_slots.end(); ++slot)
-                update(alpha4sample, *slot);
-        }
+        return batch(set, criterion, NULL);
+    }
 
-        return error_norm2_avg;
+    /**
+     *  \brief  Run backpropagation on a training set, provide input errors
+     *
+     *  Same as the batch training mode, but also provides error
+     *  derivatives by the network inputs for each training sample
+     *  (computed before the update).
+     *  That allows for further back-propagation of the error to preceding
+     *  stages (e.g. convolutional layers).
+     *  Note that the input errors are provided even if the criterion
+     *  returns 0 learning factor.
+     *
+     *  \tparam TSet          Training set (see the batch mode overload)
+     *  \tparam Criterion     Update criterion type
+     *  \param  set           Training set
+     *  \param  criterion     Update criterion
+     *  \param  input_errors  Input errors (per training sample)
+     *
+     *  \return Error norm squared average
+     */
+    template <class TSet, class Criterion>
+    Base_t operator () (
+        const TSet                        & set,
+        Criterion                         & criterion,
+        std::vector<std::vector<Base_t> > & input_errors)
+    {
+        return batch(set, criterion, &input_errors);
     }
 
 };  // end of template class backpropagation
@@ -788,4 +1833,20 @@ class adaptive_learning_factor {
 
 }}  // end of namespace libnn::ml
 
+// Explicit instantiations (see libnn/instances.hxx)
+#ifndef LIBNN_HEADER_ONLY
+/** \cond */
+namespace libnn {
+namespace ml {
+
+#define LIBNN_EXTERN(Base_t, Act_fn) \
+    extern template class backpropagation<Base_t, Act_fn>;
+LIBNN_INSTANCES(LIBNN_EXTERN)
+
+#undef LIBNN_EXTERN
+
+}}  // end of namespace libnn::ml
+/** \endcond */
+#endif  // end of #ifndef LIBNN_HEADER_ONLY
+
 #endif  // end of #ifndef libnn__ml__backpropagation_hxx
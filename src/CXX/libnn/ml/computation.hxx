@@ -41,6 +41,9 @@
  */
 
 #include "libnn/topo/nn.hxx"
+#include "libnn/misc/instrument.hxx"
+#include "libnn/misc/memory_usage.hxx"
+#include "libnn/misc/memory_resource.hxx"
 
 #include <vector>
 #include <algorithm>
@@ -74,14 +77,19 @@ class computation {
     typedef misc::fixable<Fx> fx_t;
 
     /** Neuron function values */
-    typedef std::vector<fx_t> results_t;
+    typedef std::vector<fx_t, misc::polymorphic_allocator<fx_t> > results_t;
 
     const nn_t & m_network;  /**< Neural network             */
     results_t    m_results;  /**< Function results           */
     bool         m_reset;    /**< Function results are reset */
 
+    misc::instrument::tally m_tally;  /**< Instrumentation counters */
+
     protected:
 
+    /** Instrumentation counters (see libnn/misc/instrument.hxx) */
+    misc::instrument::tally & tally() { return m_tally; }
+
     /** Check if neuron index is within bounds */
     void check_index(size_t index) const {
         if (!(index < m_results.size()))
@@ -148,17 +156,38 @@ class computation {
     /**
      *  \brief  Constructor
      *
-     *  \param  network  Neural network
+     *  The function results are allocated by the \c resource (which must
+     *  outlive the computation).
+     *  Note that it doesn't default to the network resource; computations
+     *  are typically shorter-lived than the network.
+     *
+     *  \param  network   Neural network
+     *  \param  resource  Memory resource (optional)
      */
-    computation(const nn_t & network):
+    computation(
+        const nn_t            & network,
+        misc::memory_resource * resource = misc::new_delete_resource())
+    :
         m_network(network),
-        m_results(m_network.slot_cnt()),
+        m_results(m_network.slot_cnt(), fx_t(), resource),
         m_reset(true)
     {}
 
     /** Network getter */
     const nn_t & network() const { return m_network; }
 
+    /**
+     *  \brief  Memory usage (bytes)
+     *
+     *  Function results (per neuron slot).
+     */
+    misc::memory_usage memory_usage() const {
+        misc::memory_usage usage;
+        usage.results = misc::heap_size(m_results);
+
+        return usage;
+    }
+
     /**
      *  \brief  Reset functions return values
      *
@@ -174,6 +203,7 @@ class computation {
         });
 
         m_reset = true;
+        m_tally.add(misc::instrument::RESETS);
     }
 
     /**
@@ -225,6 +255,8 @@ class computation {
 
         const typename nn_t::neuron & n = m_network.get_neuron(index);
 
+        m_tally.add(misc::instrument::NEURON_EVALS);
+
         return value.set(f(n), true);  // override early fixation
     }
 
@@ -232,7 +264,8 @@ class computation {
     computation(computation && orig):
         m_network ( orig.m_network            ),
         m_results ( std::move(orig.m_results) ),
-        m_reset   ( orig.m_reset              )
+        m_reset   ( orig.m_reset              ),
+        m_tally   ( orig.m_tally              )
     {}
 
     private:
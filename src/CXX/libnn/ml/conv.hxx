@@ -0,0 +1,776 @@
+#ifndef libnn__ml__conv_hxx
+#define libnn__ml__conv_hxx
+
+/**
+ *  Convolutional neural network evaluation and training
+ *
+ *  Convolution is computed as matrix product of the kernels and
+ *  unfolded input (im2col), see
+ *  https://en.wikipedia.org/wiki/Convolutional_neural_network
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libnn/topo/nn.hxx"
+#include "libnn/topo/conv.hxx"
+#include "libnn/ml/nn_func.hxx"
+#include "libnn/ml/backpropagation.hxx"
+#include "libnn/math/blas.hxx"
+
+#include <vector>
+#include <utility>
+#include <stdexcept>
+#include <algorithm>
+#include <cassert>
+
+
+namespace libnn {
+namespace ml {
+
+namespace impl {
+
+/**
+ *  \brief  Convolution input unfolding (im2col)
+ *
+ *  Unfolds kernel windows of \c in to columns of matrix \c col
+ *  (of kernel size rows and output plane size columns), so that
+ *  the convolution may be computed as matrix product of the kernels
+ *  and \c col.
+ *  Padding is filled with zeros.
+ *
+ *  \param  layer  Convolution layer
+ *  \param  in     Input
+ *  \param  col    Unfolded input
+ */
+template <typename Base_t, class Act_fn>
+void im2col(
+    const topo::conv_layer<Base_t, Act_fn> & layer,
+    const Base_t                           * in,
+    Base_t                                 * col)
+{
+    const auto & is = layer.input();
+    const auto & os = layer.output();
+
+    for (size_t c = 0; c < is.channels; ++c)
+    for (size_t ky = 0; ky < layer.kernel_h(); ++ky)
+    for (size_t kx = 0; kx < layer.kernel_w(); ++kx) {
+        for (size_t oy = 0; oy < os.height; ++oy) {
+            const size_t y = oy * layer.stride_h() + ky;  // padded
+
+            if (y < layer.pad_h() || !(y - layer.pad_h() < is.height)) {
+                std::fill(col, col + os.width, Base_t(0));
+                col += os.width;
+                continue;
+            }
+
+            const Base_t * in_row =
+                in + (c * is.height + y - layer.pad_h()) * is.width;
+
+            for (size_t ox = 0; ox < os.width; ++ox) {
+                const size_t x = ox * layer.stride_w() + kx;  // padded
+
+                *(col++) = x < layer.pad_w() || !(x - layer.pad_w() < is.width)
+                    ? Base_t(0)
+                    : in_row[x - layer.pad_w()];
+            }
+        }
+    }
+}
+
+
+/**
+ *  \brief  Convolution input folding (col2im)
+ *
+ *  Inverse operation to \ref im2col; values of \c col are summed
+ *  to the respective elements of \c in (padding is dropped).
+ *
+ *  \param  layer  Convolution layer
+ *  \param  col    Unfolded input
+ *  \param  in     Input (shall be zeroed)
+ */
+template <typename Base_t, class Act_fn>
+void col2im(
+    const topo::conv_layer<Base_t, Act_fn> & layer,
+    const Base_t                           * col,
+    Base_t                                 * in)
+{
+    const auto & is = layer.input();
+    const auto & os = layer.output();
+
+    for (size_t c = 0; c < is.channels; ++c)
+    for (size_t ky = 0; ky < layer.kernel_h(); ++ky)
+    for (size_t kx = 0; kx < layer.kernel_w(); ++kx) {
+        for (size_t oy = 0; oy < os.height; ++oy) {
+            const size_t y = oy * layer.stride_h() + ky;  // padded
+
+            if (y < layer.pad_h() || !(y - layer.pad_h() < is.height)) {
+                col += os.width;
+                continue;
+            }
+
+            Base_t * in_row =
+                in + (c * is.height + y - layer.pad_h()) * is.width;
+
+            for (size_t ox = 0; ox < os.width; ++ox, ++col) {
+                const size_t x = ox * layer.stride_w() + kx;  // padded
+
+                if (x < layer.pad_w() || !(x - layer.pad_w() < is.width))
+                    continue;
+
+                in_row[x - layer.pad_w()] += *col;
+            }
+        }
+    }
+}
+
+
+/**
+ *  \brief  Check whether the convolution needs input unfolding
+ *
+ *  1x1 convolution with unit stride and no padding doesn't; the input
+ *  itself is the unfolded matrix.
+ *
+ *  \param  layer  Convolution layer
+ *
+ *  \return \c true iff \ref im2col is required
+ */
+template <typename Base_t, class Act_fn>
+bool unfold(const topo::conv_layer<Base_t, Act_fn> & layer) {
+    return !(
+        1 == layer.kernel_h() && 1 == layer.kernel_w() &&
+        1 == layer.stride_h() && 1 == layer.stride_w() &&
+        0 == layer.pad_h()    && 0 == layer.pad_w());
+}
+
+
+/**
+ *  \brief  Convolutional layers stack evaluation
+ *
+ *  Keeps (pre-allocated) intermediate results of the layers so that
+ *  the evaluation and backward error propagation don't allocate memory.
+ *  Note that layer changes (other than weight updates) invalidate
+ *  the stack.
+ *
+ *  \tparam  Base_t  Base numeric type
+ *  \tparam  Act_fn  Activation function
+ */
+template <typename Base_t, class Act_fn>
+class conv_stack {
+    public:
+
+    typedef topo::conv_layer<Base_t, Act_fn> layer_t;   /**< Layer  */
+    typedef std::vector<layer_t>             layers_t;  /**< Layers */
+
+    private:
+
+    typedef std::vector<Base_t> data_t;  /**< Data */
+
+    const layers_t &                  m_layers;  /**< Layers                 */
+    std::vector<data_t>               m_act;     /**< Layers inputs, output  */
+    std::vector<data_t>               m_net;     /**< Convolution results    */
+    std::vector<std::vector<size_t> > m_argmax;  /**< Max pooling sources    */
+    data_t                            m_col;     /**< Unfolded input         */
+    data_t                            m_delta;   /**< Output error (current) */
+    data_t                            m_delta_in;  /**< Input error          */
+
+    /**
+     *  \brief  Evaluate convolution layer
+     *
+     *  \param  l  Layer index
+     */
+    void conv_forward(size_t l) {
+        const layer_t & layer = m_layers[l];
+
+        const size_t filters = layer.output().channels;
+        const size_t plane   = layer.output().plane();
+        const size_t ksize   = layer.kernel_size();
+
+        const Base_t * col = m_act[l].data();
+        if (unfold(layer)) {
+            im2col(layer, m_act[l].data(), m_col.data());
+            col = m_col.data();
+        }
+
+        Base_t * net = m_net[l].data();
+
+        // net = W col + b
+        for (size_t f = 0; f < filters; ++f)
+            std::fill(net + f * plane, net + (f + 1) * plane, layer.bias()[f]);
+
+        math::blas::gemm(math::NO_TRANS, math::NO_TRANS,
+            filters, plane, ksize,
+            Base_t(1), layer.weights().data(), ksize,
+            col, plane,
+            Base_t(1), net, plane);
+
+        // Activation
+        Base_t * out = m_act[l + 1].data();
+        const Act_fn & act_fn = layer.act_fn();
+
+        for (size_t i = 0; i < filters * plane; ++i)
+            out[i] = act_fn(net[i]);
+    }
+
+    /**
+     *  \brief  Evaluate pooling layer
+     *
+     *  \param  l  Layer index
+     */
+    void pool_forward(size_t l) {
+        const layer_t & layer = m_layers[l];
+
+        const auto & is = layer.input();
+        const auto & os = layer.output();
+
+        const bool   is_max = layer_t::MAX_POOL == layer.type();
+        const Base_t norm   = 1 / (Base_t)(layer.kernel_h() * layer.kernel_w());
+        const Base_t * in   = m_act[l].data();
+        Base_t       * out  = m_act[l + 1].data();
+        size_t       * src  = m_argmax[l].data();
+
+        for (size_t c = 0; c < os.channels; ++c)
+        for (size_t oy = 0; oy < os.height; ++oy)
+        for (size_t ox = 0; ox < os.width; ++ox, ++out) {
+            const size_t y0 = oy * layer.stride_h();
+            const size_t x0 = ox * layer.stride_w();
+
+            size_t best = (c * is.height + y0) * is.width + x0;
+            Base_t sum  = 0;
+
+            for (size_t ky = 0; ky < layer.kernel_h(); ++ky)
+            for (size_t kx = 0; kx < layer.kernel_w(); ++kx) {
+                const size_t i = (c * is.height + y0 + ky) * is.width + x0 + kx;
+
+                if (in[i] > in[best]) best = i;
+                sum += in[i];
+            }
+
+            if (is_max) {
+                *out = in[best];
+                *(src++) = best;
+            }
+            else
+                *out = sum * norm;
+        }
+    }
+
+    /**
+     *  \brief  Propagate error through convolution layer
+     *
+     *  \param  l       Layer index
+     *  \param  grad_w  Kernel weights gradient (accumulated)
+     *  \param  grad_b  Bias gradient (accumulated)
+     *  \param  input   Propagate error to the layer input
+     */
+    void conv_backward(size_t l, data_t & grad_w, data_t & grad_b, bool input) {
+        const layer_t & layer = m_layers[l];
+
+        const size_t filters = layer.output().channels;
+        const size_t plane   = layer.output().plane();
+        const size_t ksize   = layer.kernel_size();
+
+        // delta = error * act_fn'(net)
+        const Base_t * net    = m_net[l].data();
+        const Act_fn & act_fn = layer.act_fn();
+
+        for (size_t i = 0; i < filters * plane; ++i)
+            m_delta[i] *= act_fn.d(net[i]);
+
+        const Base_t * col = m_act[l].data();
+        if (unfold(layer)) {
+            im2col(layer, m_act[l].data(), m_col.data());
+            col = m_col.data();
+        }
+
+        // grad_w += delta col^T, grad_b += sum(delta)
+        math::blas::gemm(math::NO_TRANS, math::TRANS,
+            filters, ksize, plane,
+            Base_t(1), m_delta.data(), plane,
+            col, plane,
+            Base_t(1), grad_w.data(), ksize);
+
+        for (size_t f = 0; f < filters; ++f) {
+            const Base_t * delta = m_delta.data() + f * plane;
+
+            for (size_t p = 0; p < plane; ++p) grad_b[f] += delta[p];
+        }
+
+        if (!input) return;
+
+        // input error = col2im(W^T delta)
+        const size_t in_size = layer.input().size();
+
+        if (unfold(layer)) {
+            math::blas::gemm(math::TRANS, math::NO_TRANS,
+                ksize, plane, filters,
+                Base_t(1), layer.weights().data(), ksize,
+                m_delta.data(), plane,
+                Base_t(0), m_col.data(), plane);
+
+            std::fill(m_delta_in.begin(), m_delta_in.begin() + in_size,
+                Base_t(0));
+
+            col2im(layer, m_col.data(), m_delta_in.data());
+        }
+        else {
+            math::blas::gemm(math::TRANS, math::NO_TRANS,
+                ksize, plane, filters,
+                Base_t(1), layer.weights().data(), ksize,
+                m_delta.data(), plane,
+                Base_t(0), m_delta_in.data(), plane);
+        }
+    }
+
+    /**
+     *  \brief  Propagate error through pooling layer
+     *
+     *  \param  l  Layer index
+     */
+    void pool_backward(size_t l) {
+        const layer_t & layer = m_layers[l];
+
+        const auto & is = layer.input();
+        const auto & os = layer.output();
+
+        std::fill(m_delta_in.begin(), m_delta_in.begin() + is.size(),
+            Base_t(0));
+
+        if (layer_t::MAX_POOL == layer.type()) {
+            const size_t * src = m_argmax[l].data();
+
+            for (size_t i = 0; i < os.size(); ++i)
+                m_delta_in[src[i]] += m_delta[i];
+
+            return;
+        }
+
+        const Base_t norm = 1 / (Base_t)(layer.kernel_h() * layer.kernel_w());
+        const Base_t * delta = m_delta.data();
+
+        for (size_t c = 0; c < os.channels; ++c)
+        for (size_t oy = 0; oy < os.height; ++oy)
+        for (size_t ox = 0; ox < os.width; ++ox, ++delta) {
+            const size_t y0 = oy * layer.stride_h();
+            const size_t x0 = ox * layer.stride_w();
+            const Base_t d  = *delta * norm;
+
+            for (size_t ky = 0; ky < layer.kernel_h(); ++ky)
+            for (size_t kx = 0; kx < layer.kernel_w(); ++kx)
+                m_delta_in[(c * is.height + y0 + ky) * is.width + x0 + kx] += d;
+        }
+    }
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  layers  Layers
+     */
+    conv_stack(const layers_t & layers):
+        m_layers(layers),
+        m_act(layers.size() + 1),
+        m_net(layers.size()),
+        m_argmax(layers.size())
+    {
+        if (m_layers.empty())
+            throw std::logic_error(
+                "libnn::ml::conv_stack: no layers");
+
+        size_t col_size = 0, max_size = 0;
+
+        m_act[0].resize(m_layers.front().input().size());
+
+        for (size_t l = 0; l < m_layers.size(); ++l) {
+            const layer_t & layer = m_layers[l];
+
+            if (0 < l && !(layer.input() == m_layers[l - 1].output()))
+                throw std::logic_error(
+                    "libnn::ml::conv_stack: "
+                    "layer input doesn't match previous layer output");
+
+            const size_t out_size = layer.output().size();
+
+            m_act[l + 1].resize(out_size);
+
+            if (layer_t::CONV == layer.type()) {
+                m_net[l].resize(out_size);
+
+                if (unfold(layer))
+                    col_size = std::max(col_size,
+                        layer.kernel_size() * layer.output().plane());
+            }
+            else if (layer_t::MAX_POOL == layer.type())
+                m_argmax[l].resize(out_size);
+
+            max_size = std::max(max_size, layer.input().size());
+            max_size = std::max(max_size, out_size);
+        }
+
+        m_col.resize(col_size);
+        m_delta.resize(max_size);
+        m_delta_in.resize(max_size);
+    }
+
+    /** Layers getter */
+    const layers_t & layers() const { return m_layers; }
+
+    /** Input size */
+    size_t input_size() const { return m_act.front().size(); }
+
+    /** Output size */
+    size_t output_size() const { return m_act.back().size(); }
+
+    /** Output (of the last evaluation) */
+    const std::vector<Base_t> & output() const { return m_act.back(); }
+
+    /**
+     *  \brief  Evaluate the layers
+     *
+     *  \tparam Input  Input container type (iterable)
+     *  \param  input  Input
+     *
+     *  \return Output
+     */
+    template <class Input>
+    const std::vector<Base_t> & operator () (const Input & input) {
+        if (input.size() != input_size())
+            throw std::logic_error(
+                "libnn::ml::conv_stack: invalid input size");
+
+        std::copy(input.begin(), input.end(), m_act.front().begin());
+
+        for (size_t l = 0; l < m_layers.size(); ++l) {
+            if (layer_t::CONV == m_layers[l].type())
+                conv_forward(l);
+            else
+                pool_forward(l);
+        }
+
+        return output();
+    }
+
+    /**
+     *  \brief  Propagate error back through the layers
+     *
+     *  Uses results of the last evaluation.
+     *  Gradients of the convolution layers kernels and biases are added
+     *  to \c grad_w and \c grad_b (per layer, sized as the layer
+     *  parameters).
+     *
+     *  \param  error   Output error
+     *  \param  grad_w  Kernel weights gradients (accumulated)
+     *  \param  grad_b  Bias gradients (accumulated)
+     */
+    void backward(
+        const std::vector<Base_t> & error,
+        std::vector<data_t>       & grad_w,
+        std::vector<data_t>       & grad_b)
+    {
+        assert(error.size() == output_size());
+
+        std::copy(error.begin(), error.end(), m_delta.begin());
+
+        for (size_t l = m_layers.size(); l-- > 0; ) {
+            if (layer_t::CONV == m_layers[l].type())
+                conv_backward(l, grad_w[l], grad_b[l], 0 < l);
+            else
+                pool_backward(l);
+
+            m_delta.swap(m_delta_in);
+        }
+    }
+
+};  // end of template class conv_stack
+
+}  // end of namespace impl
+
+
+/**
+ *  \brief  Convolutional network function
+ *
+ *  Evaluates stack of convolutional/pooling layers and passes its output
+ *  as input to a (dense) neural network.
+ *
+ *  \tparam  Base_t  Base numeric type
+ *  \tparam  Act_fn  Activation function
+ */
+template <typename Base_t, class Act_fn>
+class conv_func: public nn_func<Base_t, Act_fn> {
+    public:
+
+    /** Layers type */
+    typedef typename impl::conv_stack<Base_t, Act_fn>::layers_t layers_t;
+
+    private:
+
+    /** Dense network type */
+    typedef topo::nn<Base_t, Act_fn> nn_t;
+
+    impl::conv_stack<Base_t, Act_fn> m_stack;  /**< Layers evaluation */
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \tparam Fixes   Container type of hard fixations (iterable)
+     *  \param  layers  Convolutional/pooling layers
+     *  \param  dense   Dense network
+     *  \param  fixes   Dense network hard fixations (bias...)
+     */
+    template <typename Fixes>
+    conv_func(const layers_t & layers, const nn_t & dense, const Fixes & fixes):
+        nn_func<Base_t, Act_fn>(dense),
+        m_stack(layers)
+    {
+        if (m_stack.output_size() != dense.input_size())
+            throw std::logic_error(
+                "libnn::ml::conv_func: "
+                "dense network input doesn't match the layers output");
+
+        std::for_each(fixes.begin(), fixes.end(),
+        [this](const std::pair<size_t, Base_t> & fix) {
+            this->const_fx(fix.first, fix.second);
+        });
+    }
+
+    /**
+     *  \brief  Compute network function
+     *
+     *  \tparam Input  Input container type (iterable)
+     *  \param  input  Input
+     *
+     *  \return Output vector
+     */
+    template <class Input>
+    std::vector<Base_t> operator () (const Input & input) {
+        return nn_func<Base_t, Act_fn>::operator () (m_stack(input));
+    }
+
+};  // end of template class conv_func
+
+
+/**
+ *  \brief  Convolutional network backpropagation
+ *
+ *  The dense network is trained by \ref backpropagation; its input
+ *  error is propagated further through the convolutional/pooling layers.
+ *  Kernel weights and biases are updated by the same learning factor.
+ *
+ *  In batch mode, the layers are re-evaluated for each training sample
+ *  in the backward phase (so that their intermediate results needn't
+ *  be kept per sample).
+ *
+ *  \tparam  Base_t  Base numeric type
+ *  \tparam  Act_fn  Activation function
+ */
+template <typename Base_t, class Act_fn>
+class conv_backprop: public backpropagation<Base_t, Act_fn> {
+    public:
+
+    /** Layers type */
+    typedef typename impl::conv_stack<Base_t, Act_fn>::layers_t layers_t;
+
+    private:
+
+    /** Ancestor type */
+    typedef backpropagation<Base_t, Act_fn> backpropagation_t;
+
+    /** Dense network type */
+    typedef topo::nn<Base_t, Act_fn> nn_t;
+
+    /** Dense network training set */
+    typedef std::vector<std::pair<std::vector<Base_t>, std::vector<Base_t> > >
+        tset_t;
+
+    layers_t &                        m_layers;   /**< Layers                */
+    impl::conv_stack<Base_t, Act_fn>  m_stack;    /**< Layers evaluation     */
+    std::vector<std::vector<Base_t> > m_grad_w;   /**< Kernels gradient      */
+    std::vector<std::vector<Base_t> > m_grad_b;   /**< Biases gradient       */
+    std::vector<Base_t>               m_error;    /**< Dense input error     */
+    std::vector<std::vector<Base_t> > m_errors;   /**< Dense input errors    */
+    tset_t                            m_tset;     /**< Dense training set    */
+
+    /** Reset gradients */
+    void reset_grad() {
+        for (size_t l = 0; l < m_layers.size(); ++l) {
+            std::fill(m_grad_w[l].begin(), m_grad_w[l].end(), Base_t(0));
+            std::fill(m_grad_b[l].begin(), m_grad_b[l].end(), Base_t(0));
+        }
+    }
+
+    /**
+     *  \brief  Update layers by gradient
+     *
+     *  \param  alpha  Learning factor
+     */
+    void update(const Base_t & alpha) {
+        for (size_t l = 0; l < m_layers.size(); ++l) {
+            auto & w = m_layers[l].weights();
+            auto & b = m_layers[l].bias();
+
+            for (size_t i = 0; i < w.size(); ++i) w[i] -= alpha * m_grad_w[l][i];
+            for (size_t i = 0; i < b.size(); ++i) b[i] -= alpha * m_grad_b[l][i];
+        }
+    }
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \tparam Fixes   Container type of hard fixations (iterable)
+     *  \param  layers  Convolutional/pooling layers
+     *  \param  dense   Dense network
+     *  \param  fixes   Dense network hard fixations (bias...)
+     */
+    template <typename Fixes>
+    conv_backprop(layers_t & layers, nn_t & dense, const Fixes & fixes):
+        backpropagation_t(dense, fixes),
+        m_layers(layers),
+        m_stack(layers),
+        m_grad_w(layers.size()),
+        m_grad_b(layers.size())
+    {
+        if (m_stack.output_size() != dense.input_size())
+            throw std::logic_error(
+                "libnn::ml::conv_backprop: "
+                "dense network input doesn't match the layers output");
+
+        for (size_t l = 0; l < m_layers.size(); ++l) {
+            m_grad_w[l].resize(m_layers[l].weights().size());
+            m_grad_b[l].resize(m_layers[l].bias().size());
+        }
+    }
+
+    /**
+     *  \brief  Run backpropagation on a single input/output pair
+     *
+     *  See \ref backpropagation on-line mode.
+     *
+     *  \tparam Input      Input container type (iterable)
+     *  \tparam Output     Output container type (iterable)
+     *  \tparam Criterion  Update criterion type
+     *  \param  input      Input
+     *  \param  output     Output (desired)
+     *  \param  criterion  Update criterion
+     *
+     *  \return Error norm squared
+     */
+    template <class Input, class Output, class Criterion>
+    Base_t operator () (
+        const Input  & input,
+        const Output & output,
+        Criterion    & criterion)
+    {
+        Base_t alpha = 0;
+        auto dense_criterion = [&alpha, &criterion](Base_t err_n2) -> Base_t {
+            return alpha = criterion(err_n2);
+        };
+
+        const Base_t err_n2 = backpropagation_t::operator () (
+            m_stack(input), output, dense_criterion, m_error);
+
+        if (0 == alpha) return err_n2;
+
+        reset_grad();
+        m_stack.backward(m_error, m_grad_w, m_grad_b);
+        update(alpha);
+
+        return err_n2;
+    }
+
+    /**
+     *  \brief  Run backpropagation on a training set
+     *
+     *  See \ref backpropagation batch mode.
+     *
+     *  \tparam TSet       Training set (iterable container of
+     *                     \c std::pair containing [input, output] samples)
+     *  \tparam Criterion  Update criterion type
+     *  \param  set        Training set
+     *  \param  criterion  Update criterion
+     *
+     *  \return Error norm squared average
+     */
+    template <class TSet, class Criterion>
+    Base_t operator () (
+        const TSet   & set,
+        Criterion    & criterion)
+    {
+        const size_t set_size = set.size();
+
+        // Evaluate layers
+        m_tset.resize(set_size);
+
+        auto sample = m_tset.begin();
+        for (auto iter = set.begin(); iter != set.end(); ++iter, ++sample) {
+            const auto & out = m_stack(iter->first);
+
+            sample->first.assign(out.begin(), out.end());
+            sample->second.assign(iter->second.begin(), iter->second.end());
+        }
+
+        Base_t alpha = 0;
+        auto dense_criterion = [&alpha, &criterion](Base_t err_n2) -> Base_t {
+            return alpha = criterion(err_n2);
+        };
+
+        const Base_t err_n2 = backpropagation_t::operator () (
+            m_tset, dense_criterion, m_errors);
+
+        if (0 == alpha) return err_n2;
+
+        // Back-propagate errors through the layers (re-evaluated)
+        reset_grad();
+
+        auto error = m_errors.begin();
+        for (auto iter = set.begin(); iter != set.end(); ++iter, ++error) {
+            m_stack(iter->first);
+            m_stack.backward(*error, m_grad_w, m_grad_b);
+        }
+
+        update(alpha / set_size);
+
+        return err_n2;
+    }
+
+};  // end of template class conv_backprop
+
+}}  // end of namespace libnn::ml
+
+#endif  // end of #ifndef libnn__ml__conv_hxx
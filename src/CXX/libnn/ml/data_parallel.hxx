@@ -0,0 +1,198 @@
+#ifndef libnn__ml__data_parallel_hxx
+#define libnn__ml__data_parallel_hxx
+
+/**
+ *  Data-parallel batch training
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libnn/misc/allreduce.hxx"
+
+#include <cstddef>
+#include <iterator>
+
+
+namespace libnn {
+namespace ml {
+
+/**
+ *  \brief  Data-parallel batch training
+ *
+ *  Each rank of the \c allreduce (typically a process, see
+ *  \c misc::shm_allreduce) trains its own replica of the network
+ *  on its shard of each batch: the batch is split to contiguous shards
+ *  of (almost) the same size, rank \c r taking the \c r-th one.
+ *  The gradients are summed by the all-reduce, so the replicas are
+ *  updated the same way as if the whole batch was processed by one
+ *  trainer (see \c backpropagation::allreduce).
+ *
+ *  All the ranks must get the same batches and criteria and the replicas
+ *  must be initialised the same.
+ *
+ *  \tparam  Base_t    Base numeric type
+ *  \tparam  Training  Trainer (\c backpropagation, \c layered_backprop
+ *                     or \c model::feed_forward::training_t)
+ */
+template <typename Base_t, class Training>
+class data_parallel {
+    public:
+
+    typedef misc::allreduce<Base_t> allreduce_t;  /**< All-reduce */
+
+    /**
+     *  \brief  Training set shard
+     *
+     *  Range of the training set samples.
+     *
+     *  \tparam  TSet  Training set
+     */
+    template <class TSet>
+    class shard {
+        public:
+
+        /** Sample iterator */
+        typedef typename TSet::const_iterator const_iterator;
+
+        private:
+
+        const_iterator m_begin;  /**< First sample         */
+        const_iterator m_end;    /**< Last sample plus one */
+        size_t         m_size;   /**< Sample count         */
+
+        public:
+
+        /**
+         *  \brief  Constructor
+         *
+         *  \param  set    Training set
+         *  \param  ranks  Rank count
+         *  \param  rank   Rank
+         */
+        shard(const TSet & set, size_t ranks, size_t rank) {
+            const size_t size  = set.size();
+            const size_t begin = rank * size / ranks;
+            const size_t end   = (rank + 1) * size / ranks;
+
+            m_begin = set.begin();
+            std::advance(m_begin, begin);
+
+            m_end = m_begin;
+            std::advance(m_end, end - begin);
+
+            m_size = end - begin;
+        }
+
+        /** Begin */
+        const_iterator begin() const { return m_begin; }
+
+        /** End */
+        const_iterator end() const { return m_end; }
+
+        /** Sample count */
+        size_t size() const { return m_size; }
+
+    };  // end of template class shard
+
+    private:
+
+    Training &    m_training;   /**< Trainer    */
+    allreduce_t & m_allreduce;  /**< All-reduce */
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  Attaches the all-reduce to the trainer.
+     *
+     *  \param  training   Trainer
+     *  \param  allreduce  All-reduce
+     */
+    data_parallel(Training & training, allreduce_t & allreduce):
+        m_training(training),
+        m_allreduce(allreduce)
+    {
+        m_training.allreduce(&m_allreduce);
+    }
+
+    /** Rank count */
+    size_t ranks() const { return m_allreduce.ranks(); }
+
+    /** Own rank */
+    size_t rank() const { return m_allreduce.rank(); }
+
+    /**
+     *  \brief  Own shard of a training set
+     *
+     *  \tparam TSet  Training set
+     *  \param  set   Training set
+     *
+     *  \return Shard
+     */
+    template <class TSet>
+    shard<TSet> get_shard(const TSet & set) const {
+        return shard<TSet>(set, ranks(), rank());
+    }
+
+    /**
+     *  \brief  Run batch training on the own shard of a training set
+     *
+     *  \tparam TSet       Training set (the whole batch)
+     *  \tparam Criterion  Update criterion type
+     *  \param  set        Training set
+     *  \param  criterion  Update criterion
+     *
+     *  \return Error norm squared average (over the whole batch)
+     */
+    template <class TSet, class Criterion>
+    Base_t operator () (const TSet & set, Criterion & criterion) {
+        return m_training(get_shard(set), criterion);
+    }
+
+    /**
+     *  \brief  Destructor
+     *
+     *  Detaches the all-reduce from the trainer.
+     */
+    ~data_parallel() { m_training.allreduce(NULL); }
+
+};  // end of template class data_parallel
+
+}}  // end of namespace libnn::ml
+
+
+#endif  // end of #ifndef libnn__ml__data_parallel_hxx
@@ -0,0 +1,1492 @@
+#ifndef libnn__ml__layered_hxx
+#define libnn__ml__layered_hxx
+
+/**
+ *  Layered network evaluation
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libnn/instances.hxx"
+#include "libnn/topo/nn.hxx"
+#include "libnn/math/blas.hxx"
+#include "libnn/misc/executor.hxx"
+#include "libnn/misc/allreduce.hxx"
+#include "libnn/ml/telemetry.hxx"
+
+#include <vector>
+#include <list>
+#include <stdexcept>
+#include <algorithm>
+#include <cstddef>
+#include <cmath>
+
+
+namespace libnn {
+namespace ml {
+
+namespace impl {
+
+/**
+ *  \brief  Layered network evaluation plan
+ *
+ *  Dense representation of a layered network (see \c model::feed_forward).
+ *  Layer k (k > 0) synapses are kept in matrices:
+ *  * W (size_k x size_(k-1)): synapses from the previous layer
+ *  * b (size_k): synapses from the bias source (the only hard-fixed neuron)
+ *  * L (size_k x size_k, strictly lower triangular): lateral synapses
+ *    (i.e. from previous neurons in the same layer)
+ *
+ *  The forward phase computes the non-lateral part of the whole layer
+ *  net as one dense product (net = W x + b) and then resolves the lateral
+ *  chain by a forward substitution-like sweep:
+ *
+ *    net_j += sum_{i<j} L_ji phi(net_i),  phi_j = phi(net_j)
+ *
+ *  The backward phase does the matching transposed (backward) sweep.
+ *  Several samples are evaluated at once (one row per sample), so that
+ *  the dense products are matrix-matrix ones.
+ *
+ *  Any topology that doesn't fit the scheme (synapses skipping layers,
+ *  shared weights, more fixations...) renders the plan invalid;
+ *  the users shall fall back to the generic computation.
+ *
+ *  Weights are copied to the matrices on construction and by \ref sync.
+ *  \ref refresh re-reads them if the network weights changed since
+ *  and re-creates the plan if the network topology changed (see
+ *  \c topo::nn::version).
+ *
+ *  Rows are independent (except for the gradient accumulation);
+ *  if an executor is set, row ranges are processed in parallel.
+ *
+ *  \tparam  Base_t  Base numeric type
+ *  \tparam  Act_fn  Activation function
+ */
+template <typename Base_t, class Act_fn>
+class layered_net {
+    public:
+
+    typedef topo::nn<Base_t, Act_fn> nn_t;  /**< Neural network type */
+
+    /** Layers (neuron index ranges [begin, end)) */
+    typedef std::vector<std::pair<size_t, size_t> > layers_t;
+
+    /** Hard fixations (neuron index, activation function value) */
+    typedef std::vector<std::pair<size_t, Base_t> > fixes_t;
+
+    private:
+
+    /** Matrix offset for n/a */
+    static const size_t npos = (size_t)-1;
+
+    /** Minimal work (multiply-adds) of a parallel row range */
+    static const size_t par_work_min = 1 << 14;
+
+    /** Layer plan */
+    struct layer {
+        size_t begin;     /**< First neuron index                 */
+        size_t size;      /**< Layer size                         */
+        size_t src_size;  /**< Previous layer size                */
+        size_t w_off;     /**< W offset in parameters             */
+        size_t b_off;     /**< b offset in parameters (or npos)   */
+        size_t l_off;     /**< L offset in parameters (or npos)   */
+
+        std::vector<const Act_fn *> act_fn;  /**< Activation functions */
+
+        /**
+         *  \brief  Constructor
+         *
+         *  \param  b  First neuron index
+         *  \param  e  Last neuron index plus one
+         */
+        layer(size_t b, size_t e):
+            begin(b), size(e - b), src_size(0),
+            w_off(npos), b_off(npos), l_off(npos)
+        {}
+
+    };  // end of struct layer
+
+    /** Binding of a synapsis weight to a parameter */
+    typedef std::pair<const Base_t *, size_t> binding_t;
+
+    const nn_t           * m_nn;        /**< Neural network             */
+    layers_t               m_spec;      /**< Layers specification       */
+    fixes_t                m_fixes;     /**< Hard fixations             */
+    size_t                 m_topology;  /**< Planned topology version   */
+    size_t                 m_weights;   /**< Synced weights version     */
+    bool                   m_valid;     /**< Plan is valid              */
+    size_t                 m_slots;     /**< Row width (neuron slots)   */
+    size_t                 m_bias;      /**< Bias source (or npos)      */
+    Base_t                 m_bias_val;  /**< Bias value                 */
+    std::vector<layer>     m_layers;    /**< Layers (0 is input)        */
+    std::vector<Base_t>    m_param;     /**< Parameters (W, b, L)       */
+    std::vector<binding_t> m_bind;      /**< Synapsis weights bindings  */
+    misc::executor       * m_exec;      /**< Executor (or NULL)         */
+
+    /**
+     *  \brief  Create the plan
+     *
+     *  \param  nn      Neural network
+     *  \param  layers  Layers
+     *  \param  fixes   Hard fixations
+     *
+     *  \return \c true iff the network fits the plan
+     */
+    bool create(
+        const nn_t     & nn,
+        const layers_t & layers,
+        const fixes_t  & fixes)
+    {
+        if (layers.size() < 2 || fixes.size() > 1) return false;
+
+        m_slots = nn.slot_cnt();
+
+        // Bias source
+        if (!fixes.empty()) {
+            m_bias     = fixes.front().first;
+            m_bias_val = fixes.front().second;
+
+            if (!(m_bias < m_slots)) return false;
+        }
+
+        // Layers must be ordered and cover all neurons but the bias
+        std::vector<size_t> layer_of(m_slots, npos);
+
+        size_t neuron_cnt = npos == m_bias ? 0 : 1;
+        size_t begin = 0;
+        for (size_t k = 0; k < layers.size(); ++k) {
+            const size_t b = layers[k].first, e = layers[k].second;
+            if (b < begin || !(b < e) || m_slots < e) return false;
+
+            for (size_t i = b; i < e; ++i) {
+                if (i == m_bias) return false;
+                layer_of[i] = k;
+            }
+
+            neuron_cnt += e - b;
+            m_layers.emplace_back(b, e);
+            begin = e;
+        }
+
+        if (neuron_cnt != nn.size()) return false;
+
+        // Input and output layers must match the network I/O (in order)
+        if (nn.input_size()  != m_layers.front().size ||
+            nn.output_size() != m_layers.back().size)
+        {
+            return false;
+        }
+
+        bool io_ok = true;
+        size_t in_index  = m_layers.front().begin;
+        size_t out_index = m_layers.back().begin;
+
+        nn.for_each_input(
+        [&io_ok, &in_index](const typename nn_t::neuron & n) {
+            if (n.index() != in_index++) io_ok = false;
+        });
+
+        nn.for_each_output(
+        [&io_ok, &out_index](const typename nn_t::neuron & n) {
+            if (n.index() != out_index++) io_ok = false;
+        });
+
+        if (!io_ok) return false;
+
+        // Parameters layout
+        size_t param_cnt = 0;
+        for (size_t k = 1; k < m_layers.size(); ++k) {
+            layer & l = m_layers[k];
+
+            l.src_size = m_layers[k - 1].size;
+            l.w_off    = param_cnt;
+            param_cnt += l.size * l.src_size;
+        }
+
+        // Classify synapses
+        bool ok = true;
+
+        nn.for_each_neuron(
+        [&ok, &layer_of, &param_cnt, this](const typename nn_t::neuron & n) {
+            if (!ok) return;
+
+            const size_t index = n.index();
+
+            if (index == m_bias) {
+                ok = 0 == n.dendrite_cnt();
+                return;
+            }
+
+            const size_t k = layer_of[index];
+            if (npos == k) { ok = false; return; }
+
+            layer & l = m_layers[k];
+            const size_t j = index - l.begin;
+
+            if (0 == k) {  // input layer
+                ok = 0 == n.dendrite_cnt();
+                return;
+            }
+
+            l.act_fn.push_back(&n.act_fn());
+
+            const layer & src = m_layers[k - 1];
+
+            n.for_each_dendrite(
+            [&](const typename nn_t::neuron::dendrite & dend) {
+                if (dend.shared()) { ok = false; return; }
+
+                const size_t s = dend.source().index();
+
+                // Bias synapsis
+                if (s == m_bias) {
+                    if (npos == l.b_off) {
+                        l.b_off    = param_cnt;
+                        param_cnt += l.size;
+                    }
+
+                    m_bind.emplace_back(&dend.weight(), l.b_off + j);
+                }
+
+                // Synapsis from previous layer
+                else if (src.begin <= s && s < src.begin + src.size) {
+                    m_bind.emplace_back(&dend.weight(),
+                        l.w_off + j * l.src_size + (s - src.begin));
+                }
+
+                // Lateral synapsis (from previous neuron in layer)
+                else if (l.begin <= s && s < index) {
+                    if (npos == l.l_off) {
+                        l.l_off    = param_cnt;
+                        param_cnt += l.size * l.size;
+                    }
+
+                    m_bind.emplace_back(&dend.weight(),
+                        l.l_off + j * l.size + (s - l.begin));
+                }
+
+                else ok = false;
+            });
+        });
+
+        if (!ok) return false;
+
+        m_param.assign(param_cnt, 0);
+
+        return true;
+    }
+
+    /** (Re-)create the plan for the current network topology */
+    void plan() {
+        m_slots    = 0;
+        m_bias     = npos;
+        m_bias_val = 0;
+        m_layers.clear();
+        m_param.clear();
+        m_bind.clear();
+
+        m_topology = m_nn->version().topology;
+        m_valid    = create(*m_nn, m_spec, m_fixes);
+
+        if (m_valid)
+            sync();
+        else {
+            m_layers.clear();
+            m_bind.clear();
+        }
+    }
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  nn      Neural network
+     *  \param  layers  Layers (input layer first, output layer last)
+     *  \param  fixes   Hard fixations (bias source)
+     */
+    layered_net(
+        const nn_t     & nn,
+        const layers_t & layers,
+        const fixes_t  & fixes)
+    :
+        m_nn(&nn),
+        m_spec(layers),
+        m_fixes(fixes),
+        m_topology(0),
+        m_weights(0),
+        m_valid(false),
+        m_slots(0),
+        m_bias(npos),
+        m_bias_val(0),
+        m_exec(NULL)
+    {
+        plan();
+    }
+
+    /** Check whether the network fits the plan */
+    bool valid() const { return m_valid; }
+
+    /** Row width (activation, net and delta rows are indexed by neurons) */
+    size_t width() const { return m_slots; }
+
+    /** Input layer first neuron index */
+    size_t input_begin() const { return m_layers.front().begin; }
+
+    /** Input size */
+    size_t input_size() const { return m_layers.front().size; }
+
+    /** Output layer first neuron index */
+    size_t output_begin() const { return m_layers.back().begin; }
+
+    /** Output size */
+    size_t output_size() const { return m_layers.back().size; }
+
+    /** Parameter count (i.e. gradient size) */
+    size_t param_cnt() const { return m_param.size(); }
+
+    /** Layer count (including the input layer) */
+    size_t layer_cnt() const { return m_layers.size(); }
+
+    /**
+     *  \brief  Layer evaluation cost
+     *
+     *  Estimated as count of multiply-adds per row (incl. the lateral
+     *  synapses) plus the activation functions evaluation (which is
+     *  considered to cost \c act_cost multiply-adds).
+     *
+     *  \param  k  Layer (at least 1)
+     *
+     *  \return Layer evaluation cost
+     */
+    double layer_cost(size_t k) const {
+        static const double act_cost = 16;
+
+        const layer & l = m_layers.at(k);
+
+        double cost = (double)l.size * (l.src_size + act_cost);
+        if (npos != l.b_off) cost += l.size;
+        if (npos != l.l_off) cost += 0.5 * l.size * (l.size - 1);
+
+        return cost;
+    }
+
+    /** Parameters (W, b and L matrices) */
+    const std::vector<Base_t> & param() const { return m_param; }
+
+    /**
+     *  \brief  Set executor
+     *
+     *  \param  exec  Executor for parallel row processing (or \c NULL)
+     */
+    void executor(misc::executor * exec) { m_exec = exec; }
+
+    /** Executor (or \c NULL) */
+    misc::executor * executor() const { return m_exec; }
+
+    /**
+     *  \brief  Copy synapses weights to the matrices
+     *
+     *  Must be called if the weights were changed (other than by
+     *  \ref update) unnoticed by the network (see \ref refresh).
+     */
+    void sync() {
+        std::for_each(m_bind.begin(), m_bind.end(),
+        [this](const binding_t & bind) {
+            m_param[bind.second] = *bind.first;
+        });
+
+        m_weights = m_nn->version().weights;
+    }
+
+    /**
+     *  \brief  Refresh the plan
+     *
+     *  Re-creates the plan if the network topology changed since
+     *  it was created, re-reads the weights if they changed since
+     *  they were read.
+     *
+     *  \return \c true iff the plan is valid
+     */
+    bool refresh() {
+        const typename nn_t::version_t & version = m_nn->version();
+
+        if (version.topology != m_topology)
+            plan();
+        else if (version.weights != m_weights)
+            sync();
+
+        return m_valid;
+    }
+
+    /**
+     *  \brief  Norm squared of parameters bound to synapses
+     *
+     *  \param  param  Parameters (e.g. the plan parameters or gradient)
+     *
+     *  \return Sum of squares of the bound parameters
+     */
+    Base_t norm2(const std::vector<Base_t> & param) const {
+        Base_t norm2 = 0;
+
+        std::for_each(m_bind.begin(), m_bind.end(),
+        [&norm2, &param](const binding_t & bind) {
+            norm2 += param[bind.second] * param[bind.second];
+        });
+
+        return norm2;
+    }
+
+    /**
+     *  \brief  Update parameters and synapses weights
+     *
+     *  Parameter p is decreased by \c alpha \c grad[p].
+     *  Only parameters bound to synapses are updated.
+     *
+     *  Note that the synapses weights are written via the plan bindings,
+     *  so the caller must have a non-const access to the network.
+     *  The network weights version is advanced (so that other plans
+     *  notice the change), this plan stays in sync.
+     *
+     *  \param  alpha  Learning factor
+     *  \param  grad   Gradient
+     */
+    void update(const Base_t & alpha, const std::vector<Base_t> & grad) {
+        std::for_each(m_bind.begin(), m_bind.end(),
+        [&alpha, &grad, this](const binding_t & bind) {
+            Base_t & p = m_param[bind.second];
+            p -= alpha * grad[bind.second];
+
+            *const_cast<Base_t *>(bind.first) = p;
+        });
+
+        const_cast<nn_t *>(m_nn)->weights_changed();
+        m_weights = m_nn->version().weights;
+    }
+
+    /**
+     *  \brief  Set input row
+     *
+     *  Sets input layer activations (and the bias source) of a row.
+     *
+     *  \tparam Input  Input container type (iterable)
+     *  \param  act    Activations row
+     *  \param  input  Input
+     */
+    template <class Input>
+    void set_input(Base_t * act, const Input & input) const {
+        if (input.size() != input_size())
+            throw std::logic_error(
+                "libnn::ml::layered_net: "
+                "invalid input size");
+
+        std::copy(input.begin(), input.end(), act + input_begin());
+
+        if (npos != m_bias) act[m_bias] = m_bias_val;
+    }
+
+    private:
+
+    /**
+     *  \brief  Process rows
+     *
+     *  Runs \c fn for row ranges; in parallel if executor is set
+     *  and the rows work pays off.
+     *
+     *  \tparam Fn   Range function type
+     *  \param  cnt  Row count
+     *  \param  fn   Range function (called with row range begin, end)
+     */
+    template <class Fn>
+    void rows(size_t cnt, const Fn & fn) const {
+        const size_t row_work = std::max<size_t>(1, m_param.size());
+
+        if (NULL == m_exec || 1 == m_exec->concurrency()
+        ||  cnt * row_work < 2 * par_work_min)
+        {
+            fn(0, cnt);
+            return;
+        }
+
+        m_exec->parallel_for(0, cnt, fn,
+            (par_work_min + row_work - 1) / row_work);
+    }
+
+    /**
+     *  \brief  Forward phase (rows)
+     *
+     *  \param  cnt      Row count
+     *  \param  act      Activations (\c cnt rows of \ref width)
+     *  \param  net      Nets (\c cnt rows of \ref width)
+     *  \param  k_begin  First layer
+     *  \param  k_end    Last layer plus one
+     */
+    void forward_rows(
+        size_t   cnt,
+        Base_t * act,
+        Base_t * net,
+        size_t   k_begin,
+        size_t   k_end) const
+    {
+        for (size_t k = k_begin; k < k_end; ++k) {
+            const layer & l   = m_layers[k];
+            const layer & src = m_layers[k - 1];
+
+            // Bias
+            for (size_t r = 0; r < cnt; ++r) {
+                Base_t * net_row = net + r * m_slots + l.begin;
+
+                if (npos == l.b_off)
+                    std::fill(net_row, net_row + l.size, Base_t(0));
+                else
+                    for (size_t j = 0; j < l.size; ++j)
+                        net_row[j] = m_bias_val * m_param[l.b_off + j];
+            }
+
+            // Non-lateral part of the nets: Net += X W^T
+            math::blas::gemm(math::NO_TRANS, math::TRANS,
+                cnt, l.size, l.src_size,
+                Base_t(1), act + src.begin, m_slots,
+                m_param.data() + l.w_off, l.src_size,
+                Base_t(1), net + l.begin, m_slots);
+
+            // Activations (lateral chain sweep)
+            for (size_t r = 0; r < cnt; ++r) {
+                Base_t * net_row = net + r * m_slots + l.begin;
+                Base_t * act_row = act + r * m_slots + l.begin;
+
+                if (npos == l.l_off) {
+                    for (size_t j = 0; j < l.size; ++j)
+                        act_row[j] = (*l.act_fn[j])(net_row[j]);
+
+                    continue;
+                }
+
+                const Base_t * lat = m_param.data() + l.l_off;
+                for (size_t j = 0; j < l.size; ++j, lat += l.size) {
+                    const Base_t net_j
+                        = net_row[j] += math::dot(lat, act_row, j);
+
+                    act_row[j] = (*l.act_fn[j])(net_j);
+                }
+            }
+        }
+    }
+
+    /**
+     *  \brief  Backward phase (rows)
+     *
+     *  Computes deltas of all layers (see \ref backward).
+     *
+     *  \param  cnt    Row count
+     *  \param  net    Nets (see \ref forward)
+     *  \param  delta  Deltas (\c cnt rows of \ref width)
+     */
+    void backward_rows(size_t cnt, const Base_t * net, Base_t * delta) const {
+        const size_t last = m_layers.size() - 1;
+
+        for (size_t k = last; k > 0; --k) {
+            const layer & l   = m_layers[k];
+            const layer & src = m_layers[k - 1];
+
+            // Deltas (transposed lateral chain sweep)
+            for (size_t r = 0; r < cnt; ++r) {
+                const Base_t * net_row   = net   + r * m_slots + l.begin;
+                Base_t       * delta_row = delta + r * m_slots + l.begin;
+
+                if (npos == l.l_off || k == last) {
+                    for (size_t j = 0; j < l.size; ++j)
+                        delta_row[j] *= l.act_fn[j]->d(net_row[j]);
+
+                    continue;
+                }
+
+                for (size_t j = l.size; j > 0; ) {
+                    --j;
+
+                    const Base_t delta_j
+                        = delta_row[j] *= l.act_fn[j]->d(net_row[j]);
+
+                    math::axpy(delta_j,
+                        m_param.data() + l.l_off + j * l.size, delta_row, j);
+                }
+            }
+
+            // Previous layer errors: E = Delta W
+            math::blas::gemm(math::NO_TRANS, math::NO_TRANS,
+                cnt, l.src_size, l.size,
+                Base_t(1), delta + l.begin, m_slots,
+                m_param.data() + l.w_off, l.src_size,
+                Base_t(0), delta + src.begin, m_slots);
+        }
+    }
+
+    /**
+     *  \brief  Gradient accumulation
+     *
+     *  \param  cnt    Row count
+     *  \param  act    Activations (see \ref forward)
+     *  \param  delta  Deltas (see \ref backward)
+     *  \param  grad   Gradient accumulator
+     */
+    void gradient(
+        size_t         cnt,
+        const Base_t * act,
+        const Base_t * delta,
+        Base_t       * grad) const
+    {
+        for (size_t k = m_layers.size() - 1; k > 0; --k) {
+            const layer & l   = m_layers[k];
+            const layer & src = m_layers[k - 1];
+
+            // dW += Delta^T X
+            if (NULL != m_exec)
+                math::gemm_threaded(*m_exec, math::TRANS, math::NO_TRANS,
+                    l.size, l.src_size, cnt,
+                    Base_t(1), delta + l.begin, m_slots,
+                    act + src.begin, m_slots,
+                    Base_t(1), grad + l.w_off, l.src_size);
+            else
+                math::blas::gemm(math::TRANS, math::NO_TRANS,
+                    l.size, l.src_size, cnt,
+                    Base_t(1), delta + l.begin, m_slots,
+                    act + src.begin, m_slots,
+                    Base_t(1), grad + l.w_off, l.src_size);
+
+            // db += bias Delta^T 1
+            if (npos != l.b_off)
+                for (size_t r = 0; r < cnt; ++r) {
+                    const Base_t * delta_row = delta + r * m_slots + l.begin;
+
+                    for (size_t j = 0; j < l.size; ++j)
+                        grad[l.b_off + j] += m_bias_val * delta_row[j];
+                }
+
+            // dL += Delta^T Phi (only the lower triangle is used)
+            if (npos != l.l_off)
+                math::blas::gemm(math::TRANS, math::NO_TRANS,
+                    l.size, l.size, cnt,
+                    Base_t(1), delta + l.begin, m_slots,
+                    act + l.begin, m_slots,
+                    Base_t(1), grad + l.l_off, l.size);
+        }
+    }
+
+    public:
+
+    /**
+     *  \brief  Forward phase
+     *
+     *  Computes nets and activations of all layers for \c cnt rows.
+     *  The input layer activations must be set (see \ref set_input).
+     *
+     *  \param  cnt  Row count
+     *  \param  act  Activations (\c cnt rows of \ref width)
+     *  \param  net  Nets (\c cnt rows of \ref width)
+     */
+    void forward(size_t cnt, Base_t * act, Base_t * net) const {
+        rows(cnt, [this, act, net](size_t begin, size_t end) {
+            forward_rows(end - begin,
+                act + begin * m_slots, net + begin * m_slots,
+                1, m_layers.size());
+        });
+    }
+
+    /**
+     *  \brief  Forward phase of a layer range
+     *
+     *  Computes nets and activations of layers [k_begin, k_end) for
+     *  \c cnt rows (by the calling thread); the previous layers
+     *  activations must be computed.
+     *  Useful for splitting the evaluation to stages.
+     *
+     *  \param  cnt      Row count
+     *  \param  act      Activations (\c cnt rows of \ref width)
+     *  \param  net      Nets (\c cnt rows of \ref width)
+     *  \param  k_begin  First layer (at least 1)
+     *  \param  k_end    Last layer plus one
+     */
+    void forward(
+        size_t   cnt,
+        Base_t * act,
+        Base_t * net,
+        size_t   k_begin,
+        size_t   k_end) const
+    {
+        if (!(0 < k_begin && k_end <= m_layers.size()))
+            throw std::range_error(
+                "libnn::ml::layered_net: "
+                "invalid layer range");
+
+        forward_rows(cnt, act, net, k_begin, k_end);
+    }
+
+    /**
+     *  \brief  Backward phase
+     *
+     *  Computes deltas of all layers for \c cnt rows and (optionally)
+     *  accumulates gradient.
+     *  On input, output layer part of \c delta rows shall contain
+     *  the output error (actual output minus desired output).
+     *  On output, input layer part of \c delta rows contains the error
+     *  derivative by the network inputs.
+     *
+     *  Note that just as in \ref backpropagation, output neurons deltas
+     *  are computed from their errors only (i.e. lateral synapses don't
+     *  propagate error within the output layer).
+     *
+     *  \param  cnt    Row count
+     *  \param  act    Activations (see \ref forward)
+     *  \param  net    Nets (see \ref forward)
+     *  \param  delta  Deltas (\c cnt rows of \ref width)
+     *  \param  grad   Gradient accumulator (or \c NULL)
+     */
+    void backward(
+        size_t         cnt,
+        const Base_t * act,
+        const Base_t * net,
+        Base_t       * delta,
+        Base_t       * grad) const
+    {
+        rows(cnt, [this, net, delta](size_t begin, size_t end) {
+            backward_rows(end - begin,
+                net + begin * m_slots, delta + begin * m_slots);
+        });
+
+        if (grad) gradient(cnt, act, delta, grad);
+    }
+
+};  // end of template class layered_net
+
+/** \cond */
+template <typename Base_t, class Act_fn>
+const size_t layered_net<Base_t, Act_fn>::npos;
+/** \endcond */
+
+}  // end of namespace impl
+
+
+/**
+ *  \brief  Computation of layered network function
+ *
+ *  Evaluates a layered network (with or without lateral synapses)
+ *  by dense matrix products and a lateral chain sweep per layer;
+ *  see \ref impl::layered_net.
+ *
+ *  The synapses weights are copied at construction; the copy is
+ *  refreshed automatically if the network weights (or topology)
+ *  changed since (see \c topo::nn::version).
+ *
+ *  \tparam  Base_t  Base numeric type
+ *  \tparam  Act_fn  Activation function
+ */
+template <typename Base_t, class Act_fn>
+class layered_func {
+    private:
+
+    /** Evaluation plan type */
+    typedef impl::layered_net<Base_t, Act_fn> net_t;
+
+    public:
+
+    typedef typename net_t::nn_t     nn_t;      /**< Neural network type */
+    typedef typename net_t::layers_t layers_t;  /**< Layers              */
+    typedef typename net_t::fixes_t  fixes_t;   /**< Hard fixations      */
+
+    private:
+
+    net_t               m_net;    /**< Evaluation plan */
+    std::vector<Base_t> m_act;    /**< Activations     */
+    std::vector<Base_t> m_nets;   /**< Nets            */
+
+    /**
+     *  \brief  Prepare rows
+     *
+     *  \param  cnt  Row count
+     */
+    void rows(size_t cnt) {
+        const size_t size = cnt * m_net.width();
+
+        if (m_act.size() < size) {
+            m_act.resize(size);
+            m_nets.resize(size);
+        }
+    }
+
+    /** Refresh the plan, check it's valid */
+    void check() {
+        if (!m_net.refresh())
+            throw std::logic_error(
+                "libnn::ml::layered_func: "
+                "the network is not layered");
+    }
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  nn      Neural network
+     *  \param  layers  Layers (input layer first, output layer last)
+     *  \param  fixes   Hard fixations (bias source)
+     */
+    layered_func(
+        const nn_t     & nn,
+        const layers_t & layers,
+        const fixes_t  & fixes = fixes_t())
+    :
+        m_net(nn, layers, fixes)
+    {
+        rows(1);
+    }
+
+    /**
+     *  \brief  Check whether the network is layered
+     *
+     *  If not, the computation is not available (and the generic one
+     *  should be used).
+     *  Note that the plan is only re-created on topology change
+     *  by \ref refresh (or evaluation).
+     */
+    bool valid() const { return m_net.valid(); }
+
+    /**
+     *  \brief  Refresh the plan (see \c impl::layered_net::refresh)
+     *
+     *  \return \c true iff the network is layered
+     */
+    bool refresh() { return m_net.refresh(); }
+
+    /**
+     *  \brief  Re-read synapses weights
+     *
+     *  Only necessary if the weights were changed unnoticed by
+     *  the network (see \c topo::nn::version).
+     */
+    void sync() { m_net.sync(); }
+
+    /**
+     *  \brief  Reserve buffers
+     *
+     *  Batches of up to \c rows inputs are then evaluated without
+     *  memory allocation.
+     *
+     *  \param  rows  Row count
+     */
+    void reserve(size_t rows) { this->rows(rows); }
+
+    /**
+     *  \brief  Set executor
+     *
+     *  \param  exec  Executor for parallel evaluation (or \c NULL)
+     */
+    void executor(misc::executor * exec) { m_net.executor(exec); }
+
+    /**
+     *  \brief  Compute network function
+     *
+     *  \tparam Input  Input container type (iterable)
+     *  \param  input  Input
+     *
+     *  \return Output vector
+     */
+    template <class Input>
+    std::vector<Base_t> operator () (const Input & input) {
+        check();
+        rows(1);
+
+        m_net.set_input(m_act.data(), input);
+        m_net.forward(1, m_act.data(), m_nets.data());
+
+        const auto out = m_act.begin() + m_net.output_begin();
+        return std::vector<Base_t>(out, out + m_net.output_size());
+    }
+
+    /**
+     *  \brief  Compute network function for a batch of inputs
+     *
+     *  The batch is evaluated at once (rows of matrix products).
+     *  The outputs are written to a row-major matrix.
+     *  Each input is copied to the activations matrix and each output
+     *  is copied from it (one copy in, one copy out; no other buffers).
+     *
+     *  \tparam Inputs   Inputs container type (iterable)
+     *  \param  inputs   Inputs
+     *  \param  outputs  Outputs (row per input)
+     *  \param  stride   Outputs row stride (0 means output size)
+     */
+    template <class Inputs>
+    void batch(const Inputs & inputs, Base_t * outputs, size_t stride = 0) {
+        check();
+
+        const size_t cnt   = inputs.size();
+        const size_t width = m_net.width();
+        const size_t size  = m_net.output_size();
+
+        if (0 == stride) stride = size;
+
+        rows(cnt);
+
+        size_t r = 0;
+        for (auto iter = inputs.begin(); iter != inputs.end(); ++iter, ++r)
+            m_net.set_input(m_act.data() + r * width, *iter);
+
+        m_net.forward(cnt, m_act.data(), m_nets.data());
+
+        for (r = 0; r < cnt; ++r) {
+            const Base_t * out =
+                m_act.data() + r * width + m_net.output_begin();
+
+            std::copy(out, out + size, outputs + r * stride);
+        }
+    }
+
+    /**
+     *  \brief  Compute network function for a batch of inputs
+     *
+     *  The batch is evaluated at once (rows of matrix products).
+     *
+     *  \tparam Inputs  Inputs container type (iterable)
+     *  \param  inputs  Inputs
+     *
+     *  \return Outputs (in order of the inputs)
+     */
+    template <class Inputs>
+    std::vector<std::vector<Base_t> > batch(const Inputs & inputs) {
+        check();
+
+        const size_t size = m_net.output_size();
+
+        std::vector<Base_t> outputs(inputs.size() * size);
+        batch(inputs, outputs.data());
+
+        std::vector<std::vector<Base_t> > result(inputs.size());
+        for (size_t r = 0; r < result.size(); ++r)
+            result[r].assign(outputs.begin() + r * size,
+                outputs.begin() + (r + 1) * size);
+
+        return result;
+    }
+
+};  // end of template class layered_func
+
+
+/**
+ *  \brief  Layered network backpropagation
+ *
+ *  Implements the same training modes as \ref backpropagation
+ *  (on-line and batch, optionally providing input errors), using
+ *  the dense evaluation plan (see \ref impl::layered_net).
+ *  The batch is processed at once (by matrix-matrix products);
+ *  the gradient is accumulated and applied afterwards.
+ *
+ *  The network synapses weights are updated along with the plan
+ *  matrices.
+ *  The weights are copied at construction; the copy is refreshed
+ *  automatically if they are changed by other means (see
+ *  \c topo::nn::version).
+ *
+ *  \tparam  Base_t  Base numeric type
+ *  \tparam  Act_fn  Activation function
+ */
+template <typename Base_t, class Act_fn>
+class layered_backprop {
+    private:
+
+    /** Evaluation plan type */
+    typedef impl::layered_net<Base_t, Act_fn> net_t;
+
+    public:
+
+    typedef typename net_t::nn_t     nn_t;      /**< Neural network type */
+    typedef typename net_t::layers_t layers_t;  /**< Layers              */
+    typedef typename net_t::fixes_t  fixes_t;   /**< Hard fixations      */
+
+    private:
+
+    net_t               m_net;    /**< Evaluation plan         */
+    std::vector<Base_t> m_act;    /**< Activations (rows)      */
+    std::vector<Base_t> m_nets;   /**< Nets (rows)             */
+    std::vector<Base_t> m_delta;  /**< Deltas (rows)           */
+    std::vector<Base_t> m_grad;   /**< Gradient                */
+
+    misc::allreduce<Base_t> * m_allreduce;  /**< Data-parallel ranks sum */
+    telemetry::recorder       m_telemetry;  /**< Training telemetry      */
+
+    /**
+     *  \brief  Report training step (if observed)
+     *
+     *  \param  samples     Sample count
+     *  \param  error       Error norm squared (average)
+     *  \param  alpha       Learning factor
+     *  \param  grad_scale  Gradient scale (0 if not available)
+     *
+     *  \return \c error
+     */
+    Base_t observed(
+        size_t samples,
+        Base_t error,
+        Base_t alpha,
+        Base_t grad_scale)
+    {
+        if (!m_telemetry.active()) return error;
+
+        const Base_t grad_norm = 0 != grad_scale
+            ? std::sqrt(m_net.norm2(m_grad)) * grad_scale : 0;
+
+        m_telemetry.step(samples, error, alpha,
+            grad_norm, std::sqrt(m_net.norm2(m_net.param())));
+
+        return error;
+    }
+
+    /**
+     *  \brief  Prepare rows
+     *
+     *  \param  cnt  Row count
+     */
+    void rows(size_t cnt) {
+        const size_t size = cnt * m_net.width();
+
+        if (m_act.size() < size) {
+            m_act.resize(size);
+            m_nets.resize(size);
+            m_delta.resize(size);
+        }
+    }
+
+    /** Refresh the plan, check it's valid */
+    void check() {
+        if (!m_net.refresh())
+            throw std::logic_error(
+                "libnn::ml::layered_backprop: "
+                "the network is not layered");
+    }
+
+    /**
+     *  \brief  Set output error
+     *
+     *  \tparam Output  Output container type (iterable)
+     *  \param  r       Row
+     *  \param  output  Output (desired)
+     *
+     *  \return Error norm squared
+     */
+    template <class Output>
+    Base_t set_error(size_t r, const Output & output) {
+        if (output.size() != m_net.output_size())
+            throw std::logic_error(
+                "libnn::ml::layered_backprop: "
+                "invalid output target supplied");
+
+        const size_t off = r * m_net.width() + m_net.output_begin();
+
+        const Base_t * act   = m_act.data()   + off;
+        Base_t       * delta = m_delta.data() + off;
+
+        Base_t error_norm2 = 0;
+
+        auto out_iter = output.begin();
+        for (size_t j = 0; j < m_net.output_size(); ++j, ++out_iter) {
+            const Base_t err = act[j] - *out_iter;
+
+            delta[j]     = err;
+            error_norm2 += err * err;
+        }
+
+        return error_norm2;
+    }
+
+    /**
+     *  \brief  Get input error
+     *
+     *  \param  r            Row
+     *  \param  input_error  Input error
+     */
+    void get_input_error(size_t r, std::vector<Base_t> & input_error) const {
+        const auto in = m_delta.begin()
+            + r * m_net.width() + m_net.input_begin();
+
+        input_error.assign(in, in + m_net.input_size());
+    }
+
+    /**
+     *  \brief  On-line training
+     *
+     *  \tparam Input        Input container type (iterable)
+     *  \tparam Output       Output container type (iterable)
+     *  \tparam Criterion    Update criterion type
+     *  \param  input        Input
+     *  \param  output       Output (desired)
+     *  \param  criterion    Update criterion
+     *  \param  input_error  Input error (optional)
+     *
+     *  \return Error norm squared
+     */
+    template <class Input, class Output, class Criterion>
+    Base_t online(
+        const Input         & input,
+        const Output        & output,
+        Criterion           & criterion,
+        std::vector<Base_t> * input_error)
+    {
+        check();
+
+        m_telemetry.start();
+
+        rows(1);
+
+        m_net.set_input(m_act.data(), input);
+        m_net.forward(1, m_act.data(), m_nets.data());
+
+        const Base_t error_norm2 = set_error(0, output);
+        m_telemetry.phase(misc::instrument::FORWARD);
+
+        m_grad.assign(m_net.param_cnt(), 0);
+        m_net.backward(1, m_act.data(), m_nets.data(), m_delta.data(),
+            m_grad.data());
+
+        if (input_error) get_input_error(0, *input_error);
+        m_telemetry.phase(misc::instrument::BACKWARD);
+
+        const Base_t alpha = criterion(error_norm2);
+        if (0 != alpha) m_net.update(alpha, m_grad);
+        m_telemetry.phase(misc::instrument::UPDATE);
+
+        return observed(1, error_norm2, alpha, 1);
+    }
+
+    /**
+     *  \brief  Batch training
+     *
+     *  \tparam TSet          Training set
+     *  \tparam Criterion     Update criterion type
+     *  \param  set           Training set
+     *  \param  criterion     Update criterion
+     *  \param  input_errors  Input errors (optional)
+     *
+     *  \return Error norm squared average
+     */
+    template <class TSet, class Criterion>
+    Base_t batch(
+        const TSet                        & set,
+        Criterion                         & criterion,
+        std::vector<std::vector<Base_t> > * input_errors)
+    {
+        check();
+
+        const size_t set_size = set.size();
+        const size_t width    = m_net.width();
+
+        m_telemetry.start();
+
+        rows(set_size);
+
+        // Compute batch forward stage
+        size_t r = 0;
+        for (auto iter = set.begin(); iter != set.end(); ++iter, ++r)
+            m_net.set_input(m_act.data() + r * width, iter->first);
+
+        m_net.forward(set_size, m_act.data(), m_nets.data());
+
+        Base_t error_norm2_avg = 0;
+
+        r = 0;
+        for (auto iter = set.begin(); iter != set.end(); ++iter, ++r)
+            error_norm2_avg += set_error(r, iter->second);
+
+        // Error average over all ranks (if data-parallel)
+        size_t total = set_size;
+        if (m_allreduce) {
+            Base_t sum[2] = { error_norm2_avg, (Base_t)set_size };
+            (*m_allreduce)(sum, 2);
+
+            error_norm2_avg = sum[0];
+            total           = (size_t)(sum[1] + 0.5);
+        }
+
+        error_norm2_avg /= total;
+        m_telemetry.phase(misc::instrument::FORWARD);
+
+        // Get learning factor
+        const Base_t alpha = criterion(error_norm2_avg);
+        if (0 == alpha && NULL == input_errors)
+            return observed(set_size, error_norm2_avg, alpha, 0);
+
+        // Compute batch backward stage
+        m_grad.assign(m_net.param_cnt(), 0);
+        m_net.backward(set_size, m_act.data(), m_nets.data(), m_delta.data(),
+            m_grad.data());
+
+        // Provide input errors
+        if (input_errors) {
+            input_errors->resize(set_size);
+
+            for (r = 0; r < set_size; ++r)
+                get_input_error(r, (*input_errors)[r]);
+        }
+
+        m_telemetry.phase(misc::instrument::BACKWARD);
+
+        if (0 == alpha)
+            return observed(
+                set_size, error_norm2_avg, alpha, (Base_t)1 / set_size);
+
+        // Sum gradient over the ranks
+        if (m_allreduce) (*m_allreduce)(m_grad.data(), m_grad.size());
+
+        // Update batch
+        m_net.update(alpha / total, m_grad);
+        m_telemetry.phase(misc::instrument::UPDATE);
+
+        return observed(set_size, error_norm2_avg, alpha, (Base_t)1 / total);
+    }
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  nn      Neural network
+     *  \param  layers  Layers (input layer first, output layer last)
+     *  \param  fixes   Hard fixations (bias source)
+     */
+    layered_backprop(
+        nn_t           & nn,
+        const layers_t & layers,
+        const fixes_t  & fixes = fixes_t())
+    :
+        m_net(nn, layers, fixes),
+        m_allreduce(NULL)
+    {}
+
+    /**
+     *  \brief  Check whether the network is layered
+     *
+     *  If not, the training is not available (and the generic
+     *  \ref backpropagation should be used).
+     *  Note that the plan is only re-created on topology change
+     *  by \ref refresh (or training).
+     */
+    bool valid() const { return m_net.valid(); }
+
+    /**
+     *  \brief  Refresh the plan (see \c impl::layered_net::refresh)
+     *
+     *  \return \c true iff the network is layered
+     */
+    bool refresh() { return m_net.refresh(); }
+
+    /**
+     *  \brief  Re-read synapses weights
+     *
+     *  Only necessary if the weights were changed unnoticed by
+     *  the network (see \c topo::nn::version).
+     */
+    void sync() { m_net.sync(); }
+
+    /**
+     *  \brief  Reserve buffers
+     *
+     *  Training sets of up to \c rows samples are then processed
+     *  without memory allocation (unless input errors are required).
+     *
+     *  \param  rows  Row count
+     */
+    void reserve(size_t rows) {
+        this->rows(rows);
+        m_grad.reserve(m_net.param_cnt());
+    }
+
+    /**
+     *  \brief  Set executor
+     *
+     *  The batch rows are then processed in parallel (and the gradient
+     *  accumulated by parallel matrix products).
+     *
+     *  \param  exec  Executor (or \c NULL)
+     */
+    void executor(misc::executor * exec) { m_net.executor(exec); }
+
+    /**
+     *  \brief  Set data-parallel batch training
+     *
+     *  See \ref backpropagation::allreduce.
+     *
+     *  \param  allreduce  All-reduce (or \c NULL)
+     */
+    void allreduce(misc::allreduce<Base_t> * allreduce) {
+        m_allreduce = allreduce;
+    }
+
+    /** Training observer (or \c NULL) */
+    telemetry::observer * observer() const { return m_telemetry.get(); }
+
+    /**
+     *  \brief  Set training observer
+     *
+     *  See \ref backpropagation::observer.
+     *
+     *  \param  obs  Observer (or \c NULL)
+     */
+    void observer(telemetry::observer * obs) { m_telemetry.set(obs); }
+
+    /** End epoch (see \ref backpropagation::epoch) */
+    void epoch() { m_telemetry.epoch(); }
+
+    /**
+     *  \brief  Gradient (of the last training)
+     *
+     *  Note that parameters are indexed by the dense plan (i.e. not
+     *  by the synapses); unbound parameters (e.g. the upper triangle
+     *  of lateral synapses matrix) are junk.
+     */
+    const std::vector<Base_t> & gradient() const { return m_grad; }
+
+    /**
+     *  \brief  Run backpropagation on a single input/output pair
+     *
+     *  See \ref backpropagation.
+     *
+     *  \tparam Input      Input container type (iterable)
+     *  \tparam Output     Output container type (iterable)
+     *  \tparam Criterion  Update criterion type
+     *  \param  input      Input
+     *  \param  output     Output (desired)
+     *  \param  criterion  Update criterion
+     *
+     *  \return Error norm squared
+     */
+    template <class Input, class Output, class Criterion>
+    Base_t operator () (
+        const Input  & input,
+        const Output & output,
+        Criterion    & criterion)
+    {
+        return online(input, output, criterion, NULL);
+    }
+
+    /**
+     *  \brief  Run backpropagation on a single pair, provide input error
+     *
+     *  See \ref backpropagation.
+     *
+     *  \tparam Input        Input container type (iterable)
+     *  \tparam Output       Output container type (iterable)
+     *  \tparam Criterion    Update criterion type
+     *  \param  input        Input
+     *  \param  output       Output (desired)
+     *  \param  criterion    Update criterion
+     *  \param  input_error  Input error
+     *
+     *  \return Error norm squared
+     */
+    template <class Input, class Output, class Criterion>
+    Base_t operator () (
+        const Input         & input,
+        const Output        & output,
+        Criterion           & criterion,
+        std::vector<Base_t> & input_error)
+    {
+        return online(input, output, criterion, &input_error);
+    }
+
+    /**
+     *  \brief  Run backpropagation on a training set
+     *
+     *  See \ref backpropagation.
+     *
+     *  \tparam TSet       Training set (iterable container of
+     *                     \c std::pair containing [input, output] samples)
+     *  \tparam Criterion  Update criterion type
+     *  \param  set        Training set
+     *  \param  criterion  Update criterion
+     *
+     *  \return Error norm squared average
+     */
+    template <class TSet, class Criterion>
+    Base_t operator () (
+        const TSet   & set,
+        Criterion    & criterion)
+    {
+        return batch(set, criterion, NULL);
+    }
+
+    /**
+     *  \brief  Run backpropagation on a training set, provide input errors
+     *
+     *  See \ref backpropagation.
+     *
+     *  \tparam TSet          Training set (see the batch mode overload)
+     *  \tparam Criterion     Update criterion type
+     *  \param  set           Training set
+     *  \param  criterion     Update criterion
+     *  \param  input_errors  Input errors (per training sample)
+     *
+     *  \return Error norm squared average
+     */
+    template <class TSet, class Criterion>
+    Base_t operator () (
+        const TSet                        & set,
+        Criterion                         & criterion,
+        std::vector<std::vector<Base_t> > & input_errors)
+    {
+        return batch(set, criterion, &input_errors);
+    }
+
+};  // end of template class layered_backprop
+
+}}  // end of namespace libnn::ml
+
+// Explicit instantiations (see libnn/instances.hxx)
+#ifndef LIBNN_HEADER_ONLY
+/** \cond */
+namespace libnn {
+namespace ml {
+
+#define LIBNN_EXTERN(Base_t, Act_fn) \
+    extern template class impl::layered_net<Base_t, Act_fn>; \
+    extern template class layered_func<Base_t, Act_fn>; \
+    extern template class layered_backprop<Base_t, Act_fn>;
+LIBNN_INSTANCES(LIBNN_EXTERN)
+
+#undef LIBNN_EXTERN
+
+}}  // end of namespace libnn::ml
+/** \endcond */
+#endif  // end of #ifndef LIBNN_HEADER_ONLY
+
+#endif  // end of #ifndef libnn__ml__layered_hxx
@@ -0,0 +1,374 @@
+#ifndef libnn__ml__micro_batch_hxx
+#define libnn__ml__micro_batch_hxx
+
+/**
+ *  Micro-batching network evaluation
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libnn/misc/latency.hxx"
+
+#include <cstddef>
+#include <vector>
+#include <deque>
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <chrono>
+#include <exception>
+#include <stdexcept>
+
+
+namespace libnn {
+namespace ml {
+
+/**
+ *  \brief  Micro-batching evaluation
+ *
+ *  Groups single-input evaluation requests (coming from many threads,
+ *  e.g. clients of an inference server) to batches evaluated at once,
+ *  so that the batched evaluation efficiency (matrix products) isn't
+ *  lost.
+ *  A batch is closed when \c max_batch requests are pending or when
+ *  the oldest pending request waited for the \c window; then it's
+ *  evaluated by a dispatcher thread and the results are scattered back
+ *  to the requesters.
+ *  The window thus bounds the latency added by the batching.
+ *  If a batch evaluation fails, its requests are evaluated one by one,
+ *  so that an invalid request doesn't fail the others.
+ *
+ *  \tparam  Base_t    Base numeric type
+ *  \tparam  Function  Network function providing batch evaluation
+ *                     (\c batch(inputs), e.g.
+ *                     \c model::feed_forward::function_t)
+ */
+template <typename Base_t, class Function>
+class micro_batcher {
+    public:
+
+    typedef std::vector<Base_t>               input_t;   /**< Input         */
+    typedef std::vector<Base_t>               output_t;  /**< Output        */
+    typedef std::chrono::steady_clock         clock_t;   /**< Clock         */
+    typedef std::chrono::microseconds         window_t;  /**< Window        */
+
+    /** Statistics */
+    struct stats {
+        size_t requests;     /**< Evaluated requests            */
+        size_t batches;      /**< Evaluated batches             */
+        double batch_avg;    /**< Average batch size            */
+        double latency_p50;  /**< Latency median (seconds)      */
+        double latency_p99;  /**< Latency 99th percentile       */
+        double latency_max;  /**< Maximal latency               */
+        double throughput;   /**< Requests per second (overall) */
+    };  // end of struct stats
+
+    private:
+
+    /** Request */
+    struct request {
+        input_t                 input;    /**< Input              */
+        std::promise<output_t>  result;   /**< Result             */
+        clock_t::time_point     arrival;  /**< Submission time    */
+    };  // end of struct request
+
+    typedef std::unique_ptr<request> request_ptr;  /**< Request pointer */
+
+    Function &                m_fn;         /**< Network function       */
+    const size_t              m_max_batch;  /**< Maximal batch size     */
+    const window_t            m_window;     /**< Batching window        */
+    std::mutex                m_mutex;      /**< Queue mutex            */
+    std::condition_variable   m_cond;       /**< Queue condition        */
+    std::deque<request_ptr>   m_queue;      /**< Pending requests       */
+    bool                      m_stop;       /**< Stop flag              */
+    mutable std::mutex        m_stats_mx;   /**< Statistics mutex       */
+    misc::latency_stats       m_latency;    /**< Request latencies      */
+    size_t                    m_batches;    /**< Batch count            */
+    clock_t::time_point       m_start;      /**< Statistics start       */
+    std::thread               m_thread;     /**< Dispatcher thread      */
+
+    /**
+     *  \brief  Take batch
+     *
+     *  Waits for the batch to be closed.
+     *
+     *  \param  batch  Batch
+     *
+     *  \return \c false iff stopped (and no requests are pending)
+     */
+    bool take(std::vector<request_ptr> & batch) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        m_cond.wait(lock, [this]() { return m_stop || !m_queue.empty(); });
+
+        if (m_queue.empty()) return false;
+
+        const clock_t::time_point deadline =
+            m_queue.front()->arrival + m_window;
+
+        m_cond.wait_until(lock, deadline, [this]() {
+            return m_stop || m_queue.size() >= m_max_batch;
+        });
+
+        const size_t cnt = std::min(m_queue.size(), m_max_batch);
+        for (size_t i = 0; i < cnt; ++i) {
+            batch.push_back(std::move(m_queue.front()));
+            m_queue.pop_front();
+        }
+
+        return true;
+    }
+
+    /**
+     *  \brief  Evaluate failed batch requests one by one
+     *
+     *  So that an invalid request only fails itself.
+     *
+     *  \param  batch   Batch
+     *  \param  inputs  Batch inputs
+     */
+    void isolate(
+        std::vector<request_ptr> & batch,
+        std::vector<input_t>     & inputs)
+    {
+        std::vector<input_t> single(1);
+
+        for (size_t i = 0; i < batch.size(); ++i) {
+            single[0].swap(inputs[i]);
+
+            try {
+                std::vector<output_t> outputs = m_fn.batch(single);
+
+                if (1 != outputs.size())
+                    throw std::logic_error(
+                        "libnn::ml::micro_batcher: "
+                        "batch output count mismatch");
+
+                batch[i]->result.set_value(std::move(outputs[0]));
+            }
+            catch (...) {
+                batch[i]->result.set_exception(std::current_exception());
+            }
+
+            single[0].swap(inputs[i]);
+        }
+    }
+
+    /** Dispatcher thread routine */
+    void run() {
+        std::vector<request_ptr> batch;
+        std::vector<input_t>     inputs;
+
+        while (take(batch)) {
+            inputs.resize(batch.size());
+            for (size_t i = 0; i < batch.size(); ++i)
+                inputs[i].swap(batch[i]->input);
+
+            try {
+                std::vector<output_t> outputs = m_fn.batch(inputs);
+
+                if (outputs.size() != batch.size())
+                    throw std::logic_error(
+                        "libnn::ml::micro_batcher: "
+                        "batch output count mismatch");
+
+                for (size_t i = 0; i < batch.size(); ++i)
+                    batch[i]->result.set_value(std::move(outputs[i]));
+            }
+            catch (...) {
+                if (1 == batch.size())
+                    batch[0]->result.set_exception(std::current_exception());
+                else
+                    isolate(batch, inputs);
+            }
+
+            const clock_t::time_point now = clock_t::now();
+            {
+                std::lock_guard<std::mutex> lock(m_stats_mx);
+
+                for (size_t i = 0; i < batch.size(); ++i)
+                    m_latency.record(std::chrono::duration<double>(
+                        now - batch[i]->arrival).count());
+
+                ++m_batches;
+            }
+
+            batch.clear();
+        }
+    }
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  Starts the dispatcher thread.
+     *
+     *  \param  fn         Network function (only used by the dispatcher)
+     *  \param  max_batch  Maximal batch size
+     *  \param  window     Batching window
+     */
+    micro_batcher(
+        Function & fn,
+        size_t     max_batch = 64,
+        window_t   window    = window_t(1000))
+    :
+        m_fn(fn),
+        m_max_batch(std::max<size_t>(1, max_batch)),
+        m_window(window),
+        m_stop(false),
+        m_batches(0),
+        m_start(clock_t::now())
+    {
+        m_thread = std::thread([this]() { run(); });
+    }
+
+    /** Maximal batch size */
+    size_t max_batch() const { return m_max_batch; }
+
+    /** Batching window */
+    window_t window() const { return m_window; }
+
+    /**
+     *  \brief  Submit evaluation request
+     *
+     *  Thread-safe.
+     *
+     *  \param  input  Input
+     *
+     *  \return Output future
+     */
+    std::future<output_t> submit(input_t input) {
+        request_ptr req(new request());
+        req->input   = std::move(input);
+        req->arrival = clock_t::now();
+
+        std::future<output_t> result = req->result.get_future();
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (m_stop)
+                throw std::logic_error(
+                    "libnn::ml::micro_batcher: "
+                    "stopped");
+
+            m_queue.push_back(std::move(req));
+
+            if (1 == m_queue.size() || m_queue.size() >= m_max_batch)
+                m_cond.notify_one();
+        }
+
+        return result;
+    }
+
+    /**
+     *  \brief  Evaluate input
+     *
+     *  Submits the request and waits for the result.
+     *
+     *  \param  input  Input
+     *
+     *  \return Output
+     */
+    output_t operator () (input_t input) {
+        return submit(std::move(input)).get();
+    }
+
+    /** Statistics (since construction or the last reset) */
+    stats statistics() const {
+        std::lock_guard<std::mutex> lock(m_stats_mx);
+
+        const double elapsed = std::chrono::duration<double>(
+            clock_t::now() - m_start).count();
+
+        stats st;
+        st.requests    = m_latency.count();
+        st.batches     = m_batches;
+        st.batch_avg   = m_batches ? (double)st.requests / m_batches : 0;
+        st.latency_p50 = m_latency.percentile(50);
+        st.latency_p99 = m_latency.percentile(99);
+        st.latency_max = m_latency.max();
+        st.throughput  = elapsed > 0 ? st.requests / elapsed : 0;
+
+        return st;
+    }
+
+    /** Reset statistics */
+    void reset_statistics() {
+        std::lock_guard<std::mutex> lock(m_stats_mx);
+
+        m_latency.reset();
+        m_batches = 0;
+        m_start   = clock_t::now();
+    }
+
+    /**
+     *  \brief  Stop
+     *
+     *  Pending requests are evaluated; further submissions fail.
+     */
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (m_stop) return;
+
+            m_stop = true;
+            m_cond.notify_one();
+        }
+
+        m_thread.join();
+    }
+
+    /** Copying is forbidden */
+    micro_batcher(const micro_batcher & orig) = delete;
+
+    /** Assignment is forbidden */
+    void operator = (const micro_batcher & rarg) = delete;
+
+    /** Destructor */
+    ~micro_batcher() { stop(); }
+
+};  // end of template class micro_batcher
+
+}}  // end of namespace libnn::ml
+
+
+#endif  // end of #ifndef libnn__ml__micro_batch_hxx
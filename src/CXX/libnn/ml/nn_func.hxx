@@ -40,6 +40,7 @@
  *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include "libnn/instances.hxx"
 #include "libnn/topo/nn.hxx"
 #include "libnn/ml/computation.hxx"
 
@@ -80,9 +81,11 @@ class nn_func: public computation<Base_t, Act_fn, Base_t> {
     Base_t f(const typename nn_t::neuron & n) {
         Base_t net = 0;
 
+        this->tally().add(misc::instrument::MULADDS, n.dendrite_cnt());
+
         n.for_each_dendrite(
         [&net, this](const typename nn_t::neuron::dendrite & dend) {
-            net += dend.weight * this->fx(dend.source.index());
+            net += dend.weight() * this->fx(dend.source().index());
         });
 
         return n.act_fn(net);
@@ -93,9 +96,15 @@ class nn_func: public computation<Base_t, Act_fn, Base_t> {
     /**
      *  \brief  Constructor
      *
-     *  \param  network  Neural network
+     *  \param  network   Neural network
+     *  \param  resource  Memory resource (for the results, optional)
      */
-    nn_func(const nn_t & network): computation_t(network) {}
+    nn_func(
+        const nn_t            & network,
+        misc::memory_resource * resource = misc::new_delete_resource())
+    :
+        computation_t(network, resource)
+    {}
 
     /**
      *  \brief  Compute network function
@@ -107,6 +116,9 @@ class nn_func: public computation<Base_t, Act_fn, Base_t> {
      */
     template <class Input>
     std::vector<Base_t> operator () (const Input & input) {
+        misc::instrument::phase_timer timer(
+            misc::instrument::FORWARD, this->tally());
+
         this->reset();  // make sure all is clean
 
         // Set input layer
@@ -132,4 +144,21 @@ class nn_func: public computation<Base_t, Act_fn, Base_t> {
 
 }}  // end of namespace libnn::ml
 
+// Explicit instantiations (see libnn/instances.hxx)
+#ifndef LIBNN_HEADER_ONLY
+/** \cond */
+namespace libnn {
+namespace ml {
+
+#define LIBNN_EXTERN(Base_t, Act_fn) \
+    extern template class computation<Base_t, Act_fn, Base_t>; \
+    extern template class nn_func<Base_t, Act_fn>;
+LIBNN_INSTANCES(LIBNN_EXTERN)
+
+#undef LIBNN_EXTERN
+
+}}  // end of namespace libnn::ml
+/** \endcond */
+#endif  // end of #ifndef LIBNN_HEADER_ONLY
+
 #endif  // end of #ifndef libnn__ml__nn_func_hxx
@@ -0,0 +1,367 @@
+#ifndef libnn__ml__numa_hxx
+#define libnn__ml__numa_hxx
+
+/**
+ *  NUMA-aware layered network function
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libnn/ml/layered.hxx"
+#include "libnn/misc/thread_pool.hxx"
+#include "libnn/misc/numa.hxx"
+
+#include <vector>
+#include <memory>
+#include <future>
+#include <algorithm>
+#include <stdexcept>
+
+
+namespace libnn {
+namespace ml {
+
+/**
+ *  \brief  NUMA-aware layered network function (serving mode)
+ *
+ *  The dense evaluation plan (see \ref impl::layered_net) is replicated
+ *  on each NUMA node.
+ *  Each replica is created by a thread running on its node (so that
+ *  the weight matrices are allocated locally) and its memory is bound
+ *  to the node.
+ *  Each node has a thread pool with workers pinned to the node CPUs;
+ *  the workers only read their local replica.
+ *
+ *  A batch of inputs is split among the nodes (proportionally to their
+ *  worker counts) and evaluated by the node workers.
+ *  Single inputs are evaluated by the calling thread, using replica
+ *  of the node it runs on.
+ *
+ *  The synapses weights are copied at construction; \ref reload
+ *  re-reads them to new replicas, which replace the current ones
+ *  atomically (i.e. evaluations in progress finish with the old ones).
+ *  The function may be used by multiple threads concurrently.
+ *
+ *  \tparam  Base_t  Base numeric type
+ *  \tparam  Act_fn  Activation function
+ */
+template <typename Base_t, class Act_fn>
+class numa_func {
+    private:
+
+    /** Evaluation plan type */
+    typedef impl::layered_net<Base_t, Act_fn> net_t;
+
+    public:
+
+    typedef typename net_t::nn_t     nn_t;      /**< Neural network type */
+    typedef typename net_t::layers_t layers_t;  /**< Layers              */
+    typedef typename net_t::fixes_t  fixes_t;   /**< Hard fixations      */
+
+    typedef std::vector<Base_t>   output_t;   /**< Output  */
+    typedef std::vector<output_t> outputs_t;  /**< Outputs */
+
+    private:
+
+    /** Minimal count of rows evaluated at once */
+    static const size_t rows_min = 8;
+
+    /** Node replica */
+    struct replica {
+        int                                node;  /**< NUMA node      */
+        std::unique_ptr<misc::thread_pool> pool;  /**< Pinned workers */
+        std::shared_ptr<const net_t>       net;   /**< Local plan     */
+    };  // end of struct replica
+
+    const nn_t &         m_nn;         /**< Neural network        */
+    layers_t             m_layers;     /**< Layers                */
+    fixes_t              m_fixes;      /**< Hard fixations        */
+    bool                 m_replicate;  /**< Replicate the plan    */
+    std::vector<replica> m_replicas;   /**< Node replicas         */
+
+    /**
+     *  \brief  Create plan replica on a node
+     *
+     *  The plan is created by a node worker (first touch) and bound
+     *  to the node.
+     *
+     *  \param  r  Replica
+     *
+     *  \return Plan
+     */
+    std::shared_ptr<const net_t> create(replica & r) const {
+        std::shared_ptr<const net_t> net;
+
+        r.pool->submit([this, &r, &net]() {
+            std::shared_ptr<net_t> n(new net_t(m_nn, m_layers, m_fixes));
+
+            misc::numa::bind(n->param().data(),
+                n->param().size() * sizeof(Base_t), r.node);
+
+            net = n;
+        }).get();
+
+        if (!net->valid())
+            throw std::logic_error(
+                "libnn::ml::numa_func: "
+                "the network is not layered");
+
+        return net;
+    }
+
+    /** Rows buffers */
+    struct buffers {
+        std::vector<Base_t> act;   /**< Activations */
+        std::vector<Base_t> nets;  /**< Net inputs  */
+    };  // end of struct buffers
+
+    /**
+     *  \brief  Per-thread rows buffers (allocated by the local thread)
+     *
+     *  \param  size  Minimal size
+     *
+     *  \return Buffers of the calling thread
+     */
+    static buffers & local_buffers(size_t size) {
+        static thread_local buffers buf;
+
+        if (buf.act.size() < size) {
+            buf.act.resize(size);
+            buf.nets.resize(size);
+        }
+
+        return buf;
+    }
+
+    /**
+     *  \brief  Evaluate rows
+     *
+     *  \tparam Inputs   Inputs container type (random access)
+     *  \param  net      Plan
+     *  \param  inputs   Inputs
+     *  \param  outputs  Outputs
+     *  \param  begin    First row
+     *  \param  end      Last row plus one
+     */
+    template <class Inputs>
+    static void evaluate(
+        const net_t  & net,
+        const Inputs & inputs,
+        outputs_t    & outputs,
+        size_t         begin,
+        size_t         end)
+    {
+        const size_t width = net.width();
+        const size_t cnt   = end - begin;
+
+        buffers & buf = local_buffers(cnt * width);
+
+        for (size_t r = 0; r < cnt; ++r)
+            net.set_input(buf.act.data() + r * width, inputs[begin + r]);
+
+        net.forward(cnt, buf.act.data(), buf.nets.data());
+
+        for (size_t r = 0; r < cnt; ++r) {
+            const Base_t * out =
+                buf.act.data() + r * width + net.output_begin();
+            outputs[begin + r].assign(out, out + net.output_size());
+        }
+    }
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  nn         Neural network
+     *  \param  layers     Layers (input layer first, output layer last)
+     *  \param  fixes      Hard fixations (bias source)
+     *  \param  threads    Workers per node (0 means all the node CPUs)
+     *  \param  replicate  Replicate the plan on each node (if \c false,
+     *                     all nodes share the 1st node plan; that's only
+     *                     useful for comparison)
+     */
+    numa_func(
+        const nn_t     & nn,
+        const layers_t & layers,
+        const fixes_t  & fixes     = fixes_t(),
+        size_t           threads   = 0,
+        bool             replicate = true)
+    :
+        m_nn(nn),
+        m_layers(layers),
+        m_fixes(fixes),
+        m_replicate(replicate)
+    {
+        const std::vector<int> nodes = misc::numa::nodes();
+
+        m_replicas.resize(nodes.size());
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            replica & r = m_replicas[i];
+
+            const std::vector<int> cpus = misc::numa::cpus(nodes[i]);
+
+            r.node = nodes[i];
+            r.pool.reset(new misc::thread_pool(
+                threads ? threads : std::max<size_t>(1, cpus.size()), cpus));
+        }
+
+        reload();
+    }
+
+    /** Node count */
+    size_t nodes() const { return m_replicas.size(); }
+
+    /**
+     *  \brief  Node workers count
+     *
+     *  \param  i  Node index (not the node number)
+     */
+    size_t workers(size_t i) const { return m_replicas.at(i).pool->size(); }
+
+    /**
+     *  \brief  Re-read synapses weights (hot reload)
+     *
+     *  New replicas are created and replace the current ones.
+     *  Concurrent evaluations aren't blocked; they use either the old
+     *  or the new weights.
+     *  NOTE that the network shall not be modified during the reload.
+     */
+    void reload() {
+        std::shared_ptr<const net_t> first;
+
+        for (size_t i = 0; i < m_replicas.size(); ++i) {
+            replica & r = m_replicas[i];
+
+            std::shared_ptr<const net_t> net =
+                m_replicate || 0 == i ? create(r) : first;
+
+            if (0 == i) first = net;
+
+            std::atomic_store(&r.net, net);
+        }
+    }
+
+    /**
+     *  \brief  Compute network function (by the calling thread)
+     *
+     *  The replica of the calling thread node is used; the row is
+     *  evaluated in the calling thread buffers (no batch is formed).
+     *
+     *  \tparam Input  Input container type (iterable)
+     *  \param  input  Input
+     *
+     *  \return Output vector
+     */
+    template <class Input>
+    output_t operator () (const Input & input) const {
+        const int node = misc::numa::current_node();
+
+        size_t i = 0;
+        while (i < m_replicas.size() && node != m_replicas[i].node) ++i;
+        if (i == m_replicas.size()) i = 0;
+
+        const std::shared_ptr<const net_t> net =
+            std::atomic_load(&m_replicas[i].net);
+
+        buffers & buf = local_buffers(net->width());
+
+        net->set_input(buf.act.data(), input);
+        net->forward(1, buf.act.data(), buf.nets.data());
+
+        const Base_t * out = buf.act.data() + net->output_begin();
+        return output_t(out, out + net->output_size());
+    }
+
+    /**
+     *  \brief  Compute network function for a batch of inputs
+     *
+     *  The inputs are split among the nodes and evaluated by the node
+     *  workers.
+     *
+     *  \tparam Inputs  Inputs container type (random access)
+     *  \param  inputs  Inputs
+     *
+     *  \return Outputs (in order of the inputs)
+     */
+    template <class Inputs>
+    outputs_t batch(const Inputs & inputs) const {
+        const size_t cnt = inputs.size();
+        outputs_t outputs(cnt);
+
+        size_t total = 0;
+        for (size_t i = 0; i < m_replicas.size(); ++i)
+            total += m_replicas[i].pool->size();
+
+        std::vector<std::future<void> > done;
+        done.reserve(m_replicas.size());
+
+        size_t begin = 0, workers = 0;
+        for (size_t i = 0; i < m_replicas.size(); ++i) {
+            const replica & r = m_replicas[i];
+
+            workers += r.pool->size();
+
+            const size_t end = cnt * workers / total;
+            if (!(begin < end)) continue;
+
+            misc::thread_pool & pool = *r.pool;
+            const std::shared_ptr<const net_t> net = std::atomic_load(&r.net);
+
+            done.push_back(pool.submit(
+            [&pool, net, &inputs, &outputs, begin, end]() {
+                pool.parallel_for(begin, end,
+                [&net, &inputs, &outputs](size_t b, size_t e) {
+                    evaluate(*net, inputs, outputs, b, e);
+                }, rows_min);
+            }));
+
+            begin = end;
+        }
+
+        // All the tasks must finish before an error is reported
+        for (size_t i = 0; i < done.size(); ++i) done[i].wait();
+        for (size_t i = 0; i < done.size(); ++i) done[i].get();
+
+        return outputs;
+    }
+
+};  // end of template class numa_func
+
+}}  // end of namespace libnn::ml
+
+
+#endif  // end of #ifndef libnn__ml__numa_hxx
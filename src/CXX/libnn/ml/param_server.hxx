@@ -0,0 +1,1085 @@
+#ifndef libnn__ml__param_server_hxx
+#define libnn__ml__param_server_hxx
+
+/**
+ *  Parameter server training
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libnn/misc/unix_socket.hxx"
+
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <list>
+#include <string>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+extern "C" {
+#include <unistd.h>
+}
+
+
+namespace libnn {
+namespace ml {
+
+/**
+ *  \brief  Parameter server update
+ *
+ *  Update of the parameters (synapses weights) pushed by a worker;
+ *  the server subtracts it from the parameters.
+ *  The update may be compressed (see \ref ps_compressor):
+ *  - \c DENSE: all the values
+ *  - \c TOPK: sparse values (indices and values)
+ *  - \c QUANT8: all the values quantised to 8 bits (\c scale multiples)
+ *
+ *  \tparam  Base_t  Base numeric type
+ */
+template <typename Base_t>
+struct ps_update {
+    /** Encoding */
+    enum encoding_t {
+        DENSE = 0,  /**< Dense values            */
+        TOPK,       /**< Sparse values           */
+        QUANT8      /**< 8-bit quantised values  */
+    };  // end of enum encoding_t
+
+    uint64_t              worker;    /**< Worker                      */
+    uint64_t              clock;     /**< Worker clock (update count) */
+    uint64_t              size;      /**< Parameter count             */
+    encoding_t            encoding;  /**< Encoding                    */
+    std::vector<uint32_t> index;     /**< Indices (\c TOPK)           */
+    std::vector<Base_t>   value;     /**< Values (\c DENSE, \c TOPK)  */
+    std::vector<int8_t>   qvalue;    /**< Values (\c QUANT8)          */
+    Base_t                scale;     /**< Quantum (\c QUANT8)         */
+
+    /** Constructor */
+    ps_update():
+        worker(0), clock(0), size(0), encoding(DENSE), scale(0)
+    {}
+
+    /**
+     *  \brief  Encoded size (bytes)
+     *
+     *  Size of the update values (i.e. the transferred data).
+     */
+    size_t bytes() const {
+        switch (encoding) {
+            case TOPK:
+                return index.size() * sizeof(uint32_t)
+                    + value.size() * sizeof(Base_t);
+
+            case QUANT8:
+                return sizeof(Base_t) + qvalue.size();
+
+            default:
+                return value.size() * sizeof(Base_t);
+        }
+    }
+
+    /**
+     *  \brief  Subtract the update from parameters
+     *
+     *  \param  params  Parameters
+     */
+    void apply(std::vector<Base_t> & params) const {
+        if (params.size() != size)
+            throw std::logic_error(
+                "libnn::ml::ps_update: "
+                "parameter count mismatch");
+
+        switch (encoding) {
+            case TOPK:
+                if (index.size() != value.size())
+                    throw std::logic_error(
+                        "libnn::ml::ps_update: "
+                        "invalid sparse update");
+
+                for (size_t i = 0; i < index.size(); ++i) {
+                    if (index[i] >= size)
+                        throw std::range_error(
+                            "libnn::ml::ps_update: "
+                            "index out of range");
+
+                    params[index[i]] -= value[i];
+                }
+
+                break;
+
+            case QUANT8:
+                if (qvalue.size() != size)
+                    throw std::logic_error(
+                        "libnn::ml::ps_update: "
+                        "invalid quantised update");
+
+                for (size_t i = 0; i < size; ++i)
+                    params[i] -= scale * qvalue[i];
+
+                break;
+
+            default:
+                if (value.size() != size)
+                    throw std::logic_error(
+                        "libnn::ml::ps_update: "
+                        "invalid dense update");
+
+                for (size_t i = 0; i < size; ++i)
+                    params[i] -= value[i];
+
+                break;
+        }
+    }
+
+};  // end of template struct ps_update
+
+
+/**
+ *  \brief  Update compressor
+ *
+ *  Encodes updates (see \ref ps_update):
+ *  - \c TOPK sparsification keeps the \c ratio of the largest (by
+ *    magnitude) values
+ *  - \c QUANT8 quantisation rounds the values to multiples of 1/127
+ *    of the largest magnitude
+ *
+ *  The compression error is fed back, i.e. the residual (values that
+ *  weren't sent or their rounding errors) is added to the next update,
+ *  so no part of the update is lost (only delayed).
+ *
+ *  \tparam  Base_t  Base numeric type
+ */
+template <typename Base_t>
+class ps_compressor {
+    public:
+
+    typedef ps_update<Base_t>                   update_t;    /**< Update   */
+    typedef typename update_t::encoding_t       encoding_t;  /**< Encoding */
+
+    private:
+
+    encoding_t          m_encoding;  /**< Encoding                      */
+    double              m_ratio;     /**< Kept values ratio (\c TOPK)   */
+    std::vector<Base_t> m_residual;  /**< Compression error feedback    */
+    std::vector<size_t> m_order;     /**< Indices (selection buffer)    */
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  encoding  Encoding
+     *  \param  ratio     Ratio of kept values (\c TOPK; at least 1 value
+     *                    is kept)
+     */
+    ps_compressor(
+        encoding_t encoding = update_t::DENSE,
+        double     ratio    = 0.01)
+    :
+        m_encoding(encoding),
+        m_ratio(ratio)
+    {
+        if (!(0 < ratio && ratio <= 1))
+            throw std::range_error(
+                "libnn::ml::ps_compressor: "
+                "ratio out of (0, 1]");
+    }
+
+    /** Encoding */
+    encoding_t encoding() const { return m_encoding; }
+
+    /** Residual (compression error not sent yet) */
+    const std::vector<Base_t> & residual() const { return m_residual; }
+
+    /**
+     *  \brief  Compress update
+     *
+     *  \param  delta   Update values
+     *  \param  update  Update (values and encoding are set)
+     */
+    void operator () (const std::vector<Base_t> & delta, update_t & update) {
+        const size_t size = delta.size();
+
+        update.size     = size;
+        update.encoding = m_encoding;
+        update.index.clear();
+        update.value.clear();
+        update.qvalue.clear();
+        update.scale = 0;
+
+        if (update_t::DENSE == m_encoding) {
+            update.value = delta;
+            return;
+        }
+
+        // Error feedback
+        m_residual.resize(size, 0);
+        for (size_t i = 0; i < size; ++i) m_residual[i] += delta[i];
+
+        if (update_t::TOPK == m_encoding) {
+            const size_t k = std::min(size, std::max<size_t>(1,
+                (size_t)std::ceil(m_ratio * size)));
+
+            m_order.resize(size);
+            for (size_t i = 0; i < size; ++i) m_order[i] = i;
+
+            const std::vector<Base_t> & res = m_residual;
+            std::nth_element(m_order.begin(), m_order.begin() + k,
+                m_order.end(),
+            [&res](size_t i, size_t j) {
+                return std::abs(res[i]) > std::abs(res[j]);
+            });
+
+            std::sort(m_order.begin(), m_order.begin() + k);
+
+            update.index.reserve(k);
+            update.value.reserve(k);
+            for (size_t i = 0; i < k; ++i) {
+                const size_t j = m_order[i];
+
+                update.index.push_back((uint32_t)j);
+                update.value.push_back(m_residual[j]);
+                m_residual[j] = 0;
+            }
+
+            return;
+        }
+
+        // 8-bit quantisation
+        Base_t max = 0;
+        for (size_t i = 0; i < size; ++i)
+            max = std::max(max, std::abs(m_residual[i]));
+
+        update.scale = max / 127;
+        update.qvalue.resize(size, 0);
+
+        if (0 == max) return;
+
+        for (size_t i = 0; i < size; ++i) {
+            const Base_t q = std::round(m_residual[i] / update.scale);
+            const int8_t q8 = (int8_t)std::max<Base_t>(-127,
+                std::min<Base_t>(127, q));
+
+            update.qvalue[i] = q8;
+            m_residual[i] -= update.scale * q8;
+        }
+    }
+
+};  // end of template class ps_compressor
+
+
+/**
+ *  \brief  Parameter server
+ *
+ *  Keeps the parameters (synapses weights) of a network trained by
+ *  several workers (see \ref ps_worker).
+ *  Workers pull the parameters, compute updates on their data
+ *  and push them; the updates are applied immediately, in order
+ *  of arrival (asynchronously).
+ *
+ *  Staleness is bounded: each worker has a clock (count of its pushed
+ *  updates); a worker may only pull (and start its next step) if its
+ *  clock exceeds the slowest worker's one by \c staleness at most.
+ *  The parameters a worker computes its update on thus contain all
+ *  the updates of all the workers except the last \c staleness ones
+ *  (per worker).
+ *  Staleness of 0 means synchronous steps; workers that finished
+ *  (see \ref done) are not waited for.
+ *
+ *  The server is thread-safe; workers communicate with it via
+ *  a transport (see \ref ps_transport).
+ *
+ *  \tparam  Base_t  Base numeric type
+ */
+template <typename Base_t>
+class param_server {
+    public:
+
+    typedef ps_update<Base_t> update_t;  /**< Update */
+
+    private:
+
+    /** Finished worker clock */
+    static const uint64_t finished = std::numeric_limits<uint64_t>::max();
+
+    mutable std::mutex      m_mutex;      /**< Operation mutex        */
+    std::condition_variable m_cond;       /**< Clock change condition */
+    std::vector<Base_t>     m_params;     /**< Parameters             */
+    std::vector<uint64_t>   m_clocks;     /**< Worker clocks          */
+    size_t                  m_staleness;  /**< Staleness bound        */
+    uint64_t                m_version;    /**< Applied updates count  */
+    uint64_t                m_max_lag;    /**< Max. observed lag      */
+    bool                    m_closed;     /**< Server closed          */
+
+    /** Slowest worker clock (lock must be held) */
+    uint64_t min_clock() const {
+        return *std::min_element(m_clocks.begin(), m_clocks.end());
+    }
+
+    /**
+     *  \brief  Check worker
+     *
+     *  \param  worker  Worker
+     */
+    void check_worker(size_t worker) const {
+        if (worker >= m_clocks.size())
+            throw std::range_error(
+                "libnn::ml::param_server: "
+                "invalid worker");
+    }
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  params     Initial parameters
+     *  \param  workers    Worker count
+     *  \param  staleness  Staleness bound (worker steps)
+     */
+    param_server(
+        const std::vector<Base_t> & params,
+        size_t                      workers,
+        size_t                      staleness = 0)
+    :
+        m_params(params),
+        m_clocks(workers, 0),
+        m_staleness(staleness),
+        m_version(0),
+        m_max_lag(0),
+        m_closed(false)
+    {
+        if (0 == workers)
+            throw std::range_error(
+                "libnn::ml::param_server: "
+                "no workers");
+    }
+
+    /** Worker count */
+    size_t workers() const { return m_clocks.size(); }
+
+    /** Staleness bound */
+    size_t staleness() const { return m_staleness; }
+
+    /** Parameters (copy) */
+    std::vector<Base_t> params() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_params;
+    }
+
+    /** Count of applied updates */
+    uint64_t version() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_version;
+    }
+
+    /**
+     *  \brief  Maximal observed lag
+     *
+     *  Maximal difference of a pulling worker clock and the slowest
+     *  worker clock (never exceeds the staleness bound).
+     */
+    uint64_t max_lag() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_max_lag;
+    }
+
+    /**
+     *  \brief  Pull parameters
+     *
+     *  Blocks until the staleness bound allows the worker to proceed.
+     *
+     *  \param  worker  Worker
+     *  \param  clock   Worker clock
+     *  \param  params  Parameters
+     *
+     *  \return Parameters version (count of applied updates)
+     */
+    uint64_t pull(size_t worker, uint64_t clock, std::vector<Base_t> & params) {
+        check_worker(worker);
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        m_cond.wait(lock, [this, clock]() {
+            return m_closed || clock <= min_clock() + m_staleness;
+        });
+
+        if (m_closed)
+            throw std::runtime_error(
+                "libnn::ml::param_server: "
+                "server closed");
+
+        const uint64_t min = min_clock();
+        if (clock > min) m_max_lag = std::max(m_max_lag, clock - min);
+
+        params = m_params;
+
+        return m_version;
+    }
+
+    /**
+     *  \brief  Push update
+     *
+     *  The update is applied and the worker clock set to the update
+     *  clock plus 1.
+     *
+     *  \param  update  Update
+     */
+    void push(const update_t & update) {
+        check_worker(update.worker);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_closed)
+            throw std::runtime_error(
+                "libnn::ml::param_server: "
+                "server closed");
+
+        update.apply(m_params);
+        ++m_version;
+
+        if (finished != m_clocks[update.worker])
+            m_clocks[update.worker] = update.clock + 1;
+
+        m_cond.notify_all();
+    }
+
+    /**
+     *  \brief  Worker finished
+     *
+     *  The worker is no longer waited for.
+     *
+     *  \param  worker  Worker
+     */
+    void done(size_t worker) {
+        check_worker(worker);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_clocks[worker] = finished;
+        m_cond.notify_all();
+    }
+
+    /**
+     *  \brief  Close the server
+     *
+     *  Blocked (and further) pulls and pushes throw an exception.
+     */
+    void close() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_closed = true;
+        m_cond.notify_all();
+    }
+
+};  // end of template class param_server
+
+/** \cond */
+template <typename Base_t> const uint64_t param_server<Base_t>::finished;
+/** \endcond */
+
+
+/**
+ *  \brief  Parameter server transport (interface)
+ *
+ *  Worker side of the communication with a \ref param_server.
+ *  Implementations are the \ref ps_local_transport (in-process)
+ *  and \ref ps_unix_transport (Unix domain socket).
+ *
+ *  \tparam  Base_t  Base numeric type
+ */
+template <typename Base_t>
+class ps_transport {
+    public:
+
+    typedef ps_update<Base_t> update_t;  /**< Update */
+
+    /**
+     *  \brief  Pull parameters (see \ref param_server::pull)
+     *
+     *  \param  worker  Worker
+     *  \param  clock   Worker clock
+     *  \param  params  Parameters
+     *
+     *  \return Parameters version
+     */
+    virtual uint64_t pull(
+        size_t                worker,
+        uint64_t              clock,
+        std::vector<Base_t> & params) = 0;
+
+    /**
+     *  \brief  Push update (see \ref param_server::push)
+     *
+     *  \param  update  Update
+     */
+    virtual void push(const update_t & update) = 0;
+
+    /**
+     *  \brief  Worker finished (see \ref param_server::done)
+     *
+     *  \param  worker  Worker
+     */
+    virtual void done(size_t worker) = 0;
+
+    /** Destructor */
+    virtual ~ps_transport() {}
+
+};  // end of template class ps_transport
+
+
+/**
+ *  \brief  In-process transport
+ *
+ *  Calls the server directly (workers are threads of the server
+ *  process).
+ *
+ *  \tparam  Base_t  Base numeric type
+ */
+template <typename Base_t>
+class ps_local_transport: public ps_transport<Base_t> {
+    public:
+
+    typedef ps_update<Base_t> update_t;  /**< Update */
+
+    private:
+
+    param_server<Base_t> & m_server;  /**< Server */
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  server  Server
+     */
+    ps_local_transport(param_server<Base_t> & server): m_server(server) {}
+
+    uint64_t pull(size_t worker, uint64_t clock, std::vector<Base_t> & params) {
+        return m_server.pull(worker, clock, params);
+    }
+
+    void push(const update_t & update) { m_server.push(update); }
+
+    void done(size_t worker) { m_server.done(worker); }
+
+};  // end of template class ps_local_transport
+
+
+namespace impl {
+
+/**
+ *  \brief  Unix socket transport protocol
+ *
+ *  Requests consist of a header (64-bit words) followed by update
+ *  values (\c PUSH only); responses consist of a header followed
+ *  by the parameters (\c PULL only).
+ *  The data are in the native byte order (the peers share a host).
+ */
+struct ps_protocol {
+    /** Request type */
+    enum request_t {
+        PULL = 0,  /**< Pull parameters */
+        PUSH,      /**< Push update     */
+        DONE       /**< Worker finished */
+    };  // end of enum request_t
+
+    /** Request header */
+    struct request {
+        uint64_t type;      /**< Request type                  */
+        uint64_t worker;    /**< Worker                        */
+        uint64_t clock;     /**< Worker clock                  */
+        uint64_t size;      /**< Parameter count (\c PUSH)     */
+        uint64_t encoding;  /**< Update encoding (\c PUSH)     */
+        uint64_t cnt;       /**< Update value count (\c PUSH)  */
+    };  // end of struct request
+
+    /** Response header */
+    struct response {
+        uint64_t status;   /**< 0 on success                 */
+        uint64_t version;  /**< Parameters version (\c PULL) */
+        uint64_t cnt;      /**< Parameter count (\c PULL)    */
+    };  // end of struct response
+
+};  // end of struct ps_protocol
+
+}  // end of namespace impl
+
+
+/**
+ *  \brief  Unix domain socket transport
+ *
+ *  Connects to a \ref ps_unix_endpoint (the workers may be processes
+ *  on the server host).
+ *  A transport instance shall only be used by one thread.
+ *
+ *  \tparam  Base_t  Base numeric type
+ */
+template <typename Base_t>
+class ps_unix_transport: public ps_transport<Base_t> {
+    public:
+
+    typedef ps_update<Base_t> update_t;  /**< Update */
+
+    private:
+
+    typedef impl::ps_protocol protocol;  /**< Protocol */
+
+    misc::unix_socket m_socket;  /**< Connection */
+
+    /** Receive response (throws on failure) */
+    protocol::response response() {
+        protocol::response resp;
+        if (!m_socket.recv(&resp, sizeof(resp)))
+            throw std::runtime_error(
+                "libnn::ml::ps_unix_transport: "
+                "connection closed");
+
+        if (0 != resp.status)
+            throw std::runtime_error(
+                "libnn::ml::ps_unix_transport: "
+                "request failed");
+
+        return resp;
+    }
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  path  Endpoint socket path
+     */
+    ps_unix_transport(const std::string & path):
+        m_socket(misc::unix_socket::connect(path))
+    {}
+
+    uint64_t pull(size_t worker, uint64_t clock, std::vector<Base_t> & params) {
+        const protocol::request req = {
+            protocol::PULL, worker, clock, 0, 0, 0 };
+
+        m_socket.send(&req, sizeof(req));
+
+        const protocol::response resp = response();
+
+        params.resize(resp.cnt);
+        m_socket.recv(params.data(), resp.cnt * sizeof(Base_t));
+
+        return resp.version;
+    }
+
+    void push(const update_t & update) {
+        const size_t cnt = update_t::QUANT8 == update.encoding
+            ? update.qvalue.size() : update.value.size();
+
+        const protocol::request req = {
+            protocol::PUSH, update.worker, update.clock, update.size,
+            (uint64_t)update.encoding, cnt };
+
+        m_socket.send(&req, sizeof(req));
+
+        switch (update.encoding) {
+            case update_t::TOPK:
+                m_socket.send(update.index.data(), cnt * sizeof(uint32_t));
+                m_socket.send(update.value.data(), cnt * sizeof(Base_t));
+                break;
+
+            case update_t::QUANT8:
+                m_socket.send(&update.scale, sizeof(Base_t));
+                m_socket.send(update.qvalue.data(), cnt);
+                break;
+
+            default:
+                m_socket.send(update.value.data(), cnt * sizeof(Base_t));
+                break;
+        }
+
+        response();
+    }
+
+    void done(size_t worker) {
+        const protocol::request req = {
+            protocol::DONE, worker, 0, 0, 0, 0 };
+
+        m_socket.send(&req, sizeof(req));
+
+        response();
+    }
+
+};  // end of template class ps_unix_transport
+
+
+/**
+ *  \brief  Unix domain socket endpoint
+ *
+ *  Serves \ref ps_unix_transport connections to a server
+ *  (each connection by a thread).
+ *
+ *  \tparam  Base_t  Base numeric type
+ */
+template <typename Base_t>
+class ps_unix_endpoint {
+    public:
+
+    typedef ps_update<Base_t> update_t;  /**< Update */
+
+    private:
+
+    typedef impl::ps_protocol protocol;  /**< Protocol */
+
+    /** Connection */
+    struct connection {
+        misc::unix_socket socket;  /**< Socket         */
+        std::thread       thread;  /**< Serving thread */
+    };  // end of struct connection
+
+    param_server<Base_t> &                  m_server;    /**< Server        */
+    std::string                             m_path;      /**< Socket path   */
+    misc::unix_socket                       m_listen;    /**< Listening     */
+    std::mutex                              m_mutex;     /**< Conns. mutex  */
+    std::list<std::unique_ptr<connection> > m_conns;     /**< Connections   */
+    std::thread                             m_acceptor;  /**< Accept thread */
+    bool                                    m_stopped;   /**< Stopped       */
+
+    /**
+     *  \brief  Receive update
+     *
+     *  \param  socket  Connection
+     *  \param  req     Request header
+     *  \param  update  Update
+     */
+    static void recv_update(
+        misc::unix_socket         & socket,
+        const protocol::request   & req,
+        update_t                  & update)
+    {
+        update.worker   = req.worker;
+        update.clock    = req.clock;
+        update.size     = req.size;
+        update.encoding = (typename update_t::encoding_t)req.encoding;
+
+        const size_t cnt = req.cnt;
+
+        switch (update.encoding) {
+            case update_t::TOPK:
+                update.index.resize(cnt);
+                update.value.resize(cnt);
+                socket.recv(update.index.data(), cnt * sizeof(uint32_t));
+                socket.recv(update.value.data(), cnt * sizeof(Base_t));
+                break;
+
+            case update_t::QUANT8:
+                update.qvalue.resize(cnt);
+                socket.recv(&update.scale, sizeof(Base_t));
+                socket.recv(update.qvalue.data(), cnt);
+                break;
+
+            case update_t::DENSE:
+                update.value.resize(cnt);
+                socket.recv(update.value.data(), cnt * sizeof(Base_t));
+                break;
+
+            default:
+                throw std::runtime_error(
+                    "libnn::ml::ps_unix_endpoint: "
+                    "invalid update encoding");
+        }
+    }
+
+    /**
+     *  \brief  Serve connection
+     *
+     *  \param  socket  Connection
+     */
+    void serve(misc::unix_socket & socket) {
+        std::vector<Base_t> params;
+        update_t update;
+
+        try {
+            protocol::request req;
+            while (socket.recv(&req, sizeof(req))) {
+                protocol::response resp = { 0, 0, 0 };
+
+                if (protocol::PUSH == req.type)
+                    recv_update(socket, req, update);
+
+                try {
+                    switch (req.type) {
+                        case protocol::PULL:
+                            resp.version = m_server.pull(
+                                req.worker, req.clock, params);
+                            resp.cnt = params.size();
+                            break;
+
+                        case protocol::PUSH:
+                            m_server.push(update);
+                            break;
+
+                        case protocol::DONE:
+                            m_server.done(req.worker);
+                            break;
+
+                        default:
+                            resp.status = 1;
+                            break;
+                    }
+                }
+                catch (const std::exception & ) {
+                    resp.status = 1;
+                }
+
+                socket.send(&resp, sizeof(resp));
+
+                if (0 == resp.status && protocol::PULL == req.type)
+                    socket.send(params.data(), params.size() * sizeof(Base_t));
+            }
+        }
+        catch (const std::exception & ) {}  // connection failure
+    }
+
+    /** Accept connections */
+    void accept() {
+        for (;;) {
+            misc::unix_socket socket = m_listen.accept();
+            if (!socket.is_open()) return;
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (m_stopped) return;
+
+            m_conns.emplace_back(new connection());
+
+            connection & conn = *m_conns.back();
+            conn.socket = std::move(socket);
+            conn.thread = std::thread([this, &conn]() {
+                serve(conn.socket);
+            });
+        }
+    }
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  Starts serving.
+     *
+     *  \param  server  Server
+     *  \param  path    Socket path (an existing socket file is replaced)
+     */
+    ps_unix_endpoint(param_server<Base_t> & server, const std::string & path):
+        m_server(server),
+        m_path(path),
+        m_listen(misc::unix_socket::listen(path)),
+        m_stopped(false)
+    {
+        m_acceptor = std::thread([this]() { accept(); });
+    }
+
+    /** Socket path */
+    const std::string & path() const { return m_path; }
+
+    /**
+     *  \brief  Stop serving
+     *
+     *  The server is closed (so that no connection is blocked by it)
+     *  and the connections are shut down.
+     */
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (m_stopped) return;
+            m_stopped = true;
+        }
+
+        m_server.close();
+
+        m_listen.shutdown();
+        m_acceptor.join();
+
+        std::for_each(m_conns.begin(), m_conns.end(),
+        [](std::unique_ptr<connection> & conn) {
+            conn->socket.shutdown();
+            conn->thread.join();
+        });
+
+        ::unlink(m_path.c_str());
+    }
+
+    /** Copying is forbidden */
+    ps_unix_endpoint(const ps_unix_endpoint & orig) = delete;
+
+    /** Assignment is forbidden */
+    void operator = (const ps_unix_endpoint & rarg) = delete;
+
+    /** Destructor */
+    ~ps_unix_endpoint() { stop(); }
+
+};  // end of template class ps_unix_endpoint
+
+
+/**
+ *  \brief  Parameter server worker
+ *
+ *  A training step pulls the parameters (synapses weights) to the local
+ *  network, computes the batch gradient by the \c backpropagation
+ *  (see \ref backpropagation::gradient) and pushes the update (gradient
+ *  multiplied by the learning factor given by the criterion),
+ *  compressed by the \c compressor.
+ *  A shared weight is a single parameter (see
+ *  \ref backpropagation::get_weights), so tied networks are supported.
+ *
+ *  \tparam  Base_t    Base numeric type
+ *  \tparam  Training  Trainer (\c backpropagation or any trainer
+ *                     providing its \c get_weights, \c set_weights
+ *                     and \c gradient, e.g.
+ *                     \c model::feed_forward::training_t)
+ */
+template <typename Base_t, class Training>
+class ps_worker {
+    public:
+
+    typedef ps_update<Base_t>     update_t;      /**< Update     */
+    typedef ps_compressor<Base_t> compressor_t;  /**< Compressor */
+    typedef ps_transport<Base_t>  transport_t;   /**< Transport  */
+
+    private:
+
+    Training &          m_training;    /**< Trainer                     */
+    transport_t &       m_transport;   /**< Transport                   */
+    size_t              m_worker;      /**< Worker                      */
+    compressor_t        m_compressor;  /**< Update compressor           */
+    uint64_t            m_clock;       /**< Clock (pushed updates)      */
+    uint64_t            m_version;     /**< Pulled parameters version   */
+    uint64_t            m_bytes;       /**< Pushed update bytes         */
+    std::vector<Base_t> m_params;      /**< Parameters                  */
+    std::vector<Base_t> m_grad;        /**< Gradient                    */
+    update_t            m_update;      /**< Update                      */
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  training    Trainer (of the local network)
+     *  \param  transport   Transport
+     *  \param  worker      Worker index
+     *  \param  compressor  Update compressor
+     */
+    ps_worker(
+        Training           & training,
+        transport_t        & transport,
+        size_t               worker,
+        const compressor_t & compressor = compressor_t())
+    :
+        m_training(training),
+        m_transport(transport),
+        m_worker(worker),
+        m_compressor(compressor),
+        m_clock(0),
+        m_version(0),
+        m_bytes(0)
+    {}
+
+    /** Worker index */
+    size_t worker() const { return m_worker; }
+
+    /** Clock (count of pushed updates) */
+    uint64_t clock() const { return m_clock; }
+
+    /** Version of the parameters the last update was computed on */
+    uint64_t version() const { return m_version; }
+
+    /** Total size of pushed updates (bytes) */
+    uint64_t pushed_bytes() const { return m_bytes; }
+
+    /**
+     *  \brief  Training step
+     *
+     *  Note that the local network has the pulled parameters afterwards
+     *  (i.e. without the pushed update).
+     *
+     *  \tparam TSet       Training set (the worker batch)
+     *  \tparam Criterion  Update criterion type
+     *  \param  set        Training set
+     *  \param  criterion  Update criterion
+     *
+     *  \return Error norm squared average
+     */
+    template <class TSet, class Criterion>
+    Base_t operator () (const TSet & set, Criterion & criterion) {
+        m_version = m_transport.pull(m_worker, m_clock, m_params);
+        m_training.set_weights(m_params);
+
+        const Base_t error_norm2_avg = m_training.gradient(set, m_grad);
+        const Base_t alpha = criterion(error_norm2_avg);
+
+        std::for_each(m_grad.begin(), m_grad.end(),
+        [alpha](Base_t & g) { g *= alpha; });
+
+        m_compressor(m_grad, m_update);
+        m_update.worker = m_worker;
+        m_update.clock  = m_clock;
+
+        m_transport.push(m_update);
+
+        m_bytes += m_update.bytes();
+        ++m_clock;
+
+        return error_norm2_avg;
+    }
+
+    /**
+     *  \brief  Finish
+     *
+     *  Notifies the server that the worker won't push any more updates.
+     */
+    void done() { m_transport.done(m_worker); }
+
+};  // end of template class ps_worker
+
+}}  // end of namespace libnn::ml
+
+
+#endif  // end of #ifndef libnn__ml__param_server_hxx
@@ -0,0 +1,486 @@
+#ifndef libnn__ml__pipeline_hxx
+#define libnn__ml__pipeline_hxx
+
+/**
+ *  Pipelined layered network function
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libnn/ml/layered.hxx"
+#include "libnn/misc/spsc_queue.hxx"
+
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <limits>
+
+
+namespace libnn {
+namespace ml {
+
+/**
+ *  \brief  Pipelined layered network function
+ *
+ *  The layers of a layered network (see \ref impl::layered_net) are
+ *  split to contiguous groups (stages); each stage is evaluated by its
+ *  own thread.
+ *  Blocks of samples (rows) flow through the stages, connected by
+ *  lock-free single-producer/single-consumer queues; so while stage
+ *  \c i evaluates its layers for a block, stage \c i-1 already works
+ *  on the next one.
+ *  The sustained throughput is therefore limited by the slowest stage;
+ *  the layers are split so that the maximal stage cost (see
+ *  \ref impl::layered_net::layer_cost) is minimal.
+ *
+ *  The calling thread feeds the pipeline and collects the outputs
+ *  (in order of the inputs).
+ *  The function is not re-entrant (only one thread may use it at once).
+ *
+ *  NOTE that the synapses weights are copied at construction;
+ *  call \ref sync if they change.
+ *
+ *  \tparam  Base_t  Base numeric type
+ *  \tparam  Act_fn  Activation function
+ */
+template <typename Base_t, class Act_fn>
+class pipeline_func {
+    private:
+
+    /** Evaluation plan type */
+    typedef impl::layered_net<Base_t, Act_fn> net_t;
+
+    public:
+
+    typedef typename net_t::nn_t     nn_t;      /**< Neural network type */
+    typedef typename net_t::layers_t layers_t;  /**< Layers              */
+    typedef typename net_t::fixes_t  fixes_t;   /**< Hard fixations      */
+
+    typedef std::vector<Base_t>   output_t;   /**< Output  */
+    typedef std::vector<output_t> outputs_t;  /**< Outputs */
+
+    private:
+
+    /** Block of rows flowing through the pipeline */
+    struct block {
+        size_t              cnt;    /**< Row count                     */
+        std::vector<Base_t> act;    /**< Activations                   */
+        std::vector<Base_t> nets;   /**< Nets                          */
+        std::exception_ptr  error;  /**< Evaluation error (if any)     */
+    };  // end of struct block
+
+    typedef misc::spsc_queue<block *> queue_t;  /**< Stage queue */
+
+    /** Stage */
+    struct stage {
+        size_t                   k_begin;  /**< First layer           */
+        size_t                   k_end;    /**< Last layer plus one   */
+        double                   cost;     /**< Cost (sum of layers)  */
+        std::unique_ptr<queue_t> in;       /**< Input queue           */
+        std::thread              thread;   /**< Stage thread          */
+    };  // end of struct stage
+
+    /** Pipeline state (shared with the stage threads) */
+    struct state {
+        net_t                                net;     /**< Plan           */
+        size_t                               rows;    /**< Rows per block */
+        std::vector<stage>                   stages;  /**< Stages         */
+        std::unique_ptr<queue_t>             out;     /**< Output queue   */
+        std::atomic<bool>                    stop;    /**< Stop flag      */
+        std::vector<std::unique_ptr<block> > blocks;  /**< All blocks     */
+        std::vector<block *>                 free;    /**< Free blocks    */
+
+        /** Constructor */
+        state(
+            const nn_t     & nn,
+            const layers_t & layers,
+            const fixes_t  & fixes,
+            size_t           rows_)
+        :
+            net(nn, layers, fixes),
+            rows(rows_),
+            stop(false)
+        {}
+
+    };  // end of struct state
+
+    std::unique_ptr<state> m_state;  /**< Pipeline state */
+
+    /**
+     *  \brief  Idle wait
+     *
+     *  Yields the CPU at first, sleeps after a while.
+     *
+     *  \param  idle  Count of idle waits in a row
+     */
+    static void backoff(size_t & idle) {
+        if (++idle < 64)
+            std::this_thread::yield();
+        else
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+
+    /**
+     *  \brief  Stage thread routine
+     *
+     *  \param  st  Pipeline state
+     *  \param  i   Stage index
+     */
+    static void run(state & st, size_t i) {
+        stage   & s   = st.stages[i];
+        queue_t & out = i + 1 < st.stages.size()
+            ? *st.stages[i + 1].in : *st.out;
+
+        size_t idle = 0;
+        while (!st.stop) {
+            block * b;
+            if (!s.in->pop(b)) {
+                backoff(idle);
+                continue;
+            }
+
+            idle = 0;
+
+            if (!b->error) {
+                try {
+                    st.net.forward(b->cnt, b->act.data(), b->nets.data(),
+                        s.k_begin, s.k_end);
+                }
+                catch (...) {
+                    b->error = std::current_exception();
+                }
+            }
+
+            while (!out.push(b)) {
+                if (st.stop) return;
+                backoff(idle);
+            }
+        }
+    }
+
+    /**
+     *  \brief  Split layers to stages
+     *
+     *  Finds contiguous partition of the layers costs minimising
+     *  the maximal part cost (by dynamic programming).
+     *
+     *  \param  costs  Layers costs
+     *  \param  parts  Part count (at most the layer count)
+     *
+     *  \return Part ends (indices to \c costs)
+     */
+    static std::vector<size_t> partition(
+        const std::vector<double> & costs,
+        size_t                      parts)
+    {
+        const size_t n = costs.size();
+        const double inf = std::numeric_limits<double>::infinity();
+
+        std::vector<double> prefix(n + 1, 0);
+        for (size_t i = 0; i < n; ++i) prefix[i + 1] = prefix[i] + costs[i];
+
+        // best[p][j]: min. max. cost of 1st j layers split to p parts
+        std::vector<std::vector<double> > best(
+            parts + 1, std::vector<double>(n + 1, inf));
+        std::vector<std::vector<size_t> > split(
+            parts + 1, std::vector<size_t>(n + 1, 0));
+
+        best[0][0] = 0;
+        for (size_t p = 1; p <= parts; ++p)
+            for (size_t j = p; j <= n; ++j)
+                for (size_t i = p - 1; i < j; ++i) {
+                    const double c = std::max(best[p - 1][i],
+                        prefix[j] - prefix[i]);
+
+                    if (c < best[p][j]) {
+                        best[p][j]  = c;
+                        split[p][j] = i;
+                    }
+                }
+
+        std::vector<size_t> ends(parts);
+        for (size_t p = parts, j = n; p > 0; --p) {
+            ends[p - 1] = j;
+            j = split[p][j];
+        }
+
+        return ends;
+    }
+
+    /** Stop stage threads */
+    void stop() {
+        if (!m_state) return;
+
+        m_state->stop = true;
+
+        std::for_each(m_state->stages.begin(), m_state->stages.end(),
+        [](stage & s) {
+            if (s.thread.joinable()) s.thread.join();
+        });
+    }
+
+    /** Get free block */
+    block * get_block() {
+        state & st = *m_state;
+
+        if (st.free.empty()) {
+            st.blocks.emplace_back(new block());
+
+            block & b = *st.blocks.back();
+            b.act.resize(st.rows * st.net.width());
+            b.nets.resize(st.rows * st.net.width());
+
+            return &b;
+        }
+
+        block * b = st.free.back();
+        st.free.pop_back();
+
+        return b;
+    }
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  nn        Neural network
+     *  \param  layers    Layers (input layer first, output layer last)
+     *  \param  fixes     Hard fixations (bias source)
+     *  \param  stages    Stage count (0 means hardware concurrency minus 1
+     *                    for the calling thread; limited by the layer count)
+     *  \param  rows      Rows (samples) per block
+     *  \param  capacity  Stage queue capacity (blocks)
+     */
+    pipeline_func(
+        const nn_t     & nn,
+        const layers_t & layers,
+        const fixes_t  & fixes    = fixes_t(),
+        size_t           stages   = 0,
+        size_t           rows     = 1,
+        size_t           capacity = 16)
+    :
+        m_state(new state(nn, layers, fixes, std::max<size_t>(1, rows)))
+    {
+        state & st = *m_state;
+
+        if (!st.net.valid())
+            throw std::logic_error(
+                "libnn::ml::pipeline_func: "
+                "the network is not layered");
+
+        // Stage balancing
+        std::vector<double> costs;
+        for (size_t k = 1; k < st.net.layer_cnt(); ++k)
+            costs.push_back(st.net.layer_cost(k));
+
+        if (0 == stages)
+            stages = std::max<size_t>(2, std::thread::hardware_concurrency())
+                - 1;
+
+        stages = std::max<size_t>(1, std::min(stages, costs.size()));
+
+        const std::vector<size_t> ends = partition(costs, stages);
+
+        st.stages.resize(stages);
+        for (size_t i = 0, begin = 0; i < stages; begin = ends[i++]) {
+            stage & s = st.stages[i];
+
+            s.k_begin = begin + 1;
+            s.k_end   = ends[i] + 1;
+            s.cost    = 0;
+            for (size_t k = begin; k < ends[i]; ++k) s.cost += costs[k];
+
+            s.in.reset(new queue_t(capacity));
+        }
+
+        st.out.reset(new queue_t(capacity));
+
+        try {
+            for (size_t i = 0; i < stages; ++i)
+                st.stages[i].thread = std::thread(run, std::ref(st), i);
+        }
+        catch (...) {
+            stop();
+            throw;
+        }
+    }
+
+    /** Move constructor */
+    pipeline_func(pipeline_func && orig): m_state(std::move(orig.m_state)) {}
+
+    /** Stage count */
+    size_t stages() const { return m_state->stages.size(); }
+
+    /**
+     *  \brief  Stage layers
+     *
+     *  \param  i  Stage index
+     *
+     *  \return Layer range [begin, end) (layer 0 is input)
+     */
+    std::pair<size_t, size_t> stage_layers(size_t i) const {
+        const stage & s = m_state->stages.at(i);
+        return std::pair<size_t, size_t>(s.k_begin, s.k_end);
+    }
+
+    /**
+     *  \brief  Stage cost
+     *
+     *  \param  i  Stage index
+     *
+     *  \return Sum of the stage layers costs
+     */
+    double stage_cost(size_t i) const { return m_state->stages.at(i).cost; }
+
+    /** Re-read synapses weights (must not be called during evaluation) */
+    void sync() { m_state->net.sync(); }
+
+    /**
+     *  \brief  Compute network function for a stream of inputs
+     *
+     *  Inputs are checked before the evaluation starts; on a failure,
+     *  the blocks in flight are collected before the exception is
+     *  re-thrown (so that the pipeline is clean for the next call).
+     *
+     *  \tparam Inputs  Inputs container type (random access)
+     *  \param  inputs  Inputs
+     *
+     *  \return Outputs (in order of the inputs)
+     */
+    template <class Inputs>
+    outputs_t batch(const Inputs & inputs) {
+        state & st = *m_state;
+
+        const size_t cnt   = inputs.size();
+        const size_t width = st.net.width();
+
+        for (size_t i = 0; i < cnt; ++i)
+            if (inputs[i].size() != st.net.input_size())
+                throw std::logic_error(
+                    "libnn::ml::pipeline_func: "
+                    "invalid input size");
+
+        queue_t & in = *st.stages.front().in;
+
+        outputs_t outputs(cnt);
+        std::exception_ptr error;
+
+        // Stop feeding on error, but collect all the blocks in flight
+        size_t next_in = 0, next_out = 0, idle = 0;
+        while (next_out < next_in || (next_in < cnt && !error)) {
+            bool progress = false;
+
+            // Feed the pipeline (only the caller pushes, so the check
+            // guarantees the push success)
+            if (next_in < cnt && !error && in.size() < in.capacity()) {
+                block * b = get_block();
+
+                b->cnt   = std::min(st.rows, cnt - next_in);
+                b->error = std::exception_ptr();
+
+                try {
+                    for (size_t r = 0; r < b->cnt; ++r)
+                        st.net.set_input(b->act.data() + r * width,
+                            inputs[next_in + r]);
+
+                    in.push(b);
+
+                    next_in += b->cnt;
+                }
+                catch (...) {
+                    st.free.push_back(b);
+                    error = std::current_exception();
+                }
+
+                progress = true;
+            }
+
+            // Collect outputs
+            block * b;
+            while (st.out->pop(b)) {
+                if (b->error && !error) error = b->error;
+
+                for (size_t r = 0; r < b->cnt; ++r, ++next_out) {
+                    const Base_t * out = b->act.data()
+                        + r * width + st.net.output_begin();
+
+                    outputs[next_out].assign(
+                        out, out + st.net.output_size());
+                }
+
+                st.free.push_back(b);
+                progress = true;
+            }
+
+            if (progress)
+                idle = 0;
+            else
+                backoff(idle);
+        }
+
+        if (error) std::rethrow_exception(error);
+
+        return outputs;
+    }
+
+    /**
+     *  \brief  Compute network function
+     *
+     *  \tparam Input  Input container type (iterable)
+     *  \param  input  Input
+     *
+     *  \return Output vector
+     */
+    template <class Input>
+    output_t operator () (const Input & input) {
+        return batch(std::vector<Input>(1, input))[0];
+    }
+
+    /** Destructor */
+    ~pipeline_func() { stop(); }
+
+};  // end of template class pipeline_func
+
+}}  // end of namespace libnn::ml
+
+
+#endif  // end of #ifndef libnn__ml__pipeline_hxx
@@ -0,0 +1,730 @@
+#ifndef libnn__ml__recurrent_hxx
+#define libnn__ml__recurrent_hxx
+
+/**
+ *  Recurrent neural network evaluation and training
+ *
+ *  Time-step evaluation and truncated backpropagation through time.
+ *  See https://en.wikipedia.org/wiki/Backpropagation_through_time
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libnn/topo/nn.hxx"
+#include "libnn/ml/backpropagation.hxx"
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+#include <stdexcept>
+
+
+namespace libnn {
+namespace ml {
+
+namespace impl {
+
+/**
+ *  \brief  Recurrent network evaluation plan
+ *
+ *  Recurrent network is a network topology where some neurons (context
+ *  neurons) take values of other neurons (their sources) from the previous
+ *  time step.
+ *  Context neurons have no synapses, so the topology itself is acyclic.
+ *
+ *  The plan lists all neurons that shall be evaluated in each time step
+ *  in evaluation order (i.e. neurons after their synapses' sources).
+ *  Synapses are flattened to arrays of source indices and weight pointers.
+ *  Referring to weights by pointers, the plan reflects weight updates
+ *  but NOT changes in the network topology (the plan must be re-created
+ *  in such case).
+ *
+ *  Neuron values are kept in flat arrays indexed by neuron index
+ *  (see \c topo::nn::slot_cnt), provided by the plan user.
+ *
+ *  \tparam  Base_t    Base numeric type
+ *  \tparam  Act_fn    Activation function
+ *  \tparam  Weight_t  Weight type (\c Base_t or \c const \c Base_t)
+ */
+template <typename Base_t, class Act_fn, typename Weight_t>
+class recurrent_plan {
+    public:
+
+    /** Neural network type */
+    typedef topo::nn<Base_t, Act_fn> nn_t;
+
+    /** Context specification (context neuron index, source neuron index) */
+    typedef std::vector<std::pair<size_t, size_t> > context_t;
+
+    /** Hard fixations list */
+    typedef std::vector<std::pair<size_t, Base_t> > fixes_t;
+
+    private:
+
+    /** Network type (constness derived from weight type) */
+    typedef typename std::conditional<
+        std::is_const<Weight_t>::value, const nn_t, nn_t>::type
+        network_t;
+
+    /** Neuron type (constness derived from weight type) */
+    typedef typename std::conditional<
+        std::is_const<Weight_t>::value,
+        const typename nn_t::neuron,
+        typename nn_t::neuron>::type
+        neuron_t;
+
+    /** Dendrite type (constness derived from weight type) */
+    typedef typename std::conditional<
+        std::is_const<Weight_t>::value,
+        const typename nn_t::neuron::dendrite,
+        typename nn_t::neuron::dendrite>::type
+        dendrite_t;
+
+    /** Evaluated neuron */
+    struct entry {
+        const typename nn_t::neuron * neuron;  /**< Neuron             */
+        size_t                        index;   /**< Neuron index       */
+        size_t                        begin;   /**< First synapsis     */
+        size_t                        end;     /**< Synapses end       */
+    };  // end of struct entry
+
+    size_t              m_size;     /**< Neuron slot count          */
+    std::vector<entry>  m_eval;     /**< Neurons in evaluation order */
+    std::vector<size_t> m_src;      /**< Synapses' source indices   */
+    std::vector<Weight_t *> m_w;    /**< Synapses' weights          */
+    std::vector<size_t> m_inputs;   /**< Input layer indices        */
+    std::vector<size_t> m_outputs;  /**< Output layer indices       */
+    context_t           m_context;  /**< Context specification      */
+    fixes_t             m_fixes;    /**< Hard fixations             */
+
+    /**
+     *  \brief  Add neuron to the plan (recursively, sources first)
+     *
+     *  \param  n       Neuron
+     *  \param  source  Neuron is a source (not evaluated)
+     *  \param  state   Neuron state (0 means not visited, 1 means
+     *                  in progress, 2 means done)
+     */
+    void plan(
+        neuron_t                & n,
+        const std::vector<char> & source,
+        std::vector<char>       & state)
+    {
+        const size_t index = n.index();
+
+        if (2 == state[index]) return;  // done
+        if (1 == state[index])
+            throw std::logic_error(
+                "libnn::ml::recurrent: "
+                "cycle not broken by a context neuron");
+
+        state[index] = 1;
+
+        if (!source[index]) {
+            n.for_each_dendrite(
+            [&source, &state, this](dendrite_t & dend) {
+                plan(dend.source(), source, state);
+            });
+
+            entry e;
+            e.neuron = &n;
+            e.index  = index;
+            e.begin  = m_src.size();
+
+            n.for_each_dendrite(
+            [this](dendrite_t & dend) {
+                m_src.push_back(dend.source().index());
+                m_w.push_back(&dend.weight());
+            });
+
+            e.end = m_src.size();
+
+            m_eval.push_back(e);
+        }
+
+        state[index] = 2;
+    }
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  network  Neural network
+     *  \param  context  Context specification
+     *  \param  fixes    Hard fixations of neurons' values
+     */
+    recurrent_plan(
+        network_t       & network,
+        const context_t & context,
+        const fixes_t   & fixes)
+    :
+        m_size(network.slot_cnt()),
+        m_context(context),
+        m_fixes(fixes)
+    {
+        std::vector<char> source(m_size, 0);
+        std::vector<char> state(m_size, 0);
+
+        network.for_each_input(
+        [&source, this](const typename nn_t::neuron & n) {
+            m_inputs.push_back(n.index());
+            source[n.index()] = 1;
+        });
+
+        network.for_each_output(
+        [this](const typename nn_t::neuron & n) {
+            m_outputs.push_back(n.index());
+        });
+
+        std::for_each(m_context.begin(), m_context.end(),
+        [&source, this](const std::pair<size_t, size_t> & ctx) {
+            if (!(ctx.first < m_size && ctx.second < m_size))
+                throw std::range_error(
+                    "libnn::ml::recurrent: "
+                    "context neuron index out of range");
+
+            source[ctx.first] = 1;
+        });
+
+        std::for_each(m_fixes.begin(), m_fixes.end(),
+        [&source](const std::pair<size_t, Base_t> & fix) {
+            source[fix.first] = 1;
+        });
+
+        network.for_each_neuron(
+        [&source, &state, this](neuron_t & n) {
+            plan(n, source, state);
+        });
+    }
+
+    /** Neuron slot count (size of state arrays) */
+    size_t size() const { return m_size; }
+
+    /** Synapsis count (size of gradient arrays) */
+    size_t synapsis_cnt() const { return m_src.size(); }
+
+    /** Input layer indices */
+    const std::vector<size_t> & inputs() const { return m_inputs; }
+
+    /** Output layer indices */
+    const std::vector<size_t> & outputs() const { return m_outputs; }
+
+    /** Context specification */
+    const context_t & context() const { return m_context; }
+
+    /**
+     *  \brief  Initialise state array
+     *
+     *  Sets hard-fixed values and zeroes the rest.
+     *
+     *  \param  phi  State array
+     */
+    void init(Base_t * phi) const {
+        std::fill(phi, phi + m_size, 0);
+
+        std::for_each(m_fixes.begin(), m_fixes.end(),
+        [phi](const std::pair<size_t, Base_t> & fix) {
+            phi[fix.first] = fix.second;
+        });
+    }
+
+    /**
+     *  \brief  Set context neurons' values
+     *
+     *  \param  phi   State array
+     *  \param  prev  Context sources' values
+     */
+    void set_context(Base_t * phi, const Base_t * prev) const {
+        for (size_t i = 0; i < m_context.size(); ++i)
+            phi[m_context[i].first] = prev[i];
+    }
+
+    /**
+     *  \brief  Get context sources' values
+     *
+     *  \param  phi   State array
+     *  \param  next  Context sources' values
+     */
+    void get_context(const Base_t * phi, Base_t * next) const {
+        for (size_t i = 0; i < m_context.size(); ++i)
+            next[i] = phi[m_context[i].second];
+    }
+
+    /**
+     *  \brief  Set input layer values
+     *
+     *  \tparam Input  Input container type (iterable)
+     *  \param  phi    State array
+     *  \param  input  Input
+     */
+    template <class Input>
+    void set_input(Base_t * phi, const Input & input) const {
+        auto in_iter = input.begin();
+        for (size_t i = 0; i < m_inputs.size(); ++i)
+            phi[m_inputs[i]] = *(in_iter++);
+    }
+
+    /**
+     *  \brief  Evaluate neurons (one time step)
+     *
+     *  Input layer and context neurons' values must be set.
+     *
+     *  \param  phi  State array (activation function values)
+     *  \param  net  Sums of weighed inputs (optional)
+     */
+    void eval(Base_t * phi, Base_t * net = NULL) const {
+        std::for_each(m_eval.begin(), m_eval.end(),
+        [phi, net, this](const entry & e) {
+            Base_t sum = 0;
+            for (size_t k = e.begin; k < e.end; ++k)
+                sum += *m_w[k] * phi[m_src[k]];
+
+            if (NULL != net) net[e.index] = sum;
+            phi[e.index] = e.neuron->act_fn(sum);
+        });
+    }
+
+    /**
+     *  \brief  Propagate error backwards (one time step)
+     *
+     *  \c dphi shall contain partial derivations of the error by
+     *  the neurons' values (for output layer, that's the output error).
+     *  The derivations are propagated to synapses' sources (in reversed
+     *  evaluation order) and gradient is accumulated.
+     *
+     *  \param  phi   State array (activation function values)
+     *  \param  net   Sums of weighed inputs
+     *  \param  dphi  Error derivations by neurons' values
+     *  \param  grad  Gradient (accumulated synapsis-wise)
+     */
+    void backprop(
+        const Base_t * phi,
+        const Base_t * net,
+        Base_t       * dphi,
+        Base_t       * grad) const
+    {
+        std::for_each(m_eval.rbegin(), m_eval.rend(),
+        [phi, net, dphi, grad, this](const entry & e) {
+            const Base_t delta =
+                dphi[e.index] * e.neuron->act_fn().d(net[e.index]);
+
+            for (size_t k = e.begin; k < e.end; ++k) {
+                dphi[m_src[k]] += *m_w[k] * delta;
+                grad[k]        += delta * phi[m_src[k]];
+            }
+        });
+    }
+
+    /**
+     *  \brief  Update weights by gradient
+     *
+     *  \param  grad   Gradient
+     *  \param  alpha  Learning factor
+     */
+    void update(const Base_t * grad, const Base_t & alpha) const {
+        for (size_t k = 0; k < m_w.size(); ++k)
+            *m_w[k] -= alpha * grad[k];
+    }
+
+};  // end of template class recurrent_plan
+
+}  // end of namespace impl
+
+
+/**
+ *  \brief  Recurrent network function
+ *
+ *  Time-step evaluation of recurrent network function.
+ *  The network state (i.e. context neurons' values) is carried from
+ *  one step to another.
+ *  All state buffers are allocated in advance, so a sequence of any length
+ *  may be processed in constant memory (use \ref step with pre-allocated
+ *  output container to avoid any allocation at all).
+ *
+ *  \tparam  Base_t  Base numeric type
+ *  \tparam  Act_fn  Activation function
+ */
+template <typename Base_t, class Act_fn>
+class recurrent_func {
+    public:
+
+    /** Evaluation plan type */
+    typedef impl::recurrent_plan<Base_t, Act_fn, const Base_t> plan_t;
+
+    /** Neural network type */
+    typedef typename plan_t::nn_t nn_t;
+
+    /** Context specification */
+    typedef typename plan_t::context_t context_t;
+
+    /** Hard fixations list */
+    typedef typename plan_t::fixes_t fixes_t;
+
+    private:
+
+    const plan_t        m_plan;  /**< Evaluation plan          */
+    std::vector<Base_t> m_phi;   /**< Neurons' values          */
+    std::vector<Base_t> m_ctx;   /**< Context sources' values  */
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  network  Neural network
+     *  \param  context  Context specification
+     *  \param  fixes    Hard fixations of neurons' values (optional)
+     */
+    recurrent_func(
+        const nn_t      & network,
+        const context_t & context,
+        const fixes_t   & fixes = fixes_t())
+    :
+        m_plan(network, context, fixes),
+        m_phi(m_plan.size()),
+        m_ctx(context.size())
+    {
+        reset();
+    }
+
+    /** Evaluation plan getter */
+    const plan_t & plan() const { return m_plan; }
+
+    /**
+     *  \brief  Reset network state
+     *
+     *  Context neurons' values are set to 0.
+     */
+    void reset() {
+        m_plan.init(m_phi.data());
+        std::fill(m_ctx.begin(), m_ctx.end(), 0);
+    }
+
+    /**
+     *  \brief  Compute one time step
+     *
+     *  The \c output container must be of (at least) the output layer size.
+     *
+     *  \tparam Input   Input container type (iterable)
+     *  \tparam Output  Output container type (iterable)
+     *  \param  input   Input
+     *  \param  output  Output
+     */
+    template <class Input, class Output>
+    void step(const Input & input, Output & output) {
+        m_plan.set_input(m_phi.data(), input);
+        m_plan.set_context(m_phi.data(), m_ctx.data());
+
+        m_plan.eval(m_phi.data());
+
+        m_plan.get_context(m_phi.data(), m_ctx.data());
+
+        const auto & outputs = m_plan.outputs();
+
+        auto out_iter = output.begin();
+        for (size_t i = 0; i < outputs.size(); ++i)
+            *(out_iter++) = m_phi[outputs[i]];
+    }
+
+    /**
+     *  \brief  Compute one time step
+     *
+     *  \tparam Input  Input container type (iterable)
+     *  \param  input  Input
+     *
+     *  \return Output vector
+     */
+    template <class Input>
+    std::vector<Base_t> operator () (const Input & input) {
+        std::vector<Base_t> output(m_plan.outputs().size());
+        step(input, output);
+        return output;
+    }
+
+};  // end of template class recurrent_func
+
+
+/**
+ *  \brief  Truncated backpropagation through time
+ *
+ *  Trains recurrent network on sequences.
+ *  The sequence is processed in windows of (at most) \c window time steps.
+ *  For each window, error is propagated backwards through time
+ *  (up to the window beginning), the gradient is accumulated
+ *  over the window and the network is updated.
+ *  The network state is carried on to the next window (and to the next
+ *  call, unless \ref reset is called).
+ *
+ *  Per-step state buffers are allocated for the window beforehand,
+ *  so memory doesn't depend on the sequence length.
+ *
+ *  Learning criteria of \ref backpropagation may be used.
+ *
+ *  Note that the \c Act_fn functor must provide method
+ *   d(const Base_t & x) const
+ *
+ *  that computes 1st derivation of the activation function in \c x.
+ *
+ *  \tparam  Base_t  Base numeric type
+ *  \tparam  Act_fn  Activation function
+ */
+template <typename Base_t, class Act_fn>
+class bptt {
+    public:
+
+    /** Evaluation plan type */
+    typedef impl::recurrent_plan<Base_t, Act_fn, Base_t> plan_t;
+
+    /** Neural network type */
+    typedef typename plan_t::nn_t nn_t;
+
+    /** Context specification */
+    typedef typename plan_t::context_t context_t;
+
+    /** Hard fixations list */
+    typedef typename plan_t::fixes_t fixes_t;
+
+    private:
+
+    const plan_t        m_plan;    /**< Evaluation plan                  */
+    size_t              m_window;  /**< Window size (time steps)         */
+    std::vector<Base_t> m_phi;     /**< Neurons' values (per step)       */
+    std::vector<Base_t> m_net;     /**< Neurons' net values (per step)   */
+    std::vector<Base_t> m_err;     /**< Output error (per step)          */
+    std::vector<Base_t> m_dphi;    /**< Error derivations by values      */
+    std::vector<Base_t> m_ctx;     /**< Context sources' values (carry)  */
+    std::vector<Base_t> m_dctx;    /**< Context error derivations        */
+    std::vector<Base_t> m_grad;    /**< Gradient                         */
+
+    /**
+     *  \brief  Process window
+     *
+     *  \tparam Criterion  Update criterion type
+     *  \param  steps      Number of time steps in the window
+     *  \param  err_norm2  Error norm squared sum over the window
+     *  \param  criterion  Update criterion
+     */
+    template <class Criterion>
+    void process(size_t steps, Base_t err_norm2, Criterion & criterion) {
+        const size_t size     = m_plan.size();
+        const auto & outputs  = m_plan.outputs();
+        const auto & context  = m_plan.context();
+
+        // Backward propagation through time
+        std::fill(m_grad.begin(), m_grad.end(), 0);
+        std::fill(m_dctx.begin(), m_dctx.end(), 0);
+
+        for (size_t t = steps; t > 0; --t) {
+            const size_t step = t - 1;
+
+            std::fill(m_dphi.begin(), m_dphi.end(), 0);
+
+            // Output error
+            const Base_t * err = m_err.data() + step * outputs.size();
+            for (size_t i = 0; i < outputs.size(); ++i)
+                m_dphi[outputs[i]] += err[i];
+
+            // Error propagated from the next step via context neurons
+            for (size_t i = 0; i < context.size(); ++i)
+                m_dphi[context[i].second] += m_dctx[i];
+
+            m_plan.backprop(
+                m_phi.data() + step * size,
+                m_net.data() + step * size,
+                m_dphi.data(),
+                m_grad.data());
+
+            for (size_t i = 0; i < context.size(); ++i)
+                m_dctx[i] = m_dphi[context[i].first];
+        }
+
+        // Update
+        const Base_t alpha = criterion(err_norm2 / steps);
+        if (0 != alpha) m_plan.update(m_grad.data(), alpha / steps);
+    }
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  network  Neural network
+     *  \param  context  Context specification
+     *  \param  window   Window size (time steps)
+     *  \param  fixes    Hard fixations of neurons' values (optional)
+     */
+    bptt(
+        nn_t            & network,
+        const context_t & context,
+        size_t            window,
+        const fixes_t   & fixes = fixes_t())
+    :
+        m_plan(network, context, fixes),
+        m_window(0),
+        m_dphi(m_plan.size()),
+        m_ctx(context.size()),
+        m_dctx(context.size()),
+        m_grad(m_plan.synapsis_cnt())
+    {
+        this->window(window);
+    }
+
+    /** Window size getter */
+    size_t window() const { return m_window; }
+
+    /**
+     *  \brief  Window size setter
+     *
+     *  \param  steps  Window size (time steps)
+     */
+    void window(size_t steps) {
+        if (0 == steps)
+            throw std::logic_error(
+                "libnn::ml::bptt: "
+                "window size must be positive");
+
+        const size_t size = m_plan.size();
+
+        m_window = steps;
+        m_phi.resize(m_window * size);
+        m_net.resize(m_window * size);
+        m_err.resize(m_window * m_plan.outputs().size());
+
+        for (size_t t = 0; t < m_window; ++t)
+            m_plan.init(m_phi.data() + t * size);
+    }
+
+    /**
+     *  \brief  Reset network state
+     *
+     *  Context neurons' values are set to 0.
+     */
+    void reset() {
+        std::fill(m_ctx.begin(), m_ctx.end(), 0);
+    }
+
+    /** Gradient (of the last window) getter */
+    const std::vector<Base_t> & gradient() const { return m_grad; }
+
+    /**
+     *  \brief  Train on a sequence
+     *
+     *  The \c Criterion functor takes average error norm squared (per time
+     *  step) over the window and returns learning factor
+     *  (see \ref backpropagation).
+     *  The learning factor is divided by the window length before it's
+     *  applied.
+     *
+     *  \tparam Inputs     Input sequence type (iterable container
+     *                     of iterable inputs)
+     *  \tparam Outputs    Desired output sequence type (iterable container
+     *                     of iterable outputs)
+     *  \tparam Criterion  Update criterion type
+     *  \param  inputs     Input sequence
+     *  \param  outputs    Desired output sequence
+     *  \param  criterion  Update criterion
+     *
+     *  \return Error norm squared average (per time step)
+     */
+    template <class Inputs, class Outputs, class Criterion>
+    Base_t operator () (
+        const Inputs  & inputs,
+        const Outputs & outputs,
+        Criterion     & criterion)
+    {
+        const size_t size    = m_plan.size();
+        const size_t out_cnt = m_plan.outputs().size();
+
+        Base_t err_norm2_sum = 0;  // over the sequence
+        Base_t err_norm2_win = 0;  // over the window
+        size_t steps = 0, t = 0;
+
+        auto out_iter = outputs.begin();
+        for (auto in_iter = inputs.begin(); in_iter != inputs.end();
+            ++in_iter, ++out_iter)
+        {
+            Base_t * phi = m_phi.data() + t * size;
+
+            // Forward step
+            m_plan.set_input(phi, *in_iter);
+            m_plan.set_context(phi, m_ctx.data());
+            m_plan.eval(phi, m_net.data() + t * size);
+            m_plan.get_context(phi, m_ctx.data());
+
+            // Output error
+            if (out_iter->size() != out_cnt)
+                throw std::logic_error(
+                    "libnn::ml::bptt: "
+                    "invalid output target supplied");
+
+            Base_t * err = m_err.data() + t * out_cnt;
+            const auto & out_layer = m_plan.outputs();
+
+            auto target = out_iter->begin();
+            for (size_t i = 0; i < out_cnt; ++i, ++target) {
+                err[i] = phi[out_layer[i]] - *target;
+                err_norm2_win += err[i] * err[i];
+            }
+
+            ++steps;
+
+            // Window is complete
+            if (++t == m_window) {
+                process(t, err_norm2_win, criterion);
+
+                err_norm2_sum += err_norm2_win;
+                err_norm2_win  = 0;
+                t = 0;
+            }
+        }
+
+        // Incomplete window
+        if (t) {
+            process(t, err_norm2_win, criterion);
+
+            err_norm2_sum += err_norm2_win;
+        }
+
+        return steps ? err_norm2_sum / steps : 0;
+    }
+
+};  // end of template class bptt
+
+}}  // end of namespace libnn::ml
+
+#endif  // end of #ifndef libnn__ml__recurrent_hxx
@@ -0,0 +1,467 @@
+#ifndef libnn__ml__telemetry_hxx
+#define libnn__ml__telemetry_hxx
+
+/**
+ *  Training telemetry
+ *
+ *  Training step and epoch events (error, learning factor, gradient
+ *  and weights norms, throughput and phases times), their asynchronous
+ *  delivery and CSV/JSON lines sink.
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libnn/misc/spsc_queue.hxx"
+#include "libnn/misc/instrument.hxx"
+
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <cstddef>
+
+
+namespace libnn {
+namespace ml {
+namespace telemetry {
+
+/** Timed phases (see libnn/misc/instrument.hxx) */
+typedef misc::instrument::phase_t phase_t;
+
+static const size_t phase_cnt = misc::instrument::phase_cnt;
+
+
+/**
+ *  \brief  Training event
+ *
+ *  Step events are produced by each training (on-line or batch) step,
+ *  epoch events when the trainer is told that an epoch has ended.
+ *  Epoch events aggregate the epoch steps: the error is average
+ *  (weighed by samples), the gradient norm is average of the steps
+ *  gradient norms, phases times are sums.
+ */
+struct event {
+    /** Event type */
+    enum type_t {
+        STEP = 0,  /**< Training step */
+        EPOCH,     /**< Epoch end     */
+    };  // end of enum type_t
+
+    type_t type;           /**< Event type                               */
+    size_t index;          /**< Step/epoch number (from 0)               */
+    size_t samples;        /**< Sample count                             */
+    double error;          /**< Error norm squared (average)             */
+    double alpha;          /**< Learning factor (0 if not updated)       */
+    double grad_norm;      /**< Gradient norm (0 if not computed)        */
+    double weight_norm;    /**< Weights norm (after update)              */
+    double samples_per_s;  /**< Throughput (samples per second)          */
+    double time[phase_cnt];  /**< Phases time [s] (see \ref phase_t)     */
+
+    /** Constructor */
+    event(type_t t = STEP):
+        type(t), index(0), samples(0), error(0), alpha(0), grad_norm(0),
+        weight_norm(0), samples_per_s(0)
+    {
+        std::fill(time, time + phase_cnt, 0);
+    }
+
+    /** Event type name */
+    const char * type_name() const { return STEP == type ? "step" : "epoch"; }
+
+};  // end of struct event
+
+
+/**
+ *  \brief  Training observer (interface)
+ *
+ *  Receives training events.
+ *  Note that the observer is called from the training thread;
+ *  use \ref async_observer to receive them from another thread
+ *  (so that the training isn't delayed).
+ */
+class observer {
+    public:
+
+    /**
+     *  \brief  Receive event
+     *
+     *  \param  ev  Event
+     */
+    virtual void operator () (const event & ev) = 0;
+
+    /** Destructor */
+    virtual ~observer() {}
+
+};  // end of class observer
+
+
+/**
+ *  \brief  Training events recorder
+ *
+ *  Used by the trainers; measures phases and steps durations and
+ *  produces events for the observer (does nothing if there's none).
+ */
+class recorder {
+    private:
+
+    typedef std::chrono::steady_clock clock_t;  /**< Clock */
+
+    observer *          m_observer;     /**< Observer (or NULL)         */
+    clock_t::time_point m_start;        /**< Step start                 */
+    clock_t::time_point m_mark;         /**< Last phase end             */
+    event               m_step;         /**< Step event                 */
+    event               m_epoch;        /**< Epoch event (accumulated)  */
+    size_t              m_epoch_steps;  /**< Epoch step count           */
+    clock_t::time_point m_epoch_start;  /**< Epoch (first step) start   */
+
+    /**
+     *  \brief  Time elapsed
+     *
+     *  \param  t    Time point
+     *  \param  now  Current time (set)
+     *
+     *  \return Seconds since \c t
+     */
+    static double since(
+        const clock_t::time_point & t,
+        clock_t::time_point       & now)
+    {
+        const clock_t::time_point n = clock_t::now();
+        const double elapsed = std::chrono::duration<double>(n - t).count();
+
+        now = n;
+
+        return elapsed;
+    }
+
+    public:
+
+    /** Constructor */
+    recorder(): m_observer(NULL), m_epoch(event::EPOCH), m_epoch_steps(0) {}
+
+    /** Set observer (or \c NULL) */
+    void set(observer * obs) { m_observer = obs; }
+
+    /** Observer (or \c NULL) */
+    observer * get() const { return m_observer; }
+
+    /** Check whether there is an observer */
+    bool active() const { return NULL != m_observer; }
+
+    /** Step start */
+    void start() {
+        if (!m_observer) return;
+
+        m_start = m_mark = clock_t::now();
+        std::fill(m_step.time, m_step.time + phase_cnt, 0);
+
+        if (0 == m_epoch_steps) m_epoch_start = m_start;
+    }
+
+    /**
+     *  \brief  Phase end
+     *
+     *  Time since the last phase end (or the step start) is added
+     *  to the phase.
+     *
+     *  \param  phase  Phase
+     */
+    void phase(phase_t phase) {
+        if (!m_observer) return;
+
+        m_step.time[phase] += since(m_mark, m_mark);
+    }
+
+    /**
+     *  \brief  Step end
+     *
+     *  \param  samples      Sample count
+     *  \param  error        Error norm squared (average)
+     *  \param  alpha        Learning factor
+     *  \param  grad_norm    Gradient norm
+     *  \param  weight_norm  Weights norm
+     */
+    void step(
+        size_t samples,
+        double error,
+        double alpha,
+        double grad_norm,
+        double weight_norm)
+    {
+        if (!m_observer) return;
+
+        clock_t::time_point now;
+        const double t = since(m_start, now);
+
+        m_step.samples       = samples;
+        m_step.error         = error;
+        m_step.alpha         = alpha;
+        m_step.grad_norm     = grad_norm;
+        m_step.weight_norm   = weight_norm;
+        m_step.samples_per_s = t > 0 ? samples / t : 0;
+
+        // Accumulate epoch
+        m_epoch.samples     += samples;
+        m_epoch.error       += error * samples;
+        m_epoch.alpha        = alpha;
+        m_epoch.grad_norm   += grad_norm;
+        m_epoch.weight_norm  = weight_norm;
+        for (size_t i = 0; i < phase_cnt; ++i)
+            m_epoch.time[i] += m_step.time[i];
+
+        ++m_epoch_steps;
+
+        (*m_observer)(m_step);
+
+        ++m_step.index;
+    }
+
+    /** Epoch end (no event if the epoch has no steps) */
+    void epoch() {
+        if (!m_observer || 0 == m_epoch_steps) return;
+
+        clock_t::time_point now;
+        const double t = since(m_epoch_start, now);
+
+        if (m_epoch.samples) m_epoch.error /= m_epoch.samples;
+        m_epoch.grad_norm     /= m_epoch_steps;
+        m_epoch.samples_per_s  = t > 0 ? m_epoch.samples / t : 0;
+
+        (*m_observer)(m_epoch);
+
+        const size_t index = m_epoch.index + 1;
+        m_epoch       = event(event::EPOCH);
+        m_epoch.index = index;
+        m_epoch_steps = 0;
+    }
+
+};  // end of class recorder
+
+
+/**
+ *  \brief  Asynchronous observer
+ *
+ *  Events are passed to the target observer by a dispatcher thread
+ *  via lock-free ring buffer (see \c misc::spsc_queue), so that
+ *  the training is never blocked by the target observer.
+ *  If the buffer is full, the event is dropped (and counted).
+ *
+ *  Events may only be produced by one thread at a time (i.e. use one
+ *  instance per trainer).
+ */
+class async_observer: public observer {
+    private:
+
+    observer &                 m_target;     /**< Target observer        */
+    misc::spsc_queue<event>    m_queue;      /**< Event ring buffer      */
+    std::chrono::microseconds  m_poll;       /**< Poll interval          */
+    std::atomic<bool>          m_stop;       /**< Stop the dispatcher    */
+    std::atomic<size_t>        m_posted;     /**< Posted event count     */
+    std::atomic<size_t>        m_delivered;  /**< Delivered event count  */
+    std::atomic<size_t>        m_dropped;    /**< Dropped event count    */
+    std::thread                m_thread;     /**< Dispatcher thread      */
+
+    /** Dispatcher thread routine */
+    void dispatch() {
+        event ev;
+
+        for (;;) {
+            if (m_queue.pop(ev)) {
+                m_target(ev);
+                m_delivered.fetch_add(1, std::memory_order_release);
+            }
+            else if (m_stop.load(std::memory_order_acquire)) {
+                if (m_queue.empty()) break;  // all delivered
+            }
+            else
+                std::this_thread::sleep_for(m_poll);
+        }
+    }
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  Starts the dispatcher thread.
+     *
+     *  \param  target    Target observer
+     *  \param  capacity  Ring buffer capacity (events)
+     *  \param  poll      Poll interval of the dispatcher [us]
+     */
+    async_observer(
+        observer & target,
+        size_t     capacity = 1024,
+        size_t     poll     = 1000)
+    :
+        m_target(target),
+        m_queue(capacity),
+        m_poll(poll),
+        m_stop(false),
+        m_posted(0),
+        m_delivered(0),
+        m_dropped(0),
+        m_thread(&async_observer::dispatch, this)
+    {}
+
+    /**
+     *  \brief  Post event (never blocks)
+     *
+     *  \param  ev  Event
+     */
+    void operator () (const event & ev) {
+        if (m_queue.push(ev))
+            m_posted.fetch_add(1, std::memory_order_relaxed);
+        else
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /** Count of events dropped because of full buffer */
+    size_t dropped() const { return m_dropped.load(); }
+
+    /**
+     *  \brief  Wait until all posted events are delivered
+     *
+     *  Must be called by the producer thread (or when it doesn't post).
+     */
+    void flush() {
+        const size_t posted = m_posted.load(std::memory_order_relaxed);
+
+        while (m_delivered.load(std::memory_order_acquire) < posted)
+            std::this_thread::sleep_for(m_poll);
+    }
+
+    /** Destructor (delivers pending events and stops the dispatcher) */
+    ~async_observer() {
+        m_stop.store(true, std::memory_order_release);
+        m_thread.join();
+    }
+
+};  // end of class async_observer
+
+
+/**
+ *  \brief  Stream sink
+ *
+ *  Writes events to a stream as CSV (with header line) or JSON lines.
+ *  Not thread-safe (use via \ref async_observer to write the stream
+ *  from another thread).
+ */
+class stream_sink: public observer {
+    public:
+
+    /** Output format */
+    enum format_t {
+        CSV = 0,  /**< Comma-separated values (with header) */
+        JSONL,    /**< JSON lines (object per event)        */
+    };  // end of enum format_t
+
+    private:
+
+    std::ostream & m_out;     /**< Output stream         */
+    const format_t m_format;  /**< Output format         */
+    bool           m_header;  /**< CSV header is written */
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  out     Output stream
+     *  \param  format  Output format
+     */
+    stream_sink(std::ostream & out, format_t format = CSV):
+        m_out(out),
+        m_format(format),
+        m_header(false)
+    {}
+
+    /**
+     *  \brief  Write event
+     *
+     *  \param  ev  Event
+     */
+    void operator () (const event & ev) {
+        if (JSONL == m_format) {
+            m_out
+                << "{\"type\": \"" << ev.type_name()
+                << "\", \"index\": " << ev.index
+                << ", \"samples\": " << ev.samples
+                << ", \"error\": " << ev.error
+                << ", \"alpha\": " << ev.alpha
+                << ", \"grad_norm\": " << ev.grad_norm
+                << ", \"weight_norm\": " << ev.weight_norm
+                << ", \"samples_per_s\": " << ev.samples_per_s;
+
+            for (size_t i = 0; i < phase_cnt; ++i)
+                m_out
+                    << ", \"" << misc::instrument::name((phase_t)i)
+                    << "_s\": " << ev.time[i];
+
+            m_out << '}' << std::endl;
+
+            return;
+        }
+
+        if (!m_header) {
+            m_out
+                << "type,index,samples,error,alpha,grad_norm,weight_norm,"
+                << "samples_per_s";
+
+            for (size_t i = 0; i < phase_cnt; ++i)
+                m_out << ',' << misc::instrument::name((phase_t)i) << "_s";
+
+            m_out << std::endl;
+
+            m_header = true;
+        }
+
+        m_out
+            << ev.type_name() << ',' << ev.index << ',' << ev.samples << ','
+            << ev.error << ',' << ev.alpha << ',' << ev.grad_norm << ','
+            << ev.weight_norm << ',' << ev.samples_per_s;
+
+        for (size_t i = 0; i < phase_cnt; ++i) m_out << ',' << ev.time[i];
+
+        m_out << std::endl;
+    }
+
+};  // end of class stream_sink
+
+}}}  // end of namespace libnn::ml::telemetry
+
+#endif  // end of #ifndef libnn__ml__telemetry_hxx
@@ -0,0 +1,465 @@
+#ifndef libnn__model__conv_hxx
+#define libnn__model__conv_hxx
+
+/**
+ *  Convolutional neural network model
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libnn/topo/conv.hxx"
+#include "libnn/ml/conv.hxx"
+#include "libnn/model/feed_forward.hxx"
+#include "libnn/math/util.hxx"
+
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+
+
+namespace libnn {
+namespace model {
+
+/**
+ *  \brief  Convolutional neural network
+ *
+ *  Stack of convolutional and pooling layers (1D or 2D) followed by
+ *  a dense feed-forward network.
+ *  The layers are added one by one (see \ref add_conv, \ref add_max_pool
+ *  etc), each taking the previous layer output as its input.
+ *  The dense network is set last (see \ref set_dense); its input layer
+ *  is the last convolutional/pooling layer output.
+ *
+ *  1D layers operate on multi-channel signals; these are represented
+ *  as planes of height 1.
+ *
+ *  \tparam  Base_t         Base numeric type
+ *  \tparam  Act_fn         Activation function
+ *  \tparam  RandWeightMin  Random weight minimum
+ *  \tparam  RandWeightMax  Random weight maximum
+ */
+template <
+    typename Base_t,
+    class    Act_fn,
+    class    RandWeightMin = math::fraction_parameter<Base_t, -1, 10>,
+    class    RandWeightMax = math::fraction_parameter<Base_t,  1, 10> >
+class conv {
+    public:
+
+    typedef Act_fn                           act_fn_t;  /**< Activation fn  */
+    typedef topo::conv_layer<Base_t, Act_fn> layer_t;   /**< Layer type     */
+    typedef std::vector<layer_t>             layers_t;  /**< Layers type    */
+    typedef typename layer_t::shape          shape_t;   /**< Data shape     */
+
+    /** Dense network type */
+    typedef feed_forward<Base_t, Act_fn, RandWeightMin, RandWeightMax> dense_t;
+
+    /** Network function */
+    class func: public ml::conv_func<Base_t, Act_fn> {
+        friend class conv;
+
+        private:
+
+        /**
+         *  \brief  Constructor (only available via the network method)
+         *
+         *  \param  layers  Layers
+         *  \param  dense   Dense network
+         */
+        func(const layers_t & layers, const dense_t & dense):
+            ml::conv_func<Base_t, Act_fn>(
+                layers, dense.topology(), fixations(dense.features()))
+        {}
+
+    };  // end of class func
+
+    /** Network training */
+    class train: public ml::conv_backprop<Base_t, Act_fn> {
+        friend class conv;
+
+        private:
+
+        /**
+         *  \brief  Constructor (only available via the network method)
+         *
+         *  \param  layers  Layers
+         *  \param  dense   Dense network
+         */
+        train(layers_t & layers, dense_t & dense):
+            ml::conv_backprop<Base_t, Act_fn>(
+                layers, dense.topology(), fixations(dense.features()))
+        {}
+
+    };  // end of class train
+
+    typedef func  function_t;  /**< Network function alias */
+    typedef train training_t;  /**< Network training alias */
+
+    private:
+
+    shape_t  m_input;   /**< Input shape   */
+    layers_t m_layers;  /**< Layers        */
+    dense_t  m_dense;   /**< Dense network */
+
+    /**
+     *  \brief  Create dense network fixation specifications
+     *
+     *  \param  features  Dense network feature bits sum
+     *
+     *  \return Vector containing bias fixation specifications
+     */
+    static std::vector<std::pair<size_t, Base_t> > fixations(int features) {
+        std::vector<std::pair<size_t, Base_t> > fixes;
+        if (dense_t::BIAS & features) fixes.emplace_back(0, 1);
+        return fixes;
+    }
+
+    /** Create default RNG for weight initialisation */
+    static math::rng_uniform<Base_t> default_rng() {
+        return math::rng_uniform<Base_t>(RandWeightMin(), RandWeightMax());
+    }
+
+    /**
+     *  \brief  Add layer
+     *
+     *  \param  layer  Layer
+     *
+     *  \return The layer
+     */
+    layer_t & add_layer(const layer_t & layer) {
+        if (m_dense.topology().size())
+            throw std::logic_error(
+                "libnn::model::conv: "
+                "can't add layers after the dense network is set");
+
+        m_layers.push_back(layer);
+        return m_layers.back();
+    }
+
+    public:
+
+    /** Default constructor */
+    conv() {}
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  input  Input shape
+     */
+    conv(const shape_t & input): m_input(input) {}
+
+    /**
+     *  \brief  Constructor (1D input)
+     *
+     *  \param  channels  Input channel count
+     *  \param  length    Input signal length
+     */
+    conv(size_t channels, size_t length): m_input(channels, 1, length) {}
+
+    /** Input shape getter */
+    const shape_t & input() const { return m_input; }
+
+    /**
+     *  \brief  Input shape setter
+     *
+     *  NOTE that setting input shape is ONLY POSSIBLE if there are
+     *  no layers, yet.
+     *
+     *  \param  shape  Input shape
+     */
+    void input(const shape_t & shape) {
+        if (!m_layers.empty())
+            throw std::logic_error(
+                "libnn::model::conv: "
+                "can't set input shape for existing layers");
+
+        m_input = shape;
+    }
+
+    /** Convolutional/pooling layers output shape */
+    const shape_t & output() const {
+        return m_layers.empty() ? m_input : m_layers.back().output();
+    }
+
+    /** Layers getter */
+    layers_t & layers() { return m_layers; }
+
+    /** Layers getter (const) */
+    const layers_t & layers() const { return m_layers; }
+
+    /** Dense network getter */
+    dense_t & dense() { return m_dense; }
+
+    /** Dense network getter (const) */
+    const dense_t & dense() const { return m_dense; }
+
+    /** Input size */
+    size_t input_size() const { return m_input.size(); }
+
+    /** Output size */
+    size_t output_size() const { return m_dense.topology().output_size(); }
+
+    /**
+     *  \brief  Add convolution layer
+     *
+     *  \tparam WInit     Weight initialiser functor type
+     *  \param  filters   Filter count (output channels)
+     *  \param  kernel_h  Kernel height
+     *  \param  kernel_w  Kernel width
+     *  \param  w_init    Weight initialiser functor
+     *  \param  stride_h  Vertical stride
+     *  \param  stride_w  Horizontal stride
+     *  \param  pad_h     Vertical zero padding
+     *  \param  pad_w     Horizontal zero padding
+     *
+     *  \return The layer
+     */
+    template <class WInit>
+    layer_t & add_conv(
+        size_t  filters,
+        size_t  kernel_h,
+        size_t  kernel_w,
+        WInit & w_init,
+        size_t  stride_h = 1,
+        size_t  stride_w = 1,
+        size_t  pad_h    = 0,
+        size_t  pad_w    = 0)
+    {
+        layer_t & layer = add_layer(layer_t(layer_t::CONV, output(),
+            filters, kernel_h, kernel_w, stride_h, stride_w, pad_h, pad_w));
+
+        std::for_each(layer.weights().begin(), layer.weights().end(),
+        [&w_init](Base_t & w) { w = w_init(); });
+
+        std::for_each(layer.bias().begin(), layer.bias().end(),
+        [&w_init](Base_t & b) { b = w_init(); });
+
+        return layer;
+    }
+
+    /**
+     *  \brief  Add convolution layer
+     *
+     *  Initialises weights by small random numbers.
+     *
+     *  \param  filters   Filter count (output channels)
+     *  \param  kernel_h  Kernel height
+     *  \param  kernel_w  Kernel width
+     *  \param  stride_h  Vertical stride
+     *  \param  stride_w  Horizontal stride
+     *  \param  pad_h     Vertical zero padding
+     *  \param  pad_w     Horizontal zero padding
+     *
+     *  \return The layer
+     */
+    layer_t & add_conv(
+        size_t filters,
+        size_t kernel_h,
+        size_t kernel_w,
+        size_t stride_h = 1,
+        size_t stride_w = 1,
+        size_t pad_h    = 0,
+        size_t pad_w    = 0)
+    {
+        auto rng = default_rng();
+        return add_conv(filters, kernel_h, kernel_w, rng,
+            stride_h, stride_w, pad_h, pad_w);
+    }
+
+    /**
+     *  \brief  Add 1D convolution layer
+     *
+     *  Initialises weights by small random numbers.
+     *
+     *  \param  filters  Filter count (output channels)
+     *  \param  kernel   Kernel length
+     *  \param  stride   Stride
+     *  \param  pad      Zero padding
+     *
+     *  \return The layer
+     */
+    layer_t & add_conv1d(
+        size_t filters,
+        size_t kernel,
+        size_t stride = 1,
+        size_t pad    = 0)
+    {
+        return add_conv(filters, 1, kernel, 1, stride, 0, pad);
+    }
+
+    /**
+     *  \brief  Add max pooling layer
+     *
+     *  \param  kernel_h  Window height
+     *  \param  kernel_w  Window width
+     *  \param  stride_h  Vertical stride (window height by default)
+     *  \param  stride_w  Horizontal stride (window width by default)
+     *
+     *  \return The layer
+     */
+    layer_t & add_max_pool(
+        size_t kernel_h,
+        size_t kernel_w,
+        size_t stride_h = 0,
+        size_t stride_w = 0)
+    {
+        return add_layer(layer_t(layer_t::MAX_POOL, output(), 0,
+            kernel_h, kernel_w,
+            stride_h ? stride_h : kernel_h,
+            stride_w ? stride_w : kernel_w));
+    }
+
+    /**
+     *  \brief  Add average pooling layer
+     *
+     *  \param  kernel_h  Window height
+     *  \param  kernel_w  Window width
+     *  \param  stride_h  Vertical stride (window height by default)
+     *  \param  stride_w  Horizontal stride (window width by default)
+     *
+     *  \return The layer
+     */
+    layer_t & add_avg_pool(
+        size_t kernel_h,
+        size_t kernel_w,
+        size_t stride_h = 0,
+        size_t stride_w = 0)
+    {
+        return add_layer(layer_t(layer_t::AVG_POOL, output(), 0,
+            kernel_h, kernel_w,
+            stride_h ? stride_h : kernel_h,
+            stride_w ? stride_w : kernel_w));
+    }
+
+    /**
+     *  \brief  Add 1D max pooling layer
+     *
+     *  \param  kernel  Window length
+     *  \param  stride  Stride (window length by default)
+     *
+     *  \return The layer
+     */
+    layer_t & add_max_pool1d(size_t kernel, size_t stride = 0) {
+        return add_max_pool(1, kernel, 1, stride);
+    }
+
+    /**
+     *  \brief  Add 1D average pooling layer
+     *
+     *  \param  kernel  Window length
+     *  \param  stride  Stride (window length by default)
+     *
+     *  \return The layer
+     */
+    layer_t & add_avg_pool1d(size_t kernel, size_t stride = 0) {
+        return add_avg_pool(1, kernel, 1, stride);
+    }
+
+    /**
+     *  \brief  Set dense network
+     *
+     *  Creates the dense feed-forward network; its input layer
+     *  is the convolutional/pooling layers output.
+     *
+     *  \tparam WInit        Weight initialiser functor type
+     *  \param  layers_spec  Number of neurons per each layer (except input)
+     *  \param  w_init       Weight initialiser functor
+     *  \param  features     Dense network feature bits sum
+     */
+    template <class WInit>
+    void set_dense(
+        const std::vector<size_t> & layers_spec,
+        WInit                     & w_init,
+        int                         features)
+    {
+        std::vector<size_t> spec;
+        spec.reserve(layers_spec.size() + 1);
+
+        spec.push_back(output().size());
+        spec.insert(spec.end(), layers_spec.begin(), layers_spec.end());
+
+        m_dense = dense_t(spec, w_init, features);
+    }
+
+    /**
+     *  \brief  Set dense network
+     *
+     *  Initialises synapsis weights by small random numbers.
+     *
+     *  \param  layers_spec  Number of neurons per each layer (except input)
+     *  \param  features     Dense network feature bits sum
+     */
+    void set_dense(const std::vector<size_t> & layers_spec, int features) {
+        auto rng = default_rng();
+        set_dense(layers_spec, rng, features);
+    }
+
+    /** Trainable parameter count (including the dense network) */
+    size_t parameter_cnt() const {
+        size_t cnt = 0;
+
+        std::for_each(m_layers.begin(), m_layers.end(),
+        [&cnt](const layer_t & layer) {
+            cnt += layer.parameter_cnt();
+        });
+
+        m_dense.topology().for_each_neuron(
+        [&cnt](const typename dense_t::topo_t::neuron & n) {
+            cnt += n.dendrite_cnt();
+        });
+
+        return cnt;
+    }
+
+    /**
+     *  \brief  Create the network function computation
+     *
+     *  Note that layers or topology changes invalidate the computation.
+     */
+    function_t function() const { return func(m_layers, m_dense); }
+
+    /**
+     *  \brief  Create training algorithm for the network
+     *
+     *  Note that layers or topology changes invalidate the training.
+     */
+    training_t training() { return train(m_layers, m_dense); }
+
+};  // end of template class conv
+
+}}  // end of namespace libnn::model
+
+#endif  // end of #ifndef libnn__model__conv_hxx
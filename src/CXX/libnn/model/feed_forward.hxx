@@ -43,8 +43,14 @@
 #include "libnn/topo/nn.hxx"
 #include "libnn/ml/nn_func.hxx"
 #include "libnn/ml/backpropagation.hxx"
+#include "libnn/ml/layered.hxx"
+#include "libnn/ml/numa.hxx"
+#include "libnn/ml/pipeline.hxx"
+#include "libnn/misc/executor.hxx"
+#include "libnn/misc/allreduce.hxx"
 #include "libnn/math/util.hxx"
 
+#include <vector>
 #include <stdexcept>
 #include <algorithm>
 #include <cstdarg>
@@ -60,6 +66,10 @@ namespace model {
  *  The topology is acyclic (lateral synapses only connect to previous
  *  neurons in a layer).
  *
+ *  The network keeps record of its layers (as ranges of neuron indices,
+ *  see \ref layers); the bias source (if used) is neuron 0 and doesn't
+ *  belong to any layer.
+ *
  *  \tparam  Base_t         Base numeric type
  *  \tparam  Act_fn         Activation function
  *  \tparam  RandWeightMin  Random weight minimum
@@ -89,64 +99,475 @@ class feed_forward {
         DEFAULT = NONE
     };  // end of enum
 
-    /** Network function */
+    /**
+     *  \brief  Create fixation specifications
+     *
+     *  \param  features  Feature bits sum
+     *
+     *  \return Vector containing bias fixation specifications
+     */
+    static std::vector<std::pair<size_t, Base_t> > fixations(int features) {
+        std::vector<std::pair<size_t, Base_t> > fixes;
+        if (BIAS & features) fixes.emplace_back(0, 1);
+        return fixes;
+    }
+
+    /** Layers specification for the dense evaluation */
+    typedef std::vector<std::pair<size_t, size_t> > ml_layers_t;
+
+    /**
+     *  \brief  Network function
+     *
+     *  If the network is layered (which is the case unless the topology
+     *  was modified), it's evaluated layer by layer using dense matrix
+     *  products (see \c ml::layered_func).
+     *  Otherwise, the generic computation is used.
+     *
+     *  In the former case, the function works with copy of the synapses
+     *  weights; the copy is refreshed automatically whenever the network
+     *  weights change (e.g. by training; see \c topo::nn::version).
+     *  Both ways therefore give the same results (up to rounding).
+     */
     class func: public ml::nn_func<Base_t, Act_fn> {
         friend class feed_forward;
 
         private:
 
+        ml::layered_func<Base_t, Act_fn> m_layered;  /**< Dense evaluation */
+
         /**
          *  \brief  Constructor (only available via the network method)
          *
          *  \param  topo      Neural network topology
+         *  \param  layers    Layers
          *  \param  features  Feaure bits sum
          */
-        func(const topo_t & topo, int features):
-            ml::nn_func<Base_t, Act_fn>(topo)
+        func(const topo_t & topo, const ml_layers_t & layers, int features):
+            ml::nn_func<Base_t, Act_fn>(topo),
+            m_layered(topo, layers, fixations(features))
         {
             if (BIAS & features) this->const_fx(0, 1);  // set bias source
         }
 
-    };  // end of class func
+        public:
 
-    /** Network training */
-    class train: public ml::backpropagation<Base_t, Act_fn> {
-        friend class feed_forward;
+        /** Check whether the dense (layer by layer) evaluation is used */
+        bool layered() const { return m_layered.valid(); }
 
-        private:
+        /**
+         *  \brief  Attach executor (e.g. \c misc::thread_pool)
+         *
+         *  \param  exec  Executor for the dense evaluation (or \c NULL)
+         */
+        void executor(misc::executor * exec) { m_layered.executor(exec); }
 
         /**
-         *  \brief  Create fixation specifications
+         *  \brief  Re-read synapses weights
          *
-         *  \param  features  Feature bits sum
+         *  Only necessary if the weights were changed unnoticed by
+         *  the network (see \c topo::nn::version).
+         */
+        void sync() { m_layered.sync(); }
+
+        /**
+         *  \brief  Reserve buffers
+         *
+         *  Batches of up to \c rows inputs are then evaluated by the dense
+         *  evaluation without memory allocation.
          *
-         *  \return Vector containing bias fixation specifications
+         *  \param  rows  Row count
          */
-        static std::vector<std::pair<size_t, Base_t> > fixations(int features) {
-            std::vector<std::pair<size_t, Base_t> > fixes;
-            if (BIAS & features) fixes.emplace_back(0, 1);
-            return fixes;
+        void reserve(size_t rows) { m_layered.reserve(rows); }
+
+        /**
+         *  \brief  Compute network function
+         *
+         *  \tparam Input  Input container type (iterable)
+         *  \param  input  Input
+         *
+         *  \return Output vector
+         */
+        template <class Input>
+        std::vector<Base_t> operator () (const Input & input) {
+            if (m_layered.refresh()) return m_layered(input);
+
+            return ml::nn_func<Base_t, Act_fn>::operator () (input);
         }
 
+        /**
+         *  \brief  Compute network function for a batch of inputs
+         *
+         *  The outputs are written to a row-major matrix.
+         *
+         *  \tparam Inputs   Inputs container type (iterable)
+         *  \param  inputs   Inputs
+         *  \param  outputs  Outputs (row per input)
+         *  \param  stride   Outputs row stride (0 means output size)
+         */
+        template <class Inputs>
+        void batch(const Inputs & inputs, Base_t * outputs, size_t stride = 0) {
+            if (m_layered.refresh()) {
+                m_layered.batch(inputs, outputs, stride);
+                return;
+            }
+
+            for (auto iter = inputs.begin(); iter != inputs.end(); ++iter) {
+                const std::vector<Base_t> out =
+                    ml::nn_func<Base_t, Act_fn>::operator () (*iter);
+
+                std::copy(out.begin(), out.end(), outputs);
+                outputs += stride ? stride : out.size();
+            }
+        }
+
+        /**
+         *  \brief  Compute network function for a batch of inputs
+         *
+         *  The dense evaluation processes the batch at once.
+         *
+         *  \tparam Inputs  Inputs container type (iterable)
+         *  \param  inputs  Inputs
+         *
+         *  \return Outputs (in order of the inputs)
+         */
+        template <class Inputs>
+        std::vector<std::vector<Base_t> > batch(const Inputs & inputs) {
+            if (m_layered.refresh()) return m_layered.batch(inputs);
+
+            std::vector<std::vector<Base_t> > outputs;
+            outputs.reserve(inputs.size());
+
+            for (auto iter = inputs.begin(); iter != inputs.end(); ++iter)
+                outputs.push_back(
+                    ml::nn_func<Base_t, Act_fn>::operator () (*iter));
+
+            return outputs;
+        }
+
+    };  // end of class func
+
+    /**
+     *  \brief  Network training
+     *
+     *  If the network is layered (see \ref func), the training is done
+     *  by the dense backpropagation (see \c ml::layered_backprop),
+     *  except for the checkpointed batch mode.
+     *  Otherwise, the generic backpropagation (\c ml::backpropagation)
+     *  is used.
+     *  Both work on the network weights; the dense one keeps their copy,
+     *  which is refreshed whenever they change by other means (the generic
+     *  training, \ref set_weights, direct access...; see
+     *  \c topo::nn::version).
+     */
+    class train {
+        friend class feed_forward;
+
+        private:
+
+        /** Generic backpropagation */
+        typedef ml::backpropagation<Base_t, Act_fn> backprop_t;
+
+        /** Dense backpropagation */
+        typedef ml::layered_backprop<Base_t, Act_fn> layered_t;
+
+        backprop_t m_generic;  /**< Generic backpropagation */
+        layered_t  m_layered;  /**< Dense backpropagation   */
+
         /**
          *  \brief  Constructor (only available via the network method)
          *
          *  \param  topo      Neural network topology
+         *  \param  layers    Layers
          *  \param  features  Feaure bits sum
          */
-        train(topo_t & topo, int features):
-            ml::backpropagation<Base_t, Act_fn>(topo, fixations(features))
+        train(topo_t & topo, const ml_layers_t & layers, int features):
+            m_generic(topo, fixations(features)),
+            m_layered(topo, layers, fixations(features))
         {}
 
+        /** Check whether the dense backpropagation shall be used */
+        bool use_layered() {
+            return 0 == m_generic.checkpoint() && m_layered.refresh();
+        }
+
+        public:
+
+        /** Check whether the dense backpropagation is available */
+        bool layered() const { return m_layered.valid(); }
+
+        /**
+         *  \brief  Attach executor (e.g. \c misc::thread_pool)
+         *
+         *  Batches are then processed in parallel by the dense
+         *  backpropagation.
+         *
+         *  \param  exec  Executor (or \c NULL)
+         */
+        void executor(misc::executor * exec) { m_layered.executor(exec); }
+
+        /**
+         *  \brief  Re-read synapses weights
+         *
+         *  Only necessary if the weights were changed unnoticed by
+         *  the network (see \c topo::nn::version).
+         */
+        void sync() { m_layered.sync(); }
+
+        /**
+         *  \brief  Reserve buffers
+         *
+         *  Training sets of up to \c rows samples are then processed
+         *  by the dense backpropagation without memory allocation.
+         *
+         *  \param  rows  Row count
+         */
+        void reserve(size_t rows) { m_layered.reserve(rows); }
+
+        /** Checkpoint interval (see \c ml::backpropagation) */
+        size_t checkpoint() const { return m_generic.checkpoint(); }
+
+        /**
+         *  \brief  Set checkpointed training mode
+         *
+         *  See \c ml::backpropagation::checkpoint.
+         *  The batch training is then done by the generic backpropagation.
+         *
+         *  \param  interval  Checkpoint interval (0 switches it off)
+         */
+        void checkpoint(size_t interval) { m_generic.checkpoint(interval); }
+
+        /** All-reduce (or \c NULL) */
+        misc::allreduce<Base_t> * allreduce() const {
+            return m_generic.allreduce();
+        }
+
+        /**
+         *  \brief  Attach all-reduce (e.g. \c misc::shm_allreduce)
+         *
+         *  Batch training is then data-parallel (see
+         *  \c ml::backpropagation::allreduce and \c ml::data_parallel).
+         *
+         *  \param  allreduce  All-reduce (or \c NULL)
+         */
+        void allreduce(misc::allreduce<Base_t> * allreduce) {
+            m_generic.allreduce(allreduce);
+            m_layered.allreduce(allreduce);
+        }
+
+        /** Training observer (or \c NULL) */
+        ml::telemetry::observer * observer() const {
+            return m_generic.observer();
+        }
+
+        /**
+         *  \brief  Set training observer (see \c ml::backpropagation)
+         *
+         *  \param  obs  Observer (or \c NULL)
+         */
+        void observer(ml::telemetry::observer * obs) {
+            m_generic.observer(obs);
+            m_layered.observer(obs);
+        }
+
+        /**
+         *  \brief  End epoch (see \c ml::backpropagation)
+         *
+         *  Note that if both the dense and the generic backpropagation
+         *  were used in the epoch, the observer gets an epoch event
+         *  from each of them.
+         */
+        void epoch() {
+            m_generic.epoch();
+            m_layered.epoch();
+        }
+
+        /**
+         *  \brief  Synapses weights (see \c ml::backpropagation)
+         *
+         *  \param  weights  Weights
+         */
+        void get_weights(std::vector<Base_t> & weights) const {
+            m_generic.get_weights(weights);
+        }
+
+        /**
+         *  \brief  Set synapses weights (see \c ml::backpropagation)
+         *
+         *  \param  weights  Weights
+         */
+        void set_weights(const std::vector<Base_t> & weights) {
+            m_generic.set_weights(weights);
+        }
+
+        /**
+         *  \brief  Compute batch gradient (see \c ml::backpropagation)
+         *
+         *  \tparam TSet  Training set
+         *  \param  set   Training set
+         *  \param  grad  Gradient
+         *
+         *  \return Error norm squared average
+         */
+        template <class TSet>
+        Base_t gradient(const TSet & set, std::vector<Base_t> & grad) {
+            return m_generic.gradient(set, grad);
+        }
+
+        /** Memory usage of the generic backpropagation (bytes) */
+        misc::memory_usage memory_usage() const {
+            return m_generic.memory_usage();
+        }
+
+        /** Activation memory of the generic backpropagation (bytes) */
+        size_t activation_memory() const {
+            return m_generic.activation_memory();
+        }
+
+        /** Peak activation memory of the generic backpropagation (bytes) */
+        size_t peak_activation_memory() const {
+            return m_generic.peak_activation_memory();
+        }
+
+        /**
+         *  \brief  On-line training (see \c ml::backpropagation)
+         *
+         *  \tparam Input      Input container type (iterable)
+         *  \tparam Output     Output container type (iterable)
+         *  \tparam Criterion  Update criterion type
+         *  \param  input      Input
+         *  \param  output     Output (desired)
+         *  \param  criterion  Update criterion
+         *
+         *  \return Error norm squared
+         */
+        template <class Input, class Output, class Criterion>
+        Base_t operator () (
+            const Input  & input,
+            const Output & output,
+            Criterion    & criterion)
+        {
+            if (use_layered()) return m_layered(input, output, criterion);
+
+            return m_generic(input, output, criterion);
+        }
+
+        /**
+         *  \brief  On-line training providing input error
+         *
+         *  See \c ml::backpropagation.
+         *
+         *  \tparam Input        Input container type (iterable)
+         *  \tparam Output       Output container type (iterable)
+         *  \tparam Criterion    Update criterion type
+         *  \param  input        Input
+         *  \param  output       Output (desired)
+         *  \param  criterion    Update criterion
+         *  \param  input_error  Input error
+         *
+         *  \return Error norm squared
+         */
+        template <class Input, class Output, class Criterion>
+        Base_t operator () (
+            const Input         & input,
+            const Output        & output,
+            Criterion           & criterion,
+            std::vector<Base_t> & input_error)
+        {
+            if (use_layered())
+                return m_layered(input, output, criterion, input_error);
+
+            return m_generic(input, output, criterion, input_error);
+        }
+
+        /**
+         *  \brief  Batch training (see \c ml::backpropagation)
+         *
+         *  \tparam TSet       Training set
+         *  \tparam Criterion  Update criterion type
+         *  \param  set        Training set
+         *  \param  criterion  Update criterion
+         *
+         *  \return Error norm squared average
+         */
+        template <class TSet, class Criterion>
+        Base_t operator () (
+            const TSet   & set,
+            Criterion    & criterion)
+        {
+            if (use_layered()) return m_layered(set, criterion);
+
+            return m_generic(set, criterion);
+        }
+
+        /**
+         *  \brief  Batch training providing input errors
+         *
+         *  See \c ml::backpropagation.
+         *
+         *  \tparam TSet          Training set
+         *  \tparam Criterion     Update criterion type
+         *  \param  set           Training set
+         *  \param  criterion     Update criterion
+         *  \param  input_errors  Input errors (per training sample)
+         *
+         *  \return Error norm squared average
+         */
+        template <class TSet, class Criterion>
+        Base_t operator () (
+            const TSet                        & set,
+            Criterion                         & criterion,
+            std::vector<std::vector<Base_t> > & input_errors)
+        {
+            if (use_layered()) return m_layered(set, criterion, input_errors);
+
+            return m_generic(set, criterion, input_errors);
+        }
+
     };  // end of class train
 
     typedef func  function_t;  /**< Network function alias */
     typedef train training_t;  /**< Network training alias */
 
+    /** NUMA-aware network function (serving mode) */
+    typedef ml::numa_func<Base_t, Act_fn> numa_function_t;
+
+    /** Pipelined network function (streaming mode) */
+    typedef ml::pipeline_func<Base_t, Act_fn> pipeline_function_t;
+
+    /** Layer (range of neuron indices) */
+    struct layer_t {
+        size_t begin;  /**< First neuron index         */
+        size_t end;    /**< Last neuron index plus one */
+
+        /**
+         *  \brief  Constructor
+         *
+         *  \param  b  First neuron index
+         *  \param  e  Last neuron index plus one
+         */
+        layer_t(size_t b, size_t e): begin(b), end(e) {}
+
+        /** Layer size */
+        size_t size() const { return end - begin; }
+
+        /**
+         *  \brief  Check whether neuron belongs to the layer
+         *
+         *  \param  index  Neuron index
+         */
+        bool contains(size_t index) const {
+            return begin <= index && index < end;
+        }
+
+    };  // end of struct layer_t
+
+    typedef std::vector<layer_t> layers_t;  /**< Layers */
+
     private:
 
-    int    m_features;  /**< Feature bits sum */
-    topo_t m_topo;      /**< Implementation   */
+    int      m_features;  /**< Feature bits sum */
+    topo_t   m_topo;      /**< Implementation   */
+    layers_t m_layers;    /**< Layers           */
 
     /**
      *  \brief  Create network topology
@@ -174,6 +595,11 @@ class feed_forward {
         for (size_t i = 0; i < layers_spec[0]; ++i)
             prev_layer.push_back(&m_topo.add_neuron(topo_t::neuron::INPUT));
 
+        m_layers.clear();
+        m_layers.reserve(layers_spec.size());
+        m_layers.emplace_back(
+            prev_layer.front()->index(), prev_layer.back()->index() + 1);
+
         // Create hidden and output layers
         for (size_t i = 1; i < layers_spec.size(); ++i) {
             // Neuron type for this layer
@@ -207,6 +633,9 @@ class feed_forward {
                 layer.push_back(&n);
             }
 
+            m_layers.emplace_back(
+                layer.front()->index(), layer.back()->index() + 1);
+
             prev_layer = layer;
         }
     }
@@ -235,6 +664,19 @@ class feed_forward {
         return v;
     }
 
+    /** Layers specification for the dense evaluation */
+    ml_layers_t ml_layers() const {
+        ml_layers_t layers;
+        layers.reserve(m_layers.size());
+
+        std::for_each(m_layers.begin(), m_layers.end(),
+        [&layers](const layer_t & layer) {
+            layers.emplace_back(layer.begin, layer.end);
+        });
+
+        return layers;
+    }
+
     /** Create default RNG for synapsis weight initialisation */
     static math::rng_uniform<Base_t> default_rng() {
         return math::rng_uniform<Base_t>(RandWeightMin(), RandWeightMax());
@@ -336,6 +778,175 @@ class feed_forward {
         m_features = feature_bits;
     }
 
+    /** Layer count */
+    size_t layer_cnt() const { return m_layers.size(); }
+
+    /** Layers getter */
+    const layers_t & layers() const { return m_layers; }
+
+    /**
+     *  \brief  Layer getter
+     *
+     *  Layer 0 is the input layer, the last one is the output layer.
+     *
+     *  \param  index  Layer index
+     *
+     *  \return Layer
+     */
+    const layer_t & layer(size_t index) const {
+        if (!(index < m_layers.size()))
+            throw std::range_error(
+                "libnn::model::feed_forward: "
+                "invalid layer index");
+
+        return m_layers[index];
+    }
+
+    /**
+     *  \brief  Get layer of a neuron
+     *
+     *  \param  index  Neuron index
+     *
+     *  \return Layer index
+     */
+    size_t layer_of(size_t index) const {
+        auto layer = std::upper_bound(m_layers.begin(), m_layers.end(), index,
+        [](size_t index, const layer_t & layer) {
+            return index < layer.end;
+        });
+
+        if (m_layers.end() == layer || !layer->contains(index))
+            throw std::range_error(
+                "libnn::model::feed_forward: "
+                "neuron doesn't belong to any layer");
+
+        return layer - m_layers.begin();
+    }
+
+    /**
+     *  \brief  Bias source neuron index
+     *
+     *  Throws an exception if the network doesn't use bias.
+     */
+    size_t bias() const {
+        if (!(BIAS & m_features))
+            throw std::logic_error(
+                "libnn::model::feed_forward: "
+                "the network doesn't use bias");
+
+        return 0;
+    }
+
+    /**
+     *  \brief  Layers setter
+     *
+     *  Sets layers of an existing topology (e.g. deserialised).
+     *  The layers must be non-empty and must partition the neurons
+     *  exactly: the first one starts right after the bias (if used),
+     *  each next one starts where the previous one ends, the last one
+     *  ends at the last neuron slot and no slot in between is empty.
+     *  Layer 0 must consist of exactly the input neurons.
+     *  At least 2 layers (input and output) are required.
+     *
+     *  \param  layers  Layers
+     */
+    void layers(const layers_t & layers) {
+        if (layers.size() < 2)
+            throw std::logic_error(
+                "libnn::model::feed_forward: "
+                "invalid layers: not enough layers");
+
+        size_t begin = BIAS & m_features ? 1 : 0;
+        std::for_each(layers.begin(), layers.end(),
+        [&begin](const layer_t & layer) {
+            if (layer.begin != begin || !(layer.begin < layer.end))
+                throw std::logic_error(
+                    "libnn::model::feed_forward: "
+                    "invalid layers: layers not adjacent");
+
+            begin = layer.end;
+        });
+
+        // Layers cover all the slots, all the slots are occupied
+        if (m_topo.slot_cnt() != begin || m_topo.size() != begin)
+            throw std::logic_error(
+                "libnn::model::feed_forward: "
+                "invalid layers: neurons not covered");
+
+        // Layer 0 is the input layer
+        const layer_t & input = layers.front();
+        bool input_ok = input.size() == m_topo.input_size();
+        m_topo.for_each_input(
+        [&input, &input_ok](const typename topo_t::neuron & n) {
+            if (!input.contains(n.index())) input_ok = false;
+        });
+
+        if (!input_ok)
+            throw std::logic_error(
+                "libnn::model::feed_forward: "
+                "invalid layers: layer 0 isn't the input layer");
+
+        m_layers = layers;
+    }
+
+    /**
+     *  \brief  Infer layers from topology
+     *
+     *  Reconstructs layers of a topology created by this model (e.g.
+     *  deserialised from older format without layers specification).
+     *  Neurons are processed in order of their indices; the input layer
+     *  consists of the input neurons, a neuron belongs to the current
+     *  layer if it has a synapsis from the previous layer, otherwise
+     *  it starts a new layer.
+     */
+    void infer_layers() {
+        layers_t layers;
+
+        size_t prev_begin = 0, prev_end = 0;  // previous layer
+        size_t begin      = 0, end      = 0;  // current layer
+
+        m_topo.for_each_neuron(
+        [&](const typename topo_t::neuron & n) {
+            const size_t index = n.index();
+
+            if ((BIAS & m_features) && 0 == index) return;  // bias
+
+            // Input layer
+            if (topo_t::neuron::INPUT == n.type()) {
+                if (end && end != index)
+                    throw std::logic_error(
+                        "libnn::model::feed_forward: "
+                        "can't infer layers: input neurons not adjacent");
+
+                if (!end) begin = index;
+                end = index + 1;
+
+                return;
+            }
+
+            bool from_prev = false;
+            n.for_each_dendrite(
+            [&](const typename topo_t::neuron::dendrite & dend) {
+                const size_t src = dend.source().index();
+                if (prev_begin <= src && src < prev_end) from_prev = true;
+            });
+
+            if (!from_prev) {  // new layer
+                if (begin < end) layers.emplace_back(begin, end);
+
+                prev_begin = begin;
+                prev_end   = end;
+                begin      = index;
+            }
+
+            end = index + 1;
+        });
+
+        if (begin < end) layers.emplace_back(begin, end);
+
+        this->layers(layers);
+    }
+
     /** Network topology getter */
     topo_t & topology() { return m_topo; }
 
@@ -344,13 +955,59 @@ class feed_forward {
 
     /**
      *  \brief  Create the network function computation
+     *
+     *  The function follows the network weights changes (see \ref func).
      */
-    function_t function() const { return func(m_topo, m_features); }
+    function_t function() const {
+        return func(m_topo, ml_layers(), m_features);
+    }
+
+    /**
+     *  \brief  Create NUMA-aware network function
+     *
+     *  The network must be layered (i.e. its topology not modified).
+     *  The function keeps reference to the network; call its
+     *  \c reload method after the network has been trained.
+     *
+     *  \param  threads    Workers per NUMA node (0 means node CPU count)
+     *  \param  replicate  Replicate weights on each node
+     */
+    numa_function_t numa_function(
+        size_t threads   = 0,
+        bool   replicate = true) const
+    {
+        return numa_function_t(m_topo, ml_layers(), fixations(m_features),
+            threads, replicate);
+    }
+
+    /**
+     *  \brief  Create pipelined network function
+     *
+     *  The network must be layered (i.e. its topology not modified).
+     *  The layers are split to stages evaluated by separate threads
+     *  (see \c ml::pipeline_func).
+     *  Note that synapses weights changes invalidate the function
+     *  (unless it's synchronised).
+     *
+     *  \param  stages  Stage count (0 means automatic)
+     *  \param  rows    Samples per pipeline block
+     */
+    pipeline_function_t pipeline_function(
+        size_t stages = 0,
+        size_t rows   = 1) const
+    {
+        return pipeline_function_t(m_topo, ml_layers(), fixations(m_features),
+            stages, rows);
+    }
 
     /**
      *  \brief  Create training algorithm for the network
+     *
+     *  Note that topology changes invalidate the training.
      */
-    training_t training() { return train(m_topo, m_features); }
+    training_t training() {
+        return train(m_topo, ml_layers(), m_features);
+    }
 
 };  // end of template class feed_forward
 
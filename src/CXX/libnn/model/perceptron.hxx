@@ -100,7 +100,7 @@ class perceptron:
         WInit                       w_init,
         int                         features = feed_forward_t::DEFAULT)
     :
-        feed_forward_t(w_init, layers_spec, features)
+        feed_forward_t(layers_spec, w_init, features)
     {}
 
     /**
@@ -0,0 +1,403 @@
+#ifndef libnn__model__recurrent_hxx
+#define libnn__model__recurrent_hxx
+
+/**
+ *  Recurrent Neural Network
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "libnn/topo/nn.hxx"
+#include "libnn/ml/recurrent.hxx"
+#include "libnn/math/util.hxx"
+
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+
+
+namespace libnn {
+namespace model {
+
+/**
+ *  \brief  Recurrent neural network
+ *
+ *  Simple recurrent network (SRN) with layered structure, optional bias
+ *  and context layer(s):
+ *  * Elman network context layer holds copy of the first hidden layer
+ *    from the previous time step
+ *  * Jordan network context layer holds copy of the output layer
+ *    from the previous time step
+ *
+ *  The context layers are connected to the first hidden layer (or output
+ *  layer if there's no hidden one).
+ *  Context neurons have no synapses (their values are set from their
+ *  sources), so the topology itself is acyclic.
+ *  Note that they are inner neurons with no synapses; do NOT minimise
+ *  the topology (see \c topo::nn::minimise).
+ *
+ *  \tparam  Base_t         Base numeric type
+ *  \tparam  Act_fn         Activation function
+ *  \tparam  RandWeightMin  Random weight minimum
+ *  \tparam  RandWeightMax  Random weight maximum
+ */
+template <
+    typename Base_t,
+    class    Act_fn,
+    class    RandWeightMin = math::fraction_parameter<Base_t, -1, 10>,
+    class    RandWeightMax = math::fraction_parameter<Base_t,  1, 10> >
+class recurrent {
+    public:
+
+    typedef Act_fn                   act_fn_t;  /**< Activation fn type */
+    typedef topo::nn<Base_t, Act_fn> topo_t;    /**< Topology type      */
+
+    /** Context specification (context neuron index, source neuron index) */
+    typedef std::vector<std::pair<size_t, size_t> > context_t;
+
+    /** Feature bits */
+    enum {
+        NONE   = 0x0,  /**< No extra features                     */
+        BIAS   = 0x1,  /**< Use bias                              */
+        ELMAN  = 0x2,  /**< Context of the first hidden layer     */
+        JORDAN = 0x4,  /**< Context of the output layer           */
+
+        /** Default features */
+        DEFAULT = ELMAN
+    };  // end of enum
+
+    /**
+     *  \brief  Create fixation specifications
+     *
+     *  \param  features  Feature bits sum
+     *
+     *  \return Vector containing bias fixation specifications
+     */
+    static std::vector<std::pair<size_t, Base_t> > fixations(int features) {
+        std::vector<std::pair<size_t, Base_t> > fixes;
+        if (BIAS & features) fixes.emplace_back(0, 1);
+        return fixes;
+    }
+
+    /** Network function (time-step evaluation) */
+    class func: public ml::recurrent_func<Base_t, Act_fn> {
+        friend class recurrent;
+
+        private:
+
+        /**
+         *  \brief  Constructor (only available via the network method)
+         *
+         *  \param  topo      Neural network topology
+         *  \param  context   Context specification
+         *  \param  features  Feaure bits sum
+         */
+        func(const topo_t & topo, const context_t & context, int features):
+            ml::recurrent_func<Base_t, Act_fn>(
+                topo, context, fixations(features))
+        {}
+
+    };  // end of class func
+
+    /** Network training (truncated BPTT) */
+    class train: public ml::bptt<Base_t, Act_fn> {
+        friend class recurrent;
+
+        private:
+
+        /**
+         *  \brief  Constructor (only available via the network method)
+         *
+         *  \param  topo      Neural network topology
+         *  \param  context   Context specification
+         *  \param  window    BPTT window size (time steps)
+         *  \param  features  Feaure bits sum
+         */
+        train(
+            topo_t          & topo,
+            const context_t & context,
+            size_t            window,
+            int               features)
+        :
+            ml::bptt<Base_t, Act_fn>(
+                topo, context, window, fixations(features))
+        {}
+
+    };  // end of class train
+
+    typedef func  function_t;  /**< Network function alias */
+    typedef train training_t;  /**< Network training alias */
+
+    private:
+
+    int       m_features;  /**< Feature bits sum       */
+    topo_t    m_topo;      /**< Implementation         */
+    context_t m_context;   /**< Context specification  */
+
+    /**
+     *  \brief  Create layer
+     *
+     *  \param  size  Layer size
+     *  \param  type  Neuron type
+     *
+     *  \return Layer neurons
+     */
+    std::vector<typename topo_t::neuron *> create_layer(
+        size_t                           size,
+        typename topo_t::neuron::type_t  type)
+    {
+        std::vector<typename topo_t::neuron *> layer;
+        layer.reserve(size);
+
+        for (size_t i = 0; i < size; ++i)
+            layer.push_back(&m_topo.add_neuron(type));
+
+        return layer;
+    }
+
+    /**
+     *  \brief  Connect layers
+     *
+     *  \tparam WInit   Weight initialiser functor type
+     *  \param  layer   Target layer
+     *  \param  source  Source layer
+     *  \param  w_init  Weight initialiser functor
+     */
+    template <class WInit>
+    static void connect(
+        const std::vector<typename topo_t::neuron *> & layer,
+        const std::vector<typename topo_t::neuron *> & source,
+        WInit                                        & w_init)
+    {
+        std::for_each(layer.begin(), layer.end(),
+        [&source, &w_init](typename topo_t::neuron * n) {
+            std::for_each(source.begin(), source.end(),
+            [n, &w_init](typename topo_t::neuron * n_src) {
+                n->set_dendrite(*n_src, w_init());
+            });
+        });
+    }
+
+    /**
+     *  \brief  Create network topology
+     *
+     *  \tparam WInit        Weight initialiser functor type
+     *  \param  layers_spec  Number of neurons per each layer
+     *  \param  w_init       Weight initialiser functor
+     */
+    template <class WInit>
+    void create_topo(const std::vector<size_t> & layers_spec, WInit & w_init) {
+        if (layers_spec.size() < 2)
+            throw std::logic_error(
+                "libnn::model::recurrent: "
+                "invalid topology: not enough layers");
+
+        if ((ELMAN & m_features) && layers_spec.size() < 3)
+            throw std::logic_error(
+                "libnn::model::recurrent: "
+                "invalid topology: Elman network requires hidden layer");
+
+        std::vector<typename topo_t::neuron *> bias;
+
+        // Create bias source
+        if (BIAS & m_features) bias.push_back(&m_topo.add_neuron());
+
+        // Create input layer
+        auto prev_layer = create_layer(layers_spec[0], topo_t::neuron::INPUT);
+
+        // Create context layers
+        std::vector<typename topo_t::neuron *> elman_ctx, jordan_ctx;
+
+        if (ELMAN & m_features)
+            elman_ctx = create_layer(layers_spec[1], topo_t::neuron::INNER);
+
+        if (JORDAN & m_features)
+            jordan_ctx = create_layer(
+                layers_spec.back(), topo_t::neuron::INNER);
+
+        // Create hidden and output layers
+        std::vector<typename topo_t::neuron *> first_layer;
+
+        for (size_t i = 1; i < layers_spec.size(); ++i) {
+            // Neuron type for this layer
+            typename topo_t::neuron::type_t type
+                = i < layers_spec.size() - 1
+                ? topo_t::neuron::INNER
+                : topo_t::neuron::OUTPUT;
+
+            auto layer = create_layer(layers_spec[i], type);
+
+            connect(layer, bias, w_init);
+            connect(layer, prev_layer, w_init);
+
+            // Context synapses
+            if (1 == i) {
+                connect(layer, elman_ctx,  w_init);
+                connect(layer, jordan_ctx, w_init);
+
+                first_layer = layer;
+            }
+
+            prev_layer = layer;
+        }
+
+        // Context specification
+        for (size_t i = 0; i < elman_ctx.size(); ++i)
+            m_context.emplace_back(
+                elman_ctx[i]->index(), first_layer[i]->index());
+
+        for (size_t i = 0; i < jordan_ctx.size(); ++i)
+            m_context.emplace_back(
+                jordan_ctx[i]->index(), prev_layer[i]->index());
+    }
+
+    /** Create default RNG for synapsis weight initialisation */
+    static math::rng_uniform<Base_t> default_rng() {
+        return math::rng_uniform<Base_t>(RandWeightMin(), RandWeightMax());
+    }
+
+    public:
+
+    /** Default constructor */
+    recurrent(): m_features(DEFAULT) {}
+
+    /**
+     *  \brief  Constructor
+     *
+     *  Construct recurrent neural network, initialising the synapses
+     *  weights using the \c w_init functor.
+     *  Note that at least 2 layers must be specified (input and output);
+     *  Elman network requires a hidden layer.
+     *
+     *  \tparam WInit        Weight initialiser functor type
+     *  \param  layers_spec  Number of neurons per each layer
+     *  \param  w_init       Weight initialiser functor
+     *  \param  features     Feature bits sum
+     */
+    template <class WInit>
+    recurrent(
+        const std::vector<size_t> & layers_spec,
+        WInit                     & w_init,
+        int                         features)
+    :
+        m_features(features)
+    {
+        create_topo(layers_spec, w_init);
+    }
+
+    /**
+     *  \brief  3-layer network constructor
+     *
+     *  Constructs 3-layer recurrent network (i.e. with 1 hidden layer).
+     *  Initialises synapsis weights by small random numbers.
+     *
+     *  \param  input_d     Input dimension
+     *  \param  hidden_cnt  Hidden layer size
+     *  \param  output_d    Output dimension
+     *  \param  features    Feature bits sum
+     */
+    recurrent(
+        size_t input_d,
+        size_t hidden_cnt,
+        size_t output_d,
+        int    features = DEFAULT)
+    :
+        m_features(features)
+    {
+        auto rng = default_rng();
+        create_topo(
+            std::vector<size_t>({input_d, hidden_cnt, output_d}), rng);
+    }
+
+    /** Feature bits sum getter */
+    int features() const { return m_features; }
+
+    /**
+     *  \brief  Features setter
+     *
+     *  NOTE that setting features is ONLY POSSIBLE if topology
+     *  is not yet created.
+     *  If the function is called on a network with existing topology,
+     *  an exception is thrown.
+     *
+     *  \param  feature_bits  Feature bits sum
+     */
+    void features(int feature_bits) {
+        if (m_topo.size())
+            throw std::logic_error(
+                "libnn::model::recurrent: "
+                "Can't set features for an existing topology");
+
+        m_features = feature_bits;
+    }
+
+    /** Network topology getter */
+    topo_t & topology() { return m_topo; }
+
+    /** Network topology getter (const) */
+    const topo_t & topology() const { return m_topo; }
+
+    /** Context specification getter */
+    context_t & context() { return m_context; }
+
+    /** Context specification getter (const) */
+    const context_t & context() const { return m_context; }
+
+    /**
+     *  \brief  Create the network function (time-step) computation
+     *
+     *  Note that topology changes invalidate the computation.
+     */
+    function_t function() const {
+        return func(m_topo, m_context, m_features);
+    }
+
+    /**
+     *  \brief  Create training algorithm for the network
+     *
+     *  Note that topology changes invalidate the training.
+     *
+     *  \param  window  BPTT window size (time steps)
+     */
+    training_t training(size_t window) {
+        return train(m_topo, m_context, window, m_features);
+    }
+
+};  // end of template class recurrent
+
+}}  // end of namespace libnn::model
+
+#endif  // end of #ifndef libnn__model__recurrent_hxx
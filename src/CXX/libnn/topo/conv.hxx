@@ -0,0 +1,305 @@
+#ifndef libnn__topo__conv_hxx
+#define libnn__topo__conv_hxx
+
+/**
+ *  Convolutional network layer
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <vector>
+#include <stdexcept>
+
+
+namespace libnn {
+namespace topo {
+
+/**
+ *  \brief  Convolutional network layer
+ *
+ *  A layer of convolutional network operates on 3D data: channels
+ *  of 2D planes (1D signals are planes of height 1).
+ *  Data are stored in channel-major, row-major order
+ *  (i.e. index of [c, y, x] is (c * height + y) * width + x).
+ *
+ *  The layer is either
+ *  * convolution: each of the filters (output channels) is a kernel
+ *    spanning all input channels; the output is activation function
+ *    of the kernel correlation with input plus bias, or
+ *  * max/average pooling: each channel is sub-sampled by taking maximum
+ *    or average of the kernel window.
+ *
+ *  Kernel weights are stored compactly (one vector per layer) instead
+ *  of separate synapses; see \c topo::nn for unrestricted topologies.
+ *
+ *  \tparam  Base_t  Base numeric type
+ *  \tparam  Act_fn  Activation function
+ */
+template <typename Base_t, class Act_fn>
+class conv_layer {
+    public:
+
+    /** Layer type */
+    enum type_t {
+        CONV = 0,  /**< Convolution */
+        MAX_POOL,  /**< Max pooling */
+        AVG_POOL,  /**< Avg pooling */
+    };  // end of enum type_t
+
+    /** Data shape */
+    struct shape {
+        size_t channels;  /**< Channel count */
+        size_t height;    /**< Plane height  */
+        size_t width;     /**< Plane width   */
+
+        /** Default constructor */
+        shape(): channels(0), height(0), width(0) {}
+
+        /**
+         *  \brief  Constructor
+         *
+         *  \param  c  Channel count
+         *  \param  h  Plane height
+         *  \param  w  Plane width
+         */
+        shape(size_t c, size_t h, size_t w):
+            channels(c), height(h), width(w)
+        {}
+
+        /** Plane size */
+        size_t plane() const { return height * width; }
+
+        /** Data size */
+        size_t size() const { return channels * plane(); }
+
+        /** Equality */
+        bool operator == (const shape & rarg) const {
+            return
+                channels == rarg.channels &&
+                height   == rarg.height   &&
+                width    == rarg.width;
+        }
+
+    };  // end of struct shape
+
+    private:
+
+    type_t              m_type;      /**< Layer type                  */
+    shape               m_input;     /**< Input shape                 */
+    shape               m_output;    /**< Output shape                */
+    size_t              m_kernel_h;  /**< Kernel height               */
+    size_t              m_kernel_w;  /**< Kernel width                */
+    size_t              m_stride_h;  /**< Vertical stride             */
+    size_t              m_stride_w;  /**< Horizontal stride           */
+    size_t              m_pad_h;     /**< Vertical (zero) padding     */
+    size_t              m_pad_w;     /**< Horizontal (zero) padding   */
+    Act_fn              m_act_fn;    /**< Activation function         */
+    std::vector<Base_t> m_weights;   /**< Kernels (filter-major)      */
+    std::vector<Base_t> m_bias;      /**< Bias (per filter)           */
+
+    /**
+     *  \brief  Compute output dimension
+     *
+     *  \param  in      Input dimension
+     *  \param  kernel  Kernel dimension
+     *  \param  stride  Stride
+     *  \param  pad     Padding
+     *
+     *  \return Output dimension
+     */
+    static size_t out_dim(size_t in, size_t kernel, size_t stride, size_t pad) {
+        if (0 == kernel || 0 == stride)
+            throw std::logic_error(
+                "libnn::topo::conv_layer: "
+                "kernel and stride must be positive");
+
+        if (in + 2 * pad < kernel)
+            throw std::logic_error(
+                "libnn::topo::conv_layer: "
+                "kernel exceeds input");
+
+        return (in + 2 * pad - kernel) / stride + 1;
+    }
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  Kernel weights and biases of a convolution layer are initialised
+     *  to 0.
+     *  For pooling layers, \c filters is ignored (the output has the same
+     *  number of channels as input) and so is \c act_fn.
+     *
+     *  \param  type      Layer type
+     *  \param  input     Input shape
+     *  \param  filters   Filter count (output channels)
+     *  \param  kernel_h  Kernel height
+     *  \param  kernel_w  Kernel width
+     *  \param  stride_h  Vertical stride
+     *  \param  stride_w  Horizontal stride
+     *  \param  pad_h     Vertical zero padding
+     *  \param  pad_w     Horizontal zero padding
+     *  \param  act_fn    Activation function
+     */
+    conv_layer(
+        type_t        type,
+        const shape & input,
+        size_t        filters,
+        size_t        kernel_h,
+        size_t        kernel_w,
+        size_t        stride_h = 1,
+        size_t        stride_w = 1,
+        size_t        pad_h    = 0,
+        size_t        pad_w    = 0,
+        const Act_fn & act_fn  = Act_fn())
+    :
+        m_type(type),
+        m_input(input),
+        m_kernel_h(kernel_h),
+        m_kernel_w(kernel_w),
+        m_stride_h(stride_h),
+        m_stride_w(stride_w),
+        m_pad_h(pad_h),
+        m_pad_w(pad_w),
+        m_act_fn(act_fn)
+    {
+        if (CONV != m_type && (m_pad_h || m_pad_w))
+            throw std::logic_error(
+                "libnn::topo::conv_layer: "
+                "padding is not supported for pooling");
+
+        m_output = shape(
+            CONV == m_type ? filters : m_input.channels,
+            out_dim(m_input.height, m_kernel_h, m_stride_h, m_pad_h),
+            out_dim(m_input.width,  m_kernel_w, m_stride_w, m_pad_w));
+
+        if (CONV == m_type) {
+            m_weights.resize(m_output.channels * kernel_size(), 0);
+            m_bias.resize(m_output.channels, 0);
+        }
+    }
+
+    /** Layer type getter */
+    type_t type() const { return m_type; }
+
+    /** Input shape getter */
+    const shape & input() const { return m_input; }
+
+    /** Output shape getter */
+    const shape & output() const { return m_output; }
+
+    /** Kernel height getter */
+    size_t kernel_h() const { return m_kernel_h; }
+
+    /** Kernel width getter */
+    size_t kernel_w() const { return m_kernel_w; }
+
+    /** Vertical stride getter */
+    size_t stride_h() const { return m_stride_h; }
+
+    /** Horizontal stride getter */
+    size_t stride_w() const { return m_stride_w; }
+
+    /** Vertical padding getter */
+    size_t pad_h() const { return m_pad_h; }
+
+    /** Horizontal padding getter */
+    size_t pad_w() const { return m_pad_w; }
+
+    /**
+     *  \brief  Kernel size
+     *
+     *  Number of weights of one filter (i.e. input channels times kernel
+     *  plane size for convolution, kernel plane size for pooling).
+     */
+    size_t kernel_size() const {
+        return (CONV == m_type ? m_input.channels : 1) * m_kernel_h * m_kernel_w;
+    }
+
+    /** Activation function getter */
+    const Act_fn & act_fn() const { return m_act_fn; }
+
+    /** Kernel weights getter (filter-major, then [c, y, x]) */
+    std::vector<Base_t> & weights() { return m_weights; }
+
+    /** Kernel weights getter (const) */
+    const std::vector<Base_t> & weights() const { return m_weights; }
+
+    /** Bias getter */
+    std::vector<Base_t> & bias() { return m_bias; }
+
+    /** Bias getter (const) */
+    const std::vector<Base_t> & bias() const { return m_bias; }
+
+    /**
+     *  \brief  Kernel weight getter
+     *
+     *  \param  f  Filter
+     *  \param  c  Input channel
+     *  \param  y  Kernel row
+     *  \param  x  Kernel column
+     *
+     *  \return Kernel weight
+     */
+    Base_t & weight(size_t f, size_t c, size_t y, size_t x) {
+        return m_weights[((f * m_input.channels + c) * m_kernel_h + y)
+            * m_kernel_w + x];
+    }
+
+    /**
+     *  \brief  Kernel weight getter (const)
+     *
+     *  \param  f  Filter
+     *  \param  c  Input channel
+     *  \param  y  Kernel row
+     *  \param  x  Kernel column
+     *
+     *  \return Kernel weight
+     */
+    const Base_t & weight(size_t f, size_t c, size_t y, size_t x) const {
+        return m_weights[((f * m_input.channels + c) * m_kernel_h + y)
+            * m_kernel_w + x];
+    }
+
+    /** Trainable parameter count */
+    size_t parameter_cnt() const { return m_weights.size() + m_bias.size(); }
+
+};  // end of template class conv_layer
+
+}}  // end of namespace libnn::topo
+
+#endif  // end of #ifndef libnn__topo__conv_hxx
@@ -40,11 +40,18 @@
  *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include "libnn/instances.hxx"
 #include "libnn/misc/fixable.hxx"
+#include "libnn/misc/memory_usage.hxx"
+#include "libnn/misc/memory_resource.hxx"
 
 #include <list>
+#include <deque>
 #include <vector>
 #include <memory>
+#include <new>
+#include <cstdint>
+#include <utility>
 #include <algorithm>
 #include <stdexcept>
 
@@ -55,6 +62,21 @@ namespace topo {
 /**
  *  \brief  Neural network
  *
+ *  Synapses may share weights (see \ref add_shared_weight).
+ *  Shared weights are stored in the network; dendrites sharing a weight
+ *  refer to it instead of their own storage.
+ *  That allows for tied architectures (convolution-like structures,
+ *  siamese networks etc).
+ *  Updates done to each dendrite weight (by training) are thus accumulated
+ *  in the shared weight.
+ *
+ *  The network storage (neurons, dendrites, shared weights) may be
+ *  allocated by a custom memory resource (huge pages, shared memory,
+ *  arena...; see \ref misc::memory_resource).
+ *
+ *  The network keeps modification stamp (see \ref version); objects
+ *  caching parts of it may check it to find out they need a refresh.
+ *
  *  \tparam  Base_t  Base numeric type
  *  \tparam  Act_fn  Activation function
  */
@@ -62,6 +84,26 @@ template <typename Base_t, class Act_fn>
 class nn {
     public:
 
+    /**
+     *  \brief  Modification stamp
+     *
+     *  The topology counter is incremented on topology changes
+     *  (neurons or synapses added, removed, re-indexed).
+     *  The weights counter is incremented whenever a non-const access
+     *  to synapses weights (or activation functors) is provided
+     *  (i.e. on potential change).
+     *  Note that weights changed via dendrite references obtained
+     *  before are not noticed.
+     */
+    struct version_t {
+        size_t topology;  /**< Topology version */
+        size_t weights;   /**< Weights version  */
+
+        /** Constructor */
+        version_t(): topology(0), weights(0) {}
+
+    };  // end of struct version_t
+
     /**
      *  \brief  Neuron
      *
@@ -81,17 +123,44 @@ class nn {
          *  \brief  Dendrite
          *
          *  Neuron's input connection (aka synapsis) to another neuron.
+         *  The weight is either dendrite's own or shared (see
+         *  \ref nn::add_shared_weight).
          */
         struct dendrite {
-            Base_t   weight;  /**< Weight        */
-            neuron & source;  /**< Source neuron */
+            private:
+
+            /** Weight storage (own weight or pointer to the shared one) */
+            union {
+                Base_t   m_weight;  /**< Own weight    */
+                Base_t * m_shared;  /**< Shared weight */
+            };
+
+            /**
+             *  \brief  Source neuron address
+             *
+             *  Neurons are (at least) word-aligned, so the lowest bit
+             *  of the address is free; it's set iff the weight is shared.
+             *  Together with the weight union, that keeps the dendrite
+             *  at 2 words.
+             */
+            uintptr_t m_source;
+
+            /** Source neuron address */
+            static uintptr_t address(neuron & src) {
+                static_assert(alignof(neuron) > 1,
+                    "libnn::topo::nn: neuron address LSB must be free");
+
+                return reinterpret_cast<uintptr_t>(&src);
+            }
+
+            public:
 
             /**
              *  \brief  Constructor (default weight)
              *
              *  \param  src  Input neuron
              */
-            dendrite(neuron & src): source(src) {}
+            dendrite(neuron & src): m_weight(), m_source(address(src)) {}
 
             /**
              *  \brief  Constructor
@@ -100,20 +169,71 @@ class nn {
              *  \param  w    Weight of the synapse
              */
             dendrite(neuron & src, const Base_t & w):
-                weight(w),
-                source(src)
+                m_weight(w),
+                m_source(address(src))
             {}
 
+            /**
+             *  \brief  Constructor (shared weight)
+             *
+             *  \param  src  Input neuron
+             *  \param  w    Shared weight of the synapse
+             */
+            dendrite(neuron & src, Base_t * w):
+                m_shared(w),
+                m_source(address(src) | 1)
+            {}
+
+            /** Weight is shared */
+            bool shared() const { return m_source & 1; }
+
+            /** Weight getter (own or shared) */
+            Base_t & weight() { return shared() ? *m_shared : m_weight; }
+
+            /** Weight getter (own or shared, const) */
+            const Base_t & weight() const {
+                return shared() ? *m_shared : m_weight;
+            }
+
+            /** Source neuron getter */
+            neuron & source() const {
+                return *reinterpret_cast<neuron *>(
+                    m_source & ~static_cast<uintptr_t>(1));
+            }
+
+            private:
+
+            /** Copying is forbidden (dendrites are kept in place) */
+            dendrite(const dendrite & orig) = delete;
+
+            /** Assignment is forbidden */
+            void operator = (const dendrite & rarg) = delete;
+
         };  // end of struct dendrite
 
-        typedef std::list<dendrite> dendrites_t;  /**< List of dendrites */
+        /** List of dendrites */
+        typedef std::list<dendrite, misc::polymorphic_allocator<dendrite> >
+            dendrites_t;
 
         private:
 
-        size_t      m_index;      /**< Index               */
-        type_t      m_type;       /**< Neuron type         */
-        Act_fn      m_act_fn;     /**< Activation function */
-        dendrites_t m_dendrites;  /**< Dendrites           */
+        friend class nn;
+
+        size_t      m_index;      /**< Index                       */
+        type_t      m_type;       /**< Neuron type                 */
+        Act_fn      m_act_fn;     /**< Activation function         */
+        dendrites_t m_dendrites;  /**< Dendrites                   */
+        version_t * m_version;    /**< Network stamp (may be NULL) */
+
+        /** Note (potential) weights change */
+        void weights_changed() {
+            if (NULL != m_version) ++m_version->weights;
+        }
+
+        /** Note topology change */
+        void topology_changed() {
+            if (NULL != m_version) ++m_version->topology;
+        }
 
         /** Index setter */
         size_t index(size_t new_index) {
@@ -125,6 +245,31 @@ class nn {
             return m_type = new_type;
         }
 
+        /**
+         *  \brief  Constructor (with memory resource)
+         *
+         *  \tparam Args      Types of activation functor constructor
+         *                    arguments
+         *  \param  resource  Memory resource (for dendrites)
+         *  \param  version   Network modification stamp
+         *  \param  index     Neuron index
+         *  \param  type      Neuron type
+         *  \param  args      Activation functor constructor arguments
+         */
+        template <typename... Args>
+        neuron(misc::memory_resource * resource,
+               version_t             * version,
+               size_t                  index,
+               type_t                  type,
+               Args...                 args)
+        :
+            m_index(index),
+            m_type(type),
+            m_act_fn(args...),
+            m_dendrites(typename dendrites_t::allocator_type(resource)),
+            m_version(version)
+        {}
+
         /**
          *  \brief  Add another dendrite
          *
@@ -137,10 +282,54 @@ class nn {
          *  \return New dendrite
          */
         dendrite & add_dendrite(neuron & n, Base_t w = Base_t()) {
+            topology_changed();
+
             m_dendrites.emplace_back(n, w);
             return m_dendrites.back();
         }
 
+        /**
+         *  \brief  Add another dendrite with shared weight
+         *
+         *  Note that the function DOES NOT CHECK for prior existence
+         *  of other dendrites to the neuron.
+         *
+         *  \param  n  Source neuron
+         *  \param  w  Shared synapsis weight
+         *
+         *  \return New dendrite
+         */
+        dendrite & add_shared_dendrite(neuron & n, Base_t & w) {
+            topology_changed();
+
+            m_dendrites.emplace_back(n, &w);
+            return m_dendrites.back();
+        }
+
+        /**
+         *  \brief  Set dendrite with shared weight
+         *
+         *  If a dendrite to \c n already exists, it's replaced.
+         *
+         *  \param  n  Source neuron
+         *  \param  w  Shared synapsis weight
+         *
+         *  \return Dendrite to \c n
+         */
+        dendrite & set_shared_dendrite(neuron & n, Base_t & w) {
+            weights_changed();
+
+            auto d_iter = get_dendrite_iter(n);
+
+            if (m_dendrites.end() != d_iter) {
+                if (&d_iter->weight() == &w) return *d_iter;
+
+                remove_dendrite(d_iter);
+            }
+
+            return add_shared_dendrite(n, w);
+        }
+
         /**
          *  \brief  Remove dendrite
          *
@@ -150,6 +339,8 @@ class nn {
          */
         typename dendrites_t::iterator
         remove_dendrite(typename dendrites_t::iterator d_iter) {
+            topology_changed();
+
             return m_dendrites.erase(d_iter);
         }
 
@@ -163,7 +354,7 @@ class nn {
         typename dendrites_t::iterator get_dendrite_iter(const neuron & n) {
             auto d_iter = m_dendrites.begin();
 
-            while (d_iter != m_dendrites.end() && &(d_iter->source) != &n)
+            while (d_iter != m_dendrites.end() && &(d_iter->source()) != &n)
                 ++d_iter;
 
             return d_iter;
@@ -186,7 +377,8 @@ class nn {
         :
             m_index(index),
             m_type(type),
-            m_act_fn(args...)
+            m_act_fn(args...),
+            m_version(NULL)
         {}
 
         /** Index getter */
@@ -199,7 +391,10 @@ class nn {
         const Act_fn & act_fn() const { return m_act_fn; }
 
         /** Activation functor getter */
-        Act_fn & act_fn() { return m_act_fn; }
+        Act_fn & act_fn() {
+            weights_changed();
+            return m_act_fn;
+        }
 
         /** Activation function evalueation */
         Base_t act_fn(const Base_t & arg) const { return m_act_fn(arg); }
@@ -215,6 +410,8 @@ class nn {
          *  \return Dendrite to \c n or \c NULL if it doesn't exist
          */
         dendrite * get_dendrite(const neuron & n) {
+            weights_changed();
+
             auto d_iter = get_dendrite_iter(n);
 
             return m_dendrites.end() == d_iter ? NULL : &*d_iter;
@@ -224,6 +421,9 @@ class nn {
          *  \brief  Set dendrite (i.e. synapsis to another neuron)
          *
          *  If no such dendrite already exists, it is added.
+         *  If it exists and its weight is shared, it's replaced by
+         *  dendrite with its own weight (i.e. the shared weight is NOT
+         *  changed).
          *
          *  \param  n  Source neuron
          *  \param  w  Synapsis weight
@@ -231,11 +431,18 @@ class nn {
          *  \return Dendrite to \c n
          */
         dendrite & set_dendrite(neuron & n, Base_t w = Base_t()) {
+            weights_changed();
+
             auto d_iter = get_dendrite_iter(n);
 
             if (m_dendrites.end() == d_iter) return add_dendrite(n, w);
 
-            d_iter->weight = w;
+            if (d_iter->shared()) {
+                remove_dendrite(d_iter);
+                return add_dendrite(n, w);
+            }
+
+            d_iter->weight() = w;
             return *d_iter;
         }
 
@@ -266,8 +473,8 @@ class nn {
             Base_t w = 0;
             auto   d_iter  = m_dendrites.begin();
             while (d_iter != m_dendrites.end()) {
-                if (d_iter->weight == 0) {
-                    w += d_iter->weight;
+                if (d_iter->weight() == 0) {
+                    w += d_iter->weight();
                     d_iter = remove_dendrite(d_iter);
                 }
                 else
@@ -297,6 +504,8 @@ class nn {
          */
         template <class Fn>
         void for_each_dendrite(Fn fn) {
+            weights_changed();
+
             std::for_each(m_dendrites.begin(), m_dendrites.end(),
             [fn](dendrite & dend) {
                 fn(dend);
@@ -307,14 +516,86 @@ class nn {
 
     private:
 
-    typedef std::unique_ptr<neuron> neuron_ptr;  /**< Neuron pointer */
-    typedef std::vector<neuron_ptr> neurons_t;   /**< Neurons list   */
-    typedef std::list<size_t>       indices_t;   /**< Indices list   */
+    /** Neuron deleter (neurons are allocated by the memory resource) */
+    class neuron_deleter {
+        private:
+
+        misc::memory_resource * m_resource;  /**< Memory resource */
+
+        public:
+
+        /** Constructor */
+        neuron_deleter(misc::memory_resource * resource = NULL):
+            m_resource(resource)
+        {}
+
+        /** Destroy neuron */
+        void operator () (neuron * n) const {
+            n->~neuron();
+            m_resource->deallocate(n, sizeof(neuron), alignof(neuron));
+        }
+
+    };  // end of class neuron_deleter
+
+    /** Neuron pointer */
+    typedef std::unique_ptr<neuron, neuron_deleter> neuron_ptr;
+
+    /** Neurons list */
+    typedef std::vector<neuron_ptr, misc::polymorphic_allocator<neuron_ptr> >
+        neurons_t;
+
+    /** Indices list */
+    typedef std::list<size_t, misc::polymorphic_allocator<size_t> >
+        indices_t;
+
+    /**
+     *  \brief  Shared weights
+     *
+     *  Note that deque is used since it keeps references to its items valid
+     *  on insertion at its end.
+     */
+    typedef std::deque<Base_t, misc::polymorphic_allocator<Base_t> >
+        shared_weights_t;
+
+    size_t                  m_size;      /**< Number of neurons  */
+    misc::memory_resource * m_resource;  /**< Memory resource    */
+    neurons_t               m_neurons;   /**< Neurons            */
+    indices_t               m_inputs;    /**< Input layer        */
+    indices_t               m_outputs;   /**< Output layer       */
+    shared_weights_t        m_shared;    /**< Shared weights     */
+    version_t               m_version;   /**< Modification stamp */
+
+    /**
+     *  \brief  Create neuron
+     *
+     *  The neuron is allocated by the memory resource.
+     *
+     *  \tparam Args   Types of activation functor constructor arguments
+     *  \param  index  Neuron index
+     *  \param  type   Neuron type
+     *  \param  args   Activation functor constructor arguments
+     *
+     *  \return Neuron pointer
+     */
+    template <typename... Args>
+    neuron_ptr create_neuron(
+        size_t                  index,
+        typename neuron::type_t type,
+        Args...                 args)
+    {
+        void * mem = m_resource->allocate(sizeof(neuron), alignof(neuron));
 
-    size_t    m_size;     /**< Number of neurons */
-    neurons_t m_neurons;  /**< Neurons           */
-    indices_t m_inputs;   /**< Input layer       */
-    indices_t m_outputs;  /**< Output layer      */
+        try {
+            return neuron_ptr(
+                new(mem) neuron(
+                    m_resource, &m_version, index, type, args...),
+                neuron_deleter(m_resource));
+        }
+        catch (...) {
+            m_resource->deallocate(mem, sizeof(neuron), alignof(neuron));
+            throw;
+        }
+    }
 
     /**
      *  \brief  Iterate over valid neuron pointers
@@ -344,6 +625,19 @@ class nn {
         });
     }
 
+    /**
+     *  \brief  Bind neurons to the network modification stamp
+     *
+     *  Done after the neurons were moved from another network.
+     */
+    void rebind() {
+        version_t * version = &m_version;
+
+        for_each_neuron_ptr([version](neuron_ptr & n_ptr) {
+            n_ptr->m_version = version;
+        });
+    }
+
     /**
      *  \brief  Resolve I/O layer
      *
@@ -407,7 +701,110 @@ class nn {
     /**
      *  \brief  Constructor (empty network)
      */
-    nn() {}
+    nn():
+        m_size(0),
+        m_resource(misc::new_delete_resource()),
+        m_neurons(m_resource),
+        m_inputs(m_resource),
+        m_outputs(m_resource),
+        m_shared(m_resource)
+    {}
+
+    /**
+     *  \brief  Constructor (empty network, with memory resource)
+     *
+     *  Neurons, dendrites and shared weights are allocated
+     *  by the \c resource (which must outlive the network).
+     *
+     *  \param  resource  Memory resource
+     */
+    explicit nn(misc::memory_resource * resource):
+        m_size(0),
+        m_resource(resource),
+        m_neurons(m_resource),
+        m_inputs(m_resource),
+        m_outputs(m_resource),
+        m_shared(m_resource)
+    {}
+
+    /**
+     *  \brief  Move constructor
+     *
+     *  The network storage is taken over (incl. the memory resource),
+     *  so shared weights references stay valid.
+     *  The original is left empty.
+     *
+     *  \param  orig  Moved network
+     */
+    nn(nn && orig):
+        m_size(orig.m_size),
+        m_resource(orig.m_resource),
+        m_neurons(std::move(orig.m_neurons)),
+        m_inputs(std::move(orig.m_inputs)),
+        m_outputs(std::move(orig.m_outputs)),
+        m_shared(std::move(orig.m_shared)),
+        m_version(orig.m_version)
+    {
+        orig.m_size = 0;
+        ++orig.m_version.topology;
+
+        rebind();
+    }
+
+    /**
+     *  \brief  Move assignment
+     *
+     *  The storage can only be exchanged between networks using
+     *  the same memory resource (element-wise move between resources
+     *  would relocate the shared weights, leaving dendrites referring
+     *  to them dangling).
+     *  \c std::logic_error is thrown if the resources differ.
+     *
+     *  \param  rarg  Moved network
+     *
+     *  \return \c *this
+     */
+    nn & operator = (nn && rarg) {
+        if (this == &rarg) return *this;
+
+        if (!m_resource->is_equal(*rarg.m_resource))
+            throw std::logic_error(
+                "libnn::nn::operator =: memory resources differ");
+
+        nn moved(std::move(rarg));
+
+        std::swap(m_size, moved.m_size);
+        m_neurons.swap(moved.m_neurons);
+        m_inputs.swap(moved.m_inputs);
+        m_outputs.swap(moved.m_outputs);
+        m_shared.swap(moved.m_shared);
+
+        // The stamp must differ from both the former states
+        m_version.topology =
+            std::max(m_version.topology, moved.m_version.topology) + 1;
+        m_version.weights  =
+            std::max(m_version.weights,  moved.m_version.weights)  + 1;
+
+        rebind();
+        moved.rebind();
+
+        return *this;
+    }
+
+    /** Memory resource getter */
+    misc::memory_resource * resource() const { return m_resource; }
+
+    /** Modification stamp getter */
+    const version_t & version() const { return m_version; }
+
+    /**
+     *  \brief  Note weights change
+     *
+     *  Shall be called if the synapses weights were changed by other
+     *  means than the network interface (e.g. via weight pointers
+     *  kept by a dense evaluation plan).
+     */
+    void weights_changed() { ++m_version.weights; }
 
     /**
      *  \brief  Network size (i.e. number of neurons) getter
@@ -429,14 +826,110 @@ class nn {
      */
     size_t output_size() const { return m_outputs.size(); }
 
+    /**
+     *  \brief  Memory usage (bytes)
+     *
+     *  Neurons (incl. I/O layers definitions), their dendrites and shared
+     *  weights.
+     */
+    misc::memory_usage memory_usage() const {
+        misc::memory_usage usage;
+
+        usage.neurons =
+            misc::heap_size(m_neurons) + m_size * sizeof(neuron) +
+            misc::heap_size(m_inputs)  + misc::heap_size(m_outputs);
+
+        usage.dendrites = misc::heap_size(m_shared);
+
+        for_each_neuron_ptr([&usage](const neuron_ptr & n_ptr) {
+            usage.dendrites += misc::heap_size(n_ptr->m_dendrites);
+        });
+
+        return usage;
+    }
+
     /** Clear network */
     void clear() {
+        ++m_version.topology;
+
         m_inputs.clear();
         m_outputs.clear();
         m_neurons.clear();
+        m_shared.clear();
         m_size = 0;
     }
 
+    /**
+     *  \brief  Add shared weight
+     *
+     *  Creates new shared weight.
+     *  Synapses may refer to it by its index (see \ref set_shared_dendrite).
+     *
+     *  \param  w  Initial weight value
+     *
+     *  \return Shared weight index
+     */
+    size_t add_shared_weight(const Base_t & w = Base_t()) {
+        m_shared.push_back(w);
+        return m_shared.size() - 1;
+    }
+
+    /** Shared weight count getter */
+    size_t shared_weight_cnt() const { return m_shared.size(); }
+
+    /**
+     *  \brief  Shared weight getter
+     *
+     *  \param  index  Shared weight index
+     *
+     *  \return Shared weight
+     */
+    Base_t & shared_weight(size_t index) {
+        if (!(index < m_shared.size()))
+            throw std::range_error(
+                "libnn::nn::shared_weight: invalid index");
+
+        ++m_version.weights;
+
+        return m_shared[index];
+    }
+
+    /**
+     *  \brief  Shared weight getter (const)
+     *
+     *  \param  index  Shared weight index
+     *
+     *  \return Shared weight
+     */
+    const Base_t & shared_weight(size_t index) const {
+        if (!(index < m_shared.size()))
+            throw std::range_error(
+                "libnn::nn::shared_weight: invalid index");
+
+        return m_shared[index];
+    }
+
+    /**
+     *  \brief  Set dendrite with shared weight
+     *
+     *  Sets synapsis from \c source to \c target neuron with shared
+     *  weight.
+     *  If such a synapsis exists, it's replaced.
+     *
+     *  \param  target  Target neuron
+     *  \param  source  Source neuron
+     *  \param  index   Shared weight index
+     *
+     *  \return Dendrite to \c source
+     */
+    typename neuron::dendrite & set_shared_dendrite(
+        neuron & target,
+        neuron & source,
+        size_t   index)
+    {
+        return target.set_shared_dendrite(source, shared_weight(index));
+    }
+
     /**
      *  \brief  Iterate over neurons
      *
@@ -576,14 +1069,14 @@ class nn {
         typename neuron::type_t type = neuron::INNER,
         Args...                 args)
     {
-        size_t index = m_neurons.size();
-        auto n = new neuron(index, type, args...);
-        m_neurons.emplace_back(n);
+        m_neurons.push_back(create_neuron(m_neurons.size(), type, args...));
         ++m_size;
+        ++m_version.topology;
 
-        io_add(*n);  // add I/O layer entry
+        neuron & n = *m_neurons.back();
+        io_add(n);  // add I/O layer entry
 
-        return *n;
+        return n;
     }
 
     /**
@@ -602,6 +1095,7 @@ class nn {
         // Destroy the neuron
         m_neurons[n.index()].reset();
         --m_size;
+        ++m_version.topology;
     }
 
     /**
@@ -635,12 +1129,13 @@ class nn {
         else
             ++m_size;  // only increment if neuron isn't replaced
 
-        auto n = new neuron(index, type, args...);
-        m_neurons[index].reset(n);
+        m_neurons[index] = create_neuron(index, type, args...);
+        ++m_version.topology;
 
-        io_add(*n);  // add I/O layer entry
+        neuron & n = *m_neurons[index];
+        io_add(n);  // add I/O layer entry
 
-        return *n;
+        return n;
     }
 
     /**
@@ -650,22 +1145,24 @@ class nn {
      *  Note that this invalidates any existing indexation-based objects!
      */
     void reindex() {
-        neurons_t neurons;
+        neurons_t neurons(m_neurons.get_allocator());
         neurons.reserve(m_size);
 
         // Clear I/O layer definitions
         m_inputs.clear();
         m_outputs.clear();
 
-        for_each_neuron_ptr([&neurons](neuron_ptr & n_ptr) {
+        for_each_neuron_ptr([this, &neurons](neuron_ptr & n_ptr) {
             size_t index = neurons.size();
             n_ptr->index(index);
-            neurons.push_back(n_ptr);
 
             io_add(*n_ptr);  // resolve I/O layer
+
+            neurons.push_back(std::move(n_ptr));
         });
 
         m_neurons.swap(neurons);
+        ++m_version.topology;
     }
 
     /**
@@ -679,7 +1176,7 @@ class nn {
      */
     void prune() {
         for_each_neuron([](neuron & n) {
-            n.minimise_dendrites;
+            n.minimise_dendrites();
         });
     }
 
@@ -720,4 +1217,20 @@ class nn {
 
 }}  // end of namespace libnn::topo
 
+// Explicit instantiations (see libnn/instances.hxx)
+#ifndef LIBNN_HEADER_ONLY
+/** \cond */
+namespace libnn {
+namespace topo {
+
+#define LIBNN_EXTERN(Base_t, Act_fn) \
+    extern template class nn<Base_t, Act_fn>;
+LIBNN_INSTANCES(LIBNN_EXTERN)
+
+#undef LIBNN_EXTERN
+
+}}  // end of namespace libnn::topo
+/** \endcond */
+#endif  // end of #ifndef LIBNN_HEADER_ONLY
+
 #endif  // end of #ifndef libnn__topo__nn_hxx
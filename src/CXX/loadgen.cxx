@@ -0,0 +1,291 @@
+/**
+ *  Inference server load generator
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "config.hxx"
+#include "serve.hxx"
+
+#include <libnn/misc/unix_socket.hxx>
+#include <libnn/misc/latency.hxx>
+
+#include <vector>
+#include <string>
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <exception>
+#include <stdexcept>
+#include <cstdlib>
+
+extern "C" {
+#include <unistd.h>
+}
+
+
+/** Options */
+struct options {
+    std::string socket;       /**< Socket path                 */
+    size_t      connections;  /**< Connection count            */
+    size_t      requests;     /**< Requests per connection     */
+    size_t      reconnect;    /**< Reconnect period (requests) */
+
+    /** Defaults */
+    options():
+        socket("/tmp/nn_serve.sock"),
+        connections(8),
+        requests(1000),
+        reconnect(0)
+    {}
+
+};  // end of struct options
+
+
+/** Connection (client thread) result */
+struct result {
+    size_t              errors;     /**< Failed requests        */
+    std::vector<double> latencies;  /**< Request latencies (s)  */
+
+    /** Constructor */
+    result(): errors(0) {}
+
+};  // end of struct result
+
+
+/** Print usage */
+static void usage(const char * prog) {
+    std::cerr
+        << "Usage: " << prog << " [OPTIONS]" << std::endl
+        << std::endl
+        << "Load generator for the inference server (nn_serve)" << std::endl
+        << std::endl
+        << "Each connection sends single-sample requests in a closed loop"
+        << std::endl
+        << "(next request is sent once the previous one is responded)."
+        << std::endl
+        << std::endl
+        << "OPTIONS:" << std::endl
+        << "    -s PATH    socket path (default: /tmp/nn_serve.sock)"
+        << std::endl
+        << "    -c COUNT   concurrent connections (default: 8)" << std::endl
+        << "    -n COUNT   requests per connection (default: 1000)"
+        << std::endl
+        << "    -r COUNT   reconnect every COUNT requests (default: never)"
+        << std::endl
+        << "    -h         this help" << std::endl;
+}
+
+
+/**
+ *  \brief  Get network input and output sizes
+ *
+ *  \param  path  Server socket path
+ *
+ *  \return Input and output sizes
+ */
+static std::pair<size_t, size_t> info(const std::string & path) {
+    libnn::misc::unix_socket socket = libnn::misc::unix_socket::connect(path);
+
+    serve::send(socket, serve::INFO, 0, std::vector<double>());
+
+    serve::header       hdr;
+    std::vector<double> sizes;
+
+    if (!serve::recv(socket, hdr, sizes) || hdr.status || 2 != sizes.size())
+        throw std::runtime_error("network info request failed");
+
+    return std::pair<size_t, size_t>(sizes[0], sizes[1]);
+}
+
+
+/**
+ *  \brief  Client (connection) routine
+ *
+ *  The client reconnects every \c reconnect requests (if non-zero),
+ *  so that the server sees many short connections.
+ *  Connection time is not included in request latency.
+ *
+ *  \param  path        Server socket path
+ *  \param  seed        Random inputs seed
+ *  \param  requests    Request count
+ *  \param  reconnect   Reconnect period (0 means never)
+ *  \param  input_size  Network input size
+ *  \param  res         Result
+ */
+static void client(
+    const std::string & path,
+    unsigned            seed,
+    size_t              requests,
+    size_t              reconnect,
+    size_t              input_size,
+    result            & res)
+{
+    typedef std::chrono::steady_clock clock_t;
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    libnn::misc::unix_socket socket;
+
+    std::vector<double> input(input_size), output;
+    serve::header       hdr;
+
+    res.latencies.reserve(requests);
+
+    for (size_t i = 0; i < requests; ++i) {
+        if (!socket.is_open() || (reconnect && 0 == i % reconnect))
+            socket = libnn::misc::unix_socket::connect(path);
+
+        for (size_t j = 0; j < input_size; ++j) input[j] = uniform(rng);
+
+        const auto t0 = clock_t::now();
+
+        serve::send(socket, serve::EVAL, 0, input);
+        if (!serve::recv(socket, hdr, output))
+            throw std::runtime_error("connection closed by server");
+
+        const auto t1 = clock_t::now();
+
+        if (hdr.status)
+            ++res.errors;
+        else
+            res.latencies.push_back(
+                std::chrono::duration<double>(t1 - t0).count());
+    }
+}
+
+
+/** Load generator main routine */
+static int main_impl(int argc, char * const argv[]) {
+    typedef std::chrono::steady_clock clock_t;
+
+    options opts;
+
+    for (int opt; -1 != (opt = ::getopt(argc, argv, "s:c:n:r:h")); ) {
+        switch (opt) {
+            case 's': opts.socket      = optarg;          break;
+            case 'c': opts.connections = ::atol(optarg);  break;
+            case 'n': opts.requests    = ::atol(optarg);  break;
+            case 'r': opts.reconnect   = ::atol(optarg);  break;
+
+            case 'h':
+                usage(argv[0]);
+                return 0;
+
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    const std::pair<size_t, size_t> sizes = info(opts.socket);
+
+    std::cout
+        << "Network " << sizes.first << " -> " << sizes.second << ", "
+        << opts.connections << " connection(s) x "
+        << opts.requests << " request(s)" << std::endl;
+
+    std::vector<result>      results(opts.connections);
+    std::vector<std::thread> clients;
+
+    const auto t0 = clock_t::now();
+
+    for (size_t i = 0; i < opts.connections; ++i)
+        clients.emplace_back([&opts, &sizes, &results, i]() {
+            try {
+                client(opts.socket, i + 1, opts.requests, opts.reconnect,
+                    sizes.first, results[i]);
+            }
+            catch (const std::exception & x) {
+                std::cerr << "Connection " << i << ": " << x.what()
+                    << std::endl;
+            }
+        });
+
+    for (size_t i = 0; i < clients.size(); ++i) clients[i].join();
+
+    const double time = std::chrono::duration<double>(
+        clock_t::now() - t0).count();
+
+    // Statistics
+    size_t responses = 0, errors = 0;
+    for (size_t i = 0; i < results.size(); ++i) {
+        responses += results[i].latencies.size();
+        errors    += results[i].errors;
+    }
+
+    libnn::misc::latency_stats latency(std::max<size_t>(1, responses));
+    for (size_t i = 0; i < results.size(); ++i)
+        for (size_t j = 0; j < results[i].latencies.size(); ++j)
+            latency.record(results[i].latencies[j]);
+
+    std::cout
+        << "Requests: " << responses << " succeeded, "
+        << errors << " failed" << std::endl
+        << "Time: " << time << " s" << std::endl
+        << "Throughput: " << responses / time << " req/s" << std::endl
+        << "Latency: p50 " << latency.percentile(50) * 1000 << " ms"
+        << ", p99 " << latency.percentile(99) * 1000 << " ms"
+        << ", max " << latency.max() * 1000 << " ms"
+        << ", mean " << latency.mean() * 1000 << " ms" << std::endl;
+
+    return responses == opts.connections * opts.requests ? 0 : 1;
+}
+
+/** Exception-safe wrapper */
+int main(int argc, char * const argv[]) {
+    int exit_code = 128;
+
+    try {
+        exit_code = main_impl(argc, argv);
+    }
+    catch (const std::exception & x) {
+        std::cerr
+            << "Standard exception caught: "
+            << x.what()
+            << std::endl;
+    }
+    catch (...) {
+        std::cerr
+            << "Unhandled non-standard exception caught"
+            << std::endl;
+    }
+
+    return exit_code;
+}
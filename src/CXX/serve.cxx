@@ -0,0 +1,394 @@
+/**
+ *  Micro-batching inference server
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "config.hxx"
+#include "serve.hxx"
+
+#include <libnn/model/feed_forward.hxx>
+#include <libnn/io/sigmoid.hxx>
+#include <libnn/io/feed_forward.hxx>
+#include <libnn/ml/micro_batch.hxx>
+#include <libnn/misc/unix_socket.hxx>
+#include <libnn/misc/thread_pool.hxx>
+#include <libnn/math/sigmoid.hxx>
+
+#include <vector>
+#include <list>
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <stdexcept>
+#include <cstdlib>
+#include <csignal>
+
+extern "C" {
+#include <unistd.h>
+}
+
+
+/** Feed-forward network model */
+typedef libnn::model::feed_forward<double, libnn::math::logistic_fn<double> >
+    nn_t;
+
+/** Micro-batcher */
+typedef libnn::ml::micro_batcher<double, nn_t::function_t> batcher_t;
+
+
+/** Stop request (set by signal) */
+static volatile sig_atomic_t stop_request = 0;
+
+/** Stop request signal handler */
+static void on_signal(int) { stop_request = 1; }
+
+
+/** Options */
+struct options {
+    std::string socket;     /**< Socket path                         */
+    std::string model;      /**< Network file                        */
+    std::string random;     /**< Random network layers specification */
+    size_t      max_batch;  /**< Maximal batch size                  */
+    size_t      window;     /**< Batching window (us)                */
+    size_t      threads;    /**< Evaluation threads                  */
+    double      interval;   /**< Statistics interval (s)             */
+
+    /** Defaults */
+    options():
+        socket("/tmp/nn_serve.sock"),
+        max_batch(64),
+        window(1000),
+        threads(1),
+        interval(0)
+    {}
+
+};  // end of struct options
+
+
+/** Print usage */
+static void usage(const char * prog) {
+    std::cerr
+        << "Usage: " << prog << " [OPTIONS]" << std::endl
+        << std::endl
+        << "Micro-batching inference server (feed-forward network)"
+        << std::endl
+        << std::endl
+        << "OPTIONS:" << std::endl
+        << "    -s PATH    socket path (default: /tmp/nn_serve.sock)"
+        << std::endl
+        << "    -m FILE    network file (serialised feed-forward network)"
+        << std::endl
+        << "    -r SPEC    random network of layers SPEC (e.g. 64,128,10)"
+        << std::endl
+        << "    -b SIZE    maximal batch size (default: 64)" << std::endl
+        << "    -w USEC    batching window (default: 1000 us)" << std::endl
+        << "    -t COUNT   evaluation threads (default: 1)" << std::endl
+        << "    -i SEC     statistics report interval (default: on exit)"
+        << std::endl
+        << "    -h         this help" << std::endl;
+}
+
+
+/** Uniform random weight initialiser */
+class weight_init {
+    public:
+
+    /** Weight in [-1, 1] */
+    double operator () () const {
+        return 2.0 * ::rand() / RAND_MAX - 1.0;
+    }
+
+};  // end of class weight_init
+
+
+/**
+ *  \brief  Create network
+ *
+ *  \param  opts  Options
+ *
+ *  \return Network
+ */
+static nn_t create_nn(const options & opts) {
+    if (!opts.model.empty()) {
+        std::ifstream file(opts.model.c_str());
+        if (!file)
+            throw std::runtime_error("failed to open " + opts.model);
+
+        nn_t nn;
+        libnn::io::deserialise(file, nn);
+
+        return nn;
+    }
+
+    std::vector<size_t> layers;
+
+    std::stringstream spec(opts.random);
+    for (std::string size; std::getline(spec, size, ','); )
+        layers.push_back(::atol(size.c_str()));
+
+    weight_init w_init;
+    return nn_t(layers, w_init, nn_t::BIAS);
+}
+
+
+/**
+ *  \brief  Print statistics
+ *
+ *  \param  batcher  Micro-batcher
+ */
+static void report(const batcher_t & batcher) {
+    const batcher_t::stats st = batcher.statistics();
+
+    std::cout
+        << "requests " << st.requests
+        << ", batches " << st.batches
+        << " (avg. size " << st.batch_avg << ")"
+        << ", latency p50 " << st.latency_p50 * 1000 << " ms"
+        << ", p99 " << st.latency_p99 * 1000 << " ms"
+        << ", max " << st.latency_max * 1000 << " ms"
+        << ", throughput " << st.throughput << " req/s"
+        << std::endl;
+}
+
+
+/**
+ *  \brief  Serve connection
+ *
+ *  \param  socket   Connection
+ *  \param  batcher  Micro-batcher
+ *  \param  sizes    Network input and output sizes
+ */
+static void serve_connection(
+    libnn::misc::unix_socket  & socket,
+    batcher_t                 & batcher,
+    const std::vector<double> & sizes)
+{
+    try {
+        serve::header       hdr;
+        std::vector<double> values;
+
+        while (serve::recv(socket, hdr, values)) {
+            if (serve::INFO == hdr.type) {
+                serve::send(socket, serve::INFO, 0, sizes);
+                continue;
+            }
+
+            std::vector<double> output;
+            uint32_t status = 1;
+
+            if (serve::EVAL == hdr.type && values.size() == sizes[0]) {
+                try {
+                    output = batcher(std::move(values));
+                    status = 0;
+                }
+                catch (const std::exception & x) {
+                    std::cerr << "Evaluation failed: " << x.what() << std::endl;
+                }
+            }
+
+            serve::send(socket, (serve::type_t)hdr.type, status, output);
+        }
+    }
+    catch (const std::exception & ) {}  // connection failure
+}
+
+
+/** Server main routine */
+static int main_impl(int argc, char * const argv[]) {
+    options opts;
+
+    for (int opt; -1 != (opt = ::getopt(argc, argv, "s:m:r:b:w:t:i:h")); ) {
+        switch (opt) {
+            case 's': opts.socket    = optarg;          break;
+            case 'm': opts.model     = optarg;          break;
+            case 'r': opts.random    = optarg;          break;
+            case 'b': opts.max_batch = ::atol(optarg);  break;
+            case 'w': opts.window    = ::atol(optarg);  break;
+            case 't': opts.threads   = ::atol(optarg);  break;
+            case 'i': opts.interval  = ::atof(optarg);  break;
+
+            case 'h':
+                usage(argv[0]);
+                return 0;
+
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    if (opts.model.empty() == opts.random.empty()) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    nn_t nn = create_nn(opts);
+    nn_t::function_t fn = nn.function();
+
+    std::unique_ptr<libnn::misc::thread_pool> pool;
+    if (opts.threads > 1) {
+        pool.reset(new libnn::misc::thread_pool(opts.threads));
+        fn.executor(pool.get());
+    }
+
+    const size_t input_size  = nn.layer(0).size();
+    const size_t output_size = nn.layer(nn.layer_cnt() - 1).size();
+
+    const std::vector<double> sizes = {
+        (double)input_size, (double)output_size };
+
+    batcher_t batcher(fn, opts.max_batch,
+        batcher_t::window_t(opts.window));
+
+    ::signal(SIGINT,  on_signal);
+    ::signal(SIGTERM, on_signal);
+
+    // Connections
+    libnn::misc::unix_socket listen =
+        libnn::misc::unix_socket::listen(opts.socket);
+
+    struct connection {
+        libnn::misc::unix_socket socket;  /**< Socket                  */
+        std::thread              thread;  /**< Serving thread          */
+        std::atomic<bool>        done;    /**< Serving thread finished */
+
+        /** Constructor */
+        connection(): done(false) {}
+
+    };  // end of struct connection
+
+    std::mutex conns_mx;
+    std::list<std::unique_ptr<connection> > conns;
+
+    std::thread acceptor([&]() {
+        for (;;) {
+            libnn::misc::unix_socket socket = listen.accept();
+            if (!socket.is_open()) return;
+
+            std::lock_guard<std::mutex> lock(conns_mx);
+
+            // Reap finished connections
+            for (auto conn = conns.begin(); conn != conns.end(); ) {
+                if (!(*conn)->done) { ++conn; continue; }
+
+                (*conn)->thread.join();
+                conn = conns.erase(conn);
+            }
+
+            conns.emplace_back(new connection());
+
+            connection & conn = *conns.back();
+            conn.socket = std::move(socket);
+            conn.thread = std::thread([&batcher, &sizes, &conn]() {
+                serve_connection(conn.socket, batcher, sizes);
+                conn.done = true;
+            });
+        }
+    });
+
+    std::cout
+        << "Serving " << input_size << " -> " << output_size
+        << " network on " << opts.socket
+        << " (max. batch " << opts.max_batch
+        << ", window " << opts.window << " us)" << std::endl;
+
+    // Periodic statistics
+    auto last = std::chrono::steady_clock::now();
+    while (!stop_request) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        const auto now = std::chrono::steady_clock::now();
+        if (opts.interval > 0 &&
+            std::chrono::duration<double>(now - last).count() >= opts.interval)
+        {
+            report(batcher);
+            batcher.reset_statistics();
+
+            last = now;
+        }
+    }
+
+    // Shutdown
+    listen.shutdown();
+    acceptor.join();
+
+    {
+        std::lock_guard<std::mutex> lock(conns_mx);
+
+        for (auto conn = conns.begin(); conn != conns.end(); ++conn) {
+            (*conn)->socket.shutdown();
+            (*conn)->thread.join();
+        }
+    }
+
+    batcher.stop();
+    ::unlink(opts.socket.c_str());
+
+    report(batcher);
+
+    return 0;
+}
+
+/** Exception-safe wrapper */
+int main(int argc, char * const argv[]) {
+    int exit_code = 128;
+
+    try {
+        exit_code = main_impl(argc, argv);
+    }
+    catch (const std::exception & x) {
+        std::cerr
+            << "Standard exception caught: "
+            << x.what()
+            << std::endl;
+    }
+    catch (...) {
+        std::cerr
+            << "Unhandled non-standard exception caught"
+            << std::endl;
+    }
+
+    return exit_code;
+}
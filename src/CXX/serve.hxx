@@ -0,0 +1,132 @@
+#ifndef libnn__serve_hxx
+#define libnn__serve_hxx
+
+/**
+ *  Inference server protocol
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <libnn/misc/unix_socket.hxx>
+
+#include <cstdint>
+#include <vector>
+#include <stdexcept>
+
+
+/**
+ *  \brief  Inference server protocol
+ *
+ *  Messages (requests and responses) consist of a header followed
+ *  by \c cnt values (\c double, in the native byte order; the peers
+ *  share a host).
+ *  - \c INFO request (no values) is responded by the network input
+ *    and output sizes
+ *  - \c EVAL request (input) is responded by the network output
+ *
+ *  Failed requests are responded with non-zero status (and no values).
+ */
+namespace serve {
+
+/** Message type */
+enum type_t {
+    INFO = 0,  /**< Network info request */
+    EVAL       /**< Evaluation request   */
+};  // end of enum type_t
+
+/** Message header */
+struct header {
+    uint32_t type;    /**< Message type (see \ref type_t)      */
+    uint32_t status;  /**< Status (responses; 0 means success) */
+    uint64_t cnt;     /**< Value count                         */
+};  // end of struct header
+
+/** Maximal value count (sanity limit) */
+static const uint64_t max_cnt = 1 << 24;
+
+
+/**
+ *  \brief  Send message
+ *
+ *  \param  socket  Connection
+ *  \param  type    Message type
+ *  \param  status  Status
+ *  \param  values  Values
+ */
+inline void send(
+    libnn::misc::unix_socket  & socket,
+    type_t                      type,
+    uint32_t                    status,
+    const std::vector<double> & values)
+{
+    const header hdr = { (uint32_t)type, status, values.size() };
+
+    socket.send(&hdr, sizeof(hdr));
+    socket.send(values.data(), values.size() * sizeof(double));
+}
+
+
+/**
+ *  \brief  Receive message
+ *
+ *  \param  socket  Connection
+ *  \param  hdr     Message header
+ *  \param  values  Values
+ *
+ *  \return \c false if the peer closed the connection
+ *          (throws if the connection closed in the middle of a message)
+ */
+inline bool recv(
+    libnn::misc::unix_socket & socket,
+    header                   & hdr,
+    std::vector<double>      & values)
+{
+    if (!socket.recv(&hdr, sizeof(hdr))) return false;
+
+    if (hdr.cnt > max_cnt)
+        throw std::runtime_error("serve::recv: message too long");
+
+    values.resize(hdr.cnt);
+    if (!socket.recv(values.data(), hdr.cnt * sizeof(double)))
+        throw std::runtime_error("serve::recv: message truncated");
+
+    return true;
+}
+
+}  // end of namespace serve
+
+
+#endif  // end of #ifndef libnn__serve_hxx
@@ -0,0 +1,580 @@
+#include "config.hxx"
+
+#include <libnn/capi.h>
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+#include <new>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+
+/** Allocation counter */
+static std::atomic<size_t> alloc_cnt(0);
+
+/** \cond */
+void * operator new (size_t size) {
+    ++alloc_cnt;
+
+    void * ptr = ::malloc(size ? size : 1);
+    if (NULL == ptr) throw std::bad_alloc();
+
+    return ptr;
+}
+
+void operator delete (void * ptr) noexcept { ::free(ptr); }
+
+void operator delete (void * ptr, size_t) noexcept { ::free(ptr); }
+/** \endcond */
+
+
+/** Report failed call */
+#define CHECK_OK(call) \
+    do { \
+        const libnn_status status = (call); \
+        if (LIBNN_OK != status) { \
+            std::cout \
+                << #call << " failed: " << libnn_strerror(status) \
+                << " (" << libnn_last_error() << ')' << std::endl; \
+            ++error_cnt; \
+        } \
+    } while (0)
+
+
+/**
+ *  \brief  Random inputs
+ *
+ *  \param  rows  Row count
+ *  \param  cols  Column count
+ *
+ *  \return Inputs (row-major, values in [0, 1])
+ */
+template <typename T>
+static std::vector<T> random_inputs(size_t rows, size_t cols) {
+    std::vector<T> x(rows * cols);
+    for (size_t i = 0; i < x.size(); ++i) x[i] = (T)::rand() / RAND_MAX;
+
+    return x;
+}
+
+
+/**
+ *  \brief  Maximal difference
+ *
+ *  \param  a  Vector
+ *  \param  b  Vector
+ *
+ *  \return max |a_i - b_i|
+ */
+template <typename T>
+static double max_diff(const std::vector<T> & a, const std::vector<T> & b) {
+    double diff = 0;
+    for (size_t i = 0; i < a.size(); ++i)
+        diff = std::max(diff, (double)std::abs(a[i] - b[i]));
+
+    return diff;
+}
+
+
+/**
+ *  \brief  Model save & load test
+ *
+ *  \param  format  Data format
+ *  \param  tol     Tolerance of outputs of the loaded model
+ *
+ *  \return Count of errors
+ */
+static int test_load_save(libnn_format format, double tol) {
+    std::cout
+        << "C API " << (LIBNN_TEXT == format ? "text" : "binary")
+        << " load & save test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    const size_t layers[] = { 5, 9, 7, 3 };
+    const char * path     = "capi_test.nn";
+
+    libnn_model * model = NULL, * loaded = NULL;
+    CHECK_OK(libnn_model_create(LIBNN_DOUBLE, layers, 4,
+        LIBNN_BIAS | LIBNN_LATERAL, -1, 1, 1, &model));
+    if (error_cnt) return error_cnt;
+
+    CHECK_OK(libnn_model_save(model, path, format));
+    CHECK_OK(libnn_model_load(path, format, LIBNN_DOUBLE, &loaded));
+    if (error_cnt) return error_cnt;
+
+    if (5 != libnn_model_input_size(loaded) ||
+        3 != libnn_model_output_size(loaded) ||
+        LIBNN_DOUBLE != libnn_model_dtype(loaded))
+    {
+        std::cout << "Loaded model mismatch" << std::endl;
+
+        ++error_cnt;
+    }
+
+    const size_t rows = 50;
+    const std::vector<double> x = random_inputs<double>(rows, 5);
+    std::vector<double> y(rows * 3), y_loaded(rows * 3);
+
+    libnn_context * ctx = NULL, * ctx_loaded = NULL;
+    CHECK_OK(libnn_context_create(model,  rows, &ctx));
+    CHECK_OK(libnn_context_create(loaded, rows, &ctx_loaded));
+    CHECK_OK(libnn_eval_f64(ctx,        x.data(), rows, y.data()));
+    CHECK_OK(libnn_eval_f64(ctx_loaded, x.data(), rows, y_loaded.data()));
+
+    const double diff = max_diff(y, y_loaded);
+    if (diff > tol) {
+        std::cout << "Loaded model outputs differ by " << diff << std::endl;
+
+        ++error_cnt;
+    }
+
+    // Loading from memory
+    if (LIBNN_BINARY == format) {
+        std::vector<char> data;
+
+        FILE * file = ::fopen(path, "rb");
+        for (int ch; EOF != (ch = ::fgetc(file)); ) data.push_back(ch);
+        ::fclose(file);
+
+        libnn_model * mem = NULL;
+        CHECK_OK(libnn_model_load_mem(data.data(), data.size(), format,
+            LIBNN_DOUBLE, &mem));
+
+        libnn_context * ctx_mem = NULL;
+        std::vector<double> y_mem(rows * 3);
+        CHECK_OK(libnn_context_create(mem, rows, &ctx_mem));
+        CHECK_OK(libnn_eval_f64(ctx_mem, x.data(), rows, y_mem.data()));
+
+        if (y_mem != y) {
+            std::cout << "Model loaded from memory differs" << std::endl;
+
+            ++error_cnt;
+        }
+
+        // Base numeric type must match
+        libnn_model * bad = NULL;
+        if (LIBNN_EFORMAT != libnn_model_load_mem(data.data(), data.size(),
+            format, LIBNN_FLOAT, &bad))
+        {
+            std::cout << "Incompatible base type not detected" << std::endl;
+
+            ++error_cnt;
+        }
+
+        libnn_context_destroy(ctx_mem);
+        libnn_model_destroy(mem);
+    }
+
+    libnn_context_destroy(ctx_loaded);
+    libnn_context_destroy(ctx);
+    libnn_model_destroy(loaded);
+    libnn_model_destroy(model);
+
+    ::remove(path);
+
+    std::cout << "C API load & save test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  Training test (XOR, float model)
+ *
+ *  \return Count of errors
+ */
+static int test_train() {
+    std::cout << "C API training test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    const size_t layers[] = { 2, 4, 1 };
+    const float  x[]      = { 0, 0,  0, 1,  1, 0,  1, 1 };
+    const float  y[]      = { 0,     1,     1,     0    };
+
+    libnn_model   * model = NULL;
+    libnn_context * ctx   = NULL;
+    CHECK_OK(libnn_model_create(LIBNN_FLOAT, layers, 3, LIBNN_BIAS,
+        -1, 1, 3, &model));
+    CHECK_OK(libnn_context_create(model, 4, &ctx));
+    if (error_cnt) return error_cnt;
+
+    float err0 = 0, err = 0;
+    CHECK_OK(libnn_train_f32(ctx, x, y, 4, 0, &err0));
+    for (int i = 0; i < 5000; ++i)
+        CHECK_OK(libnn_train_f32(ctx, x, y, 4, 2, &err));
+
+    std::cout << "Error: " << err0 << " -> " << err << std::endl;
+
+    if (!(err < err0 && err < 0.05)) {
+        std::cout << "Training didn't converge" << std::endl;
+
+        ++error_cnt;
+    }
+
+    float out[4];
+    CHECK_OK(libnn_eval_f32(ctx, x, 4, out));
+    for (size_t i = 0; i < 4; ++i)
+        if (std::abs(out[i] - y[i]) > 0.3) {
+            std::cout << "Unexpected output " << out[i] << std::endl;
+
+            ++error_cnt;
+        }
+
+    // Wrong base numeric type
+    double xd[2] = { 0, 0 }, yd[1];
+    if (LIBNN_EINVAL != libnn_eval_f64(ctx, xd, 1, yd)) {
+        std::cout << "Base numeric type mismatch not detected" << std::endl;
+
+        ++error_cnt;
+    }
+
+    libnn_context_destroy(ctx);
+    libnn_model_destroy(model);
+
+    std::cout << "C API training test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  Allocations test
+ *
+ *  Evaluation and training shall not allocate memory (once the context
+ *  training is set up).
+ *
+ *  \return Count of errors
+ */
+static int test_allocations() {
+    std::cout << "C API allocations test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    const size_t layers[] = { 16, 32, 32, 4 };
+    const size_t rows     = 64;
+
+    libnn_model   * model = NULL;
+    libnn_context * ctx   = NULL;
+    CHECK_OK(libnn_model_create(LIBNN_DOUBLE, layers, 4, LIBNN_BIAS,
+        -1, 1, 1, &model));
+    CHECK_OK(libnn_context_create(model, rows, &ctx));
+    if (error_cnt) return error_cnt;
+
+    const std::vector<double> x = random_inputs<double>(rows, 16);
+    const std::vector<double> t = random_inputs<double>(rows, 4);
+    std::vector<double> y(rows * 4);
+
+    CHECK_OK(libnn_train_f64(ctx, x.data(), t.data(), rows, 0.1, NULL));
+
+    const size_t cnt = alloc_cnt;
+
+    for (size_t i = 0; i < 100; ++i) {
+        CHECK_OK(libnn_eval_f64(ctx, x.data(), 1 + i % rows, y.data()));
+        CHECK_OK(libnn_train_f64(ctx, x.data(), t.data(), 1 + i % rows,
+            0.1, NULL));
+    }
+
+    std::cout << "Allocations: " << alloc_cnt - cnt << std::endl;
+
+    if (alloc_cnt != cnt) {
+        std::cout << "Evaluation or training allocated memory" << std::endl;
+
+        ++error_cnt;
+    }
+
+    libnn_context_destroy(ctx);
+    libnn_model_destroy(model);
+
+    std::cout << "C API allocations test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  Concurrency test
+ *
+ *  Evaluation threads (each with own context) run while another
+ *  context trains the model; the contexts shall see the new weights.
+ *
+ *  \param  threads  Evaluation thread count
+ *
+ *  \return Count of errors
+ */
+static int test_concurrency(size_t threads) {
+    std::cout << "C API concurrency test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    const size_t layers[] = { 8, 16, 2 };
+    const size_t rows     = 32;
+
+    libnn_model * model = NULL;
+    CHECK_OK(libnn_model_create(LIBNN_DOUBLE, layers, 3, LIBNN_BIAS,
+        -1, 1, 1, &model));
+    if (error_cnt) return error_cnt;
+
+    const std::vector<double> x = random_inputs<double>(rows, 8);
+    const std::vector<double> t = random_inputs<double>(rows, 2);
+
+    std::vector<libnn_context *> ctxs(threads + 1);
+    for (size_t i = 0; i < ctxs.size(); ++i)
+        CHECK_OK(libnn_context_create(model, rows, &ctxs[i]));
+
+    std::atomic<size_t> failures(0);
+    std::atomic<bool>   stop(false);
+
+    std::vector<std::thread> evaluators;
+    for (size_t i = 0; i < threads; ++i)
+        evaluators.emplace_back([&, i]() {
+            std::vector<double> y(rows * 2);
+
+            while (!stop)
+                if (LIBNN_OK != libnn_eval_f64(ctxs[i], x.data(), rows,
+                    y.data())) ++failures;
+        });
+
+    for (size_t i = 0; i < 200; ++i)
+        CHECK_OK(libnn_train_f64(ctxs[threads], x.data(), t.data(), rows,
+            0.5, NULL));
+
+    stop = true;
+    for (size_t i = 0; i < threads; ++i) evaluators[i].join();
+
+    if (failures) {
+        std::cout << failures << " evaluations failed" << std::endl;
+
+        ++error_cnt;
+    }
+
+    // All contexts shall provide the same outputs (of the trained model)
+    std::vector<double> y0(rows * 2), y(rows * 2);
+    CHECK_OK(libnn_eval_f64(ctxs[threads], x.data(), rows, y0.data()));
+
+    for (size_t i = 0; i < threads; ++i) {
+        CHECK_OK(libnn_eval_f64(ctxs[i], x.data(), rows, y.data()));
+
+        if (y != y0) {
+            std::cout << "Context " << i << " uses stale weights" << std::endl;
+
+            ++error_cnt;
+        }
+    }
+
+    for (size_t i = 0; i < ctxs.size(); ++i) libnn_context_destroy(ctxs[i]);
+    libnn_model_destroy(model);
+
+    std::cout << "C API concurrency test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  Create model and evaluate it
+ *
+ *  \param  seed  Weight generator seed
+ *  \param  x     Inputs
+ *  \param  rows  Row count
+ *  \param  y     Outputs
+ *
+ *  \return Status
+ */
+static libnn_status create_eval(
+    unsigned                    seed,
+    const std::vector<double> & x,
+    size_t                      rows,
+    std::vector<double>       & y)
+{
+    const size_t layers[] = { 6, 12, 3 };
+
+    libnn_model * model = NULL;
+    libnn_status status = libnn_model_create(LIBNN_DOUBLE, layers, 3,
+        LIBNN_BIAS, -1, 1, seed, &model);
+    if (LIBNN_OK != status) return status;
+
+    libnn_context * ctx = NULL;
+    status = libnn_context_create(model, rows, &ctx);
+    if (LIBNN_OK == status) {
+        status = libnn_eval_f64(ctx, x.data(), rows, y.data());
+        libnn_context_destroy(ctx);
+    }
+
+    libnn_model_destroy(model);
+
+    return status;
+}
+
+
+/**
+ *  \brief  Seed test
+ *
+ *  Models created (concurrently) with the same seed shall be the same,
+ *  independently of the global random generator state.
+ *
+ *  \param  threads  Creator thread count
+ *
+ *  \return Count of errors
+ */
+static int test_seed(size_t threads) {
+    std::cout << "C API seed test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    const size_t rows = 16;
+    const std::vector<double> x = random_inputs<double>(rows, 6);
+
+    std::vector<double> y_ref(rows * 3);
+    CHECK_OK(create_eval(7, x, rows, y_ref));
+    if (error_cnt) return error_cnt;
+
+    ::srand(123);  // shall not matter
+
+    std::vector<std::vector<double> > y(threads,
+        std::vector<double>(rows * 3));
+    std::atomic<size_t> failures(0);
+
+    std::vector<std::thread> creators;
+    for (size_t i = 0; i < threads; ++i)
+        creators.emplace_back([&, i]() {
+            if (LIBNN_OK != create_eval(i % 2 ? 8 : 7, x, rows, y[i]))
+                ++failures;
+        });
+
+    for (size_t i = 0; i < threads; ++i) creators[i].join();
+
+    if (failures) {
+        std::cout << failures << " creations failed" << std::endl;
+
+        ++error_cnt;
+    }
+
+    for (size_t i = 0; i < threads; ++i) {
+        if ((y[i] == y_ref) == (i % 2)) {
+            std::cout << "Model " << i << " weights mismatch" << std::endl;
+
+            ++error_cnt;
+        }
+    }
+
+    std::cout << "C API seed test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  Errors test
+ *
+ *  \return Count of errors
+ */
+static int test_errors() {
+    std::cout << "C API errors test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    libnn_model * model = NULL;
+
+    if (LIBNN_EIO != libnn_model_load("/nonexistent/model", LIBNN_TEXT,
+        LIBNN_DOUBLE, &model))
+    {
+        std::cout << "Missing file not reported" << std::endl;
+
+        ++error_cnt;
+    }
+
+    const char garbage[] = "FFNN\nfoo\n";
+    if (LIBNN_EFORMAT != libnn_model_load_mem(garbage, sizeof(garbage) - 1,
+        LIBNN_TEXT, LIBNN_DOUBLE, &model))
+    {
+        std::cout << "Malformed model not reported" << std::endl;
+
+        ++error_cnt;
+    }
+
+    std::cout << "Last error: " << libnn_last_error() << std::endl;
+
+    const size_t layers[] = { 2 };
+    if (LIBNN_EINVAL != libnn_model_create(LIBNN_DOUBLE, layers, 1, 0,
+        -1, 1, 1, &model))
+    {
+        std::cout << "Invalid layers not reported" << std::endl;
+
+        ++error_cnt;
+    }
+
+    if (LIBNN_ABI_VERSION != libnn_abi_version()) {
+        std::cout << "ABI version mismatch" << std::endl;
+
+        ++error_cnt;
+    }
+
+    std::cout << "C API errors test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/** Unit test */
+static int main_impl(int argc, char * const argv[]) {
+    int exit_code = 64;  // pessimistic assumption
+
+    do {  // pragmatic do ... while (0) loop allowing for breaks
+        exit_code = test_load_save(LIBNN_TEXT, 1e-4);
+        if (0 != exit_code) break;
+
+        exit_code = test_load_save(LIBNN_BINARY, 0);
+        if (0 != exit_code) break;
+
+        exit_code = test_train();
+        if (0 != exit_code) break;
+
+        exit_code = test_allocations();
+        if (0 != exit_code) break;
+
+        exit_code = test_concurrency(4);
+        if (0 != exit_code) break;
+
+        exit_code = test_seed(8);
+        if (0 != exit_code) break;
+
+        exit_code = test_errors();
+        if (0 != exit_code) break;
+
+    } while (0);  // end of pragmatic loop
+
+    std::cerr
+        << "Exit code: " << exit_code
+        << std::endl;
+
+    return exit_code;
+}
+
+/** Unit test exception-safe wrapper */
+int main(int argc, char * const argv[]) {
+    int exit_code = 128;
+
+    try {
+        exit_code = main_impl(argc, argv);
+    }
+    catch (const std::exception & x) {
+        std::cerr
+            << "Standard exception caught: "
+            << x.what()
+            << std::endl;
+    }
+    catch (...) {
+        std::cerr
+            << "Unhandled non-standard exception caught"
+            << std::endl;
+    }
+
+    return exit_code;
+}
@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# C API tests (load & save, training, allocations, concurrency)
+./capi
@@ -41,8 +41,11 @@
 #include "config.hxx"
 
 #include <libnn/topo/nn.hxx>
+#include <libnn/model/feed_forward.hxx>
 #include <libnn/io/nn.hxx>
+#include <libnn/io/feed_forward.hxx>
 
+#include <string>
 #include <iostream>
 #include <exception>
 #include <stdexcept>
@@ -61,6 +64,9 @@ class dummy_f {
 /** Simple linear neural network model */
 typedef libnn::topo::nn<double, dummy_f<double> > nn_t;
 
+/** Simple linear feed-forward neural network model */
+typedef libnn::model::feed_forward<double, dummy_f<double> > ffnn_t;
+
 
 /** Dummy activation functor serialisation */
 template <typename Base_t>
@@ -86,13 +92,26 @@ std::istream & operator >> (
 }
 
 
-/** Unit test */
+/**
+ *  \brief  Unit test
+ *
+ *  Reads network from standard input and writes it to standard output.
+ *  A feed-forward network is expected if the 1st argument is "ffnn",
+ *  neural network topology otherwise.
+ */
 static int main_impl(int argc, char * const argv[]) {
     int exit_code = 64;  // pessimistic assumption
 
-    nn_t nn;
-    std::cin >> nn;
-    std::cout << nn;
+    if (1 < argc && std::string("ffnn") == argv[1]) {
+        ffnn_t nn;
+        std::cin >> nn;
+        std::cout << nn;
+    }
+    else {
+        nn_t nn;
+        std::cin >> nn;
+        std::cout << nn;
+    }
 
     exit_code = 0;  // OK
 
@@ -48,6 +48,135 @@ nn_out='NNTopology
     Synapsis 2 -> 3 weight = 0.7891
 NNTopologyEnd'
 
+# Shared weights
+nn_shared_in='
+NNTopology
+    Neuron 0
+        type = INPUT
+        f    = 2x
+    NeuronEnd
+    Neuron 1
+        type = INPUT
+        f    = 2x
+    NeuronEnd
+    Neuron 2
+        type = OUTPUT
+        f    = 2x
+    NeuronEnd
+    Neuron 3
+        type = OUTPUT
+        f    = 2x
+    NeuronEnd
+
+    SharedWeight 0 = 0.5
+    SharedWeight 1=-0.25
+
+    Synapsis 0 -> 2 shared 0
+    Synapsis 1 -> 2 shared 1
+    Synapsis 0 -> 3 weight = 0.75
+    Synapsis 1 -> 3 shared   0
+NNTopologyEnd'
+
+nn_shared_out='NNTopology
+    Neuron 0
+        type = INPUT
+        f    = 2x
+    NeuronEnd
+    Neuron 1
+        type = INPUT
+        f    = 2x
+    NeuronEnd
+    Neuron 2
+        type = OUTPUT
+        f    = 2x
+    NeuronEnd
+    Neuron 3
+        type = OUTPUT
+        f    = 2x
+    NeuronEnd
+    SharedWeight 0 = 0.5
+    SharedWeight 1 = -0.25
+    Synapsis 0 -> 2 shared 0
+    Synapsis 1 -> 2 shared 1
+    Synapsis 0 -> 3 weight = 0.75
+    Synapsis 1 -> 3 shared 0
+NNTopologyEnd'
+
+# Feed-forward network (hexadecimal features: bias & lateral synapses)
+ffnn_in='
+FFNN
+    features = 0x3
+    NNTopology
+        Neuron 0
+            type = INNER
+            f    = 2x
+        NeuronEnd
+        Neuron 1
+            type = INPUT
+            f    = 2x
+        NeuronEnd
+        Neuron 2
+            type = INPUT
+            f    = 2x
+        NeuronEnd
+        Neuron 3
+            type = OUTPUT
+            f    = 2x
+        NeuronEnd
+        Neuron 4
+            type = OUTPUT
+            f    = 2x
+        NeuronEnd
+
+        Synapsis 0 -> 3 weight = 0.125
+        Synapsis 1 -> 3 weight = 0.25
+        Synapsis 2 -> 3 weight = 0.375
+        Synapsis 0 -> 4 weight = 0.5
+        Synapsis 3 -> 4 weight = 0.625
+        Synapsis 1 -> 4 weight = 0.75
+        Synapsis 2 -> 4 weight = 0.875
+    NNTopologyEnd
+    Bias 0
+    Layer 0 = [1, 3)
+    Layer 1 = [3, 5)
+FFNNEnd'
+
+ffnn_out='FFNN
+    features = 0x3
+    NNTopology
+        Neuron 0
+            type = INNER
+            f    = 2x
+        NeuronEnd
+        Neuron 1
+            type = INPUT
+            f    = 2x
+        NeuronEnd
+        Neuron 2
+            type = INPUT
+            f    = 2x
+        NeuronEnd
+        Neuron 3
+            type = OUTPUT
+            f    = 2x
+        NeuronEnd
+        Neuron 4
+            type = OUTPUT
+            f    = 2x
+        NeuronEnd
+        Synapsis 0 -> 3 weight = 0.125
+        Synapsis 1 -> 3 weight = 0.25
+        Synapsis 2 -> 3 weight = 0.375
+        Synapsis 0 -> 4 weight = 0.5
+        Synapsis 3 -> 4 weight = 0.625
+        Synapsis 1 -> 4 weight = 0.75
+        Synapsis 2 -> 4 weight = 0.875
+    NNTopologyEnd
+    Bias 0
+    Layer 0 = [1, 3)
+    Layer 1 = [3, 5)
+FFNNEnd'
+
 
 prefix=serialisation.$$
 
@@ -57,4 +186,16 @@ echo "$nn_out" > ${prefix}.exp
 
 diff ${prefix}.* || exit 1
 
+echo "$nn_shared_in" | ./serialisation > ${prefix}.out
+
+echo "$nn_shared_out" > ${prefix}.exp
+
+diff ${prefix}.* || exit 1
+
+echo "$ffnn_in" | ./serialisation ffnn > ${prefix}.out
+
+echo "$ffnn_out" > ${prefix}.exp
+
+diff ${prefix}.* || exit 1
+
 rm ${prefix}.*
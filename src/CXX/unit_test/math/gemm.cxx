@@ -0,0 +1,437 @@
+/**
+ *  Matrix multiplication kernels unit test and benchmark
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "config.hxx"
+
+#include <libnn/math/gemm.hxx>
+#include <libnn/math/blas.hxx>
+
+#include <vector>
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+
+
+using libnn::math::transpose_t;
+using libnn::math::NO_TRANS;
+using libnn::math::TRANS;
+
+
+/**
+ *  \brief  Naive matrix multiplication (reference)
+ *
+ *  See \c libnn::math::gemm for parameters.
+ */
+template <typename Base_t>
+static void naive_gemm(
+    transpose_t    trans_a,
+    transpose_t    trans_b,
+    size_t         m,
+    size_t         n,
+    size_t         k,
+    Base_t         alpha,
+    const Base_t * a,
+    size_t         lda,
+    const Base_t * b,
+    size_t         ldb,
+    Base_t         beta,
+    Base_t       * c,
+    size_t         ldc)
+{
+    for (size_t i = 0; i < m; ++i)
+        for (size_t j = 0; j < n; ++j) {
+            Base_t sum = 0;
+            for (size_t p = 0; p < k; ++p)
+                sum += libnn::math::impl::at(a, lda, trans_a, i, p)
+                    *  libnn::math::impl::at(b, ldb, trans_b, p, j);
+
+            c[i * ldc + j] = alpha * sum + (0 == beta ? 0 : beta * c[i * ldc + j]);
+        }
+}
+
+
+/**
+ *  \brief  Random matrix
+ *
+ *  \param  size  Element count
+ *
+ *  \return Elements in [-1, 1]
+ */
+template <typename Base_t>
+static std::vector<Base_t> random_matrix(size_t size) {
+    std::vector<Base_t> m;
+    m.reserve(size);
+
+    for (size_t i = 0; i < size; ++i)
+        m.push_back(Base_t(2.0 * ::rand() / RAND_MAX - 1.0));
+
+    return m;
+}
+
+
+/**
+ *  \brief  GEMM test (for one shape)
+ *
+ *  \param  type     Type name
+ *  \param  threads  Thread count (1 means \c gemm, 0 means \c blas::gemm,
+ *                   otherwise \c gemm_threaded is tested)
+ *  \param  trans_a  A transposition
+ *  \param  trans_b  B transposition
+ *  \param  m        Rows of C
+ *  \param  n        Columns of C
+ *  \param  k        Inner dimension
+ *  \param  alpha    op(A) op(B) factor
+ *  \param  beta     C factor
+ *  \param  eps      Acceptable relative error
+ *
+ *  \return Count of errors
+ */
+template <typename Base_t>
+static int test_gemm_shape(
+    const char * type,
+    size_t       threads,
+    transpose_t  trans_a,
+    transpose_t  trans_b,
+    size_t       m,
+    size_t       n,
+    size_t       k,
+    Base_t       alpha,
+    Base_t       beta,
+    double       eps)
+{
+    // Leading dimensions are padded
+    const size_t lda = (NO_TRANS == trans_a ? k : m) + 3;
+    const size_t ldb = (NO_TRANS == trans_b ? n : k) + 1;
+    const size_t ldc = n + 2;
+
+    const auto a = random_matrix<Base_t>((NO_TRANS == trans_a ? m : k) * lda);
+    const auto b = random_matrix<Base_t>((NO_TRANS == trans_b ? k : n) * ldb);
+
+    auto c     = random_matrix<Base_t>(m * ldc);
+    auto c_exp = c;
+
+    naive_gemm(trans_a, trans_b, m, n, k,
+        alpha, a.data(), lda, b.data(), ldb, beta, c_exp.data(), ldc);
+
+    if (0 == threads)
+        libnn::math::blas::gemm(trans_a, trans_b, m, n, k,
+            alpha, a.data(), lda, b.data(), ldb, beta, c.data(), ldc);
+    else if (1 == threads)
+        libnn::math::gemm(trans_a, trans_b, m, n, k,
+            alpha, a.data(), lda, b.data(), ldb, beta, c.data(), ldc);
+    else
+        libnn::math::gemm_threaded(threads, trans_a, trans_b, m, n, k,
+            alpha, a.data(), lda, b.data(), ldb, beta, c.data(), ldc);
+
+    double diff = 0;
+    for (size_t i = 0; i < m; ++i)
+        for (size_t j = 0; j < n; ++j)
+            diff = std::max(diff, (double)std::abs(
+                c[i * ldc + j] - c_exp[i * ldc + j]));
+
+    // Padding must not be touched
+    for (size_t i = 0; i < m; ++i)
+        for (size_t j = n; j < ldc; ++j)
+            if (c[i * ldc + j] != c_exp[i * ldc + j]) diff = HUGE_VAL;
+
+    if (!(diff <= eps * (k + 1))) {
+        std::cout
+            << type << " GEMM mismatch: threads " << threads
+            << ", " << (TRANS == trans_a ? "A^T" : "A")
+            << (TRANS == trans_b ? " B^T" : " B")
+            << ", " << m << 'x' << n << 'x' << k
+            << ", alpha " << alpha << ", beta " << beta
+            << ": max. difference " << diff << std::endl;
+
+        return 1;
+    }
+
+    return 0;
+}
+
+
+/**
+ *  \brief  GEMM test
+ *
+ *  \param  type  Type name
+ *  \param  eps   Acceptable relative error
+ *
+ *  \return Count of errors
+ */
+template <typename Base_t>
+static int test_gemm(const char * type, double eps) {
+    std::cout << type << " GEMM test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    const size_t shapes[][3] = {
+        {   1,   1,   1 },
+        {   7,   5,   3 },
+        {   1,  37,  29 },  // GEMV (row)
+        {  41,   1,  29 },  // GEMV (column)
+        {  30,  20,   1 },  // rank 1 update
+        {  65,  33, 257 },  // edge tiles & blocks
+        { 130, 150, 300 },
+    };
+
+    const transpose_t trans[] = { NO_TRANS, TRANS };
+
+    for (size_t s = 0; s < sizeof(shapes) / sizeof(shapes[0]); ++s)
+    for (size_t ta = 0; ta < 2; ++ta)
+    for (size_t tb = 0; tb < 2; ++tb) {
+        const size_t m = shapes[s][0], n = shapes[s][1], k = shapes[s][2];
+
+        error_cnt += test_gemm_shape<Base_t>(type, 1, trans[ta], trans[tb],
+            m, n, k, 1, 0, eps);
+
+        error_cnt += test_gemm_shape<Base_t>(type, 1, trans[ta], trans[tb],
+            m, n, k, -0.5, 2, eps);
+
+        error_cnt += test_gemm_shape<Base_t>(type, 3, trans[ta], trans[tb],
+            m, n, k, 1.5, 1, eps);
+
+        error_cnt += test_gemm_shape<Base_t>(type, 0, trans[ta], trans[tb],
+            m, n, k, -1, 0.5, eps);
+    }
+
+    std::cout << type << " GEMM test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  GEMV test
+ *
+ *  \param  type  Type name
+ *  \param  eps   Acceptable relative error
+ *
+ *  \return Count of errors
+ */
+template <typename Base_t>
+static int test_gemv(const char * type, double eps) {
+    std::cout << type << " GEMV test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    const size_t m = 23, n = 17, lda = n + 1, incx = 2, incy = 3;
+
+    const auto a = random_matrix<Base_t>(m * lda);
+    const auto x = random_matrix<Base_t>(std::max(m, n) * incx);
+
+    const transpose_t trans[] = { NO_TRANS, TRANS };
+
+    for (size_t t = 0; t < 4; ++t) {
+        const transpose_t tr = trans[t % 2];
+        const bool blas = 2 <= t;  // blas::gemv
+
+        const size_t x_size = NO_TRANS == tr ? n : m;
+        const size_t y_size = NO_TRANS == tr ? m : n;
+
+        auto y = random_matrix<Base_t>(y_size * incy);
+
+        std::vector<Base_t> y_exp(y);
+        for (size_t i = 0; i < y_size; ++i) {
+            Base_t sum = 0;
+            for (size_t j = 0; j < x_size; ++j)
+                sum += libnn::math::impl::at(a.data(), lda, tr, i, j)
+                    * x[j * incx];
+
+            y_exp[i * incy] = 2 * sum - 0.5 * y[i * incy];
+        }
+
+        if (blas)
+            libnn::math::blas::gemv<Base_t>(tr, m, n,
+                2, a.data(), lda, x.data(), incx, -0.5, y.data(), incy);
+        else
+            libnn::math::gemv<Base_t>(tr, m, n,
+                2, a.data(), lda, x.data(), incx, -0.5, y.data(), incy);
+
+        double diff = 0;
+        for (size_t i = 0; i < y.size(); ++i)
+            diff = std::max(diff, (double)std::abs(y[i] - y_exp[i]));
+
+        if (!(diff <= eps * (x_size + 1))) {
+            std::cout
+                << type << (blas ? " BLAS" : "") << " GEMV mismatch ("
+                << (TRANS == tr ? "A^T" : "A")
+                << "): max. difference " << diff << std::endl;
+
+            ++error_cnt;
+        }
+    }
+
+    std::cout << type << " GEMV test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  GEMM benchmark
+ *
+ *  Reports GFLOP/s of the naive loop, \c gemm and \c gemm_threaded
+ *  (with hardware concurrency) for N x N matrices.
+ *  The external BLAS is also measured if selected.
+ *
+ *  \param  type  Type name
+ *  \param  n     Matrix size
+ */
+template <typename Base_t>
+static void bench_gemm(const char * type, size_t n) {
+    typedef std::chrono::steady_clock clock_t;
+
+    const auto a = random_matrix<Base_t>(n * n);
+    const auto b = random_matrix<Base_t>(n * n);
+
+    std::vector<Base_t> c(n * n);
+
+    const double flop = 2.0 * n * n * n;
+
+    const int impl_cnt =
+        libnn::math::blas::CBLAS == libnn::math::blas::backend() ? 4 : 3;
+
+    const char * names[] = { "naive", "gemm", "gemm_threaded", "cblas" };
+    for (int impl = 0; impl < impl_cnt; ++impl) {
+        size_t reps = 0;
+
+        const auto t0 = clock_t::now();
+        auto t1 = t0;
+
+        do {
+            switch (impl) {
+                case 0:
+                    naive_gemm<Base_t>(NO_TRANS, NO_TRANS, n, n, n,
+                        1, a.data(), n, b.data(), n, 0, c.data(), n);
+                    break;
+
+                case 1:
+                    libnn::math::gemm<Base_t>(NO_TRANS, NO_TRANS, n, n, n,
+                        1, a.data(), n, b.data(), n, 0, c.data(), n);
+                    break;
+
+                case 2:
+                    libnn::math::gemm_threaded<Base_t>(0, NO_TRANS, NO_TRANS,
+                        n, n, n, 1, a.data(), n, b.data(), n, 0, c.data(), n);
+                    break;
+
+                case 3:
+                    libnn::math::blas::gemm<Base_t>(NO_TRANS, NO_TRANS, n, n, n,
+                        1, a.data(), n, b.data(), n, 0, c.data(), n);
+                    break;
+            }
+
+            ++reps;
+            t1 = clock_t::now();
+        } while (std::chrono::duration<double>(t1 - t0).count() < 0.2);
+
+        const double s = std::chrono::duration<double>(t1 - t0).count();
+
+        std::cout
+            << type << ' ' << n << 'x' << n << 'x' << n << ' '
+            << names[impl] << ": " << flop * reps / s * 1e-9 << " GFLOP/s"
+            << std::endl;
+    }
+}
+
+
+/** Unit test */
+static int main_impl(int argc, char * const argv[]) {
+    int exit_code = 64;  // pessimistic assumption
+
+    size_t bench_n = 256;  // benchmark matrix size (0 means no benchmark)
+    if (1 < argc) bench_n = ::atoi(argv[1]);
+
+    std::cout
+        << "BLAS backend: "
+        << libnn::math::blas::name(libnn::math::blas::backend())
+        << std::endl;
+
+    do {  // pragmatic do ... while (0) loop allowing for breaks
+        exit_code = test_gemm<double>("double", 1e-14);
+        if (0 != exit_code) break;
+
+        exit_code = test_gemm<float>("float", 1e-6);
+        if (0 != exit_code) break;
+
+        exit_code = test_gemv<double>("double", 1e-14);
+        if (0 != exit_code) break;
+
+        exit_code = test_gemv<float>("float", 1e-6);
+        if (0 != exit_code) break;
+
+        if (bench_n) {
+            bench_gemm<double>("double", bench_n);
+            bench_gemm<float>("float", bench_n);
+        }
+
+    } while (0);  // end of pragmatic loop
+
+    std::cerr
+        << "Exit code: " << exit_code
+        << std::endl;
+
+    return exit_code;
+}
+
+/** Unit test exception-safe wrapper */
+int main(int argc, char * const argv[]) {
+    int exit_code = 128;
+
+    try {
+        exit_code = main_impl(argc, argv);
+    }
+    catch (const std::exception & x) {
+        std::cerr
+            << "Standard exception caught: "
+            << x.what()
+            << std::endl;
+    }
+    catch (...) {
+        std::cerr
+            << "Unhandled non-standard exception caught"
+            << std::endl;
+    }
+
+    return exit_code;
+}
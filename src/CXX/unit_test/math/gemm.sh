@@ -0,0 +1,6 @@
+#!/bin/sh
+
+# Correctness tests and 256x256 GEMM benchmark (GFLOP/s)
+# with both BLAS backends (the external one if configured)
+LIBNN_BLAS=internal ./gemm 256 || exit $?
+./gemm 256
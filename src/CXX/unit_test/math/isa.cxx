@@ -0,0 +1,299 @@
+/**
+ *  Instruction set specific kernels unit test
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "config.hxx"
+
+#include <libnn/math/gemm.hxx>
+#include <libnn/math/cpu.hxx>
+
+#include <vector>
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+#include <cstring>
+#include <cmath>
+#include <cstdlib>
+
+
+using libnn::math::NO_TRANS;
+using libnn::math::TRANS;
+
+namespace cpu = libnn::math::cpu;
+
+
+/**
+ *  \brief  Random vector
+ *
+ *  \param  size  Vector size
+ *
+ *  \return Vector (values in [-1, 1])
+ */
+template <typename Base_t>
+static std::vector<Base_t> random_vector(size_t size) {
+    std::vector<Base_t> v(size);
+    for (size_t i = 0; i < size; ++i)
+        v[i] = (Base_t)(2.0 * ::rand() / RAND_MAX - 1.0);
+
+    return v;
+}
+
+
+/**
+ *  \brief  Maximal absolute difference
+ *
+ *  \param  x  Vector
+ *  \param  y  Vector
+ *
+ *  \return max |x_i - y_i|
+ */
+template <typename Base_t>
+static double max_diff(
+    const std::vector<Base_t> & x,
+    const std::vector<Base_t> & y)
+{
+    double diff = 0;
+    for (size_t i = 0; i < x.size(); ++i)
+        diff = std::max(diff, (double)std::abs(x[i] - y[i]));
+
+    return diff;
+}
+
+
+/**
+ *  \brief  Kernels results (using the selected instruction set)
+ *
+ *  \param  x  Input vector
+ *  \param  y  Input vector
+ *  \param  a  Input matrix data
+ *  \param  b  Input matrix data
+ *
+ *  \return Dot products, axpy, GEMV and GEMM (small and packed) results
+ */
+template <typename Base_t>
+static std::vector<Base_t> results(
+    const std::vector<Base_t> & x,
+    const std::vector<Base_t> & y,
+    const std::vector<Base_t> & a,
+    const std::vector<Base_t> & b)
+{
+    std::vector<Base_t> res;
+
+    // Dot products (all sizes up to the vector size)
+    for (size_t n = 0; n <= x.size(); ++n)
+        res.push_back(libnn::math::dot(x.data(), y.data(), n));
+
+    // axpy
+    std::vector<Base_t> z(y);
+    libnn::math::axpy(Base_t(0.5), x.data(), z.data(), z.size());
+    res.insert(res.end(), z.begin(), z.end());
+
+    // GEMV (both transpositions)
+    std::vector<Base_t> v(64);
+    libnn::math::gemv(NO_TRANS, 64, 64, Base_t(1), a.data(), 64,
+        x.data(), 1, Base_t(0), v.data(), 1);
+    res.insert(res.end(), v.begin(), v.end());
+
+    libnn::math::gemv(TRANS, 64, 64, Base_t(1), a.data(), 64,
+        x.data(), 1, Base_t(0), v.data(), 1);
+    res.insert(res.end(), v.begin(), v.end());
+
+    // GEMM (small, packed with edge tiles, transposed)
+    static const size_t dims[][3] = {
+        { 7, 5, 9 }, { 61, 63, 64 }, { 64, 64, 64 }, { 33, 17, 40 } };
+
+    for (size_t d = 0; d < sizeof(dims) / sizeof(dims[0]); ++d) {
+        const size_t m = dims[d][0], n = dims[d][1], k = dims[d][2];
+
+        std::vector<Base_t> c(m * n);
+        libnn::math::gemm(NO_TRANS, TRANS, m, n, k,
+            Base_t(1), a.data(), 64, b.data(), 64,
+            Base_t(0), c.data(), n);
+        res.insert(res.end(), c.begin(), c.end());
+
+        libnn::math::gemm(TRANS, NO_TRANS, m, n, k,
+            Base_t(1), a.data(), 64, b.data(), 64,
+            Base_t(0), c.data(), n);
+        res.insert(res.end(), c.begin(), c.end());
+    }
+
+    return res;
+}
+
+
+/**
+ *  \brief  Instruction set kernels test
+ *
+ *  Kernels of all available instruction sets shall compute the same
+ *  results (up to rounding) as the generic ones.
+ *
+ *  \param  tolerance  Max. difference
+ *
+ *  \return Count of errors
+ */
+template <typename Base_t>
+static int test_kernels(double tolerance) {
+    std::cout
+        << "Instruction set kernels test (" << sizeof(Base_t)
+        << " B base) BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    const std::vector<Base_t> x = random_vector<Base_t>(67);
+    const std::vector<Base_t> y = random_vector<Base_t>(67);
+    const std::vector<Base_t> a = random_vector<Base_t>(64 * 64);
+    const std::vector<Base_t> b = random_vector<Base_t>(64 * 64);
+
+    const cpu::isa_t orig = cpu::isa();
+
+    cpu::isa(cpu::GENERIC);
+    const std::vector<Base_t> expected = results(x, y, a, b);
+
+    for (size_t i = 1; i < cpu::isa_cnt; ++i) {
+        const cpu::isa_t isa = (cpu::isa_t)i;
+
+        if (!cpu::available(isa)) {
+            std::cout << cpu::name(isa) << ": not available" << std::endl;
+            continue;
+        }
+
+        cpu::isa(isa);
+        const double diff = max_diff(expected, results(x, y, a, b));
+
+        std::cout
+            << cpu::name(isa) << ": max. difference " << diff << std::endl;
+
+        if (diff > tolerance) {
+            std::cout << "Results differ" << std::endl;
+
+            ++error_cnt;
+        }
+    }
+
+    cpu::isa(orig);
+
+    std::cout << "Instruction set kernels test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  Instruction set selection test
+ *
+ *  \param  expected  Expected selected instruction set name (or \c NULL)
+ *
+ *  \return Count of errors
+ */
+static int test_selection(const char * expected) {
+    std::cout << "Instruction set selection test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    std::cout << "Selected: " << cpu::name(cpu::isa()) << std::endl;
+
+    if (NULL != expected && 0 != std::strcmp(expected, cpu::name(cpu::isa()))) {
+        std::cout << "Expected " << expected << std::endl;
+
+        ++error_cnt;
+    }
+
+    // The best available set is selected by default
+    if (NULL == expected)
+        for (size_t i = cpu::isa_cnt - 1; i > cpu::isa(); --i)
+            if (cpu::available((cpu::isa_t)i)) {
+                std::cout
+                    << cpu::name((cpu::isa_t)i) << " is available"
+                    << std::endl;
+
+                ++error_cnt;
+            }
+
+    std::cout << "Instruction set selection test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/** Unit test */
+static int main_impl(int argc, char * const argv[]) {
+    int exit_code = 64;  // pessimistic assumption
+
+    const char * expected = 1 < argc ? argv[1] : NULL;
+
+    do {  // pragmatic do ... while (0) loop allowing for breaks
+        exit_code = test_selection(expected);
+        if (0 != exit_code) break;
+
+        exit_code = test_kernels<double>(1e-12);
+        if (0 != exit_code) break;
+
+        exit_code = test_kernels<float>(1e-4);
+        if (0 != exit_code) break;
+
+    } while (0);  // end of pragmatic loop
+
+    std::cerr
+        << "Exit code: " << exit_code
+        << std::endl;
+
+    return exit_code;
+}
+
+/** Unit test exception-safe wrapper */
+int main(int argc, char * const argv[]) {
+    int exit_code = 128;
+
+    try {
+        exit_code = main_impl(argc, argv);
+    }
+    catch (const std::exception & x) {
+        std::cerr
+            << "Standard exception caught: "
+            << x.what()
+            << std::endl;
+    }
+    catch (...) {
+        std::cerr
+            << "Unhandled non-standard exception caught"
+            << std::endl;
+    }
+
+    return exit_code;
+}
@@ -0,0 +1,7 @@
+#!/bin/sh
+
+# Kernels of all available instruction sets
+./isa || exit $?
+
+# Instruction set forced by LIBNN_ISA
+LIBNN_ISA=generic ./isa generic
@@ -0,0 +1,375 @@
+/**
+ *  Memory resources unit test
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "config.hxx"
+
+#include "../ml/linear.hxx"
+
+#include <libnn/misc/memory_resource.hxx>
+#include <libnn/topo/nn.hxx>
+#include <libnn/io/binary.hxx>
+#include <libnn/ml/nn_func.hxx>
+#include <libnn/ml/backpropagation.hxx>
+
+#include <vector>
+#include <sstream>
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+#include <cstdint>
+#include <cstring>
+#include <cstdlib>
+#include <cmath>
+
+
+/** Counting memory resource (allocations go to the default resource) */
+class counting_resource: public libnn::misc::memory_resource {
+    private:
+
+    size_t m_live;  /**< Live memory (bytes) */
+    size_t m_cnt;   /**< Allocation count    */
+
+    protected:
+
+    void * do_allocate(size_t bytes, size_t align) {
+        m_live += bytes;
+        ++m_cnt;
+
+        return libnn::misc::new_delete_resource()->allocate(bytes, align);
+    }
+
+    void do_deallocate(void * ptr, size_t bytes, size_t align) {
+        m_live -= bytes;
+
+        libnn::misc::new_delete_resource()->deallocate(ptr, bytes, align);
+    }
+
+    public:
+
+    /** Constructor */
+    counting_resource(): m_live(0), m_cnt(0) {}
+
+    /** Live memory getter */
+    size_t live() const { return m_live; }
+
+    /** Allocation count getter */
+    size_t cnt() const { return m_cnt; }
+
+};  // end of class counting_resource
+
+
+/**
+ *  \brief  Monotonic resource test
+ *
+ *  \return Count of errors
+ */
+static int test_monotonic() {
+    std::cout << "Monotonic resource test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    counting_resource upstream;
+    alignas(16) char buffer[256];
+
+    {
+        libnn::misc::monotonic_resource arena(buffer, sizeof(buffer),
+            &upstream);
+
+        for (int round = 0; round < 2; ++round) {
+            std::vector<char *> blocks;
+            for (size_t i = 1; i <= 100; ++i) {
+                const size_t align = 1 << (i % 5);
+
+                char * block = (char *)arena.allocate(i, align);
+                if ((uintptr_t)block % align) {
+                    std::cout << "Block misaligned" << std::endl;
+
+                    ++error_cnt;
+                }
+
+                std::memset(block, (int)i, i);
+                blocks.push_back(block);
+            }
+
+            for (size_t i = 1; i <= 100; ++i) {
+                const char * block = blocks[i - 1];
+                for (size_t j = 0; j < i; ++j)
+                    if ((char)i != block[j]) {
+                        std::cout << "Blocks overlap" << std::endl;
+
+                        ++error_cnt;
+                        break;
+                    }
+            }
+
+            if (100 * 101 / 2 != arena.used()) {
+                std::cout
+                    << "Unexpected used memory: " << arena.used()
+                    << std::endl;
+
+                ++error_cnt;
+            }
+
+            if (buffer != blocks.front()) {
+                std::cout << "Initial buffer not used" << std::endl;
+
+                ++error_cnt;
+            }
+
+            std::cout
+                << "Round " << round + 1 << ": upstream chunks: "
+                << upstream.cnt() << ", upstream memory: "
+                << upstream.live() << " B" << std::endl;
+
+            arena.release();
+
+            if (upstream.live()) {
+                std::cout << "Upstream memory not released" << std::endl;
+
+                ++error_cnt;
+            }
+        }
+    }
+
+    std::cout << "Monotonic resource test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  Huge pages resource test
+ *
+ *  \return Count of errors
+ */
+static int test_huge_page() {
+    std::cout << "Huge pages resource test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    libnn::misc::huge_page_resource huge_pages;
+    libnn::misc::monotonic_resource arena(1 << 20, &huge_pages);
+
+    {
+        const libnn::misc::polymorphic_allocator<double> alloc(&arena);
+        std::vector<double, libnn::misc::polymorphic_allocator<double> >
+            values(alloc);
+
+        for (size_t i = 0; i < 500000; ++i) values.push_back(i);
+
+        for (size_t i = 0; i < values.size(); ++i)
+            if (values[i] != i) {
+                std::cout << "Unexpected value" << std::endl;
+
+                ++error_cnt;
+                break;
+            }
+    }
+
+    std::cout << "Huge pages resource test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  Network and computations memory resource test
+ *
+ *  The network is deserialised to a counting resource (so all its
+ *  storage must be allocated there) and trained using a per-call arena.
+ *  The results must be the same as the default resource ones (up to
+ *  rounding errors; the deserialised network synapses order differs).
+ *
+ *  \param  loops  Training loop count
+ *
+ *  \return Count of errors
+ */
+static int test_nn(size_t loops) {
+    std::cout << "Network memory resource test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    const std::vector<size_t> layers({4, 8, 8, 3});
+
+    nn_t nn_dflt;
+    create_deep_nn(nn_dflt, layers, true, 0.05);
+
+    std::stringstream model;
+    libnn::io::serialise_binary(model, nn_dflt);
+
+    counting_resource resource;
+    {
+        nn_t nn(&resource);
+        libnn::io::deserialise_binary(model, nn);
+
+        const size_t usage = nn.memory_usage().total();
+
+        std::cout
+            << "Network memory: " << usage << " B (resource: "
+            << resource.live() << " B)" << std::endl;
+
+        if (usage != resource.live()) {
+            std::cout << "Network not allocated by the resource" << std::endl;
+
+            ++error_cnt;
+        }
+
+        training_set_t set;
+        for (int i = 1; i <= 10; ++i) {
+            const double x = 0.1 * i;
+
+            set.emplace_back(
+                std::vector<double>({x, 2*x, 3*x, 4*x}),
+                std::vector<double>({x + 1, 2*x, 3*x - 1}));
+        }
+
+        auto criterion = [](double err_n2) -> double { return 0.01; };
+
+        backpropagation_t bprop_dflt(nn_dflt);
+
+        for (size_t i = 0; i < loops; ++i) {
+            libnn::misc::monotonic_resource arena(1024, &resource);
+
+            backpropagation_t bprop(nn, &arena);
+            bprop.checkpoint(i % 2);
+            bprop_dflt.checkpoint(i % 2);
+
+            const double en2      = bprop(set, criterion);
+            const double en2_dflt = bprop_dflt(set, criterion);
+
+            if (std::abs(en2 - en2_dflt) > 1e-9 * (1 + en2_dflt)) {
+                std::cout
+                    << "Error norms differ: " << en2 << " != " << en2_dflt
+                    << std::endl;
+
+                ++error_cnt;
+            }
+
+            nn_func_t nn_func(nn, &arena);
+            nn_func_t nn_func_dflt(nn_dflt);
+
+            const std::vector<double> y      = nn_func(set.front().first);
+            const std::vector<double> y_dflt = nn_func_dflt(set.front().first);
+
+            for (size_t j = 0; j < y.size(); ++j)
+                if (std::abs(y[j] - y_dflt[j]) > 1e-9) {
+                    std::cout << "Network functions differ" << std::endl;
+
+                    ++error_cnt;
+                    break;
+                }
+
+            if (!arena.used()) {
+                std::cout << "Arena not used" << std::endl;
+
+                ++error_cnt;
+            }
+        }
+
+        std::cout
+            << "Resource memory: " << resource.live() << " B"
+            << std::endl;
+
+        if (usage != resource.live()) {
+            std::cout << "Arena memory not released" << std::endl;
+
+            ++error_cnt;
+        }
+    }
+
+    if (resource.live()) {
+        std::cout << "Network memory not released" << std::endl;
+
+        ++error_cnt;
+    }
+
+    std::cout << "Network memory resource test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/** Unit test */
+static int main_impl(int argc, char * const argv[]) {
+    int exit_code = 64;  // pessimistic assumption
+
+    size_t loops = 10;
+    if (1 < argc) loops = ::atoi(argv[1]);
+
+    do {  // pragmatic do ... while (0) loop allowing for breaks
+        exit_code = test_monotonic();
+        if (0 != exit_code) break;
+
+        exit_code = test_huge_page();
+        if (0 != exit_code) break;
+
+        exit_code = test_nn(loops);
+        if (0 != exit_code) break;
+
+    } while (0);  // end of pragmatic loop
+
+    std::cerr
+        << "Exit code: " << exit_code
+        << std::endl;
+
+    return exit_code;
+}
+
+/** Unit test exception-safe wrapper */
+int main(int argc, char * const argv[]) {
+    int exit_code = 128;
+
+    try {
+        exit_code = main_impl(argc, argv);
+    }
+    catch (const std::exception & x) {
+        std::cerr
+            << "Standard exception caught: "
+            << x.what()
+            << std::endl;
+    }
+    catch (...) {
+        std::cerr
+            << "Unhandled non-standard exception caught"
+            << std::endl;
+    }
+
+    return exit_code;
+}
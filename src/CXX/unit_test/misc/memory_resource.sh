@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# Memory resources (network trained in 20 arenas)
+./memory_resource 20
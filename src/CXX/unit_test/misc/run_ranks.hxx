@@ -0,0 +1,113 @@
+#ifndef libnn__unit_test__misc__run_ranks_hxx
+#define libnn__unit_test__misc__run_ranks_hxx
+
+/**
+ *  Multi-process (rank) unit test fixture
+ *
+ *  \date    2026/10/18
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <vector>
+#include <iostream>
+#include <stdexcept>
+#include <functional>
+#include <cstddef>
+
+extern "C" {
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <signal.h>
+#include <unistd.h>
+}
+
+
+/**
+ *  \brief  Run ranks as processes
+ *
+ *  Ranks 1 and up are forked; rank 0 is run by the calling process.
+ *
+ *  \param  ranks  Rank count
+ *  \param  fn     Rank function (returns count of errors)
+ *
+ *  \return Count of errors (including failed ranks)
+ */
+static int run_ranks(size_t ranks, const std::function<int(size_t)> & fn) {
+    int error_cnt = 0;
+
+    std::cout.flush();
+
+    std::vector<pid_t> pids;
+    for (size_t r = 1; r < ranks; ++r) {
+        const pid_t pid = ::fork();
+        if (-1 == pid)
+            throw std::runtime_error("fork failed");
+
+        if (0 == pid) {
+            int rc = 1;
+            try { rc = fn(r); } catch (...) {}
+
+            ::_exit(rc ? 1 : 0);
+        }
+
+        pids.push_back(pid);
+    }
+
+    try {
+        error_cnt += fn(0);
+    }
+    catch (...) {
+        for (size_t i = 0; i < pids.size(); ++i) ::kill(pids[i], SIGKILL);
+
+        throw;
+    }
+
+    for (size_t i = 0; i < pids.size(); ++i) {
+        int status;
+        if (-1 == ::waitpid(pids[i], &status, 0) ||
+            !WIFEXITED(status) || 0 != WEXITSTATUS(status))
+        {
+            std::cout << "Rank " << i + 1 << " failed" << std::endl;
+
+            ++error_cnt;
+        }
+    }
+
+    return error_cnt;
+}
+
+
+#endif  // end of #ifndef libnn__unit_test__misc__run_ranks_hxx
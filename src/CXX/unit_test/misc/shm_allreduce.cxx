@@ -0,0 +1,262 @@
+/**
+ *  Shared memory all-reduce unit test
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "config.hxx"
+
+#include "run_ranks.hxx"
+
+#include <libnn/misc/shm_allreduce.hxx>
+
+#include <vector>
+#include <string>
+#include <sstream>
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+#include <functional>
+#include <chrono>
+#include <cstdlib>
+
+extern "C" {
+#include <sys/types.h>
+#include <unistd.h>
+}
+
+
+/** All-reduce type */
+typedef libnn::misc::shm_allreduce<double> allreduce_t;
+
+
+/**
+ *  \brief  Unique segment name
+ *
+ *  \return Segment name
+ */
+static std::string segment_name() {
+    static size_t cnt = 0;
+
+    std::stringstream name;
+    name << "/libnn_ut_shm_allreduce_" << ::getpid() << '_' << cnt++;
+
+    return name.str();
+}
+
+
+/**
+ *  \brief  All-reduce test
+ *
+ *  The vectors are integral, so that the sums are exact.
+ *
+ *  \param  ranks      Rank count
+ *  \param  capacity   Slot capacity
+ *  \param  size       Vector size
+ *  \param  algorithm  Algorithm
+ *
+ *  \return Count of errors
+ */
+static int test_allreduce(
+    size_t                   ranks,
+    size_t                   capacity,
+    size_t                   size,
+    allreduce_t::algorithm_t algorithm)
+{
+    std::cout
+        << "Shared memory all-reduce test ("
+        << (allreduce_t::TREE == algorithm ? "tree" : "ring") << ", "
+        << ranks << " ranks, capacity " << capacity << ", size " << size
+        << ") BEGIN" << std::endl;
+
+    const std::string name = segment_name();
+
+    int error_cnt = run_ranks(ranks, [=](size_t rank) {
+        int error_cnt = 0;
+
+        allreduce_t allreduce(name, ranks, rank, capacity, algorithm);
+
+        for (size_t round = 0; round < 3; ++round) {
+            std::vector<double> data(size);
+            for (size_t i = 0; i < size; ++i)
+                data[i] = (double)(rank * 1000 + i + round);
+
+            allreduce(data.data(), size);
+
+            for (size_t i = 0; i < size; ++i) {
+                const double exp = (double)(
+                    1000 * ranks * (ranks - 1) / 2 + ranks * (i + round));
+
+                if (data[i] != exp) {
+                    std::cout
+                        << "Rank " << rank << ", round " << round
+                        << ": sum[" << i << "] == " << data[i]
+                        << " (expected " << exp << ')' << std::endl;
+
+                    ++error_cnt;
+                    break;
+                }
+            }
+        }
+
+        return error_cnt;
+    });
+
+    std::cout << "Shared memory all-reduce test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  All-reduce benchmark
+ *
+ *  The throughput is only reported (it depends on the machine).
+ *
+ *  \param  ranks  Rank count
+ *  \param  size   Vector size
+ *
+ *  \return Count of errors
+ */
+static int bench_allreduce(size_t ranks, size_t size) {
+    typedef std::chrono::steady_clock clock_t;
+
+    std::cout
+        << "Shared memory all-reduce benchmark (" << ranks << " ranks, size "
+        << size << ") BEGIN" << std::endl;
+
+    const size_t rounds = 20;
+
+    for (int a = allreduce_t::RING; a <= allreduce_t::TREE; ++a) {
+        const std::string name = segment_name();
+
+        const int error_cnt = run_ranks(ranks, [=](size_t rank) {
+            allreduce_t allreduce(name, ranks, rank, size,
+                (allreduce_t::algorithm_t)a);
+
+            std::vector<double> data(size, 1.0);
+
+            allreduce.sync();
+            const auto t0 = clock_t::now();
+
+            for (size_t i = 0; i < rounds; ++i)
+                allreduce(data.data(), size);
+
+            const auto t1 = clock_t::now();
+
+            if (0 == rank)
+                std::cout
+                    << (allreduce_t::TREE == a ? "Tree" : "Ring") << ": "
+                    << std::chrono::duration<double, std::milli>(
+                        t1 - t0).count() / rounds
+                    << " ms per all-reduce" << std::endl;
+
+            return 0;
+        });
+
+        if (error_cnt) return error_cnt;
+    }
+
+    std::cout << "Shared memory all-reduce benchmark END" << std::endl;
+
+    return 0;
+}
+
+
+/** Unit test */
+static int main_impl(int argc, char * const argv[]) {
+    int exit_code = 64;  // pessimistic assumption
+
+    size_t size = 1 << 20;  // benchmark vector size (0 means no benchmark)
+    if (1 < argc) size = ::atoi(argv[1]);
+
+    do {  // pragmatic do ... while (0) loop allowing for breaks
+        exit_code = 0;
+
+        const size_t ranks_list[] = { 1, 2, 3, 5 };
+        for (size_t i = 0; i < sizeof(ranks_list) / sizeof(size_t); ++i) {
+            for (int a = allreduce_t::RING; a <= allreduce_t::TREE; ++a) {
+                // Single piece and pieces
+                exit_code += test_allreduce(ranks_list[i], 1024, 1000,
+                    (allreduce_t::algorithm_t)a);
+
+                exit_code += test_allreduce(ranks_list[i], 64, 1000,
+                    (allreduce_t::algorithm_t)a);
+
+                // Less elements than ranks (empty chunks)
+                exit_code += test_allreduce(ranks_list[i], 64, 2,
+                    (allreduce_t::algorithm_t)a);
+            }
+        }
+
+        if (0 != exit_code) break;
+
+        if (size) {
+            exit_code = bench_allreduce(4, size);
+            if (0 != exit_code) break;
+        }
+
+    } while (0);  // end of pragmatic loop
+
+    std::cerr
+        << "Exit code: " << exit_code
+        << std::endl;
+
+    return exit_code;
+}
+
+/** Unit test exception-safe wrapper */
+int main(int argc, char * const argv[]) {
+    int exit_code = 128;
+
+    try {
+        exit_code = main_impl(argc, argv);
+    }
+    catch (const std::exception & x) {
+        std::cerr
+            << "Standard exception caught: "
+            << x.what()
+            << std::endl;
+    }
+    catch (...) {
+        std::cerr
+            << "Unhandled non-standard exception caught"
+            << std::endl;
+    }
+
+    return exit_code;
+}
@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# Correctness tests and benchmark (4 ranks, vectors of 1M elements)
+./shm_allreduce 1048576
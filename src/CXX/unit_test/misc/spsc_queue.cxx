@@ -0,0 +1,192 @@
+/**
+ *  SPSC queue unit test
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "config.hxx"
+
+#include <libnn/misc/spsc_queue.hxx>
+
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <cstdlib>
+
+
+/**
+ *  \brief  Sequential test
+ *
+ *  \return Count of errors
+ */
+static int test_sequential() {
+    std::cout << "SPSC queue sequential test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    libnn::misc::spsc_queue<int> queue(5);
+
+    if (8 != queue.capacity()) {
+        std::cout << "Unexpected capacity: " << queue.capacity() << std::endl;
+
+        ++error_cnt;
+    }
+
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 8; ++i)
+            if (!queue.push(i)) {
+                std::cout << "Push failed" << std::endl;
+
+                ++error_cnt;
+            }
+
+        if (queue.push(8)) {
+            std::cout << "Push to full queue succeeded" << std::endl;
+
+            ++error_cnt;
+        }
+
+        int item;
+        for (int i = 0; i < 8; ++i)
+            if (!queue.pop(item) || item != i) {
+                std::cout << "Unexpected item" << std::endl;
+
+                ++error_cnt;
+            }
+
+        if (queue.pop(item) || !queue.empty()) {
+            std::cout << "Pop from empty queue succeeded" << std::endl;
+
+            ++error_cnt;
+        }
+    }
+
+    std::cout << "SPSC queue sequential test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  Concurrent test
+ *
+ *  Producer thread pushes sequence of numbers, the consumer checks
+ *  their order.
+ *
+ *  \param  cnt  Item count
+ *
+ *  \return Count of errors
+ */
+static int test_concurrent(size_t cnt) {
+    std::cout << "SPSC queue concurrent test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    libnn::misc::spsc_queue<size_t> queue(64);
+
+    std::thread producer([&queue, cnt]() {
+        for (size_t i = 0; i < cnt; ++i)
+            while (!queue.push(i)) std::this_thread::yield();
+    });
+
+    for (size_t i = 0; i < cnt; ++i) {
+        size_t item;
+        while (!queue.pop(item)) std::this_thread::yield();
+
+        if (item != i) {
+            std::cout
+                << "Unexpected item " << item << " (expected " << i << ')'
+                << std::endl;
+
+            ++error_cnt;
+            break;
+        }
+    }
+
+    producer.join();
+
+    std::cout << "SPSC queue concurrent test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/** Unit test */
+static int main_impl(int argc, char * const argv[]) {
+    int exit_code = 64;  // pessimistic assumption
+
+    size_t cnt = 100000;
+    if (1 < argc) cnt = ::atoi(argv[1]);
+
+    do {  // pragmatic do ... while (0) loop allowing for breaks
+        exit_code = test_sequential();
+        if (0 != exit_code) break;
+
+        exit_code = test_concurrent(cnt);
+        if (0 != exit_code) break;
+
+    } while (0);  // end of pragmatic loop
+
+    std::cerr
+        << "Exit code: " << exit_code
+        << std::endl;
+
+    return exit_code;
+}
+
+/** Unit test exception-safe wrapper */
+int main(int argc, char * const argv[]) {
+    int exit_code = 128;
+
+    try {
+        exit_code = main_impl(argc, argv);
+    }
+    catch (const std::exception & x) {
+        std::cerr
+            << "Standard exception caught: "
+            << x.what()
+            << std::endl;
+    }
+    catch (...) {
+        std::cerr
+            << "Unhandled non-standard exception caught"
+            << std::endl;
+    }
+
+    return exit_code;
+}
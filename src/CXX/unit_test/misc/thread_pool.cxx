@@ -0,0 +1,335 @@
+/**
+ *  Thread pool unit test
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "config.hxx"
+
+#include <libnn/misc/thread_pool.hxx>
+#include <libnn/misc/executor.hxx>
+#include <libnn/math/gemm.hxx>
+
+#include <vector>
+#include <list>
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+#include <atomic>
+#include <future>
+#include <cmath>
+#include <cstdlib>
+
+
+/**
+ *  \brief  Parallel for test
+ *
+ *  Each index of the range shall be processed exactly once.
+ *
+ *  \param  exec  Executor
+ *  \param  size  Range size
+ *  \param  grain  Grain size
+ *
+ *  \return Count of errors
+ */
+static int test_parallel_for(
+    libnn::misc::executor & exec,
+    size_t                  size,
+    size_t                  grain)
+{
+    int error_cnt = 0;
+
+    std::vector<std::atomic<int> > hits(size + 10);
+    for (size_t i = 0; i < hits.size(); ++i) hits[i] = 0;
+
+    exec.parallel_for(5, size + 5,
+    [&hits](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) ++hits[i];
+    }, grain);
+
+    for (size_t i = 0; i < hits.size(); ++i)
+        if (hits[i] != (5 <= i && i < size + 5 ? 1 : 0)) {
+            std::cout
+                << "Index " << i << " processed " << hits[i]
+                << " times (size " << size << ", grain " << grain << ')'
+                << std::endl;
+
+            ++error_cnt;
+            break;
+        }
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  Nested parallel for test
+ *
+ *  \param  exec  Executor
+ *
+ *  \return Count of errors
+ */
+static int test_nested(libnn::misc::executor & exec) {
+    std::atomic<size_t> sum(0);
+
+    exec.parallel_for(0, 16,
+    [&exec, &sum](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+            exec.parallel_for(0, 1000,
+            [&sum](size_t b, size_t e) {
+                size_t s = 0;
+                for (size_t j = b; j < e; ++j) s += j;
+
+                sum += s;
+            }, 10);
+    }, 1);
+
+    if (16 * 999 * 1000 / 2 != sum) {
+        std::cout << "Nested loops sum mismatch: " << sum << std::endl;
+
+        return 1;
+    }
+
+    return 0;
+}
+
+
+/**
+ *  \brief  Exception propagation test
+ *
+ *  \param  exec  Executor
+ *
+ *  \return Count of errors
+ */
+static int test_exception(libnn::misc::executor & exec) {
+    try {
+        exec.parallel_for(0, 1000,
+        [](size_t begin, size_t end) {
+            if (begin <= 500 && 500 < end)
+                throw std::runtime_error("expected");
+        }, 10);
+    }
+    catch (const std::runtime_error & x) {
+        return 0;
+    }
+
+    std::cout << "Exception was not propagated" << std::endl;
+
+    return 1;
+}
+
+
+/**
+ *  \brief  Parallel GEMM test
+ *
+ *  \param  exec  Executor
+ *
+ *  \return Count of errors
+ */
+static int test_gemm(libnn::misc::executor & exec) {
+    const size_t m = 200, n = 150, k = 100;
+
+    std::vector<double> a(m * k), b(k * n), c1(m * n, 1), c2(m * n, 1);
+    for (size_t i = 0; i < a.size(); ++i) a[i] = (double)::rand() / RAND_MAX;
+    for (size_t i = 0; i < b.size(); ++i) b[i] = (double)::rand() / RAND_MAX;
+
+    libnn::math::gemm<double>(libnn::math::NO_TRANS, libnn::math::NO_TRANS,
+        m, n, k, 1, a.data(), k, b.data(), n, 0.5, c1.data(), n);
+
+    libnn::math::gemm_threaded<double>(exec,
+        libnn::math::NO_TRANS, libnn::math::NO_TRANS,
+        m, n, k, 1, a.data(), k, b.data(), n, 0.5, c2.data(), n);
+
+    for (size_t i = 0; i < c1.size(); ++i)
+        if (std::abs(c1[i] - c2[i]) > 1e-12) {
+            std::cout << "Parallel GEMM mismatch" << std::endl;
+
+            return 1;
+        }
+
+    return 0;
+}
+
+
+/**
+ *  \brief  Executor test
+ *
+ *  \param  name  Executor name
+ *  \param  exec  Executor
+ *
+ *  \return Count of errors
+ */
+static int test_executor(const char * name, libnn::misc::executor & exec) {
+    std::cout
+        << name << " (concurrency " << exec.concurrency()
+        << ") test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    const size_t sizes[]  = { 1, 7, 1000, 10007 };
+    const size_t grains[] = { 0, 1, 100, 20000 };
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+        for (size_t g = 0; g < sizeof(grains) / sizeof(grains[0]); ++g)
+            error_cnt += test_parallel_for(exec, sizes[s], grains[g]);
+
+    error_cnt += test_nested(exec);
+    error_cnt += test_exception(exec);
+    error_cnt += test_gemm(exec);
+
+    std::cout << name << " test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  Task submission test
+ *
+ *  \param  pool  Thread pool
+ *
+ *  \return Count of errors
+ */
+static int test_submit(libnn::misc::thread_pool & pool) {
+    int error_cnt = 0;
+
+    std::atomic<int> cnt(0);
+    std::list<std::future<void> > futures;
+
+    for (int i = 0; i < 100; ++i)
+        futures.push_back(pool.submit([&cnt]() { ++cnt; }));
+
+    for (auto & f : futures) f.get();
+
+    if (100 != cnt) {
+        std::cout << "Tasks executed: " << cnt << std::endl;
+
+        ++error_cnt;
+    }
+
+    std::future<void> failed = pool.submit([]() {
+        throw std::runtime_error("expected");
+    });
+
+    try {
+        failed.get();
+
+        std::cout << "Task exception was not propagated" << std::endl;
+
+        ++error_cnt;
+    }
+    catch (const std::runtime_error & x) {}
+
+    return error_cnt;
+}
+
+
+/** Unit test */
+static int main_impl(int argc, char * const argv[]) {
+    int exit_code = 64;  // pessimistic assumption
+
+    do {  // pragmatic do ... while (0) loop allowing for breaks
+        libnn::misc::serial_executor serial;
+
+        exit_code = test_executor("Serial executor", serial);
+        if (0 != exit_code) break;
+
+        libnn::misc::thread_pool pool1(1);
+
+        exit_code = test_executor("Thread pool", pool1);
+        if (0 != exit_code) break;
+
+        libnn::misc::thread_pool pool(3);
+
+        exit_code = test_executor("Thread pool", pool);
+        if (0 != exit_code) break;
+
+        exit_code = test_submit(pool);
+        if (0 != exit_code) break;
+
+        // CPU affinity (if supported)
+        const std::vector<int> cpus =
+            libnn::misc::thread_pool::available_cpus();
+
+        std::cout << "Available CPUs: " << cpus.size() << std::endl;
+
+        if (!cpus.empty()) {
+            libnn::misc::thread_pool pinned(2, cpus);
+
+            exit_code = test_executor("Pinned thread pool", pinned);
+            if (0 != exit_code) break;
+        }
+
+        // Application executor hook (tasks run by the pool)
+        libnn::misc::function_executor hook(
+        [&pool](const libnn::misc::function_executor::task_t & task) {
+            pool.submit(task);
+        }, pool.size());
+
+        exit_code = test_executor("Function executor", hook);
+        if (0 != exit_code) break;
+
+    } while (0);  // end of pragmatic loop
+
+    std::cerr
+        << "Exit code: " << exit_code
+        << std::endl;
+
+    return exit_code;
+}
+
+/** Unit test exception-safe wrapper */
+int main(int argc, char * const argv[]) {
+    int exit_code = 128;
+
+    try {
+        exit_code = main_impl(argc, argv);
+    }
+    catch (const std::exception & x) {
+        std::cerr
+            << "Standard exception caught: "
+            << x.what()
+            << std::endl;
+    }
+    catch (...) {
+        std::cerr
+            << "Unhandled non-standard exception caught"
+            << std::endl;
+    }
+
+    return exit_code;
+}
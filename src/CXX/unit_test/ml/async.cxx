@@ -0,0 +1,665 @@
+/**
+ *  Async (coroutine) network evaluation unit test
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "config.hxx"
+
+#include "common.hxx"
+
+#include <libnn/model/feed_forward.hxx>
+#include <libnn/ml/async.hxx>
+#include <libnn/misc/thread_pool.hxx>
+#include <libnn/math/sigmoid.hxx>
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cmath>
+
+
+/** Feed-forward network model */
+typedef libnn::model::feed_forward<double, libnn::math::logistic_fn<double> >
+    nn_t;
+
+/** Clock */
+typedef std::chrono::steady_clock steady_t;
+
+
+/** Slow network function statistics */
+struct slow_stats {
+    std::atomic<size_t> evals;      /**< Evaluations        */
+    std::atomic<size_t> max_batch;  /**< Maximal batch size */
+
+    /** Constructor */
+    slow_stats(): evals(0), max_batch(0) {}
+
+};  // end of struct slow_stats
+
+
+/**
+ *  \brief  Slow network function
+ *
+ *  Wraps network function; delays evaluations and counts them.
+ */
+class slow_fn {
+    private:
+
+    nn_t::function_t          m_fn;     /**< Function   */
+    std::chrono::milliseconds m_delay;  /**< Delay      */
+    slow_stats &              m_stats;  /**< Statistics */
+
+    public:
+
+    /** Constructor */
+    slow_fn(const nn_t & nn, size_t delay_ms, slow_stats & stats):
+        m_fn(nn.function()),
+        m_delay(delay_ms),
+        m_stats(stats)
+    {}
+
+    /** Evaluation */
+    std::vector<double> operator () (const std::vector<double> & input) {
+        std::this_thread::sleep_for(m_delay);
+        ++m_stats.evals;
+
+        return m_fn(input);
+    }
+
+    /** Batch evaluation */
+    inputs_t batch(const inputs_t & inputs) {
+        std::this_thread::sleep_for(m_delay);
+        m_stats.evals += inputs.size();
+
+        if (inputs.size() > m_stats.max_batch)
+            m_stats.max_batch = inputs.size();
+
+        return m_fn.batch(inputs);
+    }
+
+};  // end of class slow_fn
+
+typedef libnn::ml::async_func<double, slow_fn>    async_fn_t;    /**< Async  */
+typedef libnn::ml::async_batcher<double, slow_fn> async_batch_t; /**< Batch. */
+
+
+/** Detached coroutine */
+struct detached {
+    /** Promise */
+    struct promise_type {
+        detached get_return_object() { return detached(); }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };  // end of struct promise_type
+};  // end of struct detached
+
+
+/** Coroutine completion counter */
+class counter {
+    private:
+
+    std::mutex              m_mx;    /**< Mutex  */
+    std::condition_variable m_cv;    /**< Signal */
+    size_t                  m_done;  /**< Count  */
+
+    public:
+
+    /** Constructor */
+    counter(): m_done(0) {}
+
+    /** Count completion */
+    void arrive() {
+        std::lock_guard<std::mutex> lock(m_mx);
+        ++m_done;
+        m_cv.notify_all();
+    }
+
+    /** Count */
+    size_t done() {
+        std::lock_guard<std::mutex> lock(m_mx);
+        return m_done;
+    }
+
+    /** Wait for count */
+    void wait(size_t cnt) {
+        std::unique_lock<std::mutex> lock(m_mx);
+        m_cv.wait(lock, [this, cnt]() { return m_done >= cnt; });
+    }
+
+};  // end of class counter
+
+
+/** Evaluation outcome */
+enum outcome_t {
+    PENDING = 0,  /**< Not completed        */
+    OUTPUT,       /**< Output (correct)     */
+    MISMATCH,     /**< Output (incorrect)   */
+    CANCELLED,    /**< Cancelled            */
+    EXPIRED,      /**< Deadline exceeded    */
+    FAILED        /**< Evaluation failed    */
+};  // end of enum outcome_t
+
+
+/**
+ *  \brief  Evaluation coroutine
+ *
+ *  \tparam Async     Async function type
+ *  \param  fn        Async function
+ *  \param  input     Input
+ *  \param  expected  Expected output
+ *  \param  cancel    Cancellation token
+ *  \param  deadline  Deadline
+ *  \param  outcome   Outcome
+ *  \param  thread    Thread resuming the coroutine
+ *  \param  done      Completion counter
+ */
+template <class Async>
+static detached evaluate(
+    Async                                & fn,
+    std::vector<double>                    input,
+    const std::vector<double>            & expected,
+    libnn::ml::cancel_token                cancel,
+    steady_t::time_point                    deadline,
+    outcome_t                            & outcome,
+    std::thread::id                      & thread,
+    counter                              & done)
+{
+    try {
+        const std::vector<double> out =
+            co_await fn(std::move(input), cancel, deadline);
+
+        outcome = OUTPUT;
+        for (size_t i = 0; i < expected.size(); ++i)
+            if (!(std::abs(expected[i] - out.at(i)) <= 1e-12))
+                outcome = MISMATCH;
+    }
+    catch (const libnn::ml::operation_cancelled & ) { outcome = CANCELLED; }
+    catch (const libnn::ml::deadline_exceeded & )   { outcome = EXPIRED; }
+    catch (const std::exception & )                 { outcome = FAILED; }
+
+    thread = std::this_thread::get_id();
+    done.arrive();
+}
+
+
+/** Async evaluation test fixture */
+struct fixture {
+    nn_t                          nn;        /**< Network           */
+    inputs_t                      inputs;    /**< Inputs            */
+    inputs_t                      expected;  /**< Expected outputs  */
+    std::vector<outcome_t>        outcomes;  /**< Outcomes          */
+    std::vector<std::thread::id>  threads;   /**< Resuming threads  */
+    counter                       done;      /**< Completions       */
+
+    /** Constructor */
+    fixture(size_t cnt):
+        nn(create_nn<nn_t>(std::vector<size_t>({8, 16, 3}), nn_t::BIAS)),
+        inputs(random_inputs(cnt, 8)),
+        outcomes(cnt, PENDING),
+        threads(cnt)
+    {
+        nn_t::function_t function = nn.function();
+        for (size_t i = 0; i < cnt; ++i)
+            expected.push_back(function(inputs[i]));
+    }
+
+    /** Start evaluation coroutine */
+    template <class Async>
+    void start(
+        Async &                        fn,
+        size_t                         i,
+        const libnn::ml::cancel_token & cancel   = libnn::ml::cancel_token(),
+        steady_t::time_point            deadline = steady_t::time_point::max())
+    {
+        evaluate(fn, inputs[i], expected[i], cancel, deadline,
+            outcomes[i], threads[i], done);
+    }
+
+    /**
+     *  \brief  Slow function factory
+     *
+     *  \param  delay_ms  Evaluation delay
+     *  \param  stats     Statistics
+     */
+    async_fn_t::factory_t factory(size_t delay_ms, slow_stats & stats) const {
+        const nn_t & network = nn;
+        return [&network, delay_ms, &stats]() {
+            return slow_fn(network, delay_ms, stats);
+        };
+    }
+
+    /** Count of outcomes */
+    size_t count(outcome_t outcome) const {
+        size_t cnt = 0;
+        for (size_t i = 0; i < outcomes.size(); ++i)
+            if (outcome == outcomes[i]) ++cnt;
+
+        return cnt;
+    }
+
+};  // end of struct fixture
+
+
+/**
+ *  \brief  Evaluation test
+ *
+ *  \return Count of errors
+ */
+static int test_eval() {
+    std::cout << "Async evaluation test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    fixture fx(100);
+    libnn::misc::thread_pool pool(2);
+
+    slow_stats stats;
+    async_fn_t async_fn(fx.factory(0, stats), pool);
+
+    for (size_t i = 0; i < fx.outcomes.size(); ++i) fx.start(async_fn, i);
+
+    fx.done.wait(fx.outcomes.size());
+
+    if (fx.outcomes.size() != fx.count(OUTPUT)) {
+        std::cout << "Unexpected outcomes" << std::endl;
+
+        ++error_cnt;
+    }
+
+    // Invalid input
+    fx.inputs[0].resize(3);
+    fx.start(async_fn, 0);
+    fx.done.wait(fx.outcomes.size() + 1);
+
+    if (FAILED != fx.outcomes[0]) {
+        std::cout << "Invalid input evaluated" << std::endl;
+
+        ++error_cnt;
+    }
+
+    std::cout << "Async evaluation test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  Cancellation test
+ *
+ *  \return Count of errors
+ */
+static int test_cancel() {
+    std::cout << "Async cancellation test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    fixture fx(3);
+    libnn::misc::thread_pool pool(1);
+
+    slow_stats stats;
+    async_fn_t async_fn(fx.factory(50, stats), pool);
+
+    libnn::ml::cancel_source source;
+
+    fx.start(async_fn, 0);                  // occupies the pool
+    fx.start(async_fn, 1, source.token());  // queued
+
+    source.cancel();
+
+    if (CANCELLED != fx.outcomes[1]) {  // resumed by the cancelling thread
+        std::cout << "Evaluation not cancelled at once" << std::endl;
+
+        ++error_cnt;
+    }
+
+    fx.start(async_fn, 2, source.token());  // cancelled in advance
+
+    if (CANCELLED != fx.outcomes[2]) {
+        std::cout << "Cancelled evaluation started" << std::endl;
+
+        ++error_cnt;
+    }
+
+    fx.done.wait(3);
+    pool.stop();
+
+    if (OUTPUT != fx.outcomes[0] || 1 != stats.evals) {
+        std::cout
+            << "Unexpected evaluations: " << stats.evals << std::endl;
+
+        ++error_cnt;
+    }
+
+    std::cout << "Async cancellation test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  Deadline test
+ *
+ *  \return Count of errors
+ */
+static int test_deadline() {
+    std::cout << "Async deadline test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    fixture fx(3);
+    libnn::misc::thread_pool pool(1);
+
+    slow_stats stats;
+    async_fn_t async_fn(fx.factory(200, stats), pool);
+
+    const steady_t::time_point t0 = steady_t::now();
+
+    fx.start(async_fn, 0, libnn::ml::cancel_token(),
+        t0 + std::chrono::milliseconds(20));
+
+    fx.start(async_fn, 1, libnn::ml::cancel_token(), t0);  // passed already
+
+    if (EXPIRED != fx.outcomes[1]) {
+        std::cout << "Expired evaluation started" << std::endl;
+
+        ++error_cnt;
+    }
+
+    fx.done.wait(2);
+
+    const double time = std::chrono::duration<double>(
+        steady_t::now() - t0).count();
+
+    std::cout << "Expired after " << time * 1000 << " ms" << std::endl;
+
+    if (EXPIRED != fx.outcomes[0] || time > 0.15) {
+        std::cout << "Deadline not met" << std::endl;
+
+        ++error_cnt;
+    }
+
+    // Deadline far enough
+    fx.start(async_fn, 2, libnn::ml::cancel_token(),
+        steady_t::now() + std::chrono::seconds(10));
+
+    fx.done.wait(3);
+
+    if (OUTPUT != fx.outcomes[2]) {
+        std::cout << "Evaluation failed" << std::endl;
+
+        ++error_cnt;
+    }
+
+    std::cout << "Async deadline test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  Batching test
+ *
+ *  \return Count of errors
+ */
+static int test_batcher() {
+    std::cout << "Async batching test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    fixture fx(64);
+    libnn::misc::thread_pool pool(1);
+
+    slow_stats    stats;
+    slow_fn       fn(fx.nn, 5, stats);
+    async_batch_t batcher(fn, pool, 16);
+
+    libnn::ml::cancel_source source;
+
+    for (size_t i = 0; i < fx.outcomes.size(); ++i)
+        fx.start(batcher, i, 63 == i
+            ? source.token() : libnn::ml::cancel_token());
+
+    source.cancel();
+
+    fx.done.wait(fx.outcomes.size());
+
+    std::cout
+        << "Requests: " << batcher.requests()
+        << ", batches: " << batcher.batches()
+        << " (max. " << stats.max_batch << ")" << std::endl;
+
+    if (63 != fx.count(OUTPUT) || CANCELLED != fx.outcomes[63]) {
+        std::cout << "Unexpected outcomes" << std::endl;
+
+        ++error_cnt;
+    }
+
+    if (!(batcher.batches() < batcher.requests())) {
+        std::cout << "Requests were not batched" << std::endl;
+
+        ++error_cnt;
+    }
+
+    if (stats.max_batch > batcher.max_batch()) {
+        std::cout << "Maximal batch size exceeded" << std::endl;
+
+        ++error_cnt;
+    }
+
+    std::cout << "Async batching test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  Batching invalid request test
+ *
+ *  Request with invalid input batched with valid ones fails alone.
+ *
+ *  \return Count of errors
+ */
+static int test_batcher_invalid() {
+    std::cout << "Async batching invalid request test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    fixture fx(32);
+    fx.inputs[20].resize(5);  // invalid input
+
+    libnn::misc::thread_pool pool(1);
+
+    slow_stats    stats;
+    slow_fn       fn(fx.nn, 5, stats);
+    async_batch_t batcher(fn, pool, 16);
+
+    for (size_t i = 0; i < fx.outcomes.size(); ++i)
+        fx.start(batcher, i);
+
+    fx.done.wait(fx.outcomes.size());
+
+    std::cout
+        << "Requests: " << batcher.requests()
+        << ", batches: " << batcher.batches()
+        << " (max. " << stats.max_batch << ")" << std::endl;
+
+    if (31 != fx.count(OUTPUT) || FAILED != fx.outcomes[20]) {
+        std::cout << "Unexpected outcomes" << std::endl;
+
+        ++error_cnt;
+    }
+
+    if (!(stats.max_batch > 1)) {
+        std::cout << "Requests were not batched" << std::endl;
+
+        ++error_cnt;
+    }
+
+    std::cout << "Async batching invalid request test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  Resume function test
+ *
+ *  The coroutines are resumed by an event loop (the main thread).
+ *
+ *  \return Count of errors
+ */
+static int test_resume() {
+    std::cout << "Async resume function test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    fixture fx(20);
+    libnn::misc::thread_pool pool(2);
+
+    std::mutex                          mx;
+    std::condition_variable             cv;
+    std::deque<std::coroutine_handle<> > ready;
+
+    slow_stats stats;
+    async_fn_t async_fn(fx.factory(1, stats), pool,
+    [&](std::coroutine_handle<> h) {
+        std::lock_guard<std::mutex> lock(mx);
+        ready.push_back(h);
+        cv.notify_one();
+    });
+
+    for (size_t i = 0; i < fx.outcomes.size(); ++i) fx.start(async_fn, i);
+
+    // Event loop
+    while (fx.done.done() < fx.outcomes.size()) {
+        std::coroutine_handle<> h;
+        {
+            std::unique_lock<std::mutex> lock(mx);
+            cv.wait(lock, [&]() { return !ready.empty(); });
+
+            h = ready.front();
+            ready.pop_front();
+        }
+
+        h.resume();
+    }
+
+    for (size_t i = 0; i < fx.outcomes.size(); ++i)
+        if (std::this_thread::get_id() != fx.threads[i]) {
+            std::cout << "Coroutine resumed by another thread" << std::endl;
+
+            ++error_cnt;
+            break;
+        }
+
+    if (fx.outcomes.size() != fx.count(OUTPUT)) {
+        std::cout << "Unexpected outcomes" << std::endl;
+
+        ++error_cnt;
+    }
+
+    std::cout << "Async resume function test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/** Unit test */
+static int main_impl(int argc, char * const argv[]) {
+    int exit_code = 64;  // pessimistic assumption
+
+    do {  // pragmatic do ... while (0) loop allowing for breaks
+        exit_code = test_eval();
+        if (0 != exit_code) break;
+
+        exit_code = test_cancel();
+        if (0 != exit_code) break;
+
+        exit_code = test_deadline();
+        if (0 != exit_code) break;
+
+        exit_code = test_batcher();
+        if (0 != exit_code) break;
+
+        exit_code = test_batcher_invalid();
+        if (0 != exit_code) break;
+
+        exit_code = test_resume();
+        if (0 != exit_code) break;
+
+    } while (0);  // end of pragmatic loop
+
+    std::cerr
+        << "Exit code: " << exit_code
+        << std::endl;
+
+    return exit_code;
+}
+
+/** Unit test exception-safe wrapper */
+int main(int argc, char * const argv[]) {
+    int exit_code = 128;
+
+    try {
+        exit_code = main_impl(argc, argv);
+    }
+    catch (const std::exception & x) {
+        std::cerr
+            << "Standard exception caught: "
+            << x.what()
+            << std::endl;
+    }
+    catch (...) {
+        std::cerr
+            << "Unhandled non-standard exception caught"
+            << std::endl;
+    }
+
+    return exit_code;
+}
@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# Evaluation, cancellation, deadline and batching tests
+./async
@@ -40,45 +40,27 @@
 
 #include "config.hxx"
 
+#include "linear.hxx"
+
 #include <libnn/topo/nn.hxx>
 #include <libnn/io/nn.hxx>
 #include <libnn/ml/backpropagation.hxx>
 #include <libnn/ml/nn_func.hxx>
+#include <libnn/misc/memory_resource.hxx>
 
 #include <vector>
+#include <utility>
 #include <algorithm>
 #include <iostream>
 #include <exception>
 #include <stdexcept>
+#include <cmath>
 
 
-/** Identity activation functor */
-template <typename Base_t>
-class identity {
-    public:
-
-    /** Identity function */
-    Base_t operator () (const Base_t & x) const { return x; }
-
-    /** Identity derivation (i.e. 1) */
-    Base_t d(const Base_t & x) const { return 1; }
-
-};  // end of template class identity
-
-/** Simple linear neural network model */
-typedef libnn::topo::nn<double, identity<double> > nn_t;
-
-/** Simple linear neural network backpropagation algorithm */
-typedef libnn::ml::backpropagation<double, identity<double> >
-    backpropagation_t;
-
 /** Adaptive learning criterion */
 typedef libnn::ml::adaptive_learning_factor<double>
     adaptive_learning_factor_t;
 
-/** Simple linear neural network function */
-typedef libnn::ml::nn_func<double, identity<double> > nn_func_t;
-
 
 /** Identity activation functor serialisation */
 template <typename Base_t>
@@ -622,6 +604,249 @@ static int test_backpropagation_batch_adaptive(
 }
 
 
+/**
+ *  \brief  NN backpropagation checkpointed batch test
+ *
+ *  Trains 2 instances of the same network; one in plain batch mode,
+ *  the other in checkpointed batch mode.
+ *  The resulting networks must be (nearly) the same and the checkpointed
+ *  training must use less memory.
+ *
+ *  \param  loops  Training loop count
+ *  \param  alpha  Learning factor
+ *
+ *  \return Count of errors
+ */
+static int test_backpropagation_checkpointed(
+    size_t loops,
+    double alpha)
+{
+    std::cout << "NN checkpointed backpropagation test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    const std::vector<size_t> layers({4, 4, 4, 4, 4, 4, 3});
+
+    nn_t nn_plain; create_deep_nn(nn_plain, layers);
+    nn_t nn_ckpt;  create_deep_nn(nn_ckpt,  layers);
+
+    backpropagation_t bprop_plain(nn_plain);
+    backpropagation_t bprop_ckpt(nn_ckpt);
+
+    bprop_ckpt.checkpoint(3);
+
+    auto criterion = [alpha](double err_n2) -> double {
+        return alpha;
+    };
+
+    // f([x, y, z, q]) = q[3, 2, 1] + 2[x, y, z]
+    std::vector<std::pair<std::vector<double>, std::vector<double> > > set;
+    for (int i = 1; i <= 20; ++i) {
+        const double x = 0.1 * i;
+
+        set.emplace_back(
+            std::vector<double>({x, 2*x, 3*x, 4*x}),
+            std::vector<double>({12*x + 2*x, 8*x + 4*x, 4*x + 6*x}));
+    }
+
+    for (size_t i = 0; i < loops; ++i) {
+        const double en2_plain = bprop_plain(set, criterion);
+        const double en2_ckpt  = bprop_ckpt(set, criterion);
+
+        std::cout
+            << "Loop " << i + 1 << ": |err|^2 == " << en2_plain
+            << " (checkpointed: " << en2_ckpt << ')'
+            << std::endl;
+
+        if (std::abs(en2_plain - en2_ckpt) > 1e-9 * (1 + en2_plain)) {
+            std::cout << "Error norms differ" << std::endl;
+
+            ++error_cnt;
+        }
+    }
+
+    // Compare weights
+    for (size_t i = 0; i < nn_plain.slot_cnt(); ++i) {
+        std::vector<double> w_plain, w_ckpt;
+
+        nn_plain.get_neuron(i).for_each_dendrite(
+        [&w_plain](const nn_t::neuron::dendrite & dend) {
+            w_plain.push_back(dend.weight());
+        });
+
+        nn_ckpt.get_neuron(i).for_each_dendrite(
+        [&w_ckpt](const nn_t::neuron::dendrite & dend) {
+            w_ckpt.push_back(dend.weight());
+        });
+
+        for (size_t j = 0; j < w_plain.size(); ++j)
+            if (std::abs(w_plain[j] - w_ckpt[j]) > 1e-9) {
+                std::cout
+                    << "Weight mismatch: neuron " << i
+                    << ", dendrite " << j << ": "
+                    << w_plain[j] << " != " << w_ckpt[j]
+                    << std::endl;
+
+                ++error_cnt;
+            }
+    }
+
+    const size_t mem_plain = bprop_plain.peak_activation_memory();
+    const size_t mem_ckpt  = bprop_ckpt.peak_activation_memory();
+
+    std::cout
+        << "Peak activation memory: " << mem_plain << " B"
+        << " (checkpointed: " << mem_ckpt << " B)"
+        << std::endl;
+
+    if (!(mem_ckpt < mem_plain)) {
+        std::cout << "Checkpointing didn't save memory" << std::endl;
+
+        ++error_cnt;
+    }
+
+    std::cout << "NN checkpointed backpropagation test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  NN backpropagation with shared weights test
+ *
+ *  The network has 2 inputs and 2 outputs; the synapses share 2 weights
+ *  (w, v) crosswise:
+ *  o1 = w x + v y
+ *  o2 = v x + w y
+ *  The network shall learn o1 = 3x - y, o2 = 3y - x, i.e. w = 3, v = -1.
+ *
+ *  \param  loops  Training loop count
+ *  \param  alpha  Learning factor
+ *  \param  sigma  Acceptable error
+ *
+ *  \return Count of errors
+ */
+static int test_backpropagation_shared(
+    size_t loops,
+    double alpha,
+    double sigma)
+{
+    std::cout << "NN backpropagation shared weights test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    nn_t nn;
+
+    nn_t::neuron & x  = nn.add_neuron(nn_t::neuron::INPUT);
+    nn_t::neuron & y  = nn.add_neuron(nn_t::neuron::INPUT);
+    nn_t::neuron & o1 = nn.add_neuron(nn_t::neuron::OUTPUT);
+    nn_t::neuron & o2 = nn.add_neuron(nn_t::neuron::OUTPUT);
+
+    const size_t w = nn.add_shared_weight(0.5);
+    const size_t v = nn.add_shared_weight(0.1);
+
+    nn.set_shared_dendrite(o1, x, w);
+    nn.set_shared_dendrite(o1, y, v);
+    nn.set_shared_dendrite(o2, x, v);
+    nn.set_shared_dendrite(o2, y, w);
+
+    backpropagation_t bprop(nn);
+
+    auto criterion = [alpha](double err_n2) -> double {
+        return alpha;
+    };
+
+    std::vector<std::pair<std::vector<double>, std::vector<double> > > set;
+    for (int i = -5; i <= 5; ++i) {
+        const double a = 0.3 * i, b = 0.7 - 0.2 * i;
+
+        set.emplace_back(
+            std::vector<double>({a, b}),
+            std::vector<double>({3*a - b, 3*b - a}));
+    }
+
+    double en2 = 0;
+    for (size_t i = 0; i < loops * 10; ++i) {
+        en2 = bprop(set, criterion);
+
+        if (en2 <= sigma) break;
+    }
+
+    std::cout
+        << "|err|^2 == " << en2
+        << ", w == " << nn.shared_weight(w)
+        << ", v == " << nn.shared_weight(v)
+        << std::endl;
+
+    if (!(std::abs(nn.shared_weight(w) - 3) < 1e-6 &&
+          std::abs(nn.shared_weight(v) + 1) < 1e-6))
+    {
+        std::cout << "Failed to learn" << std::endl;
+
+        ++error_cnt;
+    }
+
+    // The weights must have stayed shared
+    if (&o1.get_dendrite(x)->weight() != &o2.get_dendrite(y)->weight() ||
+        &o1.get_dendrite(y)->weight() != &o2.get_dendrite(x)->weight())
+    {
+        std::cout << "Weights are not shared any longer" << std::endl;
+
+        ++error_cnt;
+    }
+
+    // Shared weights don't cost the dendrites any extra storage
+    if (sizeof(nn_t::neuron::dendrite) != 2 * sizeof(void *)) {
+        std::cout
+            << "Dendrite takes " << sizeof(nn_t::neuron::dendrite)
+            << " B" << std::endl;
+
+        ++error_cnt;
+    }
+
+    // Moving the network must keep the dendrites bound to shared weights
+    nn_t moved(std::move(nn));
+    moved.shared_weight(w) = 2;
+    if (o1.get_dendrite(x)->weight() != 2 ||
+        o2.get_dendrite(y)->weight() != 2)
+    {
+        std::cout << "Shared weight lost by move" << std::endl;
+
+        ++error_cnt;
+    }
+
+    nn = std::move(moved);  // same memory resource
+    if (4 != nn.size() ||
+        &o1.get_dendrite(x)->weight() != &nn.shared_weight(w))
+    {
+        std::cout << "Shared weight lost by move assignment" << std::endl;
+
+        ++error_cnt;
+    }
+
+    // Moving between memory resources is refused
+    libnn::misc::monotonic_resource arena;
+    nn_t other(&arena);
+    try {
+        other = std::move(nn);
+
+        std::cout << "Move between memory resources allowed" << std::endl;
+
+        ++error_cnt;
+    }
+    catch (const std::logic_error & ex) {
+        std::cout << "Move between memory resources: " << ex.what()
+            << std::endl;
+    }
+
+    std::cout << "Network:" << std::endl << nn;
+
+    std::cout << "NN backpropagation shared weights test END" << std::endl;
+
+    return error_cnt;
+}
+
+
 /** Unit test */
 static int main_impl(int argc, char * const argv[]) {
     int exit_code = 64;  // pessimistic assumption
@@ -645,6 +870,12 @@ static int main_impl(int argc, char * const argv[]) {
         exit_code = test_backpropagation_batch_adaptive(loops, sigma);
         if (0 != exit_code) break;
 
+        exit_code = test_backpropagation_checkpointed(loops, alpha / 10);
+        if (0 != exit_code) break;
+
+        exit_code = test_backpropagation_shared(loops, alpha * 10, sigma);
+        if (0 != exit_code) break;
+
     } while (0);  // end of pragmatic loop
 
     std::cerr
@@ -0,0 +1,126 @@
+#ifndef libnn__unit_test__ml__common_hxx
+#define libnn__unit_test__ml__common_hxx
+
+/**
+ *  Common machine learning unit test definitions
+ *
+ *  \date    2026/10/18
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <libnn/math/util.hxx>
+
+#include <vector>
+#include <cstdlib>
+#include <cstddef>
+
+
+/** Inputs */
+typedef std::vector<std::vector<double> > inputs_t;
+
+
+/**
+ *  \brief  Create network
+ *
+ *  The weights are uniformly distributed in [-1, 1].
+ *  Networks created with the same \c seed are identical.
+ *
+ *  \tparam NN           Network type
+ *  \param  layers_spec  Layers specification
+ *  \param  features     Feature bits sum
+ *  \param  seed         Weight initialiser seed
+ *
+ *  \return Network
+ */
+template <class NN>
+NN create_nn(
+    const std::vector<size_t> & layers_spec,
+    int                         features,
+    unsigned                    seed = 1)
+{
+    ::srand(seed);
+
+    libnn::math::rng_uniform<double> w_init(-1, 1);
+    return NN(layers_spec, w_init, features);
+}
+
+
+/**
+ *  \brief  Create random vector
+ *
+ *  \param  size  Vector size
+ *  \param  min   Minimal value
+ *  \param  max   Maximal value
+ *
+ *  \return Vector of values in [min, max]
+ */
+inline std::vector<double> random_vector(
+    size_t size,
+    double min = 0,
+    double max = 1)
+{
+    libnn::math::rng_uniform<double> rng(min, max);
+
+    std::vector<double> v;
+    v.reserve(size);
+
+    for (size_t i = 0; i < size; ++i)
+        v.push_back(rng());
+
+    return v;
+}
+
+
+/**
+ *  \brief  Create random inputs
+ *
+ *  \param  cnt   Input count
+ *  \param  size  Input size
+ *
+ *  \return Inputs (values in [0, 1])
+ */
+inline inputs_t random_inputs(size_t cnt, size_t size) {
+    inputs_t inputs;
+    inputs.reserve(cnt);
+
+    for (size_t i = 0; i < cnt; ++i)
+        inputs.push_back(random_vector(size));
+
+    return inputs;
+}
+
+
+#endif  // end of #ifndef libnn__unit_test__ml__common_hxx
@@ -0,0 +1,324 @@
+/**
+ *  Data-parallel (multi-process) training unit test
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "config.hxx"
+
+#include "common.hxx"
+#include "../misc/run_ranks.hxx"
+
+#include <libnn/model/feed_forward.hxx>
+#include <libnn/ml/backpropagation.hxx>
+#include <libnn/ml/data_parallel.hxx>
+#include <libnn/misc/shm_allreduce.hxx>
+#include <libnn/math/sigmoid.hxx>
+
+#include <vector>
+#include <list>
+#include <string>
+#include <sstream>
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+#include <functional>
+#include <cmath>
+#include <cstdlib>
+
+extern "C" {
+#include <sys/types.h>
+#include <unistd.h>
+}
+
+
+/** Feed-forward network model */
+typedef libnn::model::feed_forward<double, libnn::math::logistic_fn<double> >
+    nn_t;
+
+/** Generic backpropagation */
+typedef libnn::ml::backpropagation<double, libnn::math::logistic_fn<double> >
+    backprop_t;
+
+/** All-reduce type */
+typedef libnn::misc::shm_allreduce<double> allreduce_t;
+
+/** Training set */
+typedef std::list<std::pair<std::vector<double>, std::vector<double> > >
+    set_t;
+
+
+/** Trainer */
+enum trainer_t {
+    LAYERED = 0,   /**< Dense backpropagation               */
+    GENERIC,       /**< Generic backpropagation             */
+    CHECKPOINTED,  /**< Checkpointed generic backpropagation */
+};  // end of enum trainer_t
+
+/** Trainer names */
+static const char * trainer_names[] = { "layered", "generic", "checkpointed" };
+
+
+/**
+ *  \brief  Create network
+ *
+ *  The generic backpropagation is used directly (without the bias
+ *  source hard fixation), so the network has no bias then.
+ *
+ *  \param  trainer  Trainer
+ *
+ *  \return Network
+ */
+static nn_t create_trainer_nn(trainer_t trainer) {
+    return create_nn<nn_t>(std::vector<size_t>({6, 10, 8, 3}),
+        GENERIC == trainer ? nn_t::LATERAL : nn_t::BIAS | nn_t::LATERAL);
+}
+
+
+/**
+ *  \brief  Create training set
+ *
+ *  \param  size  Set size
+ *
+ *  \return Training set (random inputs and outputs in [0, 1])
+ */
+static set_t create_set(size_t size) {
+    ::srand(2);
+
+    set_t set;
+    for (size_t i = 0; i < size; ++i)
+        set.emplace_back(random_vector(6), random_vector(3));
+
+    return set;
+}
+
+
+/**
+ *  \brief  Train network
+ *
+ *  \param  nn         Network
+ *  \param  trainer    Trainer
+ *  \param  set        Training set
+ *  \param  epochs     Epoch count
+ *  \param  allreduce  All-reduce (\c NULL means no data parallelism)
+ *
+ *  \return Error norm squared averages (per epoch)
+ */
+static std::vector<double> train(
+    nn_t        & nn,
+    trainer_t     trainer,
+    const set_t & set,
+    size_t        epochs,
+    allreduce_t * allreduce)
+{
+    libnn::ml::const_learning_factor<double> criterion(0, 0.5);
+
+    std::vector<double> errors;
+
+    if (GENERIC == trainer) {
+        backprop_t training(nn.topology());
+
+        if (allreduce) {
+            libnn::ml::data_parallel<double, backprop_t> dp(
+                training, *allreduce);
+
+            for (size_t i = 0; i < epochs; ++i)
+                errors.push_back(dp(set, criterion));
+        }
+        else
+            for (size_t i = 0; i < epochs; ++i)
+                errors.push_back(training(set, criterion));
+
+        return errors;
+    }
+
+    nn_t::training_t training = nn.training();
+    if (CHECKPOINTED == trainer) training.checkpoint(1);
+
+    if (allreduce) {
+        libnn::ml::data_parallel<double, nn_t::training_t> dp(
+            training, *allreduce);
+
+        for (size_t i = 0; i < epochs; ++i)
+            errors.push_back(dp(set, criterion));
+    }
+    else
+        for (size_t i = 0; i < epochs; ++i)
+            errors.push_back(training(set, criterion));
+
+    return errors;
+}
+
+
+/**
+ *  \brief  Data-parallel training test
+ *
+ *  Each rank (process) trains its replica of the network on its shard
+ *  of the training set; the replicas shall end up the same as a network
+ *  trained on the whole set by a single trainer.
+ *
+ *  \param  trainer    Trainer
+ *  \param  ranks      Rank count
+ *  \param  set_size   Training set size
+ *  \param  algorithm  All-reduce algorithm
+ *
+ *  \return Count of errors
+ */
+static int test_data_parallel(
+    trainer_t                trainer,
+    size_t                   ranks,
+    size_t                   set_size,
+    allreduce_t::algorithm_t algorithm)
+{
+    std::cout
+        << "Data-parallel training test (" << trainer_names[trainer] << ", "
+        << ranks << " ranks, " << set_size << " samples, "
+        << (allreduce_t::TREE == algorithm ? "tree" : "ring")
+        << ") BEGIN" << std::endl;
+
+    const size_t epochs = 20;
+    const set_t  set    = create_set(set_size);
+
+    // Reference (single trainer)
+    nn_t ref_nn = create_trainer_nn(trainer);
+    const std::vector<double> ref_errors = train(
+        ref_nn, trainer, set, epochs, NULL);
+
+    nn_t::function_t ref_fn = ref_nn.function();
+
+    std::vector<std::vector<double> > ref_outputs;
+    for (auto iter = set.begin(); iter != set.end(); ++iter)
+        ref_outputs.push_back(ref_fn(iter->first));
+
+    std::stringstream name;
+    name << "/libnn_ut_data_parallel_" << ::getpid();
+
+    int error_cnt = run_ranks(ranks, [&](size_t rank) {
+        allreduce_t allreduce(name.str(), ranks, rank, 100, algorithm);
+
+        nn_t nn = create_trainer_nn(trainer);
+        const std::vector<double> errors = train(
+            nn, trainer, set, epochs, &allreduce);
+
+        for (size_t i = 0; i < epochs; ++i)
+            if (std::abs(errors[i] - ref_errors[i]) > 1e-12) {
+                std::cout
+                    << "Rank " << rank << ", epoch " << i << ": error "
+                    << errors[i] << " (expected " << ref_errors[i] << ')'
+                    << std::endl;
+
+                return 1;
+            }
+
+        nn_t::function_t fn = nn.function();
+
+        size_t j = 0;
+        for (auto iter = set.begin(); iter != set.end(); ++iter, ++j) {
+            const std::vector<double> output = fn(iter->first);
+
+            for (size_t k = 0; k < output.size(); ++k)
+                if (std::abs(output[k] - ref_outputs[j][k]) > 1e-12) {
+                    std::cout
+                        << "Rank " << rank << ": output mismatch"
+                        << std::endl;
+
+                    return 1;
+                }
+        }
+
+        if (0 == rank)
+            std::cout
+                << "Error: " << ref_errors.front() << " -> "
+                << errors.back() << std::endl;
+
+        return 0;
+    });
+
+    std::cout << "Data-parallel training test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/** Unit test */
+static int main_impl(int argc, char * const argv[]) {
+    int exit_code = 64;  // pessimistic assumption
+
+    do {  // pragmatic do ... while (0) loop allowing for breaks
+        exit_code = 0;
+
+        for (int t = LAYERED; t <= CHECKPOINTED; ++t) {
+            const trainer_t trainer = (trainer_t)t;
+
+            exit_code += test_data_parallel(trainer, 1, 50, allreduce_t::RING);
+            exit_code += test_data_parallel(trainer, 3, 50, allreduce_t::RING);
+            exit_code += test_data_parallel(trainer, 3, 50, allreduce_t::TREE);
+
+            // Empty shard
+            exit_code += test_data_parallel(trainer, 4, 3, allreduce_t::RING);
+        }
+
+    } while (0);  // end of pragmatic loop
+
+    std::cerr
+        << "Exit code: " << exit_code
+        << std::endl;
+
+    return exit_code;
+}
+
+/** Unit test exception-safe wrapper */
+int main(int argc, char * const argv[]) {
+    int exit_code = 128;
+
+    try {
+        exit_code = main_impl(argc, argv);
+    }
+    catch (const std::exception & x) {
+        std::cerr
+            << "Standard exception caught: "
+            << x.what()
+            << std::endl;
+    }
+    catch (...) {
+        std::cerr
+            << "Unhandled non-standard exception caught"
+            << std::endl;
+    }
+
+    return exit_code;
+}
@@ -0,0 +1,3 @@
+#!/bin/sh
+
+./data_parallel
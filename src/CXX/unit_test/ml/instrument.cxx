@@ -0,0 +1,355 @@
+/**
+ *  Instrumentation counters unit test
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "config.hxx"
+
+#include <libnn/topo/nn.hxx>
+#include <libnn/ml/nn_func.hxx>
+#include <libnn/ml/backpropagation.hxx>
+#include <libnn/math/sigmoid.hxx>
+#include <libnn/misc/instrument.hxx>
+
+#include <vector>
+#include <thread>
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+#include <cstdint>
+#include <cstdlib>
+
+
+/** Neural network */
+typedef libnn::topo::nn<double, libnn::math::logistic_fn<double> > nn_t;
+
+/** Network function */
+typedef libnn::ml::nn_func<double, libnn::math::logistic_fn<double> >
+    nn_func_t;
+
+/** Backpropagation */
+typedef libnn::ml::backpropagation<double, libnn::math::logistic_fn<double> >
+    backprop_t;
+
+namespace instrument = libnn::misc::instrument;
+
+
+/**
+ *  \brief  Create 2-3-1 network
+ *
+ *  \param  nn  Network
+ */
+static void create_nn(nn_t & nn) {
+    nn_t::neuron & in1 = nn.add_neuron(nn_t::neuron::INPUT);
+    nn_t::neuron & in2 = nn.add_neuron(nn_t::neuron::INPUT);
+
+    nn_t::neuron & out = nn.add_neuron(nn_t::neuron::OUTPUT);
+
+    for (size_t i = 0; i < 3; ++i) {
+        nn_t::neuron & x = nn.add_neuron();
+
+        x.set_dendrite(in1, 0.1 * i);
+        x.set_dendrite(in2, 0.2 - 0.1 * i);
+        out.set_dendrite(x, 0.5);
+    }
+}
+
+
+/**
+ *  \brief  Check counter
+ *
+ *  \param  st        Stats
+ *  \param  counter   Counter
+ *  \param  expected  Expected value
+ *
+ *  \return Count of errors
+ */
+static int check(
+    const instrument::stats & st,
+    instrument::counter_t     counter,
+    uint64_t                  expected)
+{
+    std::cout
+        << instrument::name(counter) << ": " << st.count[counter]
+        << std::endl;
+
+    if (expected == st.count[counter]) return 0;
+
+    std::cout << "Expected " << expected << std::endl;
+
+    return 1;
+}
+
+
+/**
+ *  \brief  Check that there were allocations
+ *
+ *  The count depends on the standard library containers implementation.
+ *
+ *  \param  st  Stats
+ *
+ *  \return Count of errors
+ */
+static int check_allocs(const instrument::stats & st) {
+    std::cout
+        << instrument::name(instrument::ALLOCS) << ": "
+        << st.count[instrument::ALLOCS] << std::endl;
+
+    if (0 != st.count[instrument::ALLOCS]) return 0;
+
+    std::cout << "Expected allocations" << std::endl;
+
+    return 1;
+}
+
+
+/**
+ *  \brief  Check phase
+ *
+ *  Duration is measured iff phases are timed.
+ *
+ *  \param  st     Stats
+ *  \param  phase  Phase
+ *  \param  calls  Expected count of calls
+ *
+ *  \return Count of errors
+ */
+static int check(
+    const instrument::stats & st,
+    instrument::phase_t       phase,
+    uint64_t                  calls)
+{
+    std::cout
+        << instrument::name(phase) << ": " << st.calls[phase]
+        << " call(s), " << st.cycles[phase] << " cycles" << std::endl;
+
+    if (calls == st.calls[phase] &&
+        (0 == calls || !instrument::timed) == (0 == st.cycles[phase]))
+    {
+        return 0;
+    }
+
+    std::cout << "Expected " << calls << " call(s)" << std::endl;
+
+    return 1;
+}
+
+
+/** Network function counters test */
+static int test_nn_func() {
+    std::cout << "Network function counters test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    nn_t nn;
+    create_nn(nn);
+
+    instrument::reset();
+
+    nn_func_t func(nn);
+    func(std::vector<double>({0.5, 0.25}));
+    func(std::vector<double>({0.25, 0.5}));
+
+    instrument::stats st = instrument::get();
+
+    error_cnt += check(st, instrument::NEURON_EVALS, 8);
+    error_cnt += check(st, instrument::MULADDS,      18);
+    error_cnt += check(st, instrument::RESETS,       1);
+    error_cnt += check_allocs(st);
+
+    error_cnt += check(st, instrument::FORWARD,  2);
+    error_cnt += check(st, instrument::BACKWARD, 0);
+    error_cnt += check(st, instrument::UPDATE,   0);
+
+    // Evaluation reuses the computation memory
+    instrument::reset();
+
+    func(std::vector<double>({0.5, 0.5}));
+
+    st = instrument::get();
+
+    error_cnt += check(st, instrument::ALLOCS,  0);
+    error_cnt += check(st, instrument::FORWARD, 1);
+
+    std::cout << "Network function counters test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/** Backpropagation counters test */
+static int test_backprop() {
+    std::cout << "Backpropagation counters test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    nn_t nn;
+    create_nn(nn);
+
+    instrument::reset();
+
+    backprop_t bp(nn);
+    libnn::ml::const_learning_factor<double> criterion(0, 0.1);
+
+    bp(std::vector<double>({0.5, 0.25}), std::vector<double>({1}),
+        criterion);
+
+    instrument::stats st = instrument::get();
+
+    // forward: 4 evals, 9 muladds; backward: 5 evals, 9 muladds;
+    // update: 9 muladds
+    error_cnt += check(st, instrument::NEURON_EVALS, 9);
+    error_cnt += check(st, instrument::MULADDS,      27);
+    error_cnt += check(st, instrument::RESETS,       0);
+    error_cnt += check_allocs(st);
+
+    error_cnt += check(st, instrument::FORWARD,  1);
+    error_cnt += check(st, instrument::BACKWARD, 1);
+    error_cnt += check(st, instrument::UPDATE,   1);
+
+    // Training step reuses the computations memory
+    instrument::reset();
+
+    bp(std::vector<double>({0.25, 0.5}), std::vector<double>({0}),
+        criterion);
+
+    st = instrument::get();
+
+    error_cnt += check(st, instrument::ALLOCS, 0);
+    error_cnt += check(st, instrument::UPDATE, 1);
+
+    std::cout << "Backpropagation counters test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  Multi-threaded aggregation test
+ *
+ *  \param  thread_cnt  Count of threads
+ *  \param  eval_cnt    Count of evaluations per thread
+ *
+ *  \return Count of errors
+ */
+static int test_threads(size_t thread_cnt, size_t eval_cnt) {
+    std::cout << "Multi-threaded aggregation test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    nn_t nn;
+    create_nn(nn);
+
+    instrument::reset();
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < thread_cnt; ++i)
+        threads.emplace_back([&nn, eval_cnt]() {
+            nn_func_t func(nn);
+
+            for (size_t j = 0; j < eval_cnt; ++j)
+                func(std::vector<double>({0.5, (double)j / eval_cnt}));
+        });
+
+    for (size_t i = 0; i < thread_cnt; ++i) threads[i].join();
+
+    const instrument::stats st = instrument::get();
+
+    error_cnt += check(st, instrument::NEURON_EVALS, thread_cnt * eval_cnt * 4);
+    error_cnt += check(st, instrument::MULADDS,      thread_cnt * eval_cnt * 9);
+    error_cnt += check(st, instrument::RESETS, thread_cnt * (eval_cnt - 1));
+    error_cnt += check(st, instrument::FORWARD, thread_cnt * eval_cnt);
+
+    std::cout << "Multi-threaded aggregation test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/** Unit test */
+static int main_impl(int argc, char * const argv[]) {
+    int exit_code = 64;  // pessimistic assumption
+
+    size_t cnt = 10000;
+    if (1 < argc) cnt = ::atoi(argv[1]);
+
+    do {  // pragmatic do ... while (0) loop allowing for breaks
+        if (!instrument::enabled) {
+            std::cout << "Instrumentation is not compiled in" << std::endl;
+            break;
+        }
+
+        exit_code = test_nn_func();
+        if (0 != exit_code) break;
+
+        exit_code = test_backprop();
+        if (0 != exit_code) break;
+
+        exit_code = test_threads(4, cnt);
+        if (0 != exit_code) break;
+
+    } while (0);  // end of pragmatic loop
+
+    std::cerr
+        << "Exit code: " << exit_code
+        << std::endl;
+
+    return exit_code;
+}
+
+/** Unit test exception-safe wrapper */
+int main(int argc, char * const argv[]) {
+    int exit_code = 128;
+
+    try {
+        exit_code = main_impl(argc, argv);
+    }
+    catch (const std::exception & x) {
+        std::cerr
+            << "Standard exception caught: "
+            << x.what()
+            << std::endl;
+    }
+    catch (...) {
+        std::cerr
+            << "Unhandled non-standard exception caught"
+            << std::endl;
+    }
+
+    return exit_code;
+}
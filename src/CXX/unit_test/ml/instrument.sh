@@ -0,0 +1,7 @@
+#!/bin/sh
+
+# Counters of 4 threads x 10000 evaluations
+./instrument 10000 || exit $?
+
+# Ditto, with phases timing
+./instrument_phases 10000
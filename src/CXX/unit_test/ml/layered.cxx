@@ -0,0 +1,634 @@
+/**
+ *  Layered network evaluation unit test
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "config.hxx"
+
+#include "common.hxx"
+
+#include <libnn/model/feed_forward.hxx>
+#include <libnn/ml/layered.hxx>
+#include <libnn/ml/nn_func.hxx>
+#include <libnn/ml/backpropagation.hxx>
+#include <libnn/math/sigmoid.hxx>
+#include <libnn/misc/thread_pool.hxx>
+#include <libnn/io/binary.hxx>
+
+#include <vector>
+#include <list>
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <exception>
+#include <stdexcept>
+#include <chrono>
+#include <cmath>
+
+
+/** Feed-forward network model */
+typedef libnn::model::feed_forward<double, libnn::math::logistic_fn<double> >
+    nn_t;
+
+/** Training set */
+typedef std::list<std::pair<std::vector<double>, std::vector<double> > >
+    tset_t;
+
+
+/** Generic network function (with bias) */
+class generic_func:
+    public libnn::ml::nn_func<double, libnn::math::logistic_fn<double> >
+{
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  nn  Network
+     */
+    generic_func(const ::nn_t & nn):
+        libnn::ml::nn_func<double, libnn::math::logistic_fn<double> >(
+            nn.topology())
+    {
+        if (::nn_t::BIAS & nn.features()) this->const_fx(0, 1);
+    }
+
+};  // end of class generic_func
+
+
+/**
+ *  \brief  Maximal difference of 2 vectors
+ *
+ *  \param  v1  Vector
+ *  \param  v2  Vector
+ *
+ *  \return max |v1_i - v2_i|
+ */
+static double max_diff(
+    const std::vector<double> & v1,
+    const std::vector<double> & v2)
+{
+    if (v1.size() != v2.size())
+        throw std::logic_error("vector sizes differ");
+
+    double diff = 0;
+    for (size_t i = 0; i < v1.size(); ++i)
+        diff = std::max(diff, std::abs(v1[i] - v2[i]));
+
+    return diff;
+}
+
+
+/**
+ *  \brief  Synapses weights of a network
+ *
+ *  \param  nn  Network
+ *
+ *  \return Weights (neuron by neuron, dendrite by dendrite)
+ */
+static std::vector<double> weights(const nn_t & nn) {
+    std::vector<double> w;
+
+    nn.topology().for_each_neuron(
+    [&w](const nn_t::topo_t::neuron & n) {
+        n.for_each_dendrite(
+        [&w](const nn_t::topo_t::neuron::dendrite & dend) {
+            w.push_back(dend.weight());
+        });
+    });
+
+    return w;
+}
+
+
+/**
+ *  \brief  Layered evaluation test
+ *
+ *  Compares the dense evaluation with the generic one.
+ *
+ *  \param  features  Feature bits sum
+ *
+ *  \return Count of errors
+ */
+static int test_eval(int features) {
+    std::cout
+        << "Layered evaluation test (features 0x" << std::hex
+        << features << std::dec << ") BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    nn_t nn = create_nn<nn_t>(std::vector<size_t>({5, 7, 6, 3}), features, 1);
+
+    nn_t::function_t function = nn.function();
+
+    if (!function.layered()) {
+        std::cout << "Dense evaluation not used" << std::endl;
+
+        ++error_cnt;
+    }
+
+    generic_func generic(nn);
+
+    for (size_t i = 0; i < 10; ++i) {
+        const auto input = random_vector(5);
+
+        const auto output     = function(input);
+        const auto output_exp = generic(input);
+
+        const double diff = max_diff(output, output_exp);
+        if (diff > 1e-12) {
+            std::cout << "Output mismatch: " << diff << std::endl;
+
+            ++error_cnt;
+        }
+    }
+
+    std::cout << "Layered evaluation test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  Layered training test
+ *
+ *  Trains 2 identical networks, one by the dense backpropagation,
+ *  the other one by the generic backpropagation; the weights and
+ *  the input errors shall stay the same.
+ *
+ *  \param  features  Feature bits sum
+ *
+ *  \return Count of errors
+ */
+static int test_train(int features) {
+    std::cout
+        << "Layered training test (features 0x" << std::hex
+        << features << std::dec << ") BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    const std::vector<size_t> layers_spec({4, 6, 5, 3});
+
+    nn_t nn1 = create_nn<nn_t>(layers_spec, features, 2);
+    nn_t nn2 = create_nn<nn_t>(layers_spec, features, 2);
+
+    nn_t::training_t training1 = nn1.training();
+
+    libnn::ml::backpropagation<double, libnn::math::logistic_fn<double> >
+        training2(nn2.topology(), nn_t::fixations(features));
+
+    if (!training1.layered()) {
+        std::cout << "Dense backpropagation not used" << std::endl;
+
+        ++error_cnt;
+    }
+
+    tset_t set;
+    for (size_t i = 0; i < 8; ++i)
+        set.emplace_back(random_vector(4), random_vector(3));
+
+    libnn::ml::const_learning_factor<double> criterion(0, 0.5);
+
+    for (size_t loop = 0; loop < 20; ++loop) {
+        // On-line mode (with input error)
+        std::vector<double> in_err1, in_err2;
+
+        const auto & sample = set.front();
+
+        const double en2_1 = training1(
+            sample.first, sample.second, criterion, in_err1);
+        const double en2_2 = training2(
+            sample.first, sample.second, criterion, in_err2);
+
+        if (std::abs(en2_1 - en2_2) > 1e-12) {
+            std::cout
+                << "On-line error mismatch: " << en2_1
+                << " vs " << en2_2 << std::endl;
+
+            ++error_cnt;
+        }
+
+        if (max_diff(in_err1, in_err2) > 1e-12) {
+            std::cout << "On-line input error mismatch" << std::endl;
+
+            ++error_cnt;
+        }
+
+        // Batch mode (with input errors)
+        std::vector<std::vector<double> > in_errs1, in_errs2;
+
+        const double en2avg_1 = training1(set, criterion, in_errs1);
+        const double en2avg_2 = training2(set, criterion, in_errs2);
+
+        if (std::abs(en2avg_1 - en2avg_2) > 1e-12) {
+            std::cout
+                << "Batch error mismatch: " << en2avg_1
+                << " vs " << en2avg_2 << std::endl;
+
+            ++error_cnt;
+        }
+
+        for (size_t i = 0; i < in_errs1.size(); ++i)
+            if (max_diff(in_errs1[i], in_errs2[i]) > 1e-12) {
+                std::cout << "Batch input error mismatch" << std::endl;
+
+                ++error_cnt;
+            }
+
+        if (error_cnt) break;
+    }
+
+    const double diff = max_diff(weights(nn1), weights(nn2));
+
+    std::cout << "Weights difference: " << diff << std::endl;
+
+    if (diff > 1e-9) {
+        std::cout << "Weights mismatch" << std::endl;
+
+        ++error_cnt;
+    }
+
+    // Checkpointed mode falls back to the generic backpropagation
+    training1.checkpoint(1);
+    training2.checkpoint(1);
+
+    training1(set, criterion);
+    training2(set, criterion);
+
+    training1.checkpoint(0);
+    training2.checkpoint(0);
+
+    training1(set, criterion);
+    training2(set, criterion);
+
+    const double diff_ckpt = max_diff(weights(nn1), weights(nn2));
+
+    std::cout << "Weights difference: " << diff_ckpt << std::endl;
+
+    if (diff_ckpt > 1e-9) {
+        std::cout << "Weights mismatch (checkpointed mode)" << std::endl;
+
+        ++error_cnt;
+    }
+
+    std::cout << "Layered training test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  Weights tracking test
+ *
+ *  The network function (created before the training) shall follow
+ *  the network weights, no matter how they change; the dense training
+ *  shall not revert weights changed by other means.
+ *  A network trained by the generic backpropagation (and changed
+ *  the same way) serves as the reference.
+ *
+ *  \param  features  Feature bits sum
+ *
+ *  \return Count of errors
+ */
+static int test_live(int features) {
+    std::cout
+        << "Weights tracking test (features 0x" << std::hex
+        << features << std::dec << ") BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    const std::vector<size_t> layers_spec({4, 6, 5, 3});
+
+    nn_t nn1 = create_nn<nn_t>(layers_spec, features, 5);
+    nn_t nn2 = create_nn<nn_t>(layers_spec, features, 5);
+
+    nn_t::function_t function = nn1.function();
+    libnn::ml::nn_func<double, libnn::math::logistic_fn<double> > & base =
+        function;
+    generic_func generic(nn2);
+
+    nn_t::training_t training1 = nn1.training();
+
+    libnn::ml::backpropagation<double, libnn::math::logistic_fn<double> >
+        training2(nn2.topology(), nn_t::fixations(features));
+
+    tset_t set;
+    for (size_t i = 0; i < 8; ++i)
+        set.emplace_back(random_vector(4), random_vector(3));
+
+    const std::vector<double> input = random_vector(4);
+
+    libnn::ml::const_learning_factor<double> criterion(0, 0.5);
+
+    auto train = [&]() {
+        training1(set, criterion);
+        training2(set, criterion);
+
+        training1(set.front().first, set.front().second, criterion);
+        training2(set.front().first, set.front().second, criterion);
+    };
+
+    auto check = [&](const char * what, bool cmp_weights) {
+        const double diff_f = max_diff(function(input), generic(input));
+        const double diff_b = max_diff(base(input), generic(input));
+        const double diff_w = cmp_weights
+            ? max_diff(weights(nn1), weights(nn2)) : 0;
+
+        if (diff_f > 1e-9 || diff_b > 1e-9 || diff_w > 1e-9) {
+            std::cout
+                << what << ": function differs by " << diff_f
+                << ", via base by " << diff_b
+                << ", weights by " << diff_w << std::endl;
+
+            ++error_cnt;
+        }
+    };
+
+    for (size_t loop = 0; loop < 5; ++loop) {
+        train();
+        check("Training", true);
+    }
+
+    // Weights set via the training
+    std::vector<double> w;
+    training1.get_weights(w);
+    std::for_each(w.begin(), w.end(), [](double & x) { x *= 0.5; });
+
+    training1.set_weights(w);
+    training2.set_weights(w);
+    check("Weights set", true);
+
+    train();
+    check("Training after weights set", true);
+
+    // Weights changed directly
+    auto halve = [](nn_t::topo_t::neuron & n) {
+        n.for_each_dendrite([](nn_t::topo_t::neuron::dendrite & dend) {
+            dend.weight() *= 0.5;
+        });
+    };
+
+    nn1.topology().for_each_neuron(halve);
+    nn2.topology().for_each_neuron(halve);
+    check("Weights changed", true);
+
+    train();
+    check("Training after weights changed", true);
+
+    // Network loaded (synapses order may change, hence no weights check)
+    std::stringstream ss;
+    libnn::io::serialise_binary(ss, nn2);
+    libnn::io::deserialise_binary(ss, nn1);
+    check("Network loaded", false);
+
+    if (!function.layered() || !training1.layered()) {
+        std::cout << "Dense computation not used after load" << std::endl;
+
+        ++error_cnt;
+    }
+
+    train();
+    check("Training after network loaded", false);
+
+    std::cout << "Weights tracking test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  Parallel training test
+ *
+ *  Trains 2 identical networks by batches, one using a thread pool;
+ *  the weights shall stay the same.
+ *
+ *  \param  features  Feature bits sum
+ *
+ *  \return Count of errors
+ */
+static int test_parallel(int features) {
+    std::cout
+        << "Parallel training test (features 0x" << std::hex
+        << features << std::dec << ") BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    const std::vector<size_t> layers_spec({32, 64, 64, 8});
+
+    nn_t nn1 = create_nn<nn_t>(layers_spec, features, 4);
+    nn_t nn2 = create_nn<nn_t>(layers_spec, features, 4);
+
+    libnn::misc::thread_pool pool(3);
+
+    nn_t::training_t training1 = nn1.training();
+    nn_t::training_t training2 = nn2.training();
+
+    training1.executor(&pool);
+
+    tset_t set;
+    for (size_t i = 0; i < 256; ++i)
+        set.emplace_back(random_vector(32), random_vector(8));
+
+    libnn::ml::const_learning_factor<double> criterion(0, 0.5);
+
+    for (size_t loop = 0; loop < 5; ++loop) {
+        std::vector<std::vector<double> > in_errs1, in_errs2;
+
+        const double en2avg_1 = training1(set, criterion, in_errs1);
+        const double en2avg_2 = training2(set, criterion, in_errs2);
+
+        if (std::abs(en2avg_1 - en2avg_2) > 1e-9) {
+            std::cout
+                << "Batch error mismatch: " << en2avg_1
+                << " vs " << en2avg_2 << std::endl;
+
+            ++error_cnt;
+        }
+
+        for (size_t i = 0; i < in_errs1.size(); ++i)
+            if (max_diff(in_errs1[i], in_errs2[i]) > 1e-9) {
+                std::cout << "Batch input error mismatch" << std::endl;
+
+                ++error_cnt;
+                break;
+            }
+    }
+
+    const double diff = max_diff(weights(nn1), weights(nn2));
+
+    std::cout << "Weights difference: " << diff << std::endl;
+
+    if (diff > 1e-9) {
+        std::cout << "Weights mismatch" << std::endl;
+
+        ++error_cnt;
+    }
+
+    std::cout << "Parallel training test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  Evaluation speed
+ *
+ *  \param  features  Feature bits sum
+ *  \param  cnt       Evaluation count
+ *
+ *  \return Dense and generic evaluation times per sample (ns)
+ */
+static std::pair<double, double> eval_speed(int features, size_t cnt) {
+    typedef std::chrono::steady_clock clock_t;
+
+    nn_t nn = create_nn<nn_t>(
+        std::vector<size_t>({32, 64, 64, 8}), features, 3);
+
+    nn_t::function_t function = nn.function();
+
+    generic_func generic(nn);
+
+    const auto input = random_vector(32);
+
+    double sum = 0;  // prevents the computation elimination
+
+    const auto t0 = clock_t::now();
+    for (size_t i = 0; i < cnt; ++i) sum += function(input)[0];
+
+    const auto t1 = clock_t::now();
+    for (size_t i = 0; i < cnt; ++i) sum -= generic(input)[0];
+
+    const auto t2 = clock_t::now();
+
+    if (std::abs(sum) > 1e-9 * cnt)
+        throw std::logic_error("evaluation results differ");
+
+    return std::pair<double, double>(
+        std::chrono::duration<double, std::nano>(t1 - t0).count() / cnt,
+        std::chrono::duration<double, std::nano>(t2 - t1).count() / cnt);
+}
+
+
+/**
+ *  \brief  Evaluation speed report
+ *
+ *  Lateral networks shall be evaluated at a speed comparable with
+ *  the dense ones.
+ *  The times are only reported (they depend on the machine load).
+ *
+ *  \param  cnt  Evaluation count
+ *
+ *  \return Count of errors
+ */
+static int test_speed(size_t cnt) {
+    std::cout << "Evaluation speed test BEGIN" << std::endl;
+
+    const auto dense   = eval_speed(nn_t::BIAS, cnt);
+    const auto lateral = eval_speed(nn_t::BIAS | nn_t::LATERAL, cnt);
+
+    std::cout
+        << "Dense network:   " << dense.first << " ns/sample (generic "
+        << dense.second << " ns/sample)" << std::endl
+        << "Lateral network: " << lateral.first << " ns/sample (generic "
+        << lateral.second << " ns/sample)" << std::endl;
+
+    std::cout << "Evaluation speed test END" << std::endl;
+
+    return 0;
+}
+
+
+/** Unit test */
+static int main_impl(int argc, char * const argv[]) {
+    int exit_code = 64;  // pessimistic assumption
+
+    size_t cnt = 1000;
+    if (1 < argc) cnt = ::atoi(argv[1]);
+
+    do {  // pragmatic do ... while (0) loop allowing for breaks
+        exit_code = test_eval(nn_t::NONE);
+        if (0 != exit_code) break;
+
+        exit_code = test_eval(nn_t::BIAS | nn_t::LATERAL);
+        if (0 != exit_code) break;
+
+        exit_code = test_train(nn_t::BIAS);
+        if (0 != exit_code) break;
+
+        exit_code = test_train(nn_t::BIAS | nn_t::LATERAL);
+        if (0 != exit_code) break;
+
+        exit_code = test_live(nn_t::BIAS | nn_t::LATERAL);
+        if (0 != exit_code) break;
+
+        exit_code = test_parallel(nn_t::BIAS | nn_t::LATERAL);
+        if (0 != exit_code) break;
+
+        exit_code = test_speed(cnt);
+        if (0 != exit_code) break;
+
+    } while (0);  // end of pragmatic loop
+
+    std::cerr
+        << "Exit code: " << exit_code
+        << std::endl;
+
+    return exit_code;
+}
+
+/** Unit test exception-safe wrapper */
+int main(int argc, char * const argv[]) {
+    int exit_code = 128;
+
+    try {
+        exit_code = main_impl(argc, argv);
+    }
+    catch (const std::exception & x) {
+        std::cerr
+            << "Standard exception caught: "
+            << x.what()
+            << std::endl;
+    }
+    catch (...) {
+        std::cerr
+            << "Unhandled non-standard exception caught"
+            << std::endl;
+    }
+
+    return exit_code;
+}
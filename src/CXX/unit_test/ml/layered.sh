@@ -0,0 +1,5 @@
+#!/bin/sh
+
+# Both BLAS backends (the external one if configured)
+LIBNN_BLAS=internal ./layered || exit $?
+./layered
@@ -0,0 +1,130 @@
+#ifndef libnn__unit_test__ml__linear_hxx
+#define libnn__unit_test__ml__linear_hxx
+
+/**
+ *  Linear network machine learning unit test definitions
+ *
+ *  \date    2026/10/18
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <libnn/topo/nn.hxx>
+#include <libnn/ml/nn_func.hxx>
+#include <libnn/ml/backpropagation.hxx>
+
+#include <vector>
+#include <utility>
+#include <cstddef>
+
+
+/** Identity activation functor */
+template <typename Base_t>
+class identity {
+    public:
+
+    /** Identity function */
+    Base_t operator () (const Base_t & x) const { return x; }
+
+    /** Identity derivation (i.e. 1) */
+    Base_t d(const Base_t & x) const { return 1; }
+
+};  // end of template class identity
+
+/** Simple linear neural network model */
+typedef libnn::topo::nn<double, identity<double> > nn_t;
+
+/** Simple linear neural network backpropagation algorithm */
+typedef libnn::ml::backpropagation<double, identity<double> >
+    backpropagation_t;
+
+/** Simple linear neural network function */
+typedef libnn::ml::nn_func<double, identity<double> > nn_func_t;
+
+/** Training set */
+typedef std::vector<std::pair<std::vector<double>, std::vector<double> > >
+    training_set_t;
+
+
+
+
+/**
+ *  \brief  Create deep linear network
+ *
+ *  Fully connected layers.
+ *  If \c shared is set, every other neuron shares the weight
+ *  of its first dendrite.
+ *
+ *  \param  nn             Network
+ *  \param  layers         Layer sizes
+ *  \param  shared         Share weights
+ *  \param  shared_weight  Shared weight initial value
+ */
+inline void create_deep_nn(
+    nn_t                      & nn,
+    const std::vector<size_t> & layers,
+    bool                        shared        = false,
+    double                      shared_weight = 0.1)
+{
+    std::vector<nn_t::neuron *> prev_layer;
+
+    for (size_t i = 0; i < layers.size(); ++i) {
+        nn_t::neuron::type_t type =
+            0 == i                 ? nn_t::neuron::INPUT  :
+            layers.size() - 1 == i ? nn_t::neuron::OUTPUT :
+                                     nn_t::neuron::INNER;
+
+        const size_t shared_ix =
+            shared ? nn.add_shared_weight(shared_weight) : 0;
+
+        std::vector<nn_t::neuron *> layer;
+        for (size_t j = 0; j < layers[i]; ++j) {
+            nn_t::neuron & n = nn.add_neuron(type);
+
+            for (size_t k = 0; k < prev_layer.size(); ++k)
+                if (shared && 0 == k && j % 2)
+                    nn.set_shared_dendrite(n, *prev_layer[k], shared_ix);
+                else
+                    n.set_dendrite(*prev_layer[k], 0.1 * (1 + (j + k) % 3));
+
+            layer.push_back(&n);
+        }
+
+        prev_layer = layer;
+    }
+}
+
+
+#endif  // end of #ifndef libnn__unit_test__ml__linear_hxx
@@ -0,0 +1,327 @@
+/**
+ *  Memory usage accounting unit test
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "config.hxx"
+
+#include "linear.hxx"
+
+#include <libnn/topo/nn.hxx>
+#include <libnn/ml/nn_func.hxx>
+#include <libnn/ml/backpropagation.hxx>
+#include <libnn/misc/memory_usage.hxx>
+
+#include <vector>
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+#include <new>
+#include <cstdlib>
+#include <cstddef>
+
+
+/** Allocation header size (keeps the allocated memory aligned) */
+static const size_t header_size = alignof(std::max_align_t);
+
+/** Live (allocated and not freed) memory (bytes) */
+static size_t live_bytes = 0;
+
+/** \cond */
+void * operator new (size_t size) {
+    char * ptr = (char *)::malloc(header_size + size);
+    if (NULL == ptr) throw std::bad_alloc();
+
+    *(size_t *)ptr = size;
+    live_bytes += size;
+
+    return ptr + header_size;
+}
+
+// Not inlined: GCC would see the header offset into an inlined
+// allocation and raise a spurious -Warray-bounds
+__attribute__((noinline))
+void operator delete (void * ptr) noexcept {
+    if (NULL == ptr) return;
+
+    char * base = (char *)ptr - header_size;
+    live_bytes -= *(size_t *)base;
+
+    ::free(base);
+}
+
+void operator delete (void * ptr, size_t) noexcept { operator delete(ptr); }
+/** \endcond */
+
+
+/**
+ *  \brief  Check reported memory usage
+ *
+ *  \param  what      Object description
+ *  \param  usage     Reported memory usage
+ *  \param  measured  Measured memory usage
+ *
+ *  \return Count of errors
+ */
+static int check_usage(
+    const char                       * what,
+    const libnn::misc::memory_usage  & usage,
+    size_t                             measured)
+{
+    std::cout
+        << what << " memory usage: "
+        << "neurons: "     << usage.neurons
+        << ", dendrites: " << usage.dendrites
+        << ", fmap: "      << usage.fmap
+        << ", results: "   << usage.results
+        << ", optimiser: " << usage.optimiser
+        << ", total: "     << usage.total()
+        << " B (measured: " << measured << " B)"
+        << std::endl;
+
+    if (usage.total() == measured) return 0;
+
+    std::cout << what << " memory usage mismatch" << std::endl;
+
+    return 1;
+}
+
+
+/**
+ *  \brief  Network memory usage test
+ *
+ *  \param  layers  Layer sizes
+ *
+ *  \return Count of errors
+ */
+static int test_nn(const std::vector<size_t> & layers) {
+    std::cout << "Network memory usage test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    const size_t live = live_bytes;
+    {
+        nn_t nn;
+        create_deep_nn(nn, layers, true);
+
+        error_cnt += check_usage("Network", nn.memory_usage(),
+            live_bytes - live);
+
+        // Remove a neuron
+        nn.remove_neuron(nn.get_neuron(layers[0]));
+
+        error_cnt += check_usage("Pruned network", nn.memory_usage(),
+            live_bytes - live);
+    }
+
+    if (live != live_bytes) {
+        std::cout << "Network memory leaked" << std::endl;
+
+        ++error_cnt;
+    }
+
+    std::cout << "Network memory usage test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  Computation memory usage test
+ *
+ *  \param  layers  Layer sizes
+ *
+ *  \return Count of errors
+ */
+static int test_computation(const std::vector<size_t> & layers) {
+    std::cout << "Computation memory usage test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    nn_t nn;
+    create_deep_nn(nn, layers, true);
+
+    const std::vector<double> input(layers.front(), 0.5);
+
+    const size_t live = live_bytes;
+    {
+        nn_func_t nn_func(nn);
+
+        error_cnt += check_usage("Computation", nn_func.memory_usage(),
+            live_bytes - live);
+
+        nn_func(input);  // the output is freed
+
+        error_cnt += check_usage("Evaluated computation",
+            nn_func.memory_usage(), live_bytes - live);
+    }
+
+    std::cout << "Computation memory usage test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  Backpropagation memory usage test
+ *
+ *  \param  layers  Layer sizes
+ *  \param  ckpt    Checkpoint interval (0 means no checkpointing)
+ *
+ *  \return Count of errors
+ */
+static int test_backpropagation(
+    const std::vector<size_t> & layers,
+    size_t                      ckpt)
+{
+    std::cout
+        << "Backpropagation memory usage test (checkpoint interval "
+        << ckpt << ") BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    nn_t nn;
+    create_deep_nn(nn, layers, true);
+
+    training_set_t set;
+    for (int i = 1; i <= 10; ++i)
+        set.emplace_back(
+            std::vector<double>(layers.front(), 0.1 * i),
+            std::vector<double>(layers.back(),  0.2 * i));
+
+    auto criterion = [](double err_n2) -> double { return 0.01; };
+
+    const size_t live = live_bytes;
+    {
+        backpropagation_t bprop(nn);
+
+        if (ckpt) bprop.checkpoint(ckpt);
+
+        error_cnt += check_usage("Backpropagation", bprop.memory_usage(),
+            live_bytes - live);
+
+        bprop(set.front().first, set.front().second, criterion);
+
+        error_cnt += check_usage("On-line backpropagation",
+            bprop.memory_usage(), live_bytes - live);
+
+        bprop(set, criterion);
+
+        error_cnt += check_usage("Batch backpropagation",
+            bprop.memory_usage(), live_bytes - live);
+
+        std::vector<double> grad;
+        bprop.gradient(set, grad);
+
+        error_cnt += check_usage("Gradient computation",
+            bprop.memory_usage(),
+            live_bytes - live - libnn::misc::heap_size(grad));
+
+        const libnn::misc::memory_usage usage =
+            bprop.memory_usage() + nn.memory_usage();
+
+        if (!(usage.neurons && usage.dendrites && usage.fmap &&
+            usage.results && usage.optimiser))
+        {
+            std::cout << "Memory usage breakdown incomplete" << std::endl;
+
+            ++error_cnt;
+        }
+    }
+
+    if (live != live_bytes) {
+        std::cout << "Backpropagation memory leaked" << std::endl;
+
+        ++error_cnt;
+    }
+
+    std::cout << "Backpropagation memory usage test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/** Unit test */
+static int main_impl(int argc, char * const argv[]) {
+    int exit_code = 64;  // pessimistic assumption
+
+    const std::vector<size_t> layers({8, 16, 16, 16, 4});
+
+    do {  // pragmatic do ... while (0) loop allowing for breaks
+        exit_code = test_nn(layers);
+        if (0 != exit_code) break;
+
+        exit_code = test_computation(layers);
+        if (0 != exit_code) break;
+
+        exit_code = test_backpropagation(layers, 0);
+        if (0 != exit_code) break;
+
+        exit_code = test_backpropagation(layers, 2);
+        if (0 != exit_code) break;
+
+    } while (0);  // end of pragmatic loop
+
+    std::cerr
+        << "Exit code: " << exit_code
+        << std::endl;
+
+    return exit_code;
+}
+
+/** Unit test exception-safe wrapper */
+int main(int argc, char * const argv[]) {
+    int exit_code = 128;
+
+    try {
+        exit_code = main_impl(argc, argv);
+    }
+    catch (const std::exception & x) {
+        std::cerr
+            << "Standard exception caught: "
+            << x.what()
+            << std::endl;
+    }
+    catch (...) {
+        std::cerr
+            << "Unhandled non-standard exception caught"
+            << std::endl;
+    }
+
+    return exit_code;
+}
@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# Memory usage accounting (against allocations counting)
+./memory_usage
@@ -0,0 +1,363 @@
+/**
+ *  Micro-batching unit test
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "config.hxx"
+
+#include "common.hxx"
+
+#include <libnn/model/feed_forward.hxx>
+#include <libnn/ml/micro_batch.hxx>
+#include <libnn/math/sigmoid.hxx>
+
+#include <vector>
+#include <future>
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+
+
+/** Feed-forward network model */
+typedef libnn::model::feed_forward<double, libnn::math::logistic_fn<double> >
+    nn_t;
+
+
+/**
+ *  \brief  Batch size recording function
+ *
+ *  Wraps network function; records the maximal batch size.
+ */
+class recording_fn {
+    private:
+
+    nn_t::function_t    m_fn;         /**< Network function   */
+    std::atomic<size_t> m_max_batch;  /**< Maximal batch size */
+
+    public:
+
+    /** Constructor */
+    recording_fn(const nn_t & nn): m_fn(nn.function()), m_max_batch(0) {}
+
+    /** Maximal batch size */
+    size_t max_batch() const { return m_max_batch; }
+
+    /** Batch evaluation */
+    inputs_t batch(const inputs_t & inputs) {
+        if (inputs.size() > m_max_batch) m_max_batch = inputs.size();
+
+        return m_fn.batch(inputs);
+    }
+
+};  // end of class recording_fn
+
+/** Micro-batcher */
+typedef libnn::ml::micro_batcher<double, recording_fn> batcher_t;
+
+
+/**
+ *  \brief  Concurrent requests test
+ *
+ *  Many threads submit single requests; the results must match
+ *  the network function and the requests must be batched (obeying
+ *  the maximal batch size).
+ *
+ *  \param  threads  Submitter thread count
+ *  \param  cnt      Requests per thread
+ *
+ *  \return Count of errors
+ */
+static int test_concurrent(size_t threads, size_t cnt) {
+    std::cout << "Micro-batching concurrent test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    nn_t nn = create_nn<nn_t>(std::vector<size_t>({16, 32, 4}), nn_t::BIAS);
+
+    nn_t::function_t function = nn.function();
+    recording_fn     fn(nn);
+
+    const inputs_t inputs = random_inputs(threads * cnt, 16);
+
+    inputs_t expected;  // the function isn't re-entrant
+    for (size_t i = 0; i < inputs.size(); ++i)
+        expected.push_back(function(inputs[i]));
+
+    batcher_t batcher(fn, 6, batcher_t::window_t(2000));
+
+    std::atomic<size_t> mismatches(0);
+    std::vector<std::thread> submitters;
+
+    for (size_t t = 0; t < threads; ++t)
+        submitters.emplace_back([&, t]() {
+            for (size_t i = t * cnt; i < (t + 1) * cnt; ++i) {
+                const std::vector<double> out = batcher(inputs[i]);
+                const std::vector<double> & exp = expected[i];
+
+                for (size_t j = 0; j < exp.size(); ++j)
+                    if (std::abs(exp[j] - out.at(j)) > 1e-12) {
+                        ++mismatches;
+                        break;
+                    }
+            }
+        });
+
+    for (size_t t = 0; t < threads; ++t) submitters[t].join();
+
+    const batcher_t::stats st = batcher.statistics();
+
+    std::cout
+        << "Requests: " << st.requests << ", batches: " << st.batches
+        << " (avg. size " << st.batch_avg << ", max. "
+        << fn.max_batch() << ")" << std::endl
+        << "Latency: p50 " << st.latency_p50 * 1000 << " ms, p99 "
+        << st.latency_p99 * 1000 << " ms, max "
+        << st.latency_max * 1000 << " ms" << std::endl
+        << "Throughput: " << st.throughput << " req/s" << std::endl;
+
+    if (mismatches) {
+        std::cout << "Outputs mismatch: " << mismatches << std::endl;
+
+        ++error_cnt;
+    }
+
+    if (st.requests != threads * cnt) {
+        std::cout << "Unexpected request count" << std::endl;
+
+        ++error_cnt;
+    }
+
+    if (!(st.batch_avg > 1)) {
+        std::cout << "Requests were not batched" << std::endl;
+
+        ++error_cnt;
+    }
+
+    if (fn.max_batch() > batcher.max_batch()) {
+        std::cout << "Maximal batch size exceeded" << std::endl;
+
+        ++error_cnt;
+    }
+
+    std::cout << "Micro-batching concurrent test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  Window test
+ *
+ *  Single request is delayed by the window (and not much more);
+ *  request with invalid input fails.
+ *
+ *  \return Count of errors
+ */
+static int test_window() {
+    std::cout << "Micro-batching window test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    nn_t nn = create_nn<nn_t>(std::vector<size_t>({4, 8, 2}), nn_t::BIAS);
+
+    recording_fn fn(nn);
+    batcher_t batcher(fn, 64, batcher_t::window_t(20000));
+
+    const auto t0 = std::chrono::steady_clock::now();
+    batcher(std::vector<double>(4, 0.5));
+
+    const double time = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - t0).count();
+
+    std::cout << "Single request latency: " << time * 1000 << " ms"
+        << std::endl;
+
+    if (time < 0.019) {
+        std::cout << "Request wasn't delayed by the window" << std::endl;
+
+        ++error_cnt;
+    }
+
+    try {
+        batcher(std::vector<double>(3, 0.5));
+
+        std::cout << "Invalid input evaluated" << std::endl;
+
+        ++error_cnt;
+    }
+    catch (const std::exception & x) {
+        std::cout << "Invalid input failed: " << x.what() << std::endl;
+    }
+
+    batcher.stop();
+
+    try {
+        batcher.submit(std::vector<double>(4, 0.5));
+
+        std::cout << "Request submitted after stop" << std::endl;
+
+        ++error_cnt;
+    }
+    catch (const std::logic_error & ) {}
+
+    std::cout << "Micro-batching window test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  Invalid request test
+ *
+ *  Request with invalid input batched with valid ones fails alone.
+ *
+ *  \return Count of errors
+ */
+static int test_invalid() {
+    std::cout << "Micro-batching invalid request test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    nn_t nn = create_nn<nn_t>(std::vector<size_t>({4, 8, 2}), nn_t::BIAS, 2);
+
+    nn_t::function_t function = nn.function();
+    recording_fn     fn(nn);
+
+    batcher_t batcher(fn, 64, batcher_t::window_t(20000));
+
+    const inputs_t inputs = random_inputs(10, 4);
+
+    std::vector<std::future<std::vector<double> > > results;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        if (5 == i)  // the invalid one
+            results.push_back(batcher.submit(std::vector<double>(3, 0.5)));
+
+        results.push_back(batcher.submit(inputs[i]));
+    }
+
+    for (size_t i = 0, j = 0; i < results.size(); ++i) {
+        try {
+            const std::vector<double> out = results[i].get();
+
+            if (5 == i) {
+                std::cout << "Invalid input evaluated" << std::endl;
+
+                ++error_cnt;
+                continue;
+            }
+
+            if (out != function(inputs[j++])) {
+                std::cout << "Output " << i << " mismatch" << std::endl;
+
+                ++error_cnt;
+            }
+        }
+        catch (const std::exception & x) {
+            if (5 == i) continue;
+
+            std::cout << "Request " << i << " failed: " << x.what()
+                << std::endl;
+
+            ++error_cnt;
+            ++j;
+        }
+    }
+
+    if (fn.max_batch() < 2) {
+        std::cout << "Requests were not batched" << std::endl;
+
+        ++error_cnt;
+    }
+
+    std::cout << "Micro-batching invalid request test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/** Unit test */
+static int main_impl(int argc, char * const argv[]) {
+    int exit_code = 64;  // pessimistic assumption
+
+    size_t cnt = 200;
+    if (1 < argc) cnt = ::atoi(argv[1]);
+
+    do {  // pragmatic do ... while (0) loop allowing for breaks
+        exit_code = test_concurrent(8, cnt);
+        if (0 != exit_code) break;
+
+        exit_code = test_window();
+        if (0 != exit_code) break;
+
+        exit_code = test_invalid();
+        if (0 != exit_code) break;
+
+    } while (0);  // end of pragmatic loop
+
+    std::cerr
+        << "Exit code: " << exit_code
+        << std::endl;
+
+    return exit_code;
+}
+
+/** Unit test exception-safe wrapper */
+int main(int argc, char * const argv[]) {
+    int exit_code = 128;
+
+    try {
+        exit_code = main_impl(argc, argv);
+    }
+    catch (const std::exception & x) {
+        std::cerr
+            << "Standard exception caught: "
+            << x.what()
+            << std::endl;
+    }
+    catch (...) {
+        std::cerr
+            << "Unhandled non-standard exception caught"
+            << std::endl;
+    }
+
+    return exit_code;
+}
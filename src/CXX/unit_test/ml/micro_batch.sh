@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# Correctness tests (8 threads x 200 requests)
+./micro_batch 200
@@ -0,0 +1,305 @@
+/**
+ *  NUMA-aware network function unit test
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "config.hxx"
+
+#include "common.hxx"
+
+#include <libnn/model/feed_forward.hxx>
+#include <libnn/ml/numa.hxx>
+#include <libnn/ml/backpropagation.hxx>
+#include <libnn/misc/numa.hxx>
+#include <libnn/math/sigmoid.hxx>
+
+#include <vector>
+#include <list>
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+
+
+/** Feed-forward network model */
+typedef libnn::model::feed_forward<double, libnn::math::logistic_fn<double> >
+    nn_t;
+
+
+/**
+ *  \brief  Check outputs
+ *
+ *  \param  expected  Reference outputs
+ *  \param  outputs   Outputs
+ *
+ *  \return \c true iff the outputs match the reference outputs
+ */
+static bool check(const inputs_t & expected, const inputs_t & outputs) {
+    if (expected.size() != outputs.size()) return false;
+
+    for (size_t i = 0; i < expected.size(); ++i) {
+        const std::vector<double> & exp = expected[i];
+
+        if (exp.size() != outputs[i].size()) return false;
+
+        for (size_t j = 0; j < exp.size(); ++j)
+            if (std::abs(exp[j] - outputs[i][j]) > 1e-12) return false;
+    }
+
+    return true;
+}
+
+
+/**
+ *  \brief  NUMA function test
+ *
+ *  Compares the NUMA function outputs with the layered function ones,
+ *  before and after the network is trained and the function reloaded
+ *  (while being used by another thread).
+ *
+ *  \return Count of errors
+ */
+static int test_numa() {
+    std::cout << "NUMA function test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    nn_t nn = create_nn<nn_t>(std::vector<size_t>({16, 24, 24, 4}),
+        nn_t::BIAS | nn_t::LATERAL);
+
+    nn_t::numa_function_t numa_fn = nn.numa_function(2);
+    nn_t::function_t      function = nn.function();
+
+    const inputs_t inputs = random_inputs(100, 16);
+
+    // Reference outputs (the function follows the network weights)
+    const inputs_t untrained = function.batch(inputs);
+
+    if (!check(untrained, numa_fn.batch(inputs))) {
+        std::cout << "Batch outputs mismatch" << std::endl;
+
+        ++error_cnt;
+    }
+
+    inputs_t outputs;
+    for (size_t i = 0; i < inputs.size(); ++i)
+        outputs.push_back(numa_fn(inputs[i]));
+
+    if (!check(untrained, outputs)) {
+        std::cout << "Outputs mismatch" << std::endl;
+
+        ++error_cnt;
+    }
+
+    // Evaluations running during the training and reload
+    std::atomic<bool>   stop(false);
+    std::atomic<size_t> evals(0);
+    std::thread user([&]() {
+        while (!stop) {
+            numa_fn.batch(inputs);
+            ++evals;
+        }
+    });
+
+    std::list<std::pair<std::vector<double>, std::vector<double> > > set;
+    for (size_t i = 0; i < 20; ++i)
+        set.emplace_back(inputs[i], std::vector<double>(4, 0.5));
+
+    libnn::ml::const_learning_factor<double> criterion(0, 0.5);
+
+    nn_t::training_t training = nn.training();
+    for (size_t i = 0; i < 10; ++i) training(set, criterion);
+
+    // Not reloaded yet; old weights are used
+    if (!check(untrained, numa_fn.batch(inputs))) {
+        std::cout << "Outputs changed before reload" << std::endl;
+
+        ++error_cnt;
+    }
+
+    numa_fn.reload();
+
+    stop = true;
+    user.join();
+
+    std::cout << "Concurrent batches: " << evals << std::endl;
+
+    if (!check(function.batch(inputs), numa_fn.batch(inputs))) {
+        std::cout << "Outputs mismatch after reload" << std::endl;
+
+        ++error_cnt;
+    }
+
+    std::cout << "NUMA function test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  Throughput
+ *
+ *  \param  numa_fn  NUMA function
+ *  \param  inputs   Inputs batch
+ *
+ *  \return Samples per second
+ */
+static double throughput(
+    const nn_t::numa_function_t & numa_fn,
+    const inputs_t              & inputs)
+{
+    typedef std::chrono::steady_clock clock_t;
+
+    size_t batches = 0;
+
+    const auto t0 = clock_t::now();
+    auto t1 = t0;
+
+    do {
+        numa_fn.batch(inputs);
+
+        ++batches;
+        t1 = clock_t::now();
+    } while (std::chrono::duration<double>(t1 - t0).count() < 0.3);
+
+    return batches * inputs.size()
+        / std::chrono::duration<double>(t1 - t0).count();
+}
+
+
+/**
+ *  \brief  Scaling benchmark
+ *
+ *  Reports throughput of replicated and shared (1st node) weights
+ *  for increasing worker counts per node.
+ *  The times are only reported (they depend on the machine).
+ *
+ *  \param  batch  Batch size
+ *
+ *  \return Count of errors
+ */
+static int bench_numa(size_t batch) {
+    std::cout << "NUMA scaling benchmark BEGIN" << std::endl;
+
+    const std::vector<int> nodes = libnn::misc::numa::nodes();
+
+    std::cout
+        << "NUMA " << (libnn::misc::numa::available() ? "" : "not ")
+        << "available, " << nodes.size() << " node(s):";
+
+    for (size_t i = 0; i < nodes.size(); ++i)
+        std::cout
+            << ' ' << nodes[i] << " ("
+            << libnn::misc::numa::cpus(nodes[i]).size() << " CPUs)";
+
+    std::cout << std::endl;
+
+    nn_t nn = create_nn<nn_t>(std::vector<size_t>({256, 512, 512, 16}),
+        nn_t::BIAS | nn_t::LATERAL);
+
+    const inputs_t inputs = random_inputs(batch, 256);
+
+    const size_t node_cpus = std::max<size_t>(1,
+        libnn::misc::numa::cpus(nodes[0]).size());
+
+    for (size_t threads = 1; threads <= node_cpus; threads *= 2) {
+        const nn_t::numa_function_t replicated = nn.numa_function(threads);
+        const nn_t::numa_function_t shared = nn.numa_function(threads, false);
+
+        std::cout
+            << nodes.size() << " node(s) x " << threads << " worker(s): "
+            << "replicated " << throughput(replicated, inputs)
+            << " samples/s, shared " << throughput(shared, inputs)
+            << " samples/s" << std::endl;
+    }
+
+    std::cout << "NUMA scaling benchmark END" << std::endl;
+
+    return 0;
+}
+
+
+/** Unit test */
+static int main_impl(int argc, char * const argv[]) {
+    int exit_code = 64;  // pessimistic assumption
+
+    size_t batch = 256;  // benchmark batch size (0 means no benchmark)
+    if (1 < argc) batch = ::atoi(argv[1]);
+
+    do {  // pragmatic do ... while (0) loop allowing for breaks
+        exit_code = test_numa();
+        if (0 != exit_code) break;
+
+        if (batch) {
+            exit_code = bench_numa(batch);
+            if (0 != exit_code) break;
+        }
+
+    } while (0);  // end of pragmatic loop
+
+    std::cerr
+        << "Exit code: " << exit_code
+        << std::endl;
+
+    return exit_code;
+}
+
+/** Unit test exception-safe wrapper */
+int main(int argc, char * const argv[]) {
+    int exit_code = 128;
+
+    try {
+        exit_code = main_impl(argc, argv);
+    }
+    catch (const std::exception & x) {
+        std::cerr
+            << "Standard exception caught: "
+            << x.what()
+            << std::endl;
+    }
+    catch (...) {
+        std::cerr
+            << "Unhandled non-standard exception caught"
+            << std::endl;
+    }
+
+    return exit_code;
+}
@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# Correctness tests and NUMA scaling benchmark (batches of 256 samples)
+./numa 256
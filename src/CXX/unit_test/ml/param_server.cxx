@@ -0,0 +1,732 @@
+/**
+ *  Parameter server training unit test
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "config.hxx"
+
+#include "common.hxx"
+
+#include <libnn/model/feed_forward.hxx>
+#include <libnn/ml/param_server.hxx>
+#include <libnn/ml/backpropagation.hxx>
+#include <libnn/math/sigmoid.hxx>
+
+#include <vector>
+#include <list>
+#include <string>
+#include <sstream>
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <memory>
+#include <cmath>
+
+extern "C" {
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <signal.h>
+#include <unistd.h>
+}
+
+
+/** Feed-forward network model */
+typedef libnn::model::feed_forward<double, libnn::math::logistic_fn<double> >
+    nn_t;
+
+/** Parameter server */
+typedef libnn::ml::param_server<double> server_t;
+
+/** Update */
+typedef libnn::ml::ps_update<double> update_t;
+
+/** Compressor */
+typedef libnn::ml::ps_compressor<double> compressor_t;
+
+/** Worker */
+typedef libnn::ml::ps_worker<double, nn_t::training_t> worker_t;
+
+/** Training set */
+typedef std::list<std::pair<std::vector<double>, std::vector<double> > >
+    set_t;
+
+/** Tied network topology */
+typedef libnn::topo::nn<double, libnn::math::logistic_fn<double> >
+    tied_nn_t;
+
+/** Tied network trainer */
+typedef libnn::ml::backpropagation<double, libnn::math::logistic_fn<double> >
+    tied_training_t;
+
+/** Criterion */
+typedef libnn::ml::const_learning_factor<double> criterion_t;
+
+/** Encoding names */
+static const char * encoding_names[] = { "dense", "top-k", "8-bit" };
+
+
+/**
+ *  \brief  Create 4-8-2 network
+ *
+ *  \param  seed  Random seed
+ *
+ *  \return Network
+ */
+static nn_t create_ps_nn(unsigned seed = 1) {
+    return create_nn<nn_t>(std::vector<size_t>({4, 8, 2}), nn_t::BIAS, seed);
+}
+
+
+/**
+ *  \brief  Create training set
+ *
+ *  The outputs are given by another (teacher) network.
+ *
+ *  \param  size  Set size
+ *
+ *  \return Training set
+ */
+static set_t create_set(size_t size) {
+    nn_t teacher = create_ps_nn(7);
+    nn_t::function_t fn = teacher.function();
+
+    set_t set;
+    for (size_t i = 0; i < size; ++i) {
+        const std::vector<double> input = random_vector(4, -1, 1);
+        set.emplace_back(input, fn(input));
+    }
+
+    return set;
+}
+
+
+/**
+ *  \brief  Training set shard
+ *
+ *  \param  set    Training set
+ *  \param  cnt    Shard count
+ *  \param  index  Shard index
+ *
+ *  \return Every \c cnt-th sample (starting with \c index)
+ */
+static set_t shard(const set_t & set, size_t cnt, size_t index) {
+    set_t sh;
+
+    size_t i = 0;
+    for (auto iter = set.begin(); iter != set.end(); ++iter, ++i)
+        if (index == i % cnt) sh.push_back(*iter);
+
+    return sh;
+}
+
+
+/**
+ *  \brief  Error of parameters
+ *
+ *  \param  params  Parameters
+ *  \param  set     Training set
+ *
+ *  \return Error norm squared average of network with the parameters
+ */
+static double error(const std::vector<double> & params, const set_t & set) {
+    nn_t nn = create_ps_nn();
+    nn_t::training_t training = nn.training();
+    training.set_weights(params);
+
+    nn_t::function_t fn = nn.function();
+
+    double err = 0;
+    for (auto iter = set.begin(); iter != set.end(); ++iter) {
+        const std::vector<double> out = fn(iter->first);
+
+        for (size_t j = 0; j < out.size(); ++j)
+            err += (out[j] - iter->second[j]) * (out[j] - iter->second[j]);
+    }
+
+    return err / set.size();
+}
+
+
+/**
+ *  \brief  Initial parameters
+ *
+ *  \return Parameters of the initial network
+ */
+static std::vector<double> initial_params() {
+    nn_t nn = create_ps_nn();
+    nn_t::training_t training = nn.training();
+
+    std::vector<double> params;
+    training.get_weights(params);
+
+    return params;
+}
+
+
+/**
+ *  \brief  Compression test
+ *
+ *  Checks the encodings and that no part of the updates is lost
+ *  (the sum of decoded updates and the residual equals the sum
+ *  of the updates).
+ *
+ *  \param  encoding  Encoding
+ *
+ *  \return Count of errors
+ */
+static int test_compression(update_t::encoding_t encoding) {
+    std::cout
+        << "Update compression test (" << encoding_names[encoding]
+        << ") BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    const size_t size = 1000;
+
+    compressor_t compressor(encoding, 0.05);
+    update_t update;
+
+    std::vector<double> sum(size, 0), applied(size, 0);
+    size_t bytes = 0;
+
+    for (size_t step = 0; step < 50; ++step) {
+        std::vector<double> delta = random_vector(size, -1, 1);
+
+        for (size_t i = 0; i < size; ++i) sum[i] += delta[i];
+
+        compressor(delta, update);
+        bytes += update.bytes();
+
+        std::vector<double> neg(size, 0);
+        update.apply(neg);
+        for (size_t i = 0; i < size; ++i) applied[i] -= neg[i];
+
+        const std::vector<double> & res = compressor.residual();
+
+        if (update_t::TOPK == encoding) {
+            // 5% largest kept
+            double min_sent = HUGE_VAL, max_res = 0;
+            for (size_t i = 0; i < update.value.size(); ++i)
+                min_sent = std::min(min_sent, std::abs(update.value[i]));
+
+            for (size_t i = 0; i < size; ++i)
+                max_res = std::max(max_res, std::abs(res[i]));
+
+            if (50 != update.index.size() || min_sent < max_res) {
+                std::cout << "Step " << step << ": not top-k" << std::endl;
+
+                ++error_cnt;
+                break;
+            }
+        }
+        else if (update_t::QUANT8 == encoding) {
+            for (size_t i = 0; i < size; ++i)
+                if (std::abs(res[i]) > update.scale / 2 + 1e-12) {
+                    std::cout
+                        << "Step " << step << ": quantisation error "
+                        << res[i] << " exceeds half of " << update.scale
+                        << std::endl;
+
+                    ++error_cnt;
+                    break;
+                }
+        }
+    }
+
+    const std::vector<double> & res = compressor.residual();
+    for (size_t i = 0; i < size; ++i) {
+        const double r = update_t::DENSE == encoding ? 0 : res[i];
+
+        if (std::abs(applied[i] + r - sum[i]) > 1e-9) {
+            std::cout << "Update lost at " << i << std::endl;
+
+            ++error_cnt;
+            break;
+        }
+    }
+
+    std::cout
+        << "Compression ratio: " << 50.0 * size * sizeof(double) / bytes
+        << std::endl;
+
+    std::cout << "Update compression test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  Synchronous single worker test
+ *
+ *  A single worker with dense updates shall train the same way as
+ *  the batch training.
+ *
+ *  \return Count of errors
+ */
+static int test_single() {
+    std::cout << "Single worker test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    const set_t set = create_set(30);
+
+    // Reference
+    nn_t ref_nn = create_ps_nn();
+    nn_t::training_t ref_training = ref_nn.training();
+    ref_training.checkpoint(1);  // generic backpropagation
+
+    criterion_t ref_criterion(0, 0.5);
+    for (size_t i = 0; i < 10; ++i) ref_training(set, ref_criterion);
+
+    std::vector<double> ref_params;
+    ref_training.get_weights(ref_params);
+
+    // Parameter server
+    server_t server(initial_params(), 1);
+    libnn::ml::ps_local_transport<double> transport(server);
+
+    nn_t nn = create_ps_nn();
+    nn_t::training_t training = nn.training();
+    worker_t worker(training, transport, 0);
+
+    criterion_t criterion(0, 0.5);
+    for (size_t i = 0; i < 10; ++i) worker(set, criterion);
+
+    worker.done();
+
+    const std::vector<double> params = server.params();
+    for (size_t i = 0; i < params.size(); ++i)
+        if (std::abs(params[i] - ref_params[i]) > 1e-12) {
+            std::cout
+                << "Parameter " << i << ": " << params[i]
+                << " (expected " << ref_params[i] << ')' << std::endl;
+
+            ++error_cnt;
+            break;
+        }
+
+    if (10 != server.version()) {
+        std::cout << "Unexpected version " << server.version() << std::endl;
+
+        ++error_cnt;
+    }
+
+    std::cout << "Single worker test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  Create tied network
+ *
+ *  o1 = f(w x + v y + a z), o2 = f(v x + w y + b z); w and v are shared.
+ *
+ *  \param  nn  Network (empty)
+ */
+static void create_tied_nn(tied_nn_t & nn) {
+    tied_nn_t::neuron & x  = nn.add_neuron(tied_nn_t::neuron::INPUT);
+    tied_nn_t::neuron & y  = nn.add_neuron(tied_nn_t::neuron::INPUT);
+    tied_nn_t::neuron & z  = nn.add_neuron(tied_nn_t::neuron::INPUT);
+    tied_nn_t::neuron & o1 = nn.add_neuron(tied_nn_t::neuron::OUTPUT);
+    tied_nn_t::neuron & o2 = nn.add_neuron(tied_nn_t::neuron::OUTPUT);
+
+    const size_t w = nn.add_shared_weight(0.5);
+    const size_t v = nn.add_shared_weight(-0.3);
+
+    nn.set_shared_dendrite(o1, x, w);
+    nn.set_shared_dendrite(o1, y, v);
+    o1.set_dendrite(z, 0.2);
+
+    nn.set_shared_dendrite(o2, x, v);
+    nn.set_shared_dendrite(o2, y, w);
+    o2.set_dendrite(z, -0.1);
+}
+
+
+/**
+ *  \brief  Tied network test
+ *
+ *  Shared weights are single parameters; a single worker with dense
+ *  updates shall train a tied network the same way as the batch
+ *  training.
+ *
+ *  \return Count of errors
+ */
+static int test_tied() {
+    std::cout << "Tied network test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    set_t set;
+    for (size_t i = 0; i < 20; ++i)
+        set.emplace_back(random_vector(3), random_vector(2));
+
+    // Reference
+    tied_nn_t ref_nn;
+    create_tied_nn(ref_nn);
+    tied_training_t ref_training(ref_nn);
+
+    criterion_t ref_criterion(0, 0.5);
+    for (size_t i = 0; i < 10; ++i) ref_training(set, ref_criterion);
+
+    std::vector<double> ref_params;
+    ref_training.get_weights(ref_params);
+
+    if (4 != ref_params.size()) {
+        std::cout
+            << "Unexpected parameter count " << ref_params.size()
+            << std::endl;
+
+        ++error_cnt;
+    }
+
+    // Parameter server
+    tied_nn_t nn;
+    create_tied_nn(nn);
+    tied_training_t training(nn);
+
+    std::vector<double> params;
+    training.get_weights(params);
+
+    server_t server(params, 1);
+    libnn::ml::ps_local_transport<double> transport(server);
+
+    libnn::ml::ps_worker<double, tied_training_t> worker(
+        training, transport, 0);
+
+    criterion_t criterion(0, 0.5);
+    for (size_t i = 0; i < 10; ++i) worker(set, criterion);
+
+    worker.done();
+
+    params = server.params();
+    for (size_t i = 0; i < params.size(); ++i)
+        if (std::abs(params[i] - ref_params[i]) > 1e-9) {
+            std::cout
+                << "Parameter " << i << ": " << params[i]
+                << " (expected " << ref_params[i] << ')' << std::endl;
+
+            ++error_cnt;
+            break;
+        }
+
+    // Gradient of an empty set is refused
+    try {
+        std::vector<double> grad;
+        training.gradient(set_t(), grad);
+
+        std::cout << "Empty set gradient computed" << std::endl;
+
+        ++error_cnt;
+    }
+    catch (const std::logic_error & x) {
+        std::cout << "Empty set gradient: " << x.what() << std::endl;
+    }
+
+    std::cout << "Tied network test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  Asynchronous (threads) training test
+ *
+ *  \param  workers    Worker count
+ *  \param  staleness  Staleness bound
+ *  \param  encoding   Update encoding
+ *
+ *  \return Count of errors
+ */
+static int test_threads(
+    size_t              workers,
+    size_t              staleness,
+    update_t::encoding_t encoding)
+{
+    std::cout
+        << "Parameter server test (" << workers << " threads, staleness "
+        << staleness << ", " << encoding_names[encoding] << ") BEGIN"
+        << std::endl;
+
+    int error_cnt = 0;
+
+    const size_t steps = 200;
+    const set_t  set   = create_set(60);
+
+    server_t server(initial_params(), workers, staleness);
+    libnn::ml::ps_local_transport<double> transport(server);
+
+    const double error0 = error(server.params(), set);
+
+    std::vector<std::unique_ptr<nn_t> > nns;
+    for (size_t w = 0; w < workers; ++w)
+        nns.emplace_back(new nn_t(create_ps_nn()));
+
+    std::vector<std::thread> threads;
+    for (size_t w = 0; w < workers; ++w)
+        threads.emplace_back([&, w]() {
+            const set_t sh = shard(set, workers, w);
+
+            nn_t::training_t training = nns[w]->training();
+            worker_t worker(training, transport, w,
+                compressor_t(encoding, 0.2));
+
+            criterion_t criterion(0, 1.0);
+            for (size_t i = 0; i < steps; ++i) worker(sh, criterion);
+
+            worker.done();
+        });
+
+    std::for_each(threads.begin(), threads.end(),
+    [](std::thread & t) { t.join(); });
+
+    const double error1 = error(server.params(), set);
+
+    std::cout
+        << "Error: " << error0 << " -> " << error1
+        << ", max. lag: " << server.max_lag() << std::endl;
+
+    if (server.max_lag() > staleness) {
+        std::cout << "Staleness bound violated" << std::endl;
+
+        ++error_cnt;
+    }
+
+    if (workers * steps != server.version()) {
+        std::cout << "Unexpected version " << server.version() << std::endl;
+
+        ++error_cnt;
+    }
+
+    if (!(error1 < 0.5 * error0)) {
+        std::cout << "Training doesn't converge" << std::endl;
+
+        ++error_cnt;
+    }
+
+    std::cout << "Parameter server test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  Unix domain socket (processes) training test
+ *
+ *  \param  workers    Worker count
+ *  \param  staleness  Staleness bound
+ *  \param  encoding   Update encoding
+ *
+ *  \return Count of errors
+ */
+static int test_processes(
+    size_t              workers,
+    size_t              staleness,
+    update_t::encoding_t encoding)
+{
+    std::cout
+        << "Parameter server test (" << workers << " processes, staleness "
+        << staleness << ", " << encoding_names[encoding] << ") BEGIN"
+        << std::endl;
+
+    int error_cnt = 0;
+
+    const size_t steps = 200;
+    const set_t  set   = create_set(60);
+
+    std::stringstream path;
+    path << "/tmp/libnn_ut_param_server_" << ::getpid() << ".sock";
+
+    server_t server(initial_params(), workers, staleness);
+    libnn::ml::ps_unix_endpoint<double> endpoint(server, path.str());
+
+    const double error0 = error(server.params(), set);
+
+    std::cout.flush();
+
+    std::vector<pid_t> pids;
+    for (size_t w = 0; w < workers; ++w) {
+        const pid_t pid = ::fork();
+        if (-1 == pid)
+            throw std::runtime_error("fork failed");
+
+        if (0 == pid) {
+            int rc = 1;
+
+            try {
+                const set_t sh = shard(set, workers, w);
+
+                nn_t nn = create_ps_nn();
+                nn_t::training_t training = nn.training();
+
+                libnn::ml::ps_unix_transport<double> transport(path.str());
+                worker_t worker(training, transport, w,
+                    compressor_t(encoding, 0.2));
+
+                criterion_t criterion(0, 1.0);
+                for (size_t i = 0; i < steps; ++i) worker(sh, criterion);
+
+                worker.done();
+
+                if (0 == w)
+                    std::cout
+                        << "Pushed " << worker.pushed_bytes() << " bytes"
+                        << std::endl;
+
+                rc = 0;
+            }
+            catch (const std::exception & x) {
+                std::cout << "Worker " << w << ": " << x.what() << std::endl;
+            }
+
+            ::_exit(rc);
+        }
+
+        pids.push_back(pid);
+    }
+
+    for (size_t w = 0; w < pids.size(); ++w) {
+        int status;
+        if (-1 == ::waitpid(pids[w], &status, 0) ||
+            !WIFEXITED(status) || 0 != WEXITSTATUS(status))
+        {
+            std::cout << "Worker " << w << " failed" << std::endl;
+
+            ++error_cnt;
+        }
+    }
+
+    endpoint.stop();
+
+    const double error1 = error(server.params(), set);
+
+    std::cout
+        << "Error: " << error0 << " -> " << error1
+        << ", max. lag: " << server.max_lag() << std::endl;
+
+    if (server.max_lag() > staleness) {
+        std::cout << "Staleness bound violated" << std::endl;
+
+        ++error_cnt;
+    }
+
+    if (workers * steps != server.version()) {
+        std::cout << "Unexpected version " << server.version() << std::endl;
+
+        ++error_cnt;
+    }
+
+    if (!(error1 < 0.5 * error0)) {
+        std::cout << "Training doesn't converge" << std::endl;
+
+        ++error_cnt;
+    }
+
+    std::cout << "Parameter server test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/** Unit test */
+static int main_impl(int argc, char * const argv[]) {
+    int exit_code = 64;  // pessimistic assumption
+
+    do {  // pragmatic do ... while (0) loop allowing for breaks
+        exit_code = test_compression(update_t::DENSE);
+        if (0 != exit_code) break;
+
+        exit_code = test_compression(update_t::TOPK);
+        if (0 != exit_code) break;
+
+        exit_code = test_compression(update_t::QUANT8);
+        if (0 != exit_code) break;
+
+        exit_code = test_single();
+        if (0 != exit_code) break;
+
+        exit_code = test_tied();
+        if (0 != exit_code) break;
+
+        exit_code = test_threads(3, 0, update_t::DENSE);
+        if (0 != exit_code) break;
+
+        exit_code = test_threads(3, 2, update_t::TOPK);
+        if (0 != exit_code) break;
+
+        exit_code = test_threads(4, 1, update_t::QUANT8);
+        if (0 != exit_code) break;
+
+        exit_code = test_processes(2, 1, update_t::TOPK);
+        if (0 != exit_code) break;
+
+        exit_code = test_processes(3, 0, update_t::QUANT8);
+        if (0 != exit_code) break;
+
+    } while (0);  // end of pragmatic loop
+
+    std::cerr
+        << "Exit code: " << exit_code
+        << std::endl;
+
+    return exit_code;
+}
+
+/** Unit test exception-safe wrapper */
+int main(int argc, char * const argv[]) {
+    int exit_code = 128;
+
+    try {
+        exit_code = main_impl(argc, argv);
+    }
+    catch (const std::exception & x) {
+        std::cerr
+            << "Standard exception caught: "
+            << x.what()
+            << std::endl;
+    }
+    catch (...) {
+        std::cerr
+            << "Unhandled non-standard exception caught"
+            << std::endl;
+    }
+
+    return exit_code;
+}
@@ -0,0 +1,349 @@
+/**
+ *  Pipelined network function unit test
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "config.hxx"
+
+#include "common.hxx"
+
+#include <libnn/model/feed_forward.hxx>
+#include <libnn/ml/pipeline.hxx>
+#include <libnn/math/sigmoid.hxx>
+
+#include <vector>
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+#include <chrono>
+#include <cmath>
+
+
+/** Feed-forward network model */
+typedef libnn::model::feed_forward<double, libnn::math::logistic_fn<double> >
+    nn_t;
+
+
+/**
+ *  \brief  Pipeline evaluation test
+ *
+ *  \param  stages  Stage count
+ *  \param  rows    Rows per block
+ *
+ *  \return Count of errors
+ */
+static int test_eval(size_t stages, size_t rows) {
+    std::cout
+        << "Pipeline evaluation test (" << stages << " stages, "
+        << rows << " rows) BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    nn_t nn = create_nn<nn_t>(std::vector<size_t>({12, 20, 16, 16, 20, 4}),
+        nn_t::BIAS | nn_t::LATERAL);
+
+    nn_t::function_t          function = nn.function();
+    nn_t::pipeline_function_t pipeline = nn.pipeline_function(stages, rows);
+
+    for (size_t i = 0; i < pipeline.stages(); ++i)
+        std::cout
+            << "Stage " << i << ": layers [" << pipeline.stage_layers(i).first
+            << ", " << pipeline.stage_layers(i).second << "), cost "
+            << pipeline.stage_cost(i) << std::endl;
+
+    const inputs_t inputs  = random_inputs(203, 12);
+    const inputs_t outputs = pipeline.batch(inputs);
+
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        const auto exp = function(inputs[i]);
+
+        double diff = 0;
+        for (size_t j = 0; j < exp.size(); ++j)
+            diff = std::max(diff, std::abs(exp[j] - outputs[i][j]));
+
+        if (diff > 1e-12) {
+            std::cout << "Output " << i << " mismatch: " << diff << std::endl;
+
+            ++error_cnt;
+            break;
+        }
+    }
+
+    const auto out = pipeline(inputs[0]);
+    if (out != outputs[0]) {
+        std::cout << "Single output mismatch" << std::endl;
+
+        ++error_cnt;
+    }
+
+    std::cout << "Pipeline evaluation test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  Invalid input test
+ *
+ *  Batch with an invalid input shall fail without leaving blocks
+ *  in the pipeline (next evaluations shall be correct).
+ *
+ *  \return Count of errors
+ */
+static int test_invalid_input() {
+    std::cout << "Pipeline invalid input test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    nn_t nn = create_nn<nn_t>(std::vector<size_t>({12, 20, 16, 4}),
+        nn_t::BIAS | nn_t::LATERAL);
+
+    nn_t::function_t          function = nn.function();
+    nn_t::pipeline_function_t pipeline = nn.pipeline_function(3, 1);
+
+    inputs_t inputs = random_inputs(8, 12);
+    inputs.push_back(std::vector<double>(5, 0.5));
+
+    try {
+        pipeline.batch(inputs);
+
+        std::cout << "Invalid input accepted" << std::endl;
+
+        ++error_cnt;
+    }
+    catch (const std::logic_error & ex) {
+        std::cout << "Invalid input rejected: " << ex.what() << std::endl;
+    }
+
+    for (size_t i = 0; i < 2; ++i) {
+        const inputs_t outputs = pipeline.batch(
+            inputs_t(inputs.begin() + i, inputs.begin() + 8));
+
+        if (8 - i != outputs.size()) {
+            std::cout << "Output count mismatch" << std::endl;
+
+            ++error_cnt;
+            continue;
+        }
+
+        for (size_t j = 0; j < outputs.size(); ++j)
+            if (outputs[j] != function(inputs[i + j])) {
+                std::cout << "Output " << j << " mismatch" << std::endl;
+
+                ++error_cnt;
+                break;
+            }
+    }
+
+    if (pipeline(inputs[0]) != function(inputs[0])) {
+        std::cout << "Single output mismatch" << std::endl;
+
+        ++error_cnt;
+    }
+
+    std::cout << "Pipeline invalid input test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  Stage balancing test
+ *
+ *  The maximal stage cost shall be optimal (checked by brute force).
+ *
+ *  \return Count of errors
+ */
+static int test_balance() {
+    std::cout << "Stage balancing test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    nn_t nn = create_nn<nn_t>(std::vector<size_t>({8, 64, 8, 8, 64, 8, 32, 4}),
+        nn_t::BIAS | nn_t::LATERAL);
+
+    nn_t::pipeline_function_t pipeline = nn.pipeline_function(3);
+
+    // Layers costs (stage of single layer)
+    std::vector<double> costs;
+    for (size_t k = 1; k < 8; ++k) {
+        nn_t::pipeline_function_t single = nn.pipeline_function(7);
+        costs.push_back(single.stage_cost(k - 1));
+    }
+
+    double max_cost = 0;
+    for (size_t i = 0; i < pipeline.stages(); ++i)
+        max_cost = std::max(max_cost, pipeline.stage_cost(i));
+
+    double best = HUGE_VAL;
+    for (size_t e1 = 1; e1 < 6; ++e1)
+        for (size_t e2 = e1 + 1; e2 < 7; ++e2) {
+            double c1 = 0, c2 = 0, c3 = 0;
+            for (size_t k = 0;  k < e1; ++k) c1 += costs[k];
+            for (size_t k = e1; k < e2; ++k) c2 += costs[k];
+            for (size_t k = e2; k < 7;  ++k) c3 += costs[k];
+
+            best = std::min(best, std::max(c1, std::max(c2, c3)));
+        }
+
+    std::cout
+        << "Max. stage cost: " << max_cost
+        << " (optimum " << best << ")" << std::endl;
+
+    if (max_cost != best) {
+        std::cout << "Stages are not balanced" << std::endl;
+
+        ++error_cnt;
+    }
+
+    std::cout << "Stage balancing test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  Throughput report
+ *
+ *  The throughput is only reported (it depends on the machine).
+ *
+ *  \param  cnt  Sample count
+ *
+ *  \return Count of errors
+ */
+static int test_throughput(size_t cnt) {
+    typedef std::chrono::steady_clock clock_t;
+
+    std::cout << "Pipeline throughput test BEGIN" << std::endl;
+
+    nn_t nn = create_nn<nn_t>(
+        std::vector<size_t>({64, 128, 128, 128, 128, 8}),
+        nn_t::BIAS | nn_t::LATERAL);
+
+    const inputs_t inputs = random_inputs(cnt, 64);
+
+    nn_t::function_t function = nn.function();
+
+    const auto t0 = clock_t::now();
+    for (size_t i = 0; i < cnt; ++i) function(inputs[i]);
+
+    const auto t1 = clock_t::now();
+
+    std::cout
+        << "Sequential: " << cnt / std::chrono::duration<double>(t1 - t0).count()
+        << " samples/s" << std::endl;
+
+    for (size_t stages = 1; stages <= 4; stages *= 2) {
+        nn_t::pipeline_function_t pipeline = nn.pipeline_function(stages, 4);
+
+        const auto t2 = clock_t::now();
+        pipeline.batch(inputs);
+
+        const auto t3 = clock_t::now();
+
+        std::cout
+            << stages << " stage(s): "
+            << cnt / std::chrono::duration<double>(t3 - t2).count()
+            << " samples/s" << std::endl;
+    }
+
+    std::cout << "Pipeline throughput test END" << std::endl;
+
+    return 0;
+}
+
+
+/** Unit test */
+static int main_impl(int argc, char * const argv[]) {
+    int exit_code = 64;  // pessimistic assumption
+
+    size_t cnt = 2000;
+    if (1 < argc) cnt = ::atoi(argv[1]);
+
+    do {  // pragmatic do ... while (0) loop allowing for breaks
+        exit_code = test_eval(1, 1);
+        if (0 != exit_code) break;
+
+        exit_code = test_eval(3, 1);
+        if (0 != exit_code) break;
+
+        exit_code = test_eval(3, 8);
+        if (0 != exit_code) break;
+
+        exit_code = test_eval(10, 2);  // more stages than layers
+        if (0 != exit_code) break;
+
+        exit_code = test_invalid_input();
+        if (0 != exit_code) break;
+
+        exit_code = test_balance();
+        if (0 != exit_code) break;
+
+        exit_code = test_throughput(cnt);
+        if (0 != exit_code) break;
+
+    } while (0);  // end of pragmatic loop
+
+    std::cerr
+        << "Exit code: " << exit_code
+        << std::endl;
+
+    return exit_code;
+}
+
+/** Unit test exception-safe wrapper */
+int main(int argc, char * const argv[]) {
+    int exit_code = 128;
+
+    try {
+        exit_code = main_impl(argc, argv);
+    }
+    catch (const std::exception & x) {
+        std::cerr
+            << "Standard exception caught: "
+            << x.what()
+            << std::endl;
+    }
+    catch (...) {
+        std::cerr
+            << "Unhandled non-standard exception caught"
+            << std::endl;
+    }
+
+    return exit_code;
+}
@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# Correctness tests and throughput report (2000 samples)
+./pipeline 2000
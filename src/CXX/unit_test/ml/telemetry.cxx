@@ -0,0 +1,527 @@
+/**
+ *  Training telemetry unit test
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "config.hxx"
+
+#include "common.hxx"
+
+#include <libnn/model/feed_forward.hxx>
+#include <libnn/ml/backpropagation.hxx>
+#include <libnn/ml/telemetry.hxx>
+#include <libnn/math/sigmoid.hxx>
+
+#include <vector>
+#include <list>
+#include <string>
+#include <algorithm>
+#include <sstream>
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <chrono>
+#include <cmath>
+
+
+/** Feed-forward network model */
+typedef libnn::model::feed_forward<double, libnn::math::logistic_fn<double> >
+    nn_t;
+
+/** Generic backpropagation */
+typedef libnn::ml::backpropagation<double, libnn::math::logistic_fn<double> >
+    backprop_t;
+
+/** Training set */
+typedef std::list<std::pair<std::vector<double>, std::vector<double> > >
+    tset_t;
+
+/** Learning criterion */
+typedef libnn::ml::const_learning_factor<double> criterion_t;
+
+namespace telemetry = libnn::ml::telemetry;
+
+
+/** Event collector */
+class collector: public telemetry::observer {
+    public:
+
+    std::vector<telemetry::event> events;  /**< Received events */
+
+    /** Collect event */
+    void operator () (const telemetry::event & ev) { events.push_back(ev); }
+
+};  // end of class collector
+
+
+/** Slow observer (simulates stalled monitoring) */
+class slow_observer: public telemetry::observer {
+    public:
+
+    /** Take a nap */
+    void operator () (const telemetry::event & ev) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+};  // end of class slow_observer
+
+
+/**
+ *  \brief  Create XOR network
+ *
+ *  \param  features  Network features
+ *
+ *  \return 2-4-1 network
+ */
+static nn_t create_xor_nn(int features) {
+    return create_nn<nn_t>(std::vector<size_t>({2, 4, 1}), features);
+}
+
+/** XOR training set */
+static tset_t xor_set() {
+    tset_t tset;
+
+    tset.emplace_back(std::vector<double>({0, 0}), std::vector<double>({0}));
+    tset.emplace_back(std::vector<double>({0, 1}), std::vector<double>({1}));
+    tset.emplace_back(std::vector<double>({1, 0}), std::vector<double>({1}));
+    tset.emplace_back(std::vector<double>({1, 1}), std::vector<double>({0}));
+
+    return tset;
+}
+
+/** Network weights norm */
+static double weight_norm(const nn_t & nn) {
+    double norm2 = 0;
+
+    nn.topology().for_each_neuron(
+    [&norm2](const nn_t::topo_t::neuron & n) {
+        n.for_each_dendrite(
+        [&norm2](const nn_t::topo_t::neuron::dendrite & dend) {
+            norm2 += dend.weight() * dend.weight();
+        });
+    });
+
+    return std::sqrt(norm2);
+}
+
+
+/**
+ *  \brief  Check steps and epoch events
+ *
+ *  3 on-line and 2 batch steps are done, then the epoch is ended.
+ *
+ *  \tparam Train  Trainer type
+ *  \param  nn     Network
+ *  \param  train  Trainer
+ *
+ *  \return Count of errors
+ */
+template <class Train>
+static int check_events(nn_t & nn, Train & train) {
+    int error_cnt = 0;
+
+    collector events;
+    train.observer(&events);
+
+    if (&events != train.observer()) {
+        std::cout << "Observer not set" << std::endl;
+
+        ++error_cnt;
+    }
+
+    const tset_t tset = xor_set();
+    criterion_t  criterion(0, 0.5);
+
+    std::vector<double> errors;
+    for (size_t i = 0; i < 3; ++i)
+        errors.push_back(
+            train(tset.front().first, tset.front().second, criterion));
+
+    for (size_t i = 0; i < 2; ++i) errors.push_back(train(tset, criterion));
+
+    const double wnorm = weight_norm(nn);
+
+    train.epoch();
+    train.epoch();  // no steps, no event
+
+    train.observer(NULL);
+    train(tset, criterion);  // not observed
+
+    if (6 != events.events.size()) {
+        std::cout
+            << "Unexpected event count: " << events.events.size()
+            << std::endl;
+
+        return error_cnt + 1;
+    }
+
+    size_t samples = 0;
+    double error   = 0;
+
+    for (size_t i = 0; i < 5; ++i) {
+        const telemetry::event & ev = events.events[i];
+
+        std::cout
+            << ev.type_name() << ' ' << ev.index << ": samples "
+            << ev.samples << ", error " << ev.error << ", grad. norm "
+            << ev.grad_norm << ", weight norm " << ev.weight_norm << ", "
+            << ev.samples_per_s << " samples/s" << std::endl;
+
+        const size_t exp_samples = i < 3 ? 1 : 4;
+
+        if (telemetry::event::STEP != ev.type || i != ev.index ||
+            exp_samples != ev.samples || errors[i] != ev.error ||
+            0.5 != ev.alpha || !(ev.grad_norm > 0) ||
+            !(ev.samples_per_s > 0))
+        {
+            std::cout << "Unexpected step event" << std::endl;
+
+            ++error_cnt;
+        }
+
+        samples += ev.samples;
+        error   += ev.error * ev.samples;
+    }
+
+    if (std::abs(events.events[4].weight_norm - wnorm) > 1e-12) {
+        std::cout
+            << "Unexpected weight norm (expected " << wnorm << ')'
+            << std::endl;
+
+        ++error_cnt;
+    }
+
+    const telemetry::event & ev = events.events[5];
+
+    std::cout
+        << ev.type_name() << ' ' << ev.index << ": samples "
+        << ev.samples << ", error " << ev.error << ", "
+        << ev.samples_per_s << " samples/s" << std::endl;
+
+    if (telemetry::event::EPOCH != ev.type || 0 != ev.index ||
+        samples != ev.samples ||
+        std::abs(error / samples - ev.error) > 1e-12 ||
+        ev.weight_norm != events.events[4].weight_norm)
+    {
+        std::cout << "Unexpected epoch event" << std::endl;
+
+        ++error_cnt;
+    }
+
+    return error_cnt;
+}
+
+
+/** Generic backpropagation events test */
+static int test_generic() {
+    std::cout << "Generic backpropagation events test BEGIN" << std::endl;
+
+    nn_t nn = create_xor_nn(nn_t::DEFAULT);
+    backprop_t train(nn.topology());
+
+    int error_cnt = check_events(nn, train);
+
+    std::cout << "Generic backpropagation events test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/** Dense backpropagation events test */
+static int test_dense() {
+    std::cout << "Dense backpropagation events test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    nn_t nn = create_xor_nn(nn_t::BIAS);
+    nn_t::training_t train = nn.training();
+
+    if (!train.layered()) {
+        std::cout << "Dense backpropagation is not available" << std::endl;
+
+        ++error_cnt;
+    }
+
+    error_cnt += check_events(nn, train);
+
+    std::cout << "Dense backpropagation events test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  Observed batch training test
+ *
+ *  Observed generic batch training updates the network by accumulated
+ *  gradient; the result shall be the same.
+ *
+ *  \return Count of errors
+ */
+static int test_observed_batch() {
+    std::cout << "Observed batch training test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    nn_t nn1 = create_xor_nn(nn_t::DEFAULT);
+    nn_t nn2 = create_xor_nn(nn_t::DEFAULT);
+
+    backprop_t train1(nn1.topology());
+    backprop_t train2(nn2.topology());
+
+    collector events;
+    train2.observer(&events);
+
+    const tset_t tset = xor_set();
+    criterion_t  criterion(0, 0.5);
+
+    for (size_t i = 0; i < 100; ++i) {
+        train1(tset, criterion);
+        train2(tset, criterion);
+    }
+
+    std::vector<double> w1, w2;
+    train1.get_weights(w1);
+    train2.get_weights(w2);
+
+    for (size_t i = 0; i < w1.size(); ++i)
+        if (std::abs(w1[i] - w2[i]) > 1e-9) {
+            std::cout
+                << "Weight " << i << " differs: " << w1[i] << " vs. "
+                << w2[i] << std::endl;
+
+            ++error_cnt;
+        }
+
+    std::cout << "Observed batch training test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/** Stream sink test */
+static int test_sink() {
+    std::cout << "Stream sink test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    telemetry::event ev;
+    ev.index         = 7;
+    ev.samples       = 4;
+    ev.error         = 0.25;
+    ev.alpha         = 0.5;
+    ev.grad_norm     = 2;
+    ev.weight_norm   = 3;
+    ev.samples_per_s = 1000;
+    ev.time[0]       = 0.001;
+    ev.time[1]       = 0.002;
+    ev.time[2]       = 0.003;
+
+    std::ostringstream csv;
+    telemetry::stream_sink csv_sink(csv);
+    csv_sink(ev);
+    ev.type = telemetry::event::EPOCH;
+    csv_sink(ev);
+
+    const std::string csv_exp =
+        "type,index,samples,error,alpha,grad_norm,weight_norm,samples_per_s,"
+        "forward_s,backward_s,update_s\n"
+        "step,7,4,0.25,0.5,2,3,1000,0.001,0.002,0.003\n"
+        "epoch,7,4,0.25,0.5,2,3,1000,0.001,0.002,0.003\n";
+
+    std::cout << csv.str();
+
+    if (csv_exp != csv.str()) {
+        std::cout << "Unexpected CSV" << std::endl;
+
+        ++error_cnt;
+    }
+
+    std::ostringstream jsonl;
+    telemetry::stream_sink jsonl_sink(jsonl, telemetry::stream_sink::JSONL);
+    jsonl_sink(ev);
+
+    const std::string jsonl_exp =
+        "{\"type\": \"epoch\", \"index\": 7, \"samples\": 4, "
+        "\"error\": 0.25, \"alpha\": 0.5, \"grad_norm\": 2, "
+        "\"weight_norm\": 3, \"samples_per_s\": 1000, "
+        "\"forward_s\": 0.001, \"backward_s\": 0.002, "
+        "\"update_s\": 0.003}\n";
+
+    std::cout << jsonl.str();
+
+    if (jsonl_exp != jsonl.str()) {
+        std::cout << "Unexpected JSON line" << std::endl;
+
+        ++error_cnt;
+    }
+
+    std::cout << "Stream sink test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  Asynchronous delivery test
+ *
+ *  \param  cnt  Event count
+ *
+ *  \return Count of errors
+ */
+static int test_async(size_t cnt) {
+    std::cout << "Asynchronous delivery test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    // All events are delivered (unless dropped)
+    std::ostringstream out;
+    telemetry::stream_sink sink(out, telemetry::stream_sink::JSONL);
+
+    {
+        telemetry::async_observer async(sink, 64, 100);
+
+        telemetry::event ev;
+        for (size_t i = 0; i < cnt; ++i) {
+            ev.index = i;
+            async(ev);
+
+            if (0 == i % 32)  // let the dispatcher run
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+
+        async.flush();
+
+        const std::string lines = out.str();
+        const size_t line_cnt = std::count(lines.begin(), lines.end(), '\n');
+
+        std::cout
+            << "Delivered " << line_cnt << " events, dropped "
+            << async.dropped() << std::endl;
+
+        if (line_cnt + async.dropped() != cnt) {
+            std::cout << "Events lost" << std::endl;
+
+            ++error_cnt;
+        }
+    }
+
+    // Slow observer doesn't block the producer
+    {
+        slow_observer slow;
+        telemetry::async_observer async(slow, 8);
+
+        const auto t0 = std::chrono::steady_clock::now();
+
+        telemetry::event ev;
+        for (size_t i = 0; i < 100; ++i) async(ev);
+
+        const double t = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - t0).count();
+
+        std::cout
+            << "Posted 100 events to slow observer in " << t
+            << " s, dropped " << async.dropped() << std::endl;
+
+        if (t > 0.05 || 0 == async.dropped()) {
+            std::cout << "Producer was blocked" << std::endl;
+
+            ++error_cnt;
+        }
+    }
+
+    std::cout << "Asynchronous delivery test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/** Unit test */
+static int main_impl(int argc, char * const argv[]) {
+    int exit_code = 64;  // pessimistic assumption
+
+    size_t cnt = 10000;
+    if (1 < argc) cnt = ::atoi(argv[1]);
+
+    do {  // pragmatic do ... while (0) loop allowing for breaks
+        exit_code = test_generic();
+        if (0 != exit_code) break;
+
+        exit_code = test_dense();
+        if (0 != exit_code) break;
+
+        exit_code = test_observed_batch();
+        if (0 != exit_code) break;
+
+        exit_code = test_sink();
+        if (0 != exit_code) break;
+
+        exit_code = test_async(cnt);
+        if (0 != exit_code) break;
+
+    } while (0);  // end of pragmatic loop
+
+    std::cerr
+        << "Exit code: " << exit_code
+        << std::endl;
+
+    return exit_code;
+}
+
+/** Unit test exception-safe wrapper */
+int main(int argc, char * const argv[]) {
+    int exit_code = 128;
+
+    try {
+        exit_code = main_impl(argc, argv);
+    }
+    catch (const std::exception & x) {
+        std::cerr
+            << "Standard exception caught: "
+            << x.what()
+            << std::endl;
+    }
+    catch (...) {
+        std::cerr
+            << "Unhandled non-standard exception caught"
+            << std::endl;
+    }
+
+    return exit_code;
+}
@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# Asynchronous delivery of 10000 events
+./telemetry 10000
@@ -0,0 +1,505 @@
+/**
+ *  Convolutional neural network unit test
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "config.hxx"
+
+#include <libnn/math/sigmoid.hxx>
+#include <libnn/io/sigmoid.hxx>
+#include <libnn/model/conv.hxx>
+#include <libnn/io/conv.hxx>
+#include <libnn/math/util.hxx>
+
+#include <vector>
+#include <iostream>
+#include <sstream>
+#include <exception>
+#include <stdexcept>
+#include <cmath>
+#include <cstdlib>
+
+
+/** Identity activation functor */
+template <typename Base_t>
+class identity {
+    public:
+
+    /** Identity function */
+    Base_t operator () (const Base_t & x) const { return x; }
+
+    /** Identity derivation (i.e. 1) */
+    Base_t d(const Base_t & x) const { return 1; }
+
+};  // end of template class identity
+
+/** Logistic function */
+typedef libnn::math::logistic_fn<double> logistic_t;
+
+/** Linear convolutional layer */
+typedef libnn::topo::conv_layer<double, identity<double> > lin_layer_t;
+
+/** Linear convolutional layers stack */
+typedef libnn::ml::impl::conv_stack<double, identity<double> > lin_stack_t;
+
+/** Logistic convolutional neural network model */
+typedef libnn::model::conv<double, logistic_t> conv_t;
+
+/** Training set */
+typedef std::vector<std::pair<std::vector<double>, std::vector<double> > >
+    tset_t;
+
+
+/**
+ *  \brief  Direct convolution (reference implementation)
+ *
+ *  \param  layer  Convolution layer
+ *  \param  in     Input
+ *
+ *  \return Output
+ */
+static std::vector<double> direct_conv(
+    const lin_layer_t         & layer,
+    const std::vector<double> & in)
+{
+    const auto & is = layer.input();
+    const auto & os = layer.output();
+
+    std::vector<double> out(os.size());
+
+    for (size_t f = 0; f < os.channels; ++f)
+    for (size_t oy = 0; oy < os.height; ++oy)
+    for (size_t ox = 0; ox < os.width; ++ox) {
+        double sum = layer.bias()[f];
+
+        for (size_t c = 0; c < is.channels; ++c)
+        for (size_t ky = 0; ky < layer.kernel_h(); ++ky)
+        for (size_t kx = 0; kx < layer.kernel_w(); ++kx) {
+            const long y = (long)(oy * layer.stride_h() + ky) - layer.pad_h();
+            const long x = (long)(ox * layer.stride_w() + kx) - layer.pad_w();
+
+            if (y < 0 || x < 0 || !(y < (long)is.height && x < (long)is.width))
+                continue;
+
+            sum += layer.weight(f, c, ky, kx)
+                * in[(c * is.height + y) * is.width + x];
+        }
+
+        out[(f * os.height + oy) * os.width + ox] = sum;
+    }
+
+    return out;
+}
+
+
+/**
+ *  \brief  Convolution and pooling evaluation test
+ *
+ *  \return Count of errors
+ */
+static int test_conv_eval() {
+    std::cout << "Convolution evaluation test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    libnn::math::rng_uniform<double> rng(-1, 1);
+
+    // 2 channels of 5x6 planes, 3 filters 3x2, stride 2x1, padding 1x1
+    std::vector<lin_layer_t> layers;
+    layers.emplace_back(lin_layer_t::CONV,
+        lin_layer_t::shape(2, 5, 6), 3, 3, 2, 2, 1, 1, 1);
+
+    for (auto & w : layers[0].weights()) w = rng();
+    for (auto & b : layers[0].bias())    b = rng();
+
+    std::vector<double> in(layers[0].input().size());
+    for (auto & x : in) x = rng();
+
+    const auto expected = direct_conv(layers[0], in);
+
+    lin_stack_t stack(layers);
+    const auto & out = stack(in);
+
+    for (size_t i = 0; i < out.size(); ++i)
+        if (std::abs(out[i] - expected[i]) > 1e-12) {
+            std::cout
+                << "Convolution mismatch at " << i << ": "
+                << out[i] << " != " << expected[i]
+                << std::endl;
+
+            ++error_cnt;
+        }
+
+    // Pooling of [1 .. 8] (1 channel, 2x4 plane) by 2x2 windows
+    std::vector<lin_layer_t> pools;
+    pools.emplace_back(lin_layer_t::MAX_POOL,
+        lin_layer_t::shape(1, 2, 4), 0, 2, 2, 2, 2);
+    pools.emplace_back(lin_layer_t::AVG_POOL,
+        lin_layer_t::shape(1, 1, 2), 0, 1, 2, 1, 2);
+
+    lin_stack_t pool_stack(pools);
+    const auto & pool_out = pool_stack(
+        std::vector<double>({1, 2, 3, 4, 5, 6, 7, 8}));
+
+    std::cout << "Pooling result: " << pool_out[0] << std::endl;
+
+    if (1 != pool_out.size() || (6.0 + 8.0) / 2 != pool_out[0]) {
+        std::cout << "Pooling failed" << std::endl;
+
+        ++error_cnt;
+    }
+
+    std::cout << "Convolution evaluation test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  Compute error of a sample
+ *
+ *  \param  network  Network
+ *  \param  input    Input
+ *  \param  output   Desired output
+ *
+ *  \return Half of error norm squared
+ */
+static double sample_error(
+    const conv_t              & network,
+    const std::vector<double> & input,
+    const std::vector<double> & output)
+{
+    conv_t::function_t function = network.function();
+
+    const auto actual = function(input);
+
+    double err = 0;
+    for (size_t i = 0; i < actual.size(); ++i) {
+        const double d = actual[i] - output[i];
+        err += d * d / 2;
+    }
+
+    return err;
+}
+
+
+/**
+ *  \brief  Convolutional network gradient test
+ *
+ *  Performs a training step and compares the parameter changes
+ *  with numerically computed gradient.
+ *
+ *  \return Count of errors
+ */
+static int test_conv_gradient() {
+    std::cout << "Convolutional network gradient test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    libnn::math::rng_uniform<double> rng(-1, 1);
+
+    conv_t network(conv_t::shape_t(2, 6, 7));
+    network.add_conv(3, 3, 3, rng, 1, 1, 1, 1);
+    network.add_max_pool(2, 2);
+    network.add_conv(2, 1, 1, rng);
+    network.add_avg_pool(1, 3);
+    network.set_dense(std::vector<size_t>({3, 2}), rng, conv_t::dense_t::BIAS);
+
+    std::vector<double> input(network.input_size());
+    for (auto & x : input) x = rng();
+
+    const std::vector<double> output({0.2, 0.7});
+
+    // Parameters
+    std::vector<double *> params;
+    for (auto & layer : network.layers()) {
+        for (auto & w : layer.weights()) params.push_back(&w);
+        for (auto & b : layer.bias())    params.push_back(&b);
+    }
+
+    network.dense().topology().for_each_neuron(
+    [&params](conv_t::dense_t::topo_t::neuron & n) {
+        n.for_each_dendrite(
+        [&params](conv_t::dense_t::topo_t::neuron::dendrite & d) {
+            params.push_back(&d.weight());
+        });
+    });
+
+    std::cout
+        << "Parameters: " << params.size()
+        << " (" << network.parameter_cnt() << ')'
+        << std::endl;
+
+    if (params.size() != network.parameter_cnt()) {
+        std::cout << "Parameter count mismatch" << std::endl;
+
+        ++error_cnt;
+    }
+
+    // Numerical gradient
+    const double h = 1e-6;
+    std::vector<double> num_grad;
+    for (size_t i = 0; i < params.size(); ++i) {
+        const double p = *params[i];
+
+        *params[i] = p + h;
+        const double err_plus  = sample_error(network, input, output);
+
+        *params[i] = p - h;
+        const double err_minus = sample_error(network, input, output);
+
+        *params[i] = p;
+
+        num_grad.push_back((err_plus - err_minus) / (2 * h));
+    }
+
+    // Training step
+    std::vector<double> before;
+    for (size_t i = 0; i < params.size(); ++i) before.push_back(*params[i]);
+
+    const double alpha = 1e-3;
+    auto criterion = [alpha](double err_n2) -> double { return alpha; };
+
+    conv_t::training_t training = network.training();
+    training(input, output, criterion);
+
+    size_t mismatch_cnt = 0;
+    for (size_t i = 0; i < params.size(); ++i) {
+        const double grad = (before[i] - *params[i]) / alpha;
+
+        if (std::abs(grad - num_grad[i]) > 1e-6 * (1 + std::abs(grad))) {
+            std::cout
+                << "Gradient mismatch of parameter " << i << ": "
+                << grad << " != " << num_grad[i]
+                << std::endl;
+
+            ++mismatch_cnt;
+        }
+    }
+
+    if (mismatch_cnt) ++error_cnt;
+
+    std::cout << "Convolutional network gradient test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  Create signal sample
+ *
+ *  The signal contains either a pulse (class 0) or a dip (class 1)
+ *  at random position and some noise.
+ *
+ *  \param  length  Signal length
+ *  \param  cls     Class
+ *  \param  rng     Noise RNG
+ *
+ *  \return Training sample
+ */
+static std::pair<std::vector<double>, std::vector<double> > signal(
+    size_t                                   length,
+    int                                      cls,
+    const libnn::math::rng_uniform<double> & rng)
+{
+    std::vector<double> in(length);
+    for (auto & x : in) x = 0.1 * rng();
+
+    const size_t pos  = ::rand() % (length - 3);
+    const double sign = cls ? -1 : 1;
+
+    in[pos]     += sign * 0.5;
+    in[pos + 1] += sign * 1.0;
+    in[pos + 2] += sign * 0.5;
+
+    return std::pair<std::vector<double>, std::vector<double> >(
+        in, cls ? std::vector<double>({0.1, 0.9})
+                : std::vector<double>({0.9, 0.1}));
+}
+
+
+/**
+ *  \brief  Signal classification test
+ *
+ *  \param  loops  Training loop count
+ *
+ *  \return Count of errors
+ */
+static int test_signal_classification(size_t loops) {
+    std::cout << "Signal classification test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    const size_t length = 24;
+    libnn::math::rng_uniform<double> rng(-1, 1);
+
+    conv_t network(1, length);
+    network.add_conv1d(4, 3, 1, 1);
+    network.add_max_pool1d(4);
+    network.add_conv1d(4, 3);
+    network.add_max_pool1d(4);
+    network.set_dense(std::vector<size_t>({2}), conv_t::dense_t::BIAS);
+
+    tset_t set, test;
+    for (size_t i = 0; i < 32; ++i) {
+        set.push_back(signal(length, i % 2, rng));
+        test.push_back(signal(length, i % 2, rng));
+    }
+
+    conv_t::training_t training = network.training();
+    libnn::ml::const_learning_factor<double> criterion(0, 10.0);
+
+    for (size_t i = 0; i < loops; ++i) {
+        const double en2 = training(set, criterion);
+
+        if (0 == (i + 1) % 100)
+            std::cout
+                << "Loop " << i + 1 << ": |err|^2 == " << en2
+                << std::endl;
+    }
+
+    // Classify test signals
+    conv_t::function_t function = network.function();
+
+    size_t miss_cnt = 0;
+    for (auto & sample : test) {
+        const auto out = function(sample.first);
+
+        if ((out[1] > out[0]) != (sample.second[1] > sample.second[0]))
+            ++miss_cnt;
+    }
+
+    std::cout
+        << "Misclassified " << miss_cnt << " of " << test.size()
+        << std::endl;
+
+    if (miss_cnt) {
+        std::cout << "Failed to learn" << std::endl;
+
+        ++error_cnt;
+    }
+
+    // Serialisation round trip
+    std::stringstream ss1, ss2;
+    conv_t network_copy;
+
+    ss1 << network;
+    ss1 >> network_copy;
+    ss2 << network_copy;
+
+    if (ss1.str() != ss2.str()) {
+        std::cout
+            << "Serialisation mismatch:" << std::endl
+            << ss1.str() << std::endl
+            << ss2.str() << std::endl;
+
+        ++error_cnt;
+    }
+
+    conv_t::function_t function_copy = network_copy.function();
+
+    for (auto & sample : test) {
+        const auto out      = function(sample.first);
+        const auto out_copy = function_copy(sample.first);
+
+        for (size_t i = 0; i < out.size(); ++i)
+            if (std::abs(out[i] - out_copy[i]) > 1e-4) {
+                std::cout
+                    << "Deserialised network output mismatch: "
+                    << out[i] << " != " << out_copy[i]
+                    << std::endl;
+
+                ++error_cnt;
+            }
+    }
+
+    std::cout << "Network:" << std::endl << network;
+
+    std::cout << "Signal classification test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/** Unit test */
+static int main_impl(int argc, char * const argv[]) {
+    int exit_code = 64;  // pessimistic assumption
+
+    size_t loops = 1000;
+    if (1 < argc) loops = ::atoi(argv[1]);
+
+    do {  // pragmatic do ... while (0) loop allowing for breaks
+        exit_code = test_conv_eval();
+        if (0 != exit_code) break;
+
+        exit_code = test_conv_gradient();
+        if (0 != exit_code) break;
+
+        exit_code = test_signal_classification(loops);
+        if (0 != exit_code) break;
+
+    } while (0);  // end of pragmatic loop
+
+    std::cerr
+        << "Exit code: " << exit_code
+        << std::endl;
+
+    return exit_code;
+}
+
+/** Unit test exception-safe wrapper */
+int main(int argc, char * const argv[]) {
+    int exit_code = 128;
+
+    try {
+        exit_code = main_impl(argc, argv);
+    }
+    catch (const std::exception & x) {
+        std::cerr
+            << "Standard exception caught: "
+            << x.what()
+            << std::endl;
+    }
+    catch (...) {
+        std::cerr
+            << "Unhandled non-standard exception caught"
+            << std::endl;
+    }
+
+    return exit_code;
+}
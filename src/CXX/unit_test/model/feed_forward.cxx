@@ -45,9 +45,14 @@
 #include <libnn/math/util.hxx>
 
 #include <iostream>
+#include <sstream>
+#include <regex>
 #include <exception>
 #include <stdexcept>
 #include <list>
+#include <vector>
+#include <utility>
+#include <algorithm>
 
 
 /** Identity activation functor */
@@ -80,6 +85,19 @@ std::ostream & operator << (
     return out << "identity";
 }
 
+/** Identity activation functor deserialisation */
+template <typename Base_t>
+std::istream & operator >> (
+    std::istream & in,
+    identity<Base_t> & id)
+{
+    std::string str;
+    if ((in >> str).fail() || "identity" != str)
+        throw std::runtime_error("identity expected");
+
+    return in;
+}
+
 
 /**
  *  \brief  Feed-forward test
@@ -233,6 +251,134 @@ static int test_ff(size_t loops, double alpha, double sigma) {
 }
 
 
+/**
+ *  \brief  Check network layers
+ *
+ *  \param  nn        Network
+ *  \param  expected  Expected layers
+ *
+ *  \return Count of errors
+ */
+static int check_layers(const nn_t & nn, const nn_t::layers_t & expected) {
+    int error_cnt = 0;
+
+    if (nn.layer_cnt() != expected.size()) {
+        std::cout
+            << "Layer count mismatch: " << nn.layer_cnt()
+            << " != " << expected.size()
+            << std::endl;
+
+        return 1;
+    }
+
+    for (size_t i = 0; i < expected.size(); ++i) {
+        const auto & layer = nn.layer(i);
+
+        std::cout
+            << "Layer " << i << ": [" << layer.begin << ", " << layer.end
+            << ')' << std::endl;
+
+        if (layer.begin != expected[i].begin || layer.end != expected[i].end) {
+            std::cout << "Layer mismatch" << std::endl;
+
+            ++error_cnt;
+        }
+
+        for (size_t n = layer.begin; n < layer.end; ++n)
+            if (nn.layer_of(n) != i) {
+                std::cout << "Neuron " << n << " layer mismatch" << std::endl;
+
+                ++error_cnt;
+            }
+    }
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  Feed-forward layers test
+ *
+ *  \return Count of errors
+ */
+static int test_layers() {
+    std::cout << "Feed-forward NN layers test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    libnn::math::rng_uniform<double> rng(-1, 1);
+
+    nn_t nn(std::vector<size_t>({4, 6, 5, 3}), rng,
+        nn_t::BIAS | nn_t::LATERAL);
+
+    nn_t::layers_t expected;
+    expected.emplace_back(1, 5);
+    expected.emplace_back(5, 11);
+    expected.emplace_back(11, 16);
+    expected.emplace_back(16, 19);
+
+    error_cnt += check_layers(nn, expected);
+
+    if (0 != nn.bias()) {
+        std::cout << "Bias index mismatch" << std::endl;
+
+        ++error_cnt;
+    }
+
+    // Serialisation keeps the layers
+    std::stringstream ss;
+    ss << nn;
+
+    nn_t nn_copy;
+    ss >> nn_copy;
+
+    error_cnt += check_layers(nn_copy, expected);
+
+    // Layers are inferred if not serialised (older format)
+    std::stringstream ss_legacy(std::regex_replace(ss.str(),
+        std::regex("[ \\t]*(Layer|Bias) [^\\n]*\\n"), std::string()));
+
+    nn_t nn_legacy;
+    ss_legacy >> nn_legacy;
+
+    error_cnt += check_layers(nn_legacy, expected);
+
+    // Layers must partition the neurons, layer 0 being the input layer
+    const std::vector<std::vector<std::pair<size_t, size_t> > > invalid({
+        {{1, 5}, {6, 11}, {11, 16}, {16, 19}},  // gap
+        {{1, 5}, {5, 11}, {11, 16}},            // neurons not covered
+        {{1, 4}, {4, 11}, {11, 16}, {16, 19}},  // not the input layer
+    });
+
+    std::for_each(invalid.begin(), invalid.end(),
+    [&nn, &error_cnt](const std::vector<std::pair<size_t, size_t> > & spec) {
+        nn_t::layers_t layers;
+        std::for_each(spec.begin(), spec.end(),
+        [&layers](const std::pair<size_t, size_t> & range) {
+            layers.emplace_back(range.first, range.second);
+        });
+
+        try {
+            nn.layers(layers);
+
+            std::cout << "Invalid layers accepted" << std::endl;
+
+            ++error_cnt;
+        }
+        catch (const std::logic_error & x) {
+            std::cout << "Invalid layers rejected: " << x.what()
+                << std::endl;
+        }
+    });
+
+    error_cnt += check_layers(nn, expected);
+
+    std::cout << "Feed-forward NN layers test END" << std::endl;
+
+    return error_cnt;
+}
+
+
 /** Unit test */
 static int main_impl(int argc, char * const argv[]) {
     int exit_code = 64;  // pessimistic assumption
@@ -250,6 +396,9 @@ static int main_impl(int argc, char * const argv[]) {
         exit_code = test_ff(loops, alpha, sigma);
         if (0 != exit_code) break;
 
+        exit_code = test_layers();
+        if (0 != exit_code) break;
+
     } while (0);  // end of pragmatic loop
 
     std::cerr
@@ -0,0 +1,433 @@
+/**
+ *  Recurrent neural network unit test
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "config.hxx"
+
+#include <libnn/model/recurrent.hxx>
+#include <libnn/io/sigmoid.hxx>
+#include <libnn/io/recurrent.hxx>
+#include <libnn/math/sigmoid.hxx>
+#include <libnn/math/util.hxx>
+
+#include <vector>
+#include <iostream>
+#include <sstream>
+#include <exception>
+#include <stdexcept>
+#include <cmath>
+
+
+/** Identity activation functor */
+template <typename Base_t>
+class identity {
+    public:
+
+    /** Identity function */
+    Base_t operator () (const Base_t & x) const { return x; }
+
+    /** Identity derivation (i.e. 1) */
+    Base_t d(const Base_t & x) const { return 1; }
+
+};  // end of template class identity
+
+/** Identity activation functor serialisation */
+template <typename Base_t>
+std::ostream & operator << (
+    std::ostream & out,
+    const identity<Base_t> & id)
+{
+    return out << "identity";
+}
+
+/** Identity activation functor deserialisation */
+template <typename Base_t>
+std::istream & operator >> (
+    std::istream & in,
+    identity<Base_t> & id)
+{
+    std::string str;
+    if ((in >> str).fail() || "identity" != str)
+        throw std::runtime_error("identity expected");
+
+    return in;
+}
+
+/** Linear recurrent neural network model */
+typedef libnn::model::recurrent<double, identity<double> > lin_rnn_t;
+
+/** Logistic recurrent neural network model */
+typedef libnn::model::recurrent<double, libnn::math::logistic_fn<double> >
+    log_rnn_t;
+
+/** Sequence */
+typedef std::vector<std::vector<double> > sequence_t;
+
+
+/** Constant weight initialiser */
+class const_weight {
+    private:
+
+    const double m_w;  /**< Weight */
+
+    public:
+
+    /** Constructor */
+    const_weight(double w): m_w(w) {}
+
+    /** Weight */
+    double operator () () const { return m_w; }
+
+};  // end of class const_weight
+
+
+/**
+ *  \brief  Elman network time-step evaluation test
+ *
+ *  h(t) = a x(t) + c h(t-1), y(t) = b h(t)
+ *
+ *  \return Count of errors
+ */
+static int test_elman_step() {
+    std::cout << "Elman network time-step evaluation test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    const_weight w_init(1);
+    lin_rnn_t rnn(std::vector<size_t>({1, 1, 1}), w_init, lin_rnn_t::ELMAN);
+
+    // Neurons: input, context, hidden, output
+    auto & topo = rnn.topology();
+    auto & in  = topo.get_neuron(0);
+    auto & ctx = topo.get_neuron(1);
+    auto & hid = topo.get_neuron(2);
+    auto & out = topo.get_neuron(3);
+
+    const double a = 0.5, c = 0.25, b = 2;
+    hid.set_dendrite(in,  a);
+    hid.set_dendrite(ctx, c);
+    out.set_dendrite(hid, b);
+
+    lin_rnn_t::function_t function = rnn.function();
+
+    const std::vector<double> xs({1, 2, -1, 0, 4, 3});
+
+    std::vector<double> input(1), output(1);
+
+    for (int pass = 0; pass < 2; ++pass) {
+        double h = 0;
+        for (size_t t = 0; t < xs.size(); ++t) {
+            input[0] = xs[t];
+            function.step(input, output);
+
+            h = a * xs[t] + c * h;
+            const double y = b * h;
+
+            std::cout
+                << "x(" << t << ") == " << xs[t]
+                << ", y(" << t << ") == " << output[0]
+                << ", expected " << y
+                << std::endl;
+
+            if (std::abs(output[0] - y) > 1e-12) {
+                std::cout << "Unexpected output" << std::endl;
+
+                ++error_cnt;
+            }
+        }
+
+        function.reset();  // start over
+    }
+
+    std::cout << "Elman network time-step evaluation test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  Compute error over a sequence
+ *
+ *  \param  rnn      Network
+ *  \param  inputs   Input sequence
+ *  \param  outputs  Desired output sequence
+ *
+ *  \return Error (half of error norm squared sum)
+ */
+static double sequence_error(
+    const log_rnn_t  & rnn,
+    const sequence_t & inputs,
+    const sequence_t & outputs)
+{
+    log_rnn_t::function_t function = rnn.function();
+
+    double err = 0;
+    for (size_t t = 0; t < inputs.size(); ++t) {
+        const auto output = function(inputs[t]);
+
+        for (size_t i = 0; i < output.size(); ++i) {
+            const double d = output[i] - outputs[t][i];
+            err += d * d / 2;
+        }
+    }
+
+    return err;
+}
+
+
+/**
+ *  \brief  BPTT gradient test
+ *
+ *  Trains the network by one (small) step and compares the error change
+ *  with the change predicted by the gradient.
+ *
+ *  \return Count of errors
+ */
+static int test_bptt_gradient() {
+    std::cout << "BPTT gradient test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    libnn::math::rng_uniform<double> w_init(-1, 1);
+    libnn::math::rng_uniform<double> rng;
+
+    log_rnn_t rnn(std::vector<size_t>({2, 3, 2}), w_init,
+        log_rnn_t::BIAS | log_rnn_t::ELMAN | log_rnn_t::JORDAN);
+
+    sequence_t inputs, outputs;
+    for (size_t t = 0; t < 8; ++t) {
+        inputs.push_back(std::vector<double>({rng(), rng()}));
+        outputs.push_back(std::vector<double>({rng(), rng()}));
+    }
+
+    const double err0 = sequence_error(rnn, inputs, outputs);
+
+    // Single update by window spanning the whole sequence (i.e. full BPTT)
+    const double eps = 1e-4;
+    auto criterion = [eps](double err_n2) -> double { return eps; };
+
+    log_rnn_t::training_t training = rnn.training(inputs.size());
+    training(inputs, outputs, criterion);
+
+    const double err1 = sequence_error(rnn, inputs, outputs);
+
+    double grad_n2 = 0;
+    const auto & grad = training.gradient();
+    for (size_t i = 0; i < grad.size(); ++i)
+        grad_n2 += grad[i] * grad[i];
+
+    const double derr     = err1 - err0;
+    const double derr_exp = -eps / inputs.size() * grad_n2;
+
+    std::cout
+        << "Error change: " << derr
+        << ", expected " << derr_exp
+        << std::endl;
+
+    if (!(std::abs(derr - derr_exp) <= 1e-2 * std::abs(derr_exp))) {
+        std::cout << "Gradient mismatch" << std::endl;
+
+        ++error_cnt;
+    }
+
+    std::cout << "BPTT gradient test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/**
+ *  \brief  Truncated BPTT training test
+ *
+ *  The network shall learn to delay its input by 1 time step.
+ *
+ *  \param  loops  Training loop count
+ *  \param  alpha  Learning factor
+ *  \param  sigma  Acceptable error
+ *
+ *  \return Count of errors
+ */
+static int test_bptt_train(size_t loops, double alpha, double sigma) {
+    std::cout << "Truncated BPTT training test BEGIN" << std::endl;
+
+    int error_cnt = 0;
+
+    lin_rnn_t rnn(1, 2, 1, lin_rnn_t::ELMAN);
+
+    libnn::math::rng_uniform<double> rng(-1, 1);
+
+    sequence_t inputs, outputs;
+    double x_prev = 0;
+    for (size_t t = 0; t < 64; ++t) {
+        const double x = rng();
+
+        inputs.push_back(std::vector<double>({x}));
+        outputs.push_back(std::vector<double>({x_prev}));
+
+        x_prev = x;
+    }
+
+    lin_rnn_t::training_t training = rnn.training(4);
+    libnn::ml::const_learning_factor<double> criterion(sigma, alpha);
+
+    double en2 = 0, en2_order = -1;
+    for (size_t i = 0; i < loops; ++i) {
+        training.reset();
+        en2 = training(inputs, outputs, criterion);
+
+        // Print each order-magnitude improvement
+        if (en2 / en2_order <= 0.1) {
+            std::cout
+                << "Loop " << i + 1 << ": |err|^2 == " << en2
+                << std::endl;
+
+            en2_order = en2;
+        }
+
+        if (en2 <= sigma) break;
+    }
+
+    std::cout << "|err|^2 == " << en2 << std::endl;
+
+    if (!(en2 <= sigma)) {
+        std::cout << "Failed to learn" << std::endl;
+
+        ++error_cnt;
+    }
+
+    // Serialisation round trip
+    std::stringstream ss1, ss2;
+    lin_rnn_t rnn_copy;
+
+    ss1 << rnn;
+    ss1 >> rnn_copy;
+    ss2 << rnn_copy;
+
+    if (ss1.str() != ss2.str()) {
+        std::cout
+            << "Serialisation mismatch:" << std::endl
+            << ss1.str() << std::endl
+            << ss2.str() << std::endl;
+
+        ++error_cnt;
+    }
+
+    // Streaming inference by the deserialised network
+    lin_rnn_t::function_t function = rnn_copy.function();
+
+    double err_n2 = 0;
+    std::vector<double> output(1);
+    for (size_t t = 0; t < inputs.size(); ++t) {
+        function.step(inputs[t], output);
+
+        const double d = output[0] - outputs[t][0];
+        err_n2 += d * d;
+    }
+
+    err_n2 /= inputs.size();
+
+    std::cout << "Inference |err|^2 == " << err_n2 << std::endl;
+
+    if (!(err_n2 <= sigma * 10)) {
+        std::cout << "Failed to generalise" << std::endl;
+
+        ++error_cnt;
+    }
+
+    std::cout << "Network:" << std::endl << rnn;
+
+    std::cout << "Truncated BPTT training test END" << std::endl;
+
+    return error_cnt;
+}
+
+
+/** Unit test */
+static int main_impl(int argc, char * const argv[]) {
+    int exit_code = 64;  // pessimistic assumption
+
+    size_t loops = 10000;
+    if (1 < argc) loops = ::atoi(argv[1]);
+
+    double alpha = 0.5;  // learning factor
+    if (2 < argc) alpha = ::atof(argv[2]);
+
+    double sigma = 1e-6;  // acceptable error
+    if (3 < argc) sigma = ::atof(argv[3]);
+
+    do {  // pragmatic do ... while (0) loop allowing for breaks
+        exit_code = test_elman_step();
+        if (0 != exit_code) break;
+
+        exit_code = test_bptt_gradient();
+        if (0 != exit_code) break;
+
+        exit_code = test_bptt_train(loops, alpha, sigma);
+        if (0 != exit_code) break;
+
+    } while (0);  // end of pragmatic loop
+
+    std::cerr
+        << "Exit code: " << exit_code
+        << std::endl;
+
+    return exit_code;
+}
+
+/** Unit test exception-safe wrapper */
+int main(int argc, char * const argv[]) {
+    int exit_code = 128;
+
+    try {
+        exit_code = main_impl(argc, argv);
+    }
+    catch (const std::exception & x) {
+        std::cerr
+            << "Standard exception caught: "
+            << x.what()
+            << std::endl;
+    }
+    catch (...) {
+        std::cerr
+            << "Unhandled non-standard exception caught"
+            << std::endl;
+    }
+
+    return exit_code;
+}
@@ -0,0 +1,1176 @@
+/**
+ *  Python binding
+ *
+ *  \date    2026/10/17
+ *  \author  Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2015, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "config.hxx"
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <libnn/topo/nn.hxx>
+#include <libnn/model/feed_forward.hxx>
+#include <libnn/model/perceptron.hxx>
+#include <libnn/ml/nn_func.hxx>
+#include <libnn/ml/backpropagation.hxx>
+#include <libnn/misc/array_view.hxx>
+#include <libnn/math/sigmoid.hxx>
+#include <libnn/math/util.hxx>
+
+#include <vector>
+#include <string>
+#include <mutex>
+#include <new>
+#include <exception>
+#include <stdexcept>
+#include <algorithm>
+#include <utility>
+#include <random>
+#include <cstdlib>
+
+
+/** Activation function */
+typedef libnn::math::logistic_fn<double> act_fn_t;
+
+/** Network topology */
+typedef libnn::topo::nn<double, act_fn_t> nn_t;
+
+/** Network topology function */
+typedef libnn::ml::nn_func<double, act_fn_t> nn_func_t;
+
+/** Network topology training */
+typedef libnn::ml::backpropagation<double, act_fn_t> nn_train_t;
+
+/** Feed-forward network */
+typedef libnn::model::feed_forward<double, act_fn_t> feed_forward_t;
+
+/** Perceptron */
+typedef libnn::model::perceptron<double> perceptron_t;
+
+typedef libnn::misc::matrix_view<const double>   inputs_t;  /**< Inputs  */
+typedef libnn::misc::matrix_view<double>         outputs_t; /**< Outputs */
+typedef libnn::misc::training_view<const double> tset_t;    /**< Tr. set */
+
+/** Training criterion */
+typedef libnn::ml::const_learning_factor<double> criterion_t;
+
+
+/**
+ *  \brief  Object box
+ *
+ *  The library functions and trainings are polymorphic classes without
+ *  virtual destructors; boxing allows for their dynamic allocation.
+ *
+ *  \tparam  T  Object type
+ */
+template <class T>
+struct box {
+    T obj;  /**< Object */
+
+    /** Constructor */
+    template <class... Args>
+    box(Args &&... args): obj(std::forward<Args>(args)...) {}
+
+};  // end of template struct box
+
+
+/** Rows evaluated at once (bounds the evaluation buffers) */
+static const size_t block_rows = 256;
+
+/** \c numpy.empty (\c NULL if NumPy isn't available) */
+static PyObject * numpy_empty = NULL;
+
+
+/**
+ *  \brief  Buffer of \c float64 matrix
+ *
+ *  Exported by a Python object supporting the buffer protocol
+ *  (e.g. NumPy array, \c array.array or \c memoryview).
+ *  1-D buffer is a single row; the rows must be contiguous
+ *  (but may be padded).
+ *  The data are used in place (never copied).
+ */
+class buffer {
+    private:
+
+    Py_buffer m_view;  /**< Buffer view         */
+    bool      m_held;  /**< View is held        */
+
+    /** Check item format */
+    static bool is_double(const char * format) {
+        if (NULL == format) return false;
+
+        const std::string f(format);
+        if ("d" == f || "@d" == f || "=d" == f) return true;
+
+        const unsigned probe = 1;
+        if (*(const char *)&probe)  // little endian
+            return "<d" == f;
+
+        return ">d" == f || "!d" == f;
+    }
+
+    public:
+
+    /** Constructor */
+    buffer(): m_held(false) {}
+
+    /**
+     *  \brief  Get buffer
+     *
+     *  \param  obj       Exporting object
+     *  \param  writable  Writable buffer required
+     *  \param  name      Argument name (for error messages)
+     *
+     *  \return \c true on success, \c false with Python exception set
+     */
+    bool get(PyObject * obj, bool writable, const char * name) {
+        int flags = PyBUF_STRIDES | PyBUF_FORMAT;
+        if (writable) flags |= PyBUF_WRITABLE;
+
+        if (PyObject_GetBuffer(obj, &m_view, flags)) return false;
+
+        m_held = true;
+
+        if (!is_double(m_view.format) || sizeof(double) != m_view.itemsize) {
+            PyErr_Format(PyExc_TypeError,
+                "%s: float64 items expected", name);
+            return false;
+        }
+
+        if (m_view.ndim < 1 || 2 < m_view.ndim) {
+            PyErr_Format(PyExc_ValueError,
+                "%s: 1-D or 2-D array expected", name);
+            return false;
+        }
+
+        if ((Py_ssize_t)sizeof(double) != m_view.strides[m_view.ndim - 1]
+        ||  (2 == m_view.ndim && 1 < m_view.shape[0] && (
+                m_view.strides[0] % (Py_ssize_t)sizeof(double) ||
+                m_view.strides[0] < m_view.shape[1] *
+                    (Py_ssize_t)sizeof(double))))
+        {
+            PyErr_Format(PyExc_ValueError,
+                "%s: rows must be contiguous (C order)", name);
+            return false;
+        }
+
+        return true;
+    }
+
+    /** Dimension count */
+    int ndim() const { return m_view.ndim; }
+
+    /** Row count */
+    size_t rows() const { return 1 == m_view.ndim ? 1 : m_view.shape[0]; }
+
+    /** Column count */
+    size_t cols() const { return m_view.shape[m_view.ndim - 1]; }
+
+    /** Row stride (items) */
+    size_t stride() const {
+        return 1 == m_view.ndim || m_view.shape[0] < 2
+            ? cols() : m_view.strides[0] / sizeof(double);
+    }
+
+    /** Data */
+    double * data() const { return (double *)m_view.buf; }
+
+    /** Read-only matrix view */
+    inputs_t inputs() const {
+        return inputs_t(data(), rows(), cols(), stride());
+    }
+
+    /** Destructor */
+    ~buffer() { if (m_held) PyBuffer_Release(&m_view); }
+
+    /** Copying is forbidden */
+    buffer(const buffer & orig) = delete;
+
+    /** Assignment is forbidden */
+    void operator = (const buffer & rarg) = delete;
+
+};  // end of class buffer
+
+
+/**
+ *  \brief  Create output array
+ *
+ *  NumPy array if NumPy is available, \c float64 \c memoryview
+ *  (of a \c bytearray) otherwise.
+ *
+ *  \param  rows  Row count
+ *  \param  cols  Column count
+ *  \param  ndim  Dimension count (1 means single row)
+ *
+ *  \return New reference (\c NULL with Python exception set on error)
+ */
+static PyObject * new_array(size_t rows, size_t cols, int ndim) {
+    PyObject * shape = 1 == ndim
+        ? Py_BuildValue("(n)", (Py_ssize_t)cols)
+        : Py_BuildValue("(nn)", (Py_ssize_t)rows, (Py_ssize_t)cols);
+
+    if (NULL == shape) return NULL;
+
+    PyObject * array = NULL;
+
+    if (numpy_empty) {
+        array = PyObject_CallFunctionObjArgs(numpy_empty, shape, NULL);
+    }
+    else {
+        PyObject * bytes = PyByteArray_FromStringAndSize(NULL,
+            rows * cols * sizeof(double));
+
+        if (bytes) {
+            PyObject * view = PyMemoryView_FromObject(bytes);
+            Py_DECREF(bytes);
+
+            if (view) {
+                array = PyObject_CallMethod(view, "cast", "sO", "d", shape);
+                Py_DECREF(view);
+            }
+        }
+    }
+
+    Py_DECREF(shape);
+
+    return array;
+}
+
+
+/**
+ *  \brief  Run without the GIL
+ *
+ *  Releases the GIL, locks the object mutex and runs the function.
+ *  C++ exceptions are translated to Python ones.
+ *
+ *  \tparam Fn  Function type
+ *  \param  mx  Object mutex
+ *  \param  fn  Function
+ *
+ *  \return \c true on success, \c false with Python exception set
+ */
+template <class Fn>
+static bool nogil(std::mutex & mx, Fn fn) {
+    PyObject *  type = NULL;
+    std::string error;
+
+    Py_BEGIN_ALLOW_THREADS
+
+    try {
+        std::lock_guard<std::mutex> lock(mx);
+        fn();
+    }
+    catch (const std::bad_alloc & ) {
+        type = PyExc_MemoryError;
+    }
+    catch (const std::logic_error & x) {
+        type  = PyExc_ValueError;
+        error = x.what();
+    }
+    catch (const std::range_error & x) {
+        type  = PyExc_ValueError;
+        error = x.what();
+    }
+    catch (const std::exception & x) {
+        type  = PyExc_RuntimeError;
+        error = x.what();
+    }
+    catch (...) {
+        type  = PyExc_RuntimeError;
+        error = "unknown exception";
+    }
+
+    Py_END_ALLOW_THREADS
+
+    if (NULL == type) return true;
+
+    if (PyExc_MemoryError == type)
+        PyErr_NoMemory();
+    else
+        PyErr_SetString(type, error.c_str());
+
+    return false;
+}
+
+
+/**
+ *  \brief  Get evaluation buffers
+ *
+ *  \param  x            Inputs
+ *  \param  out          Outputs (\c None means new array)
+ *  \param  in_size      Network input size
+ *  \param  out_size     Network output size
+ *  \param  in_buf       Inputs buffer
+ *  \param  out_buf      Outputs buffer
+ *
+ *  \return Outputs (new reference; \c NULL with Python exception set)
+ */
+static PyObject * eval_buffers(
+    PyObject * x,
+    PyObject * out,
+    size_t     in_size,
+    size_t     out_size,
+    buffer   & in_buf,
+    buffer   & out_buf)
+{
+    if (!in_buf.get(x, false, "x")) return NULL;
+
+    if (in_size != in_buf.cols()) {
+        PyErr_Format(PyExc_ValueError,
+            "x: %zu columns expected (network input size)", in_size);
+        return NULL;
+    }
+
+    PyObject * result = out;
+    if (NULL == out || Py_None == out)
+        result = new_array(in_buf.rows(), out_size, in_buf.ndim());
+    else
+        Py_INCREF(result);
+
+    if (NULL == result) return NULL;
+
+    if (!out_buf.get(result, true, "out")) {
+        Py_DECREF(result);
+        return NULL;
+    }
+
+    if (out_size != out_buf.cols() || in_buf.rows() != out_buf.rows()) {
+        PyErr_Format(PyExc_ValueError,
+            "out: %zu x %zu array expected", in_buf.rows(), out_size);
+
+        Py_DECREF(result);
+        return NULL;
+    }
+
+    return result;
+}
+
+
+/**
+ *  \brief  Get training buffers
+ *
+ *  \param  x         Inputs
+ *  \param  y         Desired outputs
+ *  \param  in_size   Network input size
+ *  \param  out_size  Network output size
+ *  \param  x_buf     Inputs buffer
+ *  \param  y_buf     Desired outputs buffer
+ *
+ *  \return \c true on success, \c false with Python exception set
+ */
+static bool train_buffers(
+    PyObject * x,
+    PyObject * y,
+    size_t     in_size,
+    size_t     out_size,
+    buffer   & x_buf,
+    buffer   & y_buf)
+{
+    if (!x_buf.get(x, false, "x") || !y_buf.get(y, false, "y"))
+        return false;
+
+    if (in_size != x_buf.cols() || out_size != y_buf.cols()) {
+        PyErr_Format(PyExc_ValueError,
+            "x, y: %zu and %zu columns expected "
+            "(network input and output sizes)", in_size, out_size);
+        return false;
+    }
+
+    if (x_buf.rows() != y_buf.rows()) {
+        PyErr_SetString(PyExc_ValueError,
+            "x, y: row counts differ");
+        return false;
+    }
+
+    return true;
+}
+
+
+/**
+ *  \brief  Train on training set view
+ *
+ *  \tparam Training  Training type
+ *  \param  training  Training
+ *  \param  set       Training set
+ *  \param  alpha     Learning factor
+ *  \param  epochs    Epoch count
+ *  \param  batch     Batch (or on-line) training
+ *
+ *  \return Error norm squared average (of the last epoch)
+ */
+template <class Training>
+static double train_set(
+    Training     & training,
+    const tset_t & set,
+    double         alpha,
+    size_t         epochs,
+    bool           batch)
+{
+    criterion_t criterion(0, alpha);
+
+    double error = 0;
+    for (size_t e = 0; e < epochs; ++e) {
+        if (batch) {
+            error = training(set, criterion);
+            continue;
+        }
+
+        error = 0;
+        for (auto iter = set.begin(); iter != set.end(); ++iter)
+            error += training(iter->first, iter->second, criterion);
+
+        if (set.size()) error /= set.size();
+    }
+
+    return error;
+}
+
+
+//
+// Model (feed-forward network, perceptron) type
+//
+
+/**
+ *  \brief  Model object
+ *
+ *  \tparam  Model  Model type
+ */
+template <class Model>
+struct model_object {
+    typedef typename Model::function_t function_t;  /**< Function */
+    typedef typename Model::training_t training_t;  /**< Training */
+
+    PyObject_HEAD
+    Model *           model;     /**< Model                        */
+    box<function_t> * function;  /**< Function (NULL if not valid) */
+    box<training_t> * training;  /**< Training (NULL if not valid) */
+    std::mutex *      mx;        /**< Object mutex                 */
+
+    /** Input size */
+    size_t input_size() const { return model->layer(0).size(); }
+
+    /** Output size */
+    size_t output_size() const {
+        return model->layer(model->layer_cnt() - 1).size();
+    }
+
+    /** Reset model */
+    void reset(Model * m) {
+        delete function; function = NULL;
+        delete training; training = NULL;
+        delete model;    model    = m;
+    }
+
+};  // end of template struct model_object
+
+
+/** Model type object */
+template <class Model>
+struct model_type {
+    static PyTypeObject type;  /**< Type object */
+};  // end of template struct model_type
+
+/** \cond */
+template <class Model>
+PyTypeObject model_type<Model>::type = { PyVarObject_HEAD_INIT(NULL, 0) };
+/** \endcond */
+
+
+/** Model object constructor */
+template <class Model>
+static PyObject * model_new(PyTypeObject * type, PyObject * args, PyObject * kw) {
+    model_object<Model> * self = (model_object<Model> *)type->tp_alloc(type, 0);
+    if (NULL == self) return NULL;
+
+    self->model    = NULL;
+    self->function = NULL;
+    self->training = NULL;
+    self->mx       = new(std::nothrow) std::mutex();
+
+    if (NULL == self->mx) {
+        Py_DECREF(self);
+        return PyErr_NoMemory();
+    }
+
+    return (PyObject *)self;
+}
+
+
+/** Model object initialiser */
+template <class Model>
+static int model_init(model_object<Model> * self, PyObject * args, PyObject * kw) {
+    static const char * kwlist[] = {
+        "layers", "bias", "lateral", "weight", "seed", NULL };
+
+    PyObject * layers;
+    int        bias    = 1;
+    int        lateral = 0;
+    double     weight  = 1.0;
+    PyObject * seed    = Py_None;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kw, "O|ppdO", (char **)kwlist,
+        &layers, &bias, &lateral, &weight, &seed))
+    {
+        return -1;
+    }
+
+    std::vector<size_t> spec;
+
+    PyObject * seq = PySequence_Fast(layers, "layers: sequence expected");
+    if (NULL == seq) return -1;
+
+    for (Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(seq); ++i) {
+        const size_t size =
+            PyLong_AsSize_t(PySequence_Fast_GET_ITEM(seq, i));
+
+        if (PyErr_Occurred()) {
+            Py_DECREF(seq);
+            return -1;
+        }
+
+        spec.push_back(size);
+    }
+
+    Py_DECREF(seq);
+
+    typedef libnn::math::rng_uniform_seeded<double> w_init_t;
+
+    w_init_t::seed_t s;
+    if (Py_None != seed) {
+        s = PyLong_AsUnsignedLong(seed);
+        if (PyErr_Occurred()) return -1;
+    }
+    else
+        s = std::random_device()();
+
+    const int features =
+        (bias    ? Model::BIAS    : 0) |
+        (lateral ? Model::LATERAL : 0);
+
+    Model * model = NULL;
+    if (!nogil(*self->mx, [&]() {
+        w_init_t w_init(-weight, weight, s);
+        model = new Model(spec, w_init, features);
+    })) return -1;
+
+    std::lock_guard<std::mutex> lock(*self->mx);
+    self->reset(model);
+
+    return 0;
+}
+
+
+/** Model object destructor */
+template <class Model>
+static void model_dealloc(model_object<Model> * self) {
+    self->reset(NULL);
+    delete self->mx;
+
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+
+/** Check model initialisation */
+template <class Model>
+static bool model_check(model_object<Model> * self) {
+    if (self->model) return true;
+
+    PyErr_SetString(PyExc_RuntimeError, "network not initialised");
+    return false;
+}
+
+
+/** Model evaluation */
+template <class Model>
+static PyObject * model_eval(
+    model_object<Model> * self,
+    PyObject            * args,
+    PyObject            * kw)
+{
+    static const char * kwlist[] = { "x", "out", NULL };
+
+    PyObject * x;
+    PyObject * out = Py_None;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kw, "O|O", (char **)kwlist,
+        &x, &out))
+    {
+        return NULL;
+    }
+
+    if (!model_check(self)) return NULL;
+
+    buffer in_buf, out_buf;
+    PyObject * result = eval_buffers(x, out,
+        self->input_size(), self->output_size(), in_buf, out_buf);
+
+    if (NULL == result) return NULL;
+
+    const inputs_t inputs = in_buf.inputs();
+    const size_t   stride = out_buf.stride();
+
+    if (!nogil(*self->mx, [&]() {
+        if (NULL == self->function)
+            self->function = new box<typename Model::function_t>(
+                self->model->function());
+
+        for (size_t b = 0; b < inputs.rows(); b += block_rows) {
+            const size_t e = std::min(b + block_rows, inputs.rows());
+
+            self->function->obj.batch(inputs.slice(b, e),
+                out_buf.data() + b * stride, stride);
+        }
+    })) {
+        Py_DECREF(result);
+        return NULL;
+    }
+
+    return result;
+}
+
+
+/** Model training */
+template <class Model>
+static PyObject * model_train(
+    model_object<Model> * self,
+    PyObject            * args,
+    PyObject            * kw)
+{
+    static const char * kwlist[] = {
+        "x", "y", "alpha", "epochs", "batch", NULL };
+
+    PyObject * x;
+    PyObject * y;
+    double     alpha  = 0.1;
+    Py_ssize_t epochs = 1;
+    int        batch  = 1;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kw, "OO|dnp", (char **)kwlist,
+        &x, &y, &alpha, &epochs, &batch))
+    {
+        return NULL;
+    }
+
+    if (!model_check(self)) return NULL;
+
+    buffer x_buf, y_buf;
+    if (!train_buffers(x, y, self->input_size(), self->output_size(),
+        x_buf, y_buf)) return NULL;
+
+    const tset_t set(x_buf.inputs(), y_buf.inputs());
+
+    double error = 0;
+    if (!nogil(*self->mx, [&]() {
+        if (NULL == self->training)
+            self->training = new box<typename Model::training_t>(
+                self->model->training());
+
+        error = train_set(self->training->obj, set, alpha,
+            std::max<Py_ssize_t>(0, epochs), batch);
+    })) return NULL;
+
+    return PyFloat_FromDouble(error);
+}
+
+
+/** Model input size getter */
+template <class Model>
+static PyObject * model_input_size(model_object<Model> * self, void * ) {
+    if (!model_check(self)) return NULL;
+
+    return PyLong_FromSize_t(self->input_size());
+}
+
+
+/** Model output size getter */
+template <class Model>
+static PyObject * model_output_size(model_object<Model> * self, void * ) {
+    if (!model_check(self)) return NULL;
+
+    return PyLong_FromSize_t(self->output_size());
+}
+
+
+/** Model layers getter */
+template <class Model>
+static PyObject * model_layers(model_object<Model> * self, void * ) {
+    if (!model_check(self)) return NULL;
+
+    PyObject * layers = PyList_New(self->model->layer_cnt());
+    if (NULL == layers) return NULL;
+
+    for (size_t i = 0; i < self->model->layer_cnt(); ++i)
+        PyList_SET_ITEM(layers, i,
+            PyLong_FromSize_t(self->model->layer(i).size()));
+
+    return layers;
+}
+
+
+/** Eval method doc string */
+static const char * eval_doc =
+    "eval(x, out=None)\n"
+    "\n"
+    "Evaluate the network for rows of x (2-D float64 array; 1-D array\n"
+    "is a single input).\n"
+    "The outputs are written to out (writable float64 array) or to a new\n"
+    "array (NumPy array if NumPy is available).\n"
+    "The arrays are accessed in place (no conversion); the library makes\n"
+    "one copy in (inputs) and one copy out (outputs) of its work matrix.\n"
+    "The GIL is released.";
+
+/** Train method doc string */
+static const char * train_doc =
+    "train(x, y, alpha=0.1, epochs=1, batch=True)\n"
+    "\n"
+    "Train the network (backpropagation) to map rows of x to rows of y\n"
+    "(2-D float64 arrays) with learning factor alpha.\n"
+    "Batch training updates the weights once per epoch, on-line training\n"
+    "after each sample.\n"
+    "The arrays are accessed in place (no conversion); the library copies\n"
+    "the rows to its work matrices.\n"
+    "The GIL is released.\n"
+    "Returns error norm squared average (of the last epoch).";
+
+
+/**
+ *  \brief  Initialise model type
+ *
+ *  \param  name  Type name
+ *  \param  doc   Type doc string
+ *
+ *  \return Type object
+ */
+template <class Model>
+static PyTypeObject * model_type_init(const char * name, const char * doc) {
+    typedef model_object<Model> object_t;
+
+    static PyMethodDef methods[] = {
+        { "eval", (PyCFunction)(void (*)(void))model_eval<Model>,
+            METH_VARARGS | METH_KEYWORDS, eval_doc },
+        { "train", (PyCFunction)(void (*)(void))model_train<Model>,
+            METH_VARARGS | METH_KEYWORDS, train_doc },
+        { NULL, NULL, 0, NULL }
+    };
+
+    static PyGetSetDef getset[] = {
+        { (char *)"input_size", (getter)model_input_size<Model>, NULL,
+            (char *)"Network input size", NULL },
+        { (char *)"output_size", (getter)model_output_size<Model>, NULL,
+            (char *)"Network output size", NULL },
+        { (char *)"layers", (getter)model_layers<Model>, NULL,
+            (char *)"Layer sizes", NULL },
+        { NULL, NULL, NULL, NULL, NULL }
+    };
+
+    PyTypeObject & type = model_type<Model>::type;
+
+    type.tp_name      = name;
+    type.tp_doc       = doc;
+    type.tp_basicsize = sizeof(object_t);
+    type.tp_flags     = Py_TPFLAGS_DEFAULT;
+    type.tp_new       = model_new<Model>;
+    type.tp_init      = (initproc)model_init<Model>;
+    type.tp_dealloc   = (destructor)model_dealloc<Model>;
+    type.tp_methods   = methods;
+    type.tp_getset    = getset;
+
+    return &type;
+}
+
+
+//
+// Network topology type
+//
+
+/** Network topology object */
+struct nn_object {
+    PyObject_HEAD
+    nn_t *            nn;        /**< Network                      */
+    box<nn_func_t> *  function;  /**< Function (NULL if not valid) */
+    box<nn_train_t> * training;  /**< Training (NULL if not valid) */
+    std::mutex *      mx;        /**< Object mutex                 */
+
+    /** Invalidate function and training */
+    void invalidate() {
+        delete function; function = NULL;
+        delete training; training = NULL;
+    }
+
+};  // end of struct nn_object
+
+/** Network topology type object */
+static PyTypeObject nn_type = { PyVarObject_HEAD_INIT(NULL, 0) };
+
+
+/** Network topology object constructor */
+static PyObject * nn_new(PyTypeObject * type, PyObject * args, PyObject * kw) {
+    nn_object * self = (nn_object *)type->tp_alloc(type, 0);
+    if (NULL == self) return NULL;
+
+    self->nn       = new(std::nothrow) nn_t();
+    self->function = NULL;
+    self->training = NULL;
+    self->mx       = new(std::nothrow) std::mutex();
+
+    if (NULL == self->nn || NULL == self->mx) {
+        Py_DECREF(self);
+        return PyErr_NoMemory();
+    }
+
+    return (PyObject *)self;
+}
+
+
+/** Network topology object destructor */
+static void nn_dealloc(nn_object * self) {
+    self->invalidate();
+    delete self->nn;
+    delete self->mx;
+
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+
+/** Add neuron */
+static PyObject * nn_add_neuron(nn_object * self, PyObject * args) {
+    int type = nn_t::neuron::INNER;
+
+    if (!PyArg_ParseTuple(args, "|i", &type)) return NULL;
+
+    if (type < nn_t::neuron::INNER || nn_t::neuron::OUTPUT < type) {
+        PyErr_SetString(PyExc_ValueError, "invalid neuron type");
+        return NULL;
+    }
+
+    size_t index = 0;
+    if (!nogil(*self->mx, [&]() {
+        self->invalidate();
+        index = self->nn->add_neuron(
+            (typename nn_t::neuron::type_t)type).index();
+    })) return NULL;
+
+    return PyLong_FromSize_t(index);
+}
+
+
+/** Set synapse */
+static PyObject * nn_set_synapse(nn_object * self, PyObject * args) {
+    Py_ssize_t target, source;
+    double     weight = 0.0;
+
+    if (!PyArg_ParseTuple(args, "nn|d", &target, &source, &weight))
+        return NULL;
+
+    if (!nogil(*self->mx, [&]() {
+        self->invalidate();
+
+        nn_t::neuron & src = self->nn->get_neuron(source);
+        self->nn->get_neuron(target).set_dendrite(src, weight);
+    })) return NULL;
+
+    Py_RETURN_NONE;
+}
+
+
+/** Get synapse weight */
+static PyObject * nn_weight(nn_object * self, PyObject * args) {
+    Py_ssize_t target, source;
+
+    if (!PyArg_ParseTuple(args, "nn", &target, &source)) return NULL;
+
+    bool   found  = false;
+    double weight = 0.0;
+    if (!nogil(*self->mx, [&]() {
+        const nn_t & nn = *self->nn;
+
+        nn.get_neuron(target).for_each_dendrite(
+        [&](const nn_t::neuron::dendrite & d) {
+            if ((size_t)source != d.source().index()) return;
+
+            found  = true;
+            weight = d.weight();
+        });
+    })) return NULL;
+
+    if (!found) {
+        PyErr_SetString(PyExc_KeyError, "no such synapse");
+        return NULL;
+    }
+
+    return PyFloat_FromDouble(weight);
+}
+
+
+/** Network topology evaluation */
+static PyObject * nn_eval(nn_object * self, PyObject * args, PyObject * kw) {
+    static const char * kwlist[] = { "x", "out", NULL };
+
+    PyObject * x;
+    PyObject * out = Py_None;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kw, "O|O", (char **)kwlist,
+        &x, &out))
+    {
+        return NULL;
+    }
+
+    buffer in_buf, out_buf;
+    PyObject * result = eval_buffers(x, out,
+        self->nn->input_size(), self->nn->output_size(), in_buf, out_buf);
+
+    if (NULL == result) return NULL;
+
+    const inputs_t inputs = in_buf.inputs();
+    const size_t   stride = out_buf.stride();
+
+    if (!nogil(*self->mx, [&]() {
+        if (NULL == self->function)
+            self->function = new box<nn_func_t>(*self->nn);
+
+        double * output = out_buf.data();
+        for (auto row = inputs.begin(); row != inputs.end(); ++row) {
+            const std::vector<double> o = self->function->obj(*row);
+
+            std::copy(o.begin(), o.end(), output);
+            output += stride;
+        }
+    })) {
+        Py_DECREF(result);
+        return NULL;
+    }
+
+    return result;
+}
+
+
+/** Network topology training */
+static PyObject * nn_train(nn_object * self, PyObject * args, PyObject * kw) {
+    static const char * kwlist[] = {
+        "x", "y", "alpha", "epochs", "batch", NULL };
+
+    PyObject * x;
+    PyObject * y;
+    double     alpha  = 0.1;
+    Py_ssize_t epochs = 1;
+    int        batch  = 1;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kw, "OO|dnp", (char **)kwlist,
+        &x, &y, &alpha, &epochs, &batch))
+    {
+        return NULL;
+    }
+
+    buffer x_buf, y_buf;
+    if (!train_buffers(x, y, self->nn->input_size(), self->nn->output_size(),
+        x_buf, y_buf)) return NULL;
+
+    const tset_t set(x_buf.inputs(), y_buf.inputs());
+
+    double error = 0;
+    if (!nogil(*self->mx, [&]() {
+        if (NULL == self->training)
+            self->training = new box<nn_train_t>(*self->nn);
+
+        error = train_set(self->training->obj, set, alpha,
+            std::max<Py_ssize_t>(0, epochs), batch);
+    })) return NULL;
+
+    return PyFloat_FromDouble(error);
+}
+
+
+/** Network size getter */
+static PyObject * nn_size(nn_object * self, void * ) {
+    return PyLong_FromSize_t(self->nn->size());
+}
+
+
+/** Network input size getter */
+static PyObject * nn_input_size(nn_object * self, void * ) {
+    return PyLong_FromSize_t(self->nn->input_size());
+}
+
+
+/** Network output size getter */
+static PyObject * nn_output_size(nn_object * self, void * ) {
+    return PyLong_FromSize_t(self->nn->output_size());
+}
+
+
+/** Initialise network topology type */
+static PyTypeObject * nn_type_init() {
+    static PyMethodDef methods[] = {
+        { "add_neuron", (PyCFunction)nn_add_neuron, METH_VARARGS,
+            "add_neuron(type=NN.INNER)\n\n"
+            "Add neuron (NN.INNER, NN.INPUT or NN.OUTPUT); "
+            "returns its index." },
+        { "set_synapse", (PyCFunction)nn_set_synapse, METH_VARARGS,
+            "set_synapse(target, source, weight=0.0)\n\n"
+            "Set synapse from source to target neuron." },
+        { "weight", (PyCFunction)nn_weight, METH_VARARGS,
+            "weight(target, source)\n\n"
+            "Synapse weight." },
+        { "eval", (PyCFunction)(void (*)(void))nn_eval,
+            METH_VARARGS | METH_KEYWORDS, eval_doc },
+        { "train", (PyCFunction)(void (*)(void))nn_train,
+            METH_VARARGS | METH_KEYWORDS, train_doc },
+        { NULL, NULL, 0, NULL }
+    };
+
+    static PyGetSetDef getset[] = {
+        { (char *)"size", (getter)nn_size, NULL,
+            (char *)"Neuron count", NULL },
+        { (char *)"input_size", (getter)nn_input_size, NULL,
+            (char *)"Input neuron count", NULL },
+        { (char *)"output_size", (getter)nn_output_size, NULL,
+            (char *)"Output neuron count", NULL },
+        { NULL, NULL, NULL, NULL, NULL }
+    };
+
+    nn_type.tp_name      = "libnn.NN";
+    nn_type.tp_doc       =
+        "NN()\n"
+        "\n"
+        "Neural network of general topology (logistic activation).\n"
+        "Neurons are added by add_neuron, synapses by set_synapse;\n"
+        "inputs (and outputs) are ordered by the neuron indices.";
+    nn_type.tp_basicsize = sizeof(nn_object);
+    nn_type.tp_flags     = Py_TPFLAGS_DEFAULT;
+    nn_type.tp_new       = nn_new;
+    nn_type.tp_dealloc   = (destructor)nn_dealloc;
+    nn_type.tp_methods   = methods;
+    nn_type.tp_getset    = getset;
+
+    return &nn_type;
+}
+
+
+//
+// Module
+//
+
+/** Module definition */
+static PyModuleDef module_def = {
+    PyModuleDef_HEAD_INIT,
+    "libnn",
+    "Neural networks library binding\n"
+    "\n"
+    "Arrays (NumPy arrays or other objects supporting the buffer protocol\n"
+    "with float64 items) are passed to the library without conversion;\n"
+    "evaluation copies rows in and out of the library work matrices.",
+    -1,
+    NULL, NULL, NULL, NULL, NULL
+};
+
+
+/**
+ *  \brief  Add type to module
+ *
+ *  \param  module  Module
+ *  \param  name    Attribute name
+ *  \param  type    Type object
+ *
+ *  \return \c true on success
+ */
+static bool add_type(PyObject * module, const char * name, PyTypeObject * type) {
+    if (PyType_Ready(type) < 0) return false;
+
+    Py_INCREF(type);
+    if (PyModule_AddObject(module, name, (PyObject *)type) < 0) {
+        Py_DECREF(type);
+        return false;
+    }
+
+    return true;
+}
+
+
+/** Module initialisation */
+PyMODINIT_FUNC PyInit_libnn(void) {
+    PyObject * module = PyModule_Create(&module_def);
+    if (NULL == module) return NULL;
+
+    PyTypeObject * nn = nn_type_init();
+
+    if (!add_type(module, "NN", nn)
+    ||  !add_type(module, "FeedForward", model_type_init<feed_forward_t>(
+            "libnn.FeedForward",
+            "FeedForward(layers, bias=True, lateral=False, weight=1.0, "
+            "seed=None)\n"
+            "\n"
+            "Feed-forward network (logistic activation) of layers sizes;\n"
+            "synapses weights are initialised ~ U(-weight, weight)\n"
+            "(the same seed gives the same weights)."))
+    ||  !add_type(module, "Perceptron", model_type_init<perceptron_t>(
+            "libnn.Perceptron",
+            "Perceptron(layers, bias=True, lateral=False, weight=1.0, "
+            "seed=None)\n"
+            "\n"
+            "Multi-layer perceptron of layers sizes;\n"
+            "synapses weights are initialised ~ U(-weight, weight)\n"
+            "(the same seed gives the same weights).")))
+    {
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    // Neuron types
+    PyDict_SetItemString(nn->tp_dict, "INNER",
+        PyLong_FromLong(nn_t::neuron::INNER));
+    PyDict_SetItemString(nn->tp_dict, "INPUT",
+        PyLong_FromLong(nn_t::neuron::INPUT));
+    PyDict_SetItemString(nn->tp_dict, "OUTPUT",
+        PyLong_FromLong(nn_t::neuron::OUTPUT));
+    PyType_Modified(nn);
+
+    // NumPy is optional
+    PyObject * numpy = PyImport_ImportModule("numpy");
+    if (numpy) {
+        numpy_empty = PyObject_GetAttrString(numpy, "empty");
+        Py_DECREF(numpy);
+    }
+
+    PyErr_Clear();
+
+    PyModule_AddObject(module, "HAVE_NUMPY",
+        PyBool_FromLong(NULL != numpy_empty));
+
+    return module;
+}
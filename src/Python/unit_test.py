@@ -0,0 +1,211 @@
+#!/usr/bin/env python3
+
+# Python binding unit test
+#
+# Uses array.array / memoryview buffers (NumPy arrays are checked
+# if NumPy is available).
+
+import sys
+import math
+import array
+import threading
+
+import libnn
+
+
+error_cnt = 0
+
+
+def check(cond, msg):
+    """Count failed check"""
+
+    global error_cnt
+
+    if not cond:
+        print("FAILED: " + msg)
+        error_cnt += 1
+
+
+def matrix(rows, cols, values=None):
+    """float64 matrix (memoryview)"""
+
+    data = array.array("d", values if values is not None else [0.0] * (rows * cols))
+    return memoryview(data).cast("B").cast("d", [rows, cols])
+
+
+def logistic(x):
+    return 1.0 / (1.0 + math.exp(-x))
+
+
+def test_nn():
+    """General topology network test"""
+
+    print("NN test BEGIN")
+
+    nn = libnn.NN()
+    i0 = nn.add_neuron(libnn.NN.INPUT)
+    i1 = nn.add_neuron(libnn.NN.INPUT)
+    o  = nn.add_neuron(libnn.NN.OUTPUT)
+
+    nn.set_synapse(o, i0, 0.5)
+    nn.set_synapse(o, i1, -1.5)
+
+    check(3 == nn.size and 2 == nn.input_size and 1 == nn.output_size,
+        "NN sizes")
+    check(-1.5 == nn.weight(o, i1), "NN synapse weight")
+
+    x = matrix(3, 2, [0.0, 0.0, 1.0, 0.0, 0.5, 1.0])
+    y = nn.eval(x)
+
+    for r in range(3):
+        exp = logistic(0.5 * x[r, 0] - 1.5 * x[r, 1])
+        check(abs(y[r, 0] - exp) < 1e-12, "NN output %d" % r)
+
+    try:
+        nn.eval(matrix(1, 3))
+        check(False, "NN input size not checked")
+    except ValueError:
+        pass
+
+    print("NN test END")
+
+
+def test_eval(model):
+    """Model evaluation test"""
+
+    print("%s evaluation test BEGIN" % model.__name__)
+
+    nn = model([4, 8, 3], seed=1)
+    check([4, 8, 3] == nn.layers, "layers")
+    check(4 == nn.input_size and 3 == nn.output_size, "sizes")
+
+    rows = 600  # more than evaluation block
+    x = matrix(rows, 4, [(i % 17) / 17.0 for i in range(rows * 4)])
+
+    y = nn.eval(x)
+    check((rows, 3) == tuple(y.shape), "output shape")
+
+    # Row by row (1-D)
+    for r in (0, 1, 255, 256, rows - 1):
+        row = nn.eval(array.array("d", [x[r, c] for c in range(4)]))
+
+        check(1 == len(row.shape), "1-D output")
+        check(all(abs(row[c] - y[r, c]) < 1e-12 for c in range(3)),
+            "row %d output" % r)
+
+    # Output array provided
+    out = matrix(rows, 3)
+    res = nn.eval(x, out=out)
+    check(res is out, "out returned")
+    check(out.tolist() == y.tolist(), "out content")
+
+    try:
+        nn.eval(x, out=matrix(rows - 1, 3))
+        check(False, "out shape not checked")
+    except ValueError:
+        pass
+
+    try:
+        nn.eval(array.array("f", [0.0] * 4))
+        check(False, "item format not checked")
+    except TypeError:
+        pass
+
+    try:
+        nn.eval(x, out=bytes(rows * 3 * 8))
+        check(False, "out writability not checked")
+    except (TypeError, BufferError, ValueError):
+        pass
+
+    # Concurrent evaluation (GIL released; object serialised)
+    results = [None] * 4
+
+    def worker(i):
+        results[i] = nn.eval(x).tolist()
+
+    threads = [threading.Thread(target=worker, args=(i,)) for i in range(4)]
+    for t in threads: t.start()
+    for t in threads: t.join()
+
+    check(all(y.tolist() == r for r in results), "concurrent evaluation")
+
+    print("%s evaluation test END" % model.__name__)
+
+
+def test_train(model, batch):
+    """Model training test (XOR)"""
+
+    print("%s %s training test BEGIN" %
+        (model.__name__, "batch" if batch else "on-line"))
+
+    nn = model([2, 4, 1], seed=1)
+
+    x = matrix(4, 2, [0, 0, 0, 1, 1, 0, 1, 1])
+    y = matrix(4, 1, [0, 1, 1, 0])
+
+    err0 = nn.train(x, y, alpha=0.0)
+    err  = nn.train(x, y, alpha=0.5, epochs=3000, batch=batch)
+
+    print("Error: %g -> %g" % (err0, err))
+    check(err < err0 and err < 0.05, "training convergence")
+
+    out = nn.eval(x)
+    for r in range(4):
+        check(abs(out[r, 0] - y[r, 0]) < 0.3, "trained output %d" % r)
+
+    print("%s training test END" % model.__name__)
+
+
+def test_numpy():
+    """NumPy arrays test"""
+
+    import numpy
+
+    print("NumPy test BEGIN")
+
+    nn = libnn.FeedForward([5, 7, 2], seed=1)
+
+    x = numpy.random.RandomState(1).rand(100, 5)
+    y = nn.eval(x)
+    check(isinstance(y, numpy.ndarray) and (100, 2) == y.shape,
+        "NumPy output")
+
+    # Padded rows (strided view, no copy)
+    padded = numpy.zeros((100, 8))
+    padded[:, :5] = x
+    check(numpy.array_equal(nn.eval(padded[:, :5]), y), "padded rows")
+
+    out = numpy.empty((100, 4))
+    nn.eval(x, out=out[:, 1:3])
+    check(numpy.array_equal(out[:, 1:3], y), "padded output rows")
+
+    try:
+        nn.eval(numpy.asfortranarray(x))
+        check(False, "Fortran order not refused")
+    except ValueError:
+        pass
+
+    print("NumPy test END")
+
+
+def main():
+    test_nn()
+
+    for model in (libnn.FeedForward, libnn.Perceptron):
+        test_eval(model)
+
+    test_train(libnn.FeedForward, True)
+    test_train(libnn.FeedForward, False)
+
+    if libnn.HAVE_NUMPY:
+        test_numpy()
+    else:
+        print("NumPy not available, NumPy test skipped")
+
+    print("Exit code: %d" % error_cnt, file=sys.stderr)
+
+    return error_cnt
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,4 @@
+#!/bin/sh
+
+# Python binding test (module built in .libs)
+PYTHONPATH=.libs exec ${PYTHON:-python3} "${srcdir:-.}/unit_test.py"